@@ -3527,8 +3527,11 @@ ags_xorg_application_context_setup(AgsApplicationContext *application_context)
     if(AGS_IS_PULSE_DEVOUT(soundcard)){
       GList *start_port, *port;
 
+      guint port_format;
+      
       g_object_get(soundcard,
 		   "pulse-port", &start_port,
+		   "format", &port_format,
 		   NULL);
 
       port = start_port;
@@ -3541,7 +3544,7 @@ ags_xorg_application_context_setup(AgsApplicationContext *application_context)
 	ags_pulse_port_set_buffer_size(port->data,
 				       buffer_size);
 	ags_pulse_port_set_format(port->data,
-				  format);
+				  port_format);
 	ags_pulse_port_set_cache_buffer_size(port->data,
 					     buffer_size * ceil(cache_buffer_size / buffer_size));
 	
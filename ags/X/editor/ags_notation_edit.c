@@ -1892,9 +1892,11 @@ ags_notation_edit_draw_notation(AgsNotationEdit *notation_edit, cairo_t *cr)
     
     while(list_notation != NULL){
       AgsNotation *notation;
+      AgsNotationNoteStore *note_store;
 
-      GList *start_list_note, *list_note;
-
+      guint max_length;
+      guint j;
+      
       notation = AGS_NOTATION(list_notation->data);
 
       g_object_get(notation,
@@ -1920,23 +1922,31 @@ ags_notation_edit_draw_notation(AgsNotationEdit *notation_edit, cairo_t *cr)
 	continue;
       }
 
-      g_object_get(notation,
-		   "note", &start_list_note,
-		   NULL);
-      
-      list_note = start_list_note;
+      /* draw notes overlapping the visible region */
+      note_store = ags_notation_get_note_store(notation);
 
-      while(list_note != NULL){
+      max_length = (guint) (notation->maximum_note_length / AGS_NOTATION_MINIMUM_NOTE_LENGTH);
+
+      if(notation->note_tree_max_length > max_length){
+	max_length = notation->note_tree_max_length;
+      }
+      
+      for(j = ags_notation_note_store_lower_bound(note_store,
+						  (x0 > max_length) ? x0 - max_length: 0);
+	  j < note_store->length && note_store->x0[j] <= x1;
+	  j++){
+	/* x1 grows in place while recording */
+	if(ags_note_get_x1(note_store->note[j]) < x0){
+	  continue;
+	}
+	
 	ags_notation_edit_draw_note(notation_edit,
-				    list_note->data,
+				    note_store->note[j],
 				    cr,
 				    opacity);
-
-	list_note = list_note->next;
       }
 
-      g_list_free_full(start_list_note,
-		       g_object_unref);
+      ags_notation_note_store_unref(note_store);
       
       list_notation = list_notation->next;
     }
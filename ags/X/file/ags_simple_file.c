@@ -2672,6 +2672,8 @@ ags_simple_file_read_machine(AgsSimpleFile *simple_file, xmlNode *node, AgsMachi
       }else if(!xmlStrncmp(child->name,
 			   (xmlChar *) "ags-sf-notation-list",
 			   21)){
+	GList *start_notation, *notation, *notation_iter;
+
 	gchar *version;
 
 	guint major, minor;
@@ -2689,16 +2691,37 @@ ags_simple_file_read_machine(AgsSimpleFile *simple_file, xmlNode *node, AgsMachi
 	  xmlFree(version);
 	}
 	
+	/* read into a copy, so the notation index of the audio is rebuilt */
+	notation = ags_audio_get_notation(gobject->audio);
+	start_notation = g_list_copy(notation);
+	
 	if(major == 0 ||
 	   (major == 1 && minor < 2)){
 	  ags_simple_file_read_notation_list_fixup_1_0_to_1_2(simple_file,
 							      child,
-							      &(gobject->audio->notation));
+							      &notation);
 	}else{
 	  ags_simple_file_read_notation_list(simple_file,
 					     child,
-					     &(gobject->audio->notation));
+					     &notation);
+	}
+
+	/* release the notation dropped while reading */
+	notation_iter = start_notation;
+
+	while(notation_iter != NULL){
+	  if(g_list_find(notation,
+			 notation_iter->data) == NULL){
+	    g_object_unref(notation_iter->data);
+	  }
+
+	  notation_iter = notation_iter->next;
 	}
+
+	g_list_free(start_notation);
+	
+	ags_audio_set_notation(gobject->audio,
+			       notation);
       }else if(!xmlStrncmp(child->name,
 			   (xmlChar *) "ags-sf-preset-list",
 			   21)){
@@ -2792,7 +2815,7 @@ ags_simple_file_read_machine(AgsSimpleFile *simple_file, xmlNode *node, AgsMachi
       if(!xmlStrncmp(child->name,
 		     (xmlChar *) "ags-sf-automation-list",
 		     23)){
-	GList *automation;
+	GList *start_automation, *automation, *automation_iter;
 
 	gchar *version;
 
@@ -2811,16 +2834,37 @@ ags_simple_file_read_machine(AgsSimpleFile *simple_file, xmlNode *node, AgsMachi
 	  xmlFree(version);
 	}
 	
+	/* read into a copy, so the automation index of the audio is rebuilt */
+	automation = ags_audio_get_automation(gobject->audio);
+	start_automation = g_list_copy(automation);
+	
 	if(major == 0 ||
 	   (major == 1 && minor < 3)){
 	  ags_simple_file_read_automation_list_fixup_1_0_to_1_3(simple_file,
 								child,
-								&(gobject->audio->automation));
+								&automation);
 	}else{
 	  ags_simple_file_read_automation_list(simple_file,
 					       child,
-					       &(gobject->audio->automation));
+					       &automation);
+	}
+
+	/* release the automation dropped while reading */
+	automation_iter = start_automation;
+
+	while(automation_iter != NULL){
+	  if(g_list_find(automation,
+			 automation_iter->data) == NULL){
+	    g_object_unref(automation_iter->data);
+	  }
+
+	  automation_iter = automation_iter->next;
 	}
+
+	g_list_free(start_automation);
+	
+	ags_audio_set_automation(gobject->audio,
+				 automation);
       }
     }
 
@@ -3437,6 +3481,17 @@ ags_simple_file_read_audiorec_launch(AgsSimpleFile *simple_file, xmlNode *node,
   xmlChar *str;
   gchar *value;
 
+  /* a streamed wave is saved as reference to its file */
+  str = xmlGetProp(node,
+		   "stream");
+
+  gtk_toggle_button_set_active((GtkToggleButton *) audiorec->stream,
+			       (str != NULL && !g_ascii_strncasecmp(str, "true", 5)) ? TRUE: FALSE);
+
+  if(str != NULL){      
+    xmlFree(str);
+  }
+  
   str = xmlGetProp(node,
 		   "filename");
     
@@ -6830,6 +6885,8 @@ ags_simple_file_read_notation_list(AgsSimpleFile *simple_file, xmlNode *node, GL
     child = child->next;
   }
 
+  g_list_free(*notation);
+  
   *notation = list;
 }
 
@@ -7281,6 +7338,8 @@ ags_simple_file_read_automation_list(AgsSimpleFile *simple_file, xmlNode *node,
     child = child->next;
   }
 
+  g_list_free(*automation);
+  
   *automation = list;
 }
 
@@ -9179,6 +9238,13 @@ ags_simple_file_write_machine(AgsSimpleFile *simple_file, xmlNode *parent, AgsMa
     xmlNewProp(node,
 	       "filename",
 	       gtk_entry_get_text(audiorec->filename));
+
+    /* the wave isn't in memory, so it is only referenced by the filename */
+    if(gtk_toggle_button_get_active((GtkToggleButton *) audiorec->stream)){
+      xmlNewProp(node,
+		 "stream",
+		 "true");
+    }
   }else if(AGS_IS_LADSPA_BRIDGE(machine)){
     AgsLadspaBridge *ladspa_bridge;
 
@@ -519,17 +519,12 @@ ags_track_collection_mapper_apply(AgsApplicable *applicable)
 		     128, 0);
 
   /* apply notation */
-  imported_notation = track_collection_mapper->notation;
-  g_list_free_full(machine->audio->notation,
-		   g_object_unref);
+  imported_notation = g_list_copy_deep(track_collection_mapper->notation,
+				       (GCopyFunc) g_object_ref,
+				       NULL);
   
-  machine->audio->notation = imported_notation;
-  
-  while(imported_notation != NULL){
-    g_object_ref(imported_notation->data);
-    
-    imported_notation = imported_notation->next;
-  }
+  ags_audio_set_notation(machine->audio,
+			 imported_notation);
 
   /* */
   gtk_widget_show_all(GTK_WIDGET(machine));
@@ -178,6 +178,10 @@ ags_audiorec_init(AgsAudiorec *audiorec)
   AgsAudio *audio;
   AgsPlaybackDomain *playback_domain;
 
+  AgsConfig *config;
+
+  gchar *str;
+  
   guint i;
 
   static const guint staging_program[] = {
@@ -340,6 +344,29 @@ ags_audiorec_init(AgsAudiorec *audiorec)
 		     (GtkWidget *) audiorec->mix_data,
 		     FALSE, FALSE,
 		     0);
+
+  /* stream - keep the file on disk */
+  audiorec->stream = (GtkCheckButton *) gtk_check_button_new_with_label(i18n("stream from disk"));
+  gtk_box_pack_start((GtkBox *) vbox,
+		     (GtkWidget *) audiorec->stream,
+		     FALSE, FALSE,
+		     0);
+
+  config = ags_config_get_instance();
+
+  str = ags_config_get_value(config,
+			     AGS_CONFIG_GENERIC,
+			     "stream-wave");
+
+  if(str != NULL &&
+     !g_ascii_strncasecmp(str,
+			  "true",
+			  5)){
+    gtk_toggle_button_set_active((GtkToggleButton *) audiorec->stream,
+				 TRUE);
+  }
+
+  g_free(str);
   
   /* frame - hindicator */
   frame = (GtkFrame *) gtk_frame_new(i18n("input"));
@@ -894,6 +921,11 @@ ags_audiorec_open_filename(AgsAudiorec *audiorec,
 				      filename,
 				      TRUE);
 
+  if(gtk_toggle_button_get_active((GtkToggleButton *) audiorec->stream)){
+    ags_wave_loader_set_flags(wave_loader,
+			      AGS_WAVE_LOADER_STREAM);
+  }
+  
   ags_wave_loader_start(wave_loader);
 }
 
@@ -65,6 +65,7 @@ struct _AgsAudiorec
   
   GtkEntry *filename;
   GtkButton *open;
+  GtkCheckButton *stream;
 
   AgsWaveLoader *wave_loader;
 
@@ -169,6 +169,19 @@ void ags_audio_real_set_pads(AgsAudio *audio,
 			     GType channel_type,
 			     guint channels, guint channels_old);
 
+void ags_audio_timestamp_index_insert(AgsTimestampIndex *timestamp_index,
+				      GObject *data,
+				      gchar *line_property);
+void ags_audio_timestamp_index_rebuild(AgsTimestampIndex *timestamp_index,
+				       GList *list,
+				       gchar *line_property);
+gboolean ags_audio_timestamp_index_validate(GObject *data,
+					    gchar *line_property,
+					    guint line,
+					    guint64 x, guint64 length);
+gboolean ags_audio_timestamp_index_is_complete(AgsTimestampIndex *timestamp_index,
+					       guint length);
+
 void ags_audio_real_set_output_soundcard(AgsAudio *audio, GObject *output_soundcard);
 
 void ags_audio_real_set_input_soundcard(AgsAudio *audio, GObject *input_soundcard);
@@ -1798,14 +1811,20 @@ ags_audio_init(AgsAudio *audio)
 
   /* notation */
   audio->notation = NULL;
+  audio->notation_count = 0;
+  audio->notation_index = ags_timestamp_index_new((guint64) AGS_NOTATION_DEFAULT_OFFSET);
 
   /* automation */
   audio->automation_port = NULL;
   
   audio->automation = NULL;
+  audio->automation_count = 0;
+  audio->automation_index = ags_timestamp_index_new((guint64) AGS_AUTOMATION_DEFAULT_OFFSET);
   
   /* wave */
   audio->wave = NULL;
+  audio->wave_count = 0;
+  audio->wave_index = ags_timestamp_index_new((guint64) AGS_WAVE_DEFAULT_OFFSET);
 
   audio->output_audio_file = NULL;
   audio->input_audio_file = NULL;
@@ -1832,6 +1851,12 @@ ags_audio_init(AgsAudio *audio)
 
   audio->recall = NULL;
 
+  /* execution plan */
+  memset(audio->execution_plan, 0, AGS_SOUND_SCOPE_LAST * sizeof(AgsExecutionPlan *));
+
+  /* modulation source */
+  audio->modulation_source = NULL;
+
   /* data */
   audio->machine_widget = NULL;
 }
@@ -3168,6 +3193,8 @@ ags_audio_dispose(GObject *gobject)
 
   GList *list, *list_next;
 
+  guint i;
+  
   GRecMutex *play_mutex, *recall_mutex;
 
   audio = AGS_AUDIO(gobject);
@@ -3310,7 +3337,10 @@ ags_audio_dispose(GObject *gobject)
 		     g_object_unref);
 
     audio->notation = NULL;
+    audio->notation_count = 0;
   }
+
+  ags_timestamp_index_clear(audio->notation_index);
   
   /* automation */
   if(audio->automation != NULL){
@@ -3328,8 +3358,11 @@ ags_audio_dispose(GObject *gobject)
 		     g_object_unref);
 
     audio->automation = NULL;
+    audio->automation_count = 0;
   }
 
+  ags_timestamp_index_clear(audio->automation_index);
+
   /* wave */
   if(audio->wave != NULL){
     list = audio->wave;
@@ -3346,8 +3379,11 @@ ags_audio_dispose(GObject *gobject)
 		     g_object_unref);
 
     audio->wave = NULL;
+    audio->wave_count = 0;
   }
 
+  ags_timestamp_index_clear(audio->wave_index);
+
   /* output audio file */
   if(audio->output_audio_file != NULL){
     g_object_unref(audio->output_audio_file);
@@ -3499,6 +3535,22 @@ ags_audio_dispose(GObject *gobject)
     g_rec_mutex_unlock(recall_mutex);
   }
 
+  /* execution plan */
+  for(i = 0; i < AGS_SOUND_SCOPE_LAST; i++){
+    if(audio->execution_plan[i] != NULL){
+      ags_execution_plan_unref(audio->execution_plan[i]);
+
+      audio->execution_plan[i] = NULL;
+    }
+  }
+
+  /* modulation source */
+  if(audio->modulation_source != NULL){
+    g_object_unref(audio->modulation_source);
+
+    audio->modulation_source = NULL;
+  }
+
   /* call parent */
   G_OBJECT_CLASS(ags_audio_parent_class)->dispose(gobject);
 }
@@ -3630,6 +3682,8 @@ ags_audio_finalize(GObject *gobject)
     g_list_free_full(audio->notation,
 		     g_object_unref);
   }
+
+  g_object_unref(audio->notation_index);
   
   /* automation */
   if(audio->automation != NULL){
@@ -3647,6 +3701,8 @@ ags_audio_finalize(GObject *gobject)
 		     g_object_unref);
   }
 
+  g_object_unref(audio->automation_index);
+
   /* wave */
   if(audio->wave != NULL){
     list = audio->wave;
@@ -3663,6 +3719,8 @@ ags_audio_finalize(GObject *gobject)
 		     g_object_unref);
   }
 
+  g_object_unref(audio->wave_index);
+
   /* output audio file */
   if(audio->output_audio_file != NULL){
     g_object_unref(audio->output_audio_file);
@@ -6162,6 +6220,7 @@ ags_audio_set_audio_channels_shrink_automation(AgsAudio *audio,
 
   if(audio_channels == 0){
     audio->automation = NULL;
+    audio->automation_count = 0;
   }
 
   g_rec_mutex_unlock(audio_mutex);
@@ -6635,6 +6694,9 @@ ags_audio_set_audio_channels(AgsAudio *audio,
 		audio_signals[SET_AUDIO_CHANNELS], 0,
 		audio_channels, audio_channels_old);
   g_object_unref((GObject *) audio);
+
+  /* execution plan */
+  ags_execution_plan_invalidate();
 }
 
 /**
@@ -7146,10 +7208,9 @@ ags_audio_set_pads_remove_notes(AgsAudio *audio,
 
     while(note != NULL){
       if(AGS_NOTE(note->data)->y >= pads){
-	AGS_NOTATION(notation->data)->note = g_list_remove(AGS_NOTATION(notation->data)->note,
-							   note->data);
-	  
-	g_object_unref(note->data);
+	ags_notation_remove_note(notation->data,
+				 note->data,
+				 FALSE);
       }
 
       note = note->next;
@@ -7241,6 +7302,7 @@ ags_audio_set_pads_shrink_wave(AgsAudio *audio,
   g_list_free(list_start);
     
   audio->wave = NULL;
+  audio->wave_count = 0;
 
   g_rec_mutex_unlock(audio_mutex);
 }
@@ -7762,6 +7824,9 @@ ags_audio_set_pads(AgsAudio *audio,
 		channel_type,
 		pads, pads_old);
   g_object_unref((GObject *) audio);  
+
+  /* execution plan */
+  ags_execution_plan_invalidate();
 }
 
 /**
@@ -8547,6 +8612,12 @@ ags_audio_real_set_samplerate(AgsAudio *audio, guint samplerate)
 
   frequency = ceil((gdouble) audio->samplerate / (gdouble) audio->buffer_size) + AGS_SOUNDCARD_DEFAULT_OVERCLOCK;
 
+  if(audio->modulation_source != NULL){
+    g_object_set(audio->modulation_source,
+		 "samplerate", samplerate,
+		 NULL);
+  }
+  
   g_rec_mutex_unlock(audio_mutex);
 
   g_object_get(audio,
@@ -8771,6 +8842,12 @@ ags_audio_real_set_buffer_size(AgsAudio *audio, guint buffer_size)
   audio->buffer_size = buffer_size;
   
   frequency = ceil((gdouble) audio->samplerate / (gdouble) audio->buffer_size) + AGS_SOUNDCARD_DEFAULT_OVERCLOCK;
+
+  if(audio->modulation_source != NULL){
+    g_object_set(audio->modulation_source,
+		 "buffer-size", buffer_size,
+		 NULL);
+  }
   
   g_rec_mutex_unlock(audio_mutex);
   
@@ -10430,6 +10507,104 @@ ags_audio_remove_cursor(AgsAudio *audio, GObject *cursor)
   }
 }
 
+void
+ags_audio_timestamp_index_insert(AgsTimestampIndex *timestamp_index,
+				 GObject *data,
+				 gchar *line_property)
+{
+  AgsTimestamp *timestamp;
+
+  guint line;
+  
+  timestamp = NULL;
+
+  line = 0;
+  
+  g_object_get(data,
+	       line_property, &line,
+	       "timestamp", &timestamp,
+	       NULL);
+
+  ags_timestamp_index_insert(timestamp_index,
+			     data,
+			     line,
+			     ags_timestamp_get_ags_offset(timestamp));
+
+  if(timestamp != NULL){
+    g_object_unref(timestamp);
+  }
+}
+
+void
+ags_audio_timestamp_index_rebuild(AgsTimestampIndex *timestamp_index,
+				  GList *list,
+				  gchar *line_property)
+{
+  ags_timestamp_index_clear(timestamp_index);
+
+  while(list != NULL){
+    ags_audio_timestamp_index_insert(timestamp_index,
+				     list->data,
+				     line_property);
+
+    list = list->next;
+  }
+}
+
+gboolean
+ags_audio_timestamp_index_validate(GObject *data,
+				   gchar *line_property,
+				   guint line,
+				   guint64 x, guint64 length)
+{
+  AgsTimestamp *timestamp;
+
+  guint current_line;
+  guint64 current_x;
+  
+  timestamp = NULL;
+
+  current_line = 0;
+  
+  g_object_get(data,
+	       line_property, &current_line,
+	       "timestamp", &timestamp,
+	       NULL);
+
+  current_x = ags_timestamp_get_ags_offset(timestamp);
+  
+  if(timestamp != NULL){
+    g_object_unref(timestamp);
+  }
+
+  if(current_line == line &&
+     current_x >= x &&
+     current_x < x + length){
+    return(TRUE);
+  }
+
+  return(FALSE);
+}
+
+gboolean
+ags_audio_timestamp_index_is_complete(AgsTimestampIndex *timestamp_index,
+				      guint length)
+{
+  guint count;
+  
+  GRecMutex *timestamp_index_mutex;
+
+  timestamp_index_mutex = AGS_TIMESTAMP_INDEX_GET_OBJ_MUTEX(timestamp_index);
+
+  g_rec_mutex_lock(timestamp_index_mutex);
+
+  count = g_hash_table_size(timestamp_index->entry);
+  
+  g_rec_mutex_unlock(timestamp_index_mutex);
+
+  return((count == length) ? TRUE: FALSE);
+}
+
 /**
  * ags_audio_get_notation:
  * @audio: the #AgsAudio
@@ -10483,8 +10658,14 @@ ags_audio_set_notation(AgsAudio *audio, GList *notation)
 
   start_notation = audio->notation;
   audio->notation = notation;
+  g_atomic_int_set(&(audio->notation_count),
+		   g_list_length(notation));
   
   g_rec_mutex_unlock(audio_mutex);
+
+  ags_audio_timestamp_index_rebuild(audio->notation_index,
+				    notation,
+				    "audio-channel");
   
   g_list_free_full(start_notation,
 		   (GDestroyNotify) g_object_unref);
@@ -10526,6 +10707,7 @@ ags_audio_add_notation(AgsAudio *audio, GObject *notation)
     g_object_ref(notation);
     audio->notation = ags_notation_add(audio->notation,
 				       (AgsNotation *) notation);
+    g_atomic_int_inc(&(audio->notation_count));
   }
   
   g_rec_mutex_unlock(audio_mutex);
@@ -10534,6 +10716,10 @@ ags_audio_add_notation(AgsAudio *audio, GObject *notation)
     g_object_set(notation,
 		 "audio", audio,
 		 NULL);
+
+    ags_audio_timestamp_index_insert(audio->notation_index,
+				     notation,
+				     "audio-channel");
   }
 }
 
@@ -10572,11 +10758,16 @@ ags_audio_remove_notation(AgsAudio *audio, GObject *notation)
     
     audio->notation = g_list_remove(audio->notation,
 				    notation);
+    g_atomic_int_add(&(audio->notation_count),
+		     -1);
   }
   
   g_rec_mutex_unlock(audio_mutex);
 
   if(success){
+    ags_timestamp_index_remove(audio->notation_index,
+			       notation);
+
     g_object_set(notation,
 		 "audio", NULL,
 		 NULL);
@@ -10585,6 +10776,86 @@ ags_audio_remove_notation(AgsAudio *audio, GObject *notation)
   }
 }
 
+/**
+ * ags_audio_find_notation:
+ * @audio: the #AgsAudio
+ * @audio_channel: the audio channel
+ * @x: the timestamp's offset aligned to %AGS_NOTATION_DEFAULT_OFFSET
+ *
+ * Find notation of @audio_channel starting within @x and @x + %AGS_NOTATION_DEFAULT_OFFSET
+ * using the notation index. If the found notation was moved since it was added or nothing
+ * was found while the notation count exceeds the indexed notation, the index is rebuilt.
+ *
+ * Returns: (transfer full): the matching #AgsNotation or %NULL
+ *
+ * Since: 3.7.0
+ */
+GObject*
+ags_audio_find_notation(AgsAudio *audio,
+			guint audio_channel,
+			guint64 x)
+{
+  GObject *notation;
+
+  GList *start_notation;
+  
+  guint64 length;
+  guint list_length;
+  gboolean rebuild;
+
+  GRecMutex *audio_mutex;
+
+  if(!AGS_IS_AUDIO(audio)){
+    return(NULL);
+  }
+
+  /* get audio mutex */
+  audio_mutex = AGS_AUDIO_GET_OBJ_MUTEX(audio);
+
+  length = (guint64) AGS_NOTATION_DEFAULT_OFFSET;
+  
+  notation = ags_timestamp_index_find(audio->notation_index,
+				      audio_channel,
+				      x, length);
+
+  rebuild = FALSE;
+  
+  if(notation != NULL){
+    if(!ags_audio_timestamp_index_validate(notation,
+					   "audio-channel",
+					   audio_channel,
+					   x, length)){
+      g_object_unref(notation);
+
+      rebuild = TRUE;
+    }
+  }else{
+    /* a concurrent add might not be indexed yet */
+    list_length = g_atomic_int_get(&(audio->notation_count));
+
+    rebuild = !ags_audio_timestamp_index_is_complete(audio->notation_index,
+						     list_length);
+  }
+  
+  if(rebuild){
+    /* rebuild index */
+    start_notation = ags_audio_get_notation(audio);
+
+    ags_audio_timestamp_index_rebuild(audio->notation_index,
+				      start_notation,
+				      "audio-channel");
+
+    g_list_free_full(start_notation,
+		     (GDestroyNotify) g_object_unref);
+    
+    notation = ags_timestamp_index_find(audio->notation_index,
+					audio_channel,
+					x, length);
+  }
+
+  return(notation);
+}
+
 /**
  * ags_audio_get_automation_port:
  * @audio: the #AgsAudio
@@ -10819,9 +11090,15 @@ ags_audio_set_automation(AgsAudio *audio, GList *automation)
 
   start_automation = audio->automation;
   audio->automation = automation;
+  g_atomic_int_set(&(audio->automation_count),
+		   g_list_length(automation));
   
   g_rec_mutex_unlock(audio_mutex);
 
+  ags_audio_timestamp_index_rebuild(audio->automation_index,
+				    automation,
+				    "line");
+
   g_list_free_full(start_automation,
 		   (GDestroyNotify) g_object_unref);
 }
@@ -10862,6 +11139,7 @@ ags_audio_add_automation(AgsAudio *audio, GObject *automation)
     g_object_ref(automation);
     audio->automation = ags_automation_add(audio->automation,
 					   (AgsAutomation *) automation);
+    g_atomic_int_inc(&(audio->automation_count));
   }
   
   g_rec_mutex_unlock(audio_mutex);
@@ -10870,6 +11148,10 @@ ags_audio_add_automation(AgsAudio *audio, GObject *automation)
     g_object_set(automation,
 		 "audio", audio,
 		 NULL);
+
+    ags_audio_timestamp_index_insert(audio->automation_index,
+				     automation,
+				     "line");
   }
 }
 
@@ -10908,11 +11190,16 @@ ags_audio_remove_automation(AgsAudio *audio, GObject *automation)
     
     audio->automation = g_list_remove(audio->automation,
 				      automation);
+    g_atomic_int_add(&(audio->automation_count),
+		     -1);
   }
   
   g_rec_mutex_unlock(audio_mutex);
 
   if(success){
+    ags_timestamp_index_remove(audio->automation_index,
+			       automation);
+
     g_object_set(automation,
 		 "audio", NULL,
 		 NULL);
@@ -10921,6 +11208,99 @@ ags_audio_remove_automation(AgsAudio *audio, GObject *automation)
   }
 }
 
+/**
+ * ags_audio_find_automation:
+ * @audio: the #AgsAudio
+ * @line: the line
+ * @x: the timestamp's offset aligned to %AGS_AUTOMATION_DEFAULT_OFFSET
+ *
+ * Find automation of @line starting within @x and @x + %AGS_AUTOMATION_DEFAULT_OFFSET
+ * using the automation index. If any found automation was moved since it was added or
+ * nothing was found while the automation count exceeds the indexed automation, the index is
+ * rebuilt.
+ *
+ * Returns: (element-type AgsAudio.Automation) (transfer full): the #GList-struct containing matching #AgsAutomation
+ *
+ * Since: 3.7.0
+ */
+GList*
+ags_audio_find_automation(AgsAudio *audio,
+			  guint line,
+			  guint64 x)
+{
+  GList *start_automation, *automation;
+  
+  guint64 length;
+  guint list_length;
+  gboolean rebuild;
+
+  GRecMutex *audio_mutex;
+
+  if(!AGS_IS_AUDIO(audio)){
+    return(NULL);
+  }
+
+  /* get audio mutex */
+  audio_mutex = AGS_AUDIO_GET_OBJ_MUTEX(audio);
+
+  length = (guint64) AGS_AUTOMATION_DEFAULT_OFFSET;
+  
+  start_automation = ags_timestamp_index_find_all(audio->automation_index,
+						  line,
+						  x, length);
+
+  automation = start_automation;
+
+  while(automation != NULL){
+    if(!ags_audio_timestamp_index_validate(automation->data,
+					   "line",
+					   line,
+					   x, length)){
+      break;
+    }
+    
+    automation = automation->next;
+  }
+
+  rebuild = FALSE;
+  
+  if(automation != NULL){
+    g_list_free_full(start_automation,
+		     (GDestroyNotify) g_object_unref);
+
+    rebuild = TRUE;
+  }else{
+    /* a concurrent add might not be indexed yet */
+    list_length = g_atomic_int_get(&(audio->automation_count));
+
+    if(!ags_audio_timestamp_index_is_complete(audio->automation_index,
+					      list_length)){
+      g_list_free_full(start_automation,
+		       (GDestroyNotify) g_object_unref);
+
+      rebuild = TRUE;
+    }
+  }
+  
+  if(rebuild){
+    /* rebuild index */
+    automation = ags_audio_get_automation(audio);
+
+    ags_audio_timestamp_index_rebuild(audio->automation_index,
+				      automation,
+				      "line");
+
+    g_list_free_full(automation,
+		     (GDestroyNotify) g_object_unref);
+    
+    start_automation = ags_timestamp_index_find_all(audio->automation_index,
+						    line,
+						    x, length);
+  }
+
+  return(start_automation);
+}
+
 /**
  * ags_audio_get_wave:
  * @audio: the #AgsAudio
@@ -10974,9 +11354,15 @@ ags_audio_set_wave(AgsAudio *audio, GList *wave)
 
   start_wave = audio->wave;
   audio->wave = wave;
+  g_atomic_int_set(&(audio->wave_count),
+		   g_list_length(wave));
   
   g_rec_mutex_unlock(audio_mutex);
 
+  ags_audio_timestamp_index_rebuild(audio->wave_index,
+				    wave,
+				    "line");
+
   g_list_free_full(start_wave,
 		   (GDestroyNotify) g_object_unref);
 }
@@ -11017,6 +11403,7 @@ ags_audio_add_wave(AgsAudio *audio, GObject *wave)
     g_object_ref(wave);
     audio->wave = ags_wave_add(audio->wave,
 			       (AgsWave *) wave);
+    g_atomic_int_inc(&(audio->wave_count));
   }
   
   g_rec_mutex_unlock(audio_mutex);
@@ -11025,6 +11412,10 @@ ags_audio_add_wave(AgsAudio *audio, GObject *wave)
     g_object_set(wave,
 		 "audio", audio,
 		 NULL);
+
+    ags_audio_timestamp_index_insert(audio->wave_index,
+				     wave,
+				     "line");
   }
 }
 
@@ -11063,11 +11454,16 @@ ags_audio_remove_wave(AgsAudio *audio, GObject *wave)
     
     audio->wave = g_list_remove(audio->wave,
 				wave);
+    g_atomic_int_add(&(audio->wave_count),
+		     -1);
   }
   
   g_rec_mutex_unlock(audio_mutex);
 
   if(success){
+    ags_timestamp_index_remove(audio->wave_index,
+			       wave);
+
     g_object_set(wave,
 		 "audio", NULL,
 		 NULL);
@@ -11076,6 +11472,93 @@ ags_audio_remove_wave(AgsAudio *audio, GObject *wave)
   }
 }
 
+/**
+ * ags_audio_find_wave:
+ * @audio: the #AgsAudio
+ * @line: the line
+ * @x: the timestamp's offset aligned to %AGS_WAVE_DEFAULT_BUFFER_LENGTH times samplerate
+ *
+ * Find wave of @line starting within @x and @x + %AGS_WAVE_DEFAULT_BUFFER_LENGTH times
+ * the samplerate of @audio using the wave index. If the found wave was moved since it was
+ * added or nothing was found while the wave count exceeds the indexed wave, the index is rebuilt.
+ *
+ * Returns: (transfer full): the matching #AgsWave or %NULL
+ *
+ * Since: 3.7.0
+ */
+GObject*
+ags_audio_find_wave(AgsAudio *audio,
+		    guint line,
+		    guint64 x)
+{
+  GObject *wave;
+
+  GList *start_wave;
+  
+  guint64 length;
+  guint samplerate;
+  guint list_length;
+  gboolean rebuild;
+
+  GRecMutex *audio_mutex;
+
+  if(!AGS_IS_AUDIO(audio)){
+    return(NULL);
+  }
+
+  /* get audio mutex */
+  audio_mutex = AGS_AUDIO_GET_OBJ_MUTEX(audio);
+
+  g_rec_mutex_lock(audio_mutex);
+
+  samplerate = audio->samplerate;
+  
+  g_rec_mutex_unlock(audio_mutex);
+
+  length = (guint64) (AGS_WAVE_DEFAULT_BUFFER_LENGTH * samplerate);
+  
+  wave = ags_timestamp_index_find(audio->wave_index,
+				  line,
+				  x, length);
+
+  rebuild = FALSE;
+  
+  if(wave != NULL){
+    if(!ags_audio_timestamp_index_validate(wave,
+					   "line",
+					   line,
+					   x, length)){
+      g_object_unref(wave);
+
+      rebuild = TRUE;
+    }
+  }else{
+    /* a concurrent add might not be indexed yet */
+    list_length = g_atomic_int_get(&(audio->wave_count));
+
+    rebuild = !ags_audio_timestamp_index_is_complete(audio->wave_index,
+						     list_length);
+  }
+  
+  if(rebuild){
+    /* rebuild index */
+    start_wave = ags_audio_get_wave(audio);
+
+    ags_audio_timestamp_index_rebuild(audio->wave_index,
+				      start_wave,
+				      "line");
+
+    g_list_free_full(start_wave,
+		     (GDestroyNotify) g_object_unref);
+    
+    wave = ags_timestamp_index_find(audio->wave_index,
+				    line,
+				    x, length);
+  }
+
+  return(wave);
+}
+
 /**
  * ags_audio_get_output_audio_file:
  * @audio: the #AgsAudio
@@ -11606,6 +12089,9 @@ ags_audio_add_recall_id(AgsAudio *audio, GObject *recall_id)
   }
   
   g_rec_mutex_unlock(audio_mutex);
+
+  /* execution plan */
+  ags_execution_plan_invalidate();
 }
 
 /**
@@ -11641,6 +12127,9 @@ ags_audio_remove_recall_id(AgsAudio *audio, GObject *recall_id)
   }
   
   g_rec_mutex_unlock(audio_mutex);
+
+  /* execution plan */
+  ags_execution_plan_invalidate();
 }
 
 /**
@@ -12086,6 +12575,9 @@ ags_audio_add_recall(AgsAudio *audio, GObject *recall,
     g_rec_mutex_unlock(recall_mutex);
   }
 
+  /* execution plan */
+  ags_execution_plan_invalidate();
+
   if(success){
     if(AGS_IS_RECALL_AUDIO(recall) ||
        AGS_IS_RECALL_AUDIO_RUN(recall)){
@@ -12163,6 +12655,9 @@ ags_audio_insert_recall(AgsAudio *audio, GObject *recall,
     g_rec_mutex_unlock(recall_mutex);
   }
 
+  /* execution plan */
+  ags_execution_plan_invalidate();
+
   if(success){
     if(AGS_IS_RECALL_AUDIO(recall) ||
        AGS_IS_RECALL_AUDIO_RUN(recall)){
@@ -12229,6 +12724,9 @@ ags_audio_remove_recall(AgsAudio *audio, GObject *recall,
   }
 
 #if 0
+  /* execution plan */
+  ags_execution_plan_invalidate();
+
   if(success){
     if(AGS_IS_RECALL_AUDIO(recall) ||
        AGS_IS_RECALL_AUDIO_RUN(recall)){
@@ -15159,6 +15657,178 @@ ags_audio_recursive_run_stage(AgsAudio *audio,
   g_object_unref((GObject *) audio);
 }
 
+/**
+ * ags_audio_get_execution_plan:
+ * @audio: the #AgsAudio object
+ * @sound_scope: the sound scope
+ *
+ * Get the #AgsExecutionPlan of @audio's @sound_scope. The plan is compiled
+ * again if links, recall IDs or recalls changed since it was compiled.
+ *
+ * Returns: (transfer full): the #AgsExecutionPlan or %NULL
+ *
+ * Since: 3.7.0
+ */
+AgsExecutionPlan*
+ags_audio_get_execution_plan(AgsAudio *audio,
+			     gint sound_scope)
+{
+  AgsChannel *start_output;
+  AgsChannel *channel, *next_channel;
+  
+  AgsExecutionPlan *execution_plan;
+  
+  GRecMutex *audio_mutex;
+
+  if(!AGS_IS_AUDIO(audio) ||
+     sound_scope < 0 ||
+     sound_scope >= AGS_SOUND_SCOPE_LAST){
+    return(NULL);
+  }
+  
+  /* get audio mutex */
+  audio_mutex = AGS_AUDIO_GET_OBJ_MUTEX(audio);
+
+  /* get execution plan */
+  g_rec_mutex_lock(audio_mutex);
+
+  execution_plan = audio->execution_plan[sound_scope];
+
+  if(ags_execution_plan_is_valid(execution_plan)){
+    ags_execution_plan_ref(execution_plan);
+    
+    g_rec_mutex_unlock(audio_mutex);
+
+    return(execution_plan);
+  }
+  
+  g_rec_mutex_unlock(audio_mutex);
+
+  /* compile */
+  execution_plan = ags_execution_plan_alloc(sound_scope);
+
+  start_output = NULL;
+  
+  g_object_get(audio,
+	       "output", &start_output,
+	       NULL);
+
+  channel = start_output;
+
+  if(channel != NULL){
+    g_object_ref(channel);
+  }
+  
+  while(channel != NULL){
+    ags_channel_recursive_compile_run_stage(channel,
+					    execution_plan);
+
+    /* iterate */
+    next_channel = ags_channel_next(channel);
+
+    g_object_unref(channel);
+
+    channel = next_channel;
+  }
+
+  if(start_output != NULL){
+    g_object_unref(start_output);
+  }
+
+  /* replace */
+  g_rec_mutex_lock(audio_mutex);
+
+  if(audio->execution_plan[sound_scope] != NULL){
+    ags_execution_plan_unref(audio->execution_plan[sound_scope]);
+  }
+  
+  audio->execution_plan[sound_scope] = ags_execution_plan_ref(execution_plan);
+  
+  g_rec_mutex_unlock(audio_mutex);
+  
+  return(execution_plan);
+}
+
+/**
+ * ags_audio_run_execution_plan:
+ * @audio: the #AgsAudio object
+ * @sound_scope: the sound scope
+ * @staging_flags: the stage to run
+ *
+ * Run @staging_flags of @audio's @sound_scope using the flat #AgsExecutionPlan.
+ * Stages not supported by the plan are passed to ags_audio_recursive_run_stage().
+ *
+ * Since: 3.7.0
+ */
+void
+ags_audio_run_execution_plan(AgsAudio *audio,
+			     gint sound_scope, guint staging_flags)
+{
+  AgsExecutionPlan *execution_plan;
+  
+  g_return_if_fail(AGS_IS_AUDIO(audio));
+
+  if(!ags_execution_plan_test_staging_flags(staging_flags)){
+    ags_audio_recursive_run_stage(audio,
+				  sound_scope, staging_flags);
+
+    return;
+  }
+  
+  execution_plan = ags_audio_get_execution_plan(audio,
+						sound_scope);
+
+  if(execution_plan == NULL){
+    return;
+  }
+  
+  ags_execution_plan_run(execution_plan,
+			 staging_flags);
+
+  ags_execution_plan_unref(execution_plan);
+}
+
+/**
+ * ags_audio_get_modulation_source:
+ * @audio: the #AgsAudio object
+ *
+ * Get the #AgsModulationSource shared by the voices and effect recalls of
+ * @audio. It is created on first use with @audio's samplerate and buffer size.
+ *
+ * Returns: (transfer full): the #AgsModulationSource
+ *
+ * Since: 3.7.0
+ */
+AgsModulationSource*
+ags_audio_get_modulation_source(AgsAudio *audio)
+{
+  AgsModulationSource *modulation_source;
+  
+  GRecMutex *audio_mutex;
+
+  if(!AGS_IS_AUDIO(audio)){
+    return(NULL);
+  }
+  
+  /* get audio mutex */
+  audio_mutex = AGS_AUDIO_GET_OBJ_MUTEX(audio);
+
+  /* get modulation source */
+  g_rec_mutex_lock(audio_mutex);
+
+  if(audio->modulation_source == NULL){
+    audio->modulation_source = ags_modulation_source_new(audio->samplerate,
+							  audio->buffer_size);
+  }
+  
+  modulation_source = audio->modulation_source;
+  g_object_ref(modulation_source);
+  
+  g_rec_mutex_unlock(audio_mutex);
+  
+  return(modulation_source);
+}
+
 /**
  * ags_audio_new:
  * @output_soundcard: the #AgsSoundcard to use for output
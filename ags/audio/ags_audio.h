@@ -28,6 +28,9 @@
 #include <ags/audio/ags_sound_enums.h>
 #include <ags/audio/ags_channel.h>
 #include <ags/audio/ags_recall_id.h>
+#include <ags/audio/ags_timestamp_index.h>
+#include <ags/audio/ags_execution_plan.h>
+#include <ags/audio/ags_modulation_source.h>
 
 G_BEGIN_DECLS
 
@@ -172,11 +175,17 @@ struct _AgsAudio
   GList *cursor;
   
   GList *notation;
+  AgsTimestampIndex *notation_index;
+  volatile guint notation_count;
 
   gchar **automation_port;
   GList *automation;
+  AgsTimestampIndex *automation_index;
+  volatile guint automation_count;
   
   GList *wave;
+  AgsTimestampIndex *wave_index;
+  volatile guint wave_count;
   GObject *output_audio_file;
   GObject *input_audio_file;  
 
@@ -199,6 +208,10 @@ struct _AgsAudio
   GRecMutex recall_mutex;
 
   GList *recall;
+
+  AgsExecutionPlan *execution_plan[AGS_SOUND_SCOPE_LAST];
+
+  AgsModulationSource *modulation_source;
   
   gpointer machine_widget;
   gpointer file_data;
@@ -433,6 +446,10 @@ void ags_audio_set_notation(AgsAudio *audio, GList *notation);
 void ags_audio_add_notation(AgsAudio *audio, GObject *notation);
 void ags_audio_remove_notation(AgsAudio *audio, GObject *notation);
 
+GObject* ags_audio_find_notation(AgsAudio *audio,
+				 guint audio_channel,
+				 guint64 x);
+
 gchar** ags_audio_get_automation_port(AgsAudio *audio);
 void ags_audio_set_automation_port(AgsAudio *audio,
 				   gchar **automation_port);
@@ -446,12 +463,20 @@ void ags_audio_set_automation(AgsAudio *audio, GList *automation);
 void ags_audio_add_automation(AgsAudio *audio, GObject *automation);
 void ags_audio_remove_automation(AgsAudio *audio, GObject *automation);
 
+GList* ags_audio_find_automation(AgsAudio *audio,
+				 guint line,
+				 guint64 x);
+
 GList* ags_audio_get_wave(AgsAudio *audio);
 void ags_audio_set_wave(AgsAudio *audio, GList *wave);
 
 void ags_audio_add_wave(AgsAudio *audio, GObject *wave);
 void ags_audio_remove_wave(AgsAudio *audio, GObject *wave);
 
+GObject* ags_audio_find_wave(AgsAudio *audio,
+			     guint line,
+			     guint64 x);
+
 GObject* ags_audio_get_output_audio_file(AgsAudio *audio);
 void ags_audio_set_output_audio_file(AgsAudio *audio,
 				     GObject *output_audio_file);
@@ -579,6 +604,13 @@ void ags_audio_recursive_set_property(AgsAudio *audio,
 void ags_audio_recursive_run_stage(AgsAudio *audio,
 				   gint sound_scope, guint staging_flags);
 
+AgsExecutionPlan* ags_audio_get_execution_plan(AgsAudio *audio,
+					       gint sound_scope);
+void ags_audio_run_execution_plan(AgsAudio *audio,
+				  gint sound_scope, guint staging_flags);
+
+AgsModulationSource* ags_audio_get_modulation_source(AgsAudio *audio);
+
 /* instantiate */
 AgsAudio* ags_audio_new(GObject *output_soundcard);
 
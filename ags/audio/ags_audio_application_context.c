@@ -36,6 +36,7 @@
 #include <ags/audio/ags_recall_lv2_run.h>
 #include <ags/audio/ags_recall_dssi.h>
 #include <ags/audio/ags_recall_dssi_run.h>
+#include <ags/audio/ags_recall_load_util.h>
 
 #include <ags/audio/core-audio/ags_core_audio_midiin.h>
 #include <ags/audio/core-audio/ags_core_audio_server.h>
@@ -1818,6 +1819,28 @@ ags_audio_application_context_setup(AgsApplicationContext *application_context)
 
   log = ags_log_get_instance();
 
+  /* account the time spent in run stages only if asked for or a report is dumped */
+  str = ags_config_get_value(config,
+			     AGS_CONFIG_GENERIC,
+			     "dsp-load-accounting");
+
+  if(str != NULL &&
+     !g_ascii_strncasecmp(str, "true", 5)){
+    ags_recall_global_set_load_accounting(TRUE);
+  }
+
+  g_free(str);
+
+  str = ags_config_get_value(config,
+			     AGS_CONFIG_GENERIC,
+			     "dsp-load-report");
+
+  if(str != NULL){
+    ags_recall_global_set_load_accounting(TRUE);
+  }
+
+  g_free(str);
+
   /* main loop and task launcher */
   main_loop = ags_concurrency_provider_get_main_loop(AGS_CONCURRENCY_PROVIDER(application_context));
 
@@ -2255,8 +2278,11 @@ ags_audio_application_context_setup(AgsApplicationContext *application_context)
     if(AGS_IS_PULSE_DEVOUT(soundcard)){
       GList *start_port, *port;
 
+      guint port_format;
+      
       g_object_get(soundcard,
 		   "pulse-port", &start_port,
+		   "format", &port_format,
 		   NULL);
 
       port = start_port;
@@ -2269,7 +2295,7 @@ ags_audio_application_context_setup(AgsApplicationContext *application_context)
 	ags_pulse_port_set_buffer_size(port->data,
 				       buffer_size);
 	ags_pulse_port_set_format(port->data,
-				  format);
+				  port_format);
 	ags_pulse_port_set_cache_buffer_size(port->data,
 					     buffer_size * ceil(cache_buffer_size / buffer_size));
 	
@@ -3043,6 +3069,25 @@ ags_audio_application_context_quit(AgsApplicationContext *application_context)
 			     "autosave-thread");
   autosave_thread_enabled = (str != NULL && !g_ascii_strncasecmp(str, "true", 8)) ? TRUE: FALSE;
 
+  g_free(str);
+
+  /* DSP load report */
+  str = ags_config_get_value(config,
+			     AGS_CONFIG_GENERIC,
+			     "dsp-load-report");
+
+  if(str != NULL){
+    start_list = ags_sound_provider_get_audio(AGS_SOUND_PROVIDER(application_context));
+
+    ags_recall_load_util_dump_report(start_list,
+				     str);
+
+    g_list_free_full(start_list,
+		     g_object_unref);
+  }
+
+  g_free(str);
+  
   /* free managers */
   ladspa_manager = ags_ladspa_manager_get_instance();
   g_object_unref(ladspa_manager);
@@ -0,0 +1,496 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ags/audio/ags_audio_buffer_kernel.h>
+
+#include <string.h>
+
+/**
+ * SECTION:ags_audio_buffer_kernel
+ * @short_description: SIMD kernels for audio buffer copy
+ * @title: AgsAudioBufferKernel
+ * @section_id:
+ * @include: ags/audio/ags_audio_buffer_kernel.h
+ *
+ * The audio buffer kernel functions implement the additive copy of
+ * equal formats with real vector loads and stores. The instruction set
+ * is selected once at runtime using CPUID. The destination and the source
+ * need to be either contiguous or interleaved with stride 2, 4 or 8. An
+ * interleaved destination is written only at the samples of its channel.
+ * The functions return %FALSE for any other layout so the caller can
+ * fallback to the generic code.
+ */
+
+#if defined(AGS_VECTORIZED_BUILTIN_FUNCTIONS) && (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define AGS_AUDIO_BUFFER_KERNEL_X86 (1)
+#endif
+
+#define AGS_AUDIO_BUFFER_KERNEL_MAX_STRIDE (8)
+
+/* below this count of useful lanes per vector the generic code is faster */
+#define AGS_AUDIO_BUFFER_KERNEL_MIN_STRIDED_LANES (4)
+
+static volatile gsize ags_audio_buffer_kernel_isa_initialized = 0;
+static volatile gint ags_audio_buffer_kernel_isa = AGS_AUDIO_BUFFER_KERNEL_ISA_NONE;
+
+#if defined(AGS_AUDIO_BUFFER_KERNEL_X86)
+
+/*
+ * An interleaved buffer is gathered by loading full vectors and shuffle
+ * the lanes of interest. The stride is passed as constant so the shuffle
+ * masks are folded at compile time. A stride of 1 is a plain load.
+ */
+#define AGS_AUDIO_BUFFER_KERNEL_GATHER(v_result, v_part, v_even, ptr, stride, lanes, vector_bytes) { \
+    guint l_k, l_n;							\
+									\
+    if(stride == 1){							\
+      memcpy(&(v_result), (ptr), vector_bytes);				\
+    }else{								\
+      _Pragma("GCC unroll 8")						\
+      for(l_k = 0; l_k < stride; l_k++){				\
+	memcpy(&(v_part[l_k]), (ptr) + (l_k * lanes), vector_bytes);	\
+      }									\
+									\
+      _Pragma("GCC unroll 8")						\
+      for(l_n = stride; l_n > 1; l_n /= 2){				\
+	_Pragma("GCC unroll 8")						\
+	for(l_k = 0; l_k < l_n / 2; l_k++){				\
+	  v_part[l_k] = __builtin_shuffle(v_part[2 * l_k], v_part[2 * l_k + 1], v_even); \
+	}								\
+      }									\
+									\
+      v_result = v_part[0];						\
+    }									\
+  }
+
+/*
+ * The kernel body is instantiated per format and instruction set. Since
+ * target specific vector width is used the compiler emits real unaligned
+ * vector loads and stores.
+ *
+ * An interleaved destination is gathered the same way as the source, but
+ * the sum is scattered back lane by lane. Full vector stores would rewrite
+ * the samples of the other channels, which are mixed concurrently by other
+ * threads.
+ */
+#define AGS_AUDIO_BUFFER_KERNEL_COPY(isa_name, target_isa, vector_bytes, data_type, index_type, suffix) \
+  static inline void __attribute__ ((target(target_isa), always_inline)) \
+  ags_audio_buffer_kernel_copy_##suffix##_##isa_name##_with_stride(data_type *destination, guint dchannels, \
+								   data_type *source, guint schannels, \
+								   guint count, \
+								   const guint dstride, const guint sstride) \
+  {									\
+    typedef data_type v_data __attribute__ ((vector_size(vector_bytes))); \
+    typedef index_type v_index __attribute__ ((vector_size(vector_bytes))); \
+									\
+    v_data v_destination, v_source;					\
+    v_data v_part[AGS_AUDIO_BUFFER_KERNEL_MAX_STRIDE];			\
+    v_index v_even;							\
+									\
+    const guint lanes = vector_bytes / sizeof(data_type);		\
+    guint i, j, n;							\
+									\
+    i = 0;								\
+									\
+    _Pragma("GCC unroll 64")						\
+    for(j = 0; j < lanes; j++){						\
+      v_even[j] = 2 * j;						\
+    }									\
+									\
+    /* a gather doesn't read past the last sample of its channel */	\
+    for(; (i + lanes) * dstride <= ((count - 1) * dstride) + 1 &&	\
+	  (i + lanes) * sstride <= ((count - 1) * sstride) + 1; i += lanes){ \
+      AGS_AUDIO_BUFFER_KERNEL_GATHER(v_source, v_part, v_even, source + (i * sstride), sstride, lanes, vector_bytes); \
+      AGS_AUDIO_BUFFER_KERNEL_GATHER(v_destination, v_part, v_even, destination + (i * dstride), dstride, lanes, vector_bytes); \
+									\
+      v_destination += v_source;					\
+									\
+      if(dstride == 1){							\
+	memcpy(destination + i, &v_destination, vector_bytes);		\
+      }else{								\
+	/* scatter only the lanes of this channel */			\
+	_Pragma("GCC unroll 64")					\
+	for(j = 0; j < lanes; j++){					\
+	  destination[(i + j) * dstride] = v_destination[j];		\
+	}								\
+      }									\
+    }									\
+									\
+    /* remaining frames */						\
+    for(; i < count; i += n){						\
+      n = MIN(lanes, count - i);					\
+									\
+      memset(&v_destination, 0, vector_bytes);				\
+      memset(&v_source, 0, vector_bytes);				\
+									\
+      for(j = 0; j < n; j++){						\
+	v_destination[j] = destination[(i + j) * dchannels];		\
+	v_source[j] = source[(i + j) * schannels];			\
+      }									\
+									\
+      v_destination += v_source;					\
+									\
+      for(j = 0; j < n; j++){						\
+	destination[(i + j) * dchannels] = v_destination[j];		\
+      }									\
+    }									\
+  }									\
+									\
+  static inline void __attribute__ ((target(target_isa), always_inline)) \
+  ags_audio_buffer_kernel_copy_##suffix##_##isa_name##_with_dstride(data_type *destination, guint dchannels, \
+								    data_type *source, guint schannels, \
+								    guint count, \
+								    const guint dstride) \
+  {									\
+    switch(schannels){							\
+    case 1:								\
+      ags_audio_buffer_kernel_copy_##suffix##_##isa_name##_with_stride(destination, dchannels, source, schannels, count, dstride, 1); \
+      break;								\
+    case 2:								\
+      ags_audio_buffer_kernel_copy_##suffix##_##isa_name##_with_stride(destination, dchannels, source, schannels, count, dstride, 2); \
+      break;								\
+    case 4:								\
+      ags_audio_buffer_kernel_copy_##suffix##_##isa_name##_with_stride(destination, dchannels, source, schannels, count, dstride, 4); \
+      break;								\
+    case 8:								\
+      ags_audio_buffer_kernel_copy_##suffix##_##isa_name##_with_stride(destination, dchannels, source, schannels, count, dstride, 8); \
+      break;								\
+    }									\
+  }									\
+									\
+  static gboolean __attribute__ ((target(target_isa)))			\
+  ags_audio_buffer_kernel_copy_##suffix##_##isa_name(data_type *destination, guint dchannels, \
+						     data_type *source, guint schannels, \
+						     guint count)		\
+  {									\
+    guint stride;							\
+									\
+    stride = MAX(dchannels, schannels);					\
+									\
+    if(!ags_audio_buffer_kernel_test_stride(dchannels, schannels) ||	\
+       (stride > 1 &&							\
+	(vector_bytes / sizeof(data_type)) / stride < AGS_AUDIO_BUFFER_KERNEL_MIN_STRIDED_LANES)){ \
+      return(FALSE);							\
+    }									\
+									\
+    if(count == 0){							\
+      return(TRUE);							\
+    }									\
+									\
+    switch(dchannels){							\
+    case 1:								\
+      ags_audio_buffer_kernel_copy_##suffix##_##isa_name##_with_dstride(destination, dchannels, source, schannels, count, 1); \
+      break;								\
+    case 2:								\
+      ags_audio_buffer_kernel_copy_##suffix##_##isa_name##_with_dstride(destination, dchannels, source, schannels, count, 2); \
+      break;								\
+    case 4:								\
+      ags_audio_buffer_kernel_copy_##suffix##_##isa_name##_with_dstride(destination, dchannels, source, schannels, count, 4); \
+      break;								\
+    case 8:								\
+      ags_audio_buffer_kernel_copy_##suffix##_##isa_name##_with_dstride(destination, dchannels, source, schannels, count, 8); \
+      break;								\
+    }									\
+									\
+    return(TRUE);							\
+  }
+
+#define AGS_AUDIO_BUFFER_KERNEL_COPY_ALL(isa_name, target_isa, vector_bytes) \
+  AGS_AUDIO_BUFFER_KERNEL_COPY(isa_name, target_isa, vector_bytes, gint8, gint8, s8_to_s8) \
+  AGS_AUDIO_BUFFER_KERNEL_COPY(isa_name, target_isa, vector_bytes, gint16, gint16, s16_to_s16) \
+  AGS_AUDIO_BUFFER_KERNEL_COPY(isa_name, target_isa, vector_bytes, gint32, gint32, s32_to_s32) \
+  AGS_AUDIO_BUFFER_KERNEL_COPY(isa_name, target_isa, vector_bytes, gint64, gint64, s64_to_s64) \
+  AGS_AUDIO_BUFFER_KERNEL_COPY(isa_name, target_isa, vector_bytes, gfloat, gint32, float_to_float) \
+  AGS_AUDIO_BUFFER_KERNEL_COPY(isa_name, target_isa, vector_bytes, gdouble, gint64, double_to_double)
+
+AGS_AUDIO_BUFFER_KERNEL_COPY_ALL(sse2, "sse2", 16)
+AGS_AUDIO_BUFFER_KERNEL_COPY_ALL(avx2, "avx2", 32)
+AGS_AUDIO_BUFFER_KERNEL_COPY_ALL(avx512, "avx512f,avx512bw", 64)
+
+#define AGS_AUDIO_BUFFER_KERNEL_DISPATCH(suffix, destination, dchannels, source, schannels, count) { \
+    switch(ags_audio_buffer_kernel_get_isa()){				\
+    case AGS_AUDIO_BUFFER_KERNEL_ISA_AVX512:				\
+      return(ags_audio_buffer_kernel_copy_##suffix##_avx512(destination, dchannels, source, schannels, count)); \
+    case AGS_AUDIO_BUFFER_KERNEL_ISA_AVX2:				\
+      return(ags_audio_buffer_kernel_copy_##suffix##_avx2(destination, dchannels, source, schannels, count)); \
+    case AGS_AUDIO_BUFFER_KERNEL_ISA_SSE2:				\
+      return(ags_audio_buffer_kernel_copy_##suffix##_sse2(destination, dchannels, source, schannels, count)); \
+    }									\
+  }
+#else
+#define AGS_AUDIO_BUFFER_KERNEL_DISPATCH(suffix, destination, dchannels, source, schannels, count)
+#endif
+
+/**
+ * ags_audio_buffer_kernel_get_supported_isa:
+ *
+ * Get the widest instruction set supported by the running CPU and
+ * available in this build.
+ *
+ * Returns: the #AgsAudioBufferKernelIsa
+ *
+ * Since: 3.7.0
+ */
+guint
+ags_audio_buffer_kernel_get_supported_isa()
+{
+  guint isa;
+
+  isa = AGS_AUDIO_BUFFER_KERNEL_ISA_NONE;
+
+#if defined(AGS_AUDIO_BUFFER_KERNEL_X86)
+  __builtin_cpu_init();
+
+  if(__builtin_cpu_supports("avx512f") &&
+     __builtin_cpu_supports("avx512bw")){
+    isa = AGS_AUDIO_BUFFER_KERNEL_ISA_AVX512;
+  }else if(__builtin_cpu_supports("avx2")){
+    isa = AGS_AUDIO_BUFFER_KERNEL_ISA_AVX2;
+  }else if(__builtin_cpu_supports("sse2")){
+    isa = AGS_AUDIO_BUFFER_KERNEL_ISA_SSE2;
+  }
+#endif
+
+  return(isa);
+}
+
+/**
+ * ags_audio_buffer_kernel_get_isa:
+ *
+ * Get the instruction set used by the kernels. It is detected at first
+ * call.
+ *
+ * Returns: the #AgsAudioBufferKernelIsa in use
+ *
+ * Since: 3.7.0
+ */
+guint
+ags_audio_buffer_kernel_get_isa()
+{
+  if(g_once_init_enter(&ags_audio_buffer_kernel_isa_initialized)){
+    g_atomic_int_set(&ags_audio_buffer_kernel_isa,
+		     ags_audio_buffer_kernel_get_supported_isa());
+
+    g_once_init_leave(&ags_audio_buffer_kernel_isa_initialized, 1);
+  }
+
+  return(g_atomic_int_get(&ags_audio_buffer_kernel_isa));
+}
+
+/**
+ * ags_audio_buffer_kernel_set_isa:
+ * @isa: the #AgsAudioBufferKernelIsa
+ *
+ * Restrict the kernels to @isa. It is clamped to the supported
+ * instruction set, pass %AGS_AUDIO_BUFFER_KERNEL_ISA_NONE to disable
+ * the kernels.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_audio_buffer_kernel_set_isa(guint isa)
+{
+  guint supported_isa;
+
+  /* make sure detection did happen */
+  ags_audio_buffer_kernel_get_isa();
+
+  supported_isa = ags_audio_buffer_kernel_get_supported_isa();
+
+  g_atomic_int_set(&ags_audio_buffer_kernel_isa,
+		   MIN(isa, supported_isa));
+}
+
+/**
+ * ags_audio_buffer_kernel_test_stride:
+ * @dchannels: destination buffer's count of channels
+ * @schannels: source buffer's count of channels
+ *
+ * Test if the kernels have a fast path for the given channel layout.
+ * The destination and the source need to be either contiguous or
+ * interleaved with stride 2, 4 or 8.
+ *
+ * Returns: %TRUE if supported, else %FALSE
+ *
+ * Since: 3.7.0
+ */
+gboolean
+ags_audio_buffer_kernel_test_stride(guint dchannels, guint schannels)
+{
+  if(dchannels != 1 &&
+     dchannels != 2 &&
+     dchannels != 4 &&
+     dchannels != 8){
+    return(FALSE);
+  }
+
+  if(schannels == 1 ||
+     schannels == 2 ||
+     schannels == 4 ||
+     schannels == 8){
+    return(TRUE);
+  }
+
+  return(FALSE);
+}
+
+/**
+ * ags_audio_buffer_kernel_copy_s8_to_s8:
+ * @destination: destination buffer
+ * @dchannels: destination buffer's count of channels
+ * @source: source buffer
+ * @schannels: source buffer's count of channels
+ * @count: number of frames to copy
+ *
+ * Copy audio data using additive strategy.
+ *
+ * Returns: %TRUE if copied, %FALSE if there is no kernel for the layout
+ *
+ * Since: 3.7.0
+ */
+gboolean
+ags_audio_buffer_kernel_copy_s8_to_s8(gint8 *destination, guint dchannels,
+				      gint8 *source, guint schannels,
+				      guint count)
+{
+  AGS_AUDIO_BUFFER_KERNEL_DISPATCH(s8_to_s8, destination, dchannels, source, schannels, count);
+
+  return(FALSE);
+}
+
+/**
+ * ags_audio_buffer_kernel_copy_s16_to_s16:
+ * @destination: destination buffer
+ * @dchannels: destination buffer's count of channels
+ * @source: source buffer
+ * @schannels: source buffer's count of channels
+ * @count: number of frames to copy
+ *
+ * Copy audio data using additive strategy.
+ *
+ * Returns: %TRUE if copied, %FALSE if there is no kernel for the layout
+ *
+ * Since: 3.7.0
+ */
+gboolean
+ags_audio_buffer_kernel_copy_s16_to_s16(gint16 *destination, guint dchannels,
+					gint16 *source, guint schannels,
+					guint count)
+{
+  AGS_AUDIO_BUFFER_KERNEL_DISPATCH(s16_to_s16, destination, dchannels, source, schannels, count);
+
+  return(FALSE);
+}
+
+/**
+ * ags_audio_buffer_kernel_copy_s32_to_s32:
+ * @destination: destination buffer
+ * @dchannels: destination buffer's count of channels
+ * @source: source buffer
+ * @schannels: source buffer's count of channels
+ * @count: number of frames to copy
+ *
+ * Copy audio data using additive strategy. Used for signed 24 and 32 bit
+ * both stored as 32 bit integer.
+ *
+ * Returns: %TRUE if copied, %FALSE if there is no kernel for the layout
+ *
+ * Since: 3.7.0
+ */
+gboolean
+ags_audio_buffer_kernel_copy_s32_to_s32(gint32 *destination, guint dchannels,
+					gint32 *source, guint schannels,
+					guint count)
+{
+  AGS_AUDIO_BUFFER_KERNEL_DISPATCH(s32_to_s32, destination, dchannels, source, schannels, count);
+
+  return(FALSE);
+}
+
+/**
+ * ags_audio_buffer_kernel_copy_s64_to_s64:
+ * @destination: destination buffer
+ * @dchannels: destination buffer's count of channels
+ * @source: source buffer
+ * @schannels: source buffer's count of channels
+ * @count: number of frames to copy
+ *
+ * Copy audio data using additive strategy.
+ *
+ * Returns: %TRUE if copied, %FALSE if there is no kernel for the layout
+ *
+ * Since: 3.7.0
+ */
+gboolean
+ags_audio_buffer_kernel_copy_s64_to_s64(gint64 *destination, guint dchannels,
+					gint64 *source, guint schannels,
+					guint count)
+{
+  AGS_AUDIO_BUFFER_KERNEL_DISPATCH(s64_to_s64, destination, dchannels, source, schannels, count);
+
+  return(FALSE);
+}
+
+/**
+ * ags_audio_buffer_kernel_copy_float_to_float:
+ * @destination: destination buffer
+ * @dchannels: destination buffer's count of channels
+ * @source: source buffer
+ * @schannels: source buffer's count of channels
+ * @count: number of frames to copy
+ *
+ * Copy audio data using additive strategy.
+ *
+ * Returns: %TRUE if copied, %FALSE if there is no kernel for the layout
+ *
+ * Since: 3.7.0
+ */
+gboolean
+ags_audio_buffer_kernel_copy_float_to_float(gfloat *destination, guint dchannels,
+					    gfloat *source, guint schannels,
+					    guint count)
+{
+  AGS_AUDIO_BUFFER_KERNEL_DISPATCH(float_to_float, destination, dchannels, source, schannels, count);
+
+  return(FALSE);
+}
+
+/**
+ * ags_audio_buffer_kernel_copy_double_to_double:
+ * @destination: destination buffer
+ * @dchannels: destination buffer's count of channels
+ * @source: source buffer
+ * @schannels: source buffer's count of channels
+ * @count: number of frames to copy
+ *
+ * Copy audio data using additive strategy.
+ *
+ * Returns: %TRUE if copied, %FALSE if there is no kernel for the layout
+ *
+ * Since: 3.7.0
+ */
+gboolean
+ags_audio_buffer_kernel_copy_double_to_double(gdouble *destination, guint dchannels,
+					      gdouble *source, guint schannels,
+					      guint count)
+{
+  AGS_AUDIO_BUFFER_KERNEL_DISPATCH(double_to_double, destination, dchannels, source, schannels, count);
+
+  return(FALSE);
+}
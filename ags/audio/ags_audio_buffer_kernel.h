@@ -0,0 +1,73 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __AGS_AUDIO_BUFFER_KERNEL_H__
+#define __AGS_AUDIO_BUFFER_KERNEL_H__
+
+#include <glib.h>
+#include <glib-object.h>
+
+G_BEGIN_DECLS
+
+/**
+ * AgsAudioBufferKernelIsa:
+ * @AGS_AUDIO_BUFFER_KERNEL_ISA_NONE: no kernel available, use generic code
+ * @AGS_AUDIO_BUFFER_KERNEL_ISA_SSE2: 128 bit SSE2 kernels
+ * @AGS_AUDIO_BUFFER_KERNEL_ISA_AVX2: 256 bit AVX2 kernels
+ * @AGS_AUDIO_BUFFER_KERNEL_ISA_AVX512: 512 bit AVX-512 kernels
+ *
+ * #AgsAudioBufferKernelIsa specifies the instruction set the kernels
+ * were compiled for, ordered by vector width.
+ */
+typedef enum{
+  AGS_AUDIO_BUFFER_KERNEL_ISA_NONE,
+  AGS_AUDIO_BUFFER_KERNEL_ISA_SSE2,
+  AGS_AUDIO_BUFFER_KERNEL_ISA_AVX2,
+  AGS_AUDIO_BUFFER_KERNEL_ISA_AVX512,
+}AgsAudioBufferKernelIsa;
+
+guint ags_audio_buffer_kernel_get_supported_isa();
+
+guint ags_audio_buffer_kernel_get_isa();
+void ags_audio_buffer_kernel_set_isa(guint isa);
+
+gboolean ags_audio_buffer_kernel_test_stride(guint dchannels, guint schannels);
+
+gboolean ags_audio_buffer_kernel_copy_s8_to_s8(gint8 *destination, guint dchannels,
+					       gint8 *source, guint schannels,
+					       guint count);
+gboolean ags_audio_buffer_kernel_copy_s16_to_s16(gint16 *destination, guint dchannels,
+						 gint16 *source, guint schannels,
+						 guint count);
+gboolean ags_audio_buffer_kernel_copy_s32_to_s32(gint32 *destination, guint dchannels,
+						 gint32 *source, guint schannels,
+						 guint count);
+gboolean ags_audio_buffer_kernel_copy_s64_to_s64(gint64 *destination, guint dchannels,
+						 gint64 *source, guint schannels,
+						 guint count);
+gboolean ags_audio_buffer_kernel_copy_float_to_float(gfloat *destination, guint dchannels,
+						     gfloat *source, guint schannels,
+						     guint count);
+gboolean ags_audio_buffer_kernel_copy_double_to_double(gdouble *destination, guint dchannels,
+						       gdouble *source, guint schannels,
+						       guint count);
+
+G_END_DECLS
+
+#endif /*__AGS_AUDIO_BUFFER_KERNEL_H__*/
@@ -19,9 +19,10 @@
 
 #include <ags/audio/ags_audio_buffer_util.h>
 
-#include <ags/libags.h>
+#include <ags/audio/ags_audio_buffer_kernel.h>
+#include <ags/audio/ags_resampler.h>
 
-#include <samplerate.h>
+#include <ags/libags.h>
 
 #include <stdlib.h>
 #include <string.h>
@@ -3747,36 +3748,33 @@ ags_audio_buffer_util_resample_s8(gint8 *buffer, guint channels,
 				  guint buffer_length,
 				  guint target_samplerate)
 {
-  SRC_DATA secret_rabbit;
+  AgsResampler *resampler;
 
   gint8 *ret_buffer;
 
-  secret_rabbit.src_ratio = target_samplerate / samplerate;
+  guint target_buffer_length;
 
-  secret_rabbit.input_frames = buffer_length;
-  secret_rabbit.data_in = (gfloat *) malloc(channels * buffer_length * sizeof(gfloat));
-  ags_audio_buffer_util_clear_float(secret_rabbit.data_in, channels,
-				    buffer_length);
-  ags_audio_buffer_util_copy_s8_to_float(secret_rabbit.data_in, channels,
-					 buffer, channels,
-					 buffer_length);
+  resampler = ags_resampler_get_thread_default();
 
-  secret_rabbit.output_frames = ceil(secret_rabbit.src_ratio * buffer_length);
-  secret_rabbit.data_out = (gfloat *) malloc(channels * secret_rabbit.output_frames * sizeof(gfloat));
-  
-  src_simple(&secret_rabbit,
-	     SRC_SINC_BEST_QUALITY,
-	     channels);
+  ags_resampler_set_audio_channels(resampler,
+				   channels);
+  ags_resampler_set_samplerate(resampler,
+			       samplerate);
+  ags_resampler_set_target_samplerate(resampler,
+				      target_samplerate);
 
-  ret_buffer = (gint8 *) malloc(channels * (ceil((gdouble) buffer_length / (gdouble) samplerate * (gdouble) target_samplerate)) * sizeof(gint8));
-  memset(ret_buffer, 0, (ceil((gdouble) buffer_length / (gdouble) samplerate * (gdouble) target_samplerate)) * sizeof(gint8));
-  ags_audio_buffer_util_copy_float_to_s8(ret_buffer, channels,
-					 secret_rabbit.data_out, channels,
-					 (ceil((gdouble) buffer_length / (gdouble) samplerate * (gdouble) target_samplerate)));
+  target_buffer_length = ags_resampler_get_target_length(resampler,
+							 buffer_length);
+
+  ret_buffer = (gint8 *) malloc(channels * target_buffer_length * sizeof(gint8));
+  memset(ret_buffer, 0, channels * target_buffer_length * sizeof(gint8));
+
+  ags_resampler_convert(resampler,
+			buffer, AGS_AUDIO_BUFFER_UTIL_S8,
+			buffer_length,
+			ret_buffer, AGS_AUDIO_BUFFER_UTIL_S8,
+			target_buffer_length);
 
-  free(secret_rabbit.data_out);
-  free(secret_rabbit.data_in);
-  
   return(ret_buffer);
 }
 
@@ -3800,35 +3798,32 @@ ags_audio_buffer_util_resample_s16(gint16 *buffer, guint channels,
 				   guint buffer_length,
 				   guint target_samplerate)
 {
-  SRC_DATA secret_rabbit;
+  AgsResampler *resampler;
 
   gint16 *ret_buffer;
 
-  secret_rabbit.src_ratio = target_samplerate / samplerate;
+  guint target_buffer_length;
 
-  secret_rabbit.input_frames = buffer_length;
-  secret_rabbit.data_in = (gfloat *) malloc(channels * buffer_length * sizeof(gfloat));
-  ags_audio_buffer_util_clear_float(secret_rabbit.data_in, channels,
-				    buffer_length);
-  ags_audio_buffer_util_copy_s16_to_float(secret_rabbit.data_in, channels,
-					  buffer, channels,
-					  buffer_length);
+  resampler = ags_resampler_get_thread_default();
 
-  secret_rabbit.output_frames = ceil(secret_rabbit.src_ratio * buffer_length);
-  secret_rabbit.data_out = (gfloat *) malloc(channels * secret_rabbit.output_frames * sizeof(gfloat));
-  
-  src_simple(&secret_rabbit,
-	     SRC_SINC_BEST_QUALITY,
-	     channels);
+  ags_resampler_set_audio_channels(resampler,
+				   channels);
+  ags_resampler_set_samplerate(resampler,
+			       samplerate);
+  ags_resampler_set_target_samplerate(resampler,
+				      target_samplerate);
 
-  ret_buffer = (gint16 *) malloc(channels * (ceil((gdouble) buffer_length / (gdouble) samplerate * (gdouble) target_samplerate)) * sizeof(gint16));
-  memset(ret_buffer, 0, (ceil((gdouble) buffer_length / (gdouble) samplerate * (gdouble) target_samplerate)) * sizeof(gint16));
-  ags_audio_buffer_util_copy_float_to_s16(ret_buffer, channels,
-					  secret_rabbit.data_out, channels,
-					  (ceil((gdouble) buffer_length / (gdouble) samplerate * (gdouble) target_samplerate)));
+  target_buffer_length = ags_resampler_get_target_length(resampler,
+							 buffer_length);
 
-  free(secret_rabbit.data_out);
-  free(secret_rabbit.data_in);
+  ret_buffer = (gint16 *) malloc(channels * target_buffer_length * sizeof(gint16));
+  memset(ret_buffer, 0, channels * target_buffer_length * sizeof(gint16));
+
+  ags_resampler_convert(resampler,
+			buffer, AGS_AUDIO_BUFFER_UTIL_S16,
+			buffer_length,
+			ret_buffer, AGS_AUDIO_BUFFER_UTIL_S16,
+			target_buffer_length);
 
   return(ret_buffer);
 }
@@ -3853,35 +3848,32 @@ ags_audio_buffer_util_resample_s24(gint32 *buffer, guint channels,
 				   guint buffer_length,
 				   guint target_samplerate)
 {
-  SRC_DATA secret_rabbit;
+  AgsResampler *resampler;
 
   gint32 *ret_buffer;
 
-  secret_rabbit.src_ratio = target_samplerate / samplerate;
+  guint target_buffer_length;
 
-  secret_rabbit.input_frames = buffer_length;
-  secret_rabbit.data_in = (gfloat *) malloc(channels * buffer_length * sizeof(gfloat));
-  ags_audio_buffer_util_clear_float(secret_rabbit.data_in, channels,
-				    buffer_length);
-  ags_audio_buffer_util_copy_s24_to_float(secret_rabbit.data_in, channels,
-					  buffer, channels,
-					  buffer_length);
+  resampler = ags_resampler_get_thread_default();
 
-  secret_rabbit.output_frames = ceil(secret_rabbit.src_ratio * buffer_length);
-  secret_rabbit.data_out = (gfloat *) malloc(channels * secret_rabbit.output_frames * sizeof(gfloat));
-  
-  src_simple(&secret_rabbit,
-	     SRC_SINC_BEST_QUALITY,
-	     channels);
+  ags_resampler_set_audio_channels(resampler,
+				   channels);
+  ags_resampler_set_samplerate(resampler,
+			       samplerate);
+  ags_resampler_set_target_samplerate(resampler,
+				      target_samplerate);
 
-  ret_buffer = (gint32 *) malloc(channels * (ceil((gdouble) buffer_length / (gdouble) samplerate * (gdouble) target_samplerate)) * sizeof(gint32));
-  memset(ret_buffer, 0, (ceil((gdouble) buffer_length / (gdouble) samplerate * (gdouble) target_samplerate)) * sizeof(gint32));
-  ags_audio_buffer_util_copy_float_to_s24(ret_buffer, channels,
-					  secret_rabbit.data_out, channels,
-					  (ceil((gdouble) buffer_length / (gdouble) samplerate * (gdouble) target_samplerate)));
+  target_buffer_length = ags_resampler_get_target_length(resampler,
+							 buffer_length);
 
-  free(secret_rabbit.data_out);
-  free(secret_rabbit.data_in);
+  ret_buffer = (gint32 *) malloc(channels * target_buffer_length * sizeof(gint32));
+  memset(ret_buffer, 0, channels * target_buffer_length * sizeof(gint32));
+
+  ags_resampler_convert(resampler,
+			buffer, AGS_AUDIO_BUFFER_UTIL_S24,
+			buffer_length,
+			ret_buffer, AGS_AUDIO_BUFFER_UTIL_S24,
+			target_buffer_length);
 
   return(ret_buffer);
 }
@@ -3906,35 +3898,32 @@ ags_audio_buffer_util_resample_s32(gint32 *buffer, guint channels,
 				   guint buffer_length,
 				   guint target_samplerate)
 {
-  SRC_DATA secret_rabbit;
+  AgsResampler *resampler;
 
   gint32 *ret_buffer;
 
-  secret_rabbit.src_ratio = target_samplerate / samplerate;
+  guint target_buffer_length;
 
-  secret_rabbit.input_frames = buffer_length;
-  secret_rabbit.data_in = (gfloat *) malloc(channels * buffer_length * sizeof(gfloat));
-  ags_audio_buffer_util_clear_float(secret_rabbit.data_in, channels,
-				    buffer_length);
-  ags_audio_buffer_util_copy_s32_to_float(secret_rabbit.data_in, channels,
-					  buffer, channels,
-					  buffer_length);
+  resampler = ags_resampler_get_thread_default();
 
-  secret_rabbit.output_frames = ceil(secret_rabbit.src_ratio * buffer_length);
-  secret_rabbit.data_out = (gfloat *) malloc(channels * secret_rabbit.output_frames * sizeof(gfloat));
-  
-  src_simple(&secret_rabbit,
-	     SRC_SINC_BEST_QUALITY,
-	     channels);
+  ags_resampler_set_audio_channels(resampler,
+				   channels);
+  ags_resampler_set_samplerate(resampler,
+			       samplerate);
+  ags_resampler_set_target_samplerate(resampler,
+				      target_samplerate);
 
-  ret_buffer = (gint32 *) malloc(channels * (ceil((gdouble) buffer_length / (gdouble) samplerate * (gdouble) target_samplerate)) * sizeof(gint32));
-  memset(ret_buffer, 0, (ceil((gdouble) buffer_length / (gdouble) samplerate * (gdouble) target_samplerate)) * sizeof(gint32));
-  ags_audio_buffer_util_copy_float_to_s32(ret_buffer, channels,
-					  secret_rabbit.data_out, channels,
-					  (ceil((gdouble) buffer_length / (gdouble) samplerate * (gdouble) target_samplerate)));
+  target_buffer_length = ags_resampler_get_target_length(resampler,
+							 buffer_length);
 
-  free(secret_rabbit.data_out);
-  free(secret_rabbit.data_in);
+  ret_buffer = (gint32 *) malloc(channels * target_buffer_length * sizeof(gint32));
+  memset(ret_buffer, 0, channels * target_buffer_length * sizeof(gint32));
+
+  ags_resampler_convert(resampler,
+			buffer, AGS_AUDIO_BUFFER_UTIL_S32,
+			buffer_length,
+			ret_buffer, AGS_AUDIO_BUFFER_UTIL_S32,
+			target_buffer_length);
 
   return(ret_buffer);
 }
@@ -3959,35 +3948,32 @@ ags_audio_buffer_util_resample_s64(gint64 *buffer, guint channels,
 				   guint buffer_length,
 				   guint target_samplerate)
 {
-  SRC_DATA secret_rabbit;
+  AgsResampler *resampler;
 
   gint64 *ret_buffer;
 
-  secret_rabbit.src_ratio = target_samplerate / samplerate;
+  guint target_buffer_length;
 
-  secret_rabbit.input_frames = buffer_length;
-  secret_rabbit.data_in = (gfloat *) malloc(channels * buffer_length * sizeof(gfloat));
-  ags_audio_buffer_util_clear_float(secret_rabbit.data_in, channels,
-				    buffer_length);
-  ags_audio_buffer_util_copy_s64_to_float(secret_rabbit.data_in, channels,
-					  buffer, channels,
-					  buffer_length);
+  resampler = ags_resampler_get_thread_default();
 
-  secret_rabbit.output_frames = ceil(secret_rabbit.src_ratio * buffer_length);
-  secret_rabbit.data_out = (gfloat *) malloc(channels * secret_rabbit.output_frames * sizeof(gfloat));
-  
-  src_simple(&secret_rabbit,
-	     SRC_SINC_BEST_QUALITY,
-	     channels);
+  ags_resampler_set_audio_channels(resampler,
+				   channels);
+  ags_resampler_set_samplerate(resampler,
+			       samplerate);
+  ags_resampler_set_target_samplerate(resampler,
+				      target_samplerate);
 
-  ret_buffer = (gint64 *) malloc(channels * (ceil((gdouble) buffer_length / (gdouble) samplerate * (gdouble) target_samplerate)) * sizeof(gint64));
-  memset(ret_buffer, 0, (ceil((gdouble) buffer_length / (gdouble) samplerate * (gdouble) target_samplerate)) * sizeof(gint64));
-  ags_audio_buffer_util_copy_float_to_s64(ret_buffer, channels,
-					  secret_rabbit.data_out, channels,
-					  (ceil((gdouble) buffer_length / (gdouble) samplerate * (gdouble) target_samplerate)));
+  target_buffer_length = ags_resampler_get_target_length(resampler,
+							 buffer_length);
 
-  free(secret_rabbit.data_out);
-  free(secret_rabbit.data_in);
+  ret_buffer = (gint64 *) malloc(channels * target_buffer_length * sizeof(gint64));
+  memset(ret_buffer, 0, channels * target_buffer_length * sizeof(gint64));
+
+  ags_resampler_convert(resampler,
+			buffer, AGS_AUDIO_BUFFER_UTIL_S64,
+			buffer_length,
+			ret_buffer, AGS_AUDIO_BUFFER_UTIL_S64,
+			target_buffer_length);
 
   return(ret_buffer);
 }
@@ -4012,38 +3998,32 @@ ags_audio_buffer_util_resample_float(gfloat *buffer, guint channels,
 				     guint buffer_length,
 				     guint target_samplerate)
 {
-  SRC_DATA secret_rabbit;
+  AgsResampler *resampler;
 
   gfloat *ret_buffer;
 
-  //FIXME:JK: lost precision
-
-  secret_rabbit.src_ratio = target_samplerate / samplerate;
+  guint target_buffer_length;
 
-  secret_rabbit.input_frames = buffer_length;
-  secret_rabbit.data_in = (gfloat *) malloc(channels * buffer_length * sizeof(gfloat));
-  ags_audio_buffer_util_clear_float(secret_rabbit.data_in, channels,
-				    buffer_length);
-  ags_audio_buffer_util_copy_float_to_float(secret_rabbit.data_in, channels,
-					    buffer, channels,
-					    buffer_length);
+  resampler = ags_resampler_get_thread_default();
 
-  secret_rabbit.output_frames = ceil(secret_rabbit.src_ratio * buffer_length);
-  secret_rabbit.data_out = (gfloat *) malloc(channels * secret_rabbit.output_frames * sizeof(gfloat));
+  ags_resampler_set_audio_channels(resampler,
+				   channels);
+  ags_resampler_set_samplerate(resampler,
+			       samplerate);
+  ags_resampler_set_target_samplerate(resampler,
+				      target_samplerate);
 
-  src_simple(&secret_rabbit,
-	     SRC_SINC_BEST_QUALITY,
-	     channels);
+  target_buffer_length = ags_resampler_get_target_length(resampler,
+							 buffer_length);
 
-  ret_buffer = (gfloat *) malloc(channels * (ceil((gfloat) buffer_length / (gfloat) samplerate * (gfloat) target_samplerate)) * sizeof(gfloat));
-  ags_audio_buffer_util_clear_float(ret_buffer, channels,
-				    (ceil((gfloat) buffer_length / (gfloat) samplerate * (gfloat) target_samplerate)));
-  ags_audio_buffer_util_copy_float_to_float(ret_buffer, channels,
-					    secret_rabbit.data_out, channels,
-					    (ceil((gfloat) buffer_length / (gfloat) samplerate * (gfloat) target_samplerate)));
+  ret_buffer = (gfloat *) malloc(channels * target_buffer_length * sizeof(gfloat));
+  memset(ret_buffer, 0, channels * target_buffer_length * sizeof(gfloat));
 
-  free(secret_rabbit.data_out);
-  free(secret_rabbit.data_in);
+  ags_resampler_convert(resampler,
+			buffer, AGS_AUDIO_BUFFER_UTIL_FLOAT,
+			buffer_length,
+			ret_buffer, AGS_AUDIO_BUFFER_UTIL_FLOAT,
+			target_buffer_length);
 
   return(ret_buffer);
 }
@@ -4068,38 +4048,32 @@ ags_audio_buffer_util_resample_double(gdouble *buffer, guint channels,
 				      guint buffer_length,
 				      guint target_samplerate)
 {
-  SRC_DATA secret_rabbit;
+  AgsResampler *resampler;
 
   gdouble *ret_buffer;
 
-  //FIXME:JK: lost precision
+  guint target_buffer_length;
 
-  secret_rabbit.src_ratio = target_samplerate / samplerate;
+  resampler = ags_resampler_get_thread_default();
 
-  secret_rabbit.input_frames = buffer_length;
-  secret_rabbit.data_in = (gfloat *) malloc(channels * buffer_length * sizeof(gfloat));
-  ags_audio_buffer_util_clear_float(secret_rabbit.data_in, channels,
-				    buffer_length);
-  ags_audio_buffer_util_copy_double_to_float(secret_rabbit.data_in, channels,
-					     buffer, channels,
-					     buffer_length);
+  ags_resampler_set_audio_channels(resampler,
+				   channels);
+  ags_resampler_set_samplerate(resampler,
+			       samplerate);
+  ags_resampler_set_target_samplerate(resampler,
+				      target_samplerate);
 
-  secret_rabbit.output_frames = ceil(secret_rabbit.src_ratio * buffer_length);
-  secret_rabbit.data_out = (gfloat *) malloc(channels * secret_rabbit.output_frames * sizeof(gfloat));
+  target_buffer_length = ags_resampler_get_target_length(resampler,
+							 buffer_length);
 
-  src_simple(&secret_rabbit,
-	     SRC_SINC_BEST_QUALITY,
-	     channels);
+  ret_buffer = (gdouble *) malloc(channels * target_buffer_length * sizeof(gdouble));
+  memset(ret_buffer, 0, channels * target_buffer_length * sizeof(gdouble));
 
-  ret_buffer = (gdouble *) malloc(channels * (ceil((gdouble) buffer_length / (gdouble) samplerate * (gdouble) target_samplerate)) * sizeof(gdouble));
-  ags_audio_buffer_util_clear_double(ret_buffer, channels,
-				     (ceil((gdouble) buffer_length / (gdouble) samplerate * (gdouble) target_samplerate)));
-  ags_audio_buffer_util_copy_float_to_double(ret_buffer, channels,
-					     secret_rabbit.data_out, channels,
-					     (ceil((gdouble) buffer_length / (gdouble) samplerate * (gdouble) target_samplerate)));
-
-  free(secret_rabbit.data_out);
-  free(secret_rabbit.data_in);
+  ags_resampler_convert(resampler,
+			buffer, AGS_AUDIO_BUFFER_UTIL_DOUBLE,
+			buffer_length,
+			ret_buffer, AGS_AUDIO_BUFFER_UTIL_DOUBLE,
+			target_buffer_length);
 
   return(ret_buffer);
 }
@@ -4300,31 +4274,22 @@ ags_audio_buffer_util_resample_s8_with_buffer(gint8 *buffer, guint channels,
 					      guint target_buffer_length,
 					      gint8 *target_buffer)
 {
-  SRC_DATA secret_rabbit;
+  AgsResampler *resampler;
 
-  secret_rabbit.src_ratio = target_samplerate / samplerate;
+  resampler = ags_resampler_get_thread_default();
 
-  secret_rabbit.input_frames = buffer_length;
-  secret_rabbit.data_in = (gfloat *) malloc(channels * buffer_length * sizeof(gfloat));
-  ags_audio_buffer_util_clear_float(secret_rabbit.data_in, channels,
-				    buffer_length);
-  ags_audio_buffer_util_copy_s8_to_float(secret_rabbit.data_in, channels,
-					 buffer, channels,
-					 buffer_length);
+  ags_resampler_set_audio_channels(resampler,
+				   channels);
+  ags_resampler_set_samplerate(resampler,
+			       samplerate);
+  ags_resampler_set_target_samplerate(resampler,
+				      target_samplerate);
 
-  secret_rabbit.output_frames = ceil(secret_rabbit.src_ratio * buffer_length);
-  secret_rabbit.data_out = (gfloat *) malloc(channels * secret_rabbit.output_frames * sizeof(gfloat));
-  
-  src_simple(&secret_rabbit,
-	     SRC_SINC_BEST_QUALITY,
-	     channels);
-
-  ags_audio_buffer_util_copy_float_to_s8(target_buffer, channels,
-					 secret_rabbit.data_out, channels,
-					 ((secret_rabbit.output_frames > target_buffer_length) ? target_buffer_length: secret_rabbit.output_frames));
-
-  free(secret_rabbit.data_out);
-  free(secret_rabbit.data_in);
+  ags_resampler_convert(resampler,
+			buffer, AGS_AUDIO_BUFFER_UTIL_S8,
+			buffer_length,
+			target_buffer, AGS_AUDIO_BUFFER_UTIL_S8,
+			target_buffer_length);
 }
 
 /**
@@ -4349,31 +4314,22 @@ ags_audio_buffer_util_resample_s16_with_buffer(gint16 *buffer, guint channels,
 					       guint target_buffer_length,
 					       gint16 *target_buffer)
 {
-  SRC_DATA secret_rabbit;
-
-  secret_rabbit.src_ratio = target_samplerate / samplerate;
-
-  secret_rabbit.input_frames = buffer_length;
-  secret_rabbit.data_in = (gfloat *) malloc(channels * buffer_length * sizeof(gfloat));
-  ags_audio_buffer_util_clear_float(secret_rabbit.data_in, channels,
-				    buffer_length);
-  ags_audio_buffer_util_copy_s16_to_float(secret_rabbit.data_in, channels,
-					  buffer, channels,
-					  buffer_length);
+  AgsResampler *resampler;
 
-  secret_rabbit.output_frames = ceil(secret_rabbit.src_ratio * buffer_length);
-  secret_rabbit.data_out = (gfloat *) malloc(channels * secret_rabbit.output_frames * sizeof(gfloat));
-  
-  src_simple(&secret_rabbit,
-	     SRC_SINC_BEST_QUALITY,
-	     channels);
+  resampler = ags_resampler_get_thread_default();
 
-  ags_audio_buffer_util_copy_float_to_s16(target_buffer, channels,
-					  secret_rabbit.data_out, channels,
-					  ((secret_rabbit.output_frames > target_buffer_length) ? target_buffer_length: secret_rabbit.output_frames));
+  ags_resampler_set_audio_channels(resampler,
+				   channels);
+  ags_resampler_set_samplerate(resampler,
+			       samplerate);
+  ags_resampler_set_target_samplerate(resampler,
+				      target_samplerate);
 
-  free(secret_rabbit.data_out);
-  free(secret_rabbit.data_in);
+  ags_resampler_convert(resampler,
+			buffer, AGS_AUDIO_BUFFER_UTIL_S16,
+			buffer_length,
+			target_buffer, AGS_AUDIO_BUFFER_UTIL_S16,
+			target_buffer_length);
 }
 
 /**
@@ -4398,31 +4354,22 @@ ags_audio_buffer_util_resample_s24_with_buffer(gint32 *buffer, guint channels,
 					       guint target_buffer_length,
 					       gint32 *target_buffer)
 {
-  SRC_DATA secret_rabbit;
-
-  secret_rabbit.src_ratio = target_samplerate / samplerate;
+  AgsResampler *resampler;
 
-  secret_rabbit.input_frames = buffer_length;
-  secret_rabbit.data_in = (gfloat *) malloc(channels * buffer_length * sizeof(gfloat));
-  ags_audio_buffer_util_clear_float(secret_rabbit.data_in, channels,
-				    buffer_length);
-  ags_audio_buffer_util_copy_s24_to_float(secret_rabbit.data_in, channels,
-					  buffer, channels,
-					  buffer_length);
-
-  secret_rabbit.output_frames = ceil(secret_rabbit.src_ratio * buffer_length);
-  secret_rabbit.data_out = (gfloat *) malloc(channels * secret_rabbit.output_frames * sizeof(gfloat));
-  
-  src_simple(&secret_rabbit,
-	     SRC_SINC_BEST_QUALITY,
-	     channels);
+  resampler = ags_resampler_get_thread_default();
 
-  ags_audio_buffer_util_copy_float_to_s24(target_buffer, channels,
-					  secret_rabbit.data_out, channels,
-					  ((secret_rabbit.output_frames > target_buffer_length) ? target_buffer_length: secret_rabbit.output_frames));
+  ags_resampler_set_audio_channels(resampler,
+				   channels);
+  ags_resampler_set_samplerate(resampler,
+			       samplerate);
+  ags_resampler_set_target_samplerate(resampler,
+				      target_samplerate);
 
-  free(secret_rabbit.data_out);
-  free(secret_rabbit.data_in);
+  ags_resampler_convert(resampler,
+			buffer, AGS_AUDIO_BUFFER_UTIL_S24,
+			buffer_length,
+			target_buffer, AGS_AUDIO_BUFFER_UTIL_S24,
+			target_buffer_length);
 }
 
 /**
@@ -4447,31 +4394,22 @@ ags_audio_buffer_util_resample_s32_with_buffer(gint32 *buffer, guint channels,
 					       guint target_buffer_length,
 					       gint32 *target_buffer)
 {
-  SRC_DATA secret_rabbit;
+  AgsResampler *resampler;
 
-  secret_rabbit.src_ratio = target_samplerate / samplerate;
+  resampler = ags_resampler_get_thread_default();
 
-  secret_rabbit.input_frames = buffer_length;
-  secret_rabbit.data_in = (gfloat *) malloc(channels * buffer_length * sizeof(gfloat));
-  ags_audio_buffer_util_clear_float(secret_rabbit.data_in, channels,
-				    buffer_length);
-  ags_audio_buffer_util_copy_s32_to_float(secret_rabbit.data_in, channels,
-					  buffer, channels,
-					  buffer_length);
+  ags_resampler_set_audio_channels(resampler,
+				   channels);
+  ags_resampler_set_samplerate(resampler,
+			       samplerate);
+  ags_resampler_set_target_samplerate(resampler,
+				      target_samplerate);
 
-  secret_rabbit.output_frames = ceil(secret_rabbit.src_ratio * buffer_length);
-  secret_rabbit.data_out = (gfloat *) malloc(channels * secret_rabbit.output_frames * sizeof(gfloat));
-  
-  src_simple(&secret_rabbit,
-	     SRC_SINC_BEST_QUALITY,
-	     channels);
-
-  ags_audio_buffer_util_copy_float_to_s32(target_buffer, channels,
-					  secret_rabbit.data_out, channels,
-					  ((secret_rabbit.output_frames > target_buffer_length) ? target_buffer_length: secret_rabbit.output_frames));
-
-  free(secret_rabbit.data_out);
-  free(secret_rabbit.data_in);
+  ags_resampler_convert(resampler,
+			buffer, AGS_AUDIO_BUFFER_UTIL_S32,
+			buffer_length,
+			target_buffer, AGS_AUDIO_BUFFER_UTIL_S32,
+			target_buffer_length);
 }
 
 /**
@@ -4496,31 +4434,22 @@ ags_audio_buffer_util_resample_s64_with_buffer(gint64 *buffer, guint channels,
 					       guint target_buffer_length,
 					       gint64 *target_buffer)
 {
-  SRC_DATA secret_rabbit;
-
-  secret_rabbit.src_ratio = target_samplerate / samplerate;
+  AgsResampler *resampler;
 
-  secret_rabbit.input_frames = buffer_length;
-  secret_rabbit.data_in = (gfloat *) malloc(channels * buffer_length * sizeof(gfloat));
-  ags_audio_buffer_util_clear_float(secret_rabbit.data_in, channels,
-				    buffer_length);
-  ags_audio_buffer_util_copy_s64_to_float(secret_rabbit.data_in, channels,
-					  buffer, channels,
-					  buffer_length);
+  resampler = ags_resampler_get_thread_default();
 
-  secret_rabbit.output_frames = ceil(secret_rabbit.src_ratio * buffer_length);
-  secret_rabbit.data_out = (gfloat *) malloc(channels * secret_rabbit.output_frames * sizeof(gfloat));
-  
-  src_simple(&secret_rabbit,
-	     SRC_SINC_BEST_QUALITY,
-	     channels);
-
-  ags_audio_buffer_util_copy_float_to_s64(target_buffer, channels,
-					  secret_rabbit.data_out, channels,
-					  ((secret_rabbit.output_frames > target_buffer_length) ? target_buffer_length: secret_rabbit.output_frames));
+  ags_resampler_set_audio_channels(resampler,
+				   channels);
+  ags_resampler_set_samplerate(resampler,
+			       samplerate);
+  ags_resampler_set_target_samplerate(resampler,
+				      target_samplerate);
 
-  free(secret_rabbit.data_out);
-  free(secret_rabbit.data_in);
+  ags_resampler_convert(resampler,
+			buffer, AGS_AUDIO_BUFFER_UTIL_S64,
+			buffer_length,
+			target_buffer, AGS_AUDIO_BUFFER_UTIL_S64,
+			target_buffer_length);
 }
 
 /**
@@ -4545,26 +4474,22 @@ ags_audio_buffer_util_resample_float_with_buffer(gfloat *buffer, guint channels,
 						 guint target_buffer_length,
 						 gfloat *target_buffer)
 {
-  SRC_DATA secret_rabbit;
-
-  secret_rabbit.src_ratio = target_samplerate / samplerate;
-
-  secret_rabbit.input_frames = buffer_length;
-  secret_rabbit.data_in = buffer;
+  AgsResampler *resampler;
 
-  secret_rabbit.output_frames = ceil(secret_rabbit.src_ratio * buffer_length);
-  secret_rabbit.data_out = (gfloat *) malloc(channels * secret_rabbit.output_frames * sizeof(gfloat));
+  resampler = ags_resampler_get_thread_default();
 
-  src_simple(&secret_rabbit,
-	     SRC_SINC_BEST_QUALITY,
-	     channels);
+  ags_resampler_set_audio_channels(resampler,
+				   channels);
+  ags_resampler_set_samplerate(resampler,
+			       samplerate);
+  ags_resampler_set_target_samplerate(resampler,
+				      target_samplerate);
 
-  ags_audio_buffer_util_copy_float_to_float(target_buffer, channels,
-					    secret_rabbit.data_out, channels,
-					    ((secret_rabbit.output_frames > target_buffer_length) ? target_buffer_length: secret_rabbit.output_frames));
-
-  free(secret_rabbit.data_out);
-  free(secret_rabbit.data_in);
+  ags_resampler_convert(resampler,
+			buffer, AGS_AUDIO_BUFFER_UTIL_FLOAT,
+			buffer_length,
+			target_buffer, AGS_AUDIO_BUFFER_UTIL_FLOAT,
+			target_buffer_length);
 }
 
 /**
@@ -4589,31 +4514,22 @@ ags_audio_buffer_util_resample_double_with_buffer(gdouble *buffer, guint channel
 						  guint target_buffer_length,
 						  gdouble *target_buffer)
 {
-  SRC_DATA secret_rabbit;
-
-  secret_rabbit.src_ratio = target_samplerate / samplerate;
+  AgsResampler *resampler;
 
-  secret_rabbit.input_frames = buffer_length;
-  secret_rabbit.data_in = (gfloat *) malloc(channels * buffer_length * sizeof(gfloat));
-  ags_audio_buffer_util_clear_float(secret_rabbit.data_in, channels,
-				    buffer_length);
-  ags_audio_buffer_util_copy_double_to_float(secret_rabbit.data_in, channels,
-					     buffer, channels,
-					     buffer_length);
-  
-  secret_rabbit.output_frames = ceil(secret_rabbit.src_ratio * buffer_length);
-  secret_rabbit.data_out = (gfloat *) malloc(channels * secret_rabbit.output_frames * sizeof(gfloat));
-  
-  src_simple(&secret_rabbit,
-	     SRC_SINC_BEST_QUALITY,
-	     channels);
+  resampler = ags_resampler_get_thread_default();
 
-  ags_audio_buffer_util_copy_float_to_double(target_buffer, channels,
-					     secret_rabbit.data_out, channels,
-					     ((secret_rabbit.output_frames > target_buffer_length) ? target_buffer_length: secret_rabbit.output_frames));
+  ags_resampler_set_audio_channels(resampler,
+				   channels);
+  ags_resampler_set_samplerate(resampler,
+			       samplerate);
+  ags_resampler_set_target_samplerate(resampler,
+				      target_samplerate);
 
-  free(secret_rabbit.data_out);
-  free(secret_rabbit.data_in);
+  ags_resampler_convert(resampler,
+			buffer, AGS_AUDIO_BUFFER_UTIL_DOUBLE,
+			buffer_length,
+			target_buffer, AGS_AUDIO_BUFFER_UTIL_DOUBLE,
+			target_buffer_length);
 }
 
 /**
@@ -5691,6 +5607,15 @@ ags_audio_buffer_util_copy_s8_to_s8(gint8 *destination, guint dchannels,
   guint current_dchannel, current_schannel;
   guint i;
 
+#if defined(AGS_VECTORIZED_BUILTIN_FUNCTIONS)
+  /* SIMD kernel */
+  if(ags_audio_buffer_kernel_copy_s8_to_s8(destination, dchannels,
+					   source, schannels,
+					   count)){
+    return;
+  }
+#endif
+
   i = 0;
   
 #if defined(AGS_VECTORIZED_BUILTIN_FUNCTIONS)
@@ -6586,6 +6511,15 @@ ags_audio_buffer_util_copy_s16_to_s16(gint16 *destination, guint dchannels,
   guint current_dchannel, current_schannel;
   guint i;
 
+#if defined(AGS_VECTORIZED_BUILTIN_FUNCTIONS)
+  /* SIMD kernel */
+  if(ags_audio_buffer_kernel_copy_s16_to_s16(destination, dchannels,
+					     source, schannels,
+					     count)){
+    return;
+  }
+#endif
+
   i = 0;
 
 #if defined(AGS_VECTORIZED_BUILTIN_FUNCTIONS)
@@ -7480,6 +7414,15 @@ ags_audio_buffer_util_copy_s24_to_s24(gint32 *destination, guint dchannels,
   guint current_dchannel, current_schannel;
   guint i;
 
+#if defined(AGS_VECTORIZED_BUILTIN_FUNCTIONS)
+  /* SIMD kernel */
+  if(ags_audio_buffer_kernel_copy_s32_to_s32(destination, dchannels,
+					     source, schannels,
+					     count)){
+    return;
+  }
+#endif
+
   i = 0;
 
 #if defined(AGS_VECTORIZED_BUILTIN_FUNCTIONS)
@@ -8375,6 +8318,15 @@ ags_audio_buffer_util_copy_s32_to_s32(gint32 *destination, guint dchannels,
   guint current_dchannel, current_schannel;
   guint i;
 
+#if defined(AGS_VECTORIZED_BUILTIN_FUNCTIONS)
+  /* SIMD kernel */
+  if(ags_audio_buffer_kernel_copy_s32_to_s32(destination, dchannels,
+					     source, schannels,
+					     count)){
+    return;
+  }
+#endif
+
   i = 0;
   
 #if defined(AGS_VECTORIZED_BUILTIN_FUNCTIONS)
@@ -9267,6 +9219,15 @@ ags_audio_buffer_util_copy_s64_to_s64(gint64 *destination, guint dchannels,
   guint current_dchannel, current_schannel;
   guint i;
 
+#if defined(AGS_VECTORIZED_BUILTIN_FUNCTIONS)
+  /* SIMD kernel */
+  if(ags_audio_buffer_kernel_copy_s64_to_s64(destination, dchannels,
+					     source, schannels,
+					     count)){
+    return;
+  }
+#endif
+
   i = 0;  
 
 #if defined(AGS_VECTORIZED_BUILTIN_FUNCTIONS)
@@ -10162,6 +10123,15 @@ ags_audio_buffer_util_copy_float_to_float(gfloat *destination, guint dchannels,
   guint current_dchannel, current_schannel;
   guint i;
 
+#if defined(AGS_VECTORIZED_BUILTIN_FUNCTIONS)
+  /* SIMD kernel */
+  if(ags_audio_buffer_kernel_copy_float_to_float(destination, dchannels,
+						 source, schannels,
+						 count)){
+    return;
+  }
+#endif
+
   i = 0;
   
 #if defined(AGS_VECTORIZED_BUILTIN_FUNCTIONS)
@@ -11043,6 +11013,15 @@ ags_audio_buffer_util_copy_double_to_double(gdouble *destination, guint dchannel
   guint current_dchannel, current_schannel;
   guint i;
 
+#if defined(AGS_VECTORIZED_BUILTIN_FUNCTIONS)
+  /* SIMD kernel */
+  if(ags_audio_buffer_kernel_copy_double_to_double(destination, dchannels,
+						   source, schannels,
+						   count)){
+    return;
+  }
+#endif
+
   i = 0;
   
 #if defined(AGS_VECTORIZED_BUILTIN_FUNCTIONS)
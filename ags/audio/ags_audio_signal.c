@@ -900,6 +900,8 @@ ags_audio_signal_init(AgsAudioSignal *audio_signal)
   audio_signal->stream = NULL;
   audio_signal->stream_current = NULL;
   audio_signal->stream_end = NULL;
+
+  audio_signal->render_future = NULL;
 }
 
 void
@@ -1703,6 +1705,11 @@ ags_audio_signal_finalize(GObject *gobject)
     
     g_list_free(audio_signal->stream);    
   }
+
+  /* render future */
+  if(audio_signal->render_future != NULL){
+    ags_future_unref(audio_signal->render_future);
+  }
   
   /* call parent */
   G_OBJECT_CLASS(ags_audio_signal_parent_class)->finalize(gobject);
@@ -2543,6 +2550,7 @@ ags_audio_signal_set_samplerate(AgsAudioSignal *audio_signal, guint samplerate)
   void *data, *resampled_data;
 
   guint stream_length;
+  guint resampled_length;
   guint end_offset;
   guint buffer_size;
   guint old_samplerate;
@@ -2659,19 +2667,21 @@ ags_audio_signal_set_samplerate(AgsAudioSignal *audio_signal, guint samplerate)
   
   g_rec_mutex_unlock(stream_mutex);
 
-  resampled_data = ags_stream_alloc((guint) (samplerate * (stream_length * buffer_size / old_samplerate)),
+  resampled_length = (guint) ceil((gdouble) samplerate * (gdouble) (stream_length * buffer_size) / (gdouble) old_samplerate);
+  
+  resampled_data = ags_stream_alloc(resampled_length,
 				    format);
   ags_audio_buffer_util_resample_with_buffer(data, 1,
 					     ags_audio_buffer_util_format_from_soundcard(format), old_samplerate,
 					     stream_length * buffer_size,
 					     samplerate,
-					     (guint) (samplerate * (stream_length * buffer_size / old_samplerate)),
+					     resampled_length,
 					     resampled_data);
 
   g_free(data);
 
   ags_audio_signal_stream_resize(audio_signal,
-				 (guint) ceil((samplerate * (stream_length * buffer_size / old_samplerate)) / buffer_size));
+				 (guint) ceil((gdouble) resampled_length / (gdouble) buffer_size));
   
   g_rec_mutex_lock(stream_mutex);
 
@@ -3575,6 +3585,194 @@ ags_audio_signal_duplicate_stream(AgsAudioSignal *audio_signal,
   g_rec_mutex_unlock(template_stream_mutex);
 }
 
+/**
+ * ags_audio_signal_swap_stream:
+ * @audio_signal: the #AgsAudioSignal
+ * @other: the other #AgsAudioSignal
+ * 
+ * Exchange the audio data of @audio_signal and @other, along with length,
+ * frame count, last frame and loop fields. Both streams are locked during the
+ * exchange, so readers of @audio_signal see either the old or the new data.
+ * Both signals must share buffer size and format.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_audio_signal_swap_stream(AgsAudioSignal *audio_signal,
+			     AgsAudioSignal *other)
+{
+  GList *stream, *stream_end;
+
+  guint flags;
+  guint length;
+  guint frame_count;
+  guint last_frame;
+  guint loop_start, loop_end;
+  gint position;
+  
+  GRecMutex *audio_signal_mutex, *other_mutex;
+  GRecMutex *audio_signal_stream_mutex, *other_stream_mutex;
+
+  if(!AGS_IS_AUDIO_SIGNAL(audio_signal) ||
+     !AGS_IS_AUDIO_SIGNAL(other) ||
+     audio_signal == other){
+    return;
+  }
+  
+  /* get audio signal mutex */
+  audio_signal_mutex = AGS_AUDIO_SIGNAL_GET_OBJ_MUTEX(audio_signal);
+  other_mutex = AGS_AUDIO_SIGNAL_GET_OBJ_MUTEX(other);
+
+  audio_signal_stream_mutex = AGS_AUDIO_SIGNAL_GET_STREAM_MUTEX(audio_signal);
+  other_stream_mutex = AGS_AUDIO_SIGNAL_GET_STREAM_MUTEX(other);
+
+  /* swap */
+  g_rec_mutex_lock(audio_signal_mutex);
+  g_rec_mutex_lock(other_mutex);
+
+  g_rec_mutex_lock(audio_signal_stream_mutex);
+  g_rec_mutex_lock(other_stream_mutex);
+
+  position = -1;
+
+  if(audio_signal->stream_current != NULL){
+    position = g_list_position(audio_signal->stream,
+			       audio_signal->stream_current);
+  }
+  
+  stream = audio_signal->stream;
+  stream_end = audio_signal->stream_end;
+
+  audio_signal->stream = other->stream;
+  audio_signal->stream_end = other->stream_end;
+  audio_signal->stream_current = NULL;
+
+  if(position >= 0){
+    audio_signal->stream_current = g_list_nth(audio_signal->stream,
+					      (guint) position);
+  }
+  
+  other->stream = stream;
+  other->stream_end = stream_end;
+  other->stream_current = NULL;
+
+  /* the buffers are freed the way they were allocated */
+  flags = (AGS_AUDIO_SIGNAL_SLICE_ALLOC & (audio_signal->flags));
+
+  audio_signal->flags = ((~AGS_AUDIO_SIGNAL_SLICE_ALLOC) & (audio_signal->flags)) | (AGS_AUDIO_SIGNAL_SLICE_ALLOC & (other->flags));
+  other->flags = ((~AGS_AUDIO_SIGNAL_SLICE_ALLOC) & (other->flags)) | flags;
+  
+  /* fields */
+  length = audio_signal->length;
+  frame_count = audio_signal->frame_count;
+  last_frame = audio_signal->last_frame;
+  loop_start = audio_signal->loop_start;
+  loop_end = audio_signal->loop_end;
+
+  audio_signal->length = other->length;
+  audio_signal->frame_count = other->frame_count;
+  audio_signal->last_frame = other->last_frame;
+  audio_signal->loop_start = other->loop_start;
+  audio_signal->loop_end = other->loop_end;
+
+  other->length = length;
+  other->frame_count = frame_count;
+  other->last_frame = last_frame;
+  other->loop_start = loop_start;
+  other->loop_end = loop_end;
+  
+  g_rec_mutex_unlock(other_stream_mutex);
+  g_rec_mutex_unlock(audio_signal_stream_mutex);
+
+  g_rec_mutex_unlock(other_mutex);
+  g_rec_mutex_unlock(audio_signal_mutex);
+}
+
+/**
+ * ags_audio_signal_get_render_future:
+ * @audio_signal: the #AgsAudioSignal
+ * 
+ * Get the #AgsFuture of the last background job submitted to render
+ * @audio_signal. Jobs rendering the same signal wait for it to keep their
+ * order.
+ *
+ * Returns: (transfer full): the #AgsFuture or %NULL
+ *
+ * Since: 3.7.0
+ */
+AgsFuture*
+ags_audio_signal_get_render_future(AgsAudioSignal *audio_signal)
+{
+  AgsFuture *render_future;
+  
+  GRecMutex *audio_signal_mutex;
+
+  if(!AGS_IS_AUDIO_SIGNAL(audio_signal)){
+    return(NULL);
+  }
+  
+  /* get audio signal mutex */
+  audio_signal_mutex = AGS_AUDIO_SIGNAL_GET_OBJ_MUTEX(audio_signal);
+
+  /* get render future */
+  g_rec_mutex_lock(audio_signal_mutex);
+
+  render_future = audio_signal->render_future;
+
+  if(render_future != NULL){
+    ags_future_ref(render_future);
+  }
+  
+  g_rec_mutex_unlock(audio_signal_mutex);
+
+  return(render_future);
+}
+
+/**
+ * ags_audio_signal_set_render_future:
+ * @audio_signal: the #AgsAudioSignal
+ * @render_future: the #AgsFuture
+ * 
+ * Set the #AgsFuture of the last background job submitted to render
+ * @audio_signal.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_audio_signal_set_render_future(AgsAudioSignal *audio_signal,
+				   AgsFuture *render_future)
+{
+  GRecMutex *audio_signal_mutex;
+
+  if(!AGS_IS_AUDIO_SIGNAL(audio_signal)){
+    return;
+  }
+  
+  /* get audio signal mutex */
+  audio_signal_mutex = AGS_AUDIO_SIGNAL_GET_OBJ_MUTEX(audio_signal);
+
+  /* set render future */
+  g_rec_mutex_lock(audio_signal_mutex);
+
+  if(audio_signal->render_future == render_future){
+    g_rec_mutex_unlock(audio_signal_mutex);
+
+    return;
+  }
+  
+  if(audio_signal->render_future != NULL){
+    ags_future_unref(audio_signal->render_future);
+  }
+
+  if(render_future != NULL){
+    ags_future_ref(render_future);
+  }
+  
+  audio_signal->render_future = render_future;
+  
+  g_rec_mutex_unlock(audio_signal_mutex);
+}
+
 /**
  * ags_audio_signal_feed:
  * @audio_signal: the #AgsAudioSignal
@@ -120,6 +120,8 @@ struct _AgsAudioSignal
   GList *stream;
   GList *stream_current;
   GList *stream_end;
+
+  AgsFuture *render_future;
 };
 
 struct _AgsAudioSignalClass
@@ -198,6 +200,12 @@ void ags_audio_signal_clear(AgsAudioSignal *audio_signal);
 
 void ags_audio_signal_duplicate_stream(AgsAudioSignal *audio_signal,
 				       AgsAudioSignal *template);
+void ags_audio_signal_swap_stream(AgsAudioSignal *audio_signal,
+				  AgsAudioSignal *other);
+
+AgsFuture* ags_audio_signal_get_render_future(AgsAudioSignal *audio_signal);
+void ags_audio_signal_set_render_future(AgsAudioSignal *audio_signal,
+					AgsFuture *render_future);
 
 void ags_audio_signal_feed(AgsAudioSignal *audio_signal,
 			   AgsAudioSignal *template,
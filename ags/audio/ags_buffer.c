@@ -101,6 +101,7 @@ ags_buffer_flags_get_type()
   if(g_once_init_enter (&g_flags_type_id__volatile)){
     static const GFlagsValue values[] = {
       { AGS_BUFFER_IS_SELECTED, "AGS_BUFFER_IS_SELECTED", "buffer-is-selected" },
+      { AGS_BUFFER_VIEW, "AGS_BUFFER_VIEW", "buffer-view" },
       { 0, NULL, NULL }
     };
 
@@ -357,6 +358,8 @@ ags_buffer_set_property(GObject *gobject,
     {
       g_rec_mutex_lock(buffer_mutex);
 
+      buffer->flags &= (~AGS_BUFFER_VIEW);
+      
       buffer->data = g_value_get_pointer(value);
 
       g_rec_mutex_unlock(buffer_mutex);
@@ -467,7 +470,8 @@ ags_buffer_finalize(GObject *gobject)
 
   buffer = AGS_BUFFER(gobject);
 
-  if(buffer->data != NULL){
+  if(buffer->data != NULL &&
+     (AGS_BUFFER_VIEW & (buffer->flags)) == 0){
     free(buffer->data);
   }
   
@@ -824,13 +828,18 @@ ags_buffer_set_buffer_size(AgsBuffer *buffer,
 
   old_buffer_size = buffer->buffer_size;
   
-  buffer->buffer_size = buffer_size;
-
-  if(old_buffer_size == buffer->buffer_size){
+  if(old_buffer_size == buffer_size){
     g_rec_mutex_unlock(buffer_mutex);    
 
     return;
   }
+
+  /* views can't be resized in place */
+  if((AGS_BUFFER_VIEW & (buffer->flags)) != 0){
+    ags_buffer_detach_data(buffer);
+  }
+  
+  buffer->buffer_size = buffer_size;
   
   switch(buffer->format){
   case AGS_SOUNDCARD_SIGNED_8_BIT:
@@ -869,6 +878,20 @@ ags_buffer_set_buffer_size(AgsBuffer *buffer,
       word_size = sizeof(gint64);
     }
     break;
+  case AGS_SOUNDCARD_FLOAT:
+    {
+      buffer->data = (gfloat *) realloc(buffer->data,
+					buffer_size * sizeof(gfloat));
+      word_size = sizeof(gfloat);
+    }
+    break;
+  case AGS_SOUNDCARD_DOUBLE:
+    {
+      buffer->data = (gdouble *) realloc(buffer->data,
+					 buffer_size * sizeof(gdouble));
+      word_size = sizeof(gdouble);
+    }
+    break;
   default:
     g_rec_mutex_unlock(buffer_mutex);
     
@@ -955,7 +978,11 @@ ags_buffer_set_format(AgsBuffer *buffer,
 					      buffer->data, 1, 0,
 					      buffer->buffer_size, copy_mode);
 
-  free(buffer->data);
+  if((AGS_BUFFER_VIEW & (buffer->flags)) == 0){
+    free(buffer->data);
+  }
+
+  buffer->flags &= (~AGS_BUFFER_VIEW);
 
   buffer->data = data;
 
@@ -998,6 +1025,115 @@ ags_buffer_get_data(AgsBuffer *buffer)
   return(data);
 }
 
+/**
+ * ags_buffer_attach_data:
+ * @buffer: the #AgsBuffer
+ * @data: the storage to use
+ *
+ * Copy the current data of @buffer to @data and use it as view. @data
+ * must hold at least buffer size frames of @buffer's format and stay
+ * valid until ags_buffer_detach_data() is called.
+ * 
+ * Since: 3.7.0
+ */
+void
+ags_buffer_attach_data(AgsBuffer *buffer,
+		       gpointer data)
+{
+  guint copy_mode;
+
+  GRecMutex *buffer_mutex;
+
+  if(!AGS_IS_BUFFER(buffer) ||
+     data == NULL){
+    return;
+  }
+      
+  /* get buffer mutex */
+  buffer_mutex = AGS_BUFFER_GET_OBJ_MUTEX(buffer);
+
+  /* attach */
+  g_rec_mutex_lock(buffer_mutex);
+
+  if(buffer->data == data){
+    g_rec_mutex_unlock(buffer_mutex);
+
+    return;
+  }
+
+  copy_mode = ags_audio_buffer_util_get_copy_mode(ags_audio_buffer_util_format_from_soundcard(buffer->format),
+						  ags_audio_buffer_util_format_from_soundcard(buffer->format));
+
+  ags_audio_buffer_util_clear_buffer(data, 1,
+				     buffer->buffer_size, ags_audio_buffer_util_format_from_soundcard(buffer->format));
+  
+  if(buffer->data != NULL){
+    ags_audio_buffer_util_copy_buffer_to_buffer(data, 1, 0,
+						buffer->data, 1, 0,
+						buffer->buffer_size, copy_mode);
+
+    if((AGS_BUFFER_VIEW & (buffer->flags)) == 0){
+      free(buffer->data);
+    }
+  }
+  
+  buffer->data = data;
+
+  buffer->flags |= AGS_BUFFER_VIEW;
+  
+  g_rec_mutex_unlock(buffer_mutex);
+}
+
+/**
+ * ags_buffer_detach_data:
+ * @buffer: the #AgsBuffer
+ *
+ * Copy the viewed data of @buffer to storage owned by @buffer.
+ * 
+ * Since: 3.7.0
+ */
+void
+ags_buffer_detach_data(AgsBuffer *buffer)
+{
+  void *data;
+  
+  guint copy_mode;
+
+  GRecMutex *buffer_mutex;
+
+  if(!AGS_IS_BUFFER(buffer)){
+    return;
+  }
+      
+  /* get buffer mutex */
+  buffer_mutex = AGS_BUFFER_GET_OBJ_MUTEX(buffer);
+
+  /* detach */
+  g_rec_mutex_lock(buffer_mutex);
+
+  if((AGS_BUFFER_VIEW & (buffer->flags)) == 0){
+    g_rec_mutex_unlock(buffer_mutex);
+
+    return;
+  }
+
+  data = ags_stream_alloc(buffer->buffer_size,
+			  buffer->format);
+
+  copy_mode = ags_audio_buffer_util_get_copy_mode(ags_audio_buffer_util_format_from_soundcard(buffer->format),
+						  ags_audio_buffer_util_format_from_soundcard(buffer->format));
+
+  ags_audio_buffer_util_copy_buffer_to_buffer(data, 1, 0,
+					      buffer->data, 1, 0,
+					      buffer->buffer_size, copy_mode);
+
+  buffer->data = data;
+
+  buffer->flags &= (~AGS_BUFFER_VIEW);
+  
+  g_rec_mutex_unlock(buffer_mutex);
+}
+
 /**
  * ags_buffer_duplicate:
  * @buffer: an #AgsBuffer
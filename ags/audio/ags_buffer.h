@@ -46,12 +46,14 @@ typedef struct _AgsBufferClass AgsBufferClass;
 /**
  * AgsBufferFlags:
  * @AGS_BUFFER_IS_SELECTED: is selected
+ * @AGS_BUFFER_VIEW: data is a view into storage owned by someone else, as the chunks of #AgsWave
  *
  * Enum values to control the behavior or indicate internal state of #AgsBuffer by
  * enable/disable as flags.
  */
 typedef enum{
   AGS_BUFFER_IS_SELECTED     = 1,
+  AGS_BUFFER_VIEW            = 1 <<  1,
 }AgsBufferFlags;
 
 struct _AgsBuffer
@@ -111,6 +113,10 @@ void ags_buffer_set_format(AgsBuffer *buffer,
 
 gpointer ags_buffer_get_data(AgsBuffer *buffer);
 
+void ags_buffer_attach_data(AgsBuffer *buffer,
+			    gpointer data);
+void ags_buffer_detach_data(AgsBuffer *buffer);
+
 AgsBuffer* ags_buffer_duplicate(AgsBuffer *buffer);
 
 AgsBuffer* ags_buffer_new();
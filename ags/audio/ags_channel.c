@@ -53,6 +53,7 @@
 #include <ags/audio/thread/ags_audio_loop.h>
 #include <ags/audio/thread/ags_audio_thread.h>
 #include <ags/audio/thread/ags_channel_thread.h>
+#include <ags/audio/thread/ags_audio_scheduler.h>
 
 #include <ags/audio/task/ags_cancel_channel.h>
 
@@ -248,6 +249,15 @@ void ags_channel_recursive_do_run_stage_down(AgsChannel *channel,
 void ags_channel_recursive_do_run_stage_down_input(AgsChannel *channel,
 						   AgsRecyclingContext *recycling_context,
 						   gint sound_scope, guint staging_flags);
+void ags_channel_recursive_compile_run_stage_up(AgsChannel *channel,
+						AgsRecyclingContext *recycling_context,
+						AgsExecutionPlan *execution_plan);
+void ags_channel_recursive_compile_run_stage_down(AgsChannel *channel,
+						  AgsRecyclingContext *recycling_context,
+						  AgsExecutionPlan *execution_plan);
+void ags_channel_recursive_compile_run_stage_down_input(AgsChannel *channel,
+							AgsRecyclingContext *recycling_context,
+							AgsExecutionPlan *execution_plan);
 void ags_channel_recursive_cleanup_run_stage_up(AgsChannel *channel,
 						AgsRecyclingContext *recycling_context,
 						gint sound_scope, guint local_staging_flags);
@@ -4723,6 +4733,10 @@ ags_channel_set_link(AgsChannel *channel, AgsChannel *link,
     g_rec_mutex_unlock(link_mutex);
   }
 
+  /* dependency graph */
+  ags_audio_scheduler_topology_changed(ags_audio_scheduler_get_instance());
+  ags_execution_plan_invalidate();
+
   /* ref count */
   if(channel != NULL && link != NULL){
     g_object_ref(channel);
@@ -8199,6 +8213,9 @@ ags_channel_add_recall_id(AgsChannel *channel, AgsRecallID *recall_id)
   }
   
   g_rec_mutex_unlock(channel_mutex);
+
+  /* execution plan */
+  ags_execution_plan_invalidate();
 }
 
 /**
@@ -8233,6 +8250,9 @@ ags_channel_remove_recall_id(AgsChannel *channel, AgsRecallID *recall_id)
   }
   
   g_rec_mutex_unlock(channel_mutex);
+
+  /* execution plan */
+  ags_execution_plan_invalidate();
 }
 
 /**
@@ -8577,6 +8597,9 @@ ags_channel_add_recall(AgsChannel *channel, GObject *recall,
     g_rec_mutex_unlock(recall_mutex);
   }
 
+  /* execution plan */
+  ags_execution_plan_invalidate();
+
   if(success){
     if(AGS_IS_RECALL_CHANNEL(recall) ||
        AGS_IS_RECALL_CHANNEL_RUN(recall)){
@@ -8685,6 +8708,9 @@ ags_channel_insert_recall(AgsChannel *channel, GObject *recall,
     g_rec_mutex_unlock(recall_mutex);
   }
 
+  /* execution plan */
+  ags_execution_plan_invalidate();
+
   if(success){
     if(AGS_IS_RECALL_CHANNEL(recall) ||
        AGS_IS_RECALL_CHANNEL_RUN(recall)){
@@ -8754,6 +8780,9 @@ ags_channel_remove_recall(AgsChannel *channel, GObject *recall,
     g_rec_mutex_unlock(recall_mutex);
   }
   
+  /* execution plan */
+  ags_execution_plan_invalidate();
+
   if(success){
 #if 0 
     if(AGS_IS_RECALL_CHANNEL(recall) ||
@@ -14454,9 +14483,9 @@ ags_channel_recursive_do_run_stage_down_input(AgsChannel *channel,
 }
 
 void
-ags_channel_recursive_cleanup_run_stage_up(AgsChannel *channel,
+ags_channel_recursive_compile_run_stage_up(AgsChannel *channel,
 					   AgsRecyclingContext *recycling_context,
-					   gint sound_scope, guint local_staging_flags)
+					   AgsExecutionPlan *execution_plan)
 {
   AgsAudio *current_audio;
   AgsChannel *current_channel, *nth_channel;
@@ -14468,11 +14497,6 @@ ags_channel_recursive_cleanup_run_stage_up(AgsChannel *channel,
   guint audio_channel;
   guint line;
     
-  static const guint staging_mask = (AGS_SOUND_STAGING_CHECK_RT_DATA |
-				     AGS_SOUND_STAGING_RUN_INIT_PRE |
-				     AGS_SOUND_STAGING_RUN_INIT_INTER |
-				     AGS_SOUND_STAGING_RUN_INIT_POST);
-    
   if(!AGS_IS_CHANNEL(channel) ||
      !AGS_IS_RECYCLING_CONTEXT(recycling_context)){
     return;
@@ -14485,103 +14509,61 @@ ags_channel_recursive_cleanup_run_stage_up(AgsChannel *channel,
   }
 
   current_link = NULL;
-    
+
   if(AGS_IS_OUTPUT(channel)){
     g_object_get(channel,
 		 "audio", &current_audio,
 		 NULL);
       
-    goto ags_channel_recursive_cleanup_run_stage_up_OUTPUT;
+    goto ags_channel_recursive_compile_run_stage_up_OUTPUT;
   }
 
   while(current_channel != NULL){
     /* check scope - input */
     recall_id =
-      start_recall_id = ags_channel_check_scope(current_channel, sound_scope);
+      start_recall_id = ags_channel_check_scope(current_channel, execution_plan->sound_scope);
 
     current_recall_id = ags_recall_id_find_recycling_context(start_recall_id,
 							     recycling_context);
-      
-    /* cancel */
-    if((AGS_CHANNEL_RECURSIVE_CLEANUP_STAGING_CANCEL_RECALL & (local_staging_flags)) != 0){
-      if(current_recall_id != NULL){
-	ags_channel_cancel_recall(current_channel,
-				  current_recall_id);
-      }
-    }
-
-    /* remove */
-    if((AGS_CHANNEL_RECURSIVE_CLEANUP_STAGING_REMOVE_RECALL & (local_staging_flags)) != 0){	
-      if(current_recall_id != NULL){
-	ags_channel_cleanup_recall(current_channel,
-				   current_recall_id);
-      }
-    }
-
-    /* fini - clean */
-    if((AGS_CHANNEL_RECURSIVE_CLEANUP_SCOPE & (local_staging_flags)) != 0){	
-      if(current_recall_id != NULL){
-	ags_channel_remove_recall_id(current_channel,
-				     current_recall_id);
 
-	ags_channel_unset_staging_flags(current_channel, sound_scope,
-					staging_mask);
-      }
+    /* add recall */
+    if(current_recall_id != NULL){
+      ags_execution_plan_add_recall_id(execution_plan,
+				       (GObject *) current_channel, (GObject *) current_recall_id);
     }
       
     /* free recall id */
     g_list_free_full(start_recall_id,
 		     g_object_unref);
-      
+
     /* get current audio */
     g_object_get(current_channel,
 		 "audio", &current_audio,
 		 NULL);
-      
+
     /* check scope - audio */
     recall_id =
-      start_recall_id = ags_audio_check_scope(current_audio, sound_scope);
+      start_recall_id = ags_audio_check_scope(current_audio, execution_plan->sound_scope);
       
     current_recall_id = ags_recall_id_find_recycling_context(start_recall_id,
 							     recycling_context);
-      
-    /* cancel */
-    if((AGS_CHANNEL_RECURSIVE_CLEANUP_STAGING_CANCEL_RECALL & (local_staging_flags)) != 0){
-      if(current_recall_id != NULL){
-	ags_audio_cancel_recall(current_audio,
-				current_recall_id);
-      }
-    }
-
-    /* remove */
-    if((AGS_CHANNEL_RECURSIVE_CLEANUP_STAGING_REMOVE_RECALL & (local_staging_flags)) != 0){
-      if(current_recall_id){
-	ags_audio_cleanup_recall(current_audio,
-				 current_recall_id);
-      }
-    }
-
-    /* fini - clean */
-    if((AGS_CHANNEL_RECURSIVE_CLEANUP_SCOPE & (local_staging_flags)) != 0){	
-      if(current_recall_id != NULL){
-	ags_audio_remove_recall_id(current_audio,
-				   (GObject *) current_recall_id);
 
-	ags_audio_unset_staging_flags(current_audio, sound_scope,
-				      staging_mask);
-      }
+    /* add recall */
+    if(current_recall_id != NULL){
+      ags_execution_plan_add_recall_id(execution_plan,
+				       (GObject *) current_audio, (GObject *) current_recall_id);
     }
 
     /* free recall id */
     g_list_free_full(start_recall_id,
 		     g_object_unref);
-
+      
     /* get some fields */
     g_object_get(current_channel,
 		 "audio-channel", &audio_channel,
 		 "line", &line,
 		 NULL);
-
+      
     /* move up */
     if(current_channel != NULL){
       g_object_unref(current_channel);
@@ -14592,14 +14574,13 @@ ags_channel_recursive_cleanup_run_stage_up(AgsChannel *channel,
 		 NULL);
 
     if(ags_audio_test_flags(current_audio, AGS_AUDIO_OUTPUT_HAS_RECYCLING)){
-      /* fini - clean */
-      if((AGS_CHANNEL_RECURSIVE_CLEANUP_SCOPE & (local_staging_flags)) != 0){
-	ags_audio_remove_recycling_context(current_audio, (GObject *) recycling_context);
-      }
-
       /* unref current audio */
       g_object_unref(current_audio);
-	
+
+      if(current_channel != NULL){
+	g_object_unref(current_channel);
+      }
+
       break;
     }
 
@@ -14608,7 +14589,7 @@ ags_channel_recursive_cleanup_run_stage_up(AgsChannel *channel,
 				    audio_channel);
 
       g_object_unref(current_channel);
-	  
+
       current_channel = nth_channel;
     }else{
       nth_channel = ags_channel_nth(current_channel,
@@ -14619,54 +14600,28 @@ ags_channel_recursive_cleanup_run_stage_up(AgsChannel *channel,
       current_channel = nth_channel;
     }
       
-  ags_channel_recursive_cleanup_run_stage_up_OUTPUT:
-      
+  ags_channel_recursive_compile_run_stage_up_OUTPUT:
+
     /* check scope - output */
     recall_id =
-      start_recall_id = ags_channel_check_scope(current_channel, sound_scope);
+      start_recall_id = ags_channel_check_scope(current_channel, execution_plan->sound_scope);
       
     current_recall_id = ags_recall_id_find_recycling_context(start_recall_id,
 							     recycling_context);
 
-    /* cancel */
-    if((AGS_CHANNEL_RECURSIVE_CLEANUP_STAGING_CANCEL_RECALL & (local_staging_flags)) != 0){
-      if(current_recall_id != NULL){
-	ags_channel_cancel_recall(current_channel,
-				  current_recall_id);
-      }
-    }
-
-    /* remove */
-    if((AGS_CHANNEL_RECURSIVE_CLEANUP_STAGING_REMOVE_RECALL & (local_staging_flags)) != 0){
-      if(current_recall_id != NULL){
-	ags_channel_cleanup_recall(current_channel,
-				   current_recall_id);
-      }
-    }
-
-    /* fini - clean */
-    if((AGS_CHANNEL_RECURSIVE_CLEANUP_SCOPE & (local_staging_flags)) != 0){
-      if(current_recall_id){
-	ags_channel_remove_recall_id(current_channel,
-				     current_recall_id);
-
-	ags_channel_unset_staging_flags(current_channel, sound_scope,
-					staging_mask);
-      }
+    /* add recall */
+    if(current_recall_id != NULL){
+      ags_execution_plan_add_recall_id(execution_plan,
+				       (GObject *) current_channel, (GObject *) current_recall_id);
     }
       
     /* free recall id */
     g_list_free_full(start_recall_id,
 		     g_object_unref);
       
-    /* fini - clean */
-    if((AGS_CHANNEL_RECURSIVE_CLEANUP_SCOPE & (local_staging_flags)) != 0){
-      ags_audio_remove_recycling_context(current_audio, (GObject *) recycling_context);
-    }
-      
     /* unref current audio */
     g_object_unref(current_audio);
-      
+
     /* iterate */
     current_link = ags_channel_get_link(current_channel);
 
@@ -14681,9 +14636,9 @@ ags_channel_recursive_cleanup_run_stage_up(AgsChannel *channel,
 }
 
 void
-ags_channel_recursive_cleanup_run_stage_down(AgsChannel *channel,
+ags_channel_recursive_compile_run_stage_down(AgsChannel *channel,
 					     AgsRecyclingContext *recycling_context,
-					     gint sound_scope, guint local_staging_flags)
+					     AgsExecutionPlan *execution_plan)
 {
   AgsAudio *current_audio;
   AgsChannel *start_input;
@@ -14694,55 +14649,28 @@ ags_channel_recursive_cleanup_run_stage_down(AgsChannel *channel,
   GList *start_recall_id, *recall_id;
 
   guint audio_channel, line;
-  gboolean play_context;
     
-  static const guint staging_mask = (AGS_SOUND_STAGING_CHECK_RT_DATA |
-				     AGS_SOUND_STAGING_RUN_INIT_PRE |
-				     AGS_SOUND_STAGING_RUN_INIT_INTER |
-				     AGS_SOUND_STAGING_RUN_INIT_POST);
-
   if(!AGS_IS_CHANNEL(channel) ||
      !AGS_IS_RECYCLING_CONTEXT(recycling_context)){
     return;
   }
 
-  /* cleanup */
+  /* do */
   next_recycling_context = recycling_context;
     
   /* check scope - output */
   recall_id =
-    start_recall_id = ags_channel_check_scope(channel, sound_scope);
-      
+    start_recall_id = ags_channel_check_scope(channel, execution_plan->sound_scope);
+
   current_recall_id = ags_recall_id_find_recycling_context(start_recall_id,
 							   recycling_context);
 
-  /* cancel */
-  if((AGS_CHANNEL_RECURSIVE_CLEANUP_STAGING_CANCEL_RECALL & (local_staging_flags)) != 0){
-    if(current_recall_id != NULL){
-      ags_channel_cancel_recall(channel,
-				current_recall_id);
-    }
-  }
-
-  /* remove */
-  if((AGS_CHANNEL_RECURSIVE_CLEANUP_STAGING_REMOVE_RECALL & (local_staging_flags)) != 0){	
-    if(current_recall_id != NULL){
-      ags_channel_cleanup_recall(channel,
-				 current_recall_id);
-    }
+  /* add recall */
+  if(current_recall_id != NULL){
+    ags_execution_plan_add_recall_id(execution_plan,
+				     (GObject *) channel, (GObject *) current_recall_id);
   }
     
-  /* fini - clean */
-  if((AGS_CHANNEL_RECURSIVE_CLEANUP_SCOPE & (local_staging_flags)) != 0){	
-    if(current_recall_id != NULL){
-      ags_channel_remove_recall_id(channel,
-				   current_recall_id);
-
-      ags_channel_unset_staging_flags(channel, sound_scope,
-				      staging_mask);
-    }
-  }
-
   /* free recall id */
   g_list_free_full(start_recall_id,
 		   g_object_unref);
@@ -14753,39 +14681,18 @@ ags_channel_recursive_cleanup_run_stage_down(AgsChannel *channel,
 	       "audio-channel", &audio_channel,
 	       "line", &line,
 	       NULL);
-      
+
   /* check scope - audio */
   recall_id =
-    start_recall_id = ags_audio_check_scope(current_audio, sound_scope);
+    start_recall_id = ags_audio_check_scope(current_audio, execution_plan->sound_scope);
 
   current_recall_id = ags_recall_id_find_recycling_context(start_recall_id,
 							   recycling_context);
-      
-  /* cancel */
-  if((AGS_CHANNEL_RECURSIVE_CLEANUP_STAGING_CANCEL_RECALL & (local_staging_flags)) != 0){
-    if(current_recall_id != NULL){
-      ags_audio_cancel_recall(current_audio,
-			      current_recall_id);
-    }
-  }
-
-  /* remove */
-  if((AGS_CHANNEL_RECURSIVE_CLEANUP_STAGING_REMOVE_RECALL & (local_staging_flags)) != 0){
-    if(current_recall_id){
-      ags_audio_cleanup_recall(current_audio,
-			       current_recall_id);
-    }
-  }
-
-  /* fini - clean */
-  if((AGS_CHANNEL_RECURSIVE_CLEANUP_SCOPE & (local_staging_flags)) != 0){	
-    if(current_recall_id != NULL){
-      ags_audio_remove_recall_id(current_audio,
-				 (GObject *) current_recall_id);
 
-      ags_audio_unset_staging_flags(current_audio, sound_scope,
-				    staging_mask);
-    }
+  /* add recall */
+  if(current_recall_id != NULL){
+    ags_execution_plan_add_recall_id(execution_plan,
+				     (GObject *) current_audio, (GObject *) current_recall_id);
   }
 
   /* free recall id */
@@ -14864,68 +14771,42 @@ ags_channel_recursive_cleanup_run_stage_down(AgsChannel *channel,
      next_recycling_context != recycling_context){
     /* check scope - audio */
     recall_id =
-      start_recall_id = ags_audio_check_scope(current_audio, sound_scope);
+      start_recall_id = ags_audio_check_scope(current_audio, execution_plan->sound_scope);
 
     current_recall_id = ags_recall_id_find_recycling_context(start_recall_id,
 							     next_recycling_context);
 
-    /* cancel */
-    if((AGS_CHANNEL_RECURSIVE_CLEANUP_STAGING_CANCEL_RECALL & (local_staging_flags)) != 0){
-      if(current_recall_id != NULL){
-	ags_audio_cancel_recall(current_audio,
-				current_recall_id);
-      }
-    }
-
-    /* remove */
-    if((AGS_CHANNEL_RECURSIVE_CLEANUP_STAGING_REMOVE_RECALL & (local_staging_flags)) != 0){	
-      if(current_recall_id != NULL){
-	ags_audio_cleanup_recall(current_audio,
-				 current_recall_id);
-      }
+    /* add recall */
+    if(current_recall_id != NULL){
+      ags_execution_plan_add_recall_id(execution_plan,
+				       (GObject *) current_audio, (GObject *) current_recall_id);
     }
-
-    /* fini - clean */
-    if((AGS_CHANNEL_RECURSIVE_CLEANUP_SCOPE & (local_staging_flags)) != 0){	
-      if(current_recall_id != NULL){
-	ags_audio_remove_recall_id(current_audio,
-				   (GObject *) current_recall_id);
-
-	ags_audio_unset_staging_flags(current_audio, sound_scope,
-				      staging_mask);
-      }
-    }      
-
+    
+    /* free recall id */
     g_list_free_full(start_recall_id,
 		     g_object_unref);
   }
 
-  /* free recall id */
-  ags_channel_recursive_cleanup_run_stage_down_input(channel,
-						     next_recycling_context,
-						     sound_scope, local_staging_flags);
-    
   /* unref */
   if(start_input != NULL){
     g_object_unref(start_input);
   }
     
-  /* fini - clean */
-  if((AGS_CHANNEL_RECURSIVE_CLEANUP_SCOPE & (local_staging_flags)) != 0){
-    ags_audio_remove_recycling_context(current_audio, (GObject *) recycling_context);
-    ags_audio_remove_recycling_context(current_audio, (GObject *) next_recycling_context);
-  }
+  /* traverse the tree */
+  ags_channel_recursive_compile_run_stage_down_input(channel,
+						     next_recycling_context,
+						     execution_plan);
 
   /* unref */
   if(current_audio != NULL){
     g_object_unref(current_audio);
   }
 }
-
+  
 void
-ags_channel_recursive_cleanup_run_stage_down_input(AgsChannel *channel,
+ags_channel_recursive_compile_run_stage_down_input(AgsChannel *channel,
 						   AgsRecyclingContext *recycling_context,
-						   gint sound_scope, guint local_staging_flags)
+						   AgsExecutionPlan *execution_plan)
 {
   AgsAudio *current_audio;
   AgsChannel *start_input;
@@ -14934,12 +14815,613 @@ ags_channel_recursive_cleanup_run_stage_down_input(AgsChannel *channel,
   AgsRecallID *current_recall_id;
 
   GList *start_recall_id, *recall_id;
-
-  guint audio_channel, line;
     
-  static const guint staging_mask = (AGS_SOUND_STAGING_CHECK_RT_DATA |
-				     AGS_SOUND_STAGING_RUN_INIT_PRE |
-				     AGS_SOUND_STAGING_RUN_INIT_INTER |
+  guint audio_channel, line;
+
+  if(!AGS_IS_CHANNEL(channel) ||
+     !AGS_IS_RECYCLING_CONTEXT(recycling_context)){
+    return;
+  }
+    
+  /* get some fields */
+  g_object_get(channel,
+	       "audio", &current_audio,
+	       "line", &line,
+	       "audio-channel", &audio_channel,
+	       NULL);
+
+  if(current_audio == NULL){
+    return;
+  }
+
+  /* get some fields */
+  g_object_get(current_audio,
+	       "input", &start_input,
+	       NULL);
+    
+  /* sync/async */
+  if(ags_audio_test_flags(current_audio, AGS_AUDIO_ASYNC)){
+    nth_input = ags_channel_nth(start_input,
+				audio_channel);
+
+    current_input = nth_input;
+
+    next_pad = NULL;
+      
+    while(current_input != NULL){
+      /* get some fields */
+      current_link = ags_channel_get_link(current_input);
+      
+      /* check scope - input */
+      recall_id =
+	start_recall_id = ags_channel_check_scope(current_input, execution_plan->sound_scope);
+
+      current_recall_id = ags_recall_id_find_recycling_context(start_recall_id,
+							       recycling_context);
+
+      /* add recall */
+      if(current_recall_id != NULL){
+	ags_execution_plan_add_recall_id(execution_plan,
+					 (GObject *) current_input, (GObject *) current_recall_id);
+      }
+
+      /* free recall id */
+      g_list_free_full(start_recall_id,
+		       g_object_unref);
+
+      /* traverse the tree */
+      ags_channel_recursive_compile_run_stage_down(current_link,
+						   recycling_context,
+						   execution_plan);
+
+      if(current_link != NULL){
+	g_object_unref(current_link);
+      }
+
+      /* iterate */
+      next_pad = ags_channel_next_pad(current_input);
+
+      g_object_unref(current_input);
+
+      current_input = next_pad;
+    }
+
+    if(next_pad != NULL){
+      g_object_unref(next_pad);
+    }
+  }else{
+    nth_input = ags_channel_nth(start_input,
+				line);
+
+    current_input = nth_input;
+      
+    /* get some fields */
+    current_link = ags_channel_get_link(current_input);
+      
+    /* check scope - input */
+    recall_id =
+      start_recall_id = ags_channel_check_scope(current_input, execution_plan->sound_scope);
+
+    current_recall_id = ags_recall_id_find_recycling_context(start_recall_id,
+							     recycling_context);
+
+    /* add recall */
+    if(current_recall_id != NULL){
+      ags_execution_plan_add_recall_id(execution_plan,
+				       (GObject *) current_input, (GObject *) current_recall_id);
+    }
+
+    /* free recall id */
+    g_list_free_full(start_recall_id,
+		     g_object_unref);
+
+    /* traverse the tree */
+    ags_channel_recursive_compile_run_stage_down(current_link,
+						 recycling_context,
+						 execution_plan);
+
+    if(current_link != NULL){
+      g_object_unref(current_link);
+    }
+
+    if(current_input != NULL){
+      g_object_unref(current_input);
+    }
+  }
+
+  /* unref */
+  if(start_input != NULL){
+    g_object_unref(start_input);
+  }
+}
+
+void
+ags_channel_recursive_cleanup_run_stage_up(AgsChannel *channel,
+					   AgsRecyclingContext *recycling_context,
+					   gint sound_scope, guint local_staging_flags)
+{
+  AgsAudio *current_audio;
+  AgsChannel *current_channel, *nth_channel;
+  AgsChannel *current_link;
+  AgsRecallID *current_recall_id;
+
+  GList *start_recall_id, *recall_id;
+
+  guint audio_channel;
+  guint line;
+    
+  static const guint staging_mask = (AGS_SOUND_STAGING_CHECK_RT_DATA |
+				     AGS_SOUND_STAGING_RUN_INIT_PRE |
+				     AGS_SOUND_STAGING_RUN_INIT_INTER |
+				     AGS_SOUND_STAGING_RUN_INIT_POST);
+    
+  if(!AGS_IS_CHANNEL(channel) ||
+     !AGS_IS_RECYCLING_CONTEXT(recycling_context)){
+    return;
+  }
+
+  current_channel = channel;
+
+  if(current_channel != NULL){
+    g_object_ref(current_channel);
+  }
+
+  current_link = NULL;
+    
+  if(AGS_IS_OUTPUT(channel)){
+    g_object_get(channel,
+		 "audio", &current_audio,
+		 NULL);
+      
+    goto ags_channel_recursive_cleanup_run_stage_up_OUTPUT;
+  }
+
+  while(current_channel != NULL){
+    /* check scope - input */
+    recall_id =
+      start_recall_id = ags_channel_check_scope(current_channel, sound_scope);
+
+    current_recall_id = ags_recall_id_find_recycling_context(start_recall_id,
+							     recycling_context);
+      
+    /* cancel */
+    if((AGS_CHANNEL_RECURSIVE_CLEANUP_STAGING_CANCEL_RECALL & (local_staging_flags)) != 0){
+      if(current_recall_id != NULL){
+	ags_channel_cancel_recall(current_channel,
+				  current_recall_id);
+      }
+    }
+
+    /* remove */
+    if((AGS_CHANNEL_RECURSIVE_CLEANUP_STAGING_REMOVE_RECALL & (local_staging_flags)) != 0){	
+      if(current_recall_id != NULL){
+	ags_channel_cleanup_recall(current_channel,
+				   current_recall_id);
+      }
+    }
+
+    /* fini - clean */
+    if((AGS_CHANNEL_RECURSIVE_CLEANUP_SCOPE & (local_staging_flags)) != 0){	
+      if(current_recall_id != NULL){
+	ags_channel_remove_recall_id(current_channel,
+				     current_recall_id);
+
+	ags_channel_unset_staging_flags(current_channel, sound_scope,
+					staging_mask);
+      }
+    }
+      
+    /* free recall id */
+    g_list_free_full(start_recall_id,
+		     g_object_unref);
+      
+    /* get current audio */
+    g_object_get(current_channel,
+		 "audio", &current_audio,
+		 NULL);
+      
+    /* check scope - audio */
+    recall_id =
+      start_recall_id = ags_audio_check_scope(current_audio, sound_scope);
+      
+    current_recall_id = ags_recall_id_find_recycling_context(start_recall_id,
+							     recycling_context);
+      
+    /* cancel */
+    if((AGS_CHANNEL_RECURSIVE_CLEANUP_STAGING_CANCEL_RECALL & (local_staging_flags)) != 0){
+      if(current_recall_id != NULL){
+	ags_audio_cancel_recall(current_audio,
+				current_recall_id);
+      }
+    }
+
+    /* remove */
+    if((AGS_CHANNEL_RECURSIVE_CLEANUP_STAGING_REMOVE_RECALL & (local_staging_flags)) != 0){
+      if(current_recall_id){
+	ags_audio_cleanup_recall(current_audio,
+				 current_recall_id);
+      }
+    }
+
+    /* fini - clean */
+    if((AGS_CHANNEL_RECURSIVE_CLEANUP_SCOPE & (local_staging_flags)) != 0){	
+      if(current_recall_id != NULL){
+	ags_audio_remove_recall_id(current_audio,
+				   (GObject *) current_recall_id);
+
+	ags_audio_unset_staging_flags(current_audio, sound_scope,
+				      staging_mask);
+      }
+    }
+
+    /* free recall id */
+    g_list_free_full(start_recall_id,
+		     g_object_unref);
+
+    /* get some fields */
+    g_object_get(current_channel,
+		 "audio-channel", &audio_channel,
+		 "line", &line,
+		 NULL);
+
+    /* move up */
+    if(current_channel != NULL){
+      g_object_unref(current_channel);
+    }
+
+    g_object_get(current_audio,
+		 "output", &current_channel,
+		 NULL);
+
+    if(ags_audio_test_flags(current_audio, AGS_AUDIO_OUTPUT_HAS_RECYCLING)){
+      /* fini - clean */
+      if((AGS_CHANNEL_RECURSIVE_CLEANUP_SCOPE & (local_staging_flags)) != 0){
+	ags_audio_remove_recycling_context(current_audio, (GObject *) recycling_context);
+      }
+
+      /* unref current audio */
+      g_object_unref(current_audio);
+	
+      break;
+    }
+
+    if(ags_audio_test_flags(current_audio, AGS_AUDIO_ASYNC)){
+      nth_channel = ags_channel_nth(current_channel,
+				    audio_channel);
+
+      g_object_unref(current_channel);
+	  
+      current_channel = nth_channel;
+    }else{
+      nth_channel = ags_channel_nth(current_channel,
+				    line);
+
+      g_object_unref(current_channel);
+
+      current_channel = nth_channel;
+    }
+      
+  ags_channel_recursive_cleanup_run_stage_up_OUTPUT:
+      
+    /* check scope - output */
+    recall_id =
+      start_recall_id = ags_channel_check_scope(current_channel, sound_scope);
+      
+    current_recall_id = ags_recall_id_find_recycling_context(start_recall_id,
+							     recycling_context);
+
+    /* cancel */
+    if((AGS_CHANNEL_RECURSIVE_CLEANUP_STAGING_CANCEL_RECALL & (local_staging_flags)) != 0){
+      if(current_recall_id != NULL){
+	ags_channel_cancel_recall(current_channel,
+				  current_recall_id);
+      }
+    }
+
+    /* remove */
+    if((AGS_CHANNEL_RECURSIVE_CLEANUP_STAGING_REMOVE_RECALL & (local_staging_flags)) != 0){
+      if(current_recall_id != NULL){
+	ags_channel_cleanup_recall(current_channel,
+				   current_recall_id);
+      }
+    }
+
+    /* fini - clean */
+    if((AGS_CHANNEL_RECURSIVE_CLEANUP_SCOPE & (local_staging_flags)) != 0){
+      if(current_recall_id){
+	ags_channel_remove_recall_id(current_channel,
+				     current_recall_id);
+
+	ags_channel_unset_staging_flags(current_channel, sound_scope,
+					staging_mask);
+      }
+    }
+      
+    /* free recall id */
+    g_list_free_full(start_recall_id,
+		     g_object_unref);
+      
+    /* fini - clean */
+    if((AGS_CHANNEL_RECURSIVE_CLEANUP_SCOPE & (local_staging_flags)) != 0){
+      ags_audio_remove_recycling_context(current_audio, (GObject *) recycling_context);
+    }
+      
+    /* unref current audio */
+    g_object_unref(current_audio);
+      
+    /* iterate */
+    current_link = ags_channel_get_link(current_channel);
+
+    g_object_unref(current_channel);
+
+    current_channel = current_link;
+  }
+
+  if(current_link != NULL){
+    g_object_unref(current_link);
+  }
+}
+
+void
+ags_channel_recursive_cleanup_run_stage_down(AgsChannel *channel,
+					     AgsRecyclingContext *recycling_context,
+					     gint sound_scope, guint local_staging_flags)
+{
+  AgsAudio *current_audio;
+  AgsChannel *start_input;
+  AgsChannel *current_input, *next_pad, *next_channel, *nth_input;
+  AgsRecallID *current_recall_id, *next_recall_id;
+  AgsRecyclingContext *next_recycling_context;
+    
+  GList *start_recall_id, *recall_id;
+
+  guint audio_channel, line;
+  gboolean play_context;
+    
+  static const guint staging_mask = (AGS_SOUND_STAGING_CHECK_RT_DATA |
+				     AGS_SOUND_STAGING_RUN_INIT_PRE |
+				     AGS_SOUND_STAGING_RUN_INIT_INTER |
+				     AGS_SOUND_STAGING_RUN_INIT_POST);
+
+  if(!AGS_IS_CHANNEL(channel) ||
+     !AGS_IS_RECYCLING_CONTEXT(recycling_context)){
+    return;
+  }
+
+  /* cleanup */
+  next_recycling_context = recycling_context;
+    
+  /* check scope - output */
+  recall_id =
+    start_recall_id = ags_channel_check_scope(channel, sound_scope);
+      
+  current_recall_id = ags_recall_id_find_recycling_context(start_recall_id,
+							   recycling_context);
+
+  /* cancel */
+  if((AGS_CHANNEL_RECURSIVE_CLEANUP_STAGING_CANCEL_RECALL & (local_staging_flags)) != 0){
+    if(current_recall_id != NULL){
+      ags_channel_cancel_recall(channel,
+				current_recall_id);
+    }
+  }
+
+  /* remove */
+  if((AGS_CHANNEL_RECURSIVE_CLEANUP_STAGING_REMOVE_RECALL & (local_staging_flags)) != 0){	
+    if(current_recall_id != NULL){
+      ags_channel_cleanup_recall(channel,
+				 current_recall_id);
+    }
+  }
+    
+  /* fini - clean */
+  if((AGS_CHANNEL_RECURSIVE_CLEANUP_SCOPE & (local_staging_flags)) != 0){	
+    if(current_recall_id != NULL){
+      ags_channel_remove_recall_id(channel,
+				   current_recall_id);
+
+      ags_channel_unset_staging_flags(channel, sound_scope,
+				      staging_mask);
+    }
+  }
+
+  /* free recall id */
+  g_list_free_full(start_recall_id,
+		   g_object_unref);
+
+  /* get current audio */
+  g_object_get(channel,
+	       "audio", &current_audio,
+	       "audio-channel", &audio_channel,
+	       "line", &line,
+	       NULL);
+      
+  /* check scope - audio */
+  recall_id =
+    start_recall_id = ags_audio_check_scope(current_audio, sound_scope);
+
+  current_recall_id = ags_recall_id_find_recycling_context(start_recall_id,
+							   recycling_context);
+      
+  /* cancel */
+  if((AGS_CHANNEL_RECURSIVE_CLEANUP_STAGING_CANCEL_RECALL & (local_staging_flags)) != 0){
+    if(current_recall_id != NULL){
+      ags_audio_cancel_recall(current_audio,
+			      current_recall_id);
+    }
+  }
+
+  /* remove */
+  if((AGS_CHANNEL_RECURSIVE_CLEANUP_STAGING_REMOVE_RECALL & (local_staging_flags)) != 0){
+    if(current_recall_id){
+      ags_audio_cleanup_recall(current_audio,
+			       current_recall_id);
+    }
+  }
+
+  /* fini - clean */
+  if((AGS_CHANNEL_RECURSIVE_CLEANUP_SCOPE & (local_staging_flags)) != 0){	
+    if(current_recall_id != NULL){
+      ags_audio_remove_recall_id(current_audio,
+				 (GObject *) current_recall_id);
+
+      ags_audio_unset_staging_flags(current_audio, sound_scope,
+				    staging_mask);
+    }
+  }
+
+  /* free recall id */
+  g_list_free_full(start_recall_id,
+		   g_object_unref);
+
+  /* get some fields */
+  g_object_get(current_audio,
+	       "input", &start_input,
+	       NULL);
+
+  /* check next recycling context */
+  if(ags_audio_test_flags(current_audio, AGS_AUDIO_OUTPUT_HAS_RECYCLING)){
+    AgsRecycling *first_recycling;
+
+    gint position;
+      
+    next_recycling_context = NULL;
+    first_recycling = NULL;
+
+    if(ags_audio_test_flags(current_audio, AGS_AUDIO_ASYNC)){
+      AgsChannel *first_with_recycling;
+	  
+      nth_input = ags_channel_nth(start_input,
+				  audio_channel);
+
+      current_input = nth_input;
+	
+      first_with_recycling = ags_channel_first_with_recycling(current_input);
+	  
+      g_object_get(first_with_recycling,
+		   "first-recycling", &first_recycling,
+		   NULL);
+
+      g_object_unref(first_with_recycling);
+
+      if(current_input != NULL){
+	g_object_unref(current_input);
+      }
+    }else{
+      nth_input = ags_channel_nth(start_input,
+				  line);
+
+      current_input = nth_input;
+
+      g_object_get(current_input,
+		   "first-recycling", &first_recycling,
+		   NULL);
+
+      if(current_input != NULL){
+	g_object_unref(current_input);
+      }
+    }
+
+    if(first_recycling != NULL){
+      position = ags_recycling_context_find_child(recycling_context,
+						  first_recycling);
+
+      if(position >= 0){
+	GList *child_start;
+
+	g_object_get(recycling_context,
+		     "child", &child_start,
+		     NULL);
+
+	next_recycling_context = g_list_nth_data(child_start, position);
+	g_list_free_full(child_start,
+			 g_object_unref);
+      }
+
+      g_object_unref(first_recycling);
+    }
+  }
+
+  if(next_recycling_context != NULL &&
+     next_recycling_context != recycling_context){
+    /* check scope - audio */
+    recall_id =
+      start_recall_id = ags_audio_check_scope(current_audio, sound_scope);
+
+    current_recall_id = ags_recall_id_find_recycling_context(start_recall_id,
+							     next_recycling_context);
+
+    /* cancel */
+    if((AGS_CHANNEL_RECURSIVE_CLEANUP_STAGING_CANCEL_RECALL & (local_staging_flags)) != 0){
+      if(current_recall_id != NULL){
+	ags_audio_cancel_recall(current_audio,
+				current_recall_id);
+      }
+    }
+
+    /* remove */
+    if((AGS_CHANNEL_RECURSIVE_CLEANUP_STAGING_REMOVE_RECALL & (local_staging_flags)) != 0){	
+      if(current_recall_id != NULL){
+	ags_audio_cleanup_recall(current_audio,
+				 current_recall_id);
+      }
+    }
+
+    /* fini - clean */
+    if((AGS_CHANNEL_RECURSIVE_CLEANUP_SCOPE & (local_staging_flags)) != 0){	
+      if(current_recall_id != NULL){
+	ags_audio_remove_recall_id(current_audio,
+				   (GObject *) current_recall_id);
+
+	ags_audio_unset_staging_flags(current_audio, sound_scope,
+				      staging_mask);
+      }
+    }      
+
+    g_list_free_full(start_recall_id,
+		     g_object_unref);
+  }
+
+  /* free recall id */
+  ags_channel_recursive_cleanup_run_stage_down_input(channel,
+						     next_recycling_context,
+						     sound_scope, local_staging_flags);
+    
+  /* unref */
+  if(start_input != NULL){
+    g_object_unref(start_input);
+  }
+    
+  /* fini - clean */
+  if((AGS_CHANNEL_RECURSIVE_CLEANUP_SCOPE & (local_staging_flags)) != 0){
+    ags_audio_remove_recycling_context(current_audio, (GObject *) recycling_context);
+    ags_audio_remove_recycling_context(current_audio, (GObject *) next_recycling_context);
+  }
+
+  /* unref */
+  if(current_audio != NULL){
+    g_object_unref(current_audio);
+  }
+}
+
+void
+ags_channel_recursive_cleanup_run_stage_down_input(AgsChannel *channel,
+						   AgsRecyclingContext *recycling_context,
+						   gint sound_scope, guint local_staging_flags)
+{
+  AgsAudio *current_audio;
+  AgsChannel *start_input;
+  AgsChannel *current_input, *next_pad, *nth_input;
+  AgsChannel *current_link;
+  AgsRecallID *current_recall_id;
+
+  GList *start_recall_id, *recall_id;
+
+  guint audio_channel, line;
+    
+  static const guint staging_mask = (AGS_SOUND_STAGING_CHECK_RT_DATA |
+				     AGS_SOUND_STAGING_RUN_INIT_PRE |
+				     AGS_SOUND_STAGING_RUN_INIT_INTER |
 				     AGS_SOUND_STAGING_RUN_INIT_POST);
 
   if(!AGS_IS_CHANNEL(channel) ||
@@ -15425,6 +15907,141 @@ ags_channel_recursive_run_stage(AgsChannel *channel,
   g_object_unref(G_OBJECT(channel));
 }
 
+/**
+ * ags_channel_recursive_compile_run_stage:
+ * @channel: the #AgsChannel
+ * @execution_plan: the #AgsExecutionPlan
+ * 
+ * Compile the play stages of @channel's recursive tree into @execution_plan. The
+ * recalls are appended in the very same order ags_channel_recursive_run_stage()
+ * would visit them.
+ * 
+ * Since: 3.7.0
+ */
+void
+ags_channel_recursive_compile_run_stage(AgsChannel *channel,
+					AgsExecutionPlan *execution_plan)
+{
+  AgsChannel *link;
+  AgsRecyclingContext *recycling_context;
+
+  GList *recall_id;
+
+  guint pad;
+
+  GRecMutex *channel_mutex;
+  GRecMutex *recall_id_mutex;
+
+  if(!AGS_IS_CHANNEL(channel) ||
+     execution_plan == NULL){
+    return;
+  }
+  
+  /* check scope - find recycling context */
+  recall_id = ags_channel_check_scope(channel, execution_plan->sound_scope);
+
+  recycling_context = NULL;
+    
+  if(recall_id != NULL){
+    AgsRecycling *recycling;
+    
+    GList *iter;
+
+    g_object_get(channel,
+		 "first-recycling", &recycling,
+		 NULL);
+    
+    iter = recall_id;
+
+    while(iter != NULL){
+      AgsRecallID *current_recall_id;
+      AgsRecyclingContext *current_recycling_context;
+      
+      current_recall_id = iter->data;
+
+      /* get recall id mutex */
+      recall_id_mutex = AGS_RECALL_ID_GET_OBJ_MUTEX(current_recall_id);
+      
+      /* get recycling context */
+      g_rec_mutex_lock(recall_id_mutex);
+      
+      current_recycling_context = current_recall_id->recycling_context;
+      
+      g_rec_mutex_unlock(recall_id_mutex);
+
+      if(ags_recycling_context_find(current_recycling_context, recycling) >= 0){
+	recycling_context = current_recycling_context;
+	
+	break;
+      }
+      
+      /* iterate */
+      iter = iter->next;
+    }
+
+    if(recycling != NULL){
+      g_object_unref(recycling);
+    }
+    
+    g_list_free_full(recall_id,
+		     g_object_unref);
+  }
+
+  if(recycling_context == NULL){
+    return;
+  }
+  
+  /* get channel mutex */
+  channel_mutex = AGS_CHANNEL_GET_OBJ_MUTEX(channel);
+  
+  /* get link and pad */
+  g_rec_mutex_lock(channel_mutex);
+      
+  link = channel->link;
+
+  pad = channel->pad;
+  
+  g_rec_mutex_unlock(channel_mutex);
+
+  if(AGS_IS_OUTPUT(channel)){
+    if(pad == 0){
+      AgsAudio *audio;
+
+      ags_channel_recursive_compile_run_stage_down(channel,
+						   recycling_context,
+						   execution_plan);
+
+      audio = NULL;
+    
+      g_object_get(channel,
+		   "audio", &audio,
+		   NULL);
+
+      ags_execution_plan_add_staging_completed(execution_plan,
+					       (GObject *) audio);
+      
+      ags_channel_recursive_compile_run_stage_up(link,
+						 recycling_context,
+						 execution_plan);
+
+      if(audio != NULL){
+	g_object_unref(audio);
+      }
+    }else{
+      ags_channel_recursive_compile_run_stage_up(channel,
+						 recycling_context,
+						 execution_plan);
+    }
+  }else{
+    ags_channel_recursive_compile_run_stage_down(link,
+						 recycling_context,
+						 execution_plan);
+    ags_channel_recursive_compile_run_stage_up(channel,
+					       recycling_context,
+					       execution_plan);
+  }
+}
+
 /**
  * ags_channel_new:
  * @audio: the #AgsAudio
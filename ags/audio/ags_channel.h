@@ -30,6 +30,7 @@
 #include <ags/audio/ags_recall.h>
 #include <ags/audio/ags_recycling.h>
 #include <ags/audio/ags_notation.h>
+#include <ags/audio/ags_execution_plan.h>
 
 #include <math.h>
 
@@ -401,6 +402,9 @@ void ags_channel_recursive_set_property(AgsChannel *channel,
 void ags_channel_recursive_run_stage(AgsChannel *channel,
 				     gint sound_scope, guint staging_flags);
 
+void ags_channel_recursive_compile_run_stage(AgsChannel *channel,
+					     AgsExecutionPlan *execution_plan);
+
 /* instantiate */
 AgsChannel* ags_channel_new(GObject *audio);
 
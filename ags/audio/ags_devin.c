@@ -646,7 +646,7 @@ ags_devin_init(AgsDevin *devin)
 
   devin->samplerate = ags_soundcard_helper_config_get_samplerate(config);
   devin->buffer_size = ags_soundcard_helper_config_get_buffer_size(config);
-  devin->format = ags_soundcard_helper_config_get_format(config);
+  devin->format = ags_soundcard_helper_config_get_device_format(config);
 
   /* device */
   if(use_alsa){
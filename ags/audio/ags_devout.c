@@ -222,6 +222,7 @@ enum{
   PROP_DSP_CHANNELS,
   PROP_PCM_CHANNELS,
   PROP_FORMAT,
+  PROP_DEVICE_FORMAT,
   PROP_BUFFER_SIZE,
   PROP_SAMPLERATE,
   PROP_BUFFER,
@@ -304,6 +305,7 @@ ags_devout_flags_get_type()
       { AGS_DEVOUT_START_PLAY, "AGS_DEVOUT_START_PLAY", "devout-start-play" },
       { AGS_DEVOUT_NONBLOCKING, "AGS_DEVOUT_NONBLOCKING", "devout-nonblocking" },
       { AGS_DEVOUT_INITIALIZED, "AGS_DEVOUT_INITIALIZED", "devout-initialized" },
+      { AGS_DEVOUT_FLOAT_MIX_BUS, "AGS_DEVOUT_FLOAT_MIX_BUS", "devout-float-mix-bus" },
       { 0, NULL, NULL }
     };
 
@@ -404,6 +406,25 @@ ags_devout_class_init(AgsDevoutClass *devout)
 				  PROP_FORMAT,
 				  param_spec);
 
+  /**
+   * AgsDevout:device-format:
+   *
+   * The precision of the device, differs from format if float mix bus
+   * is enabled. It can't be changed while the device is running.
+   * 
+   * Since: 3.7.0
+   */
+  param_spec = g_param_spec_uint("device-format",
+				 i18n_pspec("precision of device"),
+				 i18n_pspec("The precision written to the device"),
+				 0,
+				 G_MAXUINT32,
+				 AGS_SOUNDCARD_DEFAULT_FORMAT,
+				 G_PARAM_READABLE | G_PARAM_WRITABLE);
+  g_object_class_install_property(gobject,
+				  PROP_DEVICE_FORMAT,
+				  param_spec);
+
   /**
    * AgsDevout:buffer-size:
    *
@@ -671,7 +692,12 @@ ags_devout_init(AgsDevout *devout)
   devout->samplerate = ags_soundcard_helper_config_get_samplerate(config);
   devout->buffer_size = ags_soundcard_helper_config_get_buffer_size(config);
   devout->format = ags_soundcard_helper_config_get_format(config);
+  devout->device_format = ags_soundcard_helper_config_get_device_format(config);
 
+  if(ags_soundcard_helper_config_get_float_mix_bus(config)){
+    devout->flags |= AGS_DEVOUT_FLOAT_MIX_BUS;
+  }
+  
   /* device */
   if(use_alsa){
     devout->out.alsa.handle = NULL;
@@ -706,6 +732,8 @@ ags_devout_init(AgsDevout *devout)
   devout->buffer[2] = NULL;
   devout->buffer[3] = NULL;
 
+  devout->device_buffer = NULL;
+  
   g_atomic_int_set(&(devout->available),
 		   TRUE);
   
@@ -867,19 +895,67 @@ ags_devout_set_property(GObject *gobject,
 
       g_rec_mutex_lock(devout_mutex);
 
+      /* float mix bus keeps its buffers, the format applies to device */
+      if((AGS_DEVOUT_FLOAT_MIX_BUS & (devout->flags)) != 0){
+	if(format != AGS_SOUNDCARD_FLOAT &&
+	   format != devout->device_format){
+	  if(((AGS_DEVOUT_PLAY | AGS_DEVOUT_INITIALIZED) & (devout->flags)) != 0){
+	    g_warning("ags_devout.c - can't change device format while running");
+	  }else{
+	    devout->device_format = format;
+	  }
+	}
+	
+	g_rec_mutex_unlock(devout_mutex);
+	
+	return;
+      }
+      
       if(format == devout->format){
 	g_rec_mutex_unlock(devout_mutex);
 	
 	return;
       }
 
+      /* device buffer and ring buffer were allocated for the device format */
+      if(((AGS_DEVOUT_PLAY | AGS_DEVOUT_INITIALIZED) & (devout->flags)) != 0){
+	g_rec_mutex_unlock(devout_mutex);
+
+	g_warning("ags_devout.c - can't change device format while running");
+	
+	return;
+      }
+
       devout->format = format;
+      devout->device_format = format;
 
       g_rec_mutex_unlock(devout_mutex);
 
       ags_devout_realloc_buffer(devout);
     }
     break;
+  case PROP_DEVICE_FORMAT:
+    {
+      guint device_format;
+
+      device_format = g_value_get_uint(value);
+
+      g_rec_mutex_lock(devout_mutex);
+
+      if(device_format != devout->device_format &&
+	 ((AGS_DEVOUT_PLAY | AGS_DEVOUT_INITIALIZED) & (devout->flags)) != 0){
+	g_rec_mutex_unlock(devout_mutex);
+
+	g_warning("ags_devout.c - can't change device format while running");
+	
+	return;
+      }
+
+      devout->device_format = device_format;
+
+      g_rec_mutex_unlock(devout_mutex);
+    }
+    break;
   case PROP_BUFFER_SIZE:
     {
       guint buffer_size;
@@ -1032,6 +1108,15 @@ ags_devout_get_property(GObject *gobject,
       g_rec_mutex_unlock(devout_mutex);
     }
     break;
+  case PROP_DEVICE_FORMAT:
+    {
+      g_rec_mutex_lock(devout_mutex);
+
+      g_value_set_uint(value, devout->device_format);
+
+      g_rec_mutex_unlock(devout_mutex);
+    }
+    break;
   case PROP_BUFFER_SIZE:
     {
       g_rec_mutex_lock(devout_mutex);
@@ -1118,6 +1203,10 @@ ags_devout_finalize(GObject *gobject)
   free(devout->buffer[2]);
   free(devout->buffer[3]);
 
+  if(devout->device_buffer != NULL){
+    free(devout->device_buffer);
+  }
+  
   /* free buffer array */
   free(devout->buffer);
 
@@ -2159,7 +2248,7 @@ ags_devout_oss_init(AgsSoundcard *soundcard,
 
   gchar *str;
 
-  guint word_size;
+  guint word_size, buffer_word_size;
   int format;
   int tmp;
   guint i;
@@ -2178,7 +2267,7 @@ ags_devout_oss_init(AgsSoundcard *soundcard,
   /* retrieve word size */
   g_rec_mutex_lock(devout_mutex);
 
-  switch(devout->format){
+  switch(devout->device_format){
   case AGS_SOUNDCARD_SIGNED_8_BIT:
     {
 #ifdef AGS_WITH_OSS
@@ -2224,15 +2313,28 @@ ags_devout_oss_init(AgsSoundcard *soundcard,
     return;
   }
 
+  /* float mix bus converts to device format */
+  buffer_word_size = word_size;
+  
+  if((AGS_DEVOUT_FLOAT_MIX_BUS & (devout->flags)) != 0){
+    buffer_word_size = sizeof(gfloat);
+
+    if(devout->device_buffer != NULL){
+      free(devout->device_buffer);
+    }
+    
+    devout->device_buffer = (void *) malloc(devout->pcm_channels * devout->buffer_size * word_size);
+  }
+  
   /* prepare for playback */
   devout->flags |= (AGS_DEVOUT_START_PLAY |
 		    AGS_DEVOUT_PLAY |
 		    AGS_DEVOUT_NONBLOCKING);
 
-  memset(devout->buffer[0], 0, devout->pcm_channels * devout->buffer_size * word_size);
-  memset(devout->buffer[1], 0, devout->pcm_channels * devout->buffer_size * word_size);
-  memset(devout->buffer[2], 0, devout->pcm_channels * devout->buffer_size * word_size);
-  memset(devout->buffer[3], 0, devout->pcm_channels * devout->buffer_size * word_size);
+  memset(devout->buffer[0], 0, devout->pcm_channels * devout->buffer_size * buffer_word_size);
+  memset(devout->buffer[1], 0, devout->pcm_channels * devout->buffer_size * buffer_word_size);
+  memset(devout->buffer[2], 0, devout->pcm_channels * devout->buffer_size * buffer_word_size);
+  memset(devout->buffer[3], 0, devout->pcm_channels * devout->buffer_size * buffer_word_size);
 
   /* allocate ring buffer */
   g_atomic_int_set(&(devout->available),
@@ -2569,7 +2671,7 @@ ags_devout_oss_play(AgsSoundcard *soundcard,
   g_rec_mutex_lock(devout_mutex);
   
   /* retrieve word size */
-  switch(devout->format){
+  switch(devout->device_format){
   case AGS_SOUNDCARD_SIGNED_8_BIT:
     {
       word_size = sizeof(gint8);
@@ -2627,11 +2729,24 @@ ags_devout_oss_play(AgsSoundcard *soundcard,
   ags_soundcard_lock_buffer(soundcard,
 			    devout->buffer[nth_buffer]);
 
-  ags_devout_oss_play_fill_ring_buffer(devout->buffer[nth_buffer],
-				       devout->format,
-				       devout->ring_buffer[devout->nth_ring_buffer],
-				       devout->pcm_channels,
-				       devout->buffer_size);
+  if((AGS_DEVOUT_FLOAT_MIX_BUS & (devout->flags)) != 0){
+    /* convert float mix bus once */
+    ags_soundcard_util_convert_float_to_device(devout->device_buffer, devout->device_format,
+					       devout->buffer[nth_buffer],
+					       devout->pcm_channels * devout->buffer_size);
+    
+    ags_devout_oss_play_fill_ring_buffer(devout->device_buffer,
+					 devout->device_format,
+					 devout->ring_buffer[devout->nth_ring_buffer],
+					 devout->pcm_channels,
+					 devout->buffer_size);
+  }else{
+    ags_devout_oss_play_fill_ring_buffer(devout->buffer[nth_buffer],
+					 devout->format,
+					 devout->ring_buffer[devout->nth_ring_buffer],
+					 devout->pcm_channels,
+					 devout->buffer_size);
+  }
 
   ags_soundcard_unlock_buffer(soundcard,
 			      devout->buffer[nth_buffer]);
@@ -2747,6 +2862,12 @@ ags_devout_oss_free(AgsSoundcard *soundcard)
   
   devout->ring_buffer = NULL;
 
+  if(devout->device_buffer != NULL){
+    free(devout->device_buffer);
+  }
+
+  devout->device_buffer = NULL;
+
   /* reset flags */
   devout->flags &= (~(AGS_DEVOUT_BUFFER0 |
 		      AGS_DEVOUT_BUFFER1 |
@@ -2801,7 +2922,7 @@ ags_devout_alsa_init(AgsSoundcard *soundcard,
   int err, dir;
 #endif
 
-  guint word_size;
+  guint word_size, buffer_word_size;
   guint i, i_stop;
   
   GRecMutex *devout_mutex; 
@@ -2831,7 +2952,7 @@ ags_devout_alsa_init(AgsSoundcard *soundcard,
   format = SND_PCM_FORMAT_S16;
 #endif
   
-  switch(devout->format){
+  switch(devout->device_format){
   case AGS_SOUNDCARD_SIGNED_8_BIT:
     {
 #ifdef AGS_WITH_ALSA
@@ -2882,15 +3003,28 @@ ags_devout_alsa_init(AgsSoundcard *soundcard,
     return;
   }
 
+  /* float mix bus converts to device format */
+  buffer_word_size = word_size;
+  
+  if((AGS_DEVOUT_FLOAT_MIX_BUS & (devout->flags)) != 0){
+    buffer_word_size = sizeof(gfloat);
+
+    if(devout->device_buffer != NULL){
+      free(devout->device_buffer);
+    }
+    
+    devout->device_buffer = (void *) malloc(devout->pcm_channels * devout->buffer_size * word_size);
+  }
+  
   /* prepare for playback */
   devout->flags |= (AGS_DEVOUT_START_PLAY |
 		    AGS_DEVOUT_PLAY |
 		    AGS_DEVOUT_NONBLOCKING);
 
-  memset(devout->buffer[0], 0, devout->pcm_channels * devout->buffer_size * word_size);
-  memset(devout->buffer[1], 0, devout->pcm_channels * devout->buffer_size * word_size);
-  memset(devout->buffer[2], 0, devout->pcm_channels * devout->buffer_size * word_size);
-  memset(devout->buffer[3], 0, devout->pcm_channels * devout->buffer_size * word_size);
+  memset(devout->buffer[0], 0, devout->pcm_channels * devout->buffer_size * buffer_word_size);
+  memset(devout->buffer[1], 0, devout->pcm_channels * devout->buffer_size * buffer_word_size);
+  memset(devout->buffer[2], 0, devout->pcm_channels * devout->buffer_size * buffer_word_size);
+  memset(devout->buffer[3], 0, devout->pcm_channels * devout->buffer_size * buffer_word_size);
 
   /* allocate ring buffer */
 #ifdef AGS_WITH_ALSA
@@ -3544,7 +3678,7 @@ ags_devout_alsa_play(AgsSoundcard *soundcard,
   g_rec_mutex_lock(devout_mutex);
   
   /* retrieve word size */
-  switch(devout->format){
+  switch(devout->device_format){
   case AGS_SOUNDCARD_SIGNED_8_BIT:
     {
       word_size = sizeof(gint8);
@@ -3611,9 +3745,20 @@ ags_devout_alsa_play(AgsSoundcard *soundcard,
   ags_soundcard_lock_buffer(soundcard,
 			    devout->buffer[nth_buffer]);
   
-  ags_devout_alsa_play_fill_ring_buffer(devout->buffer[nth_buffer], devout->format,
-					devout->ring_buffer[devout->nth_ring_buffer],
-					devout->pcm_channels, devout->buffer_size);
+  if((AGS_DEVOUT_FLOAT_MIX_BUS & (devout->flags)) != 0){
+    /* convert float mix bus once */
+    ags_soundcard_util_convert_float_to_device(devout->device_buffer, devout->device_format,
+					       devout->buffer[nth_buffer],
+					       devout->pcm_channels * devout->buffer_size);
+    
+    ags_devout_alsa_play_fill_ring_buffer(devout->device_buffer, devout->device_format,
+					  devout->ring_buffer[devout->nth_ring_buffer],
+					  devout->pcm_channels, devout->buffer_size);
+  }else{
+    ags_devout_alsa_play_fill_ring_buffer(devout->buffer[nth_buffer], devout->format,
+					  devout->ring_buffer[devout->nth_ring_buffer],
+					  devout->pcm_channels, devout->buffer_size);
+  }
 
   ags_soundcard_unlock_buffer(soundcard,
 			      devout->buffer[nth_buffer]);
@@ -3774,6 +3919,12 @@ ags_devout_alsa_free(AgsSoundcard *soundcard)
   
   devout->ring_buffer = NULL;
 
+  if(devout->device_buffer != NULL){
+    free(devout->device_buffer);
+  }
+
+  devout->device_buffer = NULL;
+
   /* reset flags */
   devout->flags &= (~(AGS_DEVOUT_BUFFER0 |
 		      AGS_DEVOUT_BUFFER1 |
@@ -4688,6 +4839,16 @@ ags_devout_realloc_buffer(AgsDevout *devout)
       word_size = sizeof(gint64);
     }
     break;
+  case AGS_SOUNDCARD_FLOAT:
+    {
+      word_size = sizeof(gfloat);
+    }
+    break;
+  case AGS_SOUNDCARD_DOUBLE:
+    {
+      word_size = sizeof(gdouble);
+    }
+    break;
   default:
     g_warning("ags_devout_realloc_buffer(): unsupported word size");
     return;
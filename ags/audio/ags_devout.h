@@ -63,6 +63,7 @@ typedef struct _AgsDevoutClass AgsDevoutClass;
  * @AGS_DEVOUT_START_PLAY: playback starting
  * @AGS_DEVOUT_NONBLOCKING: do non-blocking calls
  * @AGS_DEVOUT_INITIALIZED: the soundcard was initialized
+ * @AGS_DEVOUT_FLOAT_MIX_BUS: buffers are float, convert to device format while filling ring buffer
  * 
  * Enum values to control the behavior or indicate internal state of #AgsDevout by
  * enable/disable as flags.
@@ -89,6 +90,8 @@ typedef enum
 
   AGS_DEVOUT_NONBLOCKING        = 1 << 12,
   AGS_DEVOUT_INITIALIZED        = 1 << 13,
+
+  AGS_DEVOUT_FLOAT_MIX_BUS      = 1 << 14,
 }AgsDevoutFlags;
 
 #define AGS_DEVOUT_ERROR (ags_devout_error_quark())
@@ -117,6 +120,7 @@ struct _AgsDevout
   guint dsp_channels;
   guint pcm_channels;
   guint format;
+  guint device_format;
   guint buffer_size;
   guint samplerate; // sample_rate
   
@@ -126,6 +130,7 @@ struct _AgsDevout
   GRecMutex **sub_block_mutex;
 
   void **buffer;
+  void *device_buffer;
 
   volatile gboolean available;
   
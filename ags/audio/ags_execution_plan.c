@@ -0,0 +1,478 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <ags/audio/ags_execution_plan.h>
+
+#include <ags/audio/ags_audio.h>
+#include <ags/audio/ags_channel.h>
+#include <ags/audio/ags_recall.h>
+#include <ags/audio/ags_recall_audio.h>
+#include <ags/audio/ags_recall_channel.h>
+#include <ags/audio/ags_recall_id.h>
+#include <ags/audio/ags_recycling_context.h>
+
+void ags_execution_plan_append(AgsExecutionPlan *execution_plan,
+			       guint entry_type,
+			       GObject *object,
+			       GObject *recall_id);
+
+/**
+ * SECTION:ags_execution_plan
+ * @short_description: flattened run stage
+ * @title: AgsExecutionPlan
+ * @section_id:
+ * @include: ags/audio/ags_execution_plan.h
+ *
+ * The #AgsExecutionPlan is the recall tree of one sound scope compiled into
+ * a flat array, in the very order ags_audio_recursive_run_stage() would visit
+ * the recalls. It is compiled again after links, recall IDs or recalls changed
+ * and replaces the recursive traversal for the stages of the staging program.
+ */
+
+static volatile guint ags_execution_plan_generation = 1;
+
+GType
+ags_execution_plan_get_type()
+{
+  static volatile gsize g_define_type_id__volatile = 0;
+
+  if(g_once_init_enter (&g_define_type_id__volatile)){
+    GType ags_type_execution_plan = 0;
+
+    ags_type_execution_plan =
+      g_boxed_type_register_static("AgsExecutionPlan",
+				   (GBoxedCopyFunc) ags_execution_plan_ref,
+				   (GBoxedFreeFunc) ags_execution_plan_unref);
+
+    g_once_init_leave(&g_define_type_id__volatile, ags_type_execution_plan);
+  }
+
+  return g_define_type_id__volatile;
+}
+
+/**
+ * ags_execution_plan_alloc:
+ * @sound_scope: the sound scope
+ *
+ * Allocate an empty #AgsExecutionPlan of @sound_scope. The generation is taken
+ * now, so changes done while compiling invalidate the plan.
+ *
+ * Returns: (transfer full): the new #AgsExecutionPlan
+ *
+ * Since: 3.7.0
+ */
+AgsExecutionPlan*
+ags_execution_plan_alloc(gint sound_scope)
+{
+  AgsExecutionPlan *execution_plan;
+
+  execution_plan = (AgsExecutionPlan *) g_malloc(sizeof(AgsExecutionPlan));
+
+  execution_plan->ref_count = 1;
+
+  execution_plan->sound_scope = sound_scope;
+  execution_plan->generation = ags_execution_plan_get_generation();
+
+  execution_plan->length = 0;
+  execution_plan->allocated_length = 0;
+
+  execution_plan->entry = NULL;
+
+  return(execution_plan);
+}
+
+/**
+ * ags_execution_plan_ref:
+ * @execution_plan: the #AgsExecutionPlan
+ *
+ * Increase reference count of @execution_plan.
+ *
+ * Returns: (transfer full): @execution_plan
+ *
+ * Since: 3.7.0
+ */
+AgsExecutionPlan*
+ags_execution_plan_ref(AgsExecutionPlan *execution_plan)
+{
+  if(execution_plan == NULL){
+    return(NULL);
+  }
+
+  g_atomic_int_inc(&(execution_plan->ref_count));
+
+  return(execution_plan);
+}
+
+/**
+ * ags_execution_plan_unref:
+ * @execution_plan: the #AgsExecutionPlan
+ *
+ * Decrease reference count of @execution_plan and free it if the count drops to 0.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_execution_plan_unref(AgsExecutionPlan *execution_plan)
+{
+  guint i;
+
+  if(execution_plan == NULL){
+    return;
+  }
+
+  if(g_atomic_int_dec_and_test(&(execution_plan->ref_count))){
+    for(i = 0; i < execution_plan->length; i++){
+      g_object_unref(execution_plan->entry[i].object);
+
+      if(execution_plan->entry[i].recall_id != NULL){
+	g_object_unref(execution_plan->entry[i].recall_id);
+      }
+    }
+
+    g_free(execution_plan->entry);
+    
+    g_free(execution_plan);
+  }
+}
+
+/**
+ * ags_execution_plan_invalidate:
+ *
+ * Invalidate all #AgsExecutionPlan, call it as links, recall IDs or recalls
+ * change.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_execution_plan_invalidate()
+{
+  g_atomic_int_inc(&ags_execution_plan_generation);
+}
+
+/**
+ * ags_execution_plan_get_generation:
+ *
+ * Get the current generation.
+ *
+ * Returns: the generation
+ *
+ * Since: 3.7.0
+ */
+guint
+ags_execution_plan_get_generation()
+{
+  return(g_atomic_int_get(&ags_execution_plan_generation));
+}
+
+/**
+ * ags_execution_plan_is_valid:
+ * @execution_plan: the #AgsExecutionPlan
+ *
+ * Check @execution_plan to be compiled from the current tree.
+ *
+ * Returns: %TRUE if valid, else %FALSE
+ *
+ * Since: 3.7.0
+ */
+gboolean
+ags_execution_plan_is_valid(AgsExecutionPlan *execution_plan)
+{
+  if(execution_plan == NULL){
+    return(FALSE);
+  }
+
+  return((execution_plan->generation == ags_execution_plan_get_generation()) ? TRUE: FALSE);
+}
+
+/**
+ * ags_execution_plan_test_staging_flags:
+ * @staging_flags: the staging flags
+ *
+ * Test @staging_flags to be run by #AgsExecutionPlan. Init, cancel, remove and
+ * fini stages modify the tree and take the recursive path.
+ *
+ * Returns: %TRUE if supported, else %FALSE
+ *
+ * Since: 3.7.0
+ */
+gboolean
+ags_execution_plan_test_staging_flags(guint staging_flags)
+{
+  return(((~AGS_EXECUTION_PLAN_STAGING_MASK) & (staging_flags)) == 0 ? TRUE: FALSE);
+}
+
+void
+ags_execution_plan_append(AgsExecutionPlan *execution_plan,
+			  guint entry_type,
+			  GObject *object,
+			  GObject *recall_id)
+{
+  AgsExecutionPlanEntry *entry;
+
+  if(execution_plan->length == execution_plan->allocated_length){
+    execution_plan->allocated_length = (execution_plan->allocated_length == 0) ? 16: (2 * execution_plan->allocated_length);
+
+    execution_plan->entry = (AgsExecutionPlanEntry *) g_realloc(execution_plan->entry,
+								execution_plan->allocated_length * sizeof(AgsExecutionPlanEntry));
+  }
+
+  entry = &(execution_plan->entry[execution_plan->length]);
+
+  entry->entry_type = entry_type;
+
+  entry->object = g_object_ref(object);
+  entry->recall_id = (recall_id != NULL) ? g_object_ref(recall_id): NULL;
+
+  execution_plan->length += 1;
+}
+
+/**
+ * ags_execution_plan_add_recall_id:
+ * @execution_plan: the #AgsExecutionPlan
+ * @object: the #AgsAudio or #AgsChannel
+ * @recall_id: the #AgsRecallID
+ *
+ * Append the recalls ags_audio_play_recall() or ags_channel_play_recall() would
+ * run for @recall_id of @object.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_execution_plan_add_recall_id(AgsExecutionPlan *execution_plan,
+				 GObject *object,
+				 GObject *recall_id)
+{
+  AgsRecyclingContext *parent_recycling_context, *recycling_context;
+  
+  GList *start_list, *list;
+
+  GRecMutex *list_mutex;
+
+  if(execution_plan == NULL ||
+     (!AGS_IS_AUDIO(object) &&
+      !AGS_IS_CHANNEL(object)) ||
+     !AGS_IS_RECALL_ID(recall_id)){
+    return;
+  }
+
+  recycling_context = NULL;
+
+  g_object_get(recall_id,
+	       "recycling-context", &recycling_context,
+	       NULL);
+
+  if(recycling_context == NULL){
+    return;
+  }
+  
+  parent_recycling_context = NULL;
+  
+  g_object_get(recycling_context,
+	       "parent", &parent_recycling_context,
+	       NULL);
+
+  /* get the appropriate list */
+  if(AGS_IS_AUDIO(object)){
+    list_mutex = (parent_recycling_context == NULL) ? AGS_AUDIO_GET_PLAY_MUTEX(object): AGS_AUDIO_GET_RECALL_MUTEX(object);
+
+    g_rec_mutex_lock(list_mutex);
+
+    start_list = g_list_copy_deep((parent_recycling_context == NULL) ? AGS_AUDIO(object)->play: AGS_AUDIO(object)->recall,
+				  (GCopyFunc) g_object_ref,
+				  NULL);
+
+    g_rec_mutex_unlock(list_mutex);
+  }else{
+    list_mutex = (parent_recycling_context == NULL) ? AGS_CHANNEL_GET_PLAY_MUTEX(object): AGS_CHANNEL_GET_RECALL_MUTEX(object);
+
+    g_rec_mutex_lock(list_mutex);
+
+    start_list = g_list_copy_deep((parent_recycling_context == NULL) ? AGS_CHANNEL(object)->play: AGS_CHANNEL(object)->recall,
+				  (GCopyFunc) g_object_ref,
+				  NULL);
+
+    g_rec_mutex_unlock(list_mutex);
+  }
+
+  start_list = g_list_reverse(start_list);
+
+  /* automate */
+  list = start_list;
+  
+  while(list != NULL){
+    if((AGS_IS_AUDIO(object) && AGS_IS_RECALL_AUDIO(list->data)) ||
+       (AGS_IS_CHANNEL(object) && AGS_IS_RECALL_CHANNEL(list->data))){
+      ags_execution_plan_append(execution_plan,
+				AGS_EXECUTION_PLAN_ENTRY_AUTOMATE,
+				list->data,
+				recall_id);
+    }
+
+    list = list->next;
+  }
+
+  /* play */
+  list = start_list;
+
+  while((list = ags_recall_find_recycling_context(list,
+						  (GObject *) recycling_context)) != NULL){
+    ags_execution_plan_append(execution_plan,
+			      AGS_EXECUTION_PLAN_ENTRY_PLAY,
+			      list->data,
+			      recall_id);
+
+    list = list->next;
+  }
+
+  g_list_free_full(start_list,
+		   g_object_unref);
+
+  if(parent_recycling_context != NULL){
+    g_object_unref(parent_recycling_context);
+  }
+
+  g_object_unref(recycling_context);
+}
+
+/**
+ * ags_execution_plan_add_staging_completed:
+ * @execution_plan: the #AgsExecutionPlan
+ * @audio: the #AgsAudio
+ *
+ * Append setting staging completed of all output of @audio.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_execution_plan_add_staging_completed(AgsExecutionPlan *execution_plan,
+					 GObject *audio)
+{
+  AgsChannel *output, *next;
+
+  if(execution_plan == NULL ||
+     !AGS_IS_AUDIO(audio)){
+    return;
+  }
+
+  output = NULL;
+	
+  g_object_get(audio,
+	       "output", &output,
+	       NULL);
+
+  while(output != NULL){
+    ags_execution_plan_append(execution_plan,
+			      AGS_EXECUTION_PLAN_ENTRY_STAGING_COMPLETED,
+			      (GObject *) output,
+			      NULL);
+
+    /* iterate */
+    next = ags_channel_next(output);
+
+    g_object_unref(output);
+	
+    output = next;
+  }
+}
+
+/**
+ * ags_execution_plan_run:
+ * @execution_plan: the #AgsExecutionPlan
+ * @staging_flags: the staging flags
+ *
+ * Run @staging_flags of all entries in @execution_plan. The @staging_flags
+ * are expected to pass ags_execution_plan_test_staging_flags().
+ *
+ * Since: 3.7.0
+ */
+void
+ags_execution_plan_run(AgsExecutionPlan *execution_plan,
+		       guint staging_flags)
+{
+  AgsExecutionPlanEntry *entry;
+  
+  guint play_staging_flags;
+  gboolean do_automate;
+  guint i;
+  
+  static const guint staging_mask = (AGS_SOUND_STAGING_RUN_INIT_PRE |
+				     AGS_SOUND_STAGING_RUN_INIT_INTER |
+				     AGS_SOUND_STAGING_RUN_INIT_POST |
+				     AGS_SOUND_STAGING_FEED_INPUT_QUEUE |
+				     AGS_SOUND_STAGING_AUTOMATE |
+				     AGS_SOUND_STAGING_RUN_PRE |
+				     AGS_SOUND_STAGING_RUN_INTER |
+				     AGS_SOUND_STAGING_RUN_POST |
+				     AGS_SOUND_STAGING_DO_FEEDBACK |
+				     AGS_SOUND_STAGING_FEED_OUTPUT_QUEUE |
+				     AGS_SOUND_STAGING_FINI);
+
+  if(execution_plan == NULL){
+    return;
+  }
+
+  /* same masking as the play recall signal */
+  do_automate = FALSE;
+  play_staging_flags = staging_flags;
+  
+  if((AGS_SOUND_STAGING_FX & (staging_flags)) == 0){
+    play_staging_flags = staging_flags & staging_mask;
+
+    if((AGS_SOUND_STAGING_AUTOMATE & (play_staging_flags)) != 0){
+      do_automate = TRUE;
+    }
+    
+    play_staging_flags &= (~AGS_SOUND_STAGING_AUTOMATE);
+  }
+
+  for(i = 0; i < execution_plan->length; i++){
+    entry = &(execution_plan->entry[i]);
+
+    switch(entry->entry_type){
+    case AGS_EXECUTION_PLAN_ENTRY_AUTOMATE:
+      {
+	if(do_automate &&
+	   !ags_recall_id_check_state_flags((AgsRecallID *) entry->recall_id, AGS_SOUND_STATE_IS_TERMINATING)){
+	  ags_recall_set_staging_flags((AgsRecall *) entry->object,
+				       AGS_SOUND_STAGING_AUTOMATE);
+	  ags_recall_unset_staging_flags((AgsRecall *) entry->object,
+					 AGS_SOUND_STAGING_AUTOMATE);
+	}
+      }
+      break;
+    case AGS_EXECUTION_PLAN_ENTRY_PLAY:
+      {
+	if(!ags_recall_id_check_state_flags((AgsRecallID *) entry->recall_id, AGS_SOUND_STATE_IS_TERMINATING)){
+	  ags_recall_set_staging_flags((AgsRecall *) entry->object,
+				       play_staging_flags);
+	  ags_recall_unset_staging_flags((AgsRecall *) entry->object,
+					 play_staging_flags);
+	}
+      }
+      break;
+    case AGS_EXECUTION_PLAN_ENTRY_STAGING_COMPLETED:
+      {
+	ags_channel_set_staging_completed((AgsChannel *) entry->object,
+					  execution_plan->sound_scope);
+      }
+      break;
+    }
+  }
+}
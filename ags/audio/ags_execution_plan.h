@@ -0,0 +1,108 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __AGS_EXECUTION_PLAN_H__
+#define __AGS_EXECUTION_PLAN_H__
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <ags/libags.h>
+
+#include <ags/audio/ags_sound_enums.h>
+
+G_BEGIN_DECLS
+
+#define AGS_TYPE_EXECUTION_PLAN         (ags_execution_plan_get_type())
+#define AGS_EXECUTION_PLAN(ptr) ((AgsExecutionPlan *)(ptr))
+#define AGS_EXECUTION_PLAN_ENTRY(ptr) ((AgsExecutionPlanEntry *)(ptr))
+
+#define AGS_EXECUTION_PLAN_STAGING_MASK (AGS_SOUND_STAGING_FEED_INPUT_QUEUE |	\
+					 AGS_SOUND_STAGING_AUTOMATE |	\
+					 AGS_SOUND_STAGING_RUN_PRE |	\
+					 AGS_SOUND_STAGING_RUN_INTER |	\
+					 AGS_SOUND_STAGING_RUN_POST |	\
+					 AGS_SOUND_STAGING_DO_FEEDBACK | \
+					 AGS_SOUND_STAGING_FEED_OUTPUT_QUEUE | \
+					 AGS_SOUND_STAGING_FX)
+
+typedef struct _AgsExecutionPlan AgsExecutionPlan;
+typedef struct _AgsExecutionPlanEntry AgsExecutionPlanEntry;
+
+/**
+ * AgsExecutionPlanEntryType:
+ * @AGS_EXECUTION_PLAN_ENTRY_AUTOMATE: automate the recall
+ * @AGS_EXECUTION_PLAN_ENTRY_PLAY: play the recall
+ * @AGS_EXECUTION_PLAN_ENTRY_STAGING_COMPLETED: set staging completed of the output channel
+ *
+ * Enum values describing what an #AgsExecutionPlanEntry does.
+ */
+typedef enum{
+  AGS_EXECUTION_PLAN_ENTRY_AUTOMATE,
+  AGS_EXECUTION_PLAN_ENTRY_PLAY,
+  AGS_EXECUTION_PLAN_ENTRY_STAGING_COMPLETED,
+}AgsExecutionPlanEntryType;
+
+struct _AgsExecutionPlanEntry
+{
+  guint entry_type;
+
+  GObject *object;
+  GObject *recall_id;
+};
+
+struct _AgsExecutionPlan
+{
+  volatile gint ref_count;
+
+  gint sound_scope;
+  guint generation;
+
+  guint length;
+  guint allocated_length;
+  
+  AgsExecutionPlanEntry *entry;
+};
+
+GType ags_execution_plan_get_type();
+
+AgsExecutionPlan* ags_execution_plan_alloc(gint sound_scope);
+
+AgsExecutionPlan* ags_execution_plan_ref(AgsExecutionPlan *execution_plan);
+void ags_execution_plan_unref(AgsExecutionPlan *execution_plan);
+
+void ags_execution_plan_invalidate();
+guint ags_execution_plan_get_generation();
+
+gboolean ags_execution_plan_is_valid(AgsExecutionPlan *execution_plan);
+gboolean ags_execution_plan_test_staging_flags(guint staging_flags);
+
+void ags_execution_plan_add_recall_id(AgsExecutionPlan *execution_plan,
+				      GObject *object,
+				      GObject *recall_id);
+void ags_execution_plan_add_staging_completed(AgsExecutionPlan *execution_plan,
+					      GObject *audio);
+
+void ags_execution_plan_run(AgsExecutionPlan *execution_plan,
+			    guint staging_flags);
+
+G_END_DECLS
+
+#endif /*__AGS_EXECUTION_PLAN_H__*/
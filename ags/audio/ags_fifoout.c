@@ -567,7 +567,7 @@ ags_fifoout_init(AgsFifoout *fifoout)
 
   fifoout->samplerate = ags_soundcard_helper_config_get_samplerate(config);
   fifoout->buffer_size = ags_soundcard_helper_config_get_buffer_size(config);
-  fifoout->format = ags_soundcard_helper_config_get_format(config);
+  fifoout->format = ags_soundcard_helper_config_get_device_format(config);
 
   /*  */
   fifoout->device = AGS_FIFOOUT_DEFAULT_DEVICE;
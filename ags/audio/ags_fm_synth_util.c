@@ -20,10 +20,47 @@
 #include <ags/audio/ags_fm_synth_util.h>
 
 #include <ags/audio/ags_synth_enums.h>
+#include <ags/audio/ags_synth_util.h>
 #include <ags/audio/ags_audio_buffer_util.h>
 
 #include <math.h>
 #include <complex.h>
+#include <string.h>
+
+gdouble ags_fm_synth_util_get_lfo_factor(guint lfo_osc_mode,
+					 gdouble lfo_freq, gdouble lfo_depth,
+					 gdouble tuning,
+					 guint samplerate,
+					 guint x);
+void ags_fm_synth_util_init_carrier(gdouble freq, gdouble phase,
+				    guint samplerate,
+				    guint x,
+				    guint lfo_osc_mode,
+				    gdouble lfo_freq, gdouble lfo_depth,
+				    gdouble tuning,
+				    gdouble *carrier_phase, gdouble *current_dt);
+void ags_fm_synth_util_render_chunk(gdouble *buffer,
+				    guint oscillator_mode,
+				    gdouble freq, gdouble volume,
+				    guint samplerate,
+				    guint x, guint n_frames,
+				    guint lfo_osc_mode,
+				    gdouble lfo_freq, gdouble lfo_depth,
+				    gdouble tuning,
+				    gdouble *carrier_phase, gdouble *current_dt);
+void ags_fm_synth_util_render_modulated_chunk(gdouble *buffer,
+					      guint oscillator_mode,
+					      gdouble freq, gdouble volume,
+					      guint samplerate,
+					      guint x, guint n_frames,
+					      AgsModulationSource *modulation_source,
+					      gdouble *carrier_phase, gdouble *current_dt);
+void ags_fm_synth_util_render_carrier(gdouble *buffer,
+				      guint oscillator_mode,
+				      gdouble volume,
+				      guint n_frames,
+				      gdouble *dt,
+				      gdouble *carrier_phase);
 
 /**
  * SECTION:ags_fm_synth_util
@@ -35,6 +72,1074 @@
  * Utility functions to compute FM synths.
  */
 
+gdouble
+ags_fm_synth_util_get_lfo_factor(guint lfo_osc_mode,
+				 gdouble lfo_freq, gdouble lfo_depth,
+				 gdouble tuning,
+				 guint samplerate,
+				 guint x)
+{
+  gdouble t;
+  gdouble lfo;
+
+  t = (gdouble) x * lfo_freq / (gdouble) samplerate;
+  t -= floor(t);
+
+  lfo = 0.0;
+  
+  switch(lfo_osc_mode){
+  case AGS_SYNTH_OSCILLATOR_SIN:
+  {
+    lfo = ags_synth_util_sin_lookup(t);
+  }
+  break;
+  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
+  {
+    lfo = 2.0 * t - 1.0;
+  }
+  break;
+  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
+  {
+    lfo = 1.0 - 4.0 * fabs(t - 0.5);
+  }
+  break;
+  case AGS_SYNTH_OSCILLATOR_SQUARE:
+  {
+    lfo = (t < 0.5) ? 1.0: -1.0;
+  }
+  break;
+  case AGS_SYNTH_OSCILLATOR_IMPULSE:
+  {
+    lfo = (t < 0.6 || t >= 0.9) ? 1.0: -1.0;
+  }
+  break;
+  }
+
+  return(exp2(tuning / 1200.0 + lfo * lfo_depth));
+}
+
+void
+ags_fm_synth_util_init_carrier(gdouble freq, gdouble phase,
+			       guint samplerate,
+			       guint x,
+			       guint lfo_osc_mode,
+			       gdouble lfo_freq, gdouble lfo_depth,
+			       gdouble tuning,
+			       gdouble *carrier_phase, gdouble *current_dt)
+{
+  ags_synth_util_sin_table_init();
+
+  /* carrier cycles per frame at the first frame */
+  current_dt[0] = freq * ags_fm_synth_util_get_lfo_factor(lfo_osc_mode,
+							  lfo_freq, lfo_depth,
+							  tuning,
+							  samplerate,
+							  x) / (gdouble) samplerate;
+
+  carrier_phase[0] = ((gdouble) x + phase) * current_dt[0];
+  carrier_phase[0] -= floor(carrier_phase[0]);
+}
+
+void
+ags_fm_synth_util_render_chunk(gdouble *buffer,
+			       guint oscillator_mode,
+			       gdouble freq, gdouble volume,
+			       guint samplerate,
+			       guint x, guint n_frames,
+			       guint lfo_osc_mode,
+			       gdouble lfo_freq, gdouble lfo_depth,
+			       gdouble tuning,
+			       gdouble *carrier_phase, gdouble *current_dt)
+{
+  gdouble dt[AGS_SYNTH_UTIL_CHUNK_SIZE];
+
+  gdouble next_dt;
+  gdouble ramp;
+  guint control_count;
+  guint j, k;
+  
+  /* control rate - ramp the frequency to the next control point */
+  for(j = 0; j < n_frames; j += control_count){
+    control_count = n_frames - j;
+
+    if(control_count > AGS_FM_SYNTH_UTIL_CONTROL_PERIOD){
+      control_count = AGS_FM_SYNTH_UTIL_CONTROL_PERIOD;
+    }
+
+    next_dt = freq * ags_fm_synth_util_get_lfo_factor(lfo_osc_mode,
+						      lfo_freq, lfo_depth,
+						      tuning,
+						      samplerate,
+						      x + j + control_count) / (gdouble) samplerate;
+
+    ramp = (next_dt - current_dt[0]) / (gdouble) control_count;
+      
+    for(k = 0; k < control_count; k++){
+      dt[j + k] = current_dt[0] + (gdouble) k * ramp;
+    }
+
+    current_dt[0] = next_dt;
+  }
+
+  ags_fm_synth_util_render_carrier(buffer,
+				   oscillator_mode,
+				   volume,
+				   n_frames,
+				   dt,
+				   carrier_phase);
+}
+
+void
+ags_fm_synth_util_render_modulated_chunk(gdouble *buffer,
+					 guint oscillator_mode,
+					 gdouble freq, gdouble volume,
+					 guint samplerate,
+					 guint x, guint n_frames,
+					 AgsModulationSource *modulation_source,
+					 gdouble *carrier_phase, gdouble *current_dt)
+{
+  gdouble dt[AGS_SYNTH_UTIL_CHUNK_SIZE];
+
+  gdouble next_dt;
+  gdouble ramp;
+  guint control_count;
+  guint j, k;
+  
+  /* control rate - the LFO is read from the shared control points */
+  for(j = 0; j < n_frames; j += control_count){
+    control_count = n_frames - j;
+
+    if(control_count > AGS_FM_SYNTH_UTIL_CONTROL_PERIOD){
+      control_count = AGS_FM_SYNTH_UTIL_CONTROL_PERIOD;
+    }
+
+    next_dt = freq * exp2(ags_modulation_source_get_value(modulation_source,
+							  x + j + control_count)) / (gdouble) samplerate;
+
+    ramp = (next_dt - current_dt[0]) / (gdouble) control_count;
+      
+    for(k = 0; k < control_count; k++){
+      dt[j + k] = current_dt[0] + (gdouble) k * ramp;
+    }
+
+    current_dt[0] = next_dt;
+  }
+
+  ags_fm_synth_util_render_carrier(buffer,
+				   oscillator_mode,
+				   volume,
+				   n_frames,
+				   dt,
+				   carrier_phase);
+}
+
+void
+ags_fm_synth_util_render_carrier(gdouble *buffer,
+				 guint oscillator_mode,
+				 gdouble volume,
+				 guint n_frames,
+				 gdouble *dt,
+				 gdouble *carrier_phase)
+{
+  gdouble t[AGS_SYNTH_UTIL_CHUNK_SIZE];
+
+  guint j;
+
+  /* running phase */
+  for(j = 0; j < n_frames; j++){
+    t[j] = carrier_phase[0];
+
+    carrier_phase[0] += dt[j];
+    carrier_phase[0] -= floor(carrier_phase[0]);
+  }
+
+  /* only the poly BLEP width is taken from the magnitude */
+  for(j = 0; j < n_frames; j++){
+    dt[j] = fabs(dt[j]);
+
+    if(dt[j] > 0.5){
+      dt[j] = 0.5;
+    }
+  }
+    
+  switch(oscillator_mode){
+  case AGS_SYNTH_OSCILLATOR_SIN:
+  {
+    for(j = 0; j < n_frames; j++){
+      buffer[j] += ags_synth_util_sin_lookup(t[j]) * volume;
+    }
+  }
+  break;
+  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
+  {
+    for(j = 0; j < n_frames; j++){
+      buffer[j] += (2.0 * t[j] - 1.0 - ags_synth_util_poly_blep(t[j], dt[j])) * volume;
+    }
+  }
+  break;
+  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
+  {
+    gdouble u;
+      
+    for(j = 0; j < n_frames; j++){
+      u = t[j] + 0.5;
+      u -= floor(u);
+	
+      buffer[j] += (1.0 - 4.0 * fabs(t[j] - 0.5) + 4.0 * dt[j] * (ags_synth_util_poly_blamp(t[j], dt[j]) - ags_synth_util_poly_blamp(u, dt[j]))) * volume;
+    }
+  }
+  break;
+  case AGS_SYNTH_OSCILLATOR_SQUARE:
+  {
+    gdouble u;
+      
+    for(j = 0; j < n_frames; j++){
+      u = t[j] + 0.5;
+      u -= floor(u);
+
+      buffer[j] += (((t[j] < 0.5) ? 1.0: -1.0) + ags_synth_util_poly_blep(t[j], dt[j]) - ags_synth_util_poly_blep(u, dt[j])) * volume;
+    }
+  }
+  break;
+  case AGS_SYNTH_OSCILLATOR_IMPULSE:
+  {
+    gdouble u, v;
+
+    for(j = 0; j < n_frames; j++){
+      u = t[j] + 0.4;
+      u -= floor(u);
+
+      v = t[j] + 0.1;
+      v -= floor(v);
+
+      buffer[j] += (((t[j] < 0.6 || t[j] >= 0.9) ? 1.0: -1.0) - ags_synth_util_poly_blep(u, dt[j]) + ags_synth_util_poly_blep(v, dt[j])) * volume;
+    }
+  }
+  break;
+  }
+}
+
+/**
+ * ags_fm_synth_util_oscillate_double:
+ * @buffer: the audio buffer
+ * @oscillator_mode: the #AgsSynthOscillatorMode of the carrier
+ * @freq: the frequency of the wave
+ * @phase: the phase of the wave in frames
+ * @volume: the volume of the wave
+ * @samplerate: the samplerate
+ * @offset: start frame
+ * @n_frames: generate n frames
+ * @lfo_osc_mode: the LFO's oscillator mode
+ * @lfo_freq: the LFO's frequency
+ * @lfo_depth: the LFO's depth
+ * @tuning: the tuninig
+ *
+ * Add @n_frames of a frequency modulated wave to @buffer.
+ *
+ * The LFO is evaluated every %AGS_FM_SYNTH_UTIL_CONTROL_PERIOD frames
+ * and the carrier frequency ramps linearly in between. The carrier keeps
+ * a running phase and is rendered like ags_synth_util_oscillate_double()
+ * does, so there is no transcendental call per frame.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_fm_synth_util_oscillate_double(gdouble *buffer,
+				   guint oscillator_mode,
+				   gdouble freq, gdouble phase, gdouble volume,
+				   guint samplerate,
+				   guint offset, guint n_frames,
+				   guint lfo_osc_mode,
+				   gdouble lfo_freq, gdouble lfo_depth,
+				   gdouble tuning)
+{
+  gdouble carrier_phase, current_dt;
+  guint count;
+  guint i;
+
+  if(buffer == NULL ||
+     samplerate == 0){
+    return;
+  }
+
+  if(oscillator_mode >= AGS_SYNTH_OSCILLATOR_LAST){
+    g_warning("ags_fm_synth_util_oscillate_double() - unknown oscillator mode");
+
+    return;
+  }
+
+  ags_fm_synth_util_init_carrier(freq, phase,
+				 samplerate,
+				 offset,
+				 lfo_osc_mode,
+				 lfo_freq, lfo_depth,
+				 tuning,
+				 &carrier_phase, &current_dt);
+  
+  for(i = offset; i < offset + n_frames; i += count){
+    count = offset + n_frames - i;
+
+    if(count > AGS_SYNTH_UTIL_CHUNK_SIZE){
+      count = AGS_SYNTH_UTIL_CHUNK_SIZE;
+    }
+
+    ags_fm_synth_util_render_chunk(buffer + i,
+				   oscillator_mode,
+				   freq, volume,
+				   samplerate,
+				   i, count,
+				   lfo_osc_mode,
+				   lfo_freq, lfo_depth,
+				   tuning,
+				   &carrier_phase, &current_dt);
+  }
+}
+
+/**
+ * ags_fm_synth_util_oscillate_s8:
+ * @buffer: the audio buffer
+ * @oscillator_mode: the #AgsSynthOscillatorMode of the carrier
+ * @freq: the frequency of the wave
+ * @phase: the phase of the wave
+ * @volume: the volume of the wave
+ * @samplerate: the samplerate
+ * @offset: start frame
+ * @n_frames: generate n frames
+ * @lfo_osc_mode: the LFO's oscillator mode
+ * @lfo_freq: the LFO's frequency
+ * @lfo_depth: the LFO's depth
+ * @tuning: the tuninig
+ *
+ * Add frequency modulated wave to @buffer.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_fm_synth_util_oscillate_s8(gint8 *buffer,
+			       guint oscillator_mode,
+			       gdouble freq, gdouble phase, gdouble volume,
+			       guint samplerate,
+			       guint offset, guint n_frames,
+			       guint lfo_osc_mode,
+			       gdouble lfo_freq, gdouble lfo_depth,
+			       gdouble tuning)
+{
+  static const gdouble scale = 127.0;
+
+  gdouble y[AGS_SYNTH_UTIL_CHUNK_SIZE];
+
+  gdouble carrier_phase, current_dt;
+  guint count;
+  guint i, j;
+
+  if(buffer == NULL ||
+     samplerate == 0 ||
+     oscillator_mode >= AGS_SYNTH_OSCILLATOR_LAST){
+    return;
+  }
+
+  ags_fm_synth_util_init_carrier(freq, phase,
+				 samplerate,
+				 offset,
+				 lfo_osc_mode,
+				 lfo_freq, lfo_depth,
+				 tuning,
+				 &carrier_phase, &current_dt);
+
+  for(i = offset; i < offset + n_frames; i += count){
+    count = offset + n_frames - i;
+
+    if(count > AGS_SYNTH_UTIL_CHUNK_SIZE){
+      count = AGS_SYNTH_UTIL_CHUNK_SIZE;
+    }
+
+    memset(y, 0, count * sizeof(gdouble));
+    
+    ags_fm_synth_util_render_chunk(y,
+				   oscillator_mode,
+				   freq, volume * scale,
+				   samplerate,
+				   i, count,
+				   lfo_osc_mode,
+				   lfo_freq, lfo_depth,
+				   tuning,
+				   &carrier_phase, &current_dt);
+
+    for(j = 0; j < count; j++){
+      buffer[i + j] = (gint8) (0xff & ((gint16) buffer[i + j] + (gint16) y[j]));
+    }
+  }
+}
+
+/**
+ * ags_fm_synth_util_oscillate_s16:
+ * @buffer: the audio buffer
+ * @oscillator_mode: the #AgsSynthOscillatorMode of the carrier
+ * @freq: the frequency of the wave
+ * @phase: the phase of the wave
+ * @volume: the volume of the wave
+ * @samplerate: the samplerate
+ * @offset: start frame
+ * @n_frames: generate n frames
+ * @lfo_osc_mode: the LFO's oscillator mode
+ * @lfo_freq: the LFO's frequency
+ * @lfo_depth: the LFO's depth
+ * @tuning: the tuninig
+ *
+ * Add frequency modulated wave to @buffer.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_fm_synth_util_oscillate_s16(gint16 *buffer,
+				guint oscillator_mode,
+				gdouble freq, gdouble phase, gdouble volume,
+				guint samplerate,
+				guint offset, guint n_frames,
+				guint lfo_osc_mode,
+				gdouble lfo_freq, gdouble lfo_depth,
+				gdouble tuning)
+{
+  static const gdouble scale = 32767.0;
+
+  gdouble y[AGS_SYNTH_UTIL_CHUNK_SIZE];
+
+  gdouble carrier_phase, current_dt;
+  guint count;
+  guint i, j;
+
+  if(buffer == NULL ||
+     samplerate == 0 ||
+     oscillator_mode >= AGS_SYNTH_OSCILLATOR_LAST){
+    return;
+  }
+
+  ags_fm_synth_util_init_carrier(freq, phase,
+				 samplerate,
+				 offset,
+				 lfo_osc_mode,
+				 lfo_freq, lfo_depth,
+				 tuning,
+				 &carrier_phase, &current_dt);
+
+  for(i = offset; i < offset + n_frames; i += count){
+    count = offset + n_frames - i;
+
+    if(count > AGS_SYNTH_UTIL_CHUNK_SIZE){
+      count = AGS_SYNTH_UTIL_CHUNK_SIZE;
+    }
+
+    memset(y, 0, count * sizeof(gdouble));
+    
+    ags_fm_synth_util_render_chunk(y,
+				   oscillator_mode,
+				   freq, volume * scale,
+				   samplerate,
+				   i, count,
+				   lfo_osc_mode,
+				   lfo_freq, lfo_depth,
+				   tuning,
+				   &carrier_phase, &current_dt);
+
+    for(j = 0; j < count; j++){
+      buffer[i + j] = (gint16) (0xffff & ((gint32) buffer[i + j] + (gint32) y[j]));
+    }
+  }
+}
+
+/**
+ * ags_fm_synth_util_oscillate_s24:
+ * @buffer: the audio buffer
+ * @oscillator_mode: the #AgsSynthOscillatorMode of the carrier
+ * @freq: the frequency of the wave
+ * @phase: the phase of the wave
+ * @volume: the volume of the wave
+ * @samplerate: the samplerate
+ * @offset: start frame
+ * @n_frames: generate n frames
+ * @lfo_osc_mode: the LFO's oscillator mode
+ * @lfo_freq: the LFO's frequency
+ * @lfo_depth: the LFO's depth
+ * @tuning: the tuninig
+ *
+ * Add frequency modulated wave to @buffer.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_fm_synth_util_oscillate_s24(gint32 *buffer,
+				guint oscillator_mode,
+				gdouble freq, gdouble phase, gdouble volume,
+				guint samplerate,
+				guint offset, guint n_frames,
+				guint lfo_osc_mode,
+				gdouble lfo_freq, gdouble lfo_depth,
+				gdouble tuning)
+{
+  static const gdouble scale = 8388607.0;
+
+  gdouble y[AGS_SYNTH_UTIL_CHUNK_SIZE];
+
+  gdouble carrier_phase, current_dt;
+  guint count;
+  guint i, j;
+
+  if(buffer == NULL ||
+     samplerate == 0 ||
+     oscillator_mode >= AGS_SYNTH_OSCILLATOR_LAST){
+    return;
+  }
+
+  ags_fm_synth_util_init_carrier(freq, phase,
+				 samplerate,
+				 offset,
+				 lfo_osc_mode,
+				 lfo_freq, lfo_depth,
+				 tuning,
+				 &carrier_phase, &current_dt);
+
+  for(i = offset; i < offset + n_frames; i += count){
+    count = offset + n_frames - i;
+
+    if(count > AGS_SYNTH_UTIL_CHUNK_SIZE){
+      count = AGS_SYNTH_UTIL_CHUNK_SIZE;
+    }
+
+    memset(y, 0, count * sizeof(gdouble));
+    
+    ags_fm_synth_util_render_chunk(y,
+				   oscillator_mode,
+				   freq, volume * scale,
+				   samplerate,
+				   i, count,
+				   lfo_osc_mode,
+				   lfo_freq, lfo_depth,
+				   tuning,
+				   &carrier_phase, &current_dt);
+
+    for(j = 0; j < count; j++){
+      buffer[i + j] = (gint32) (0xffffffff & ((gint32) buffer[i + j] + (gint32) y[j]));
+    }
+  }
+}
+
+/**
+ * ags_fm_synth_util_oscillate_s32:
+ * @buffer: the audio buffer
+ * @oscillator_mode: the #AgsSynthOscillatorMode of the carrier
+ * @freq: the frequency of the wave
+ * @phase: the phase of the wave
+ * @volume: the volume of the wave
+ * @samplerate: the samplerate
+ * @offset: start frame
+ * @n_frames: generate n frames
+ * @lfo_osc_mode: the LFO's oscillator mode
+ * @lfo_freq: the LFO's frequency
+ * @lfo_depth: the LFO's depth
+ * @tuning: the tuninig
+ *
+ * Add frequency modulated wave to @buffer.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_fm_synth_util_oscillate_s32(gint32 *buffer,
+				guint oscillator_mode,
+				gdouble freq, gdouble phase, gdouble volume,
+				guint samplerate,
+				guint offset, guint n_frames,
+				guint lfo_osc_mode,
+				gdouble lfo_freq, gdouble lfo_depth,
+				gdouble tuning)
+{
+  static const gdouble scale = 214748363.0;
+
+  gdouble y[AGS_SYNTH_UTIL_CHUNK_SIZE];
+
+  gdouble carrier_phase, current_dt;
+  guint count;
+  guint i, j;
+
+  if(buffer == NULL ||
+     samplerate == 0 ||
+     oscillator_mode >= AGS_SYNTH_OSCILLATOR_LAST){
+    return;
+  }
+
+  ags_fm_synth_util_init_carrier(freq, phase,
+				 samplerate,
+				 offset,
+				 lfo_osc_mode,
+				 lfo_freq, lfo_depth,
+				 tuning,
+				 &carrier_phase, &current_dt);
+
+  for(i = offset; i < offset + n_frames; i += count){
+    count = offset + n_frames - i;
+
+    if(count > AGS_SYNTH_UTIL_CHUNK_SIZE){
+      count = AGS_SYNTH_UTIL_CHUNK_SIZE;
+    }
+
+    memset(y, 0, count * sizeof(gdouble));
+    
+    ags_fm_synth_util_render_chunk(y,
+				   oscillator_mode,
+				   freq, volume * scale,
+				   samplerate,
+				   i, count,
+				   lfo_osc_mode,
+				   lfo_freq, lfo_depth,
+				   tuning,
+				   &carrier_phase, &current_dt);
+
+    for(j = 0; j < count; j++){
+      buffer[i + j] = (gint32) (0xffffffff & ((gint64) buffer[i + j] + (gint64) y[j]));
+    }
+  }
+}
+
+/**
+ * ags_fm_synth_util_oscillate_s64:
+ * @buffer: the audio buffer
+ * @oscillator_mode: the #AgsSynthOscillatorMode of the carrier
+ * @freq: the frequency of the wave
+ * @phase: the phase of the wave
+ * @volume: the volume of the wave
+ * @samplerate: the samplerate
+ * @offset: start frame
+ * @n_frames: generate n frames
+ * @lfo_osc_mode: the LFO's oscillator mode
+ * @lfo_freq: the LFO's frequency
+ * @lfo_depth: the LFO's depth
+ * @tuning: the tuninig
+ *
+ * Add frequency modulated wave to @buffer.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_fm_synth_util_oscillate_s64(gint64 *buffer,
+				guint oscillator_mode,
+				gdouble freq, gdouble phase, gdouble volume,
+				guint samplerate,
+				guint offset, guint n_frames,
+				guint lfo_osc_mode,
+				gdouble lfo_freq, gdouble lfo_depth,
+				gdouble tuning)
+{
+  static const gdouble scale = 9223372036854775807.0;
+
+  gdouble y[AGS_SYNTH_UTIL_CHUNK_SIZE];
+
+  gdouble carrier_phase, current_dt;
+  guint count;
+  guint i, j;
+
+  if(buffer == NULL ||
+     samplerate == 0 ||
+     oscillator_mode >= AGS_SYNTH_OSCILLATOR_LAST){
+    return;
+  }
+
+  ags_fm_synth_util_init_carrier(freq, phase,
+				 samplerate,
+				 offset,
+				 lfo_osc_mode,
+				 lfo_freq, lfo_depth,
+				 tuning,
+				 &carrier_phase, &current_dt);
+
+  for(i = offset; i < offset + n_frames; i += count){
+    count = offset + n_frames - i;
+
+    if(count > AGS_SYNTH_UTIL_CHUNK_SIZE){
+      count = AGS_SYNTH_UTIL_CHUNK_SIZE;
+    }
+
+    memset(y, 0, count * sizeof(gdouble));
+    
+    ags_fm_synth_util_render_chunk(y,
+				   oscillator_mode,
+				   freq, volume * scale,
+				   samplerate,
+				   i, count,
+				   lfo_osc_mode,
+				   lfo_freq, lfo_depth,
+				   tuning,
+				   &carrier_phase, &current_dt);
+
+    for(j = 0; j < count; j++){
+      buffer[i + j] = (gint64) (0xffffffffffff & ((gint64) buffer[i + j] + (gint64) y[j]));
+    }
+  }
+}
+
+/**
+ * ags_fm_synth_util_oscillate_float:
+ * @buffer: the audio buffer
+ * @oscillator_mode: the #AgsSynthOscillatorMode of the carrier
+ * @freq: the frequency of the wave
+ * @phase: the phase of the wave
+ * @volume: the volume of the wave
+ * @samplerate: the samplerate
+ * @offset: start frame
+ * @n_frames: generate n frames
+ * @lfo_osc_mode: the LFO's oscillator mode
+ * @lfo_freq: the LFO's frequency
+ * @lfo_depth: the LFO's depth
+ * @tuning: the tuninig
+ *
+ * Add frequency modulated wave to @buffer.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_fm_synth_util_oscillate_float(float *buffer,
+				  guint oscillator_mode,
+				  gdouble freq, gdouble phase, gdouble volume,
+				  guint samplerate,
+				  guint offset, guint n_frames,
+				  guint lfo_osc_mode,
+				  gdouble lfo_freq, gdouble lfo_depth,
+				  gdouble tuning)
+{
+  gdouble y[AGS_SYNTH_UTIL_CHUNK_SIZE];
+
+  gdouble carrier_phase, current_dt;
+  guint count;
+  guint i, j;
+
+  if(buffer == NULL ||
+     samplerate == 0 ||
+     oscillator_mode >= AGS_SYNTH_OSCILLATOR_LAST){
+    return;
+  }
+
+  ags_fm_synth_util_init_carrier(freq, phase,
+				 samplerate,
+				 offset,
+				 lfo_osc_mode,
+				 lfo_freq, lfo_depth,
+				 tuning,
+				 &carrier_phase, &current_dt);
+
+  for(i = offset; i < offset + n_frames; i += count){
+    count = offset + n_frames - i;
+
+    if(count > AGS_SYNTH_UTIL_CHUNK_SIZE){
+      count = AGS_SYNTH_UTIL_CHUNK_SIZE;
+    }
+
+    memset(y, 0, count * sizeof(gdouble));
+    
+    ags_fm_synth_util_render_chunk(y,
+				   oscillator_mode,
+				   freq, volume,
+				   samplerate,
+				   i, count,
+				   lfo_osc_mode,
+				   lfo_freq, lfo_depth,
+				   tuning,
+				   &carrier_phase, &current_dt);
+
+    for(j = 0; j < count; j++){
+      buffer[i + j] = (float) ((gdouble) buffer[i + j] + y[j]);
+    }
+  }
+}
+
+/**
+ * ags_fm_synth_util_oscillate_complex:
+ * @buffer: the audio buffer
+ * @oscillator_mode: the #AgsSynthOscillatorMode of the carrier
+ * @freq: the frequency of the wave
+ * @phase: the phase of the wave
+ * @volume: the volume of the wave
+ * @samplerate: the samplerate
+ * @offset: start frame
+ * @n_frames: generate n frames
+ * @lfo_osc_mode: the LFO's oscillator mode
+ * @lfo_freq: the LFO's frequency
+ * @lfo_depth: the LFO's depth
+ * @tuning: the tuninig
+ *
+ * Set @buffer to frequency modulated wave.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_fm_synth_util_oscillate_complex(AgsComplex *buffer,
+				    guint oscillator_mode,
+				    gdouble freq, gdouble phase, gdouble volume,
+				    guint samplerate,
+				    guint offset, guint n_frames,
+				    guint lfo_osc_mode,
+				    gdouble lfo_freq, gdouble lfo_depth,
+				    gdouble tuning)
+{
+  AgsComplex *c_ptr;
+  AgsComplex **c_ptr_ptr;
+
+  gdouble y[AGS_SYNTH_UTIL_CHUNK_SIZE];
+
+  gdouble carrier_phase, current_dt;
+  guint count;
+  guint i, j;
+
+  if(buffer == NULL ||
+     samplerate == 0 ||
+     oscillator_mode >= AGS_SYNTH_OSCILLATOR_LAST){
+    return;
+  }
+
+  c_ptr = buffer;
+  c_ptr_ptr = &c_ptr;
+
+  ags_fm_synth_util_init_carrier(freq, phase,
+				 samplerate,
+				 offset,
+				 lfo_osc_mode,
+				 lfo_freq, lfo_depth,
+				 tuning,
+				 &carrier_phase, &current_dt);
+
+  for(i = offset; i < offset + n_frames; i += count){
+    count = offset + n_frames - i;
+
+    if(count > AGS_SYNTH_UTIL_CHUNK_SIZE){
+      count = AGS_SYNTH_UTIL_CHUNK_SIZE;
+    }
+
+    memset(y, 0, count * sizeof(gdouble));
+    
+    ags_fm_synth_util_render_chunk(y,
+				   oscillator_mode,
+				   freq, volume,
+				   samplerate,
+				   i, count,
+				   lfo_osc_mode,
+				   lfo_freq, lfo_depth,
+				   tuning,
+				   &carrier_phase, &current_dt);
+
+    for(j = 0; j < count; j++, c_ptr++){
+      AGS_AUDIO_BUFFER_UTIL_DOUBLE_TO_COMPLEX(y[j], c_ptr_ptr);
+    }
+  }
+}
+
+/**
+ * ags_fm_synth_util_oscillate:
+ * @buffer: the audio buffer
+ * @oscillator_mode: the #AgsSynthOscillatorMode of the carrier
+ * @freq: the frequency of the wave
+ * @phase: the phase of the wave
+ * @volume: the volume of the wave
+ * @samplerate: the samplerate
+ * @audio_buffer_util_format: the audio data format
+ * @offset: start frame
+ * @n_frames: generate n frames
+ * @lfo_osc_mode: the LFO's oscillator mode
+ * @lfo_freq: the LFO's frequency
+ * @lfo_depth: the LFO's depth
+ * @tuning: the tuninig
+ *
+ * Generate frequency modulated wave of @oscillator_mode.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_fm_synth_util_oscillate(void *buffer,
+			    guint oscillator_mode,
+			    gdouble freq, gdouble phase, gdouble volume,
+			    guint samplerate, guint audio_buffer_util_format,
+			    guint offset, guint n_frames,
+			    guint lfo_osc_mode,
+			    gdouble lfo_freq, gdouble lfo_depth,
+			    gdouble tuning)
+{
+  switch(audio_buffer_util_format){
+  case AGS_AUDIO_BUFFER_UTIL_S8:
+  {
+    ags_fm_synth_util_oscillate_s8((gint8 *) buffer,
+				   oscillator_mode,
+				   freq, phase, volume,
+				   samplerate,
+				   offset, n_frames,
+				   lfo_osc_mode,
+				   lfo_freq, lfo_depth,
+				   tuning);
+  }
+  break;
+  case AGS_AUDIO_BUFFER_UTIL_S16:
+  {
+    ags_fm_synth_util_oscillate_s16((gint16 *) buffer,
+				    oscillator_mode,
+				    freq, phase, volume,
+				    samplerate,
+				    offset, n_frames,
+				    lfo_osc_mode,
+				    lfo_freq, lfo_depth,
+				    tuning);
+  }
+  break;
+  case AGS_AUDIO_BUFFER_UTIL_S24:
+  {
+    ags_fm_synth_util_oscillate_s24((gint32 *) buffer,
+				    oscillator_mode,
+				    freq, phase, volume,
+				    samplerate,
+				    offset, n_frames,
+				    lfo_osc_mode,
+				    lfo_freq, lfo_depth,
+				    tuning);
+  }
+  break;
+  case AGS_AUDIO_BUFFER_UTIL_S32:
+  {
+    ags_fm_synth_util_oscillate_s32((gint32 *) buffer,
+				    oscillator_mode,
+				    freq, phase, volume,
+				    samplerate,
+				    offset, n_frames,
+				    lfo_osc_mode,
+				    lfo_freq, lfo_depth,
+				    tuning);
+  }
+  break;
+  case AGS_AUDIO_BUFFER_UTIL_S64:
+  {
+    ags_fm_synth_util_oscillate_s64((gint64 *) buffer,
+				    oscillator_mode,
+				    freq, phase, volume,
+				    samplerate,
+				    offset, n_frames,
+				    lfo_osc_mode,
+				    lfo_freq, lfo_depth,
+				    tuning);
+  }
+  break;
+  case AGS_AUDIO_BUFFER_UTIL_FLOAT:
+  {
+    ags_fm_synth_util_oscillate_float((float *) buffer,
+				      oscillator_mode,
+				      freq, phase, volume,
+				      samplerate,
+				      offset, n_frames,
+				      lfo_osc_mode,
+				      lfo_freq, lfo_depth,
+				      tuning);
+  }
+  break;
+  case AGS_AUDIO_BUFFER_UTIL_DOUBLE:
+  {
+    ags_fm_synth_util_oscillate_double((double *) buffer,
+				       oscillator_mode,
+				       freq, phase, volume,
+				       samplerate,
+				       offset, n_frames,
+				       lfo_osc_mode,
+				       lfo_freq, lfo_depth,
+				       tuning);
+  }
+  break;
+  case AGS_AUDIO_BUFFER_UTIL_COMPLEX:
+  {
+    ags_fm_synth_util_oscillate_complex((AgsComplex *) buffer,
+					oscillator_mode,
+					freq, phase, volume,
+					samplerate,
+					offset, n_frames,
+					lfo_osc_mode,
+					lfo_freq, lfo_depth,
+					tuning);
+  }
+  break;
+  default:
+  {
+    g_warning("ags_fm_synth_util_oscillate() - unsupported format");
+  }
+  }
+}
+
+/**
+ * ags_fm_synth_util_modulate:
+ * @buffer: the audio buffer
+ * @oscillator_mode: the #AgsSynthOscillatorMode of the carrier
+ * @freq: the frequency of the wave
+ * @phase: the phase of the wave in frames
+ * @volume: the volume of the wave
+ * @samplerate: the samplerate
+ * @audio_buffer_util_format: the audio data format
+ * @offset: start frame
+ * @n_frames: generate n frames
+ * @modulation_source: the #AgsModulationSource
+ *
+ * Add @n_frames of a wave frequency modulated by the computed control points
+ * of @modulation_source to @buffer. It renders like ags_fm_synth_util_oscillate(),
+ * but the LFO isn't evaluated per call, so voices sharing @modulation_source
+ * don't compute the same LFO again.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_fm_synth_util_modulate(void *buffer,
+			   guint oscillator_mode,
+			   gdouble freq, gdouble phase, gdouble volume,
+			   guint samplerate, guint audio_buffer_util_format,
+			   guint offset, guint n_frames,
+			   AgsModulationSource *modulation_source)
+{
+  gdouble y[AGS_SYNTH_UTIL_CHUNK_SIZE];
+
+  gdouble carrier_phase, current_dt;
+  guint copy_mode;
+  guint count;
+  guint i;
+
+  if(buffer == NULL ||
+     samplerate == 0 ||
+     oscillator_mode >= AGS_SYNTH_OSCILLATOR_LAST ||
+     !AGS_IS_MODULATION_SOURCE(modulation_source)){
+    return;
+  }
+
+  ags_synth_util_sin_table_init();
+
+  copy_mode = ags_audio_buffer_util_get_copy_mode(audio_buffer_util_format,
+						  AGS_AUDIO_BUFFER_UTIL_DOUBLE);
+
+  /* carrier cycles per frame at the first frame */
+  current_dt = freq * exp2(ags_modulation_source_get_value(modulation_source,
+							   offset)) / (gdouble) samplerate;
+
+  carrier_phase = ((gdouble) offset + phase) * current_dt;
+  carrier_phase -= floor(carrier_phase);
+
+  for(i = offset; i < offset + n_frames; i += count){
+    count = offset + n_frames - i;
+
+    if(count > AGS_SYNTH_UTIL_CHUNK_SIZE){
+      count = AGS_SYNTH_UTIL_CHUNK_SIZE;
+    }
+
+    memset(y, 0, count * sizeof(gdouble));
+    
+    ags_fm_synth_util_render_modulated_chunk(y,
+					     oscillator_mode,
+					     freq, volume,
+					     samplerate,
+					     i, count,
+					     modulation_source,
+					     &carrier_phase, &current_dt);
+
+    ags_audio_buffer_util_copy_buffer_to_buffer(buffer, 1, i,
+						y, 1, 0,
+						count, copy_mode);
+  }
+}
+
 /**
  * ags_fm_synth_util_sin_s8:
  * @buffer: the audio buffer
@@ -62,46 +1167,14 @@ ags_fm_synth_util_sin_s8(gint8 *buffer,
 			 gdouble lfo_freq, gdouble lfo_depth,
 			 gdouble tuning)
 {
-  static const gdouble scale = 127.0;
-  guint i;
-
-  switch(lfo_osc_mode){
-  case AGS_SYNTH_OSCILLATOR_SIN:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) (sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / (gdouble) samplerate) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) (sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / (gdouble) samplerate) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
-  { 
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) (sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / (gdouble) samplerate) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SQUARE:
-  {   
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) (sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_IMPULSE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) (sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) * scale * volume)));
-    }
-  }
-  break;
-  }
+  ags_fm_synth_util_oscillate_s8(buffer,
+				 AGS_SYNTH_OSCILLATOR_SIN,
+				 freq, phase, volume,
+				 samplerate,
+				 offset, n_frames,
+				 lfo_osc_mode,
+				 lfo_freq, lfo_depth,
+				 tuning);
 }
 
 /**
@@ -131,46 +1204,14 @@ ags_fm_synth_util_sin_s16(gint16 *buffer,
 			  gdouble lfo_freq, gdouble lfo_depth,
 			  gdouble tuning)
 {
-  static const gdouble scale = 32767.0;
-  guint i;
-    
-  switch(lfo_osc_mode){
-  case AGS_SYNTH_OSCILLATOR_SIN:
-  {    
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint32) (0xffff & ((gint32) buffer[i] + (gint32) (sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / (gdouble) samplerate) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint32) (0xffff & ((gint32) buffer[i] + (gint32) (sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / (gdouble) samplerate) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint32) (0xffff & ((gint32) buffer[i] + (gint32) (sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / (gdouble) samplerate) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SQUARE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint32) (0xffff & ((gint32) buffer[i] + (gint32) (sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_IMPULSE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint32) (0xffff & ((gint32) buffer[i] + (gint32) (sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) * scale * volume)));
-    }
-  }
-  break;
-  }
+  ags_fm_synth_util_oscillate_s16(buffer,
+				  AGS_SYNTH_OSCILLATOR_SIN,
+				  freq, phase, volume,
+				  samplerate,
+				  offset, n_frames,
+				  lfo_osc_mode,
+				  lfo_freq, lfo_depth,
+				  tuning);
 }
 
 /**
@@ -200,46 +1241,14 @@ ags_fm_synth_util_sin_s24(gint32 *buffer,
 			  gdouble lfo_freq, gdouble lfo_depth,
 			  gdouble tuning)
 {
-  static const gdouble scale = 8388607.0;
-  guint i;
-
-  switch(lfo_osc_mode){
-  case AGS_SYNTH_OSCILLATOR_SIN:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) (sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / (gdouble) samplerate) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) (sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / (gdouble) samplerate) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) (sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / (gdouble) samplerate) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SQUARE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) (sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_IMPULSE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) (sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) * scale * volume)));
-    }
-  }
-  break;
-  }
+  ags_fm_synth_util_oscillate_s24(buffer,
+				  AGS_SYNTH_OSCILLATOR_SIN,
+				  freq, phase, volume,
+				  samplerate,
+				  offset, n_frames,
+				  lfo_osc_mode,
+				  lfo_freq, lfo_depth,
+				  tuning);
 }
 
 /**
@@ -251,64 +1260,32 @@ ags_fm_synth_util_sin_s24(gint32 *buffer,
  * @samplerate: the samplerate
  * @offset: start frame
  * @n_frames: generate n frames
- * @lfo_osc_mode: the LFO's oscillator mode
- * @lfo_freq: the LFO's frequency
- * @lfo_depth: the LFO's depth
- * @tuning: the tuninig
- * 
- * Generate frequency modulate sin wave.
- * 
- * Since: 3.0.0
- */
-void
-ags_fm_synth_util_sin_s32(gint32 *buffer,
-			  gdouble freq, gdouble phase, gdouble volume,
-			  guint samplerate,
-			  guint offset, guint n_frames,
-			  guint lfo_osc_mode,
-			  gdouble lfo_freq, gdouble lfo_depth,
-			  gdouble tuning)
-{
-  static const gdouble scale = 214748363.0;
-  guint i;
-
-  switch(lfo_osc_mode){
-  case AGS_SYNTH_OSCILLATOR_SIN:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) (sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / (gdouble) samplerate) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) (sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / (gdouble) samplerate) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) (sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / (gdouble) samplerate) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SQUARE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) (sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_IMPULSE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) (sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) * scale * volume)));
-    }
-  }
-  break;
-  }
+ * @lfo_osc_mode: the LFO's oscillator mode
+ * @lfo_freq: the LFO's frequency
+ * @lfo_depth: the LFO's depth
+ * @tuning: the tuninig
+ * 
+ * Generate frequency modulate sin wave.
+ * 
+ * Since: 3.0.0
+ */
+void
+ags_fm_synth_util_sin_s32(gint32 *buffer,
+			  gdouble freq, gdouble phase, gdouble volume,
+			  guint samplerate,
+			  guint offset, guint n_frames,
+			  guint lfo_osc_mode,
+			  gdouble lfo_freq, gdouble lfo_depth,
+			  gdouble tuning)
+{
+  ags_fm_synth_util_oscillate_s32(buffer,
+				  AGS_SYNTH_OSCILLATOR_SIN,
+				  freq, phase, volume,
+				  samplerate,
+				  offset, n_frames,
+				  lfo_osc_mode,
+				  lfo_freq, lfo_depth,
+				  tuning);
 }
 
 /**
@@ -338,46 +1315,14 @@ ags_fm_synth_util_sin_s64(gint64 *buffer,
 			  gdouble lfo_freq, gdouble lfo_depth,
 			  gdouble tuning)
 {
-  static const gdouble scale = 9223372036854775807.0;
-  guint i;
-
-  switch(lfo_osc_mode){
-  case AGS_SYNTH_OSCILLATOR_SIN:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint64) (0xffffffffffffffff & ((gint64) buffer[i] + (gint64) (sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / (gdouble) samplerate) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint64) (0xffffffffffffffff & ((gint64) buffer[i] + (gint64) (sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / (gdouble) samplerate) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint64) (0xffffffffffffffff & ((gint64) buffer[i] + (gint64) (sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / (gdouble) samplerate) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SQUARE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint64) (0xffffffffffffffff & ((gint64) buffer[i] + (gint64) (sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_IMPULSE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint64) (0xffffffffffffffff & ((gint64) buffer[i] + (gint64) (sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) * scale * volume)));
-    }
-  }
-  break;
-  }
+  ags_fm_synth_util_oscillate_s64(buffer,
+				  AGS_SYNTH_OSCILLATOR_SIN,
+				  freq, phase, volume,
+				  samplerate,
+				  offset, n_frames,
+				  lfo_osc_mode,
+				  lfo_freq, lfo_depth,
+				  tuning);
 }
 
 /**
@@ -407,45 +1352,14 @@ ags_fm_synth_util_sin_float(float *buffer,
 			    gdouble lfo_freq, gdouble lfo_depth,
 			    gdouble tuning)
 {
-  guint i;
-
-  switch(lfo_osc_mode){
-  case AGS_SYNTH_OSCILLATOR_SIN:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (float) ((gdouble) buffer[i] + (gdouble) (sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / (gdouble) samplerate) * volume));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (float) ((gdouble) buffer[i] + (gdouble) (sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / (gdouble) samplerate) * volume));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (float) ((gdouble) buffer[i] + (gdouble) (sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / (gdouble) samplerate) * volume));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SQUARE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (float) ((gdouble) buffer[i] + (gdouble) (sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) * volume));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_IMPULSE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (float) ((gdouble) buffer[i] + (gdouble) (sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) * volume));
-    }
-  }
-  break;
-  }
+  ags_fm_synth_util_oscillate_float(buffer,
+				    AGS_SYNTH_OSCILLATOR_SIN,
+				    freq, phase, volume,
+				    samplerate,
+				    offset, n_frames,
+				    lfo_osc_mode,
+				    lfo_freq, lfo_depth,
+				    tuning);
 }
 
 /**
@@ -475,45 +1389,14 @@ ags_fm_synth_util_sin_double(double *buffer,
 			     gdouble lfo_freq, gdouble lfo_depth,
 			     gdouble tuning)
 {
-  guint i;
-
-  switch(lfo_osc_mode){
-  case AGS_SYNTH_OSCILLATOR_SIN:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (double) ((gdouble) buffer[i] + (gdouble) (sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / (gdouble) samplerate) * volume));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (double) ((gdouble) buffer[i] + (gdouble) (sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / (gdouble) samplerate) * volume));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (double) ((gdouble) buffer[i] + (gdouble) (sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / (gdouble) samplerate) * volume));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SQUARE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (double) ((gdouble) buffer[i] + (gdouble) (sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) * volume));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_IMPULSE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (double) ((gdouble) buffer[i] + (gdouble) (sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) * volume));
-    }
-  }
-  break;
-  }
+  ags_fm_synth_util_oscillate_double(buffer,
+				     AGS_SYNTH_OSCILLATOR_SIN,
+				     freq, phase, volume,
+				     samplerate,
+				     offset, n_frames,
+				     lfo_osc_mode,
+				     lfo_freq, lfo_depth,
+				     tuning);
 }
 
 /**
@@ -543,66 +1426,14 @@ ags_fm_synth_util_sin_complex(AgsComplex *buffer,
 			      gdouble lfo_freq, gdouble lfo_depth,
 			      gdouble tuning)
 {
-  AgsComplex *c_ptr;
-  AgsComplex **c_ptr_ptr;
-
-  double y;
-
-  guint i_stop;
-  guint i;
-
-  c_ptr = buffer;
-  c_ptr_ptr = &c_ptr;
-  
-  i_stop = offset + n_frames;
-
-  switch(lfo_osc_mode){
-  case AGS_SYNTH_OSCILLATOR_SIN:
-  {
-    for(i = offset; i < i_stop; i++, c_ptr++){
-      y  = (gdouble) (sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / (gdouble) samplerate) * volume);
-
-      AGS_AUDIO_BUFFER_UTIL_DOUBLE_TO_COMPLEX(y, c_ptr_ptr);
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
-  {
-    for(i = offset; i < i_stop; i++, c_ptr++){
-      y = (gdouble) (sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / (gdouble) samplerate) * volume);
-
-      AGS_AUDIO_BUFFER_UTIL_DOUBLE_TO_COMPLEX(y, c_ptr_ptr);
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
-  {
-    for(i = offset; i < i_stop; i++, c_ptr++){
-      y = (gdouble) (sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / (gdouble) samplerate) * volume);
-
-      AGS_AUDIO_BUFFER_UTIL_DOUBLE_TO_COMPLEX(y, c_ptr_ptr);
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SQUARE:
-  {
-    for(i = offset; i < i_stop; i++, c_ptr++){
-      y = (gdouble) (sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) * volume);
-
-      AGS_AUDIO_BUFFER_UTIL_DOUBLE_TO_COMPLEX(y, c_ptr_ptr);
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_IMPULSE:
-  {
-    for(i = offset; i < i_stop; i++, c_ptr++){
-      y = (gdouble) (sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) * volume);
-
-      AGS_AUDIO_BUFFER_UTIL_DOUBLE_TO_COMPLEX(y, c_ptr_ptr);
-    }
-  }
-  break;
-  }
+  ags_fm_synth_util_oscillate_complex(buffer,
+				      AGS_SYNTH_OSCILLATOR_SIN,
+				      freq, phase, volume,
+				      samplerate,
+				      offset, n_frames,
+				      lfo_osc_mode,
+				      lfo_freq, lfo_depth,
+				      tuning);
 }
 
 /**
@@ -632,49 +1463,14 @@ ags_fm_synth_util_sawtooth_s8(gint8 *buffer,
 			      gdouble lfo_freq, gdouble lfo_depth,
 			      gdouble tuning)
 {
-  static const gdouble scale = 127.0;
-  guint i;
-
-  phase = (int) ceil(phase) % (int) ceil(freq);
-  phase = ceil(phase / freq) * ceil(samplerate / freq);
-
-  switch(lfo_osc_mode){
-  case AGS_SYNTH_OSCILLATOR_SIN:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / samplerate) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / samplerate) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / samplerate) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SQUARE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / samplerate) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_IMPULSE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / samplerate) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  }
+  ags_fm_synth_util_oscillate_s8(buffer,
+				 AGS_SYNTH_OSCILLATOR_SAWTOOTH,
+				 freq, phase, volume,
+				 samplerate,
+				 offset, n_frames,
+				 lfo_osc_mode,
+				 lfo_freq, lfo_depth,
+				 tuning);
 }
 
 /**
@@ -694,59 +1490,24 @@ ags_fm_synth_util_sawtooth_s8(gint8 *buffer,
  * Generate frequency modulate sawtooth wave.
  * 
  * Since: 3.0.0
- */
-void
-ags_fm_synth_util_sawtooth_s16(gint16 *buffer,
-			       gdouble freq, gdouble phase, gdouble volume,
-			       guint samplerate,
-			       guint offset, guint n_frames,
-			       guint lfo_osc_mode,
-			       gdouble lfo_freq, gdouble lfo_depth,
-			       gdouble tuning)
-{
-  static const gdouble scale = 32767.0;
-  guint i;
-
-  phase = (int) ceil(phase) % (int) ceil(freq);
-  phase = ceil(phase / freq) * ceil(samplerate / freq);
-
-  switch(lfo_osc_mode){
-  case AGS_SYNTH_OSCILLATOR_SIN:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint16) (0xffff & ((gint32) buffer[i] + (gint32) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / samplerate) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint16) (0xffff & ((gint32) buffer[i] + (gint32) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / samplerate) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint16) (0xffff & ((gint32) buffer[i] + (gint32) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / samplerate) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SQUARE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint16) (0xffff & ((gint32) buffer[i] + (gint32) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / samplerate) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_IMPULSE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint16) (0xffff & ((gint32) buffer[i] + (gint32) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / samplerate) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  }
+ */
+void
+ags_fm_synth_util_sawtooth_s16(gint16 *buffer,
+			       gdouble freq, gdouble phase, gdouble volume,
+			       guint samplerate,
+			       guint offset, guint n_frames,
+			       guint lfo_osc_mode,
+			       gdouble lfo_freq, gdouble lfo_depth,
+			       gdouble tuning)
+{
+  ags_fm_synth_util_oscillate_s16(buffer,
+				  AGS_SYNTH_OSCILLATOR_SAWTOOTH,
+				  freq, phase, volume,
+				  samplerate,
+				  offset, n_frames,
+				  lfo_osc_mode,
+				  lfo_freq, lfo_depth,
+				  tuning);
 }
 
 /**
@@ -776,49 +1537,14 @@ ags_fm_synth_util_sawtooth_s24(gint32 *buffer,
 			       gdouble lfo_freq, gdouble lfo_depth,
 			       gdouble tuning)
 {
-  static const gdouble scale = 8388607.0;
-  guint i;
-
-  phase = (int) ceil(phase) % (int) ceil(freq);
-  phase = ceil(phase / freq) * ceil(samplerate / freq);
-
-  switch(lfo_osc_mode){
-  case AGS_SYNTH_OSCILLATOR_SIN:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / samplerate) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / samplerate) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / samplerate) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SQUARE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / samplerate) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_IMPULSE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / samplerate) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  }
+  ags_fm_synth_util_oscillate_s24(buffer,
+				  AGS_SYNTH_OSCILLATOR_SAWTOOTH,
+				  freq, phase, volume,
+				  samplerate,
+				  offset, n_frames,
+				  lfo_osc_mode,
+				  lfo_freq, lfo_depth,
+				  tuning);
 }
 
 /**
@@ -848,49 +1574,14 @@ ags_fm_synth_util_sawtooth_s32(gint32 *buffer,
 			       gdouble lfo_freq, gdouble lfo_depth,
 			       gdouble tuning)
 {
-  static const gdouble scale = 214748363.0;
-  guint i;
-
-  phase = (int) ceil(phase) % (int) ceil(freq);
-  phase = ceil(phase / freq) * ceil(samplerate / freq);
-
-  switch(lfo_osc_mode){
-  case AGS_SYNTH_OSCILLATOR_SIN:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / samplerate) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / samplerate) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / samplerate) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SQUARE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / samplerate) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_IMPULSE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / samplerate) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  }
+  ags_fm_synth_util_oscillate_s32(buffer,
+				  AGS_SYNTH_OSCILLATOR_SAWTOOTH,
+				  freq, phase, volume,
+				  samplerate,
+				  offset, n_frames,
+				  lfo_osc_mode,
+				  lfo_freq, lfo_depth,
+				  tuning);
 }
 
 /**
@@ -920,49 +1611,14 @@ ags_fm_synth_util_sawtooth_s64(gint64 *buffer,
 			       gdouble lfo_freq, gdouble lfo_depth,
 			       gdouble tuning)
 {
-  static const gdouble scale = 9223372036854775807.0;
-  guint i;
-
-  phase = (int) ceil(phase) % (int) ceil(freq);
-  phase = ceil(phase / freq) * ceil(samplerate / freq);
-
-  switch(lfo_osc_mode){
-  case AGS_SYNTH_OSCILLATOR_SIN:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint64) (0xffffffffffffffff & ((gint64) buffer[i] + (gint64) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / samplerate) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint64) (0xffffffffffffffff & ((gint64) buffer[i] + (gint64) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / samplerate) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint64) (0xffffffffffffffff & ((gint64) buffer[i] + (gint64) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / samplerate) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SQUARE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint64) (0xffffffffffffffff & ((gint64) buffer[i] + (gint64) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / samplerate) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_IMPULSE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint64) (0xffffffffffffffff & ((gint64) buffer[i] + (gint64) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / samplerate) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  }
+  ags_fm_synth_util_oscillate_s64(buffer,
+				  AGS_SYNTH_OSCILLATOR_SAWTOOTH,
+				  freq, phase, volume,
+				  samplerate,
+				  offset, n_frames,
+				  lfo_osc_mode,
+				  lfo_freq, lfo_depth,
+				  tuning);
 }
 
 /**
@@ -992,48 +1648,14 @@ ags_fm_synth_util_sawtooth_float(float *buffer,
 				 gdouble lfo_freq, gdouble lfo_depth,
 				 gdouble tuning)
 {
-  guint i;
-
-  phase = (int) ceil(phase) % (int) ceil(freq);
-  phase = ceil(phase / freq) * ceil(samplerate / freq);
-
-  switch(lfo_osc_mode){
-  case AGS_SYNTH_OSCILLATOR_SIN:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = ((double) buffer[i] + (double) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / samplerate) - 1.0) * volume));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = ((double) buffer[i] + (double) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / samplerate) - 1.0) * volume));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = ((double) buffer[i] + (double) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / samplerate) - 1.0) * volume));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SQUARE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = ((double) buffer[i] + (double) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / samplerate) - 1.0) * volume));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_IMPULSE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = ((double) buffer[i] + (double) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / samplerate) - 1.0) * volume));
-    }
-  }
-  break;
-  }
+  ags_fm_synth_util_oscillate_float(buffer,
+				    AGS_SYNTH_OSCILLATOR_SAWTOOTH,
+				    freq, phase, volume,
+				    samplerate,
+				    offset, n_frames,
+				    lfo_osc_mode,
+				    lfo_freq, lfo_depth,
+				    tuning);
 }
 
 /**
@@ -1063,48 +1685,14 @@ ags_fm_synth_util_sawtooth_double(double *buffer,
 				  gdouble lfo_freq, gdouble lfo_depth,
 				  gdouble tuning)
 {
-  guint i;
-
-  phase = (int) ceil(phase) % (int) ceil(freq);
-  phase = ceil(phase / freq) * ceil(samplerate / freq);
-
-  switch(lfo_osc_mode){
-  case AGS_SYNTH_OSCILLATOR_SIN:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = ((double) buffer[i] + (double) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / samplerate) - 1.0) * volume));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = ((double) buffer[i] + (double) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / samplerate) - 1.0) * volume));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = ((double) buffer[i] + (double) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / samplerate) - 1.0) * volume));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SQUARE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = ((double) buffer[i] + (double) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / samplerate) - 1.0) * volume));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_IMPULSE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = ((double) buffer[i] + (double) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / samplerate) - 1.0) * volume));
-    }
-  }
-  break;
-  }
+  ags_fm_synth_util_oscillate_double(buffer,
+				     AGS_SYNTH_OSCILLATOR_SAWTOOTH,
+				     freq, phase, volume,
+				     samplerate,
+				     offset, n_frames,
+				     lfo_osc_mode,
+				     lfo_freq, lfo_depth,
+				     tuning);
 }
 
 /**
@@ -1120,83 +1708,28 @@ ags_fm_synth_util_sawtooth_double(double *buffer,
  * @lfo_freq: the LFO's frequency
  * @lfo_depth: the LFO's depth
  * @tuning: the tuninig
- * 
- * Generate frequency modulate sawtooth wave.
- * 
- * Since: 3.0.0
- */
-void
-ags_fm_synth_util_sawtooth_complex(AgsComplex *buffer,
-				   gdouble freq, gdouble phase, gdouble volume,
-				   guint samplerate,
-				   guint offset, guint n_frames,
-				   guint lfo_osc_mode,
-				   gdouble lfo_freq, gdouble lfo_depth,
-				   gdouble tuning)
-{
-  AgsComplex *c_ptr;
-  AgsComplex **c_ptr_ptr;
-
-  double y;
-
-  guint i_stop;
-  guint i;
-
-  phase = (int) ceil(phase) % (int) ceil(freq);
-  phase = ceil(phase / freq) * ceil(samplerate / freq);
-
-  c_ptr = buffer;
-  c_ptr_ptr = &c_ptr;
-
-  i_stop = offset + n_frames;
-
-  switch(lfo_osc_mode){
-  case AGS_SYNTH_OSCILLATOR_SIN:
-  {
-    for(i = offset; i < offset + n_frames; i++, c_ptr++){
-      y = (double) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / samplerate) - 1.0) * volume);
-
-      AGS_AUDIO_BUFFER_UTIL_DOUBLE_TO_COMPLEX(y, c_ptr_ptr);
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
-  {
-    for(i = offset; i < offset + n_frames; i++, c_ptr++){
-      y = (double) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / samplerate) - 1.0) * volume);
-
-      AGS_AUDIO_BUFFER_UTIL_DOUBLE_TO_COMPLEX(y, c_ptr_ptr);
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
-  {
-    for(i = offset; i < offset + n_frames; i++, c_ptr++){
-      y = (double) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / samplerate) - 1.0) * volume);
-
-      AGS_AUDIO_BUFFER_UTIL_DOUBLE_TO_COMPLEX(y, c_ptr_ptr);
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SQUARE:
-  {
-    for(i = offset; i < offset + n_frames; i++, c_ptr++){
-      y = (double) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / samplerate) - 1.0) * volume);
-
-      AGS_AUDIO_BUFFER_UTIL_DOUBLE_TO_COMPLEX(y, c_ptr_ptr);
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_IMPULSE:
-  {
-    for(i = offset; i < offset + n_frames; i++, c_ptr++){
-      y = (double) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / samplerate) - 1.0) * volume);
-
-      AGS_AUDIO_BUFFER_UTIL_DOUBLE_TO_COMPLEX(y, c_ptr_ptr);
-    }
-  }
-  break;
-  }
+ * 
+ * Generate frequency modulate sawtooth wave.
+ * 
+ * Since: 3.0.0
+ */
+void
+ags_fm_synth_util_sawtooth_complex(AgsComplex *buffer,
+				   gdouble freq, gdouble phase, gdouble volume,
+				   guint samplerate,
+				   guint offset, guint n_frames,
+				   guint lfo_osc_mode,
+				   gdouble lfo_freq, gdouble lfo_depth,
+				   gdouble tuning)
+{
+  ags_fm_synth_util_oscillate_complex(buffer,
+				      AGS_SYNTH_OSCILLATOR_SAWTOOTH,
+				      freq, phase, volume,
+				      samplerate,
+				      offset, n_frames,
+				      lfo_osc_mode,
+				      lfo_freq, lfo_depth,
+				      tuning);
 }
 
 /**
@@ -1226,49 +1759,14 @@ ags_fm_synth_util_triangle_s8(gint8 *buffer,
 			      gdouble lfo_freq, gdouble lfo_depth,
 			      gdouble tuning)
 {
-  static const gdouble scale = 127.0;
-  guint i;
-
-  phase = (int) ceil(phase) % (int) ceil(freq);
-  phase = ceil(phase / freq) * ceil(samplerate / freq);
-
-  switch(lfo_osc_mode){
-  case AGS_SYNTH_OSCILLATOR_SIN:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) ((((phase + i) * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / samplerate)) / 2.0) * 2) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) ((((phase + i) * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / samplerate)) / 2.0) * 2) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) ((((phase + i) * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / samplerate)) / 2.0) * 2) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SQUARE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) ((((phase + i) * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / samplerate)) / 2.0) * 2) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_IMPULSE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) ((((phase + i) * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / samplerate)) / 2.0) * 2) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  }
+  ags_fm_synth_util_oscillate_s8(buffer,
+				 AGS_SYNTH_OSCILLATOR_TRIANGLE,
+				 freq, phase, volume,
+				 samplerate,
+				 offset, n_frames,
+				 lfo_osc_mode,
+				 lfo_freq, lfo_depth,
+				 tuning);
 }
 
 /**
@@ -1298,49 +1796,14 @@ ags_fm_synth_util_triangle_s16(gint16 *buffer,
 			       gdouble lfo_freq, gdouble lfo_depth,
 			       gdouble tuning)
 {
-  static const gdouble scale = 32767.0;
-  guint i;
-
-  phase = (int) ceil(phase) % (int) ceil(freq);
-  phase = ceil(phase / freq) * ceil(samplerate / freq);
-
-  switch(lfo_osc_mode){
-  case AGS_SYNTH_OSCILLATOR_SIN:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint16) (0xffff & ((gint32) buffer[i] + (gint32) ((((phase + i) * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / samplerate)) / 2.0) * 2) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint16) (0xffff & ((gint32) buffer[i] + (gint32) ((((phase + i) * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / samplerate)) / 2.0) * 2) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint16) (0xffff & ((gint32) buffer[i] + (gint32) ((((phase + i) * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / samplerate)) / 2.0) * 2) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SQUARE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint16) (0xffff & ((gint32) buffer[i] + (gint32) ((((phase + i) * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / samplerate)) / 2.0) * 2) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_IMPULSE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint16) (0xffff & ((gint32) buffer[i] + (gint32) ((((phase + i) * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / samplerate)) / 2.0) * 2) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  }
+  ags_fm_synth_util_oscillate_s16(buffer,
+				  AGS_SYNTH_OSCILLATOR_TRIANGLE,
+				  freq, phase, volume,
+				  samplerate,
+				  offset, n_frames,
+				  lfo_osc_mode,
+				  lfo_freq, lfo_depth,
+				  tuning);
 }
 
 /**
@@ -1370,50 +1833,14 @@ ags_fm_synth_util_triangle_s24(gint32 *buffer,
 			       gdouble lfo_freq, gdouble lfo_depth,
 			       gdouble tuning)
 {
-  static const gdouble scale = 8388607.0;
-  gdouble current_freq;
-  guint i;
-
-  phase = (int) ceil(phase) % (int) ceil(freq);
-  phase = ceil(phase / freq) * ceil(samplerate / freq);
-
-  switch(lfo_osc_mode){
-  case AGS_SYNTH_OSCILLATOR_SIN:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) ((((phase + i) * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / samplerate)) / 2.0) * 2) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) ((((phase + i) * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / samplerate)) / 2.0) * 2) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) ((((phase + i) * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / samplerate)) / 2.0) * 2) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SQUARE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) ((((phase + i) * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / samplerate)) / 2.0) * 2) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_IMPULSE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) ((((phase + i) * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / samplerate)) / 2.0) * 2) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  }
+  ags_fm_synth_util_oscillate_s24(buffer,
+				  AGS_SYNTH_OSCILLATOR_TRIANGLE,
+				  freq, phase, volume,
+				  samplerate,
+				  offset, n_frames,
+				  lfo_osc_mode,
+				  lfo_freq, lfo_depth,
+				  tuning);
 }
 
 /**
@@ -1443,49 +1870,14 @@ ags_fm_synth_util_triangle_s32(gint32 *buffer,
 			       gdouble lfo_freq, gdouble lfo_depth,
 			       gdouble tuning)
 {
-  static const gdouble scale = 214748363.0;
-  guint i;
-  
-  phase = (int) ceil(phase) % (int) ceil(freq);
-  phase = ceil(phase / freq) * ceil(samplerate / freq);
-
-  switch(lfo_osc_mode){
-  case AGS_SYNTH_OSCILLATOR_SIN:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) ((((phase + i) * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / samplerate)) / 2.0) * 2) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) ((((phase + i) * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / samplerate)) / 2.0) * 2) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) ((((phase + i) * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / samplerate)) / 2.0) * 2) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SQUARE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) ((((phase + i) * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / samplerate)) / 2.0) * 2) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_IMPULSE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) ((((phase + i) * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / samplerate)) / 2.0) * 2) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  }
+  ags_fm_synth_util_oscillate_s32(buffer,
+				  AGS_SYNTH_OSCILLATOR_TRIANGLE,
+				  freq, phase, volume,
+				  samplerate,
+				  offset, n_frames,
+				  lfo_osc_mode,
+				  lfo_freq, lfo_depth,
+				  tuning);
 }
 
 /**
@@ -1515,49 +1907,14 @@ ags_fm_synth_util_triangle_s64(gint64 *buffer,
 			       gdouble lfo_freq, gdouble lfo_depth,
 			       gdouble tuning)
 {
-  static const gdouble scale = 9223372036854775807.0;
-  guint i;
-
-  phase = (int) ceil(phase) % (int) ceil(freq);
-  phase = ceil(phase / freq) * ceil(samplerate / freq);
-
-  switch(lfo_osc_mode){
-  case AGS_SYNTH_OSCILLATOR_SIN:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint64) (0xffffffffffffffff & ((gint64) buffer[i] + (gint64) ((((phase + i) * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / samplerate)) / 2.0) * 2) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint64) (0xffffffffffffffff & ((gint64) buffer[i] + (gint64) ((((phase + i) * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / samplerate)) / 2.0) * 2) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint64) (0xffffffffffffffff & ((gint64) buffer[i] + (gint64) ((((phase + i) * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / samplerate)) / 2.0) * 2) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SQUARE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint64) (0xffffffffffffffff & ((gint64) buffer[i] + (gint64) ((((phase + i) * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / samplerate)) / 2.0) * 2) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_IMPULSE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = (gint64) (0xffffffffffffffff & ((gint64) buffer[i] + (gint64) ((((phase + i) * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / samplerate)) / 2.0) * 2) - 1.0) * scale * volume)));
-    }
-  }
-  break;
-  }
+  ags_fm_synth_util_oscillate_s64(buffer,
+				  AGS_SYNTH_OSCILLATOR_TRIANGLE,
+				  freq, phase, volume,
+				  samplerate,
+				  offset, n_frames,
+				  lfo_osc_mode,
+				  lfo_freq, lfo_depth,
+				  tuning);
 }
 
 /**
@@ -1566,69 +1923,35 @@ ags_fm_synth_util_triangle_s64(gint64 *buffer,
  * @freq: the frequency of the sin wave
  * @phase: the phase of the sin wave
  * @volume: the volume of the sin wave
- * @samplerate: the samplerate
- * @offset: start frame
- * @n_frames: generate n frames
- * @lfo_osc_mode: the LFO's oscillator mode
- * @lfo_freq: the LFO's frequency
- * @lfo_depth: the LFO's depth
- * @tuning: the tuninig
- * 
- * Generate frequency modulate triangle wave.
- * 
- * Since: 3.0.0
- */
-void
-ags_fm_synth_util_triangle_float(float *buffer,
-				 gdouble freq, gdouble phase, gdouble volume,
-				 guint samplerate,
-				 guint offset, guint n_frames,
-				 guint lfo_osc_mode,
-				 gdouble lfo_freq, gdouble lfo_depth,
-				 gdouble tuning)
-{
-  guint i;
-
-  phase = (int) ceil(phase) % (int) ceil(freq);
-  phase = ceil(phase / freq) * ceil(samplerate / freq);
-
-  switch(lfo_osc_mode){
-  case AGS_SYNTH_OSCILLATOR_SIN:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = ((double) buffer[i] + (double) ((((phase + i) * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / samplerate)) / 2.0) * 2) - 1.0) * volume));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = ((double) buffer[i] + (double) ((((phase + i) * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / samplerate)) / 2.0) * 2) - 1.0) * volume));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = ((double) buffer[i] + (double) ((((phase + i) * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / samplerate)) / 2.0) * 2) - 1.0) * volume));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SQUARE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = ((double) buffer[i] + (double) ((((phase + i) * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / samplerate)) / 2.0) * 2) - 1.0) * volume));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_IMPULSE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = ((double) buffer[i] + (double) ((((phase + i) * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / samplerate)) / 2.0) * 2) - 1.0) * volume));
-    }
-  }
-  break;
-  }
+ * @samplerate: the samplerate
+ * @offset: start frame
+ * @n_frames: generate n frames
+ * @lfo_osc_mode: the LFO's oscillator mode
+ * @lfo_freq: the LFO's frequency
+ * @lfo_depth: the LFO's depth
+ * @tuning: the tuninig
+ * 
+ * Generate frequency modulate triangle wave.
+ * 
+ * Since: 3.0.0
+ */
+void
+ags_fm_synth_util_triangle_float(float *buffer,
+				 gdouble freq, gdouble phase, gdouble volume,
+				 guint samplerate,
+				 guint offset, guint n_frames,
+				 guint lfo_osc_mode,
+				 gdouble lfo_freq, gdouble lfo_depth,
+				 gdouble tuning)
+{
+  ags_fm_synth_util_oscillate_float(buffer,
+				    AGS_SYNTH_OSCILLATOR_TRIANGLE,
+				    freq, phase, volume,
+				    samplerate,
+				    offset, n_frames,
+				    lfo_osc_mode,
+				    lfo_freq, lfo_depth,
+				    tuning);
 }
 
 /**
@@ -1658,48 +1981,14 @@ ags_fm_synth_util_triangle_double(double *buffer,
 				  gdouble lfo_freq, gdouble lfo_depth,
 				  gdouble tuning)
 {
-  guint i;
-
-  phase = (int) ceil(phase) % (int) ceil(freq);
-  phase = ceil(phase / freq) * ceil(samplerate / freq);
-
-  switch(lfo_osc_mode){
-  case AGS_SYNTH_OSCILLATOR_SIN:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = ((double) buffer[i] + (double) ((((phase + i) * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / samplerate)) / 2.0) * 2) - 1.0) * volume));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = ((double) buffer[i] + (double) ((((phase + i) * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / samplerate)) / 2.0) * 2) - 1.0) * volume));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = ((double) buffer[i] + (double) ((((phase + i) * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / samplerate)) / 2.0) * 2) - 1.0) * volume));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SQUARE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = ((double) buffer[i] + (double) ((((phase + i) * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / samplerate)) / 2.0) * 2) - 1.0) * volume));
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_IMPULSE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      buffer[i] = ((double) buffer[i] + (double) ((((phase + i) * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / samplerate)) / 2.0) * 2) - 1.0) * volume));
-    }
-  }
-  break;
-  }
+  ags_fm_synth_util_oscillate_double(buffer,
+				     AGS_SYNTH_OSCILLATOR_TRIANGLE,
+				     freq, phase, volume,
+				     samplerate,
+				     offset, n_frames,
+				     lfo_osc_mode,
+				     lfo_freq, lfo_depth,
+				     tuning);
 }
 
 /**
@@ -1729,69 +2018,14 @@ ags_fm_synth_util_triangle_complex(AgsComplex *buffer,
 				   gdouble lfo_freq, gdouble lfo_depth,
 				   gdouble tuning)
 {
-  AgsComplex *c_ptr;
-  AgsComplex **c_ptr_ptr;
-
-  double y;
-
-  guint i_stop;
-  guint i;
-
-  phase = (int) ceil(phase) % (int) ceil(freq);
-  phase = ceil(phase / freq) * ceil(samplerate / freq);
-
-  c_ptr = buffer;
-  c_ptr_ptr = &c_ptr;
-
-  i_stop = offset + n_frames;
-
-  switch(lfo_osc_mode){
-  case AGS_SYNTH_OSCILLATOR_SIN:
-  {
-    for(i = offset; i < offset + n_frames; i++, c_ptr++){
-      y = (double) ((((phase + i) * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / samplerate)) / 2.0) * 2) - 1.0) * volume);
-
-      AGS_AUDIO_BUFFER_UTIL_DOUBLE_TO_COMPLEX(y, c_ptr_ptr);
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
-  {
-    for(i = offset; i < offset + n_frames; i++, c_ptr++){
-      y = (double) ((((phase + i) * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / samplerate)) / 2.0) * 2) - 1.0) * volume);
-
-      AGS_AUDIO_BUFFER_UTIL_DOUBLE_TO_COMPLEX(y, c_ptr_ptr);
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
-  {
-    for(i = offset; i < offset + n_frames; i++, c_ptr++){
-      y = (double) ((((phase + i) * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / samplerate)) / 2.0) * 2) - 1.0) * volume);
-
-      AGS_AUDIO_BUFFER_UTIL_DOUBLE_TO_COMPLEX(y, c_ptr_ptr);
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SQUARE:
-  {
-    for(i = offset; i < offset + n_frames; i++, c_ptr++){
-      y = (double) ((((phase + i) * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / samplerate)) / 2.0) * 2) - 1.0) * volume);
-
-      AGS_AUDIO_BUFFER_UTIL_DOUBLE_TO_COMPLEX(y, c_ptr_ptr);
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_IMPULSE:
-  {
-    for(i = offset; i < offset + n_frames; i++, c_ptr++){
-      y = (double) ((((phase + i) * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / samplerate)) / 2.0) * 2) - 1.0) * volume);
-
-      AGS_AUDIO_BUFFER_UTIL_DOUBLE_TO_COMPLEX(y, c_ptr_ptr);
-    }
-  }
-  break;
-  }
+  ags_fm_synth_util_oscillate_complex(buffer,
+				      AGS_SYNTH_OSCILLATOR_TRIANGLE,
+				      freq, phase, volume,
+				      samplerate,
+				      offset, n_frames,
+				      lfo_osc_mode,
+				      lfo_freq, lfo_depth,
+				      tuning);
 }
 
 /**
@@ -1821,66 +2055,14 @@ ags_fm_synth_util_square_s8(gint8 *buffer,
 			    gdouble lfo_freq, gdouble lfo_depth,
 			    gdouble tuning)
 {
-  static const gdouble scale = 127.0;
-  guint i;
-
-  switch(lfo_osc_mode){
-  case AGS_SYNTH_OSCILLATOR_SIN:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / (gdouble) samplerate) >= 0.0){
-	buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / (gdouble) samplerate) >= 0.0){
-	buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / (gdouble) samplerate) >= 0.0){
-	buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SQUARE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) >= 0.0){
-	buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_IMPULSE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) >= 0.0){
-	buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  }
+  ags_fm_synth_util_oscillate_s8(buffer,
+				 AGS_SYNTH_OSCILLATOR_SQUARE,
+				 freq, phase, volume,
+				 samplerate,
+				 offset, n_frames,
+				 lfo_osc_mode,
+				 lfo_freq, lfo_depth,
+				 tuning);
 }
 
 /**
@@ -1910,66 +2092,14 @@ ags_fm_synth_util_square_s16(gint16 *buffer,
 			     gdouble lfo_freq, gdouble lfo_depth,
 			     gdouble tuning)
 {
-  static const gdouble scale = 32767.0;
-  guint i;
-
-  switch(lfo_osc_mode){
-  case AGS_SYNTH_OSCILLATOR_SIN:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / (gdouble) samplerate) >= 0.0){
-	buffer[i] = (gint16) (0xffff & ((gint32) buffer[i] + (gint32) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint16) (0xffff & ((gint32) buffer[i] + (gint32) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / (gdouble) samplerate) >= 0.0){
-	buffer[i] = (gint16) (0xffff & ((gint32) buffer[i] + (gint32) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint16) (0xffff & ((gint32) buffer[i] + (gint32) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / (gdouble) samplerate) >= 0.0){
-	buffer[i] = (gint16) (0xffff & ((gint32) buffer[i] + (gint32) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint16) (0xffff & ((gint32) buffer[i] + (gint32) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SQUARE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) >= 0.0){
-	buffer[i] = (gint16) (0xffff & ((gint32) buffer[i] + (gint32) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint16) (0xffff & ((gint32) buffer[i] + (gint32) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_IMPULSE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) >= 0.0){
-	buffer[i] = (gint16) (0xffff & ((gint32) buffer[i] + (gint32) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint16) (0xffff & ((gint32) buffer[i] + (gint32) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  }
+  ags_fm_synth_util_oscillate_s16(buffer,
+				  AGS_SYNTH_OSCILLATOR_SQUARE,
+				  freq, phase, volume,
+				  samplerate,
+				  offset, n_frames,
+				  lfo_osc_mode,
+				  lfo_freq, lfo_depth,
+				  tuning);
 }
 
 /**
@@ -1999,66 +2129,14 @@ ags_fm_synth_util_square_s24(gint32 *buffer,
 			     gdouble lfo_freq, gdouble lfo_depth,
 			     gdouble tuning)
 {
-  static const gdouble scale = 8388607.0;
-  guint i;
-
-  switch(lfo_osc_mode){
-  case AGS_SYNTH_OSCILLATOR_SIN:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / (gdouble) samplerate) >= 0.0){
-	buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / (gdouble) samplerate) >= 0.0){
-	buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / (gdouble) samplerate) >= 0.0){
-	buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SQUARE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) >= 0.0){
-	buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_IMPULSE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) >= 0.0){
-	buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  }
+  ags_fm_synth_util_oscillate_s24(buffer,
+				  AGS_SYNTH_OSCILLATOR_SQUARE,
+				  freq, phase, volume,
+				  samplerate,
+				  offset, n_frames,
+				  lfo_osc_mode,
+				  lfo_freq, lfo_depth,
+				  tuning);
 }
 
 /**
@@ -2082,72 +2160,20 @@ ags_fm_synth_util_square_s24(gint32 *buffer,
 void
 ags_fm_synth_util_square_s32(gint32 *buffer,
 			     gdouble freq, gdouble phase, gdouble volume,
-			     guint samplerate,
-			     guint offset, guint n_frames,
-			     guint lfo_osc_mode,
-			     gdouble lfo_freq, gdouble lfo_depth,
-			     gdouble tuning)
-{
-  static const gdouble scale = 214748363.0;
-  guint i;
-
-  switch(lfo_osc_mode){
-  case AGS_SYNTH_OSCILLATOR_SIN:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / (gdouble) samplerate) >= 0.0){
-	buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / (gdouble) samplerate) >= 0.0){
-	buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / (gdouble) samplerate) >= 0.0){
-	buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SQUARE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) >= 0.0){
-	buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_IMPULSE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) >= 0.0){
-	buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  }
+			     guint samplerate,
+			     guint offset, guint n_frames,
+			     guint lfo_osc_mode,
+			     gdouble lfo_freq, gdouble lfo_depth,
+			     gdouble tuning)
+{
+  ags_fm_synth_util_oscillate_s32(buffer,
+				  AGS_SYNTH_OSCILLATOR_SQUARE,
+				  freq, phase, volume,
+				  samplerate,
+				  offset, n_frames,
+				  lfo_osc_mode,
+				  lfo_freq, lfo_depth,
+				  tuning);
 }
 
 /**
@@ -2177,66 +2203,14 @@ ags_fm_synth_util_square_s64(gint64 *buffer,
 			     gdouble lfo_freq, gdouble lfo_depth,
 			     gdouble tuning)
 {
-  static const gdouble scale = 9223372036854775807.0;
-  guint i;
-
-  switch(lfo_osc_mode){
-  case AGS_SYNTH_OSCILLATOR_SIN:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / (gdouble) samplerate) >= 0.0){
-	buffer[i] = (gint64) (0xffffffffffffffff & ((gint64) buffer[i] + (gint64) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint64) (0xffffffffffffffff & ((gint64) buffer[i] + (gint64) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / (gdouble) samplerate) >= 0.0){
-	buffer[i] = (gint64) (0xffffffffffffffff & ((gint64) buffer[i] + (gint64) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint64) (0xffffffffffffffff & ((gint64) buffer[i] + (gint64) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / (gdouble) samplerate) >= 0.0){
-	buffer[i] = (gint64) (0xffffffffffffffff & ((gint64) buffer[i] + (gint64) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint64) (0xffffffffffffffff & ((gint64) buffer[i] + (gint64) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SQUARE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) >= 0.0){
-	buffer[i] = (gint64) (0xffffffffffffffff & ((gint64) buffer[i] + (gint64) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint64) (0xffffffffffffffff & ((gint64) buffer[i] + (gint64) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_IMPULSE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) >= 0.0){
-	buffer[i] = (gint64) (0xffffffffffffffff & ((gint64) buffer[i] + (gint64) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint64) (0xffffffffffffffff & ((gint64) buffer[i] + (gint64) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  }
+  ags_fm_synth_util_oscillate_s64(buffer,
+				  AGS_SYNTH_OSCILLATOR_SQUARE,
+				  freq, phase, volume,
+				  samplerate,
+				  offset, n_frames,
+				  lfo_osc_mode,
+				  lfo_freq, lfo_depth,
+				  tuning);
 }
 
 /**
@@ -2266,65 +2240,14 @@ ags_fm_synth_util_square_float(float *buffer,
 			       gdouble lfo_freq, gdouble lfo_depth,
 			       gdouble tuning)
 {
-  guint i;
-
-  switch(lfo_osc_mode){
-  case AGS_SYNTH_OSCILLATOR_SIN:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / (gdouble) samplerate) >= 0.0){
-	buffer[i] = (buffer[i] + (1.0 * volume));
-      }else{
-	buffer[i] = (buffer[i] + (-1.0 * volume));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / (gdouble) samplerate) >= 0.0){
-	buffer[i] = (buffer[i] + (1.0 * volume));
-      }else{
-	buffer[i] = (buffer[i] + (-1.0 * volume));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / (gdouble) samplerate) >= 0.0){
-	buffer[i] = (buffer[i] + (1.0 * volume));
-      }else{
-	buffer[i] = (buffer[i] + (-1.0 * volume));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SQUARE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) >= 0.0){
-	buffer[i] = (buffer[i] + (1.0 * volume));
-      }else{
-	buffer[i] = (buffer[i] + (-1.0 * volume));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_IMPULSE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) >= 0.0){
-	buffer[i] = (buffer[i] + (1.0 * volume));
-      }else{
-	buffer[i] = (buffer[i] + (-1.0 * volume));
-      }
-    }
-  }
-  break;
-  }
+  ags_fm_synth_util_oscillate_float(buffer,
+				    AGS_SYNTH_OSCILLATOR_SQUARE,
+				    freq, phase, volume,
+				    samplerate,
+				    offset, n_frames,
+				    lfo_osc_mode,
+				    lfo_freq, lfo_depth,
+				    tuning);
 }
 
 /**
@@ -2354,65 +2277,14 @@ ags_fm_synth_util_square_double(double *buffer,
 				gdouble lfo_freq, gdouble lfo_depth,
 				gdouble tuning)
 {
-  guint i;
-
-  switch(lfo_osc_mode){
-  case AGS_SYNTH_OSCILLATOR_SIN:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / (gdouble) samplerate) >= 0.0){
-	buffer[i] = (buffer[i] + (1.0 * volume));
-      }else{
-	buffer[i] = (buffer[i] + (-1.0 * volume));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / (gdouble) samplerate) >= 0.0){
-	buffer[i] = (buffer[i] + (1.0 * volume));
-      }else{
-	buffer[i] = (buffer[i] + (-1.0 * volume));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / (gdouble) samplerate) >= 0.0){
-	buffer[i] = (buffer[i] + (1.0 * volume));
-      }else{
-	buffer[i] = (buffer[i] + (-1.0 * volume));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SQUARE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) >= 0.0){
-	buffer[i] = (buffer[i] + (1.0 * volume));
-      }else{
-	buffer[i] = (buffer[i] + (-1.0 * volume));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_IMPULSE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) >= 0.0){
-	buffer[i] = (buffer[i] + (1.0 * volume));
-      }else{
-	buffer[i] = (buffer[i] + (-1.0 * volume));
-      }
-    }
-  }
-  break;
-  }
+  ags_fm_synth_util_oscillate_double(buffer,
+				     AGS_SYNTH_OSCILLATOR_SQUARE,
+				     freq, phase, volume,
+				     samplerate,
+				     offset, n_frames,
+				     lfo_osc_mode,
+				     lfo_freq, lfo_depth,
+				     tuning);
 }
 
 /**
@@ -2442,87 +2314,14 @@ ags_fm_synth_util_square_complex(AgsComplex *buffer,
 				 gdouble lfo_freq, gdouble lfo_depth,
 				 gdouble tuning)
 {
-  AgsComplex *c_ptr;
-  AgsComplex **c_ptr_ptr;
-
-  double y;
-  complex z0, z1;
-
-  guint i_stop;
-  guint i;
-
-  c_ptr = buffer;
-  c_ptr_ptr = &c_ptr;
-  
-  i_stop = offset + n_frames;
-
-  switch(lfo_osc_mode){
-  case AGS_SYNTH_OSCILLATOR_SIN:
-  {
-    for(i = offset; i < i_stop; i++, c_ptr++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / (gdouble) samplerate) >= 0.0){
-	y = (1.0 * volume);
-      }else{
-	y = (-1.0 * volume);
-      }
-
-      AGS_AUDIO_BUFFER_UTIL_DOUBLE_TO_COMPLEX(y, c_ptr_ptr);
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
-  {
-    for(i = offset; i < i_stop; i++, c_ptr++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / (gdouble) samplerate) >= 0.0){
-	y = (1.0 * volume);
-      }else{
-	y = (-1.0 * volume);
-      }
-
-      AGS_AUDIO_BUFFER_UTIL_DOUBLE_TO_COMPLEX(y, c_ptr_ptr);
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
-  {
-    for(i = offset; i < i_stop; i++, c_ptr++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / (gdouble) samplerate) >= 0.0){
-	y = (1.0 * volume);
-      }else{
-	y = (-1.0 * volume);
-      }
-
-      AGS_AUDIO_BUFFER_UTIL_DOUBLE_TO_COMPLEX(y, c_ptr_ptr);
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SQUARE:
-  {
-    for(i = offset; i < i_stop; i++, c_ptr++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) >= 0.0){
-	y = (1.0 * volume);
-      }else{
-	y = (-1.0 * volume);
-      }
-
-      AGS_AUDIO_BUFFER_UTIL_DOUBLE_TO_COMPLEX(y, c_ptr_ptr);
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_IMPULSE:
-  {
-    for(i = offset; i < i_stop; i++, c_ptr++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) >= 0.0){
-	y = (1.0 * volume);
-      }else{
-	y = (-1.0 * volume);
-      }
-
-      AGS_AUDIO_BUFFER_UTIL_DOUBLE_TO_COMPLEX(y, c_ptr_ptr);
-    }
-  }
-  break;
-  }
+  ags_fm_synth_util_oscillate_complex(buffer,
+				      AGS_SYNTH_OSCILLATOR_SQUARE,
+				      freq, phase, volume,
+				      samplerate,
+				      offset, n_frames,
+				      lfo_osc_mode,
+				      lfo_freq, lfo_depth,
+				      tuning);
 }
 
 /**
@@ -2552,155 +2351,51 @@ ags_fm_synth_util_impulse_s8(gint8 *buffer,
 			     gdouble lfo_freq, gdouble lfo_depth,
 			     gdouble tuning)
 {
-  static const gdouble scale = 127.0;
-  guint i;
-
-  switch(lfo_osc_mode){
-  case AGS_SYNTH_OSCILLATOR_SIN:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-	buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-	buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-	buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SQUARE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-	buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_IMPULSE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-	buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  }
+  ags_fm_synth_util_oscillate_s8(buffer,
+				 AGS_SYNTH_OSCILLATOR_IMPULSE,
+				 freq, phase, volume,
+				 samplerate,
+				 offset, n_frames,
+				 lfo_osc_mode,
+				 lfo_freq, lfo_depth,
+				 tuning);
 }
 
 /**
  * ags_fm_synth_util_impulse_s16:
  * @buffer: the audio buffer
- * @freq: the frequency of the sin wave
- * @phase: the phase of the sin wave
- * @volume: the volume of the sin wave
- * @samplerate: the samplerate
- * @offset: start frame
- * @n_frames: generate n frames
- * @lfo_osc_mode: the LFO's oscillator mode
- * @lfo_freq: the LFO's frequency
- * @lfo_depth: the LFO's depth
- * @tuning: the tuninig
- * 
- * Generate frequency modulate impulse wave.
- * 
- * Since: 3.0.0
- */
-void
-ags_fm_synth_util_impulse_s16(gint16 *buffer,
-			      gdouble freq, gdouble phase, gdouble volume,
-			      guint samplerate,
-			      guint offset, guint n_frames,
-			      guint lfo_osc_mode,
-			      gdouble lfo_freq, gdouble lfo_depth,
-			      gdouble tuning)
-{
-  static const gdouble scale = 32767.0;
-  guint i;
-
-  switch(lfo_osc_mode){
-  case AGS_SYNTH_OSCILLATOR_SIN:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-	buffer[i] = (gint16) (0xffff & ((gint32) buffer[i] + (gint32) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint16) (0xffff & ((gint32) buffer[i] + (gint32) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-	buffer[i] = (gint16) (0xffff & ((gint32) buffer[i] + (gint32) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint16) (0xffff & ((gint32) buffer[i] + (gint32) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-	buffer[i] = (gint16) (0xffff & ((gint32) buffer[i] + (gint32) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint16) (0xffff & ((gint32) buffer[i] + (gint32) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SQUARE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-	buffer[i] = (gint16) (0xffff & ((gint32) buffer[i] + (gint32) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint16) (0xffff & ((gint32) buffer[i] + (gint32) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_IMPULSE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-	buffer[i] = (gint16) (0xffff & ((gint32) buffer[i] + (gint32) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint16) (0xffff & ((gint32) buffer[i] + (gint32) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  }
+ * @freq: the frequency of the sin wave
+ * @phase: the phase of the sin wave
+ * @volume: the volume of the sin wave
+ * @samplerate: the samplerate
+ * @offset: start frame
+ * @n_frames: generate n frames
+ * @lfo_osc_mode: the LFO's oscillator mode
+ * @lfo_freq: the LFO's frequency
+ * @lfo_depth: the LFO's depth
+ * @tuning: the tuninig
+ * 
+ * Generate frequency modulate impulse wave.
+ * 
+ * Since: 3.0.0
+ */
+void
+ags_fm_synth_util_impulse_s16(gint16 *buffer,
+			      gdouble freq, gdouble phase, gdouble volume,
+			      guint samplerate,
+			      guint offset, guint n_frames,
+			      guint lfo_osc_mode,
+			      gdouble lfo_freq, gdouble lfo_depth,
+			      gdouble tuning)
+{
+  ags_fm_synth_util_oscillate_s16(buffer,
+				  AGS_SYNTH_OSCILLATOR_IMPULSE,
+				  freq, phase, volume,
+				  samplerate,
+				  offset, n_frames,
+				  lfo_osc_mode,
+				  lfo_freq, lfo_depth,
+				  tuning);
 }
 
 /**
@@ -2730,66 +2425,14 @@ ags_fm_synth_util_impulse_s24(gint32 *buffer,
 			      gdouble lfo_freq, gdouble lfo_depth,
 			      gdouble tuning)
 {
-  static const gdouble scale = 8388607.0;
-  guint i;
-
-  switch(lfo_osc_mode){
-  case AGS_SYNTH_OSCILLATOR_SIN:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-	buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-	buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-	buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SQUARE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-	buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_IMPULSE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-	buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  }
+  ags_fm_synth_util_oscillate_s24(buffer,
+				  AGS_SYNTH_OSCILLATOR_IMPULSE,
+				  freq, phase, volume,
+				  samplerate,
+				  offset, n_frames,
+				  lfo_osc_mode,
+				  lfo_freq, lfo_depth,
+				  tuning);
 }
 
 /**
@@ -2819,66 +2462,14 @@ ags_fm_synth_util_impulse_s32(gint32 *buffer,
 			      gdouble lfo_freq, gdouble lfo_depth,
 			      gdouble tuning)
 {
-  static const gdouble scale = 214748363.0;
-  guint i;
-
-  switch(lfo_osc_mode){
-  case AGS_SYNTH_OSCILLATOR_SIN:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-	buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-	buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-	buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SQUARE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-	buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_IMPULSE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-	buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  }
+  ags_fm_synth_util_oscillate_s32(buffer,
+				  AGS_SYNTH_OSCILLATOR_IMPULSE,
+				  freq, phase, volume,
+				  samplerate,
+				  offset, n_frames,
+				  lfo_osc_mode,
+				  lfo_freq, lfo_depth,
+				  tuning);
 }
 
 /**
@@ -2908,66 +2499,14 @@ ags_fm_synth_util_impulse_s64(gint64 *buffer,
 			      gdouble lfo_freq, gdouble lfo_depth,
 			      gdouble tuning)
 {
-  static const gdouble scale = 9223372036854775807.0;
-  guint i;
-
-  switch(lfo_osc_mode){
-  case AGS_SYNTH_OSCILLATOR_SIN:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-	buffer[i] = (gint64) (0xffffffffffffffff & ((gint64) buffer[i] + (gint64) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint64) (0xffffffffffffffff & ((gint64) buffer[i] + (gint64) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-	buffer[i] = (gint64) (0xffffffffffffffff & ((gint64) buffer[i] + (gint64) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint64) (0xffffffffffffffff & ((gint64) buffer[i] + (gint64) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-	buffer[i] = (gint64) (0xffffffffffffffff & ((gint64) buffer[i] + (gint64) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint64) (0xffffffffffffffff & ((gint64) buffer[i] + (gint64) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SQUARE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-	buffer[i] = (gint64) (0xffffffffffffffff & ((gint64) buffer[i] + (gint64) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint64) (0xffffffffffffffff & ((gint64) buffer[i] + (gint64) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_IMPULSE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-	buffer[i] = (gint64) (0xffffffffffffffff & ((gint64) buffer[i] + (gint64) (1.0 * scale * volume)));
-      }else{
-	buffer[i] = (gint64) (0xffffffffffffffff & ((gint64) buffer[i] + (gint64) (-1.0 * scale * volume)));
-      }
-    }
-  }
-  break;
-  }
+  ags_fm_synth_util_oscillate_s64(buffer,
+				  AGS_SYNTH_OSCILLATOR_IMPULSE,
+				  freq, phase, volume,
+				  samplerate,
+				  offset, n_frames,
+				  lfo_osc_mode,
+				  lfo_freq, lfo_depth,
+				  tuning);
 }
 
 /**
@@ -2997,65 +2536,14 @@ ags_fm_synth_util_impulse_float(float *buffer,
 				gdouble lfo_freq, gdouble lfo_depth,
 				gdouble tuning)
 {
-  guint i;
-
-  switch(lfo_osc_mode){
-  case AGS_SYNTH_OSCILLATOR_SIN:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-	buffer[i] = (buffer[i] + (1.0 * volume));
-      }else{
-	buffer[i] = (buffer[i] + (-1.0 * volume));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-	buffer[i] = (buffer[i] + (1.0 * volume));
-      }else{
-	buffer[i] = (buffer[i] + (-1.0 * volume));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-	buffer[i] = (buffer[i] + (1.0 * volume));
-      }else{
-	buffer[i] = (buffer[i] + (-1.0 * volume));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SQUARE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-	buffer[i] = (buffer[i] + (1.0 * volume));
-      }else{
-	buffer[i] = (buffer[i] + (-1.0 * volume));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_IMPULSE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-	buffer[i] = (buffer[i] + (1.0 * volume));
-      }else{
-	buffer[i] = (buffer[i] + (-1.0 * volume));
-      }
-    }
-  }
-  break;
-  }
+  ags_fm_synth_util_oscillate_float(buffer,
+				    AGS_SYNTH_OSCILLATOR_IMPULSE,
+				    freq, phase, volume,
+				    samplerate,
+				    offset, n_frames,
+				    lfo_osc_mode,
+				    lfo_freq, lfo_depth,
+				    tuning);
 }
 
 /**
@@ -3085,65 +2573,14 @@ ags_fm_synth_util_impulse_double(double *buffer,
 				 gdouble lfo_freq, gdouble lfo_depth,
 				 gdouble tuning)
 {
-  guint i;
-
-  switch(lfo_osc_mode){
-  case AGS_SYNTH_OSCILLATOR_SIN:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-	buffer[i] = (buffer[i] + (1.0 * volume));
-      }else{
-	buffer[i] = (buffer[i] + (-1.0 * volume));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-	buffer[i] = (buffer[i] + (1.0 * volume));
-      }else{
-	buffer[i] = (buffer[i] + (-1.0 * volume));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-	buffer[i] = (buffer[i] + (1.0 * volume));
-      }else{
-	buffer[i] = (buffer[i] + (-1.0 * volume));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SQUARE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-	buffer[i] = (buffer[i] + (1.0 * volume));
-      }else{
-	buffer[i] = (buffer[i] + (-1.0 * volume));
-      }
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_IMPULSE:
-  {
-    for(i = offset; i < offset + n_frames; i++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-	buffer[i] = (buffer[i] + (1.0 * volume));
-      }else{
-	buffer[i] = (buffer[i] + (-1.0 * volume));
-      }
-    }
-  }
-  break;
-  }
+  ags_fm_synth_util_oscillate_double(buffer,
+				     AGS_SYNTH_OSCILLATOR_IMPULSE,
+				     freq, phase, volume,
+				     samplerate,
+				     offset, n_frames,
+				     lfo_osc_mode,
+				     lfo_freq, lfo_depth,
+				     tuning);
 }
 
 /**
@@ -3173,86 +2610,14 @@ ags_fm_synth_util_impulse_complex(AgsComplex *buffer,
 				  gdouble lfo_freq, gdouble lfo_depth,
 				  gdouble tuning)
 {
-  AgsComplex *c_ptr;
-  AgsComplex **c_ptr_ptr;
-
-  double y;
-
-  guint i_stop;
-  guint i;
-
-  c_ptr = buffer;
-  c_ptr_ptr = &c_ptr;
-  
-  i_stop = offset + n_frames;
-
-  switch(lfo_osc_mode){
-  case AGS_SYNTH_OSCILLATOR_SIN:
-  {
-    for(i = offset; i < offset + n_frames; i++, c_ptr++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + sin(i * 2.0 * M_PI * lfo_freq / samplerate) * lfo_depth)) / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-	y = (1.0 * volume);
-      }else{
-	y = (-1.0 * volume);
-      }
-
-      AGS_AUDIO_BUFFER_UTIL_DOUBLE_TO_COMPLEX(y, c_ptr_ptr);
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
-  {
-    for(i = offset; i < offset + n_frames; i++, c_ptr++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((((int) ceil(i) % (int) ceil(samplerate / lfo_freq)) * 2.0 * lfo_freq / samplerate) - 1.0) * lfo_depth)) / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-	y = (1.0 * volume);
-      }else{
-	y = (-1.0 * volume);
-      }
-
-      AGS_AUDIO_BUFFER_UTIL_DOUBLE_TO_COMPLEX(y, c_ptr_ptr);
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
-  {
-    for(i = offset; i < offset + n_frames; i++, c_ptr++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + (((i) * lfo_freq / samplerate * 2.0) - ((int) ((double) ((int) ((i) * lfo_freq / samplerate)) / 2.0) * 2) - 1.0) * lfo_depth)) / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-	y = (1.0 * volume);
-      }else{
-	y = (-1.0 * volume);
-      }
-
-      AGS_AUDIO_BUFFER_UTIL_DOUBLE_TO_COMPLEX(y, c_ptr_ptr);
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_SQUARE:
-  {
-    for(i = offset; i < offset + n_frames; i++, c_ptr++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= 0.0) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-	y = (1.0 * volume);
-      }else{
-	y = (-1.0 * volume);
-      }
-
-      AGS_AUDIO_BUFFER_UTIL_DOUBLE_TO_COMPLEX(y, c_ptr_ptr);
-    }
-  }
-  break;
-  case AGS_SYNTH_OSCILLATOR_IMPULSE:
-  {
-    for(i = offset; i < offset + n_frames; i++, c_ptr++){
-      if(sin((gdouble) (i + phase) * 2.0 * M_PI * (freq * exp2(tuning / 1200.0 + ((sin((gdouble) (i) * 2.0 * M_PI * lfo_freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)) ? 1.0: -1.0) * lfo_depth)) / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-	y = (1.0 * volume);
-      }else{
-	y = (-1.0 * volume);
-      }
-
-      AGS_AUDIO_BUFFER_UTIL_DOUBLE_TO_COMPLEX(y, c_ptr_ptr);
-    }
-  }
-  break;
-  }
+  ags_fm_synth_util_oscillate_complex(buffer,
+				      AGS_SYNTH_OSCILLATOR_IMPULSE,
+				      freq, phase, volume,
+				      samplerate,
+				      offset, n_frames,
+				      lfo_osc_mode,
+				      lfo_freq, lfo_depth,
+				      tuning);
 }
 
 /**
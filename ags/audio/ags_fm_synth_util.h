@@ -25,8 +25,94 @@
 
 #include <ags/libags.h>
 
+#include <ags/audio/ags_modulation_source.h>
+
 G_BEGIN_DECLS
 
+#define AGS_FM_SYNTH_UTIL_CONTROL_PERIOD (32)
+
+/* fm oscillator */
+void ags_fm_synth_util_oscillate_s8(gint8 *buffer,
+				    guint oscillator_mode,
+				    gdouble freq, gdouble phase, gdouble volume,
+				    guint samplerate,
+				    guint offset, guint n_frames,
+				    guint lfo_osc_mode,
+				    gdouble lfo_freq, gdouble lfo_depth,
+				    gdouble tuning);
+void ags_fm_synth_util_oscillate_s16(gint16 *buffer,
+				     guint oscillator_mode,
+				     gdouble freq, gdouble phase, gdouble volume,
+				     guint samplerate,
+				     guint offset, guint n_frames,
+				     guint lfo_osc_mode,
+				     gdouble lfo_freq, gdouble lfo_depth,
+				     gdouble tuning);
+void ags_fm_synth_util_oscillate_s24(gint32 *buffer,
+				     guint oscillator_mode,
+				     gdouble freq, gdouble phase, gdouble volume,
+				     guint samplerate,
+				     guint offset, guint n_frames,
+				     guint lfo_osc_mode,
+				     gdouble lfo_freq, gdouble lfo_depth,
+				     gdouble tuning);
+void ags_fm_synth_util_oscillate_s32(gint32 *buffer,
+				     guint oscillator_mode,
+				     gdouble freq, gdouble phase, gdouble volume,
+				     guint samplerate,
+				     guint offset, guint n_frames,
+				     guint lfo_osc_mode,
+				     gdouble lfo_freq, gdouble lfo_depth,
+				     gdouble tuning);
+void ags_fm_synth_util_oscillate_s64(gint64 *buffer,
+				     guint oscillator_mode,
+				     gdouble freq, gdouble phase, gdouble volume,
+				     guint samplerate,
+				     guint offset, guint n_frames,
+				     guint lfo_osc_mode,
+				     gdouble lfo_freq, gdouble lfo_depth,
+				     gdouble tuning);
+void ags_fm_synth_util_oscillate_float(float *buffer,
+				       guint oscillator_mode,
+				       gdouble freq, gdouble phase, gdouble volume,
+				       guint samplerate,
+				       guint offset, guint n_frames,
+				       guint lfo_osc_mode,
+				       gdouble lfo_freq, gdouble lfo_depth,
+				       gdouble tuning);
+void ags_fm_synth_util_oscillate_double(gdouble *buffer,
+					guint oscillator_mode,
+					gdouble freq, gdouble phase, gdouble volume,
+					guint samplerate,
+					guint offset, guint n_frames,
+					guint lfo_osc_mode,
+					gdouble lfo_freq, gdouble lfo_depth,
+					gdouble tuning);
+void ags_fm_synth_util_oscillate_complex(AgsComplex *buffer,
+					 guint oscillator_mode,
+					 gdouble freq, gdouble phase, gdouble volume,
+					 guint samplerate,
+					 guint offset, guint n_frames,
+					 guint lfo_osc_mode,
+					 gdouble lfo_freq, gdouble lfo_depth,
+					 gdouble tuning);
+
+void ags_fm_synth_util_oscillate(void *buffer,
+				 guint oscillator_mode,
+				 gdouble freq, gdouble phase, gdouble volume,
+				 guint samplerate, guint audio_buffer_util_format,
+				 guint offset, guint n_frames,
+				 guint lfo_osc_mode,
+				 gdouble lfo_freq, gdouble lfo_depth,
+				 gdouble tuning);
+
+void ags_fm_synth_util_modulate(void *buffer,
+				guint oscillator_mode,
+				gdouble freq, gdouble phase, gdouble volume,
+				guint samplerate, guint audio_buffer_util_format,
+				guint offset, guint n_frames,
+				AgsModulationSource *modulation_source);
+
 /* fm sin oscillator */
 void ags_fm_synth_util_sin_s8(gint8 *buffer,
 			      gdouble freq, gdouble phase, gdouble volume,
@@ -0,0 +1,1076 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ags/audio/ags_modulation_source.h>
+
+#include <ags/audio/ags_synth_enums.h>
+#include <ags/audio/ags_synth_util.h>
+#include <ags/audio/ags_audio_buffer_util.h>
+
+#include <math.h>
+#include <complex.h>
+#include <string.h>
+
+#include <ags/i18n.h>
+
+void ags_modulation_source_class_init(AgsModulationSourceClass *modulation_source);
+void ags_modulation_source_init(AgsModulationSource *modulation_source);
+void ags_modulation_source_set_property(GObject *gobject,
+					guint prop_id,
+					const GValue *value,
+					GParamSpec *param_spec);
+void ags_modulation_source_get_property(GObject *gobject,
+					guint prop_id,
+					GValue *value,
+					GParamSpec *param_spec);
+void ags_modulation_source_finalize(GObject *gobject);
+
+void ags_modulation_source_alloc_control_value(AgsModulationSource *modulation_source);
+
+gboolean ags_modulation_source_is_computed(AgsModulationSource *modulation_source,
+					   guint64 tic);
+
+gdouble ags_modulation_source_get_lfo(guint lfo_wave,
+				      gdouble t);
+gdouble ags_modulation_source_interpolate(AgsModulationSource *modulation_source,
+					  guint frame);
+
+/**
+ * SECTION:ags_modulation_source
+ * @short_description: control rate modulation shared by voices
+ * @title: AgsModulationSource
+ * @section_id:
+ * @include: ags/audio/ags_modulation_source.h
+ *
+ * #AgsModulationSource computes a free-running LFO once per buffer at control
+ * rate, that is one control point every #AgsModulationSource:control-period
+ * frames. All voices and effect recalls of an #AgsAudio share the same source,
+ * see ags_audio_get_modulation_source(), and read it by linear interpolation
+ * instead of evaluating the oscillator per sample.
+ *
+ * The first consumer calling ags_modulation_source_compute() with a new tic
+ * advances the LFO by one buffer, all other consumers of the same tic reuse
+ * the computed control points. The phase is owned by the source and not by
+ * the voices, so it runs on regardless of which voice computed a tic.
+ *
+ * Once a tic is computed, ags_modulation_source_compute() and the reading
+ * functions don't lock the source anymore. The control points are rewritten
+ * only by the next tic, so all consumers have to read them within the tic
+ * they computed.
+ */
+
+enum{
+  PROP_0,
+  PROP_SAMPLERATE,
+  PROP_BUFFER_SIZE,
+  PROP_CONTROL_PERIOD,
+  PROP_LFO_WAVE,
+  PROP_LFO_FREQ,
+  PROP_LFO_DEPTH,
+  PROP_LFO_TUNING,
+};
+
+static gpointer ags_modulation_source_parent_class = NULL;
+
+GType
+ags_modulation_source_get_type()
+{
+  static volatile gsize g_define_type_id__volatile = 0;
+
+  if(g_once_init_enter (&g_define_type_id__volatile)){
+    GType ags_type_modulation_source = 0;
+
+    static const GTypeInfo ags_modulation_source_info = {
+      sizeof(AgsModulationSourceClass),
+      NULL,
+      NULL,
+      (GClassInitFunc) ags_modulation_source_class_init,
+      NULL,
+      NULL,
+      sizeof(AgsModulationSource),
+      0,
+      (GInstanceInitFunc) ags_modulation_source_init,
+    };
+
+    ags_type_modulation_source = g_type_register_static(G_TYPE_OBJECT,
+							"AgsModulationSource",
+							&ags_modulation_source_info,
+							0);
+
+    g_once_init_leave(&g_define_type_id__volatile, ags_type_modulation_source);
+  }
+
+  return g_define_type_id__volatile;
+}
+
+void
+ags_modulation_source_class_init(AgsModulationSourceClass *modulation_source)
+{
+  GObjectClass *gobject;
+
+  GParamSpec *param_spec;
+
+  ags_modulation_source_parent_class = g_type_class_peek_parent(modulation_source);
+
+  /* GObjectClass */
+  gobject = (GObjectClass *) modulation_source;
+
+  gobject->set_property = ags_modulation_source_set_property;
+  gobject->get_property = ags_modulation_source_get_property;
+
+  gobject->finalize = ags_modulation_source_finalize;
+
+  /* properties */
+  /**
+   * AgsModulationSource:samplerate:
+   *
+   * The samplerate of the consumers.
+   *
+   * Since: 3.7.0
+   */
+  param_spec = g_param_spec_uint("samplerate",
+				 i18n_pspec("samplerate"),
+				 i18n_pspec("The samplerate of the consumers"),
+				 0,
+				 G_MAXUINT32,
+				 0,
+				 G_PARAM_READABLE | G_PARAM_WRITABLE);
+  g_object_class_install_property(gobject,
+				  PROP_SAMPLERATE,
+				  param_spec);
+
+  /**
+   * AgsModulationSource:buffer-size:
+   *
+   * The buffer size of the consumers, the LFO advances by it per tic.
+   *
+   * Since: 3.7.0
+   */
+  param_spec = g_param_spec_uint("buffer-size",
+				 i18n_pspec("buffer size"),
+				 i18n_pspec("The buffer size of the consumers"),
+				 0,
+				 G_MAXUINT32,
+				 0,
+				 G_PARAM_READABLE | G_PARAM_WRITABLE);
+  g_object_class_install_property(gobject,
+				  PROP_BUFFER_SIZE,
+				  param_spec);
+
+  /**
+   * AgsModulationSource:control-period:
+   *
+   * The count of frames between two control points.
+   *
+   * Since: 3.7.0
+   */
+  param_spec = g_param_spec_uint("control-period",
+				 i18n_pspec("control period"),
+				 i18n_pspec("The count of frames between two control points"),
+				 1,
+				 G_MAXUINT32,
+				 AGS_MODULATION_SOURCE_DEFAULT_CONTROL_PERIOD,
+				 G_PARAM_READABLE | G_PARAM_WRITABLE);
+  g_object_class_install_property(gobject,
+				  PROP_CONTROL_PERIOD,
+				  param_spec);
+
+  /**
+   * AgsModulationSource:lfo-wave:
+   *
+   * The LFO wave, see #AgsSynthOscillatorMode-enum.
+   *
+   * Since: 3.7.0
+   */
+  param_spec = g_param_spec_uint("lfo-wave",
+				 i18n_pspec("LFO wave"),
+				 i18n_pspec("The LFO wave"),
+				 0,
+				 AGS_SYNTH_OSCILLATOR_LAST - 1,
+				 AGS_SYNTH_OSCILLATOR_SIN,
+				 G_PARAM_READABLE | G_PARAM_WRITABLE);
+  g_object_class_install_property(gobject,
+				  PROP_LFO_WAVE,
+				  param_spec);
+
+  /**
+   * AgsModulationSource:lfo-freq:
+   *
+   * The LFO frequency.
+   *
+   * Since: 3.7.0
+   */
+  param_spec = g_param_spec_double("lfo-freq",
+				   i18n_pspec("LFO frequency"),
+				   i18n_pspec("The LFO frequency"),
+				   0.0,
+				   G_MAXDOUBLE,
+				   0.0,
+				   G_PARAM_READABLE | G_PARAM_WRITABLE);
+  g_object_class_install_property(gobject,
+				  PROP_LFO_FREQ,
+				  param_spec);
+
+  /**
+   * AgsModulationSource:lfo-depth:
+   *
+   * The LFO depth.
+   *
+   * Since: 3.7.0
+   */
+  param_spec = g_param_spec_double("lfo-depth",
+				   i18n_pspec("LFO depth"),
+				   i18n_pspec("The LFO depth"),
+				   -G_MAXDOUBLE,
+				   G_MAXDOUBLE,
+				   1.0,
+				   G_PARAM_READABLE | G_PARAM_WRITABLE);
+  g_object_class_install_property(gobject,
+				  PROP_LFO_DEPTH,
+				  param_spec);
+
+  /**
+   * AgsModulationSource:lfo-tuning:
+   *
+   * The LFO tuning in cents.
+   *
+   * Since: 3.7.0
+   */
+  param_spec = g_param_spec_double("lfo-tuning",
+				   i18n_pspec("LFO tuning"),
+				   i18n_pspec("The LFO tuning"),
+				   -G_MAXDOUBLE,
+				   G_MAXDOUBLE,
+				   0.0,
+				   G_PARAM_READABLE | G_PARAM_WRITABLE);
+  g_object_class_install_property(gobject,
+				  PROP_LFO_TUNING,
+				  param_spec);
+
+  /* LFO lookup */
+  ags_synth_util_sin_table_init();
+}
+
+void
+ags_modulation_source_init(AgsModulationSource *modulation_source)
+{
+  AgsConfig *config;
+
+  modulation_source->flags = 0;
+
+  /* modulation source mutex */
+  g_rec_mutex_init(&(modulation_source->obj_mutex));
+
+  /* config */
+  config = ags_config_get_instance();
+
+  /* fields */
+  modulation_source->samplerate = (guint) ags_soundcard_helper_config_get_samplerate(config);
+  modulation_source->buffer_size = (guint) ags_soundcard_helper_config_get_buffer_size(config);
+
+  modulation_source->control_period = AGS_MODULATION_SOURCE_DEFAULT_CONTROL_PERIOD;
+
+  modulation_source->lfo_wave = AGS_SYNTH_OSCILLATOR_SIN;
+  modulation_source->lfo_freq = 0.0;
+  modulation_source->lfo_depth = 1.0;
+  modulation_source->lfo_tuning = 0.0;
+
+  modulation_source->tic = G_MAXUINT64;
+  modulation_source->sequence = 0;
+  modulation_source->lfo_phase = 0.0;
+
+  modulation_source->control_count = 0;
+  modulation_source->control_value = NULL;
+
+  ags_modulation_source_alloc_control_value(modulation_source);
+}
+
+void
+ags_modulation_source_set_property(GObject *gobject,
+				   guint prop_id,
+				   const GValue *value,
+				   GParamSpec *param_spec)
+{
+  AgsModulationSource *modulation_source;
+
+  GRecMutex *modulation_source_mutex;
+
+  modulation_source = AGS_MODULATION_SOURCE(gobject);
+
+  /* get modulation source mutex */
+  modulation_source_mutex = AGS_MODULATION_SOURCE_GET_OBJ_MUTEX(modulation_source);
+
+  g_rec_mutex_lock(modulation_source_mutex);
+
+  g_atomic_int_inc(&(modulation_source->sequence));
+
+  switch(prop_id){
+  case PROP_SAMPLERATE:
+    {
+      modulation_source->samplerate = g_value_get_uint(value);
+    }
+    break;
+  case PROP_BUFFER_SIZE:
+    {
+      modulation_source->buffer_size = g_value_get_uint(value);
+
+      ags_modulation_source_alloc_control_value(modulation_source);
+    }
+    break;
+  case PROP_CONTROL_PERIOD:
+    {
+      modulation_source->control_period = g_value_get_uint(value);
+
+      ags_modulation_source_alloc_control_value(modulation_source);
+    }
+    break;
+  case PROP_LFO_WAVE:
+    {
+      modulation_source->lfo_wave = g_value_get_uint(value);
+    }
+    break;
+  case PROP_LFO_FREQ:
+    {
+      modulation_source->lfo_freq = g_value_get_double(value);
+    }
+    break;
+  case PROP_LFO_DEPTH:
+    {
+      modulation_source->lfo_depth = g_value_get_double(value);
+    }
+    break;
+  case PROP_LFO_TUNING:
+    {
+      modulation_source->lfo_tuning = g_value_get_double(value);
+    }
+    break;
+  default:
+    G_OBJECT_WARN_INVALID_PROPERTY_ID(gobject, prop_id, param_spec);
+    break;
+  }
+
+  /* recompute on next access */
+  modulation_source->flags &= (~AGS_MODULATION_SOURCE_COMPUTED);
+
+  g_atomic_int_inc(&(modulation_source->sequence));
+
+  g_rec_mutex_unlock(modulation_source_mutex);
+}
+
+void
+ags_modulation_source_get_property(GObject *gobject,
+				   guint prop_id,
+				   GValue *value,
+				   GParamSpec *param_spec)
+{
+  AgsModulationSource *modulation_source;
+
+  GRecMutex *modulation_source_mutex;
+
+  modulation_source = AGS_MODULATION_SOURCE(gobject);
+
+  /* get modulation source mutex */
+  modulation_source_mutex = AGS_MODULATION_SOURCE_GET_OBJ_MUTEX(modulation_source);
+
+  g_rec_mutex_lock(modulation_source_mutex);
+
+  switch(prop_id){
+  case PROP_SAMPLERATE:
+    {
+      g_value_set_uint(value, modulation_source->samplerate);
+    }
+    break;
+  case PROP_BUFFER_SIZE:
+    {
+      g_value_set_uint(value, modulation_source->buffer_size);
+    }
+    break;
+  case PROP_CONTROL_PERIOD:
+    {
+      g_value_set_uint(value, modulation_source->control_period);
+    }
+    break;
+  case PROP_LFO_WAVE:
+    {
+      g_value_set_uint(value, modulation_source->lfo_wave);
+    }
+    break;
+  case PROP_LFO_FREQ:
+    {
+      g_value_set_double(value, modulation_source->lfo_freq);
+    }
+    break;
+  case PROP_LFO_DEPTH:
+    {
+      g_value_set_double(value, modulation_source->lfo_depth);
+    }
+    break;
+  case PROP_LFO_TUNING:
+    {
+      g_value_set_double(value, modulation_source->lfo_tuning);
+    }
+    break;
+  default:
+    G_OBJECT_WARN_INVALID_PROPERTY_ID(gobject, prop_id, param_spec);
+    break;
+  }
+
+  g_rec_mutex_unlock(modulation_source_mutex);
+}
+
+void
+ags_modulation_source_finalize(GObject *gobject)
+{
+  AgsModulationSource *modulation_source;
+
+  modulation_source = AGS_MODULATION_SOURCE(gobject);
+
+  g_free(modulation_source->control_value);
+
+  /* call parent */
+  G_OBJECT_CLASS(ags_modulation_source_parent_class)->finalize(gobject);
+}
+
+void
+ags_modulation_source_alloc_control_value(AgsModulationSource *modulation_source)
+{
+  guint control_count;
+
+  control_count = 0;
+  
+  if(modulation_source->control_period != 0){
+    /* control points including both buffer boundaries */
+    control_count = (modulation_source->buffer_size + modulation_source->control_period - 1) / modulation_source->control_period + 1;
+  }
+  
+  if(modulation_source->control_count != control_count){
+    modulation_source->control_value = (gdouble *) g_realloc(modulation_source->control_value,
+							     control_count * sizeof(gdouble));
+
+    if(control_count > 0){
+      memset(modulation_source->control_value, 0, control_count * sizeof(gdouble));
+    }
+    
+    modulation_source->control_count = control_count;
+  }
+}
+
+gboolean
+ags_modulation_source_is_computed(AgsModulationSource *modulation_source,
+				  guint64 tic)
+{
+  guint sequence;
+  gboolean is_computed;
+
+  /* odd while a writer holds the mutex */
+  sequence = (guint) g_atomic_int_get(&(modulation_source->sequence));
+
+  if((1 & sequence) != 0){
+    return(FALSE);
+  }
+  
+  is_computed = (modulation_source->tic == tic &&
+		 (AGS_MODULATION_SOURCE_COMPUTED & (modulation_source->flags)) != 0) ? TRUE: FALSE;
+
+  /* retry locked if a writer interfered */
+  if((guint) g_atomic_int_get(&(modulation_source->sequence)) != sequence){
+    return(FALSE);
+  }
+
+  return(is_computed);
+}
+
+gdouble
+ags_modulation_source_get_lfo(guint lfo_wave,
+			      gdouble t)
+{
+  gdouble lfo;
+
+  lfo = 0.0;
+
+  switch(lfo_wave){
+  case AGS_SYNTH_OSCILLATOR_SIN:
+  {
+    lfo = ags_synth_util_sin_lookup(t);
+  }
+  break;
+  case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
+  {
+    lfo = 2.0 * t - 1.0;
+  }
+  break;
+  case AGS_SYNTH_OSCILLATOR_TRIANGLE:
+  {
+    lfo = 1.0 - 4.0 * fabs(t - 0.5);
+  }
+  break;
+  case AGS_SYNTH_OSCILLATOR_SQUARE:
+  {
+    lfo = (t < 0.5) ? 1.0: -1.0;
+  }
+  break;
+  case AGS_SYNTH_OSCILLATOR_IMPULSE:
+  {
+    lfo = (t < 0.6 || t >= 0.9) ? 1.0: -1.0;
+  }
+  break;
+  }
+
+  return(lfo);
+}
+
+gdouble
+ags_modulation_source_interpolate(AgsModulationSource *modulation_source,
+				  guint frame)
+{
+  gdouble *control_value;
+
+  gdouble frac;
+  guint control_period;
+  guint k;
+
+  control_value = modulation_source->control_value;
+
+  if(control_value == NULL ||
+     modulation_source->control_count == 0){
+    return(1.0);
+  }
+
+  control_period = modulation_source->control_period;
+
+  if(frame >= modulation_source->buffer_size){
+    return(control_value[modulation_source->control_count - 1]);
+  }
+
+  k = frame / control_period;
+  frac = (gdouble) (frame - k * control_period) / (gdouble) control_period;
+
+  return(control_value[k] + frac * (control_value[k + 1] - control_value[k]));
+}
+
+/**
+ * ags_modulation_source_test_flags:
+ * @modulation_source: the #AgsModulationSource
+ * @flags: the flags
+ *
+ * Test @flags to be set on @modulation_source.
+ *
+ * Returns: %TRUE if flags are set, else %FALSE
+ *
+ * Since: 3.7.0
+ */
+gboolean
+ags_modulation_source_test_flags(AgsModulationSource *modulation_source, guint flags)
+{
+  gboolean retval;
+
+  GRecMutex *modulation_source_mutex;
+
+  if(!AGS_IS_MODULATION_SOURCE(modulation_source)){
+    return(FALSE);
+  }
+
+  /* get modulation source mutex */
+  modulation_source_mutex = AGS_MODULATION_SOURCE_GET_OBJ_MUTEX(modulation_source);
+
+  /* test */
+  g_rec_mutex_lock(modulation_source_mutex);
+
+  retval = (flags & (modulation_source->flags)) ? TRUE: FALSE;
+
+  g_rec_mutex_unlock(modulation_source_mutex);
+
+  return(retval);
+}
+
+/**
+ * ags_modulation_source_set_flags:
+ * @modulation_source: the #AgsModulationSource
+ * @flags: see #AgsModulationSourceFlags-enum
+ *
+ * Enable a feature of @modulation_source.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_modulation_source_set_flags(AgsModulationSource *modulation_source, guint flags)
+{
+  GRecMutex *modulation_source_mutex;
+
+  if(!AGS_IS_MODULATION_SOURCE(modulation_source)){
+    return;
+  }
+
+  /* get modulation source mutex */
+  modulation_source_mutex = AGS_MODULATION_SOURCE_GET_OBJ_MUTEX(modulation_source);
+
+  /* set flags */
+  g_rec_mutex_lock(modulation_source_mutex);
+
+  g_atomic_int_inc(&(modulation_source->sequence));
+
+  modulation_source->flags |= flags;
+
+  g_atomic_int_inc(&(modulation_source->sequence));
+
+  g_rec_mutex_unlock(modulation_source_mutex);
+}
+
+/**
+ * ags_modulation_source_unset_flags:
+ * @modulation_source: the #AgsModulationSource
+ * @flags: see #AgsModulationSourceFlags-enum
+ *
+ * Disable a feature of @modulation_source.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_modulation_source_unset_flags(AgsModulationSource *modulation_source, guint flags)
+{
+  GRecMutex *modulation_source_mutex;
+
+  if(!AGS_IS_MODULATION_SOURCE(modulation_source)){
+    return;
+  }
+
+  /* get modulation source mutex */
+  modulation_source_mutex = AGS_MODULATION_SOURCE_GET_OBJ_MUTEX(modulation_source);
+
+  /* unset flags */
+  g_rec_mutex_lock(modulation_source_mutex);
+
+  g_atomic_int_inc(&(modulation_source->sequence));
+
+  modulation_source->flags &= (~flags);
+
+  g_atomic_int_inc(&(modulation_source->sequence));
+
+  g_rec_mutex_unlock(modulation_source_mutex);
+}
+
+/**
+ * ags_modulation_source_set_lfo:
+ * @modulation_source: the #AgsModulationSource
+ * @lfo_wave: the LFO wave, see #AgsSynthOscillatorMode-enum
+ * @lfo_freq: the LFO frequency
+ * @lfo_depth: the LFO depth
+ * @lfo_tuning: the LFO tuning in cents
+ *
+ * Set the LFO parameters of @modulation_source. The control points are
+ * recomputed by the next call to ags_modulation_source_compute() only if
+ * a parameter actually changed.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_modulation_source_set_lfo(AgsModulationSource *modulation_source,
+			      guint lfo_wave,
+			      gdouble lfo_freq, gdouble lfo_depth,
+			      gdouble lfo_tuning)
+{
+  GRecMutex *modulation_source_mutex;
+
+  if(!AGS_IS_MODULATION_SOURCE(modulation_source)){
+    return;
+  }
+
+  /* get modulation source mutex */
+  modulation_source_mutex = AGS_MODULATION_SOURCE_GET_OBJ_MUTEX(modulation_source);
+
+  /* set LFO */
+  g_rec_mutex_lock(modulation_source_mutex);
+
+  if(modulation_source->lfo_wave != lfo_wave ||
+     modulation_source->lfo_freq != lfo_freq ||
+     modulation_source->lfo_depth != lfo_depth ||
+     modulation_source->lfo_tuning != lfo_tuning){
+    g_atomic_int_inc(&(modulation_source->sequence));
+
+    modulation_source->lfo_wave = lfo_wave;
+    modulation_source->lfo_freq = lfo_freq;
+    modulation_source->lfo_depth = lfo_depth;
+    modulation_source->lfo_tuning = lfo_tuning;
+
+    modulation_source->flags &= (~AGS_MODULATION_SOURCE_COMPUTED);
+
+    g_atomic_int_inc(&(modulation_source->sequence));
+  }
+
+  g_rec_mutex_unlock(modulation_source_mutex);
+}
+
+/**
+ * ags_modulation_source_compute:
+ * @modulation_source: the #AgsModulationSource
+ * @tic: the tic identifying the current buffer
+ *
+ * Compute the control points of @modulation_source for @tic. If @tic differs
+ * from the previous call the LFO advances by one buffer, calling it again with
+ * the same @tic doesn't do anything and doesn't lock @modulation_source,
+ * unless a parameter was modified.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_modulation_source_compute(AgsModulationSource *modulation_source,
+			      guint64 tic)
+{
+  gdouble t, dt;
+  gdouble lfo;
+  guint frame;
+  guint k;
+
+  GRecMutex *modulation_source_mutex;
+
+  if(!AGS_IS_MODULATION_SOURCE(modulation_source)){
+    return;
+  }
+
+  /* computed already */
+  if(ags_modulation_source_is_computed(modulation_source,
+				       tic)){
+    return;
+  }
+
+  /* get modulation source mutex */
+  modulation_source_mutex = AGS_MODULATION_SOURCE_GET_OBJ_MUTEX(modulation_source);
+
+  g_rec_mutex_lock(modulation_source_mutex);
+
+  if(modulation_source->tic == tic &&
+     (AGS_MODULATION_SOURCE_COMPUTED & (modulation_source->flags)) != 0){
+    g_rec_mutex_unlock(modulation_source_mutex);
+
+    return;
+  }
+
+  if(modulation_source->samplerate == 0 ||
+     modulation_source->control_period == 0){
+    g_rec_mutex_unlock(modulation_source_mutex);
+
+    return;
+  }
+
+  dt = modulation_source->lfo_freq / (gdouble) modulation_source->samplerate;
+
+  g_atomic_int_inc(&(modulation_source->sequence));
+
+  /* advance the free running LFO */
+  if(modulation_source->tic != tic &&
+     modulation_source->tic != G_MAXUINT64){
+    modulation_source->lfo_phase += (gdouble) modulation_source->buffer_size * dt;
+    modulation_source->lfo_phase -= floor(modulation_source->lfo_phase);
+  }
+
+  modulation_source->tic = tic;
+
+  for(k = 0; k < modulation_source->control_count; k++){
+    frame = k * modulation_source->control_period;
+
+    if(frame > modulation_source->buffer_size){
+      frame = modulation_source->buffer_size;
+    }
+
+    t = modulation_source->lfo_phase + (gdouble) frame * dt;
+    t -= floor(t);
+
+    lfo = ags_modulation_source_get_lfo(modulation_source->lfo_wave,
+					t);
+
+    modulation_source->control_value[k] = modulation_source->lfo_tuning / 1200.0 + lfo * modulation_source->lfo_depth;
+  }
+
+  modulation_source->flags |= AGS_MODULATION_SOURCE_COMPUTED;
+
+  g_atomic_int_inc(&(modulation_source->sequence));
+
+  g_rec_mutex_unlock(modulation_source_mutex);
+}
+
+/**
+ * ags_modulation_source_compute_lfo:
+ * @modulation_source: the #AgsModulationSource
+ * @tic: the tic identifying the current buffer
+ * @lfo_wave: the LFO wave, see #AgsSynthOscillatorMode-enum
+ * @lfo_freq: the LFO frequency
+ * @lfo_depth: the LFO depth
+ * @lfo_tuning: the LFO tuning in cents
+ *
+ * Compute the control points of @modulation_source for @tic like
+ * ags_modulation_source_compute() does. The first consumer of @tic sets
+ * the LFO parameters, all others only compare theirs. The phase is the
+ * free-running phase of @modulation_source in any case.
+ *
+ * Returns: %TRUE if the control points of @tic were computed with the
+ *   given LFO parameters, otherwise %FALSE and the caller has to compute
+ *   its own LFO
+ *
+ * Since: 3.7.0
+ */
+gboolean
+ags_modulation_source_compute_lfo(AgsModulationSource *modulation_source,
+				  guint64 tic,
+				  guint lfo_wave,
+				  gdouble lfo_freq, gdouble lfo_depth,
+				  gdouble lfo_tuning)
+{
+  gboolean success;
+  
+  GRecMutex *modulation_source_mutex;
+
+  if(!AGS_IS_MODULATION_SOURCE(modulation_source)){
+    return(FALSE);
+  }
+
+  /* first consumer of tic */
+  if(!ags_modulation_source_is_computed(modulation_source,
+					tic)){
+    /* get modulation source mutex */
+    modulation_source_mutex = AGS_MODULATION_SOURCE_GET_OBJ_MUTEX(modulation_source);
+
+    g_rec_mutex_lock(modulation_source_mutex);
+
+    if(modulation_source->tic != tic ||
+       (AGS_MODULATION_SOURCE_COMPUTED & (modulation_source->flags)) == 0){
+      ags_modulation_source_set_lfo(modulation_source,
+				    lfo_wave,
+				    lfo_freq, lfo_depth,
+				    lfo_tuning);
+    }
+    
+    ags_modulation_source_compute(modulation_source,
+				  tic);
+    
+    g_rec_mutex_unlock(modulation_source_mutex);
+  }
+
+  /* the parameters don't change until the next tic */
+  success = (modulation_source->lfo_wave == lfo_wave &&
+	     modulation_source->lfo_freq == lfo_freq &&
+	     modulation_source->lfo_depth == lfo_depth &&
+	     modulation_source->lfo_tuning == lfo_tuning) ? TRUE: FALSE;
+
+  return(success);
+}
+
+/**
+ * ags_modulation_source_get_value:
+ * @modulation_source: the #AgsModulationSource
+ * @frame: the frame within the current buffer
+ *
+ * Get the modulation value at @frame interpolated from the control points
+ * computed by ags_modulation_source_compute(). It doesn't lock
+ * @modulation_source.
+ *
+ * Returns: the modulation value
+ *
+ * Since: 3.7.0
+ */
+gdouble
+ags_modulation_source_get_value(AgsModulationSource *modulation_source,
+				guint frame)
+{
+  gdouble value;
+
+  if(!AGS_IS_MODULATION_SOURCE(modulation_source)){
+    return(1.0);
+  }
+
+  value = ags_modulation_source_interpolate(modulation_source,
+					    frame);
+
+  return(value);
+}
+
+/**
+ * ags_modulation_source_fill:
+ * @modulation_source: the #AgsModulationSource
+ * @buffer: the buffer to fill
+ * @offset: start frame
+ * @n_frames: fill n frames
+ *
+ * Fill @buffer from @offset on with the interpolated modulation values. It
+ * doesn't lock @modulation_source.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_modulation_source_fill(AgsModulationSource *modulation_source,
+			   gdouble *buffer,
+			   guint offset, guint n_frames)
+{
+  guint i;
+
+  if(!AGS_IS_MODULATION_SOURCE(modulation_source) ||
+     buffer == NULL){
+    return;
+  }
+
+  for(i = offset; i < offset + n_frames; i++){
+    buffer[i] = ags_modulation_source_interpolate(modulation_source,
+						  i);
+  }
+}
+
+/**
+ * ags_modulation_source_multiply:
+ * @modulation_source: the #AgsModulationSource
+ * @buffer: the audio buffer
+ * @audio_buffer_util_format: the audio buffer util format
+ * @offset: start frame
+ * @n_frames: apply to n frames
+ *
+ * Multiply @buffer by the interpolated modulation values, the same way
+ * ags_lfo_synth_util_sin() applies its LFO. It doesn't lock @modulation_source.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_modulation_source_multiply(AgsModulationSource *modulation_source,
+			       void *buffer,
+			       guint audio_buffer_util_format,
+			       guint offset, guint n_frames)
+{
+  guint i;
+
+  if(!AGS_IS_MODULATION_SOURCE(modulation_source) ||
+     buffer == NULL){
+    return;
+  }
+
+  switch(audio_buffer_util_format){
+  case AGS_AUDIO_BUFFER_UTIL_S8:
+  {
+    gint8 *s8_buffer;
+
+    s8_buffer = (gint8 *) buffer;
+
+    for(i = offset; i < offset + n_frames; i++){
+      s8_buffer[i] = (gint8) (0xff & (gint16) ((gdouble) s8_buffer[i] * ags_modulation_source_interpolate(modulation_source, i)));
+    }
+  }
+  break;
+  case AGS_AUDIO_BUFFER_UTIL_S16:
+  {
+    gint16 *s16_buffer;
+
+    s16_buffer = (gint16 *) buffer;
+
+    for(i = offset; i < offset + n_frames; i++){
+      s16_buffer[i] = (gint16) (0xffff & (gint32) ((gdouble) s16_buffer[i] * ags_modulation_source_interpolate(modulation_source, i)));
+    }
+  }
+  break;
+  case AGS_AUDIO_BUFFER_UTIL_S24:
+  {
+    gint32 *s24_buffer;
+
+    s24_buffer = (gint32 *) buffer;
+
+    for(i = offset; i < offset + n_frames; i++){
+      s24_buffer[i] = (gint32) (0xffffffff & (gint32) ((gdouble) s24_buffer[i] * ags_modulation_source_interpolate(modulation_source, i)));
+    }
+  }
+  break;
+  case AGS_AUDIO_BUFFER_UTIL_S32:
+  {
+    gint32 *s32_buffer;
+
+    s32_buffer = (gint32 *) buffer;
+
+    for(i = offset; i < offset + n_frames; i++){
+      s32_buffer[i] = (gint32) (0xffffffff & (gint64) ((gdouble) s32_buffer[i] * ags_modulation_source_interpolate(modulation_source, i)));
+    }
+  }
+  break;
+  case AGS_AUDIO_BUFFER_UTIL_S64:
+  {
+    gint64 *s64_buffer;
+
+    s64_buffer = (gint64 *) buffer;
+
+    for(i = offset; i < offset + n_frames; i++){
+      s64_buffer[i] = (gint64) (0xffffffffffff & (gint64) ((gdouble) s64_buffer[i] * ags_modulation_source_interpolate(modulation_source, i)));
+    }
+  }
+  break;
+  case AGS_AUDIO_BUFFER_UTIL_FLOAT:
+  {
+    gfloat *float_buffer;
+
+    float_buffer = (gfloat *) buffer;
+
+    for(i = offset; i < offset + n_frames; i++){
+      float_buffer[i] = (gfloat) ((gdouble) float_buffer[i] * ags_modulation_source_interpolate(modulation_source, i));
+    }
+  }
+  break;
+  case AGS_AUDIO_BUFFER_UTIL_DOUBLE:
+  {
+    gdouble *double_buffer;
+
+    double_buffer = (gdouble *) buffer;
+
+    for(i = offset; i < offset + n_frames; i++){
+      double_buffer[i] = double_buffer[i] * ags_modulation_source_interpolate(modulation_source, i);
+    }
+  }
+  break;
+  case AGS_AUDIO_BUFFER_UTIL_COMPLEX:
+  {
+    AgsComplex *complex_buffer;
+
+    complex_buffer = (AgsComplex *) buffer;
+
+    for(i = offset; i < offset + n_frames; i++){
+      ags_complex_set(complex_buffer + i,
+		      ags_complex_get(complex_buffer + i) * ags_modulation_source_interpolate(modulation_source, i));
+    }
+  }
+  break;
+  default:
+    g_warning("ags_modulation_source_multiply() - unsupported format");
+  }
+}
+
+/**
+ * ags_modulation_source_new:
+ * @samplerate: the samplerate
+ * @buffer_size: the buffer size
+ *
+ * Create a new instance of #AgsModulationSource.
+ *
+ * Returns: the new #AgsModulationSource
+ *
+ * Since: 3.7.0
+ */
+AgsModulationSource*
+ags_modulation_source_new(guint samplerate,
+			  guint buffer_size)
+{
+  AgsModulationSource *modulation_source;
+
+  modulation_source = (AgsModulationSource *) g_object_new(AGS_TYPE_MODULATION_SOURCE,
+							   "samplerate", samplerate,
+							   "buffer-size", buffer_size,
+							   NULL);
+
+  return(modulation_source);
+}
@@ -0,0 +1,120 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __AGS_MODULATION_SOURCE_H__
+#define __AGS_MODULATION_SOURCE_H__
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <ags/libags.h>
+
+G_BEGIN_DECLS
+
+#define AGS_TYPE_MODULATION_SOURCE                (ags_modulation_source_get_type())
+#define AGS_MODULATION_SOURCE(obj)                (G_TYPE_CHECK_INSTANCE_CAST((obj), AGS_TYPE_MODULATION_SOURCE, AgsModulationSource))
+#define AGS_MODULATION_SOURCE_CLASS(class)        (G_TYPE_CHECK_CLASS_CAST((class), AGS_TYPE_MODULATION_SOURCE, AgsModulationSourceClass))
+#define AGS_IS_MODULATION_SOURCE(obj)             (G_TYPE_CHECK_INSTANCE_TYPE ((obj), AGS_TYPE_MODULATION_SOURCE))
+#define AGS_IS_MODULATION_SOURCE_CLASS(class)     (G_TYPE_CHECK_CLASS_TYPE ((class), AGS_TYPE_MODULATION_SOURCE))
+#define AGS_MODULATION_SOURCE_GET_CLASS(obj)      (G_TYPE_INSTANCE_GET_CLASS (obj, AGS_TYPE_MODULATION_SOURCE, AgsModulationSourceClass))
+
+#define AGS_MODULATION_SOURCE_GET_OBJ_MUTEX(obj) (&(((AgsModulationSource *) obj)->obj_mutex))
+
+#define AGS_MODULATION_SOURCE_DEFAULT_CONTROL_PERIOD (32)
+
+typedef struct _AgsModulationSource AgsModulationSource;
+typedef struct _AgsModulationSourceClass AgsModulationSourceClass;
+
+/**
+ * AgsModulationSourceFlags:
+ * @AGS_MODULATION_SOURCE_COMPUTED: the control values of the current tic are computed
+ *
+ * Enum values to control the behavior or indicate internal state of #AgsModulationSource by
+ * enable/disable as flags.
+ */
+typedef enum{
+  AGS_MODULATION_SOURCE_COMPUTED     = 1,
+}AgsModulationSourceFlags;
+
+struct _AgsModulationSource
+{
+  GObject gobject;
+
+  guint flags;
+
+  GRecMutex obj_mutex;
+
+  guint samplerate;
+  guint buffer_size;
+
+  guint control_period;
+
+  guint lfo_wave;
+  gdouble lfo_freq;
+  gdouble lfo_depth;
+  gdouble lfo_tuning;
+
+  guint64 tic;
+  volatile guint sequence;
+  gdouble lfo_phase;
+
+  guint control_count;
+  gdouble *control_value;
+};
+
+struct _AgsModulationSourceClass
+{
+  GObjectClass gobject;
+};
+
+GType ags_modulation_source_get_type(void);
+
+gboolean ags_modulation_source_test_flags(AgsModulationSource *modulation_source, guint flags);
+void ags_modulation_source_set_flags(AgsModulationSource *modulation_source, guint flags);
+void ags_modulation_source_unset_flags(AgsModulationSource *modulation_source, guint flags);
+
+void ags_modulation_source_set_lfo(AgsModulationSource *modulation_source,
+				   guint lfo_wave,
+				   gdouble lfo_freq, gdouble lfo_depth,
+				   gdouble lfo_tuning);
+
+void ags_modulation_source_compute(AgsModulationSource *modulation_source,
+				   guint64 tic);
+gboolean ags_modulation_source_compute_lfo(AgsModulationSource *modulation_source,
+					   guint64 tic,
+					   guint lfo_wave,
+					   gdouble lfo_freq, gdouble lfo_depth,
+					   gdouble lfo_tuning);
+
+gdouble ags_modulation_source_get_value(AgsModulationSource *modulation_source,
+					guint frame);
+void ags_modulation_source_fill(AgsModulationSource *modulation_source,
+				gdouble *buffer,
+				guint offset, guint n_frames);
+void ags_modulation_source_multiply(AgsModulationSource *modulation_source,
+				    void *buffer,
+				    guint audio_buffer_util_format,
+				    guint offset, guint n_frames);
+
+AgsModulationSource* ags_modulation_source_new(guint samplerate,
+					       guint buffer_size);
+
+G_END_DECLS
+
+#endif /*__AGS_MODULATION_SOURCE_H__*/
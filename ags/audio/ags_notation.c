@@ -41,6 +41,19 @@ void ags_notation_get_property(GObject *gobject,
 void ags_notation_dispose(GObject *gobject);
 void ags_notation_finalize(GObject *gobject);
 
+gint ags_notation_tree_entry_compare(gconstpointer a,
+				     gconstpointer b,
+				     gpointer user_data);
+GSequenceIter* ags_notation_tree_lower_bound(AgsNotation *notation,
+					     guint x0, guint y);
+void ags_notation_tree_insert(AgsNotation *notation,
+			      AgsNote *note);
+gboolean ags_notation_tree_remove(AgsNotation *notation,
+				  AgsNote *note);
+void ags_notation_tree_rebuild(AgsNotation *notation);
+
+void ags_notation_invalidate_note_store(AgsNotation *notation);
+
 void ags_notation_insert_native_piano_from_clipboard_version_0_3_12(AgsNotation *notation,
 								    xmlNode *root_node, char *version,
 								    char *base_frequency,
@@ -67,6 +80,10 @@ void ags_notation_insert_native_piano_from_clipboard(AgsNotation *notation,
  * @include: ags/audio/ags_notation.h
  *
  * #AgsNotation acts as a container of #AgsNote.
+ *
+ * The notes are kept in a balanced tree sorted by x0 and y, #AgsNotation:note
+ * is maintained alongside as sorted #GList-struct view. So adding, removing and
+ * finding notes doesn't depend on the count of notes.
  */
 
 enum{
@@ -110,6 +127,25 @@ ags_notation_get_type()
   return g_define_type_id__volatile;
 }
 
+GType
+ags_notation_note_store_get_type()
+{
+  static volatile gsize g_define_type_id__volatile = 0;
+
+  if(g_once_init_enter (&g_define_type_id__volatile)){
+    GType ags_type_notation_note_store = 0;
+
+    ags_type_notation_note_store =
+      g_boxed_type_register_static("AgsNotationNoteStore",
+				   (GBoxedCopyFunc) ags_notation_note_store_ref,
+				   (GBoxedFreeFunc) ags_notation_note_store_unref);
+
+    g_once_init_leave(&g_define_type_id__volatile, ags_type_notation_note_store);
+  }
+
+  return g_define_type_id__volatile;
+}
+
 void 
 ags_notation_class_init(AgsNotationClass *notation)
 {
@@ -219,6 +255,12 @@ ags_notation_init(AgsNotation *notation)
 
   notation->note = NULL;
   notation->selection = NULL;
+
+  notation->note_tree = g_sequence_new(g_free);
+  notation->note_tree_iter = g_hash_table_new(g_direct_hash, g_direct_equal);
+  notation->note_tree_max_length = 0;
+
+  notation->note_store = NULL;
 }
 
 void
@@ -313,7 +355,7 @@ ags_notation_set_property(GObject *gobject,
       g_rec_mutex_lock(notation_mutex);
 
       if(note == NULL ||
-	 g_list_find(notation->note, note) != NULL){
+	 g_hash_table_contains(notation->note_tree_iter, note)){
 	g_rec_mutex_unlock(notation_mutex);
 	
 	return;
@@ -431,6 +473,12 @@ ags_notation_dispose(GObject *gobject)
 
   notation->note = NULL;
   notation->selection = NULL;
+
+  g_hash_table_remove_all(notation->note_tree_iter);
+  g_sequence_remove_range(g_sequence_get_begin_iter(notation->note_tree),
+			  g_sequence_get_end_iter(notation->note_tree));
+
+  ags_notation_invalidate_note_store(notation);
     
   /* call parent */
   G_OBJECT_CLASS(ags_notation_parent_class)->dispose(gobject);
@@ -459,11 +507,218 @@ ags_notation_finalize(GObject *gobject)
 
   g_list_free_full(notation->selection,
 		   g_object_unref);
+
+  g_hash_table_destroy(notation->note_tree_iter);
+  g_sequence_free(notation->note_tree);
+
+  ags_notation_note_store_unref(notation->note_store);
   
   /* call parent */
   G_OBJECT_CLASS(ags_notation_parent_class)->finalize(gobject);
 }
 
+gint
+ags_notation_tree_entry_compare(gconstpointer a,
+				gconstpointer b,
+				gpointer user_data)
+{
+  AgsNotationTreeEntry *entry_a, *entry_b;
+
+  entry_a = AGS_NOTATION_TREE_ENTRY(a);
+  entry_b = AGS_NOTATION_TREE_ENTRY(b);
+
+  if(entry_a->x0 != entry_b->x0){
+    return((entry_a->x0 < entry_b->x0) ? -1: 1);
+  }
+
+  if(entry_a->y != entry_b->y){
+    return((entry_a->y < entry_b->y) ? -1: 1);
+  }
+
+  /* search keys sort before equal entries */
+  if(entry_a->link == NULL &&
+     entry_b->link != NULL){
+    return(-1);
+  }
+
+  if(entry_a->link != NULL &&
+     entry_b->link == NULL){
+    return(1);
+  }
+  
+  return(0);
+}
+
+GSequenceIter*
+ags_notation_tree_lower_bound(AgsNotation *notation,
+			      guint x0, guint y)
+{
+  AgsNotationTreeEntry key;
+
+  key.x0 = x0;
+  key.y = y;
+  key.link = NULL;
+
+  return(g_sequence_search(notation->note_tree,
+			   &key,
+			   ags_notation_tree_entry_compare,
+			   NULL));
+}
+
+void
+ags_notation_tree_insert(AgsNotation *notation,
+			 AgsNote *note)
+{
+  AgsNotationTreeEntry *entry, *prev_entry;
+
+  GSequenceIter *iter;
+  GList *link;
+
+  guint x0, x1;
+  guint y;
+
+  g_object_get(note,
+	       "x0", &x0,
+	       "x1", &x1,
+	       "y", &y,
+	       NULL);
+
+  entry = (AgsNotationTreeEntry *) g_new0(AgsNotationTreeEntry,
+					  1);
+
+  entry->x0 = x0;
+  entry->y = y;
+
+  iter = g_sequence_insert_sorted(notation->note_tree,
+				  entry,
+				  ags_notation_tree_entry_compare,
+				  NULL);
+
+  /* link the list view next to the previous entry */
+  if(!g_sequence_iter_is_begin(iter)){
+    prev_entry = AGS_NOTATION_TREE_ENTRY(g_sequence_get(g_sequence_iter_prev(iter)));
+
+    link = g_list_alloc();
+    link->data = note;
+    
+    link->prev = prev_entry->link;
+    link->next = prev_entry->link->next;
+
+    if(prev_entry->link->next != NULL){
+      prev_entry->link->next->prev = link;
+    }
+
+    prev_entry->link->next = link;
+  }else{
+    notation->note = g_list_prepend(notation->note,
+				    note);
+
+    link = notation->note;
+  }
+
+  entry->link = link;
+
+  g_hash_table_insert(notation->note_tree_iter,
+		      note,
+		      iter);
+
+  ags_notation_invalidate_note_store(notation);
+
+  if(x1 > x0 &&
+     x1 - x0 > notation->note_tree_max_length){
+    notation->note_tree_max_length = x1 - x0;
+  }
+}
+
+gboolean
+ags_notation_tree_remove(AgsNotation *notation,
+			 AgsNote *note)
+{
+  AgsNotationTreeEntry *entry;
+
+  GSequenceIter *iter;
+
+  iter = g_hash_table_lookup(notation->note_tree_iter,
+			     note);
+
+  if(iter == NULL){
+    return(FALSE);
+  }
+
+  entry = AGS_NOTATION_TREE_ENTRY(g_sequence_get(iter));
+
+  notation->note = g_list_delete_link(notation->note,
+				      entry->link);
+
+  g_hash_table_remove(notation->note_tree_iter,
+		      note);
+  g_sequence_remove(iter);
+
+  ags_notation_invalidate_note_store(notation);
+
+  return(TRUE);
+}
+
+void
+ags_notation_tree_rebuild(AgsNotation *notation)
+{
+  AgsNotationTreeEntry *entry;
+
+  GList *link;
+
+  guint x0, x1;
+  guint y;
+  
+  g_hash_table_remove_all(notation->note_tree_iter);
+  g_sequence_remove_range(g_sequence_get_begin_iter(notation->note_tree),
+			  g_sequence_get_end_iter(notation->note_tree));
+
+  ags_notation_invalidate_note_store(notation);
+
+  notation->note = g_list_sort(notation->note,
+			       (GCompareFunc) ags_note_sort_func);
+
+  link = notation->note;
+
+  while(link != NULL){
+    g_object_get(link->data,
+		 "x0", &x0,
+		 "x1", &x1,
+		 "y", &y,
+		 NULL);
+
+    entry = (AgsNotationTreeEntry *) g_new0(AgsNotationTreeEntry,
+					    1);
+
+    entry->x0 = x0;
+    entry->y = y;
+    entry->link = link;
+
+    g_hash_table_insert(notation->note_tree_iter,
+			link->data,
+			g_sequence_append(notation->note_tree,
+					  entry));
+
+    if(x1 > x0 &&
+       x1 - x0 > notation->note_tree_max_length){
+      notation->note_tree_max_length = x1 - x0;
+    }
+
+    link = link->next;
+  }
+}
+
+void
+ags_notation_invalidate_note_store(AgsNotation *notation)
+{
+  AgsNotationNoteStore *note_store;
+
+  note_store = notation->note_store;
+  notation->note_store = NULL;
+  
+  ags_notation_note_store_unref(note_store);
+}
+
 /**
  * ags_notation_get_obj_mutex:
  * @notation: the #AgsNotation
@@ -1153,6 +1408,8 @@ ags_notation_set_note(AgsNotation *notation, GList *note)
 
   start_note = notation->note;
   notation->note = note;
+
+  ags_notation_tree_rebuild(notation);
   
   g_rec_mutex_unlock(notation_mutex);
 
@@ -1271,9 +1528,13 @@ ags_notation_add_note(AgsNotation *notation,
     ags_note_set_flags(note,
 		       AGS_NOTE_IS_SELECTED);
   }else{
-    notation->note = g_list_insert_sorted(notation->note,
-					  note,
-					  (GCompareFunc) ags_note_sort_func);
+    if(!g_hash_table_contains(notation->note_tree_iter,
+			      note)){
+      ags_notation_tree_insert(notation,
+			       note);
+    }else{
+      g_object_unref(note);
+    }
   }
 
   g_rec_mutex_unlock(notation_mutex);
@@ -1308,10 +1569,8 @@ ags_notation_remove_note(AgsNotation *notation,
   g_rec_mutex_lock(notation_mutex);
   
   if(!use_selection_list){
-    if(g_list_find(notation->note,
-		   note) != NULL){
-      notation->note = g_list_remove(notation->note,
-				     note);
+    if(ags_notation_tree_remove(notation,
+				note)){
       g_object_unref(note);
     }
   }else{
@@ -1342,11 +1601,11 @@ gboolean
 ags_notation_remove_note_at_position(AgsNotation *notation,
 				     guint x, guint y)
 {
+  AgsNotationTreeEntry *entry;
   AgsNote *note;
   
-  GList *start_list, *list;
+  GSequenceIter *iter;
 
-  guint current_x0, current_y;
   gboolean retval;
 
   GRecMutex *notation_mutex;
@@ -1361,52 +1620,33 @@ ags_notation_remove_note_at_position(AgsNotation *notation,
   /* find note */
   g_rec_mutex_lock(notation_mutex);
 
-  list =
-    start_list = g_list_copy_deep(notation->note,
-				  (GCopyFunc) g_object_ref,
-				  NULL);
-  
-  g_rec_mutex_unlock(notation_mutex);
+  iter = ags_notation_tree_lower_bound(notation,
+				       x, y);
 
   note = NULL;
-
-  retval = FALSE;
   
-  while(list != NULL){
-    g_object_get(list->data,
-		 "x0", &current_x0,
-		 "y", &current_y,
-		 NULL);
+  retval = FALSE;
+
+  if(!g_sequence_iter_is_end(iter)){
+    entry = AGS_NOTATION_TREE_ENTRY(g_sequence_get(iter));
 
-    if(current_x0 == x &&
-       current_y == y){
-      note = list->data;
+    if(entry->x0 == x &&
+       entry->y == y){
+      note = entry->link->data;
       
       retval = TRUE;
-      
-      break;
-    }
-
-    if(current_x0 > x){
-      break;
     }
-    
-    list = list->next;
   }
 
   /* delete link and unref */
   if(retval){
-    g_rec_mutex_lock(notation_mutex);
+    ags_notation_tree_remove(notation,
+			     note);
     
-    notation->note = g_list_remove(notation->note,
-				   note);
     g_object_unref(note);
-
-    g_rec_mutex_unlock(notation_mutex);
   }
 
-  g_list_free_full(start_list,
-		   g_object_unref);
+  g_rec_mutex_unlock(notation_mutex);
 
   return(retval);
 }
@@ -1528,12 +1768,15 @@ ags_notation_find_point(AgsNotation *notation,
 			guint x, guint y,
 			gboolean use_selection_list)
 {
+  AgsNotationTreeEntry *entry;
   AgsNote *retval;
   
+  GSequenceIter *iter;
   GList *note;
 
   guint current_x0, current_x1, current_y;
-
+  guint max_length;
+  
   GRecMutex *notation_mutex;
 
   if(!AGS_IS_NOTATION(notation)){
@@ -1546,36 +1789,81 @@ ags_notation_find_point(AgsNotation *notation,
   /* find note */
   g_rec_mutex_lock(notation_mutex);
 
+  retval = NULL;
+
   if(use_selection_list){
     note = notation->selection;
-  }else{
-    note = notation->note;
-  }
-
-  retval = NULL;
   
-  while(note != NULL){
-    g_object_get(note->data,
-		 "x0", &current_x0,
-		 "x1", &current_x1,
-		 "y", &current_y,
-		 NULL);
+    while(note != NULL){
+      g_object_get(note->data,
+		   "x0", &current_x0,
+		   "x1", &current_x1,
+		   "y", &current_y,
+		   NULL);
     
-    if(current_x0 > x){
-      break;
-    }
+      if(current_x0 > x){
+	break;
+      }
 
-    if(x >= current_x0 &&
-       x < current_x1 &&
-       current_y == y){
-      retval = note->data;
+      if(x >= current_x0 &&
+	 x < current_x1 &&
+	 current_y == y){
+	retval = note->data;
 
-      break;
+	break;
+      }
+    
+      note = note->next;
+    }
+  }else{
+    /* notes starting within maximum note length before x */
+    max_length = (guint) (notation->maximum_note_length / AGS_NOTATION_MINIMUM_NOTE_LENGTH);
+
+    if(notation->note_tree_max_length > max_length){
+      max_length = notation->note_tree_max_length;
     }
+
+    iter = ags_notation_tree_lower_bound(notation,
+					 ((x > max_length) ? x - max_length: 0), y);
     
-    note = note->next;
-  }
+    while(!g_sequence_iter_is_end(iter)){
+      entry = AGS_NOTATION_TREE_ENTRY(g_sequence_get(iter));
 
+      if(entry->x0 > x){
+	break;
+      }
+
+      if(entry->y < y){
+	iter = ags_notation_tree_lower_bound(notation,
+					     entry->x0, y);
+	
+	continue;
+      }
+
+      if(entry->y > y){
+	/* skip to next x0 */
+	iter = ags_notation_tree_lower_bound(notation,
+					     entry->x0 + 1, y);
+
+	continue;
+      }
+      
+      g_object_get(entry->link->data,
+		   "x0", &current_x0,
+		   "x1", &current_x1,
+		   NULL);
+
+      if(x >= current_x0 &&
+	 x < current_x1){
+	retval = entry->link->data;
+
+	break;
+      }
+
+      iter = g_sequence_iter_next(iter);
+    }
+  }
+  
   g_rec_mutex_unlock(notation_mutex);
 
   return(retval);
@@ -1602,6 +1890,9 @@ ags_notation_find_region(AgsNotation *notation,
 			 guint x1, guint y1,
 			 gboolean use_selection_list)
 {
+  AgsNotationTreeEntry *entry;
+
+  GSequenceIter *iter;
   GList *note;
   GList *region;
 
@@ -1621,7 +1912,7 @@ ags_notation_find_region(AgsNotation *notation,
 
     tmp = x1;
     x1 = x0;
-    x0 = x1;
+    x0 = tmp;
   }
 
   if(y0 > y1){
@@ -1635,44 +1926,62 @@ ags_notation_find_region(AgsNotation *notation,
   /* find note */
   g_rec_mutex_lock(notation_mutex);
 
+  region = NULL;
+
   if(use_selection_list){
     note = notation->selection;
-  }else{
-    note = notation->note;
-  }
 
-  while(note != NULL){
-    g_object_get(note->data,
-		 "x0", &current_x0,
-		 NULL);
-    
-    if(current_x0 >= x0){
-      break;
-    }
-    
-    note = note->next;
-  }
+    while(note != NULL){
+      g_object_get(note->data,
+		   "x0", &current_x0,
+		   "y", &current_y,
+		   NULL);
 
-  region = NULL;
+      if(current_x0 > x1){
+	break;
+      }
 
-  while(note != NULL){
-    g_object_get(note->data,
-		 "x0", &current_x0,
-		 "y", &current_y,
-		 NULL);
+      if(current_x0 >= x0 &&
+	 current_y >= y0 && current_y < y1){
+	region = g_list_prepend(region,
+				note->data);
+      }
 
-    if(current_x0 > x1){
-      break;
+      note = note->next;
     }
+  }else{
+    iter = ags_notation_tree_lower_bound(notation,
+					 x0, y0);
+  
+    while(!g_sequence_iter_is_end(iter)){
+      entry = AGS_NOTATION_TREE_ENTRY(g_sequence_get(iter));
+
+      if(entry->x0 > x1){
+	break;
+      }
+
+      if(entry->y < y0){
+	iter = ags_notation_tree_lower_bound(notation,
+					     entry->x0, y0);
+
+	continue;
+      }
+      
+      if(entry->y >= y1){
+	/* skip to next x0 */
+	iter = ags_notation_tree_lower_bound(notation,
+					     entry->x0 + 1, y0);
+
+	continue;
+      }
 
-    if(current_y >= y0 && current_y < y1){
       region = g_list_prepend(region,
-			      note->data);
-    }
+			      entry->link->data);
 
-    note = note->next;
+      iter = g_sequence_iter_next(iter);
+    }
   }
-
+  
   g_rec_mutex_unlock(notation_mutex);
 
   region = g_list_reverse(region);
@@ -1697,14 +2006,13 @@ ags_notation_find_offset(AgsNotation *notation,
 			 guint x,
 			 gboolean use_selection_list)
 {
+  AgsNotationTreeEntry *entry;
+
+  GSequenceIter *iter;
   GList *retval;
   GList *note;
-  GList *next, *prev;
-  GList *current_start, *current_end, *current;
 
-  guint current_start_x, current_end_x, current_x;
-  guint length, position;
-  gboolean success;
+  guint current_x;
 
   GRecMutex *notation_mutex;
 
@@ -1718,152 +2026,210 @@ ags_notation_find_offset(AgsNotation *notation,
   /* find note */
   g_rec_mutex_lock(notation_mutex);
 
+  retval = NULL;
+
   if(use_selection_list){
     note = notation->selection;
+
+    while(note != NULL){
+      g_object_get(note->data,
+		   "x0", &current_x,
+		   NULL);
+
+      if(current_x > x){
+	break;
+      }
+
+      if(current_x == x){
+	retval = g_list_prepend(retval,
+				note->data);
+	g_object_ref(note->data);
+      }
+      
+      note = note->next;
+    }
   }else{
-    note = notation->note;
-  }
+    iter = ags_notation_tree_lower_bound(notation,
+					 x, 0);
   
-  current_start = note;
-  current_end = g_list_last(note);
-  
-  length = g_list_length(note);
-  position = (length - 1) / 2;
+    while(!g_sequence_iter_is_end(iter)){
+      entry = AGS_NOTATION_TREE_ENTRY(g_sequence_get(iter));
 
-  current = g_list_nth(current_start,
-		       position);
-  
-  retval = NULL;
-  success = FALSE;
-  
-  while(!success && current != NULL){
-    g_object_get(current_start->data,
-		 "x0", &current_start_x,
-		 NULL);
+      if(entry->x0 != x){
+	break;
+      }
 
-    if(current_start_x > x){
-      break;
-    }
-    
-    if(current_start_x == x){
       retval = g_list_prepend(retval,
-			      current_start->data);
-      g_object_ref(current_start->data);
+			      entry->link->data);
+      g_object_ref(entry->link->data);
       
-      break;
+      iter = g_sequence_iter_next(iter);
     }
-    
-    g_object_get(current_end->data,
-		 "x0", &current_end_x,
-		 NULL);
+  }
 
-    if(current_end_x < x){
-      break;
-    }
+  g_rec_mutex_unlock(notation_mutex);
 
-    if(current_end_x == x){
-      retval = g_list_prepend(retval,
-			      current_end->data);
-      g_object_ref(current_end->data);
+  retval = g_list_reverse(retval);
+  
+  return(retval);
+}
 
-      break;
-    }
+/**
+ * ags_notation_get_note_store:
+ * @notation: the #AgsNotation
+ *
+ * Get the x0 and y of the notes of @notation as struct of arrays sorted by x0
+ * and y. The store is created on demand and shared until notes are added to or
+ * removed from @notation, the returned store is never modified. Properties
+ * that change in place, like x1, have to be read from the note.
+ *
+ * Returns: (transfer full): the #AgsNotationNoteStore, unref with ags_notation_note_store_unref()
+ *
+ * Since: 3.7.0
+ */
+AgsNotationNoteStore*
+ags_notation_get_note_store(AgsNotation *notation)
+{
+  AgsNotationNoteStore *note_store;
+  AgsNotationTreeEntry *entry;
+  
+  GSequenceIter *iter;
 
-    g_object_get(current->data,
-		 "x0", &current_x,
-		 NULL);
+  guint length;
+  guint i;
+  
+  GRecMutex *notation_mutex;
+
+  if(!AGS_IS_NOTATION(notation)){
+    return(NULL);
+  }
+
+  /* get notation mutex */
+  notation_mutex = AGS_NOTATION_GET_OBJ_MUTEX(notation);
+
+  g_rec_mutex_lock(notation_mutex);
+
+  if(notation->note_store == NULL){
+    length = g_sequence_get_length(notation->note_tree);
+
+    /* one allocation for all arrays */
+    note_store = (AgsNotationNoteStore *) g_malloc(sizeof(AgsNotationNoteStore) +
+						   length * (2 * sizeof(guint) + sizeof(AgsNote *)));
+
+    note_store->ref_count = 1;
     
-    if(current_x == x){
-      retval = g_list_prepend(retval,
-			      current->data);
-      g_object_ref(current->data);
+    note_store->length = length;
+
+    note_store->note = (AgsNote **) (note_store + 1);
+    note_store->x0 = (guint *) (note_store->note + length);
+    note_store->y = note_store->x0 + length;
+
+    iter = g_sequence_get_begin_iter(notation->note_tree);
+    
+    for(i = 0; i < length; i++){
+      entry = AGS_NOTATION_TREE_ENTRY(g_sequence_get(iter));
+
+      note_store->note[i] = (AgsNote *) g_object_ref(entry->link->data);
+
+      note_store->x0[i] = entry->x0;
+      note_store->y[i] = entry->y;
       
-      break;
+      iter = g_sequence_iter_next(iter);
     }
 
-    if(length <= 3){
-      break;
-    }
+    notation->note_store = note_store;
+  }
 
-    if(current_x < x){
-      current_start = current->next;
-      current_end = current_end->prev;
-    }else if(current_x > x){
-      current_start = current_start->next;
-      current_end = current->prev;
-    }else{
-      current_start = current_start->next;
-      //NOTE:JK: we want progression
-      //current_end = current_end->prev;
-    }
+  note_store = ags_notation_note_store_ref(notation->note_store);
+  
+  g_rec_mutex_unlock(notation_mutex);
 
-    length = g_list_position(current_start,
-			     current_end) + 1;
-    position = (length - 1) / 2;
+  return(note_store);
+}
 
-    current = g_list_nth(current_start,
-			 position);
+/**
+ * ags_notation_note_store_ref:
+ * @note_store: the #AgsNotationNoteStore
+ *
+ * Increase reference count of @note_store.
+ *
+ * Returns: (transfer full): @note_store
+ *
+ * Since: 3.7.0
+ */
+AgsNotationNoteStore*
+ags_notation_note_store_ref(AgsNotationNoteStore *note_store)
+{
+  if(note_store == NULL){
+    return(NULL);
   }
 
-  if(retval != NULL){
-    next = NULL;
-    prev = NULL;
-    
-    if(current_start->data == retval->data){
-      next = current_start->next;
-      prev = current_start->prev;
-    }else if(current_end->data == retval->data){
-      next = current_end->next;
-      prev = current_end->prev;
-    }else if(current->data == retval->data){
-      next = current->next;
-      prev = current->prev;
-    }
+  g_atomic_int_inc(&(note_store->ref_count));
+
+  return(note_store);
+}
 
-    /* check next */
-    current = next;
+/**
+ * ags_notation_note_store_unref:
+ * @note_store: the #AgsNotationNoteStore
+ *
+ * Decrease reference count of @note_store and free it if the count drops to 0.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_notation_note_store_unref(AgsNotationNoteStore *note_store)
+{
+  guint i;
+  
+  if(note_store == NULL){
+    return;
+  }
 
-    while(current != NULL){
-      g_object_get(current->data,
-		   "x0", &current_x,
-		   NULL);
-    
-      if(current_x == x){
-	retval = g_list_prepend(retval,
-				current->data);
-	g_object_ref(current->data);
-      }else{
-	break;
-      }
-	
-      current = current->next;
+  if(g_atomic_int_dec_and_test(&(note_store->ref_count))){
+    for(i = 0; i < note_store->length; i++){
+      g_object_unref(note_store->note[i]);
     }
+    
+    g_free(note_store);
+  }
+}
 
-    retval = g_list_reverse(retval);
+/**
+ * ags_notation_note_store_lower_bound:
+ * @note_store: the #AgsNotationNoteStore
+ * @x: the offset
+ *
+ * Binary search the first note of @note_store with x0 not less than @x.
+ *
+ * Returns: the index of the note or the length of @note_store if not found
+ *
+ * Since: 3.7.0
+ */
+guint
+ags_notation_note_store_lower_bound(AgsNotationNoteStore *note_store,
+				    guint x)
+{
+  guint lower, upper, middle;
 
-    /* check prev */
-    current = prev;
+  if(note_store == NULL){
+    return(0);
+  }
 
-    while(current != NULL){
-      g_object_get(current->data,
-		   "x0", &current_x,
-		   NULL);
-    
-      if(current_x == x){
-	retval = g_list_prepend(retval,
-				current->data);
-	g_object_ref(current->data);
-      }else{
-	break;
-      }
-	
-      current = current->prev;
+  lower = 0;
+  upper = note_store->length;
+
+  while(lower < upper){
+    middle = lower + (upper - lower) / 2;
+
+    if(note_store->x0[middle] < x){
+      lower = middle + 1;
+    }else{
+      upper = middle;
     }
   }
 
-  g_rec_mutex_unlock(notation_mutex);
-  
-  return(retval);
+  return(lower);
 }
 
 /**
@@ -2354,9 +2720,10 @@ ags_notation_cut_selection(AgsNotation *notation)
   selection = notation->selection;
 
   while(selection != NULL){
-    notation->note = g_list_remove(notation->note,
-				   selection->data);
-    g_object_unref(selection->data);
+    if(ags_notation_tree_remove(notation,
+				selection->data)){
+      g_object_unref(selection->data);
+    }
 
     selection = selection->next;
   }
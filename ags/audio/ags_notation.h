@@ -57,8 +57,15 @@ G_BEGIN_DECLS
 #define AGS_NOTATION_CLIPBOARD_TYPE "AgsNotationClipboardXml"
 #define AGS_NOTATION_CLIPBOARD_FORMAT "AgsNotationNativePiano"
 
+#define AGS_TYPE_NOTATION_NOTE_STORE         (ags_notation_note_store_get_type())
+
+#define AGS_NOTATION_TREE_ENTRY(ptr) ((AgsNotationTreeEntry *)(ptr))
+#define AGS_NOTATION_NOTE_STORE(ptr) ((AgsNotationNoteStore *)(ptr))
+
 typedef struct _AgsNotation AgsNotation;
 typedef struct _AgsNotationClass AgsNotationClass;
+typedef struct _AgsNotationTreeEntry AgsNotationTreeEntry;
+typedef struct _AgsNotationNoteStore AgsNotationNoteStore;
 
 /**
  * AgsNotationFlags:
@@ -94,6 +101,12 @@ struct _AgsNotation
 
   GList *note;
   GList *selection;
+
+  GSequence *note_tree;
+  GHashTable *note_tree_iter;
+  guint note_tree_max_length;
+
+  AgsNotationNoteStore *note_store;
 };
 
 struct _AgsNotationClass
@@ -101,7 +114,49 @@ struct _AgsNotationClass
   GObjectClass gobject;
 };
 
+/**
+ * AgsNotationTreeEntry:
+ * @x0: the note's x0 at insert time
+ * @y: the note's y at insert time
+ * @link: the #GList-struct of #AgsNotation:note containing the note, %NULL for search keys
+ *
+ * The sort key of a note stored in the note tree of #AgsNotation.
+ */
+struct _AgsNotationTreeEntry
+{
+  guint x0;
+  guint y;
+  
+  GList *link;
+};
+
+/**
+ * AgsNotationNoteStore:
+ * @ref_count: the reference count
+ * @length: the count of notes
+ * @x0: the x0 of the notes
+ * @y: the y of the notes
+ * @note: the #AgsNote of the notes
+ *
+ * Read-only index of the notes of #AgsNotation as struct of arrays sorted
+ * by x0 and y. The arrays can be scanned without locking or referencing the notes.
+ * The notes remain the storage of everything else, x1 in particular grows in
+ * place while recording, so read it from the note.
+ */
+struct _AgsNotationNoteStore
+{
+  volatile gint ref_count;
+
+  guint length;
+  
+  guint *x0;
+  guint *y;
+
+  AgsNote **note;
+};
+
 GType ags_notation_get_type();
+GType ags_notation_note_store_get_type();
 
 GRecMutex* ags_notation_get_obj_mutex(AgsNotation *notation);
 
@@ -166,6 +221,14 @@ GList* ags_notation_find_offset(AgsNotation *notation,
 				guint x,
 				gboolean use_selection_list);
 
+AgsNotationNoteStore* ags_notation_get_note_store(AgsNotation *notation);
+
+AgsNotationNoteStore* ags_notation_note_store_ref(AgsNotationNoteStore *note_store);
+void ags_notation_note_store_unref(AgsNotationNoteStore *note_store);
+
+guint ags_notation_note_store_lower_bound(AgsNotationNoteStore *note_store,
+					  guint x);
+
 void ags_notation_free_selection(AgsNotation *notation);
 
 void ags_notation_add_point_to_selection(AgsNotation *notation,
@@ -226,6 +226,12 @@ ags_playback_domain_init(AgsPlaybackDomain *playback_domain)
   /* playback */
   playback_domain->output_playback = NULL;
   playback_domain->input_playback = NULL;
+
+  /* published to the audio thread */
+  playback_domain->epoch_reclaimer = ags_epoch_reclaimer_alloc();
+
+  playback_domain->output_playback_array = NULL;
+  playback_domain->input_playback_array = NULL;
 }
 
 void
@@ -399,6 +405,18 @@ ags_playback_domain_dispose(GObject *gobject)
     
     playback_domain->input_playback = NULL;
   }
+
+  if(playback_domain->output_playback_array != NULL){
+    ags_epoch_array_publish(&(playback_domain->output_playback_array),
+			    NULL,
+			    playback_domain->epoch_reclaimer);
+  }
+
+  if(playback_domain->input_playback_array != NULL){
+    ags_epoch_array_publish(&(playback_domain->input_playback_array),
+			    NULL,
+			    playback_domain->epoch_reclaimer);
+  }
   
   /* call parent */
   G_OBJECT_CLASS(ags_playback_domain_parent_class)->dispose(gobject);
@@ -438,6 +456,12 @@ ags_playback_domain_finalize(GObject *gobject)
   g_list_free_full(playback_domain->input_playback,
 		   g_object_unref);
 
+  /* published arrays */
+  ags_epoch_array_free(playback_domain->output_playback_array);
+  ags_epoch_array_free(playback_domain->input_playback_array);
+
+  ags_epoch_reclaimer_free(playback_domain->epoch_reclaimer);
+
   /* call parent */
   G_OBJECT_CLASS(ags_playback_domain_parent_class)->finalize(gobject);
 }
@@ -658,6 +682,10 @@ ags_playback_domain_add_playback(AgsPlaybackDomain *playback_domain,
       g_object_ref(playback);
       playback_domain->output_playback = g_list_append(playback_domain->output_playback,
 						       playback);
+
+      ags_epoch_array_publish(&(playback_domain->output_playback_array),
+			      playback_domain->output_playback,
+			      playback_domain->epoch_reclaimer);
     }      
   }else if(g_type_is_a(channel_type,
 		       AGS_TYPE_INPUT)){
@@ -666,6 +694,10 @@ ags_playback_domain_add_playback(AgsPlaybackDomain *playback_domain,
       g_object_ref(playback);
       playback_domain->input_playback = g_list_append(playback_domain->input_playback,
 						      playback);
+
+      ags_epoch_array_publish(&(playback_domain->input_playback_array),
+			      playback_domain->input_playback,
+			      playback_domain->epoch_reclaimer);
     }
   }
 
@@ -703,11 +735,21 @@ ags_playback_domain_remove_playback(AgsPlaybackDomain *playback_domain,
 		 AGS_TYPE_OUTPUT)){
     playback_domain->output_playback = g_list_remove(playback_domain->output_playback,
 						     playback);
+
+    ags_epoch_array_publish(&(playback_domain->output_playback_array),
+			    playback_domain->output_playback,
+			    playback_domain->epoch_reclaimer);
+    
     g_object_unref(playback);
   }else if(g_type_is_a(channel_type,
 		       AGS_TYPE_INPUT)){
     playback_domain->input_playback = g_list_remove(playback_domain->input_playback,
 						    playback);
+
+    ags_epoch_array_publish(&(playback_domain->input_playback_array),
+			    playback_domain->input_playback,
+			    playback_domain->epoch_reclaimer);
+    
     g_object_unref(playback);
   }
   
@@ -70,6 +70,11 @@ struct _AgsPlaybackDomain
 
   GList *output_playback;
   GList *input_playback;
+
+  AgsEpochReclaimer *epoch_reclaimer;
+
+  AgsEpochArray *output_playback_array;
+  AgsEpochArray *input_playback_array;
 };
 
 struct _AgsPlaybackDomainClass
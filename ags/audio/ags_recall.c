@@ -104,6 +104,10 @@ AgsRecall* ags_recall_real_duplicate(AgsRecall *reall,
 void ags_recall_child_done(AgsRecall *child,
 			   AgsRecall *parent);
 
+void ags_recall_invoke_run_stage(AgsRecall *recall,
+				 guint stage,
+				 gboolean omit_event);
+
 /**
  * SECTION:ags_recall
  * @short_description: The recall base class
@@ -112,6 +116,9 @@ void ags_recall_child_done(AgsRecall *child,
  * @include: ags/audio/ags_recall.h
  *
  * #AgsRecall acts as effect processor.
+ *
+ * The time spent in run-pre, run-inter and run-post is accounted per
+ * recall, including its children. Retrieve it by ags_recall_get_load().
  */
 
 enum{
@@ -168,6 +175,7 @@ static gboolean ags_recall_global_children_lock_free = FALSE;
 static gboolean ags_recall_global_omit_event = TRUE;
 static gboolean ags_recall_global_performance_mode = FALSE;
 static gboolean ags_recall_global_rt_safe = FALSE;
+static gboolean ags_recall_global_load_accounting = FALSE;
 
 GType
 ags_recall_get_type(void)
@@ -1053,6 +1061,11 @@ ags_recall_init(AgsRecall *recall)
   recall->child_value = NULL;
 
   recall->children = NULL;
+
+  /* load */
+  memset(recall->load_run_count, 0, AGS_RECALL_LOAD_STAGE_COUNT * sizeof(guint64));
+  memset(recall->load_cumulative_time, 0, AGS_RECALL_LOAD_STAGE_COUNT * sizeof(guint64));
+  memset(recall->load_peak_time, 0, AGS_RECALL_LOAD_STAGE_COUNT * sizeof(guint64));
 }
 
 void
@@ -2109,6 +2122,21 @@ ags_recall_global_set_omit_event(gboolean omit_event)
   ags_recall_global_omit_event = omit_event;
 }
 
+/**
+ * ags_recall_global_set_load_accounting:
+ * @load_accounting: %TRUE if account the time spent in run stages, otherwise %FALSE
+ * 
+ * Set global config value load accounting. It is disabled by default, since
+ * it reads the clock twice per recall and stage.
+ * 
+ * Since: 3.7.0
+ */
+void
+ags_recall_global_set_load_accounting(gboolean load_accounting)
+{
+  ags_recall_global_load_accounting = load_accounting;
+}
+
 /**
  * ags_recall_global_get_children_lock_free:
  * 
@@ -2185,6 +2213,25 @@ ags_recall_global_get_rt_safe()
   return(rt_safe);
 }
 
+/**
+ * ags_recall_global_get_load_accounting:
+ * 
+ * Get global config value load accounting.
+ *
+ * Returns: if %TRUE the time spent in run stages is accounted, else not
+ * 
+ * Since: 3.7.0
+ */
+gboolean
+ags_recall_global_get_load_accounting()
+{
+  gboolean load_accounting;
+
+  load_accounting = ags_recall_global_load_accounting;
+  
+  return(load_accounting);
+}
+
 /**
  * ags_recall_get_obj_mutex:
  * @recall: the #AgsRecall
@@ -3057,29 +3104,23 @@ ags_recall_set_staging_flags(AgsRecall *recall, guint staging_flags)
 
     if((AGS_SOUND_STAGING_RUN_PRE & (staging_flags)) != 0 &&
        (AGS_SOUND_STAGING_RUN_PRE & (recall_staging_flags)) == 0){
-      if(omit_event){
-	AGS_RECALL_GET_CLASS(recall)->run_pre(recall);
-      }else{
-	ags_recall_run_pre(recall);
-      }
+      ags_recall_invoke_run_stage(recall,
+				  AGS_RECALL_LOAD_RUN_PRE,
+				  omit_event);
     }
 
     if((AGS_SOUND_STAGING_RUN_INTER & (staging_flags)) != 0 &&
        (AGS_SOUND_STAGING_RUN_INTER & (recall_staging_flags)) == 0){
-      if(omit_event){
-	AGS_RECALL_GET_CLASS(recall)->run_inter(recall);
-      }else{
-	ags_recall_run_inter(recall);
-      }
+      ags_recall_invoke_run_stage(recall,
+				  AGS_RECALL_LOAD_RUN_INTER,
+				  omit_event);
     }
 
     if((AGS_SOUND_STAGING_RUN_POST & (staging_flags)) != 0 &&
        (AGS_SOUND_STAGING_RUN_POST & (recall_staging_flags)) == 0){
-      if(omit_event){
-	AGS_RECALL_GET_CLASS(recall)->run_post(recall);
-      }else{
-	ags_recall_run_post(recall);
-      }
+      ags_recall_invoke_run_stage(recall,
+				  AGS_RECALL_LOAD_RUN_POST,
+				  omit_event);
     }
 
     if((AGS_SOUND_STAGING_DO_FEEDBACK & (staging_flags)) != 0 &&
@@ -5233,11 +5274,9 @@ ags_recall_real_run_pre(AgsRecall *recall)
   while(list != NULL){
     next = list->next;
     
-    if(omit_event){
-      AGS_RECALL_GET_CLASS(AGS_RECALL(list->data))->run_pre(AGS_RECALL(list->data));
-    }else{
-      ags_recall_run_pre(AGS_RECALL(list->data));
-    }    
+    ags_recall_invoke_run_stage(AGS_RECALL(list->data),
+				AGS_RECALL_LOAD_RUN_PRE,
+				omit_event);
 
     list = next;
   }
@@ -5320,11 +5359,9 @@ ags_recall_real_run_inter(AgsRecall *recall)
   while(list != NULL){
     next = list->next;
     
-    if(omit_event){
-      AGS_RECALL_GET_CLASS(AGS_RECALL(list->data))->run_inter(AGS_RECALL(list->data));
-    }else{
-      ags_recall_run_inter(AGS_RECALL(list->data));
-    }    
+    ags_recall_invoke_run_stage(AGS_RECALL(list->data),
+				AGS_RECALL_LOAD_RUN_INTER,
+				omit_event);
 
     list = next;
   }
@@ -5408,11 +5445,9 @@ ags_recall_real_run_post(AgsRecall *recall)
   while(list != NULL){
     next = list->next;
     
-    if(omit_event){
-      AGS_RECALL_GET_CLASS(AGS_RECALL(list->data))->run_post(AGS_RECALL(list->data));
-    }else{
-      ags_recall_run_post(AGS_RECALL(list->data));
-    }    
+    ags_recall_invoke_run_stage(AGS_RECALL(list->data),
+				AGS_RECALL_LOAD_RUN_POST,
+				omit_event);
 
     list = next;
   }
@@ -5605,6 +5640,138 @@ ags_recall_feed_output_queue(AgsRecall *recall)
   g_object_unref(G_OBJECT(recall));
 }
 
+void
+ags_recall_invoke_run_stage(AgsRecall *recall,
+			    guint stage,
+			    gboolean omit_event)
+{
+  gint64 start_time;
+  guint64 duration;
+  gboolean load_accounting;
+
+  load_accounting = ags_recall_global_load_accounting;
+
+  start_time = 0;
+  
+  /* the caller holds a reference of recall */
+  if(load_accounting){
+    start_time = ags_deadline_clock_get_monotonic_time();
+  }
+  
+  switch(stage){
+  case AGS_RECALL_LOAD_RUN_PRE:
+  {
+    if(omit_event){
+      AGS_RECALL_GET_CLASS(recall)->run_pre(recall);
+    }else{
+      ags_recall_run_pre(recall);
+    }
+  }
+  break;
+  case AGS_RECALL_LOAD_RUN_INTER:
+  {
+    if(omit_event){
+      AGS_RECALL_GET_CLASS(recall)->run_inter(recall);
+    }else{
+      ags_recall_run_inter(recall);
+    }
+  }
+  break;
+  case AGS_RECALL_LOAD_RUN_POST:
+  {
+    if(omit_event){
+      AGS_RECALL_GET_CLASS(recall)->run_post(recall);
+    }else{
+      ags_recall_run_post(recall);
+    }
+  }
+  break;
+  }
+
+  if(load_accounting){
+    duration = (guint64) (ags_deadline_clock_get_monotonic_time() - start_time);
+
+    /* only the thread running the recall writes */
+    recall->load_run_count[stage] += 1;
+    recall->load_cumulative_time[stage] += duration;
+
+    if(duration > recall->load_peak_time[stage]){
+      recall->load_peak_time[stage] = duration;
+    }
+  }
+}
+
+/**
+ * ags_recall_get_load:
+ * @recall: the #AgsRecall
+ * @stage: the #AgsRecallLoadStage
+ * @run_count: (out): return location of the run count
+ * @cumulative_time: (out): return location of the cumulative time in nsec
+ * @peak_time: (out): return location of the peak time in nsec
+ * 
+ * Get the time spent by @recall in @stage, including its children.
+ * 
+ * Since: 3.7.0
+ */
+void
+ags_recall_get_load(AgsRecall *recall,
+		    guint stage,
+		    guint64 *run_count, guint64 *cumulative_time, guint64 *peak_time)
+{
+  if(!AGS_IS_RECALL(recall) ||
+     stage >= AGS_RECALL_LOAD_STAGE_COUNT){
+    if(run_count != NULL){
+      run_count[0] = 0;
+    }
+
+    if(cumulative_time != NULL){
+      cumulative_time[0] = 0;
+    }
+
+    if(peak_time != NULL){
+      peak_time[0] = 0;
+    }
+    
+    return;
+  }
+
+  if(run_count != NULL){
+    run_count[0] = recall->load_run_count[stage];
+  }
+
+  if(cumulative_time != NULL){
+    cumulative_time[0] = recall->load_cumulative_time[stage];
+  }
+
+  if(peak_time != NULL){
+    peak_time[0] = recall->load_peak_time[stage];
+  }
+}
+
+/**
+ * ags_recall_reset_load:
+ * @recall: the #AgsRecall
+ * 
+ * Reset the load accounting of @recall.
+ * 
+ * Since: 3.7.0
+ */
+void
+ags_recall_reset_load(AgsRecall *recall)
+{
+  guint i;
+  
+  if(!AGS_IS_RECALL(recall)){
+    return;
+  }
+
+  for(i = 0; i < AGS_RECALL_LOAD_STAGE_COUNT; i++){
+    recall->load_run_count[i] = 0;
+    recall->load_cumulative_time[i] = 0;
+    recall->load_peak_time[i] = 0;
+  }
+}
+
 void
 ags_recall_real_stop_persistent(AgsRecall *recall)
 {
@@ -93,6 +93,22 @@ typedef enum{
   AGS_RECALL_NOTIFY_RECALL,
 }AgsRecallNotifyDependencyMode;
 
+/**
+ * AgsRecallLoadStage:
+ * @AGS_RECALL_LOAD_RUN_PRE: time spent in run-pre
+ * @AGS_RECALL_LOAD_RUN_INTER: time spent in run-inter
+ * @AGS_RECALL_LOAD_RUN_POST: time spent in run-post
+ * @AGS_RECALL_LOAD_STAGE_COUNT: the stage count
+ * 
+ * Stages of load accounting.
+ */
+typedef enum{
+  AGS_RECALL_LOAD_RUN_PRE,
+  AGS_RECALL_LOAD_RUN_INTER,
+  AGS_RECALL_LOAD_RUN_POST,
+  AGS_RECALL_LOAD_STAGE_COUNT,
+}AgsRecallLoadStage;
+
 struct _AgsRecall
 {
   GObject gobject;
@@ -155,6 +171,10 @@ struct _AgsRecall
   GValue *child_value;
 
   GList *children;  
+
+  guint64 load_run_count[AGS_RECALL_LOAD_STAGE_COUNT];
+  guint64 load_cumulative_time[AGS_RECALL_LOAD_STAGE_COUNT];
+  guint64 load_peak_time[AGS_RECALL_LOAD_STAGE_COUNT];
 };
 
 struct _AgsRecallClass
@@ -209,11 +229,13 @@ struct _AgsRecallHandler
 GType ags_recall_get_type();
 
 void ags_recall_global_set_omit_event(gboolean omit_event);
+void ags_recall_global_set_load_accounting(gboolean load_accounting);
 
 gboolean ags_recall_global_get_children_lock_free();
 gboolean ags_recall_global_get_omit_event();
 gboolean ags_recall_global_get_performance_mode();
 gboolean ags_recall_global_get_rt_safe();
+gboolean ags_recall_global_get_load_accounting();
 
 GRecMutex* ags_recall_get_obj_mutex(AgsRecall *recall);
 
@@ -344,6 +366,11 @@ void ags_recall_run_post(AgsRecall *recall);
 void ags_recall_do_feedback(AgsRecall *recall);
 void ags_recall_feed_output_queue(AgsRecall *recall);
 
+void ags_recall_get_load(AgsRecall *recall,
+			 guint stage,
+			 guint64 *run_count, guint64 *cumulative_time, guint64 *peak_time);
+void ags_recall_reset_load(AgsRecall *recall);
+
 void ags_recall_stop_persistent(AgsRecall *recall);
 void ags_recall_cancel(AgsRecall *recall);
 void ags_recall_done(AgsRecall *recall);
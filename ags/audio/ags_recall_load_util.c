@@ -0,0 +1,326 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ags/audio/ags_recall_load_util.h>
+
+#include <ags/audio/ags_audio.h>
+#include <ags/audio/ags_channel.h>
+#include <ags/audio/ags_recall.h>
+
+#include <stdio.h>
+
+void ags_recall_load_util_append_recall(GString *report,
+					gchar *audio_name, gchar *channel_name, gchar *line,
+					GList *start_recall);
+void ags_recall_load_util_reset_recall(GList *start_recall);
+
+/**
+ * SECTION:ags_recall_load_util
+ * @short_description: recall load report
+ * @title: AgsRecallLoadUtil
+ * @section_id:
+ * @include: ags/audio/ags_recall_load_util.h
+ *
+ * Collect the load accounted by #AgsRecall of all recalls of a list of
+ * #AgsAudio. Every row of the report names the audio, the channel and
+ * line, the recall's type and the stage followed by run count, cumulative
+ * and peak time in nsec. Fields are separated by tabs. Recalls that never
+ * ran are omitted. The time of a recall is inclusive, it contains the time
+ * of its children, so don't sum up the rows of a recall and its children.
+ *
+ * Time is only accounted if enabled by ags_recall_global_set_load_accounting().
+ */
+
+static const gchar *ags_recall_load_util_stage_name[] = {
+  "run-pre",
+  "run-inter",
+  "run-post",
+};
+
+void
+ags_recall_load_util_append_recall(GString *report,
+				   gchar *audio_name, gchar *channel_name, gchar *line,
+				   GList *start_recall)
+{
+  GList *recall;
+  GList *start_children;
+
+  guint64 run_count, cumulative_time, peak_time;
+  guint i;
+  
+  recall = start_recall;
+
+  while(recall != NULL){
+    for(i = 0; i < AGS_RECALL_LOAD_STAGE_COUNT; i++){
+      ags_recall_get_load(recall->data,
+			  i,
+			  &run_count, &cumulative_time, &peak_time);
+
+      if(run_count == 0){
+	continue;
+      }
+
+      g_string_append_printf(report,
+			     "%s\t%s\t%s\t%s\t%s\t%" G_GUINT64_FORMAT "\t%" G_GUINT64_FORMAT "\t%" G_GUINT64_FORMAT "\n",
+			     audio_name, channel_name, line,
+			     G_OBJECT_TYPE_NAME(recall->data),
+			     ags_recall_load_util_stage_name[i],
+			     run_count, cumulative_time, peak_time);
+    }
+
+    /* children */
+    start_children = ags_recall_get_children(recall->data);
+
+    ags_recall_load_util_append_recall(report,
+				       audio_name, channel_name, line,
+				       start_children);
+
+    g_list_free_full(start_children,
+		     g_object_unref);
+    
+    recall = recall->next;
+  }
+}
+
+/**
+ * ags_recall_load_util_get_report:
+ * @start_audio: (element-type AgsAudio.Audio): the #GList-struct containing #AgsAudio
+ *
+ * Get the load report of all recalls of @start_audio, their channels and
+ * children.
+ *
+ * Returns: (transfer full): the report as string
+ *
+ * Since: 3.7.0
+ */
+gchar*
+ags_recall_load_util_get_report(GList *start_audio)
+{
+  AgsChannel *channel, *next_channel;
+  
+  GString *report;
+
+  GList *audio;
+  GList *start_play, *start_recall;
+
+  gchar *audio_name;
+  gchar *line;
+
+  guint i;
+  
+  report = g_string_new(AGS_RECALL_LOAD_UTIL_REPORT_HEADER);
+
+  audio = start_audio;
+
+  while(audio != NULL){
+    audio_name = ags_audio_get_audio_name(audio->data);
+
+    if(audio_name == NULL){
+      audio_name = g_strdup(G_OBJECT_TYPE_NAME(audio->data));
+    }
+    
+    /* audio */
+    start_play = ags_audio_get_play(audio->data);
+    start_recall = ags_audio_get_recall(audio->data);
+
+    ags_recall_load_util_append_recall(report,
+				       audio_name, "-", "-",
+				       start_play);
+    ags_recall_load_util_append_recall(report,
+				       audio_name, "-", "-",
+				       start_recall);
+
+    g_list_free_full(start_play,
+		     g_object_unref);
+    g_list_free_full(start_recall,
+		     g_object_unref);
+    
+    /* output and input */
+    for(i = 0; i < 2; i++){
+      if(i == 0){
+	channel = ags_audio_get_output(audio->data);
+      }else{
+	channel = ags_audio_get_input(audio->data);
+      }
+      
+      while(channel != NULL){
+	line = g_strdup_printf("%u",
+			       ags_channel_get_line(channel));
+
+	start_play = ags_channel_get_play(channel);
+	start_recall = ags_channel_get_recall(channel);
+
+	ags_recall_load_util_append_recall(report,
+					   audio_name, ((i == 0) ? "output": "input"), line,
+					   start_play);
+	ags_recall_load_util_append_recall(report,
+					   audio_name, ((i == 0) ? "output": "input"), line,
+					   start_recall);
+
+	g_list_free_full(start_play,
+			 g_object_unref);
+	g_list_free_full(start_recall,
+			 g_object_unref);
+
+	g_free(line);
+	
+	/* iterate */
+	next_channel = ags_channel_next(channel);
+
+	g_object_unref(channel);
+
+	channel = next_channel;
+      }
+    }
+
+    g_free(audio_name);
+    
+    audio = audio->next;
+  }
+
+  return(g_string_free(report, FALSE));
+}
+
+/**
+ * ags_recall_load_util_dump_report:
+ * @start_audio: (element-type AgsAudio.Audio): the #GList-struct containing #AgsAudio
+ * @filename: the filename to write to or "-" for stdout
+ *
+ * Write the load report of @start_audio to @filename.
+ *
+ * Returns: %TRUE on success, otherwise %FALSE
+ *
+ * Since: 3.7.0
+ */
+gboolean
+ags_recall_load_util_dump_report(GList *start_audio,
+				 gchar *filename)
+{
+  gchar *report;
+
+  gboolean success;
+  
+  if(filename == NULL){
+    return(FALSE);
+  }
+  
+  report = ags_recall_load_util_get_report(start_audio);
+
+  if(!g_strcmp0(filename, "-")){
+    fputs(report, stdout);
+    fflush(stdout);
+    
+    success = TRUE;
+  }else{
+    success = g_file_set_contents(filename,
+				  report, -1,
+				  NULL);
+  }
+
+  g_free(report);
+
+  return(success);
+}
+
+void
+ags_recall_load_util_reset_recall(GList *start_recall)
+{
+  GList *recall;
+  GList *start_children;
+
+  recall = start_recall;
+
+  while(recall != NULL){
+    ags_recall_reset_load(recall->data);
+
+    start_children = ags_recall_get_children(recall->data);
+
+    ags_recall_load_util_reset_recall(start_children);
+
+    g_list_free_full(start_children,
+		     g_object_unref);
+    
+    recall = recall->next;
+  }
+}
+
+/**
+ * ags_recall_load_util_reset:
+ * @start_audio: (element-type AgsAudio.Audio): the #GList-struct containing #AgsAudio
+ *
+ * Reset the load accounting of all recalls of @start_audio, their
+ * channels and children.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_recall_load_util_reset(GList *start_audio)
+{
+  AgsChannel *channel, *next_channel;
+  
+  GList *audio;
+  GList *start_play, *start_recall;
+
+  guint i;
+
+  audio = start_audio;
+
+  while(audio != NULL){
+    start_play = ags_audio_get_play(audio->data);
+    start_recall = ags_audio_get_recall(audio->data);
+
+    ags_recall_load_util_reset_recall(start_play);
+    ags_recall_load_util_reset_recall(start_recall);
+
+    g_list_free_full(start_play,
+		     g_object_unref);
+    g_list_free_full(start_recall,
+		     g_object_unref);
+
+    for(i = 0; i < 2; i++){
+      if(i == 0){
+	channel = ags_audio_get_output(audio->data);
+      }else{
+	channel = ags_audio_get_input(audio->data);
+      }
+      
+      while(channel != NULL){
+	start_play = ags_channel_get_play(channel);
+	start_recall = ags_channel_get_recall(channel);
+
+	ags_recall_load_util_reset_recall(start_play);
+	ags_recall_load_util_reset_recall(start_recall);
+
+	g_list_free_full(start_play,
+			 g_object_unref);
+	g_list_free_full(start_recall,
+			 g_object_unref);
+
+	/* iterate */
+	next_channel = ags_channel_next(channel);
+
+	g_object_unref(channel);
+
+	channel = next_channel;
+      }
+    }
+
+    audio = audio->next;
+  }
+}
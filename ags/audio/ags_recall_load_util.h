@@ -0,0 +1,38 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __AGS_RECALL_LOAD_UTIL_H__
+#define __AGS_RECALL_LOAD_UTIL_H__
+
+#include <glib.h>
+#include <glib-object.h>
+
+G_BEGIN_DECLS
+
+#define AGS_RECALL_LOAD_UTIL_REPORT_HEADER "# audio\tchannel\tline\trecall\tstage\trun-count\tinclusive-cumulative-ns\tinclusive-peak-ns\n"
+
+gchar* ags_recall_load_util_get_report(GList *start_audio);
+gboolean ags_recall_load_util_dump_report(GList *start_audio,
+					  gchar *filename);
+
+void ags_recall_load_util_reset(GList *start_audio);
+
+G_END_DECLS
+
+#endif /*__AGS_RECALL_LOAD_UTIL_H__*/
@@ -0,0 +1,1014 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ags/audio/ags_resampler.h>
+
+#include <ags/audio/ags_audio_buffer_util.h>
+
+#include <ags/i18n.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+void ags_resampler_class_init(AgsResamplerClass *resampler);
+void ags_resampler_init(AgsResampler *resampler);
+void ags_resampler_set_property(GObject *gobject,
+				guint prop_id,
+				const GValue *value,
+				GParamSpec *param_spec);
+void ags_resampler_get_property(GObject *gobject,
+				guint prop_id,
+				GValue *value,
+				GParamSpec *param_spec);
+void ags_resampler_finalize(GObject *gobject);
+
+int ags_resampler_converter_type(guint quality);
+void ags_resampler_realloc_data_out(AgsResampler *resampler);
+
+/**
+ * SECTION:ags_resampler
+ * @short_description: stateful streaming resampler
+ * @title: AgsResampler
+ * @section_id:
+ * @include: ags/audio/ags_resampler.h
+ *
+ * #AgsResampler converts the samplerate of interleaved audio data. The filter
+ * state is kept across calls of ags_resampler_process(), so consecutive blocks
+ * of a stream are resampled without discontinuities. The work buffers are
+ * allocated once and reused.
+ */
+
+enum{
+  PROP_0,
+  PROP_QUALITY,
+  PROP_AUDIO_CHANNELS,
+  PROP_SAMPLERATE,
+  PROP_TARGET_SAMPLERATE,
+};
+
+static gpointer ags_resampler_parent_class = NULL;
+
+static GPrivate ags_resampler_thread_default = G_PRIVATE_INIT(g_object_unref);
+
+GType
+ags_resampler_get_type()
+{
+  static volatile gsize g_define_type_id__volatile = 0;
+
+  if(g_once_init_enter (&g_define_type_id__volatile)){
+    GType ags_type_resampler = 0;
+
+    static const GTypeInfo ags_resampler_info = {
+      sizeof(AgsResamplerClass),
+      NULL,
+      NULL,
+      (GClassInitFunc) ags_resampler_class_init,
+      NULL,
+      NULL,
+      sizeof(AgsResampler),
+      0,
+      (GInstanceInitFunc) ags_resampler_init,
+    };
+
+    ags_type_resampler = g_type_register_static(G_TYPE_OBJECT,
+						"AgsResampler",
+						&ags_resampler_info,
+						0);
+
+    g_once_init_leave(&g_define_type_id__volatile, ags_type_resampler);
+  }
+
+  return g_define_type_id__volatile;
+}
+
+void
+ags_resampler_class_init(AgsResamplerClass *resampler)
+{
+  GObjectClass *gobject;
+
+  GParamSpec *param_spec;
+
+  ags_resampler_parent_class = g_type_class_peek_parent(resampler);
+
+  gobject = (GObjectClass *) resampler;
+
+  gobject->set_property = ags_resampler_set_property;
+  gobject->get_property = ags_resampler_get_property;
+
+  gobject->finalize = ags_resampler_finalize;
+
+  /* properties */
+  /**
+   * AgsResampler:quality:
+   *
+   * The quality tier, see #AgsResamplerQuality-enum.
+   *
+   * Since: 3.7.0
+   */
+  param_spec = g_param_spec_uint("quality",
+				 i18n_pspec("quality"),
+				 i18n_pspec("The quality tier"),
+				 0,
+				 AGS_RESAMPLER_ZERO_ORDER_HOLD,
+				 AGS_RESAMPLER_DEFAULT_QUALITY,
+				 G_PARAM_READABLE | G_PARAM_WRITABLE);
+  g_object_class_install_property(gobject,
+				  PROP_QUALITY,
+				  param_spec);
+
+  /**
+   * AgsResampler:audio-channels:
+   *
+   * The count of interleaved audio channels.
+   *
+   * Since: 3.7.0
+   */
+  param_spec = g_param_spec_uint("audio-channels",
+				 i18n_pspec("audio channels"),
+				 i18n_pspec("The count of interleaved audio channels"),
+				 1,
+				 G_MAXUINT32,
+				 1,
+				 G_PARAM_READABLE | G_PARAM_WRITABLE);
+  g_object_class_install_property(gobject,
+				  PROP_AUDIO_CHANNELS,
+				  param_spec);
+
+  /**
+   * AgsResampler:samplerate:
+   *
+   * The samplerate of input.
+   *
+   * Since: 3.7.0
+   */
+  param_spec = g_param_spec_uint("samplerate",
+				 i18n_pspec("samplerate"),
+				 i18n_pspec("The samplerate of input"),
+				 0,
+				 G_MAXUINT32,
+				 AGS_SOUNDCARD_DEFAULT_SAMPLERATE,
+				 G_PARAM_READABLE | G_PARAM_WRITABLE);
+  g_object_class_install_property(gobject,
+				  PROP_SAMPLERATE,
+				  param_spec);
+
+  /**
+   * AgsResampler:target-samplerate:
+   *
+   * The samplerate of output.
+   *
+   * Since: 3.7.0
+   */
+  param_spec = g_param_spec_uint("target-samplerate",
+				 i18n_pspec("target samplerate"),
+				 i18n_pspec("The samplerate of output"),
+				 0,
+				 G_MAXUINT32,
+				 AGS_SOUNDCARD_DEFAULT_SAMPLERATE,
+				 G_PARAM_READABLE | G_PARAM_WRITABLE);
+  g_object_class_install_property(gobject,
+				  PROP_TARGET_SAMPLERATE,
+				  param_spec);
+}
+
+void
+ags_resampler_init(AgsResampler *resampler)
+{
+  resampler->flags = 0;
+
+  /* add resampler mutex */
+  g_rec_mutex_init(&(resampler->obj_mutex));
+
+  /* fields */
+  resampler->quality = AGS_RESAMPLER_DEFAULT_QUALITY;
+
+  resampler->audio_channels = 1;
+
+  resampler->samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
+  resampler->target_samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
+
+  resampler->src_state = NULL;
+
+  resampler->data_in = NULL;
+  resampler->data_in_length = 0;
+  resampler->pending_frames = 0;
+
+  resampler->data_out = NULL;
+  resampler->data_out_length = 0;
+}
+
+void
+ags_resampler_set_property(GObject *gobject,
+			   guint prop_id,
+			   const GValue *value,
+			   GParamSpec *param_spec)
+{
+  AgsResampler *resampler;
+
+  resampler = AGS_RESAMPLER(gobject);
+
+  switch(prop_id){
+  case PROP_QUALITY:
+    {
+      ags_resampler_set_quality(resampler,
+				g_value_get_uint(value));
+    }
+    break;
+  case PROP_AUDIO_CHANNELS:
+    {
+      ags_resampler_set_audio_channels(resampler,
+				       g_value_get_uint(value));
+    }
+    break;
+  case PROP_SAMPLERATE:
+    {
+      ags_resampler_set_samplerate(resampler,
+				   g_value_get_uint(value));
+    }
+    break;
+  case PROP_TARGET_SAMPLERATE:
+    {
+      ags_resampler_set_target_samplerate(resampler,
+					  g_value_get_uint(value));
+    }
+    break;
+  default:
+    G_OBJECT_WARN_INVALID_PROPERTY_ID(gobject, prop_id, param_spec);
+    break;
+  }
+}
+
+void
+ags_resampler_get_property(GObject *gobject,
+			   guint prop_id,
+			   GValue *value,
+			   GParamSpec *param_spec)
+{
+  AgsResampler *resampler;
+
+  GRecMutex *resampler_mutex;
+
+  resampler = AGS_RESAMPLER(gobject);
+
+  /* get resampler mutex */
+  resampler_mutex = AGS_RESAMPLER_GET_OBJ_MUTEX(resampler);
+
+  switch(prop_id){
+  case PROP_QUALITY:
+    {
+      g_rec_mutex_lock(resampler_mutex);
+
+      g_value_set_uint(value,
+		       resampler->quality);
+
+      g_rec_mutex_unlock(resampler_mutex);
+    }
+    break;
+  case PROP_AUDIO_CHANNELS:
+    {
+      g_rec_mutex_lock(resampler_mutex);
+
+      g_value_set_uint(value,
+		       resampler->audio_channels);
+
+      g_rec_mutex_unlock(resampler_mutex);
+    }
+    break;
+  case PROP_SAMPLERATE:
+    {
+      g_rec_mutex_lock(resampler_mutex);
+
+      g_value_set_uint(value,
+		       resampler->samplerate);
+
+      g_rec_mutex_unlock(resampler_mutex);
+    }
+    break;
+  case PROP_TARGET_SAMPLERATE:
+    {
+      g_rec_mutex_lock(resampler_mutex);
+
+      g_value_set_uint(value,
+		       resampler->target_samplerate);
+
+      g_rec_mutex_unlock(resampler_mutex);
+    }
+    break;
+  default:
+    G_OBJECT_WARN_INVALID_PROPERTY_ID(gobject, prop_id, param_spec);
+    break;
+  }
+}
+
+void
+ags_resampler_finalize(GObject *gobject)
+{
+  AgsResampler *resampler;
+
+  resampler = AGS_RESAMPLER(gobject);
+
+  if(resampler->src_state != NULL){
+    src_delete(resampler->src_state);
+  }
+
+  if(resampler->data_in != NULL){
+    free(resampler->data_in);
+  }
+
+  if(resampler->data_out != NULL){
+    free(resampler->data_out);
+  }
+
+  /* call parent */
+  G_OBJECT_CLASS(ags_resampler_parent_class)->finalize(gobject);
+}
+
+int
+ags_resampler_converter_type(guint quality)
+{
+  switch(quality){
+  case AGS_RESAMPLER_BEST_QUALITY:
+    return(SRC_SINC_BEST_QUALITY);
+  case AGS_RESAMPLER_MEDIUM_QUALITY:
+    return(SRC_SINC_MEDIUM_QUALITY);
+  case AGS_RESAMPLER_FASTEST:
+    return(SRC_SINC_FASTEST);
+  case AGS_RESAMPLER_LINEAR:
+    return(SRC_LINEAR);
+  case AGS_RESAMPLER_ZERO_ORDER_HOLD:
+    return(SRC_ZERO_ORDER_HOLD);
+  }
+
+  return(SRC_SINC_MEDIUM_QUALITY);
+}
+
+void
+ags_resampler_realloc_data_out(AgsResampler *resampler)
+{
+  guint data_out_length;
+
+  if(resampler->samplerate == 0){
+    return;
+  }
+
+  /* one block of input produces at most this many frames */
+  data_out_length = (guint) ceil((gdouble) AGS_RESAMPLER_DEFAULT_BLOCK_LENGTH * (gdouble) resampler->target_samplerate / (gdouble) resampler->samplerate) + 1;
+
+  if(data_out_length == resampler->data_out_length &&
+     resampler->data_out != NULL){
+    return;
+  }
+
+  resampler->data_out = (gfloat *) realloc(resampler->data_out,
+					   resampler->audio_channels * data_out_length * sizeof(gfloat));
+  resampler->data_out_length = data_out_length;
+}
+
+/**
+ * ags_resampler_get_quality:
+ * @resampler: the #AgsResampler
+ *
+ * Gets quality.
+ *
+ * Returns: the quality tier
+ *
+ * Since: 3.7.0
+ */
+guint
+ags_resampler_get_quality(AgsResampler *resampler)
+{
+  guint quality;
+
+  if(!AGS_IS_RESAMPLER(resampler)){
+    return(AGS_RESAMPLER_DEFAULT_QUALITY);
+  }
+
+  g_object_get(resampler,
+	       "quality", &quality,
+	       NULL);
+
+  return(quality);
+}
+
+/**
+ * ags_resampler_set_quality:
+ * @resampler: the #AgsResampler
+ * @quality: the quality tier
+ *
+ * Set quality, the filter state is recreated on next processing.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_resampler_set_quality(AgsResampler *resampler,
+			  guint quality)
+{
+  GRecMutex *resampler_mutex;
+
+  if(!AGS_IS_RESAMPLER(resampler)){
+    return;
+  }
+
+  /* get resampler mutex */
+  resampler_mutex = AGS_RESAMPLER_GET_OBJ_MUTEX(resampler);
+
+  /* set quality */
+  g_rec_mutex_lock(resampler_mutex);
+
+  if(resampler->quality != quality){
+    resampler->quality = quality;
+
+    if(resampler->src_state != NULL){
+      src_delete(resampler->src_state);
+
+      resampler->src_state = NULL;
+    }
+
+    resampler->pending_frames = 0;
+  }
+
+  g_rec_mutex_unlock(resampler_mutex);
+}
+
+/**
+ * ags_resampler_get_audio_channels:
+ * @resampler: the #AgsResampler
+ *
+ * Gets audio channels.
+ *
+ * Returns: the count of audio channels
+ *
+ * Since: 3.7.0
+ */
+guint
+ags_resampler_get_audio_channels(AgsResampler *resampler)
+{
+  guint audio_channels;
+
+  if(!AGS_IS_RESAMPLER(resampler)){
+    return(0);
+  }
+
+  g_object_get(resampler,
+	       "audio-channels", &audio_channels,
+	       NULL);
+
+  return(audio_channels);
+}
+
+/**
+ * ags_resampler_set_audio_channels:
+ * @resampler: the #AgsResampler
+ * @audio_channels: the count of audio channels
+ *
+ * Set audio channels, the filter state is recreated on next processing.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_resampler_set_audio_channels(AgsResampler *resampler,
+				 guint audio_channels)
+{
+  GRecMutex *resampler_mutex;
+
+  if(!AGS_IS_RESAMPLER(resampler) ||
+     audio_channels == 0){
+    return;
+  }
+
+  /* get resampler mutex */
+  resampler_mutex = AGS_RESAMPLER_GET_OBJ_MUTEX(resampler);
+
+  /* set audio channels */
+  g_rec_mutex_lock(resampler_mutex);
+
+  if(resampler->audio_channels != audio_channels){
+    resampler->audio_channels = audio_channels;
+
+    if(resampler->src_state != NULL){
+      src_delete(resampler->src_state);
+
+      resampler->src_state = NULL;
+    }
+
+    /* work buffers are interleaved */
+    if(resampler->data_in != NULL){
+      free(resampler->data_in);
+
+      resampler->data_in = NULL;
+    }
+
+    resampler->data_in_length = 0;
+    resampler->pending_frames = 0;
+
+    if(resampler->data_out != NULL){
+      free(resampler->data_out);
+
+      resampler->data_out = NULL;
+    }
+
+    resampler->data_out_length = 0;
+  }
+
+  g_rec_mutex_unlock(resampler_mutex);
+}
+
+/**
+ * ags_resampler_get_samplerate:
+ * @resampler: the #AgsResampler
+ *
+ * Gets samplerate.
+ *
+ * Returns: the samplerate of input
+ *
+ * Since: 3.7.0
+ */
+guint
+ags_resampler_get_samplerate(AgsResampler *resampler)
+{
+  guint samplerate;
+
+  if(!AGS_IS_RESAMPLER(resampler)){
+    return(0);
+  }
+
+  g_object_get(resampler,
+	       "samplerate", &samplerate,
+	       NULL);
+
+  return(samplerate);
+}
+
+/**
+ * ags_resampler_set_samplerate:
+ * @resampler: the #AgsResampler
+ * @samplerate: the samplerate of input
+ *
+ * Set samplerate.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_resampler_set_samplerate(AgsResampler *resampler,
+			     guint samplerate)
+{
+  GRecMutex *resampler_mutex;
+
+  if(!AGS_IS_RESAMPLER(resampler)){
+    return;
+  }
+
+  /* get resampler mutex */
+  resampler_mutex = AGS_RESAMPLER_GET_OBJ_MUTEX(resampler);
+
+  /* set samplerate */
+  g_rec_mutex_lock(resampler_mutex);
+
+  resampler->samplerate = samplerate;
+
+  g_rec_mutex_unlock(resampler_mutex);
+}
+
+/**
+ * ags_resampler_get_target_samplerate:
+ * @resampler: the #AgsResampler
+ *
+ * Gets target samplerate.
+ *
+ * Returns: the samplerate of output
+ *
+ * Since: 3.7.0
+ */
+guint
+ags_resampler_get_target_samplerate(AgsResampler *resampler)
+{
+  guint target_samplerate;
+
+  if(!AGS_IS_RESAMPLER(resampler)){
+    return(0);
+  }
+
+  g_object_get(resampler,
+	       "target-samplerate", &target_samplerate,
+	       NULL);
+
+  return(target_samplerate);
+}
+
+/**
+ * ags_resampler_set_target_samplerate:
+ * @resampler: the #AgsResampler
+ * @target_samplerate: the samplerate of output
+ *
+ * Set target samplerate.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_resampler_set_target_samplerate(AgsResampler *resampler,
+				    guint target_samplerate)
+{
+  GRecMutex *resampler_mutex;
+
+  if(!AGS_IS_RESAMPLER(resampler)){
+    return;
+  }
+
+  /* get resampler mutex */
+  resampler_mutex = AGS_RESAMPLER_GET_OBJ_MUTEX(resampler);
+
+  /* set target samplerate */
+  g_rec_mutex_lock(resampler_mutex);
+
+  resampler->target_samplerate = target_samplerate;
+
+  g_rec_mutex_unlock(resampler_mutex);
+}
+
+/**
+ * ags_resampler_get_target_length:
+ * @resampler: the #AgsResampler
+ * @buffer_length: the count of input frames
+ *
+ * Gets the count of output frames @buffer_length input frames result in.
+ *
+ * Returns: the target length
+ *
+ * Since: 3.7.0
+ */
+guint
+ags_resampler_get_target_length(AgsResampler *resampler,
+				 guint buffer_length)
+{
+  guint samplerate, target_samplerate;
+
+  GRecMutex *resampler_mutex;
+
+  if(!AGS_IS_RESAMPLER(resampler)){
+    return(0);
+  }
+
+  /* get resampler mutex */
+  resampler_mutex = AGS_RESAMPLER_GET_OBJ_MUTEX(resampler);
+
+  g_rec_mutex_lock(resampler_mutex);
+
+  samplerate = resampler->samplerate;
+  target_samplerate = resampler->target_samplerate;
+
+  g_rec_mutex_unlock(resampler_mutex);
+
+  if(samplerate == 0){
+    return(0);
+  }
+
+  return((guint) ceil((gdouble) buffer_length * (gdouble) target_samplerate / (gdouble) samplerate));
+}
+
+/**
+ * ags_resampler_reset:
+ * @resampler: the #AgsResampler
+ *
+ * Reset the filter state and drop pending input, do it before processing
+ * a new stream.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_resampler_reset(AgsResampler *resampler)
+{
+  GRecMutex *resampler_mutex;
+
+  if(!AGS_IS_RESAMPLER(resampler)){
+    return;
+  }
+
+  /* get resampler mutex */
+  resampler_mutex = AGS_RESAMPLER_GET_OBJ_MUTEX(resampler);
+
+  /* reset */
+  g_rec_mutex_lock(resampler_mutex);
+
+  if(resampler->src_state != NULL){
+    src_reset(resampler->src_state);
+  }
+
+  resampler->pending_frames = 0;
+
+  g_rec_mutex_unlock(resampler_mutex);
+}
+
+/**
+ * ags_resampler_process:
+ * @resampler: the #AgsResampler
+ * @buffer: the interleaved input buffer
+ * @format: the format of @buffer as AgsAudioBufferUtilFormat-enum
+ * @buffer_length: the count of input frames
+ * @target_buffer: the interleaved output buffer
+ * @target_format: the format of @target_buffer as AgsAudioBufferUtilFormat-enum
+ * @target_buffer_length: the count of output frames available
+ * @end_of_input: %TRUE if @buffer is the last block of the stream, else %FALSE
+ *
+ * Resample the next block of a stream. The filter state is kept between calls, input
+ * not consumed yet is kept for the next call. The output is copied to @target_buffer
+ * the same way ags_audio_buffer_util_copy_buffer_to_buffer() does, so clear it first.
+ *
+ * Returns: the count of frames written to @target_buffer
+ *
+ * Since: 3.7.0
+ */
+guint
+ags_resampler_process(AgsResampler *resampler,
+		      void *buffer, guint format,
+		      guint buffer_length,
+		      void *target_buffer, guint target_format,
+		      guint target_buffer_length,
+		      gboolean end_of_input)
+{
+  SRC_DATA src_data;
+
+  guint audio_channels;
+  guint in_copy_mode, out_copy_mode;
+  guint offset, written;
+  guint block_length;
+  guint i;
+  int error;
+  gboolean last_block;
+
+  GRecMutex *resampler_mutex;
+
+  if(!AGS_IS_RESAMPLER(resampler) ||
+     target_buffer == NULL ||
+     (buffer == NULL && buffer_length != 0)){
+    return(0);
+  }
+
+  /* get resampler mutex */
+  resampler_mutex = AGS_RESAMPLER_GET_OBJ_MUTEX(resampler);
+
+  g_rec_mutex_lock(resampler_mutex);
+
+  if(resampler->samplerate == 0 ||
+     resampler->target_samplerate == 0 ||
+     !src_is_valid_ratio((gdouble) resampler->target_samplerate / (gdouble) resampler->samplerate)){
+    g_rec_mutex_unlock(resampler_mutex);
+
+    g_warning("ags_resampler_process() - invalid ratio");
+
+    return(0);
+  }
+
+  audio_channels = resampler->audio_channels;
+
+  /* filter state */
+  if(resampler->src_state == NULL){
+    resampler->src_state = src_new(ags_resampler_converter_type(resampler->quality),
+				   audio_channels,
+				   &error);
+
+    if(resampler->src_state == NULL){
+      g_rec_mutex_unlock(resampler_mutex);
+
+      g_warning("ags_resampler_process() - %s", src_strerror(error));
+
+      return(0);
+    }
+  }
+
+  ags_resampler_realloc_data_out(resampler);
+
+  in_copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_FLOAT,
+						     format);
+  out_copy_mode = ags_audio_buffer_util_get_copy_mode(target_format,
+						      AGS_AUDIO_BUFFER_UTIL_FLOAT);
+
+  src_data.src_ratio = (gdouble) resampler->target_samplerate / (gdouble) resampler->samplerate;
+
+  offset = 0;
+  written = 0;
+
+  do{
+    /* append next block of input */
+    block_length = buffer_length - offset;
+
+    if(block_length > AGS_RESAMPLER_DEFAULT_BLOCK_LENGTH &&
+       written < target_buffer_length){
+      block_length = AGS_RESAMPLER_DEFAULT_BLOCK_LENGTH;
+    }
+
+    if(resampler->pending_frames + block_length > resampler->data_in_length){
+      resampler->data_in_length = resampler->pending_frames + block_length;
+      resampler->data_in = (gfloat *) realloc(resampler->data_in,
+					      audio_channels * resampler->data_in_length * sizeof(gfloat));
+    }
+
+    if(block_length > 0){
+      ags_audio_buffer_util_clear_float(resampler->data_in + audio_channels * resampler->pending_frames, 1,
+					audio_channels * block_length);
+
+      for(i = 0; i < audio_channels; i++){
+	ags_audio_buffer_util_copy_buffer_to_buffer(resampler->data_in, audio_channels, audio_channels * resampler->pending_frames + i,
+						    buffer, audio_channels, audio_channels * offset + i,
+						    block_length, in_copy_mode);
+      }
+    }
+
+    resampler->pending_frames += block_length;
+    offset += block_length;
+
+    last_block = (end_of_input && offset >= buffer_length) ? TRUE: FALSE;
+
+    /* run filter */
+    while(written < target_buffer_length){
+      src_data.data_in = resampler->data_in;
+      src_data.input_frames = resampler->pending_frames;
+
+      src_data.data_out = resampler->data_out;
+      src_data.output_frames = resampler->data_out_length;
+
+      if(src_data.output_frames > target_buffer_length - written){
+	src_data.output_frames = target_buffer_length - written;
+      }
+
+      src_data.end_of_input = last_block;
+
+      error = src_process(resampler->src_state,
+			  &src_data);
+
+      if(error != 0){
+	g_warning("ags_resampler_process() - %s", src_strerror(error));
+
+	break;
+      }
+
+      /* copy output */
+      if(src_data.output_frames_gen > 0){
+	for(i = 0; i < audio_channels; i++){
+	  ags_audio_buffer_util_copy_buffer_to_buffer(target_buffer, audio_channels, audio_channels * written + i,
+						      resampler->data_out, audio_channels, i,
+						      src_data.output_frames_gen, out_copy_mode);
+	}
+
+	written += src_data.output_frames_gen;
+      }
+
+      /* keep input not consumed */
+      if(src_data.input_frames_used > 0){
+	resampler->pending_frames -= src_data.input_frames_used;
+
+	if(resampler->pending_frames > 0){
+	  memmove(resampler->data_in,
+		  resampler->data_in + audio_channels * src_data.input_frames_used,
+		  audio_channels * resampler->pending_frames * sizeof(gfloat));
+	}
+      }
+
+      if(src_data.output_frames_gen == 0 &&
+	 src_data.input_frames_used == 0){
+	break;
+      }
+
+      if(!last_block &&
+	 resampler->pending_frames == 0){
+	break;
+      }
+    }
+  }while(offset < buffer_length);
+
+  g_rec_mutex_unlock(resampler_mutex);
+
+  return(written);
+}
+
+/**
+ * ags_resampler_convert:
+ * @resampler: the #AgsResampler
+ * @buffer: the interleaved input buffer
+ * @format: the format of @buffer as AgsAudioBufferUtilFormat-enum
+ * @buffer_length: the count of input frames
+ * @target_buffer: the interleaved output buffer
+ * @target_format: the format of @target_buffer as AgsAudioBufferUtilFormat-enum
+ * @target_buffer_length: the count of output frames available
+ *
+ * Resample @buffer as a complete stream, the filter state is reset before and
+ * the filter is flushed after.
+ *
+ * Returns: the count of frames written to @target_buffer
+ *
+ * Since: 3.7.0
+ */
+guint
+ags_resampler_convert(AgsResampler *resampler,
+		      void *buffer, guint format,
+		      guint buffer_length,
+		      void *target_buffer, guint target_format,
+		      guint target_buffer_length)
+{
+  guint written;
+
+  GRecMutex *resampler_mutex;
+
+  if(!AGS_IS_RESAMPLER(resampler)){
+    return(0);
+  }
+
+  /* get resampler mutex */
+  resampler_mutex = AGS_RESAMPLER_GET_OBJ_MUTEX(resampler);
+
+  g_rec_mutex_lock(resampler_mutex);
+
+  ags_resampler_reset(resampler);
+
+  written = ags_resampler_process(resampler,
+				  buffer, format,
+				  buffer_length,
+				  target_buffer, target_format,
+				  target_buffer_length,
+				  TRUE);
+
+  /* drop what didn't fit */
+  ags_resampler_reset(resampler);
+
+  g_rec_mutex_unlock(resampler_mutex);
+
+  return(written);
+}
+
+/**
+ * ags_resampler_get_thread_default:
+ *
+ * Get the #AgsResampler of the calling thread. It is created on first use and
+ * released as the thread exits, use it to avoid allocating the filter state
+ * and work buffers on every call.
+ *
+ * Returns: (transfer none): the #AgsResampler
+ *
+ * Since: 3.7.0
+ */
+AgsResampler*
+ags_resampler_get_thread_default()
+{
+  AgsResampler *resampler;
+
+  resampler = (AgsResampler *) g_private_get(&ags_resampler_thread_default);
+
+  if(resampler == NULL){
+    resampler = ags_resampler_new(1,
+				  AGS_SOUNDCARD_DEFAULT_SAMPLERATE,
+				  AGS_SOUNDCARD_DEFAULT_SAMPLERATE,
+				  AGS_RESAMPLER_DEFAULT_QUALITY);
+
+    g_private_set(&ags_resampler_thread_default,
+		  resampler);
+  }
+
+  return(resampler);
+}
+
+/**
+ * ags_resampler_new:
+ * @audio_channels: the count of interleaved audio channels
+ * @samplerate: the samplerate of input
+ * @target_samplerate: the samplerate of output
+ * @quality: the quality tier
+ *
+ * Creates a new instance of #AgsResampler
+ *
+ * Returns: the new #AgsResampler
+ *
+ * Since: 3.7.0
+ */
+AgsResampler*
+ags_resampler_new(guint audio_channels,
+		  guint samplerate,
+		  guint target_samplerate,
+		  guint quality)
+{
+  AgsResampler *resampler;
+
+  resampler = (AgsResampler *) g_object_new(AGS_TYPE_RESAMPLER,
+					    "audio-channels", audio_channels,
+					    "samplerate", samplerate,
+					    "target-samplerate", target_samplerate,
+					    "quality", quality,
+					    NULL);
+
+  return(resampler);
+}
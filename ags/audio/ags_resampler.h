@@ -0,0 +1,139 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __AGS_RESAMPLER_H__
+#define __AGS_RESAMPLER_H__
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <samplerate.h>
+
+#include <ags/libags.h>
+
+G_BEGIN_DECLS
+
+#define AGS_TYPE_RESAMPLER                (ags_resampler_get_type())
+#define AGS_RESAMPLER(obj)                (G_TYPE_CHECK_INSTANCE_CAST((obj), AGS_TYPE_RESAMPLER, AgsResampler))
+#define AGS_RESAMPLER_CLASS(class)        (G_TYPE_CHECK_CLASS_CAST((class), AGS_TYPE_RESAMPLER, AgsResamplerClass))
+#define AGS_IS_RESAMPLER(obj)             (G_TYPE_CHECK_INSTANCE_TYPE((obj), AGS_TYPE_RESAMPLER))
+#define AGS_IS_RESAMPLER_CLASS(class)     (G_TYPE_CHECK_CLASS_TYPE((class), AGS_TYPE_RESAMPLER))
+#define AGS_RESAMPLER_GET_CLASS(obj)      (G_TYPE_INSTANCE_GET_CLASS((obj), AGS_TYPE_RESAMPLER, AgsResamplerClass))
+
+#define AGS_RESAMPLER_GET_OBJ_MUTEX(obj) (&(((AgsResampler *) obj)->obj_mutex))
+
+#define AGS_RESAMPLER_DEFAULT_QUALITY (AGS_RESAMPLER_MEDIUM_QUALITY)
+#define AGS_RESAMPLER_DEFAULT_BLOCK_LENGTH (4096)
+
+typedef struct _AgsResampler AgsResampler;
+typedef struct _AgsResamplerClass AgsResamplerClass;
+
+/**
+ * AgsResamplerQuality:
+ * @AGS_RESAMPLER_BEST_QUALITY: band limited sinc, best quality
+ * @AGS_RESAMPLER_MEDIUM_QUALITY: band limited sinc, medium quality
+ * @AGS_RESAMPLER_FASTEST: band limited sinc, fastest
+ * @AGS_RESAMPLER_LINEAR: linear interpolation
+ * @AGS_RESAMPLER_ZERO_ORDER_HOLD: zero order hold
+ *
+ * Enum values to select the quality tier of #AgsResampler.
+ */
+typedef enum{
+  AGS_RESAMPLER_BEST_QUALITY,
+  AGS_RESAMPLER_MEDIUM_QUALITY,
+  AGS_RESAMPLER_FASTEST,
+  AGS_RESAMPLER_LINEAR,
+  AGS_RESAMPLER_ZERO_ORDER_HOLD,
+}AgsResamplerQuality;
+
+struct _AgsResampler
+{
+  GObject gobject;
+
+  guint flags;
+
+  GRecMutex obj_mutex;
+
+  guint quality;
+
+  guint audio_channels;
+
+  guint samplerate;
+  guint target_samplerate;
+
+  SRC_STATE *src_state;
+
+  gfloat *data_in;
+  guint data_in_length;
+  guint pending_frames;
+
+  gfloat *data_out;
+  guint data_out_length;
+};
+
+struct _AgsResamplerClass
+{
+  GObjectClass gobject;
+};
+
+GType ags_resampler_get_type();
+
+guint ags_resampler_get_quality(AgsResampler *resampler);
+void ags_resampler_set_quality(AgsResampler *resampler,
+			       guint quality);
+
+guint ags_resampler_get_audio_channels(AgsResampler *resampler);
+void ags_resampler_set_audio_channels(AgsResampler *resampler,
+				      guint audio_channels);
+
+guint ags_resampler_get_samplerate(AgsResampler *resampler);
+void ags_resampler_set_samplerate(AgsResampler *resampler,
+				  guint samplerate);
+
+guint ags_resampler_get_target_samplerate(AgsResampler *resampler);
+void ags_resampler_set_target_samplerate(AgsResampler *resampler,
+					 guint target_samplerate);
+
+guint ags_resampler_get_target_length(AgsResampler *resampler,
+				      guint buffer_length);
+
+void ags_resampler_reset(AgsResampler *resampler);
+
+guint ags_resampler_process(AgsResampler *resampler,
+			    void *buffer, guint format,
+			    guint buffer_length,
+			    void *target_buffer, guint target_format,
+			    guint target_buffer_length,
+			    gboolean end_of_input);
+guint ags_resampler_convert(AgsResampler *resampler,
+			    void *buffer, guint format,
+			    guint buffer_length,
+			    void *target_buffer, guint target_format,
+			    guint target_buffer_length);
+
+AgsResampler* ags_resampler_get_thread_default();
+
+AgsResampler* ags_resampler_new(guint audio_channels,
+				guint samplerate,
+				guint target_samplerate,
+				guint quality);
+
+G_END_DECLS
+
+#endif /*__AGS_RESAMPLER_H__*/
@@ -0,0 +1,868 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ags/audio/ags_sample_cache.h>
+
+#include <ags/audio/ags_audio_signal.h>
+
+#include <ags/i18n.h>
+
+void ags_sample_cache_class_init(AgsSampleCacheClass *sample_cache);
+void ags_sample_cache_init(AgsSampleCache *sample_cache);
+void ags_sample_cache_set_property(GObject *gobject,
+				   guint prop_id,
+				   const GValue *value,
+				   GParamSpec *param_spec);
+void ags_sample_cache_get_property(GObject *gobject,
+				   guint prop_id,
+				   GValue *value,
+				   GParamSpec *param_spec);
+void ags_sample_cache_finalize(GObject *gobject);
+
+guint ags_sample_cache_entry_hash(gconstpointer key);
+gboolean ags_sample_cache_entry_equal(gconstpointer a,
+				      gconstpointer b);
+
+guint64 ags_sample_cache_get_word_size(guint format);
+
+void ags_sample_cache_sample_weak_notify(gpointer data,
+					 GObject *where_the_object_was);
+
+void ags_sample_cache_remove_entry(AgsSampleCache *sample_cache,
+				   AgsSampleCacheEntry *sample_cache_entry,
+				   gboolean weak_unref);
+void ags_sample_cache_evict(AgsSampleCache *sample_cache);
+
+AgsSampleCacheEntry* ags_sample_cache_lookup_entry(AgsSampleCache *sample_cache,
+						   GObject *sample,
+						   guint flags,
+						   guint samplerate, guint format,
+						   gdouble note);
+AgsSampleCacheEntry* ags_sample_cache_insert_entry(AgsSampleCache *sample_cache,
+						   GObject *sample,
+						   guint flags,
+						   guint samplerate, guint format,
+						   gdouble note,
+						   void *data, guint frame_count);
+
+/**
+ * SECTION:ags_sample_cache
+ * @short_description: decoded and resampled sample cache
+ * @title: AgsSampleCache
+ * @section_id:
+ * @include: ags/audio/ags_sample_cache.h
+ *
+ * #AgsSampleCache keeps the PCM of Soundfont2 and SFZ samples at two levels.
+ * The decoded level holds the sample read and resampled as double, keyed by
+ * sample and samplerate only. The pitched level is keyed by sample,
+ * samplerate, format and note and is computed from the decoded level. So
+ * every key of an instrument reads and resamples its sample once, and
+ * regenerating the instrument reuses the pitched data.
+ *
+ * Both levels share #AgsSampleCache:memory-budget and evict the least
+ * recently used entries first. Entries of a sample are dropped as soon as the
+ * sample is finalized.
+ */
+
+enum{
+  PROP_0,
+  PROP_MEMORY_BUDGET,
+  PROP_MEMORY_USED,
+};
+
+static gpointer ags_sample_cache_parent_class = NULL;
+
+AgsSampleCache *ags_sample_cache = NULL;
+
+GType
+ags_sample_cache_get_type()
+{
+  static volatile gsize g_define_type_id__volatile = 0;
+
+  if(g_once_init_enter (&g_define_type_id__volatile)){
+    GType ags_type_sample_cache = 0;
+
+    static const GTypeInfo ags_sample_cache_info = {
+      sizeof(AgsSampleCacheClass),
+      NULL,
+      NULL,
+      (GClassInitFunc) ags_sample_cache_class_init,
+      NULL,
+      NULL,
+      sizeof(AgsSampleCache),
+      0,
+      (GInstanceInitFunc) ags_sample_cache_init,
+    };
+
+    ags_type_sample_cache = g_type_register_static(G_TYPE_OBJECT,
+						   "AgsSampleCache",
+						   &ags_sample_cache_info,
+						   0);
+
+    g_once_init_leave(&g_define_type_id__volatile, ags_type_sample_cache);
+  }
+
+  return g_define_type_id__volatile;
+}
+
+void
+ags_sample_cache_class_init(AgsSampleCacheClass *sample_cache)
+{
+  GObjectClass *gobject;
+
+  GParamSpec *param_spec;
+
+  ags_sample_cache_parent_class = g_type_class_peek_parent(sample_cache);
+
+  /* GObjectClass */
+  gobject = (GObjectClass *) sample_cache;
+
+  gobject->set_property = ags_sample_cache_set_property;
+  gobject->get_property = ags_sample_cache_get_property;
+
+  gobject->finalize = ags_sample_cache_finalize;
+
+  /* properties */
+  /**
+   * AgsSampleCache:memory-budget:
+   *
+   * The maximum count of bytes the cached sample data may use.
+   *
+   * Since: 3.7.0
+   */
+  param_spec = g_param_spec_uint64("memory-budget",
+				   i18n_pspec("memory budget"),
+				   i18n_pspec("The maximum count of bytes cached"),
+				   0,
+				   G_MAXUINT64,
+				   AGS_SAMPLE_CACHE_DEFAULT_MEMORY_BUDGET,
+				   G_PARAM_READABLE | G_PARAM_WRITABLE);
+  g_object_class_install_property(gobject,
+				  PROP_MEMORY_BUDGET,
+				  param_spec);
+
+  /**
+   * AgsSampleCache:memory-used:
+   *
+   * The count of bytes the cached sample data currently uses.
+   *
+   * Since: 3.7.0
+   */
+  param_spec = g_param_spec_uint64("memory-used",
+				   i18n_pspec("memory used"),
+				   i18n_pspec("The count of bytes cached"),
+				   0,
+				   G_MAXUINT64,
+				   0,
+				   G_PARAM_READABLE);
+  g_object_class_install_property(gobject,
+				  PROP_MEMORY_USED,
+				  param_spec);
+}
+
+void
+ags_sample_cache_init(AgsSampleCache *sample_cache)
+{
+  sample_cache->flags = 0;
+
+  /* sample cache mutex */
+  g_rec_mutex_init(&(sample_cache->obj_mutex));
+
+  /* fields */
+  sample_cache->memory_budget = AGS_SAMPLE_CACHE_DEFAULT_MEMORY_BUDGET;
+  sample_cache->memory_used = 0;
+
+  sample_cache->entry = g_hash_table_new(ags_sample_cache_entry_hash,
+					 ags_sample_cache_entry_equal);
+  sample_cache->lru = g_queue_new();
+}
+
+void
+ags_sample_cache_set_property(GObject *gobject,
+			      guint prop_id,
+			      const GValue *value,
+			      GParamSpec *param_spec)
+{
+  AgsSampleCache *sample_cache;
+
+  GRecMutex *sample_cache_mutex;
+
+  sample_cache = AGS_SAMPLE_CACHE(gobject);
+
+  /* get sample cache mutex */
+  sample_cache_mutex = AGS_SAMPLE_CACHE_GET_OBJ_MUTEX(sample_cache);
+
+  switch(prop_id){
+  case PROP_MEMORY_BUDGET:
+    {
+      g_rec_mutex_lock(sample_cache_mutex);
+
+      sample_cache->memory_budget = g_value_get_uint64(value);
+
+      ags_sample_cache_evict(sample_cache);
+
+      g_rec_mutex_unlock(sample_cache_mutex);
+    }
+    break;
+  default:
+    G_OBJECT_WARN_INVALID_PROPERTY_ID(gobject, prop_id, param_spec);
+    break;
+  }
+}
+
+void
+ags_sample_cache_get_property(GObject *gobject,
+			      guint prop_id,
+			      GValue *value,
+			      GParamSpec *param_spec)
+{
+  AgsSampleCache *sample_cache;
+
+  GRecMutex *sample_cache_mutex;
+
+  sample_cache = AGS_SAMPLE_CACHE(gobject);
+
+  /* get sample cache mutex */
+  sample_cache_mutex = AGS_SAMPLE_CACHE_GET_OBJ_MUTEX(sample_cache);
+
+  switch(prop_id){
+  case PROP_MEMORY_BUDGET:
+    {
+      g_rec_mutex_lock(sample_cache_mutex);
+
+      g_value_set_uint64(value, sample_cache->memory_budget);
+
+      g_rec_mutex_unlock(sample_cache_mutex);
+    }
+    break;
+  case PROP_MEMORY_USED:
+    {
+      g_rec_mutex_lock(sample_cache_mutex);
+
+      g_value_set_uint64(value, sample_cache->memory_used);
+
+      g_rec_mutex_unlock(sample_cache_mutex);
+    }
+    break;
+  default:
+    G_OBJECT_WARN_INVALID_PROPERTY_ID(gobject, prop_id, param_spec);
+    break;
+  }
+}
+
+void
+ags_sample_cache_finalize(GObject *gobject)
+{
+  AgsSampleCache *sample_cache;
+
+  sample_cache = AGS_SAMPLE_CACHE(gobject);
+
+  ags_sample_cache_clear(sample_cache);
+
+  g_hash_table_destroy(sample_cache->entry);
+  g_queue_free(sample_cache->lru);
+
+  if(sample_cache == ags_sample_cache){
+    ags_sample_cache = NULL;
+  }
+
+  /* call parent */
+  G_OBJECT_CLASS(ags_sample_cache_parent_class)->finalize(gobject);
+}
+
+guint
+ags_sample_cache_entry_hash(gconstpointer key)
+{
+  AgsSampleCacheEntry *sample_cache_entry;
+
+  guint hash;
+
+  sample_cache_entry = (AgsSampleCacheEntry *) key;
+
+  hash = g_direct_hash(sample_cache_entry->sample);
+  hash = 31 * hash + sample_cache_entry->flags;
+  hash = 31 * hash + sample_cache_entry->samplerate;
+  hash = 31 * hash + sample_cache_entry->format;
+  hash = 31 * hash + g_double_hash(&(sample_cache_entry->note));
+
+  return(hash);
+}
+
+gboolean
+ags_sample_cache_entry_equal(gconstpointer a,
+			     gconstpointer b)
+{
+  AgsSampleCacheEntry *entry_a, *entry_b;
+
+  entry_a = (AgsSampleCacheEntry *) a;
+  entry_b = (AgsSampleCacheEntry *) b;
+
+  if(entry_a->sample == entry_b->sample &&
+     entry_a->flags == entry_b->flags &&
+     entry_a->samplerate == entry_b->samplerate &&
+     entry_a->format == entry_b->format &&
+     entry_a->note == entry_b->note){
+    return(TRUE);
+  }
+
+  return(FALSE);
+}
+
+guint64
+ags_sample_cache_get_word_size(guint format)
+{
+  guint64 word_size;
+
+  word_size = 0;
+
+  switch(format){
+  case AGS_SOUNDCARD_SIGNED_8_BIT:
+    {
+      word_size = sizeof(gint8);
+    }
+    break;
+  case AGS_SOUNDCARD_SIGNED_16_BIT:
+    {
+      word_size = sizeof(gint16);
+    }
+    break;
+  case AGS_SOUNDCARD_SIGNED_24_BIT:
+  case AGS_SOUNDCARD_SIGNED_32_BIT:
+    {
+      word_size = sizeof(gint32);
+    }
+    break;
+  case AGS_SOUNDCARD_SIGNED_64_BIT:
+    {
+      word_size = sizeof(gint64);
+    }
+    break;
+  case AGS_SOUNDCARD_FLOAT:
+    {
+      word_size = sizeof(gfloat);
+    }
+    break;
+  case AGS_SOUNDCARD_DOUBLE:
+    {
+      word_size = sizeof(gdouble);
+    }
+    break;
+  case AGS_SOUNDCARD_COMPLEX:
+    {
+      word_size = sizeof(AgsComplex);
+    }
+    break;
+  default:
+    g_warning("ags_sample_cache_get_word_size() - unsupported format");
+  }
+
+  return(word_size);
+}
+
+void
+ags_sample_cache_sample_weak_notify(gpointer data,
+				    GObject *where_the_object_was)
+{
+  AgsSampleCache *sample_cache;
+
+  GList *start_list, *list;
+
+  GRecMutex *sample_cache_mutex;
+
+  sample_cache = AGS_SAMPLE_CACHE(data);
+
+  /* get sample cache mutex */
+  sample_cache_mutex = AGS_SAMPLE_CACHE_GET_OBJ_MUTEX(sample_cache);
+
+  /* the sample is gone, drop its entries without touching it */
+  g_rec_mutex_lock(sample_cache_mutex);
+
+  list =
+    start_list = g_list_copy(sample_cache->lru->head);
+
+  while(list != NULL){
+    AgsSampleCacheEntry *sample_cache_entry;
+
+    sample_cache_entry = list->data;
+
+    if(sample_cache_entry->sample == where_the_object_was){
+      ags_sample_cache_remove_entry(sample_cache,
+				    sample_cache_entry,
+				    FALSE);
+    }
+
+    list = list->next;
+  }
+
+  g_rec_mutex_unlock(sample_cache_mutex);
+
+  g_list_free(start_list);
+}
+
+void
+ags_sample_cache_remove_entry(AgsSampleCache *sample_cache,
+			      AgsSampleCacheEntry *sample_cache_entry,
+			      gboolean weak_unref)
+{
+  g_hash_table_remove(sample_cache->entry,
+		      sample_cache_entry);
+
+  g_queue_delete_link(sample_cache->lru,
+		      sample_cache_entry->lru_link);
+  sample_cache_entry->lru_link = NULL;
+
+  sample_cache->memory_used -= sample_cache_entry->size;
+
+  if(weak_unref){
+    g_object_weak_unref(sample_cache_entry->sample,
+			ags_sample_cache_sample_weak_notify,
+			sample_cache);
+  }
+
+  /* the key is meaningless from now on */
+  sample_cache_entry->sample = NULL;
+
+  ags_sample_cache_entry_unref(sample_cache_entry);
+}
+
+void
+ags_sample_cache_evict(AgsSampleCache *sample_cache)
+{
+  while(sample_cache->memory_used > sample_cache->memory_budget &&
+	sample_cache->lru->tail != NULL){
+    ags_sample_cache_remove_entry(sample_cache,
+				  sample_cache->lru->tail->data,
+				  TRUE);
+  }
+}
+
+/**
+ * ags_sample_cache_entry_ref:
+ * @sample_cache_entry: the #AgsSampleCacheEntry
+ *
+ * Increase reference count of @sample_cache_entry.
+ *
+ * Returns: the @sample_cache_entry
+ *
+ * Since: 3.7.0
+ */
+AgsSampleCacheEntry*
+ags_sample_cache_entry_ref(AgsSampleCacheEntry *sample_cache_entry)
+{
+  if(sample_cache_entry == NULL){
+    return(NULL);
+  }
+
+  g_atomic_int_inc(&(sample_cache_entry->ref_count));
+
+  return(sample_cache_entry);
+}
+
+/**
+ * ags_sample_cache_entry_unref:
+ * @sample_cache_entry: the #AgsSampleCacheEntry
+ *
+ * Decrease reference count of @sample_cache_entry, the data is freed as the
+ * last reference is dropped.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_sample_cache_entry_unref(AgsSampleCacheEntry *sample_cache_entry)
+{
+  if(sample_cache_entry == NULL){
+    return;
+  }
+
+  if(g_atomic_int_dec_and_test(&(sample_cache_entry->ref_count))){
+    ags_stream_free(sample_cache_entry->data);
+
+    g_free(sample_cache_entry);
+  }
+}
+
+AgsSampleCacheEntry*
+ags_sample_cache_lookup_entry(AgsSampleCache *sample_cache,
+			      GObject *sample,
+			      guint flags,
+			      guint samplerate, guint format,
+			      gdouble note)
+{
+  AgsSampleCacheEntry key;
+  AgsSampleCacheEntry *sample_cache_entry;
+
+  GRecMutex *sample_cache_mutex;
+
+  if(!AGS_IS_SAMPLE_CACHE(sample_cache) ||
+     sample == NULL){
+    return(NULL);
+  }
+
+  /* get sample cache mutex */
+  sample_cache_mutex = AGS_SAMPLE_CACHE_GET_OBJ_MUTEX(sample_cache);
+
+  key.flags = flags;
+  key.sample = sample;
+  key.samplerate = samplerate;
+  key.format = format;
+  key.note = note;
+
+  /* lookup */
+  g_rec_mutex_lock(sample_cache_mutex);
+
+  sample_cache_entry = g_hash_table_lookup(sample_cache->entry,
+					   &key);
+
+  if(sample_cache_entry != NULL){
+    g_queue_unlink(sample_cache->lru,
+		   sample_cache_entry->lru_link);
+    g_queue_push_head_link(sample_cache->lru,
+			   sample_cache_entry->lru_link);
+
+    ags_sample_cache_entry_ref(sample_cache_entry);
+  }
+
+  g_rec_mutex_unlock(sample_cache_mutex);
+
+  return(sample_cache_entry);
+}
+
+AgsSampleCacheEntry*
+ags_sample_cache_insert_entry(AgsSampleCache *sample_cache,
+			      GObject *sample,
+			      guint flags,
+			      guint samplerate, guint format,
+			      gdouble note,
+			      void *data, guint frame_count)
+{
+  AgsSampleCacheEntry *sample_cache_entry, *current;
+
+  GRecMutex *sample_cache_mutex;
+
+  if(!AGS_IS_SAMPLE_CACHE(sample_cache) ||
+     sample == NULL){
+    ags_stream_free(data);
+
+    return(NULL);
+  }
+
+  /* get sample cache mutex */
+  sample_cache_mutex = AGS_SAMPLE_CACHE_GET_OBJ_MUTEX(sample_cache);
+
+  sample_cache_entry = (AgsSampleCacheEntry *) g_malloc(sizeof(AgsSampleCacheEntry));
+
+  sample_cache_entry->ref_count = 1;
+
+  sample_cache_entry->flags = flags;
+
+  sample_cache_entry->sample = sample;
+
+  sample_cache_entry->samplerate = samplerate;
+  sample_cache_entry->format = format;
+  sample_cache_entry->note = note;
+
+  sample_cache_entry->data = data;
+  sample_cache_entry->frame_count = frame_count;
+
+  sample_cache_entry->size = frame_count * ags_sample_cache_get_word_size(format);
+
+  sample_cache_entry->lru_link = NULL;
+
+  /* insert */
+  g_rec_mutex_lock(sample_cache_mutex);
+
+  current = g_hash_table_lookup(sample_cache->entry,
+				sample_cache_entry);
+
+  if(current != NULL){
+    ags_sample_cache_entry_ref(current);
+
+    g_rec_mutex_unlock(sample_cache_mutex);
+
+    ags_sample_cache_entry_unref(sample_cache_entry);
+
+    return(current);
+  }
+
+  g_hash_table_add(sample_cache->entry,
+		   sample_cache_entry);
+
+  g_queue_push_head(sample_cache->lru,
+		    sample_cache_entry);
+  sample_cache_entry->lru_link = sample_cache->lru->head;
+
+  sample_cache->memory_used += sample_cache_entry->size;
+
+  g_object_weak_ref(sample,
+		    ags_sample_cache_sample_weak_notify,
+		    sample_cache);
+
+  /* the caller's reference keeps the data alive even if evicted right away */
+  ags_sample_cache_entry_ref(sample_cache_entry);
+
+  ags_sample_cache_evict(sample_cache);
+
+  g_rec_mutex_unlock(sample_cache_mutex);
+
+  return(sample_cache_entry);
+}
+
+/**
+ * ags_sample_cache_lookup:
+ * @sample_cache: the #AgsSampleCache
+ * @sample: the sample, either #AgsIpatchSample or #AgsSFZSample
+ * @samplerate: the samplerate
+ * @format: the format
+ * @note: the note
+ *
+ * Lookup the pitched data of @sample rendered with @samplerate, @format and
+ * @note. A hit becomes the most recently used entry.
+ *
+ * Returns: (transfer full): the #AgsSampleCacheEntry or %NULL, release it with ags_sample_cache_entry_unref()
+ *
+ * Since: 3.7.0
+ */
+AgsSampleCacheEntry*
+ags_sample_cache_lookup(AgsSampleCache *sample_cache,
+			GObject *sample,
+			guint samplerate, guint format,
+			gdouble note)
+{
+  return(ags_sample_cache_lookup_entry(sample_cache,
+				       sample,
+				       0,
+				       samplerate, format,
+				       note));
+}
+
+/**
+ * ags_sample_cache_insert:
+ * @sample_cache: the #AgsSampleCache
+ * @sample: the sample, either #AgsIpatchSample or #AgsSFZSample
+ * @samplerate: the samplerate
+ * @format: the format
+ * @note: the note
+ * @data: (transfer full): the data allocated with ags_stream_alloc()
+ * @frame_count: the frame count of @data
+ *
+ * Insert @data as pitched rendering of @sample. If an other thread inserted
+ * the same key meanwhile, @data is freed and the existing entry is returned.
+ * Least recently used entries are evicted to stay within the memory budget.
+ *
+ * Returns: (transfer full): the #AgsSampleCacheEntry, release it with ags_sample_cache_entry_unref()
+ *
+ * Since: 3.7.0
+ */
+AgsSampleCacheEntry*
+ags_sample_cache_insert(AgsSampleCache *sample_cache,
+			GObject *sample,
+			guint samplerate, guint format,
+			gdouble note,
+			void *data, guint frame_count)
+{
+  return(ags_sample_cache_insert_entry(sample_cache,
+				       sample,
+				       0,
+				       samplerate, format,
+				       note,
+				       data, frame_count));
+}
+
+/**
+ * ags_sample_cache_lookup_decoded:
+ * @sample_cache: the #AgsSampleCache
+ * @sample: the sample, either #AgsIpatchSample or #AgsSFZSample
+ * @samplerate: the samplerate
+ *
+ * Lookup the decoded data of @sample resampled to @samplerate, the data is
+ * of format %AGS_SOUNDCARD_DOUBLE and independent of the note. A hit
+ * becomes the most recently used entry.
+ *
+ * Returns: (transfer full): the #AgsSampleCacheEntry or %NULL, release it with ags_sample_cache_entry_unref()
+ *
+ * Since: 3.7.0
+ */
+AgsSampleCacheEntry*
+ags_sample_cache_lookup_decoded(AgsSampleCache *sample_cache,
+				GObject *sample,
+				guint samplerate)
+{
+  return(ags_sample_cache_lookup_entry(sample_cache,
+				       sample,
+				       AGS_SAMPLE_CACHE_ENTRY_DECODED,
+				       samplerate, AGS_SOUNDCARD_DOUBLE,
+				       0.0));
+}
+
+/**
+ * ags_sample_cache_insert_decoded:
+ * @sample_cache: the #AgsSampleCache
+ * @sample: the sample, either #AgsIpatchSample or #AgsSFZSample
+ * @samplerate: the samplerate
+ * @data: (transfer full): the data of format %AGS_SOUNDCARD_DOUBLE allocated with ags_stream_alloc()
+ * @frame_count: the frame count of @data
+ *
+ * Insert @data as decoded @sample resampled to @samplerate. It is charged to
+ * the same memory budget as the pitched entries. If an other thread inserted
+ * it meanwhile, @data is freed and the existing entry is returned.
+ *
+ * Returns: (transfer full): the #AgsSampleCacheEntry, release it with ags_sample_cache_entry_unref()
+ *
+ * Since: 3.7.0
+ */
+AgsSampleCacheEntry*
+ags_sample_cache_insert_decoded(AgsSampleCache *sample_cache,
+				GObject *sample,
+				guint samplerate,
+				void *data, guint frame_count)
+{
+  return(ags_sample_cache_insert_entry(sample_cache,
+				       sample,
+				       AGS_SAMPLE_CACHE_ENTRY_DECODED,
+				       samplerate, AGS_SOUNDCARD_DOUBLE,
+				       0.0,
+				       data, frame_count));
+}
+
+/**
+ * ags_sample_cache_remove_sample:
+ * @sample_cache: the #AgsSampleCache
+ * @sample: the sample
+ *
+ * Remove all entries of @sample, call it after modifying the sample data.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_sample_cache_remove_sample(AgsSampleCache *sample_cache,
+			       GObject *sample)
+{
+  GList *start_list, *list;
+
+  GRecMutex *sample_cache_mutex;
+
+  if(!AGS_IS_SAMPLE_CACHE(sample_cache) ||
+     sample == NULL){
+    return;
+  }
+
+  /* get sample cache mutex */
+  sample_cache_mutex = AGS_SAMPLE_CACHE_GET_OBJ_MUTEX(sample_cache);
+
+  /* remove */
+  g_rec_mutex_lock(sample_cache_mutex);
+
+  list =
+    start_list = g_list_copy(sample_cache->lru->head);
+
+  while(list != NULL){
+    AgsSampleCacheEntry *sample_cache_entry;
+
+    sample_cache_entry = list->data;
+
+    if(sample_cache_entry->sample == sample){
+      ags_sample_cache_remove_entry(sample_cache,
+				    sample_cache_entry,
+				    TRUE);
+    }
+
+    list = list->next;
+  }
+
+  g_rec_mutex_unlock(sample_cache_mutex);
+
+  g_list_free(start_list);
+}
+
+/**
+ * ags_sample_cache_clear:
+ * @sample_cache: the #AgsSampleCache
+ *
+ * Remove all entries of @sample_cache.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_sample_cache_clear(AgsSampleCache *sample_cache)
+{
+  GRecMutex *sample_cache_mutex;
+
+  if(!AGS_IS_SAMPLE_CACHE(sample_cache)){
+    return;
+  }
+
+  /* get sample cache mutex */
+  sample_cache_mutex = AGS_SAMPLE_CACHE_GET_OBJ_MUTEX(sample_cache);
+
+  /* clear */
+  g_rec_mutex_lock(sample_cache_mutex);
+
+  while(sample_cache->lru->tail != NULL){
+    ags_sample_cache_remove_entry(sample_cache,
+				  sample_cache->lru->tail->data,
+				  TRUE);
+  }
+
+  g_rec_mutex_unlock(sample_cache_mutex);
+}
+
+/**
+ * ags_sample_cache_get_instance:
+ *
+ * Get instance.
+ *
+ * Returns: (transfer none): the #AgsSampleCache
+ *
+ * Since: 3.7.0
+ */
+AgsSampleCache*
+ags_sample_cache_get_instance()
+{
+  static GMutex mutex;
+
+  g_mutex_lock(&mutex);
+
+  if(ags_sample_cache == NULL){
+    ags_sample_cache = ags_sample_cache_new();
+  }
+
+  g_mutex_unlock(&mutex);
+
+  return(ags_sample_cache);
+}
+
+/**
+ * ags_sample_cache_new:
+ *
+ * Create a new instance of #AgsSampleCache.
+ *
+ * Returns: the new #AgsSampleCache
+ *
+ * Since: 3.7.0
+ */
+AgsSampleCache*
+ags_sample_cache_new()
+{
+  AgsSampleCache *sample_cache;
+
+  sample_cache = (AgsSampleCache *) g_object_new(AGS_TYPE_SAMPLE_CACHE,
+						 NULL);
+
+  return(sample_cache);
+}
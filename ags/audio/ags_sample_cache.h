@@ -0,0 +1,129 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __AGS_SAMPLE_CACHE_H__
+#define __AGS_SAMPLE_CACHE_H__
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <ags/libags.h>
+
+G_BEGIN_DECLS
+
+#define AGS_TYPE_SAMPLE_CACHE                (ags_sample_cache_get_type())
+#define AGS_SAMPLE_CACHE(obj)                (G_TYPE_CHECK_INSTANCE_CAST((obj), AGS_TYPE_SAMPLE_CACHE, AgsSampleCache))
+#define AGS_SAMPLE_CACHE_CLASS(class)        (G_TYPE_CHECK_CLASS_CAST((class), AGS_TYPE_SAMPLE_CACHE, AgsSampleCacheClass))
+#define AGS_IS_SAMPLE_CACHE(obj)             (G_TYPE_CHECK_INSTANCE_TYPE ((obj), AGS_TYPE_SAMPLE_CACHE))
+#define AGS_IS_SAMPLE_CACHE_CLASS(class)     (G_TYPE_CHECK_CLASS_TYPE ((class), AGS_TYPE_SAMPLE_CACHE))
+#define AGS_SAMPLE_CACHE_GET_CLASS(obj)      (G_TYPE_INSTANCE_GET_CLASS (obj, AGS_TYPE_SAMPLE_CACHE, AgsSampleCacheClass))
+
+#define AGS_SAMPLE_CACHE_GET_OBJ_MUTEX(obj) (&(((AgsSampleCache *) obj)->obj_mutex))
+
+#define AGS_SAMPLE_CACHE_DEFAULT_MEMORY_BUDGET (64 * 1024 * 1024)
+
+typedef struct _AgsSampleCache AgsSampleCache;
+typedef struct _AgsSampleCacheClass AgsSampleCacheClass;
+typedef struct _AgsSampleCacheEntry AgsSampleCacheEntry;
+
+/**
+ * AgsSampleCacheEntryFlags:
+ * @AGS_SAMPLE_CACHE_ENTRY_DECODED: the entry is the decoded and resampled sample as double, shared by all notes
+ *
+ * Enum values to control the behavior or indicate internal state of #AgsSampleCacheEntry by
+ * enable/disable as flags.
+ */
+typedef enum{
+  AGS_SAMPLE_CACHE_ENTRY_DECODED   = 1,
+}AgsSampleCacheEntryFlags;
+
+struct _AgsSampleCache
+{
+  GObject gobject;
+
+  guint flags;
+
+  GRecMutex obj_mutex;
+
+  guint64 memory_budget;
+  guint64 memory_used;
+
+  GHashTable *entry;
+  GQueue *lru;
+};
+
+struct _AgsSampleCacheClass
+{
+  GObjectClass gobject;
+};
+
+struct _AgsSampleCacheEntry
+{
+  volatile gint ref_count;
+
+  guint flags;
+
+  GObject *sample;
+
+  guint samplerate;
+  guint format;
+  gdouble note;
+
+  void *data;
+  guint frame_count;
+
+  guint64 size;
+
+  GList *lru_link;
+};
+
+GType ags_sample_cache_get_type(void);
+
+AgsSampleCacheEntry* ags_sample_cache_entry_ref(AgsSampleCacheEntry *sample_cache_entry);
+void ags_sample_cache_entry_unref(AgsSampleCacheEntry *sample_cache_entry);
+
+AgsSampleCacheEntry* ags_sample_cache_lookup(AgsSampleCache *sample_cache,
+					     GObject *sample,
+					     guint samplerate, guint format,
+					     gdouble note);
+AgsSampleCacheEntry* ags_sample_cache_insert(AgsSampleCache *sample_cache,
+					     GObject *sample,
+					     guint samplerate, guint format,
+					     gdouble note,
+					     void *data, guint frame_count);
+
+AgsSampleCacheEntry* ags_sample_cache_lookup_decoded(AgsSampleCache *sample_cache,
+						     GObject *sample,
+						     guint samplerate);
+AgsSampleCacheEntry* ags_sample_cache_insert_decoded(AgsSampleCache *sample_cache,
+						     GObject *sample,
+						     guint samplerate,
+						     void *data, guint frame_count);
+
+void ags_sample_cache_remove_sample(AgsSampleCache *sample_cache,
+				    GObject *sample);
+void ags_sample_cache_clear(AgsSampleCache *sample_cache);
+
+AgsSampleCache* ags_sample_cache_get_instance();
+
+AgsSampleCache* ags_sample_cache_new();
+
+G_END_DECLS
+
+#endif /*__AGS_SAMPLE_CACHE_H__*/
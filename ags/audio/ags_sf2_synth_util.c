@@ -23,6 +23,7 @@
 #include <ags/audio/ags_audio_signal.h>
 #include <ags/audio/ags_audio_buffer_util.h>
 #include <ags/audio/ags_fast_pitch_util.h>
+#include <ags/audio/ags_sample_cache.h>
 
 #include <ags/audio/file/ags_sound_container.h>
 #include <ags/audio/file/ags_sound_resource.h>
@@ -32,6 +33,9 @@
 #include <math.h>
 #include <complex.h>
 
+AgsSampleCacheEntry* ags_sf2_synth_util_get_decoded(AgsIpatchSample *ipatch_sample,
+						    guint samplerate);
+
 /**
  * SECTION:ags_sf2_synth_util
  * @short_description: frequency modulation synth util
@@ -218,6 +222,113 @@ ags_sf2_synth_util_midi_locale_find_sample_near_midi_key(AgsIpatch *ipatch,
   return(ipatch_sample);
 }
 
+AgsSampleCacheEntry*
+ags_sf2_synth_util_get_decoded(AgsIpatchSample *ipatch_sample,
+			       guint samplerate)
+{
+  AgsSampleCache *sample_cache;
+  AgsSampleCacheEntry *sample_cache_entry;
+
+  void *sample_buffer;
+
+  guint frame_count;
+  guint source_frame_count;
+  guint source_samplerate;
+  guint source_buffer_size;
+  guint source_format;
+
+  GRecMutex *ipatch_sample_mutex;
+
+  sample_cache = ags_sample_cache_get_instance();
+
+  ipatch_sample_mutex = AGS_IPATCH_SAMPLE_GET_OBJ_MUTEX(ipatch_sample);
+
+  /* lookup decoded and resampled sample */
+  sample_cache_entry = ags_sample_cache_lookup_decoded(sample_cache,
+						       (GObject *) ipatch_sample,
+						       samplerate);
+
+  if(sample_cache_entry != NULL){
+    return(sample_cache_entry);
+  }
+
+  /* decode single-flight, the read shares the buffer of the sample */
+  g_rec_mutex_lock(ipatch_sample_mutex);
+
+  sample_cache_entry = ags_sample_cache_lookup_decoded(sample_cache,
+						       (GObject *) ipatch_sample,
+						       samplerate);
+
+  if(sample_cache_entry == NULL){
+    source_frame_count = 0;
+
+    source_samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
+    source_buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
+    source_format = AGS_SOUNDCARD_DEFAULT_FORMAT;  
+  
+    ags_sound_resource_info(AGS_SOUND_RESOURCE(ipatch_sample),
+			    &source_frame_count,
+			    NULL, NULL);
+
+    ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(ipatch_sample),
+				   NULL,
+				   &source_samplerate,
+				   &source_buffer_size,
+				   &source_format);
+
+    sample_buffer = ags_stream_alloc(source_frame_count,
+				     AGS_SOUNDCARD_DOUBLE);
+
+    ags_stream_free(ipatch_sample->buffer);
+  
+    ipatch_sample->buffer = ags_stream_alloc(ipatch_sample->audio_channels * source_frame_count,
+					     ipatch_sample->format);
+  
+    ipatch_sample->offset = 0;
+
+    ags_sound_resource_read(AGS_SOUND_RESOURCE(ipatch_sample),
+			    sample_buffer, 1,
+			    0,
+			    source_frame_count, AGS_SOUNDCARD_DOUBLE);
+
+    /* resample if needed */
+    frame_count = source_frame_count;
+  
+    if(source_samplerate != samplerate){
+      void *tmp_sample_buffer;
+
+      guint tmp_frame_count;
+
+      tmp_frame_count = (guint) ceil((gdouble) samplerate / (gdouble) source_samplerate * (gdouble) source_frame_count);
+
+      tmp_sample_buffer = ags_stream_alloc(tmp_frame_count,
+					   AGS_SOUNDCARD_DOUBLE);
+
+      ags_audio_buffer_util_resample_with_buffer(sample_buffer, 1,
+						 AGS_AUDIO_BUFFER_UTIL_DOUBLE, source_samplerate,
+						 source_frame_count,
+						 samplerate,
+						 tmp_frame_count,
+						 tmp_sample_buffer);
+    
+      ags_stream_free(sample_buffer);
+
+      sample_buffer = tmp_sample_buffer;
+    
+      frame_count = tmp_frame_count;
+    }
+
+    sample_cache_entry = ags_sample_cache_insert_decoded(sample_cache,
+							 (GObject *) ipatch_sample,
+							 samplerate,
+							 sample_buffer, frame_count);
+  }
+
+  g_rec_mutex_unlock(ipatch_sample_mutex);
+
+  return(sample_cache_entry);
+}
+
 /**
  * ags_sf2_synth_util_copy_s8:
  * @buffer: the audio buffer
@@ -247,7 +358,8 @@ ags_sf2_synth_util_copy_s8(gint8 *buffer,
 			   guint loop_mode,
 			   gint loop_start, gint loop_end)
 {
-  void *sample_buffer;
+  AgsSampleCache *sample_cache;
+  AgsSampleCacheEntry *sample_cache_entry;
 
   gint8 *im_buffer;
 
@@ -255,110 +367,77 @@ ags_sf2_synth_util_copy_s8(gint8 *buffer,
   guint frame_count;
   gdouble base_key;
   gdouble tuning;
-  guint source_frame_count;
-  guint source_samplerate;
-  guint source_buffer_size;
-  guint source_format;
   guint copy_mode;
 
   guint i0, i1, i2;
   gboolean success;
   gboolean pong_copy;
 
-  source_frame_count = 0;
-
-  source_samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
-  source_buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
-  source_format = AGS_SOUNDCARD_DEFAULT_FORMAT;  
-  
-  ags_sound_resource_info(AGS_SOUND_RESOURCE(ipatch_sample),
-			  &source_frame_count,
-			  NULL, NULL);
-
-  ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(ipatch_sample),
-				 NULL,
-				 &source_samplerate,
-				 &source_buffer_size,
-				 &source_format);
-
-  sample_buffer = ags_stream_alloc(source_frame_count,
-				   AGS_SOUNDCARD_DOUBLE);
-
-  ags_stream_free(ipatch_sample->buffer);
-  
-  ipatch_sample->buffer = ags_stream_alloc(ipatch_sample->audio_channels * source_frame_count,
-					   ipatch_sample->format);
-  
-  ipatch_sample->offset = 0;
-
-  ags_sound_resource_read(AGS_SOUND_RESOURCE(ipatch_sample),
-			  sample_buffer, 1,
-			  0,
-			  source_frame_count, AGS_SOUNDCARD_DOUBLE);
-
-  /* resample if needed */
-  frame_count = source_frame_count;
-  
-  if(source_samplerate != samplerate){
-    void *tmp_sample_buffer;
+  sample_cache = ags_sample_cache_get_instance();
 
-    guint tmp_frame_count;
+  /* lookup resampled and pitched sample */
+  sample_cache_entry = ags_sample_cache_lookup(sample_cache,
+					       (GObject *) ipatch_sample,
+					       samplerate, AGS_SOUNDCARD_SIGNED_8_BIT,
+					       note);
 
-    tmp_frame_count = (samplerate / source_samplerate) * source_frame_count;
+  if(sample_cache_entry == NULL){
+    AgsSampleCacheEntry *decoded_entry;
 
-    tmp_sample_buffer = ags_stream_alloc(tmp_frame_count,
-					 AGS_SOUNDCARD_DOUBLE);
+    /* the decoded and resampled sample is shared by all notes */
+    decoded_entry = ags_sf2_synth_util_get_decoded(ipatch_sample,
+						   samplerate);
 
-    ags_audio_buffer_util_resample_with_buffer(sample_buffer, 1,
-					       AGS_AUDIO_BUFFER_UTIL_DOUBLE, source_samplerate,
-					       source_frame_count,
-					       samplerate,
-					       tmp_frame_count,
-					       tmp_sample_buffer);
-    
-    ags_stream_free(sample_buffer);
+    frame_count = decoded_entry->frame_count;
 
-    sample_buffer = tmp_sample_buffer;
-    
-    frame_count = tmp_frame_count;
-  }
+    /* format a private copy */
+    im_buffer = ags_stream_alloc(frame_count,
+				 AGS_SOUNDCARD_SIGNED_8_BIT);
 
-  /* format */
-  im_buffer = ags_stream_alloc(frame_count,
-			       AGS_SOUNDCARD_SIGNED_8_BIT);
+    copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_S8,
+						    AGS_AUDIO_BUFFER_UTIL_DOUBLE);
 
-  copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_S8,
-						  AGS_AUDIO_BUFFER_UTIL_DOUBLE);
+    ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
+						decoded_entry->data, 1, 0,
+						frame_count, copy_mode);
 
-  ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
-					      sample_buffer, 1, 0,
-					      frame_count, copy_mode);
+    ags_sample_cache_entry_unref(decoded_entry);
 
-  /* pitch */
-  midi_key = 60;
+    /* pitch without holding any lock */
+    midi_key = 60;
   
-  if(ipatch_sample->sample != NULL){
-    gint tmp_midi_key;
+    if(ipatch_sample->sample != NULL){
+      gint tmp_midi_key;
     
-    g_object_get(ipatch_sample->sample,
-		 "root-note", &tmp_midi_key,
-		 NULL);
+      g_object_get(ipatch_sample->sample,
+		   "root-note", &tmp_midi_key,
+		   NULL);
 
-    if(tmp_midi_key >= 0 &&
-       tmp_midi_key < 128){
-      midi_key = tmp_midi_key;
+      if(tmp_midi_key >= 0 &&
+	 tmp_midi_key < 128){
+	midi_key = tmp_midi_key;
+      }
     }
-  }
   
-  base_key = (gdouble) midi_key - 21.0;
+    base_key = (gdouble) midi_key - 21.0;
 
-  tuning = 100.0 * (note - base_key);
+    tuning = 100.0 * (note - base_key);
   
-  ags_fast_pitch_util_compute_s8(im_buffer,
-				 frame_count,
-				 samplerate,
-				 base_key,
-				 tuning);
+    ags_fast_pitch_util_compute_s8(im_buffer,
+				   frame_count,
+				   samplerate,
+				   base_key,
+				   tuning);
+
+    sample_cache_entry = ags_sample_cache_insert(sample_cache,
+						 (GObject *) ipatch_sample,
+						 samplerate, AGS_SOUNDCARD_SIGNED_8_BIT,
+						 note,
+						 im_buffer, frame_count);
+  }
+
+  im_buffer = sample_cache_entry->data;
+  frame_count = sample_cache_entry->frame_count;
 
   success = FALSE;
   pong_copy = FALSE;
@@ -483,8 +562,7 @@ ags_sf2_synth_util_copy_s8(gint8 *buffer,
     }
   }
   
-  ags_stream_free(sample_buffer);
-  ags_stream_free(im_buffer);
+  ags_sample_cache_entry_unref(sample_cache_entry);
 }
 
 /**
@@ -516,7 +594,8 @@ ags_sf2_synth_util_copy_s16(gint16 *buffer,
 			    guint loop_mode,
 			    gint loop_start, gint loop_end)
 {
-  void *sample_buffer;
+  AgsSampleCache *sample_cache;
+  AgsSampleCacheEntry *sample_cache_entry;
 
   gint16 *im_buffer;
 
@@ -524,110 +603,77 @@ ags_sf2_synth_util_copy_s16(gint16 *buffer,
   guint frame_count;
   gdouble base_key;
   gdouble tuning;
-  guint source_frame_count;
-  guint source_samplerate;
-  guint source_buffer_size;
-  guint source_format;
   guint copy_mode;
 
   guint i0, i1, i2;
   gboolean success;
   gboolean pong_copy;
 
-  source_frame_count = 0;
+  sample_cache = ags_sample_cache_get_instance();
 
-  source_samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
-  source_buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
-  source_format = AGS_SOUNDCARD_DEFAULT_FORMAT;  
-  
-  ags_sound_resource_info(AGS_SOUND_RESOURCE(ipatch_sample),
-			  &source_frame_count,
-			  NULL, NULL);
+  /* lookup resampled and pitched sample */
+  sample_cache_entry = ags_sample_cache_lookup(sample_cache,
+					       (GObject *) ipatch_sample,
+					       samplerate, AGS_SOUNDCARD_SIGNED_16_BIT,
+					       note);
 
-  ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(ipatch_sample),
-				 NULL,
-				 &source_samplerate,
-				 &source_buffer_size,
-				 &source_format);
+  if(sample_cache_entry == NULL){
+    AgsSampleCacheEntry *decoded_entry;
 
-  sample_buffer = ags_stream_alloc(source_frame_count,
-				   AGS_SOUNDCARD_DOUBLE);
+    /* the decoded and resampled sample is shared by all notes */
+    decoded_entry = ags_sf2_synth_util_get_decoded(ipatch_sample,
+						   samplerate);
 
-  ags_stream_free(ipatch_sample->buffer);
-  
-  ipatch_sample->buffer = ags_stream_alloc(ipatch_sample->audio_channels * source_frame_count,
-					   ipatch_sample->format);
-  
-  ipatch_sample->offset = 0;
-  
-  ags_sound_resource_read(AGS_SOUND_RESOURCE(ipatch_sample),
-			  sample_buffer, 1,
-			  0,
-			  source_frame_count, AGS_SOUNDCARD_DOUBLE);
-
-  /* resample if needed */
-  frame_count = source_frame_count;
-  
-  if(source_samplerate != samplerate){
-    void *tmp_sample_buffer;
-
-    guint tmp_frame_count;
+    frame_count = decoded_entry->frame_count;
 
-    tmp_frame_count = (samplerate / source_samplerate) * source_frame_count;
+    /* format a private copy */
+    im_buffer = ags_stream_alloc(frame_count,
+				 AGS_SOUNDCARD_SIGNED_16_BIT);
 
-    tmp_sample_buffer = ags_stream_alloc(tmp_frame_count,
-					 AGS_SOUNDCARD_DOUBLE);
+    copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_S16,
+						    AGS_AUDIO_BUFFER_UTIL_DOUBLE);
 
-    ags_audio_buffer_util_resample_with_buffer(sample_buffer, 1,
-					       AGS_AUDIO_BUFFER_UTIL_DOUBLE, source_samplerate,
-					       source_frame_count,
-					       samplerate,
-					       tmp_frame_count,
-					       tmp_sample_buffer);
-    
-    ags_stream_free(sample_buffer);
-
-    sample_buffer = tmp_sample_buffer;
-    
-    frame_count = tmp_frame_count;
-  }
+    ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
+						decoded_entry->data, 1, 0,
+						frame_count, copy_mode);
 
-  /* format */
-  im_buffer = ags_stream_alloc(frame_count,
-			       AGS_SOUNDCARD_SIGNED_16_BIT);
+    ags_sample_cache_entry_unref(decoded_entry);
 
-  copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_S16,
-						  AGS_AUDIO_BUFFER_UTIL_DOUBLE);
-
-  ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
-					      sample_buffer, 1, 0,
-					      frame_count, copy_mode);
-
-  /* pitch */
-  midi_key = 60;
+    /* pitch without holding any lock */
+    midi_key = 60;
   
-  if(ipatch_sample->sample != NULL){
-    gint tmp_midi_key;
+    if(ipatch_sample->sample != NULL){
+      gint tmp_midi_key;
     
-    g_object_get(ipatch_sample->sample,
-		 "root-note", &tmp_midi_key,
-		 NULL);
+      g_object_get(ipatch_sample->sample,
+		   "root-note", &tmp_midi_key,
+		   NULL);
     
-    if(tmp_midi_key >= 0 &&
-       tmp_midi_key < 128){
-      midi_key = tmp_midi_key;
+      if(tmp_midi_key >= 0 &&
+	 tmp_midi_key < 128){
+	midi_key = tmp_midi_key;
+      }
     }
-  }
   
-  base_key = (gdouble) midi_key - 21.0;
+    base_key = (gdouble) midi_key - 21.0;
 
-  tuning = 100.0 * (note - base_key);
+    tuning = 100.0 * (note - base_key);
 
-  ags_fast_pitch_util_compute_s16(im_buffer,
-				  frame_count,
-				  samplerate,
-				  base_key,
-				  tuning);
+    ags_fast_pitch_util_compute_s16(im_buffer,
+				    frame_count,
+				    samplerate,
+				    base_key,
+				    tuning);
+
+    sample_cache_entry = ags_sample_cache_insert(sample_cache,
+						 (GObject *) ipatch_sample,
+						 samplerate, AGS_SOUNDCARD_SIGNED_16_BIT,
+						 note,
+						 im_buffer, frame_count);
+  }
+
+  im_buffer = sample_cache_entry->data;
+  frame_count = sample_cache_entry->frame_count;
 
   success = FALSE;
   pong_copy = FALSE;
@@ -752,8 +798,7 @@ ags_sf2_synth_util_copy_s16(gint16 *buffer,
     }
   }
   
-  ags_stream_free(sample_buffer);
-  ags_stream_free(im_buffer);
+  ags_sample_cache_entry_unref(sample_cache_entry);
 }
 
 /**
@@ -785,7 +830,8 @@ ags_sf2_synth_util_copy_s24(gint32 *buffer,
 			    guint loop_mode,
 			    gint loop_start, gint loop_end)
 {
-  void *sample_buffer;
+  AgsSampleCache *sample_cache;
+  AgsSampleCacheEntry *sample_cache_entry;
 
   gint32 *im_buffer;
 
@@ -793,110 +839,77 @@ ags_sf2_synth_util_copy_s24(gint32 *buffer,
   guint frame_count;
   gdouble base_key;
   gdouble tuning;
-  guint source_frame_count;
-  guint source_samplerate;
-  guint source_buffer_size;
-  guint source_format;
   guint copy_mode;
 
   guint i0, i1, i2;
   gboolean success;
   gboolean pong_copy;
-  
-  source_frame_count = 0;
-
-  source_samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
-  source_buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
-  source_format = AGS_SOUNDCARD_DEFAULT_FORMAT;  
-
-  ags_sound_resource_info(AGS_SOUND_RESOURCE(ipatch_sample),
-			  &source_frame_count,
-			  NULL, NULL);
-
-  ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(ipatch_sample),
-				 NULL,
-				 &source_samplerate,
-				 &source_buffer_size,
-				 &source_format);
-
-  sample_buffer = ags_stream_alloc(source_frame_count,
-				   AGS_SOUNDCARD_DOUBLE);
-
-  ags_stream_free(ipatch_sample->buffer);
-  
-  ipatch_sample->buffer = ags_stream_alloc(ipatch_sample->audio_channels * source_frame_count,
-					   ipatch_sample->format);
-  
-  ipatch_sample->offset = 0;
-
-  ags_sound_resource_read(AGS_SOUND_RESOURCE(ipatch_sample),
-			  sample_buffer, 1,
-			  0,
-			  source_frame_count, AGS_SOUNDCARD_DOUBLE);
 
-  /* resample if needed */
-  frame_count = source_frame_count;
-  
-  if(source_samplerate != samplerate){
-    void *tmp_sample_buffer;
+  sample_cache = ags_sample_cache_get_instance();
 
-    guint tmp_frame_count;
+  /* lookup resampled and pitched sample */
+  sample_cache_entry = ags_sample_cache_lookup(sample_cache,
+					       (GObject *) ipatch_sample,
+					       samplerate, AGS_SOUNDCARD_SIGNED_24_BIT,
+					       note);
 
-    tmp_frame_count = (samplerate / source_samplerate) * source_frame_count;
+  if(sample_cache_entry == NULL){
+    AgsSampleCacheEntry *decoded_entry;
 
-    tmp_sample_buffer = ags_stream_alloc(tmp_frame_count,
-					 AGS_SOUNDCARD_DOUBLE);
+    /* the decoded and resampled sample is shared by all notes */
+    decoded_entry = ags_sf2_synth_util_get_decoded(ipatch_sample,
+						   samplerate);
 
-    ags_audio_buffer_util_resample_with_buffer(sample_buffer, 1,
-					       AGS_AUDIO_BUFFER_UTIL_DOUBLE, source_samplerate,
-					       source_frame_count,
-					       samplerate,
-					       tmp_frame_count,
-					       tmp_sample_buffer);
-    
-    ags_stream_free(sample_buffer);
+    frame_count = decoded_entry->frame_count;
 
-    sample_buffer = tmp_sample_buffer;
-    
-    frame_count = tmp_frame_count;
-  }
+    /* format a private copy */
+    im_buffer = ags_stream_alloc(frame_count,
+				 AGS_SOUNDCARD_SIGNED_24_BIT);
 
-  /* format */
-  im_buffer = ags_stream_alloc(frame_count,
-			       AGS_SOUNDCARD_SIGNED_24_BIT);
+    copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_S24,
+						    AGS_AUDIO_BUFFER_UTIL_DOUBLE);
 
-  copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_S24,
-						  AGS_AUDIO_BUFFER_UTIL_DOUBLE);
+    ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
+						decoded_entry->data, 1, 0,
+						frame_count, copy_mode);
 
-  ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
-					      sample_buffer, 1, 0,
-					      frame_count, copy_mode);
+    ags_sample_cache_entry_unref(decoded_entry);
 
-  /* pitch */
-  midi_key = 60;
+    /* pitch without holding any lock */
+    midi_key = 60;
   
-  if(ipatch_sample->sample != NULL){
-    gint tmp_midi_key;
+    if(ipatch_sample->sample != NULL){
+      gint tmp_midi_key;
     
-    g_object_get(ipatch_sample->sample,
-		 "root-note", &tmp_midi_key,
-		 NULL);
+      g_object_get(ipatch_sample->sample,
+		   "root-note", &tmp_midi_key,
+		   NULL);
 
-    if(tmp_midi_key >= 0 &&
-       tmp_midi_key < 128){
-      midi_key = tmp_midi_key;
+      if(tmp_midi_key >= 0 &&
+	 tmp_midi_key < 128){
+	midi_key = tmp_midi_key;
+      }
     }
-  }
   
-  base_key = (gdouble) midi_key - 21.0;
+    base_key = (gdouble) midi_key - 21.0;
 
-  tuning = 100.0 * (note - base_key);
+    tuning = 100.0 * (note - base_key);
   
-  ags_fast_pitch_util_compute_s24(im_buffer,
-				  frame_count,
-				  samplerate,
-				  base_key,
-				  tuning);
+    ags_fast_pitch_util_compute_s24(im_buffer,
+				    frame_count,
+				    samplerate,
+				    base_key,
+				    tuning);
+
+    sample_cache_entry = ags_sample_cache_insert(sample_cache,
+						 (GObject *) ipatch_sample,
+						 samplerate, AGS_SOUNDCARD_SIGNED_24_BIT,
+						 note,
+						 im_buffer, frame_count);
+  }
+
+  im_buffer = sample_cache_entry->data;
+  frame_count = sample_cache_entry->frame_count;
 
   success = FALSE;
   pong_copy = FALSE;
@@ -1021,8 +1034,7 @@ ags_sf2_synth_util_copy_s24(gint32 *buffer,
     }
   }
   
-  ags_stream_free(sample_buffer);
-  ags_stream_free(im_buffer);
+  ags_sample_cache_entry_unref(sample_cache_entry);
 }
 
 /**
@@ -1054,7 +1066,8 @@ ags_sf2_synth_util_copy_s32(gint32 *buffer,
 			    guint loop_mode,
 			    gint loop_start, gint loop_end)
 {
-  void *sample_buffer;
+  AgsSampleCache *sample_cache;
+  AgsSampleCacheEntry *sample_cache_entry;
 
   gint32 *im_buffer;
 
@@ -1062,110 +1075,77 @@ ags_sf2_synth_util_copy_s32(gint32 *buffer,
   guint frame_count;
   gdouble base_key;
   gdouble tuning;
-  guint source_frame_count;
-  guint source_samplerate;
-  guint source_buffer_size;
-  guint source_format;
   guint copy_mode;
 
   guint i0, i1, i2;
   gboolean success;
   gboolean pong_copy;
-  
-  source_frame_count = 0;
 
-  source_samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
-  source_buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
-  source_format = AGS_SOUNDCARD_DEFAULT_FORMAT;  
+  sample_cache = ags_sample_cache_get_instance();
 
-  ags_sound_resource_info(AGS_SOUND_RESOURCE(ipatch_sample),
-			  &source_frame_count,
-			  NULL, NULL);
+  /* lookup resampled and pitched sample */
+  sample_cache_entry = ags_sample_cache_lookup(sample_cache,
+					       (GObject *) ipatch_sample,
+					       samplerate, AGS_SOUNDCARD_SIGNED_32_BIT,
+					       note);
 
-  ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(ipatch_sample),
-				 NULL,
-				 &source_samplerate,
-				 &source_buffer_size,
-				 &source_format);
+  if(sample_cache_entry == NULL){
+    AgsSampleCacheEntry *decoded_entry;
 
-  sample_buffer = ags_stream_alloc(source_frame_count,
-				   AGS_SOUNDCARD_DOUBLE);
+    /* the decoded and resampled sample is shared by all notes */
+    decoded_entry = ags_sf2_synth_util_get_decoded(ipatch_sample,
+						   samplerate);
 
-  ags_stream_free(ipatch_sample->buffer);
-  
-  ipatch_sample->buffer = ags_stream_alloc(ipatch_sample->audio_channels * source_frame_count,
-					   ipatch_sample->format);
-  
-  ipatch_sample->offset = 0;
+    frame_count = decoded_entry->frame_count;
 
-  ags_sound_resource_read(AGS_SOUND_RESOURCE(ipatch_sample),
-			  sample_buffer, 1,
-			  0,
-			  source_frame_count, AGS_SOUNDCARD_DOUBLE);
+    /* format a private copy */
+    im_buffer = ags_stream_alloc(frame_count,
+				 AGS_SOUNDCARD_SIGNED_32_BIT);
 
-  /* resample if needed */
-  frame_count = source_frame_count;
-  
-  if(source_samplerate != samplerate){
-    void *tmp_sample_buffer;
-
-    guint tmp_frame_count;
-
-    tmp_frame_count = (samplerate / source_samplerate) * source_frame_count;
-
-    tmp_sample_buffer = ags_stream_alloc(tmp_frame_count,
-					 AGS_SOUNDCARD_DOUBLE);
-
-    ags_audio_buffer_util_resample_with_buffer(sample_buffer, 1,
-					       AGS_AUDIO_BUFFER_UTIL_DOUBLE, source_samplerate,
-					       source_frame_count,
-					       samplerate,
-					       tmp_frame_count,
-					       tmp_sample_buffer);
-    
-    ags_stream_free(sample_buffer);
-
-    sample_buffer = tmp_sample_buffer;
-    
-    frame_count = tmp_frame_count;
-  }
+    copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_S32,
+						    AGS_AUDIO_BUFFER_UTIL_DOUBLE);
 
-  /* format */
-  im_buffer = ags_stream_alloc(frame_count,
-			       AGS_SOUNDCARD_SIGNED_32_BIT);
+    ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
+						decoded_entry->data, 1, 0,
+						frame_count, copy_mode);
 
-  copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_S32,
-						  AGS_AUDIO_BUFFER_UTIL_DOUBLE);
+    ags_sample_cache_entry_unref(decoded_entry);
 
-  ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
-					      sample_buffer, 1, 0,
-					      frame_count, copy_mode);
-
-  /* pitch */
-  midi_key = 60;
+    /* pitch without holding any lock */
+    midi_key = 60;
   
-  if(ipatch_sample->sample != NULL){
-    gint tmp_midi_key;
+    if(ipatch_sample->sample != NULL){
+      gint tmp_midi_key;
     
-    g_object_get(ipatch_sample->sample,
-		 "root-note", &tmp_midi_key,
-		 NULL);
+      g_object_get(ipatch_sample->sample,
+		   "root-note", &tmp_midi_key,
+		   NULL);
 
-    if(tmp_midi_key >= 0 &&
-       tmp_midi_key < 128){
-      midi_key = tmp_midi_key;
+      if(tmp_midi_key >= 0 &&
+	 tmp_midi_key < 128){
+	midi_key = tmp_midi_key;
+      }
     }
-  }
   
-  base_key = (gdouble) midi_key - 21.0;
+    base_key = (gdouble) midi_key - 21.0;
 
-  tuning = 100.0 * (note - base_key);
+    tuning = 100.0 * (note - base_key);
   
-  ags_fast_pitch_util_compute_s32(im_buffer,
-				  frame_count,
-				  samplerate,
-				  base_key,
-				  tuning);
+    ags_fast_pitch_util_compute_s32(im_buffer,
+				    frame_count,
+				    samplerate,
+				    base_key,
+				    tuning);
+
+    sample_cache_entry = ags_sample_cache_insert(sample_cache,
+						 (GObject *) ipatch_sample,
+						 samplerate, AGS_SOUNDCARD_SIGNED_32_BIT,
+						 note,
+						 im_buffer, frame_count);
+  }
+
+  im_buffer = sample_cache_entry->data;
+  frame_count = sample_cache_entry->frame_count;
 
   success = FALSE;
   pong_copy = FALSE;
@@ -1290,8 +1270,7 @@ ags_sf2_synth_util_copy_s32(gint32 *buffer,
     }
   }
 
-  ags_stream_free(sample_buffer);
-  ags_stream_free(im_buffer);
+  ags_sample_cache_entry_unref(sample_cache_entry);
 }
 
 /**
@@ -1323,7 +1302,8 @@ ags_sf2_synth_util_copy_s64(gint64 *buffer,
 			    guint loop_mode,
 			    gint loop_start, gint loop_end)
 {
-  void *sample_buffer;
+  AgsSampleCache *sample_cache;
+  AgsSampleCacheEntry *sample_cache_entry;
 
   gint64 *im_buffer;
 
@@ -1331,110 +1311,77 @@ ags_sf2_synth_util_copy_s64(gint64 *buffer,
   guint frame_count;
   gdouble base_key;
   gdouble tuning;
-  guint source_frame_count;
-  guint source_samplerate;
-  guint source_buffer_size;
-  guint source_format;
   guint copy_mode;
 
   guint i0, i1, i2;
   gboolean success;
   gboolean pong_copy;
-  
-  source_frame_count = 0;
-
-  source_samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
-  source_buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
-  source_format = AGS_SOUNDCARD_DEFAULT_FORMAT;  
 
-  ags_sound_resource_info(AGS_SOUND_RESOURCE(ipatch_sample),
-			  &source_frame_count,
-			  NULL, NULL);
+  sample_cache = ags_sample_cache_get_instance();
 
-  ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(ipatch_sample),
-				 NULL,
-				 &source_samplerate,
-				 &source_buffer_size,
-				 &source_format);
+  /* lookup resampled and pitched sample */
+  sample_cache_entry = ags_sample_cache_lookup(sample_cache,
+					       (GObject *) ipatch_sample,
+					       samplerate, AGS_SOUNDCARD_SIGNED_64_BIT,
+					       note);
 
-  sample_buffer = ags_stream_alloc(source_frame_count,
-				   AGS_SOUNDCARD_DOUBLE);
-
-  ags_stream_free(ipatch_sample->buffer);
-  
-  ipatch_sample->buffer = ags_stream_alloc(ipatch_sample->audio_channels * source_frame_count,
-					   ipatch_sample->format);
-  
-  ipatch_sample->offset = 0;
+  if(sample_cache_entry == NULL){
+    AgsSampleCacheEntry *decoded_entry;
 
-  ags_sound_resource_read(AGS_SOUND_RESOURCE(ipatch_sample),
-			  sample_buffer, 1,
-			  0,
-			  source_frame_count, AGS_SOUNDCARD_DOUBLE);
+    /* the decoded and resampled sample is shared by all notes */
+    decoded_entry = ags_sf2_synth_util_get_decoded(ipatch_sample,
+						   samplerate);
 
-  /* resample if needed */
-  frame_count = source_frame_count;
-  
-  if(source_samplerate != samplerate){
-    void *tmp_sample_buffer;
+    frame_count = decoded_entry->frame_count;
 
-    guint tmp_frame_count;
+    /* format a private copy */
+    im_buffer = ags_stream_alloc(frame_count,
+				 AGS_SOUNDCARD_SIGNED_64_BIT);
 
-    tmp_frame_count = (samplerate / source_samplerate) * source_frame_count;
+    copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_S64,
+						    AGS_AUDIO_BUFFER_UTIL_DOUBLE);
 
-    tmp_sample_buffer = ags_stream_alloc(tmp_frame_count,
-					 AGS_SOUNDCARD_DOUBLE);
+    ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
+						decoded_entry->data, 1, 0,
+						frame_count, copy_mode);
 
-    ags_audio_buffer_util_resample_with_buffer(sample_buffer, 1,
-					       AGS_AUDIO_BUFFER_UTIL_DOUBLE, source_samplerate,
-					       source_frame_count,
-					       samplerate,
-					       tmp_frame_count,
-					       tmp_sample_buffer);
-    
-    ags_stream_free(sample_buffer);
+    ags_sample_cache_entry_unref(decoded_entry);
 
-    sample_buffer = tmp_sample_buffer;
-    
-    frame_count = tmp_frame_count;
-  }
-
-  /* format */
-  im_buffer = ags_stream_alloc(frame_count,
-			       AGS_SOUNDCARD_SIGNED_64_BIT);
-
-  copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_S64,
-						  AGS_AUDIO_BUFFER_UTIL_DOUBLE);
-
-  ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
-					      sample_buffer, 1, 0,
-					      frame_count, copy_mode);
-
-  /* pitch */
-  midi_key = 60;
+    /* pitch without holding any lock */
+    midi_key = 60;
   
-  if(ipatch_sample->sample != NULL){
-    gint tmp_midi_key;
+    if(ipatch_sample->sample != NULL){
+      gint tmp_midi_key;
     
-    g_object_get(ipatch_sample->sample,
-		 "root-note", &tmp_midi_key,
-		 NULL);
+      g_object_get(ipatch_sample->sample,
+		   "root-note", &tmp_midi_key,
+		   NULL);
 
-    if(tmp_midi_key >= 0 &&
-       tmp_midi_key < 128){
-      midi_key = tmp_midi_key;
+      if(tmp_midi_key >= 0 &&
+	 tmp_midi_key < 128){
+	midi_key = tmp_midi_key;
+      }
     }
-  }
   
-  base_key = (gdouble) midi_key - 21.0;
+    base_key = (gdouble) midi_key - 21.0;
 
-  tuning = 100.0 * (note - base_key);
+    tuning = 100.0 * (note - base_key);
   
-  ags_fast_pitch_util_compute_s64(im_buffer,
-				  frame_count,
-				  samplerate,
-				  base_key,
-				  tuning);
+    ags_fast_pitch_util_compute_s64(im_buffer,
+				    frame_count,
+				    samplerate,
+				    base_key,
+				    tuning);
+
+    sample_cache_entry = ags_sample_cache_insert(sample_cache,
+						 (GObject *) ipatch_sample,
+						 samplerate, AGS_SOUNDCARD_SIGNED_64_BIT,
+						 note,
+						 im_buffer, frame_count);
+  }
+
+  im_buffer = sample_cache_entry->data;
+  frame_count = sample_cache_entry->frame_count;
 
   success = FALSE;
   pong_copy = FALSE;
@@ -1559,8 +1506,7 @@ ags_sf2_synth_util_copy_s64(gint64 *buffer,
     }
   }
 
-  ags_stream_free(sample_buffer);
-  ags_stream_free(im_buffer);
+  ags_sample_cache_entry_unref(sample_cache_entry);
 }
 
 /**
@@ -1592,7 +1538,8 @@ ags_sf2_synth_util_copy_float(gfloat *buffer,
 			      guint loop_mode,
 			      gint loop_start, gint loop_end)
 {
-  void *sample_buffer;
+  AgsSampleCache *sample_cache;
+  AgsSampleCacheEntry *sample_cache_entry;
 
   gfloat *im_buffer;
 
@@ -1600,110 +1547,77 @@ ags_sf2_synth_util_copy_float(gfloat *buffer,
   guint frame_count;
   gdouble base_key;
   gdouble tuning;
-  guint source_frame_count;
-  guint source_samplerate;
-  guint source_buffer_size;
-  guint source_format;
   guint copy_mode;
 
   guint i0, i1, i2;
   gboolean success;
   gboolean pong_copy;
-  
-  source_frame_count = 0;
-
-  source_samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
-  source_buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
-  source_format = AGS_SOUNDCARD_DEFAULT_FORMAT;  
-
-  ags_sound_resource_info(AGS_SOUND_RESOURCE(ipatch_sample),
-			  &source_frame_count,
-			  NULL, NULL);
-
-  ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(ipatch_sample),
-				 NULL,
-				 &source_samplerate,
-				 &source_buffer_size,
-				 &source_format);
 
-  sample_buffer = ags_stream_alloc(source_frame_count,
-				   AGS_SOUNDCARD_DOUBLE);
+  sample_cache = ags_sample_cache_get_instance();
 
-  ags_stream_free(ipatch_sample->buffer);
-  
-  ipatch_sample->buffer = ags_stream_alloc(ipatch_sample->audio_channels * source_frame_count,
-					   ipatch_sample->format);
-  
-  ipatch_sample->offset = 0;
-
-  ags_sound_resource_read(AGS_SOUND_RESOURCE(ipatch_sample),
-			  sample_buffer, 1,
-			  0,
-			  source_frame_count, AGS_SOUNDCARD_DOUBLE);
-
-  /* resample if needed */
-  frame_count = source_frame_count;
-  
-  if(source_samplerate != samplerate){
-    void *tmp_sample_buffer;
+  /* lookup resampled and pitched sample */
+  sample_cache_entry = ags_sample_cache_lookup(sample_cache,
+					       (GObject *) ipatch_sample,
+					       samplerate, AGS_SOUNDCARD_FLOAT,
+					       note);
 
-    guint tmp_frame_count;
+  if(sample_cache_entry == NULL){
+    AgsSampleCacheEntry *decoded_entry;
 
-    tmp_frame_count = (samplerate / source_samplerate) * source_frame_count;
+    /* the decoded and resampled sample is shared by all notes */
+    decoded_entry = ags_sf2_synth_util_get_decoded(ipatch_sample,
+						   samplerate);
 
-    tmp_sample_buffer = ags_stream_alloc(tmp_frame_count,
-					 AGS_SOUNDCARD_DOUBLE);
+    frame_count = decoded_entry->frame_count;
 
-    ags_audio_buffer_util_resample_with_buffer(sample_buffer, 1,
-					       AGS_AUDIO_BUFFER_UTIL_DOUBLE, source_samplerate,
-					       source_frame_count,
-					       samplerate,
-					       tmp_frame_count,
-					       tmp_sample_buffer);
-    
-    ags_stream_free(sample_buffer);
+    /* format a private copy */
+    im_buffer = ags_stream_alloc(frame_count,
+				 AGS_SOUNDCARD_FLOAT);
 
-    sample_buffer = tmp_sample_buffer;
-    
-    frame_count = tmp_frame_count;
-  }
+    copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_FLOAT,
+						    AGS_AUDIO_BUFFER_UTIL_DOUBLE);
 
-  /* format */
-  im_buffer = ags_stream_alloc(frame_count,
-			       AGS_SOUNDCARD_FLOAT);
+    ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
+						decoded_entry->data, 1, 0,
+						frame_count, copy_mode);
 
-  copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_FLOAT,
-						  AGS_AUDIO_BUFFER_UTIL_DOUBLE);
+    ags_sample_cache_entry_unref(decoded_entry);
 
-  ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
-					      sample_buffer, 1, 0,
-					      frame_count, copy_mode);
-
-  /* pitch */
-  midi_key = 60;
+    /* pitch without holding any lock */
+    midi_key = 60;
   
-  if(ipatch_sample->sample != NULL){
-    gint tmp_midi_key;
+    if(ipatch_sample->sample != NULL){
+      gint tmp_midi_key;
     
-    g_object_get(ipatch_sample->sample,
-		 "root-note", &tmp_midi_key,
-		 NULL);
+      g_object_get(ipatch_sample->sample,
+		   "root-note", &tmp_midi_key,
+		   NULL);
 
-    if(tmp_midi_key >= 0 &&
-       tmp_midi_key < 128){
-      midi_key = tmp_midi_key;
+      if(tmp_midi_key >= 0 &&
+	 tmp_midi_key < 128){
+	midi_key = tmp_midi_key;
+      }
     }
-  }
   
-  base_key = (gdouble) midi_key - 21.0;
+    base_key = (gdouble) midi_key - 21.0;
 
-  tuning = 100.0 * (note - base_key);
+    tuning = 100.0 * (note - base_key);
   
-  ags_fast_pitch_util_compute_float(im_buffer,
-				    frame_count,
-				    samplerate,
-				    base_key,
-				    tuning);
+    ags_fast_pitch_util_compute_float(im_buffer,
+				      frame_count,
+				      samplerate,
+				      base_key,
+				      tuning);
+
+    sample_cache_entry = ags_sample_cache_insert(sample_cache,
+						 (GObject *) ipatch_sample,
+						 samplerate, AGS_SOUNDCARD_FLOAT,
+						 note,
+						 im_buffer, frame_count);
+  }
+
+  im_buffer = sample_cache_entry->data;
+  frame_count = sample_cache_entry->frame_count;
 
   success = FALSE;
   pong_copy = FALSE;
@@ -1828,8 +1742,7 @@ ags_sf2_synth_util_copy_float(gfloat *buffer,
     }
   }
   
-  ags_stream_free(sample_buffer);
-  ags_stream_free(im_buffer);
+  ags_sample_cache_entry_unref(sample_cache_entry);
 }
 
 /**
@@ -1861,7 +1774,8 @@ ags_sf2_synth_util_copy_double(gdouble *buffer,
 			       guint loop_mode,
 			       gint loop_start, gint loop_end)
 {
-  void *sample_buffer;
+  AgsSampleCache *sample_cache;
+  AgsSampleCacheEntry *sample_cache_entry;
 
   gdouble *im_buffer;
 
@@ -1869,110 +1783,77 @@ ags_sf2_synth_util_copy_double(gdouble *buffer,
   guint frame_count;
   gdouble base_key;
   gdouble tuning;
-  guint source_frame_count;
-  guint source_samplerate;
-  guint source_buffer_size;
-  guint source_format;
   guint copy_mode;
 
   guint i0, i1, i2;
   gboolean success;
   gboolean pong_copy;
-  
-  source_frame_count = 0;
-
-  source_samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
-  source_buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
-  source_format = AGS_SOUNDCARD_DEFAULT_FORMAT;  
-
-  ags_sound_resource_info(AGS_SOUND_RESOURCE(ipatch_sample),
-			  &source_frame_count,
-			  NULL, NULL);
-
-  ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(ipatch_sample),
-				 NULL,
-				 &source_samplerate,
-				 &source_buffer_size,
-				 &source_format);
-
-  sample_buffer = ags_stream_alloc(source_frame_count,
-				   AGS_SOUNDCARD_DOUBLE);
 
-  ags_stream_free(ipatch_sample->buffer);
-  
-  ipatch_sample->buffer = ags_stream_alloc(ipatch_sample->audio_channels * source_frame_count,
-					   ipatch_sample->format);
-  
-  ipatch_sample->offset = 0;
-
-  ags_sound_resource_read(AGS_SOUND_RESOURCE(ipatch_sample),
-			  sample_buffer, 1,
-			  0,
-			  source_frame_count, AGS_SOUNDCARD_DOUBLE);
-
-  /* resample if needed */
-  frame_count = source_frame_count;
-  
-  if(source_samplerate != samplerate){
-    void *tmp_sample_buffer;
+  sample_cache = ags_sample_cache_get_instance();
 
-    guint tmp_frame_count;
+  /* lookup resampled and pitched sample */
+  sample_cache_entry = ags_sample_cache_lookup(sample_cache,
+					       (GObject *) ipatch_sample,
+					       samplerate, AGS_SOUNDCARD_DOUBLE,
+					       note);
 
-    tmp_frame_count = (samplerate / source_samplerate) * source_frame_count;
+  if(sample_cache_entry == NULL){
+    AgsSampleCacheEntry *decoded_entry;
 
-    tmp_sample_buffer = ags_stream_alloc(tmp_frame_count,
-					 AGS_SOUNDCARD_DOUBLE);
+    /* the decoded and resampled sample is shared by all notes */
+    decoded_entry = ags_sf2_synth_util_get_decoded(ipatch_sample,
+						   samplerate);
 
-    ags_audio_buffer_util_resample_with_buffer(sample_buffer, 1,
-					       AGS_AUDIO_BUFFER_UTIL_DOUBLE, source_samplerate,
-					       source_frame_count,
-					       samplerate,
-					       tmp_frame_count,
-					       tmp_sample_buffer);
-    
-    ags_stream_free(sample_buffer);
+    frame_count = decoded_entry->frame_count;
 
-    sample_buffer = tmp_sample_buffer;
-    
-    frame_count = tmp_frame_count;
-  }
+    /* format a private copy */
+    im_buffer = ags_stream_alloc(frame_count,
+				 AGS_SOUNDCARD_DOUBLE);
 
-  /* format */
-  im_buffer = ags_stream_alloc(frame_count,
-			       AGS_SOUNDCARD_DOUBLE);
+    copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_DOUBLE,
+						    AGS_AUDIO_BUFFER_UTIL_DOUBLE);
 
-  copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_DOUBLE,
-						  AGS_AUDIO_BUFFER_UTIL_DOUBLE);
+    ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
+						decoded_entry->data, 1, 0,
+						frame_count, copy_mode);
 
-  ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
-					      sample_buffer, 1, 0,
-					      frame_count, copy_mode);
+    ags_sample_cache_entry_unref(decoded_entry);
 
-  /* pitch */
-  midi_key = 60;
+    /* pitch without holding any lock */
+    midi_key = 60;
   
-  if(ipatch_sample->sample != NULL){
-    gint tmp_midi_key;
+    if(ipatch_sample->sample != NULL){
+      gint tmp_midi_key;
     
-    g_object_get(ipatch_sample->sample,
-		 "root-note", &tmp_midi_key,
-		 NULL);
+      g_object_get(ipatch_sample->sample,
+		   "root-note", &tmp_midi_key,
+		   NULL);
 
-    if(tmp_midi_key >= 0 &&
-       tmp_midi_key < 128){
-      midi_key = tmp_midi_key;
+      if(tmp_midi_key >= 0 &&
+	 tmp_midi_key < 128){
+	midi_key = tmp_midi_key;
+      }
     }
-  }
   
-  base_key = (gdouble) midi_key - 21.0;
+    base_key = (gdouble) midi_key - 21.0;
 
-  tuning = 100.0 * (note - base_key);
+    tuning = 100.0 * (note - base_key);
   
-  ags_fast_pitch_util_compute_double(im_buffer,
-				     frame_count,
-				     samplerate,
-				     base_key,
-				     tuning);
+    ags_fast_pitch_util_compute_double(im_buffer,
+				       frame_count,
+				       samplerate,
+				       base_key,
+				       tuning);
+
+    sample_cache_entry = ags_sample_cache_insert(sample_cache,
+						 (GObject *) ipatch_sample,
+						 samplerate, AGS_SOUNDCARD_DOUBLE,
+						 note,
+						 im_buffer, frame_count);
+  }
+
+  im_buffer = sample_cache_entry->data;
+  frame_count = sample_cache_entry->frame_count;
 
   success = FALSE;
   pong_copy = FALSE;
@@ -2097,8 +1978,7 @@ ags_sf2_synth_util_copy_double(gdouble *buffer,
     }
   }
   
-  ags_stream_free(sample_buffer);
-  ags_stream_free(im_buffer);
+  ags_sample_cache_entry_unref(sample_cache_entry);
 }
 
 /**
@@ -2130,7 +2010,8 @@ ags_sf2_synth_util_copy_complex(AgsComplex *buffer,
 				guint loop_mode,
 				gint loop_start, gint loop_end)
 {
-  void *sample_buffer;
+  AgsSampleCache *sample_cache;
+  AgsSampleCacheEntry *sample_cache_entry;
 
   AgsComplex *im_buffer;
 
@@ -2138,110 +2019,77 @@ ags_sf2_synth_util_copy_complex(AgsComplex *buffer,
   guint frame_count;
   gdouble base_key;
   gdouble tuning;
-  guint source_frame_count;
-  guint source_samplerate;
-  guint source_buffer_size;
-  guint source_format;
   guint copy_mode;
 
   guint i0, i1, i2;
   gboolean success;
   gboolean pong_copy;
-  
-  source_frame_count = 0;
-
-  source_samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
-  source_buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
-  source_format = AGS_SOUNDCARD_DEFAULT_FORMAT;  
-
-  ags_sound_resource_info(AGS_SOUND_RESOURCE(ipatch_sample),
-			  &source_frame_count,
-			  NULL, NULL);
-
-  ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(ipatch_sample),
-				 NULL,
-				 &source_samplerate,
-				 &source_buffer_size,
-				 &source_format);
-
-  sample_buffer = ags_stream_alloc(source_frame_count,
-				   AGS_SOUNDCARD_DOUBLE);
-
-  ags_stream_free(ipatch_sample->buffer);
-  
-  ipatch_sample->buffer = ags_stream_alloc(ipatch_sample->audio_channels * source_frame_count,
-					   ipatch_sample->format);
-  
-  ipatch_sample->offset = 0;
 
-  ags_sound_resource_read(AGS_SOUND_RESOURCE(ipatch_sample),
-			  sample_buffer, 1,
-			  0,
-			  source_frame_count, AGS_SOUNDCARD_DOUBLE);
-
-  /* resample if needed */
-  frame_count = source_frame_count;
-  
-  if(source_samplerate != samplerate){
-    void *tmp_sample_buffer;
+  sample_cache = ags_sample_cache_get_instance();
 
-    guint tmp_frame_count;
+  /* lookup resampled and pitched sample */
+  sample_cache_entry = ags_sample_cache_lookup(sample_cache,
+					       (GObject *) ipatch_sample,
+					       samplerate, AGS_SOUNDCARD_COMPLEX,
+					       note);
 
-    tmp_frame_count = (samplerate / source_samplerate) * source_frame_count;
+  if(sample_cache_entry == NULL){
+    AgsSampleCacheEntry *decoded_entry;
 
-    tmp_sample_buffer = ags_stream_alloc(tmp_frame_count,
-					 AGS_SOUNDCARD_DOUBLE);
+    /* the decoded and resampled sample is shared by all notes */
+    decoded_entry = ags_sf2_synth_util_get_decoded(ipatch_sample,
+						   samplerate);
 
-    ags_audio_buffer_util_resample_with_buffer(sample_buffer, 1,
-					       AGS_AUDIO_BUFFER_UTIL_DOUBLE, source_samplerate,
-					       source_frame_count,
-					       samplerate,
-					       tmp_frame_count,
-					       tmp_sample_buffer);
-    
-    ags_stream_free(sample_buffer);
+    frame_count = decoded_entry->frame_count;
 
-    sample_buffer = tmp_sample_buffer;
-    
-    frame_count = tmp_frame_count;
-  }
+    /* format a private copy */
+    im_buffer = ags_stream_alloc(frame_count,
+				 AGS_SOUNDCARD_COMPLEX);
 
-  /* format */
-  im_buffer = ags_stream_alloc(frame_count,
-			       AGS_SOUNDCARD_COMPLEX);
+    copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_COMPLEX,
+						    AGS_AUDIO_BUFFER_UTIL_DOUBLE);
 
-  copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_COMPLEX,
-						  AGS_AUDIO_BUFFER_UTIL_DOUBLE);
+    ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
+						decoded_entry->data, 1, 0,
+						frame_count, copy_mode);
 
-  ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
-					      sample_buffer, 1, 0,
-					      frame_count, copy_mode);
+    ags_sample_cache_entry_unref(decoded_entry);
 
-  /* pitch */
-  midi_key = 60;
+    /* pitch without holding any lock */
+    midi_key = 60;
 
-  if(ipatch_sample->sample != NULL){
-    gint tmp_midi_key;
+    if(ipatch_sample->sample != NULL){
+      gint tmp_midi_key;
     
-    g_object_get(ipatch_sample->sample,
-		 "root-note", &tmp_midi_key,
-		 NULL);
+      g_object_get(ipatch_sample->sample,
+		   "root-note", &tmp_midi_key,
+		   NULL);
 
-    if(tmp_midi_key >= 0 &&
-       tmp_midi_key < 128){
-      midi_key = tmp_midi_key;
+      if(tmp_midi_key >= 0 &&
+	 tmp_midi_key < 128){
+	midi_key = tmp_midi_key;
+      }
     }
-  }
   
-  base_key = (gdouble) midi_key - 21.0;
+    base_key = (gdouble) midi_key - 21.0;
 
-  tuning = 100.0 * (note - base_key);
+    tuning = 100.0 * (note - base_key);
   
-  ags_fast_pitch_util_compute_complex(im_buffer,
-				      frame_count,
-				      samplerate,
-				      base_key,
-				      tuning);
+    ags_fast_pitch_util_compute_complex(im_buffer,
+					frame_count,
+					samplerate,
+					base_key,
+					tuning);
+
+    sample_cache_entry = ags_sample_cache_insert(sample_cache,
+						 (GObject *) ipatch_sample,
+						 samplerate, AGS_SOUNDCARD_COMPLEX,
+						 note,
+						 im_buffer, frame_count);
+  }
+
+  im_buffer = sample_cache_entry->data;
+  frame_count = sample_cache_entry->frame_count;
 
   success = FALSE;
   pong_copy = FALSE;
@@ -2366,8 +2214,7 @@ ags_sf2_synth_util_copy_complex(AgsComplex *buffer,
     }
   }
 
-  ags_stream_free(sample_buffer);
-  ags_stream_free(im_buffer);
+  ags_sample_cache_entry_unref(sample_cache_entry);
 }
 
 /**
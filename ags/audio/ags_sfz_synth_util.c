@@ -24,6 +24,7 @@
 #include <ags/audio/ags_audio_buffer_util.h>
 #include <ags/audio/ags_diatonic_scale.h>
 #include <ags/audio/ags_fast_pitch_util.h>
+#include <ags/audio/ags_sample_cache.h>
 
 #include <ags/audio/file/ags_sound_container.h>
 #include <ags/audio/file/ags_sound_resource.h>
@@ -40,6 +41,9 @@
 #include <complex.h>
 
 
+AgsSampleCacheEntry* ags_sfz_synth_util_get_decoded(AgsSFZSample *sfz_sample,
+						    guint samplerate);
+
 /**
  * SECTION:ags_sfz_synth_util
  * @short_description: frequency modulation synth util
@@ -50,6 +54,113 @@
  * Utility functions to compute SFZ synths.
  */
 
+AgsSampleCacheEntry*
+ags_sfz_synth_util_get_decoded(AgsSFZSample *sfz_sample,
+			       guint samplerate)
+{
+  AgsSampleCache *sample_cache;
+  AgsSampleCacheEntry *sample_cache_entry;
+
+  void *sample_buffer;
+
+  guint frame_count;
+  guint source_frame_count;
+  guint source_samplerate;
+  guint source_buffer_size;
+  guint source_format;
+
+  GRecMutex *sfz_sample_mutex;
+
+  sample_cache = ags_sample_cache_get_instance();
+
+  sfz_sample_mutex = AGS_SFZ_SAMPLE_GET_OBJ_MUTEX(sfz_sample);
+
+  /* lookup decoded and resampled sample */
+  sample_cache_entry = ags_sample_cache_lookup_decoded(sample_cache,
+						       (GObject *) sfz_sample,
+						       samplerate);
+
+  if(sample_cache_entry != NULL){
+    return(sample_cache_entry);
+  }
+
+  /* decode single-flight, the read shares the buffer of the sample */
+  g_rec_mutex_lock(sfz_sample_mutex);
+
+  sample_cache_entry = ags_sample_cache_lookup_decoded(sample_cache,
+						       (GObject *) sfz_sample,
+						       samplerate);
+
+  if(sample_cache_entry == NULL){
+    source_frame_count = 0;
+
+    source_samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
+    source_buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
+    source_format = AGS_SOUNDCARD_DEFAULT_FORMAT;  
+  
+    ags_sound_resource_info(AGS_SOUND_RESOURCE(sfz_sample),
+			    &source_frame_count,
+			    NULL, NULL);
+
+    ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(sfz_sample),
+				   NULL,
+				   &source_samplerate,
+				   &source_buffer_size,
+				   &source_format);
+
+    sample_buffer = ags_stream_alloc(source_frame_count,
+				     AGS_SOUNDCARD_DOUBLE);
+
+    ags_stream_free(sfz_sample->buffer);
+  
+    sfz_sample->buffer = ags_stream_alloc(sfz_sample->audio_channels * source_frame_count,
+					  sfz_sample->format);
+  
+    sfz_sample->offset = 0;
+
+    ags_sound_resource_read(AGS_SOUND_RESOURCE(sfz_sample),
+			    sample_buffer, 1,
+			    0,
+			    source_frame_count, AGS_SOUNDCARD_DOUBLE);
+  
+    /* resample if needed */
+    frame_count = source_frame_count;
+  
+    if(source_samplerate != samplerate){
+      void *tmp_sample_buffer;
+
+      guint tmp_frame_count;
+
+      tmp_frame_count = (guint) ceil((gdouble) samplerate / (gdouble) source_samplerate * (gdouble) source_frame_count);
+
+      tmp_sample_buffer = ags_stream_alloc(tmp_frame_count,
+					   AGS_SOUNDCARD_DOUBLE);
+
+      ags_audio_buffer_util_resample_with_buffer(sample_buffer, 1,
+						 AGS_AUDIO_BUFFER_UTIL_DOUBLE, source_samplerate,
+						 source_frame_count,
+						 samplerate,
+						 tmp_frame_count,
+						 tmp_sample_buffer);
+    
+      ags_stream_free(sample_buffer);
+
+      sample_buffer = tmp_sample_buffer;
+    
+      frame_count = tmp_frame_count;
+    }
+
+    sample_cache_entry = ags_sample_cache_insert_decoded(sample_cache,
+							 (GObject *) sfz_sample,
+							 samplerate,
+							 sample_buffer, frame_count);
+  }
+
+  g_rec_mutex_unlock(sfz_sample_mutex);
+
+  return(sample_cache_entry);
+}
+
 /**
  * ags_sfz_synth_util_copy_s8:
  * @buffer: the audio buffer
@@ -79,148 +190,116 @@ ags_sfz_synth_util_copy_s8(gint8 *buffer,
 			   guint loop_mode,
 			   gint loop_start, gint loop_end)
 {
+  AgsSampleCache *sample_cache;
+  AgsSampleCacheEntry *sample_cache_entry;
+
   gchar *group_key;
   gchar *region_key;
 
-  void *sample_buffer;
-
   gint8 *im_buffer;
 
   gint midi_key, current_midi_key;
   guint frame_count;
   gdouble base_key;
   gdouble tuning;
-  guint source_frame_count;
-  guint source_samplerate;
-  guint source_buffer_size;
-  guint source_format;
   guint copy_mode;
 
   guint i0, i1, i2;
   gboolean success;
   gboolean pong_copy;
-  
-  source_frame_count = 0;
 
-  source_samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
-  source_buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
-  source_format = AGS_SOUNDCARD_DEFAULT_FORMAT;  
-  
-  ags_sound_resource_info(AGS_SOUND_RESOURCE(sfz_sample),
-			  &source_frame_count,
-			  NULL, NULL);
+  sample_cache = ags_sample_cache_get_instance();
 
-  ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(sfz_sample),
-				 NULL,
-				 &source_samplerate,
-				 &source_buffer_size,
-				 &source_format);
+  /* lookup resampled and pitched sample */
+  sample_cache_entry = ags_sample_cache_lookup(sample_cache,
+					       (GObject *) sfz_sample,
+					       samplerate, AGS_SOUNDCARD_SIGNED_8_BIT,
+					       note);
 
-  sample_buffer = ags_stream_alloc(source_frame_count,
-				   AGS_SOUNDCARD_DOUBLE);
+  if(sample_cache_entry == NULL){
+    AgsSampleCacheEntry *decoded_entry;
 
-  ags_stream_free(sfz_sample->buffer);
-  
-  sfz_sample->buffer = ags_stream_alloc(sfz_sample->audio_channels * source_frame_count,
-					sfz_sample->format);
-  
-  sfz_sample->offset = 0;
+    /* the decoded and resampled sample is shared by all notes */
+    decoded_entry = ags_sfz_synth_util_get_decoded(sfz_sample,
+						   samplerate);
 
-  ags_sound_resource_read(AGS_SOUND_RESOURCE(sfz_sample),
-			  sample_buffer, 1,
-			  0,
-			  source_frame_count, AGS_SOUNDCARD_DOUBLE);
-  
-  /* resample if needed */
-  frame_count = source_frame_count;
-  
-  if(source_samplerate != samplerate){
-    void *tmp_sample_buffer;
-
-    guint tmp_frame_count;
-
-    tmp_frame_count = (samplerate / source_samplerate) * source_frame_count;
-
-    tmp_sample_buffer = ags_stream_alloc(tmp_frame_count,
-					 AGS_SOUNDCARD_DOUBLE);
+    frame_count = decoded_entry->frame_count;
 
-    ags_audio_buffer_util_resample_with_buffer(sample_buffer, 1,
-					       AGS_AUDIO_BUFFER_UTIL_DOUBLE, source_samplerate,
-					       source_frame_count,
-					       samplerate,
-					       tmp_frame_count,
-					       tmp_sample_buffer);
-    
-    ags_stream_free(sample_buffer);
+    /* format a private copy */
+    im_buffer = ags_stream_alloc(frame_count,
+				 AGS_SOUNDCARD_SIGNED_8_BIT);
 
-    sample_buffer = tmp_sample_buffer;
-    
-    frame_count = tmp_frame_count;
-  }
+    copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_S8,
+						    AGS_AUDIO_BUFFER_UTIL_DOUBLE);
 
-  /* format */
-  im_buffer = ags_stream_alloc(frame_count,
-			       AGS_SOUNDCARD_SIGNED_8_BIT);
+    ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
+						decoded_entry->data, 1, 0,
+						frame_count, copy_mode);
 
-  copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_S8,
-						  AGS_AUDIO_BUFFER_UTIL_DOUBLE);
+    ags_sample_cache_entry_unref(decoded_entry);
 
-  ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
-					      sample_buffer, 1, 0,
-					      frame_count, copy_mode);
-  
-  /* pitch */
-  midi_key = 60;
+    /* pitch without holding any lock */
+    midi_key = 60;
 
-  group_key = ags_sfz_group_lookup_control(sfz_sample->group,
-					   "key");
+    group_key = ags_sfz_group_lookup_control(sfz_sample->group,
+					     "key");
 
-  if(group_key != NULL){
-    int retval;
+    if(group_key != NULL){
+      int retval;
     
-    retval = sscanf(group_key, "%d", &current_midi_key);
+      retval = sscanf(group_key, "%d", &current_midi_key);
 
-    if(retval <= 0){
-      retval = ags_diatonic_scale_note_to_midi_key(group_key,
-						   &current_midi_key);
+      if(retval <= 0){
+	retval = ags_diatonic_scale_note_to_midi_key(group_key,
+						     &current_midi_key);
 
-      if(retval > 0){
-	midi_key = current_midi_key;
+	if(retval > 0){
+	  midi_key = current_midi_key;
+	}
       }
-    }
 
-    g_free(group_key);
-  }
+      g_free(group_key);
+    }
   
-  region_key = ags_sfz_region_lookup_control(sfz_sample->region,
-					     "key");
+    region_key = ags_sfz_region_lookup_control(sfz_sample->region,
+					       "key");
   
-  if(region_key != NULL){
-    int retval;
+    if(region_key != NULL){
+      int retval;
 
-    retval = sscanf(region_key, "%d", &current_midi_key);
+      retval = sscanf(region_key, "%d", &current_midi_key);
 
-    if(retval <= 0){
-      retval = ags_diatonic_scale_note_to_midi_key(region_key,
-						   &current_midi_key);
+      if(retval <= 0){
+	retval = ags_diatonic_scale_note_to_midi_key(region_key,
+						     &current_midi_key);
 
-      if(retval > 0){
-	midi_key = current_midi_key;
+	if(retval > 0){
+	  midi_key = current_midi_key;
+	}
       }
-    }
 
-    g_free(region_key);
-  }
+      g_free(region_key);
+    }
     
-  base_key = (gdouble) midi_key - 21.0;
+    base_key = (gdouble) midi_key - 21.0;
 
-  tuning = 100.0 * (note - base_key);
+    tuning = 100.0 * (note - base_key);
   
-  ags_fast_pitch_util_compute_s8(im_buffer,
-				 frame_count,
-				 samplerate,
-				 base_key,
-				 tuning);
+    ags_fast_pitch_util_compute_s8(im_buffer,
+				   frame_count,
+				   samplerate,
+				   base_key,
+				   tuning);
+
+    sample_cache_entry = ags_sample_cache_insert(sample_cache,
+						 (GObject *) sfz_sample,
+						 samplerate, AGS_SOUNDCARD_SIGNED_8_BIT,
+						 note,
+						 im_buffer, frame_count);
+  }
+
+  im_buffer = sample_cache_entry->data;
+  frame_count = sample_cache_entry->frame_count;
 
   success = FALSE;
   pong_copy = FALSE;
@@ -345,8 +424,7 @@ ags_sfz_synth_util_copy_s8(gint8 *buffer,
     }
   }
   
-  ags_stream_free(sample_buffer);
-  ags_stream_free(im_buffer);
+  ags_sample_cache_entry_unref(sample_cache_entry);
 }
 
 /**
@@ -378,9 +456,10 @@ ags_sfz_synth_util_copy_s16(gint16 *buffer,
 			    guint loop_mode,
 			    gint loop_start, gint loop_end)
 {
-  gchar *group_key, *region_key;
+  AgsSampleCache *sample_cache;
+  AgsSampleCacheEntry *sample_cache_entry;
 
-  void *sample_buffer;
+  gchar *group_key, *region_key;
 
   gint16 *im_buffer;
 
@@ -388,137 +467,104 @@ ags_sfz_synth_util_copy_s16(gint16 *buffer,
   guint frame_count;
   gdouble base_key;
   gdouble tuning;
-  guint source_frame_count;
-  guint source_samplerate;
-  guint source_buffer_size;
-  guint source_format;
   guint copy_mode;
 
   guint i0, i1, i2;
   gboolean success;
   gboolean pong_copy;
 
-  source_frame_count = 0;
-
-  source_samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
-  source_buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
-  source_format = AGS_SOUNDCARD_DEFAULT_FORMAT;  
-  
-  ags_sound_resource_info(AGS_SOUND_RESOURCE(sfz_sample),
-			  &source_frame_count,
-			  NULL, NULL);
-
-  ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(sfz_sample),
-				 NULL,
-				 &source_samplerate,
-				 &source_buffer_size,
-				 &source_format);
-
-  sample_buffer = ags_stream_alloc(source_frame_count,
-				   AGS_SOUNDCARD_DOUBLE);
-
-  ags_stream_free(sfz_sample->buffer);
-  
-  sfz_sample->buffer = ags_stream_alloc(sfz_sample->audio_channels * source_frame_count,
-					sfz_sample->format);
-  
-  sfz_sample->offset = 0;
+  sample_cache = ags_sample_cache_get_instance();
 
-  ags_sound_resource_read(AGS_SOUND_RESOURCE(sfz_sample),
-			  sample_buffer, 1,
-			  0,
-			  source_frame_count, AGS_SOUNDCARD_DOUBLE);
+  /* lookup resampled and pitched sample */
+  sample_cache_entry = ags_sample_cache_lookup(sample_cache,
+					       (GObject *) sfz_sample,
+					       samplerate, AGS_SOUNDCARD_SIGNED_16_BIT,
+					       note);
 
-  /* resample if needed */
-  frame_count = source_frame_count;
-  
-  if(source_samplerate != samplerate){
-    void *tmp_sample_buffer;
+  if(sample_cache_entry == NULL){
+    AgsSampleCacheEntry *decoded_entry;
 
-    guint tmp_frame_count;
+    /* the decoded and resampled sample is shared by all notes */
+    decoded_entry = ags_sfz_synth_util_get_decoded(sfz_sample,
+						   samplerate);
 
-    tmp_frame_count = (samplerate / source_samplerate) * source_frame_count;
+    frame_count = decoded_entry->frame_count;
 
-    tmp_sample_buffer = ags_stream_alloc(tmp_frame_count,
-					 AGS_SOUNDCARD_DOUBLE);
-
-    ags_audio_buffer_util_resample_with_buffer(sample_buffer, 1,
-					       AGS_AUDIO_BUFFER_UTIL_DOUBLE, source_samplerate,
-					       source_frame_count,
-					       samplerate,
-					       tmp_frame_count,
-					       tmp_sample_buffer);
-    
-    ags_stream_free(sample_buffer);
-
-    sample_buffer = tmp_sample_buffer;
-    
-    frame_count = tmp_frame_count;
-  }
+    /* format a private copy */
+    im_buffer = ags_stream_alloc(frame_count,
+				 AGS_SOUNDCARD_SIGNED_16_BIT);
 
-  /* format */
-  im_buffer = ags_stream_alloc(frame_count,
-			       AGS_SOUNDCARD_SIGNED_16_BIT);
+    copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_S16,
+						    AGS_AUDIO_BUFFER_UTIL_DOUBLE);
 
-  copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_S16,
-						  AGS_AUDIO_BUFFER_UTIL_DOUBLE);
+    ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
+						decoded_entry->data, 1, 0,
+						frame_count, copy_mode);
 
-  ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
-					      sample_buffer, 1, 0,
-					      frame_count, copy_mode);
+    ags_sample_cache_entry_unref(decoded_entry);
 
-  /* pitch */
-  midi_key = 60;
+    /* pitch without holding any lock */
+    midi_key = 60;
   
-  group_key = ags_sfz_group_lookup_control(sfz_sample->group,
-					   "key");
+    group_key = ags_sfz_group_lookup_control(sfz_sample->group,
+					     "key");
 
-  if(group_key != NULL){
-    int retval;
+    if(group_key != NULL){
+      int retval;
     
-    retval = sscanf(group_key, "%d", &current_midi_key);
+      retval = sscanf(group_key, "%d", &current_midi_key);
 
-    if(retval <= 0){
-      retval = ags_diatonic_scale_note_to_midi_key(group_key,
-						   &current_midi_key);
+      if(retval <= 0){
+	retval = ags_diatonic_scale_note_to_midi_key(group_key,
+						     &current_midi_key);
 
-      if(retval > 0){
-	midi_key = current_midi_key;
+	if(retval > 0){
+	  midi_key = current_midi_key;
+	}
       }
-    }
 
-    g_free(group_key);
-  }
+      g_free(group_key);
+    }
   
-  region_key = ags_sfz_region_lookup_control(sfz_sample->region,
-					     "key");
+    region_key = ags_sfz_region_lookup_control(sfz_sample->region,
+					       "key");
 
-  if(region_key != NULL){
-    int retval;
+    if(region_key != NULL){
+      int retval;
     
-    retval = sscanf(region_key, "%d", &current_midi_key);
+      retval = sscanf(region_key, "%d", &current_midi_key);
 
-    if(retval <= 0){
-      retval = ags_diatonic_scale_note_to_midi_key(region_key,
-						   &current_midi_key);
+      if(retval <= 0){
+	retval = ags_diatonic_scale_note_to_midi_key(region_key,
+						     &current_midi_key);
 
-      if(retval > 0){
-	midi_key = current_midi_key;
+	if(retval > 0){
+	  midi_key = current_midi_key;
+	}
       }
-    }
 
-    g_free(region_key);
-  }
+      g_free(region_key);
+    }
   
-  base_key = (gdouble) midi_key - 21.0;
+    base_key = (gdouble) midi_key - 21.0;
 
-  tuning = 100.0 * (note - base_key);
+    tuning = 100.0 * (note - base_key);
   
-  ags_fast_pitch_util_compute_s16(im_buffer,
-				  frame_count,
-				  samplerate,
-				  base_key,
-				  tuning);
+    ags_fast_pitch_util_compute_s16(im_buffer,
+				    frame_count,
+				    samplerate,
+				    base_key,
+				    tuning);
+
+    sample_cache_entry = ags_sample_cache_insert(sample_cache,
+						 (GObject *) sfz_sample,
+						 samplerate, AGS_SOUNDCARD_SIGNED_16_BIT,
+						 note,
+						 im_buffer, frame_count);
+  }
+
+  im_buffer = sample_cache_entry->data;
+  frame_count = sample_cache_entry->frame_count;
 
   success = FALSE;
   pong_copy = FALSE;
@@ -643,8 +689,7 @@ ags_sfz_synth_util_copy_s16(gint16 *buffer,
     }
   }
   
-  ags_stream_free(sample_buffer);
-  ags_stream_free(im_buffer);
+  ags_sample_cache_entry_unref(sample_cache_entry);
 }
 
 /**
@@ -676,9 +721,10 @@ ags_sfz_synth_util_copy_s24(gint32 *buffer,
 			    guint loop_mode,
 			    gint loop_start, gint loop_end)
 {
-  gchar *group_key, *region_key;
+  AgsSampleCache *sample_cache;
+  AgsSampleCacheEntry *sample_cache_entry;
 
-  void *sample_buffer;
+  gchar *group_key, *region_key;
 
   gint32 *im_buffer;
 
@@ -686,137 +732,104 @@ ags_sfz_synth_util_copy_s24(gint32 *buffer,
   guint frame_count;
   gdouble base_key;
   gdouble tuning;
-  guint source_frame_count;
-  guint source_samplerate;
-  guint source_buffer_size;
-  guint source_format;
   guint copy_mode;
 
   guint i0, i1, i2;
   gboolean success;
   gboolean pong_copy;
 
-  source_frame_count = 0;
-
-  source_samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
-  source_buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
-  source_format = AGS_SOUNDCARD_DEFAULT_FORMAT;  
-  
-  ags_sound_resource_info(AGS_SOUND_RESOURCE(sfz_sample),
-			  &source_frame_count,
-			  NULL, NULL);
-
-  ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(sfz_sample),
-				 NULL,
-				 &source_samplerate,
-				 &source_buffer_size,
-				 &source_format);
+  sample_cache = ags_sample_cache_get_instance();
 
-  sample_buffer = ags_stream_alloc(source_frame_count,
-				   AGS_SOUNDCARD_DOUBLE);
+  /* lookup resampled and pitched sample */
+  sample_cache_entry = ags_sample_cache_lookup(sample_cache,
+					       (GObject *) sfz_sample,
+					       samplerate, AGS_SOUNDCARD_SIGNED_24_BIT,
+					       note);
 
-  ags_stream_free(sfz_sample->buffer);
-  
-  sfz_sample->buffer = ags_stream_alloc(sfz_sample->audio_channels * source_frame_count,
-					sfz_sample->format);
-  
-  sfz_sample->offset = 0;
+  if(sample_cache_entry == NULL){
+    AgsSampleCacheEntry *decoded_entry;
 
-  ags_sound_resource_read(AGS_SOUND_RESOURCE(sfz_sample),
-			  sample_buffer, 1,
-			  0,
-			  source_frame_count, AGS_SOUNDCARD_DOUBLE);
+    /* the decoded and resampled sample is shared by all notes */
+    decoded_entry = ags_sfz_synth_util_get_decoded(sfz_sample,
+						   samplerate);
 
-  /* resample if needed */
-  frame_count = source_frame_count;
-  
-  if(source_samplerate != samplerate){
-    void *tmp_sample_buffer;
+    frame_count = decoded_entry->frame_count;
 
-    guint tmp_frame_count;
+    /* format a private copy */
+    im_buffer = ags_stream_alloc(frame_count,
+				 AGS_SOUNDCARD_SIGNED_24_BIT);
 
-    tmp_frame_count = (samplerate / source_samplerate) * source_frame_count;
+    copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_S24,
+						    AGS_AUDIO_BUFFER_UTIL_DOUBLE);
 
-    tmp_sample_buffer = ags_stream_alloc(tmp_frame_count,
-					 AGS_SOUNDCARD_DOUBLE);
+    ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
+						decoded_entry->data, 1, 0,
+						frame_count, copy_mode);
 
-    ags_audio_buffer_util_resample_with_buffer(sample_buffer, 1,
-					       AGS_AUDIO_BUFFER_UTIL_DOUBLE, source_samplerate,
-					       source_frame_count,
-					       samplerate,
-					       tmp_frame_count,
-					       tmp_sample_buffer);
-    
-    ags_stream_free(sample_buffer);
+    ags_sample_cache_entry_unref(decoded_entry);
 
-    sample_buffer = tmp_sample_buffer;
-    
-    frame_count = tmp_frame_count;
-  }
-
-  /* format */
-  im_buffer = ags_stream_alloc(frame_count,
-			       AGS_SOUNDCARD_SIGNED_24_BIT);
-
-  copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_S24,
-						  AGS_AUDIO_BUFFER_UTIL_DOUBLE);
-
-  ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
-					      sample_buffer, 1, 0,
-					      frame_count, copy_mode);
-
-  /* pitch */
-  midi_key = 60;
+    /* pitch without holding any lock */
+    midi_key = 60;
   
-  group_key = ags_sfz_group_lookup_control(sfz_sample->group,
-					   "key");
+    group_key = ags_sfz_group_lookup_control(sfz_sample->group,
+					     "key");
 
-  if(group_key != NULL){
-    int retval;
+    if(group_key != NULL){
+      int retval;
     
-    retval = sscanf(group_key, "%d", &current_midi_key);
+      retval = sscanf(group_key, "%d", &current_midi_key);
 
-    if(retval <= 0){
-      retval = ags_diatonic_scale_note_to_midi_key(group_key,
-						   &current_midi_key);
+      if(retval <= 0){
+	retval = ags_diatonic_scale_note_to_midi_key(group_key,
+						     &current_midi_key);
 
-      if(retval > 0){
-	midi_key = current_midi_key;
+	if(retval > 0){
+	  midi_key = current_midi_key;
+	}
       }
-    }
 
-    g_free(group_key);
-  }
+      g_free(group_key);
+    }
   
-  region_key = ags_sfz_region_lookup_control(sfz_sample->region,
-					     "key");
+    region_key = ags_sfz_region_lookup_control(sfz_sample->region,
+					       "key");
 
-  if(region_key != NULL){
-    int retval;
+    if(region_key != NULL){
+      int retval;
     
-    retval = sscanf(region_key, "%d", &current_midi_key);
+      retval = sscanf(region_key, "%d", &current_midi_key);
 
-    if(retval <= 0){
-      retval = ags_diatonic_scale_note_to_midi_key(region_key,
-						   &current_midi_key);
+      if(retval <= 0){
+	retval = ags_diatonic_scale_note_to_midi_key(region_key,
+						     &current_midi_key);
 
-      if(retval > 0){
-	midi_key = current_midi_key;
+	if(retval > 0){
+	  midi_key = current_midi_key;
+	}
       }
-    }
 
-    g_free(region_key);
-  }
+      g_free(region_key);
+    }
   
-  base_key = (gdouble) midi_key - 21.0;
+    base_key = (gdouble) midi_key - 21.0;
 
-  tuning = 100.0 * (note - base_key);
+    tuning = 100.0 * (note - base_key);
   
-  ags_fast_pitch_util_compute_s24(im_buffer,
-				  frame_count,
-				  samplerate,
-				  base_key,
-				  tuning);
+    ags_fast_pitch_util_compute_s24(im_buffer,
+				    frame_count,
+				    samplerate,
+				    base_key,
+				    tuning);
+
+    sample_cache_entry = ags_sample_cache_insert(sample_cache,
+						 (GObject *) sfz_sample,
+						 samplerate, AGS_SOUNDCARD_SIGNED_24_BIT,
+						 note,
+						 im_buffer, frame_count);
+  }
+
+  im_buffer = sample_cache_entry->data;
+  frame_count = sample_cache_entry->frame_count;
 
   success = FALSE;
   pong_copy = FALSE;
@@ -941,8 +954,7 @@ ags_sfz_synth_util_copy_s24(gint32 *buffer,
     }
   }
   
-  ags_stream_free(sample_buffer);
-  ags_stream_free(im_buffer);
+  ags_sample_cache_entry_unref(sample_cache_entry);
 }
 
 /**
@@ -974,9 +986,10 @@ ags_sfz_synth_util_copy_s32(gint32 *buffer,
 			    guint loop_mode,
 			    gint loop_start, gint loop_end)
 {
-  gchar *group_key, *region_key;
+  AgsSampleCache *sample_cache;
+  AgsSampleCacheEntry *sample_cache_entry;
 
-  void *sample_buffer;
+  gchar *group_key, *region_key;
 
   gint32 *im_buffer;
 
@@ -984,137 +997,104 @@ ags_sfz_synth_util_copy_s32(gint32 *buffer,
   guint frame_count;
   gdouble base_key;
   gdouble tuning;
-  guint source_frame_count;
-  guint source_samplerate;
-  guint source_buffer_size;
-  guint source_format;
   guint copy_mode;
 
   guint i0, i1, i2;
   gboolean success;
   gboolean pong_copy;
-  
-  source_frame_count = 0;
 
-  source_samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
-  source_buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
-  source_format = AGS_SOUNDCARD_DEFAULT_FORMAT;  
+  sample_cache = ags_sample_cache_get_instance();
 
-  ags_sound_resource_info(AGS_SOUND_RESOURCE(sfz_sample),
-			  &source_frame_count,
-			  NULL, NULL);
+  /* lookup resampled and pitched sample */
+  sample_cache_entry = ags_sample_cache_lookup(sample_cache,
+					       (GObject *) sfz_sample,
+					       samplerate, AGS_SOUNDCARD_SIGNED_32_BIT,
+					       note);
 
-  ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(sfz_sample),
-				 NULL,
-				 &source_samplerate,
-				 &source_buffer_size,
-				 &source_format);
+  if(sample_cache_entry == NULL){
+    AgsSampleCacheEntry *decoded_entry;
 
-  sample_buffer = ags_stream_alloc(source_frame_count,
-				   AGS_SOUNDCARD_DOUBLE);
+    /* the decoded and resampled sample is shared by all notes */
+    decoded_entry = ags_sfz_synth_util_get_decoded(sfz_sample,
+						   samplerate);
 
-  ags_stream_free(sfz_sample->buffer);
-  
-  sfz_sample->buffer = ags_stream_alloc(sfz_sample->audio_channels * source_frame_count,
-					sfz_sample->format);
-  
-  sfz_sample->offset = 0;
-
-  ags_sound_resource_read(AGS_SOUND_RESOURCE(sfz_sample),
-			  sample_buffer, 1,
-			  0,
-			  source_frame_count, AGS_SOUNDCARD_DOUBLE);
-
-  /* resample if needed */
-  frame_count = source_frame_count;
-  
-  if(source_samplerate != samplerate){
-    void *tmp_sample_buffer;
+    frame_count = decoded_entry->frame_count;
 
-    guint tmp_frame_count;
+    /* format a private copy */
+    im_buffer = ags_stream_alloc(frame_count,
+				 AGS_SOUNDCARD_SIGNED_32_BIT);
 
-    tmp_frame_count = (samplerate / source_samplerate) * source_frame_count;
+    copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_S32,
+						    AGS_AUDIO_BUFFER_UTIL_DOUBLE);
 
-    tmp_sample_buffer = ags_stream_alloc(tmp_frame_count,
-					 AGS_SOUNDCARD_DOUBLE);
-
-    ags_audio_buffer_util_resample_with_buffer(sample_buffer, 1,
-					       AGS_AUDIO_BUFFER_UTIL_DOUBLE, source_samplerate,
-					       source_frame_count,
-					       samplerate,
-					       tmp_frame_count,
-					       tmp_sample_buffer);
-    
-    ags_stream_free(sample_buffer);
-
-    sample_buffer = tmp_sample_buffer;
-    
-    frame_count = tmp_frame_count;
-  }
+    ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
+						decoded_entry->data, 1, 0,
+						frame_count, copy_mode);
 
-  /* format */
-  im_buffer = ags_stream_alloc(frame_count,
-			       AGS_SOUNDCARD_SIGNED_32_BIT);
+    ags_sample_cache_entry_unref(decoded_entry);
 
-  copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_S32,
-						  AGS_AUDIO_BUFFER_UTIL_DOUBLE);
-
-  ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
-					      sample_buffer, 1, 0,
-					      frame_count, copy_mode);
-
-  /* pitch */
-  midi_key = 60;
+    /* pitch without holding any lock */
+    midi_key = 60;
   
-  group_key = ags_sfz_group_lookup_control(sfz_sample->group,
-					   "key");
+    group_key = ags_sfz_group_lookup_control(sfz_sample->group,
+					     "key");
 
-  if(group_key != NULL){
-    int retval;
+    if(group_key != NULL){
+      int retval;
     
-    retval = sscanf(group_key, "%d", &current_midi_key);
+      retval = sscanf(group_key, "%d", &current_midi_key);
 
-    if(retval <= 0){
-      retval = ags_diatonic_scale_note_to_midi_key(group_key,
-						   &current_midi_key);
+      if(retval <= 0){
+	retval = ags_diatonic_scale_note_to_midi_key(group_key,
+						     &current_midi_key);
 
-      if(retval > 0){
-	midi_key = current_midi_key;
+	if(retval > 0){
+	  midi_key = current_midi_key;
+	}
       }
-    }
 
-    g_free(group_key);
-  }
+      g_free(group_key);
+    }
   
-  region_key = ags_sfz_region_lookup_control(sfz_sample->region,
-					     "key");
+    region_key = ags_sfz_region_lookup_control(sfz_sample->region,
+					       "key");
 
-  if(region_key != NULL){
-    int retval;
+    if(region_key != NULL){
+      int retval;
     
-    retval = sscanf(region_key, "%d", &current_midi_key);
+      retval = sscanf(region_key, "%d", &current_midi_key);
 
-    if(retval <= 0){
-      retval = ags_diatonic_scale_note_to_midi_key(region_key,
-						   &current_midi_key);
+      if(retval <= 0){
+	retval = ags_diatonic_scale_note_to_midi_key(region_key,
+						     &current_midi_key);
 
-      if(retval > 0){
-	midi_key = current_midi_key;
+	if(retval > 0){
+	  midi_key = current_midi_key;
+	}
       }
-    }
 
-    g_free(region_key);
-  }
+      g_free(region_key);
+    }
   
-  base_key = (gdouble) midi_key - 21.0;
+    base_key = (gdouble) midi_key - 21.0;
 
-  tuning = 100.0 * (note - base_key);
+    tuning = 100.0 * (note - base_key);
   
-  ags_fast_pitch_util_compute_s32(im_buffer,
-				  frame_count,
-				  samplerate,
-				  base_key,
-				  tuning);
+    ags_fast_pitch_util_compute_s32(im_buffer,
+				    frame_count,
+				    samplerate,
+				    base_key,
+				    tuning);
+
+    sample_cache_entry = ags_sample_cache_insert(sample_cache,
+						 (GObject *) sfz_sample,
+						 samplerate, AGS_SOUNDCARD_SIGNED_32_BIT,
+						 note,
+						 im_buffer, frame_count);
+  }
+
+  im_buffer = sample_cache_entry->data;
+  frame_count = sample_cache_entry->frame_count;
 
   success = FALSE;
   pong_copy = FALSE;
@@ -1239,8 +1219,7 @@ ags_sfz_synth_util_copy_s32(gint32 *buffer,
     }
   }
 
-  ags_stream_free(sample_buffer);
-  ags_stream_free(im_buffer);
+  ags_sample_cache_entry_unref(sample_cache_entry);
 }
 
 /**
@@ -1272,9 +1251,10 @@ ags_sfz_synth_util_copy_s64(gint64 *buffer,
 			    guint loop_mode,
 			    gint loop_start, gint loop_end)
 {
-  gchar *group_key, *region_key;
+  AgsSampleCache *sample_cache;
+  AgsSampleCacheEntry *sample_cache_entry;
 
-  void *sample_buffer;
+  gchar *group_key, *region_key;
 
   gint64 *im_buffer;
 
@@ -1282,137 +1262,104 @@ ags_sfz_synth_util_copy_s64(gint64 *buffer,
   guint frame_count;
   gdouble base_key;
   gdouble tuning;
-  guint source_frame_count;
-  guint source_samplerate;
-  guint source_buffer_size;
-  guint source_format;
   guint copy_mode;
 
   guint i0, i1, i2;
   gboolean success;
   gboolean pong_copy;
 
-  source_frame_count = 0;
+  sample_cache = ags_sample_cache_get_instance();
 
-  source_samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
-  source_buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
-  source_format = AGS_SOUNDCARD_DEFAULT_FORMAT;  
-  
-  ags_sound_resource_info(AGS_SOUND_RESOURCE(sfz_sample),
-			  &source_frame_count,
-			  NULL, NULL);
+  /* lookup resampled and pitched sample */
+  sample_cache_entry = ags_sample_cache_lookup(sample_cache,
+					       (GObject *) sfz_sample,
+					       samplerate, AGS_SOUNDCARD_SIGNED_64_BIT,
+					       note);
 
-  ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(sfz_sample),
-				 NULL,
-				 &source_samplerate,
-				 &source_buffer_size,
-				 &source_format);
+  if(sample_cache_entry == NULL){
+    AgsSampleCacheEntry *decoded_entry;
 
-  sample_buffer = ags_stream_alloc(source_frame_count,
-				   AGS_SOUNDCARD_DOUBLE);
+    /* the decoded and resampled sample is shared by all notes */
+    decoded_entry = ags_sfz_synth_util_get_decoded(sfz_sample,
+						   samplerate);
 
-  ags_stream_free(sfz_sample->buffer);
-  
-  sfz_sample->buffer = ags_stream_alloc(sfz_sample->audio_channels * source_frame_count,
-					sfz_sample->format);
-  
-  sfz_sample->offset = 0;
+    frame_count = decoded_entry->frame_count;
 
-  ags_sound_resource_read(AGS_SOUND_RESOURCE(sfz_sample),
-			  sample_buffer, 1,
-			  0,
-			  source_frame_count, AGS_SOUNDCARD_DOUBLE);
+    /* format a private copy */
+    im_buffer = ags_stream_alloc(frame_count,
+				 AGS_SOUNDCARD_SIGNED_64_BIT);
 
-  /* resample if needed */
-  frame_count = source_frame_count;
-  
-  if(source_samplerate != samplerate){
-    void *tmp_sample_buffer;
+    copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_S64,
+						    AGS_AUDIO_BUFFER_UTIL_DOUBLE);
 
-    guint tmp_frame_count;
+    ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
+						decoded_entry->data, 1, 0,
+						frame_count, copy_mode);
 
-    tmp_frame_count = (samplerate / source_samplerate) * source_frame_count;
+    ags_sample_cache_entry_unref(decoded_entry);
 
-    tmp_sample_buffer = ags_stream_alloc(tmp_frame_count,
-					 AGS_SOUNDCARD_DOUBLE);
-
-    ags_audio_buffer_util_resample_with_buffer(sample_buffer, 1,
-					       AGS_AUDIO_BUFFER_UTIL_DOUBLE, source_samplerate,
-					       source_frame_count,
-					       samplerate,
-					       tmp_frame_count,
-					       tmp_sample_buffer);
-    
-    ags_stream_free(sample_buffer);
-
-    sample_buffer = tmp_sample_buffer;
-    
-    frame_count = tmp_frame_count;
-  }
-
-  /* format */
-  im_buffer = ags_stream_alloc(frame_count,
-			       AGS_SOUNDCARD_SIGNED_64_BIT);
-
-  copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_S64,
-						  AGS_AUDIO_BUFFER_UTIL_DOUBLE);
-
-  ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
-					      sample_buffer, 1, 0,
-					      frame_count, copy_mode);
-
-  /* pitch */
-  midi_key = 60;
+    /* pitch without holding any lock */
+    midi_key = 60;
   
-  group_key = ags_sfz_group_lookup_control(sfz_sample->group,
-					   "key");
+    group_key = ags_sfz_group_lookup_control(sfz_sample->group,
+					     "key");
 
-  if(group_key != NULL){
-    int retval;
+    if(group_key != NULL){
+      int retval;
     
-    retval = sscanf(group_key, "%d", &current_midi_key);
+      retval = sscanf(group_key, "%d", &current_midi_key);
 
-    if(retval <= 0){
-      retval = ags_diatonic_scale_note_to_midi_key(group_key,
-						   &current_midi_key);
+      if(retval <= 0){
+	retval = ags_diatonic_scale_note_to_midi_key(group_key,
+						     &current_midi_key);
 
-      if(retval > 0){
-	midi_key = current_midi_key;
+	if(retval > 0){
+	  midi_key = current_midi_key;
+	}
       }
-    }
 
-    g_free(group_key);
-  }
+      g_free(group_key);
+    }
   
-  region_key = ags_sfz_region_lookup_control(sfz_sample->region,
-					     "key");
+    region_key = ags_sfz_region_lookup_control(sfz_sample->region,
+					       "key");
 
-  if(region_key != NULL){
-    int retval;
+    if(region_key != NULL){
+      int retval;
     
-    retval = sscanf(region_key, "%d", &current_midi_key);
+      retval = sscanf(region_key, "%d", &current_midi_key);
 
-    if(retval <= 0){
-      retval = ags_diatonic_scale_note_to_midi_key(region_key,
-						   &current_midi_key);
+      if(retval <= 0){
+	retval = ags_diatonic_scale_note_to_midi_key(region_key,
+						     &current_midi_key);
 
-      if(retval > 0){
-	midi_key = current_midi_key;
+	if(retval > 0){
+	  midi_key = current_midi_key;
+	}
       }
-    }
 
-    g_free(region_key);
-  }
+      g_free(region_key);
+    }
   
-  base_key = (gdouble) midi_key - 21.0;
+    base_key = (gdouble) midi_key - 21.0;
 
-  tuning = 100.0 * (note - base_key);
+    tuning = 100.0 * (note - base_key);
   
-  ags_fast_pitch_util_compute_s64(im_buffer,
-				  frame_count,
-				  samplerate,
-				  base_key,
-				  tuning);
+    ags_fast_pitch_util_compute_s64(im_buffer,
+				    frame_count,
+				    samplerate,
+				    base_key,
+				    tuning);
+
+    sample_cache_entry = ags_sample_cache_insert(sample_cache,
+						 (GObject *) sfz_sample,
+						 samplerate, AGS_SOUNDCARD_SIGNED_64_BIT,
+						 note,
+						 im_buffer, frame_count);
+  }
+
+  im_buffer = sample_cache_entry->data;
+  frame_count = sample_cache_entry->frame_count;
 
   success = FALSE;
   pong_copy = FALSE;
@@ -1537,8 +1484,7 @@ ags_sfz_synth_util_copy_s64(gint64 *buffer,
     }
   }
 
-  ags_stream_free(sample_buffer);
-  ags_stream_free(im_buffer);
+  ags_sample_cache_entry_unref(sample_cache_entry);
 }
 
 /**
@@ -1570,9 +1516,10 @@ ags_sfz_synth_util_copy_float(gfloat *buffer,
 			      guint loop_mode,
 			      gint loop_start, gint loop_end)
 {
-  gchar *group_key, *region_key;
+  AgsSampleCache *sample_cache;
+  AgsSampleCacheEntry *sample_cache_entry;
 
-  void *sample_buffer;
+  gchar *group_key, *region_key;
 
   gfloat *im_buffer;
 
@@ -1580,137 +1527,104 @@ ags_sfz_synth_util_copy_float(gfloat *buffer,
   guint frame_count;
   gdouble base_key;
   gdouble tuning;
-  guint source_frame_count;
-  guint source_samplerate;
-  guint source_buffer_size;
-  guint source_format;
   guint copy_mode;
 
   guint i0, i1, i2;
   gboolean success;
   gboolean pong_copy;
 
-  source_frame_count = 0;
-
-  source_samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
-  source_buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
-  source_format = AGS_SOUNDCARD_DEFAULT_FORMAT;  
-  
-  ags_sound_resource_info(AGS_SOUND_RESOURCE(sfz_sample),
-			  &source_frame_count,
-			  NULL, NULL);
+  sample_cache = ags_sample_cache_get_instance();
 
-  ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(sfz_sample),
-				 NULL,
-				 &source_samplerate,
-				 &source_buffer_size,
-				 &source_format);
+  /* lookup resampled and pitched sample */
+  sample_cache_entry = ags_sample_cache_lookup(sample_cache,
+					       (GObject *) sfz_sample,
+					       samplerate, AGS_SOUNDCARD_FLOAT,
+					       note);
 
-  sample_buffer = ags_stream_alloc(source_frame_count,
-				   AGS_SOUNDCARD_DOUBLE);
+  if(sample_cache_entry == NULL){
+    AgsSampleCacheEntry *decoded_entry;
 
-  ags_stream_free(sfz_sample->buffer);
-  
-  sfz_sample->buffer = ags_stream_alloc(sfz_sample->audio_channels * source_frame_count,
-					sfz_sample->format);
-  
-  sfz_sample->offset = 0;
+    /* the decoded and resampled sample is shared by all notes */
+    decoded_entry = ags_sfz_synth_util_get_decoded(sfz_sample,
+						   samplerate);
 
-  ags_sound_resource_read(AGS_SOUND_RESOURCE(sfz_sample),
-			  sample_buffer, 1,
-			  0,
-			  source_frame_count, AGS_SOUNDCARD_DOUBLE);
+    frame_count = decoded_entry->frame_count;
 
-  /* resample if needed */
-  frame_count = source_frame_count;
-  
-  if(source_samplerate != samplerate){
-    void *tmp_sample_buffer;
+    /* format a private copy */
+    im_buffer = ags_stream_alloc(frame_count,
+				 AGS_SOUNDCARD_FLOAT);
 
-    guint tmp_frame_count;
+    copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_FLOAT,
+						    AGS_AUDIO_BUFFER_UTIL_DOUBLE);
 
-    tmp_frame_count = (samplerate / source_samplerate) * source_frame_count;
+    ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
+						decoded_entry->data, 1, 0,
+						frame_count, copy_mode);
 
-    tmp_sample_buffer = ags_stream_alloc(tmp_frame_count,
-					 AGS_SOUNDCARD_DOUBLE);
-
-    ags_audio_buffer_util_resample_with_buffer(sample_buffer, 1,
-					       AGS_AUDIO_BUFFER_UTIL_DOUBLE, source_samplerate,
-					       source_frame_count,
-					       samplerate,
-					       tmp_frame_count,
-					       tmp_sample_buffer);
-    
-    ags_stream_free(sample_buffer);
-
-    sample_buffer = tmp_sample_buffer;
-    
-    frame_count = tmp_frame_count;
-  }
+    ags_sample_cache_entry_unref(decoded_entry);
 
-  /* format */
-  im_buffer = ags_stream_alloc(frame_count,
-			       AGS_SOUNDCARD_FLOAT);
-
-  copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_FLOAT,
-						  AGS_AUDIO_BUFFER_UTIL_DOUBLE);
-
-  ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
-					      sample_buffer, 1, 0,
-					      frame_count, copy_mode);
-
-  /* pitch */
-  midi_key = 60;
+    /* pitch without holding any lock */
+    midi_key = 60;
   
-  group_key = ags_sfz_group_lookup_control(sfz_sample->group,
-					   "key");
+    group_key = ags_sfz_group_lookup_control(sfz_sample->group,
+					     "key");
 
-  if(group_key != NULL){
-    int retval;
+    if(group_key != NULL){
+      int retval;
     
-    retval = sscanf(group_key, "%d", &current_midi_key);
+      retval = sscanf(group_key, "%d", &current_midi_key);
 
-    if(retval <= 0){
-      retval = ags_diatonic_scale_note_to_midi_key(group_key,
-						   &current_midi_key);
+      if(retval <= 0){
+	retval = ags_diatonic_scale_note_to_midi_key(group_key,
+						     &current_midi_key);
 
-      if(retval > 0){
-	midi_key = current_midi_key;
+	if(retval > 0){
+	  midi_key = current_midi_key;
+	}
       }
-    }
 
-    g_free(group_key);
-  }
+      g_free(group_key);
+    }
   
-  region_key = ags_sfz_region_lookup_control(sfz_sample->region,
-					     "key");
+    region_key = ags_sfz_region_lookup_control(sfz_sample->region,
+					       "key");
 
-  if(region_key != NULL){
-    int retval;
+    if(region_key != NULL){
+      int retval;
     
-    retval = sscanf(region_key, "%d", &current_midi_key);
+      retval = sscanf(region_key, "%d", &current_midi_key);
 
-    if(retval <= 0){
-      retval = ags_diatonic_scale_note_to_midi_key(region_key,
-						   &current_midi_key);
+      if(retval <= 0){
+	retval = ags_diatonic_scale_note_to_midi_key(region_key,
+						     &current_midi_key);
 
-      if(retval > 0){
-	midi_key = current_midi_key;
+	if(retval > 0){
+	  midi_key = current_midi_key;
+	}
       }
-    }
 
-    g_free(region_key);
-  }
+      g_free(region_key);
+    }
   
-  base_key = (gdouble) midi_key - 21.0;
+    base_key = (gdouble) midi_key - 21.0;
 
-  tuning = 100.0 * (note - base_key);
+    tuning = 100.0 * (note - base_key);
   
-  ags_fast_pitch_util_compute_float(im_buffer,
-				    frame_count,
-				    samplerate,
-				    base_key,
-				    tuning);
+    ags_fast_pitch_util_compute_float(im_buffer,
+				      frame_count,
+				      samplerate,
+				      base_key,
+				      tuning);
+
+    sample_cache_entry = ags_sample_cache_insert(sample_cache,
+						 (GObject *) sfz_sample,
+						 samplerate, AGS_SOUNDCARD_FLOAT,
+						 note,
+						 im_buffer, frame_count);
+  }
+
+  im_buffer = sample_cache_entry->data;
+  frame_count = sample_cache_entry->frame_count;
 
   success = FALSE;
   pong_copy = FALSE;
@@ -1835,8 +1749,7 @@ ags_sfz_synth_util_copy_float(gfloat *buffer,
     }
   }
   
-  ags_stream_free(sample_buffer);
-  ags_stream_free(im_buffer);
+  ags_sample_cache_entry_unref(sample_cache_entry);
 }
 
 /**
@@ -1868,9 +1781,10 @@ ags_sfz_synth_util_copy_double(gdouble *buffer,
 			       guint loop_mode,
 			       gint loop_start, gint loop_end)
 {
-  gchar *group_key, *region_key;
+  AgsSampleCache *sample_cache;
+  AgsSampleCacheEntry *sample_cache_entry;
 
-  void *sample_buffer;
+  gchar *group_key, *region_key;
 
   gdouble *im_buffer;
 
@@ -1878,137 +1792,104 @@ ags_sfz_synth_util_copy_double(gdouble *buffer,
   guint frame_count;
   gdouble base_key;
   gdouble tuning;
-  guint source_frame_count;
-  guint source_samplerate;
-  guint source_buffer_size;
-  guint source_format;
   guint copy_mode;
 
   guint i0, i1, i2;
   gboolean success;
   gboolean pong_copy;
-    
-  source_frame_count = 0;
-
-  source_samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
-  source_buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
-  source_format = AGS_SOUNDCARD_DEFAULT_FORMAT;  
-
-  ags_sound_resource_info(AGS_SOUND_RESOURCE(sfz_sample),
-			  &source_frame_count,
-			  NULL, NULL);
 
-  ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(sfz_sample),
-				 NULL,
-				 &source_samplerate,
-				 &source_buffer_size,
-				 &source_format);
+  sample_cache = ags_sample_cache_get_instance();
 
-  sample_buffer = ags_stream_alloc(source_frame_count,
-				   AGS_SOUNDCARD_DOUBLE);
+  /* lookup resampled and pitched sample */
+  sample_cache_entry = ags_sample_cache_lookup(sample_cache,
+					       (GObject *) sfz_sample,
+					       samplerate, AGS_SOUNDCARD_DOUBLE,
+					       note);
 
-  ags_stream_free(sfz_sample->buffer);
-  
-  sfz_sample->buffer = ags_stream_alloc(sfz_sample->audio_channels * source_frame_count,
-					sfz_sample->format);
-  
-  sfz_sample->offset = 0;
+  if(sample_cache_entry == NULL){
+    AgsSampleCacheEntry *decoded_entry;
 
-  ags_sound_resource_read(AGS_SOUND_RESOURCE(sfz_sample),
-			  sample_buffer, 1,
-			  0,
-			  source_frame_count, AGS_SOUNDCARD_DOUBLE);
+    /* the decoded and resampled sample is shared by all notes */
+    decoded_entry = ags_sfz_synth_util_get_decoded(sfz_sample,
+						   samplerate);
 
-  /* resample if needed */
-  frame_count = source_frame_count;
-  
-  if(source_samplerate != samplerate){
-    void *tmp_sample_buffer;
+    frame_count = decoded_entry->frame_count;
 
-    guint tmp_frame_count;
+    /* format a private copy */
+    im_buffer = ags_stream_alloc(frame_count,
+				 AGS_SOUNDCARD_DOUBLE);
 
-    tmp_frame_count = (samplerate / source_samplerate) * source_frame_count;
+    copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_DOUBLE,
+						    AGS_AUDIO_BUFFER_UTIL_DOUBLE);
 
-    tmp_sample_buffer = ags_stream_alloc(tmp_frame_count,
-					 AGS_SOUNDCARD_DOUBLE);
-
-    ags_audio_buffer_util_resample_with_buffer(sample_buffer, 1,
-					       AGS_AUDIO_BUFFER_UTIL_DOUBLE, source_samplerate,
-					       source_frame_count,
-					       samplerate,
-					       tmp_frame_count,
-					       tmp_sample_buffer);
-    
-    ags_stream_free(sample_buffer);
-
-    sample_buffer = tmp_sample_buffer;
-    
-    frame_count = tmp_frame_count;
-  }
+    ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
+						decoded_entry->data, 1, 0,
+						frame_count, copy_mode);
 
-  /* format */
-  im_buffer = ags_stream_alloc(frame_count,
-			       AGS_SOUNDCARD_DOUBLE);
+    ags_sample_cache_entry_unref(decoded_entry);
 
-  copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_DOUBLE,
-						  AGS_AUDIO_BUFFER_UTIL_DOUBLE);
-
-  ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
-					      sample_buffer, 1, 0,
-					      frame_count, copy_mode);
-
-  /* pitch */
-  midi_key = 60;
+    /* pitch without holding any lock */
+    midi_key = 60;
   
-  group_key = ags_sfz_group_lookup_control(sfz_sample->group,
-					   "key");
+    group_key = ags_sfz_group_lookup_control(sfz_sample->group,
+					     "key");
 
-  if(group_key != NULL){
-    int retval;
+    if(group_key != NULL){
+      int retval;
     
-    retval = sscanf(group_key, "%d", &current_midi_key);
+      retval = sscanf(group_key, "%d", &current_midi_key);
 
-    if(retval <= 0){
-      retval = ags_diatonic_scale_note_to_midi_key(group_key,
-						   &current_midi_key);
+      if(retval <= 0){
+	retval = ags_diatonic_scale_note_to_midi_key(group_key,
+						     &current_midi_key);
 
-      if(retval > 0){
-	midi_key = current_midi_key;
+	if(retval > 0){
+	  midi_key = current_midi_key;
+	}
       }
-    }
 
-    g_free(group_key);
-  }
+      g_free(group_key);
+    }
   
-  region_key = ags_sfz_region_lookup_control(sfz_sample->region,
-					     "key");
+    region_key = ags_sfz_region_lookup_control(sfz_sample->region,
+					       "key");
 
-  if(region_key != NULL){
-    int retval;
+    if(region_key != NULL){
+      int retval;
     
-    retval = sscanf(region_key, "%d", &current_midi_key);
+      retval = sscanf(region_key, "%d", &current_midi_key);
 
-    if(retval <= 0){
-      retval = ags_diatonic_scale_note_to_midi_key(region_key,
-						   &current_midi_key);
+      if(retval <= 0){
+	retval = ags_diatonic_scale_note_to_midi_key(region_key,
+						     &current_midi_key);
 
-      if(retval > 0){
-	midi_key = current_midi_key;
+	if(retval > 0){
+	  midi_key = current_midi_key;
+	}
       }
-    }
 
-    g_free(region_key);
-  }
+      g_free(region_key);
+    }
   
-  base_key = (gdouble) midi_key - 21.0;
+    base_key = (gdouble) midi_key - 21.0;
 
-  tuning = 100.0 * (note - base_key);
+    tuning = 100.0 * (note - base_key);
   
-  ags_fast_pitch_util_compute_double(im_buffer,
-				     frame_count,
-				     samplerate,
-				     base_key,
-				     tuning);
+    ags_fast_pitch_util_compute_double(im_buffer,
+				       frame_count,
+				       samplerate,
+				       base_key,
+				       tuning);
+
+    sample_cache_entry = ags_sample_cache_insert(sample_cache,
+						 (GObject *) sfz_sample,
+						 samplerate, AGS_SOUNDCARD_DOUBLE,
+						 note,
+						 im_buffer, frame_count);
+  }
+
+  im_buffer = sample_cache_entry->data;
+  frame_count = sample_cache_entry->frame_count;
 
   success = FALSE;
   pong_copy = FALSE;
@@ -2133,8 +2014,7 @@ ags_sfz_synth_util_copy_double(gdouble *buffer,
     }
   }
   
-  ags_stream_free(sample_buffer);
-  ags_stream_free(im_buffer);
+  ags_sample_cache_entry_unref(sample_cache_entry);
 }
 
 /**
@@ -2166,9 +2046,10 @@ ags_sfz_synth_util_copy_complex(AgsComplex *buffer,
 				guint loop_mode,
 				gint loop_start, gint loop_end)
 {
-  gchar *group_key, *region_key;
+  AgsSampleCache *sample_cache;
+  AgsSampleCacheEntry *sample_cache_entry;
 
-  void *sample_buffer;
+  gchar *group_key, *region_key;
 
   AgsComplex *im_buffer;
 
@@ -2176,137 +2057,104 @@ ags_sfz_synth_util_copy_complex(AgsComplex *buffer,
   guint frame_count;
   gdouble base_key;
   gdouble tuning;
-  guint source_frame_count;
-  guint source_samplerate;
-  guint source_buffer_size;
-  guint source_format;
   guint copy_mode;
 
   guint i0, i1, i2;
   gboolean success;
   gboolean pong_copy;
 
-  source_frame_count = 0;
-
-  source_samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
-  source_buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
-  source_format = AGS_SOUNDCARD_DEFAULT_FORMAT;  
-  
-  ags_sound_resource_info(AGS_SOUND_RESOURCE(sfz_sample),
-			  &source_frame_count,
-			  NULL, NULL);
-
-  ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(sfz_sample),
-				 NULL,
-				 &source_samplerate,
-				 &source_buffer_size,
-				 &source_format);
-
-  sample_buffer = ags_stream_alloc(source_frame_count,
-				   AGS_SOUNDCARD_DOUBLE);
-
-  ags_stream_free(sfz_sample->buffer);
-  
-  sfz_sample->buffer = ags_stream_alloc(sfz_sample->audio_channels * source_frame_count,
-					sfz_sample->format);
-  
-  sfz_sample->offset = 0;
-
-  ags_sound_resource_read(AGS_SOUND_RESOURCE(sfz_sample),
-			  sample_buffer, 1,
-			  0,
-			  source_frame_count, AGS_SOUNDCARD_DOUBLE);
-
-  /* resample if needed */
-  frame_count = source_frame_count;
-  
-  if(source_samplerate != samplerate){
-    void *tmp_sample_buffer;
+  sample_cache = ags_sample_cache_get_instance();
 
-    guint tmp_frame_count;
+  /* lookup resampled and pitched sample */
+  sample_cache_entry = ags_sample_cache_lookup(sample_cache,
+					       (GObject *) sfz_sample,
+					       samplerate, AGS_SOUNDCARD_COMPLEX,
+					       note);
 
-    tmp_frame_count = (samplerate / source_samplerate) * source_frame_count;
+  if(sample_cache_entry == NULL){
+    AgsSampleCacheEntry *decoded_entry;
 
-    tmp_sample_buffer = ags_stream_alloc(tmp_frame_count,
-					 AGS_SOUNDCARD_DOUBLE);
+    /* the decoded and resampled sample is shared by all notes */
+    decoded_entry = ags_sfz_synth_util_get_decoded(sfz_sample,
+						   samplerate);
 
-    ags_audio_buffer_util_resample_with_buffer(sample_buffer, 1,
-					       AGS_AUDIO_BUFFER_UTIL_DOUBLE, source_samplerate,
-					       source_frame_count,
-					       samplerate,
-					       tmp_frame_count,
-					       tmp_sample_buffer);
-    
-    ags_stream_free(sample_buffer);
+    frame_count = decoded_entry->frame_count;
 
-    sample_buffer = tmp_sample_buffer;
-    
-    frame_count = tmp_frame_count;
-  }
+    /* format a private copy */
+    im_buffer = ags_stream_alloc(frame_count,
+				 AGS_SOUNDCARD_COMPLEX);
 
-  /* format */
-  im_buffer = ags_stream_alloc(frame_count,
-			       AGS_SOUNDCARD_COMPLEX);
+    copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_COMPLEX,
+						    AGS_AUDIO_BUFFER_UTIL_DOUBLE);
 
-  copy_mode = ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_COMPLEX,
-						  AGS_AUDIO_BUFFER_UTIL_DOUBLE);
+    ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
+						decoded_entry->data, 1, 0,
+						frame_count, copy_mode);
 
-  ags_audio_buffer_util_copy_buffer_to_buffer(im_buffer, 1, 0,
-					      sample_buffer, 1, 0,
-					      frame_count, copy_mode);
+    ags_sample_cache_entry_unref(decoded_entry);
 
-  /* pitch */
-  midi_key = 60;
+    /* pitch without holding any lock */
+    midi_key = 60;
   
-  group_key = ags_sfz_group_lookup_control(sfz_sample->group,
-					   "key");
+    group_key = ags_sfz_group_lookup_control(sfz_sample->group,
+					     "key");
 
-  if(group_key != NULL){
-    int retval;
+    if(group_key != NULL){
+      int retval;
     
-    retval = sscanf(group_key, "%d", &current_midi_key);
+      retval = sscanf(group_key, "%d", &current_midi_key);
 
-    if(retval <= 0){
-      retval = ags_diatonic_scale_note_to_midi_key(group_key,
-						   &current_midi_key);
+      if(retval <= 0){
+	retval = ags_diatonic_scale_note_to_midi_key(group_key,
+						     &current_midi_key);
 
-      if(retval > 0){
-	midi_key = current_midi_key;
+	if(retval > 0){
+	  midi_key = current_midi_key;
+	}
       }
-    }
 
-    g_free(group_key);
-  }
+      g_free(group_key);
+    }
   
-  region_key = ags_sfz_region_lookup_control(sfz_sample->region,
-					     "key");
+    region_key = ags_sfz_region_lookup_control(sfz_sample->region,
+					       "key");
 
-  if(region_key != NULL){
-    int retval;
+    if(region_key != NULL){
+      int retval;
     
-    retval = sscanf(region_key, "%d", &current_midi_key);
+      retval = sscanf(region_key, "%d", &current_midi_key);
 
-    if(retval <= 0){
-      retval = ags_diatonic_scale_note_to_midi_key(region_key,
-						   &current_midi_key);
+      if(retval <= 0){
+	retval = ags_diatonic_scale_note_to_midi_key(region_key,
+						     &current_midi_key);
 
-      if(retval > 0){
-	midi_key = current_midi_key;
+	if(retval > 0){
+	  midi_key = current_midi_key;
+	}
       }
-    }
 
-    g_free(region_key);
-  }
+      g_free(region_key);
+    }
   
-  base_key = (gdouble) midi_key - 21.0;
+    base_key = (gdouble) midi_key - 21.0;
 
-  tuning = 100.0 * (note - base_key);
+    tuning = 100.0 * (note - base_key);
   
-  ags_fast_pitch_util_compute_complex(im_buffer,
-				      frame_count,
-				      samplerate,
-				      base_key,
-				      tuning);
+    ags_fast_pitch_util_compute_complex(im_buffer,
+					frame_count,
+					samplerate,
+					base_key,
+					tuning);
+
+    sample_cache_entry = ags_sample_cache_insert(sample_cache,
+						 (GObject *) sfz_sample,
+						 samplerate, AGS_SOUNDCARD_COMPLEX,
+						 note,
+						 im_buffer, frame_count);
+  }
+
+  im_buffer = sample_cache_entry->data;
+  frame_count = sample_cache_entry->frame_count;
 
   success = FALSE;
   pong_copy = FALSE;
@@ -2431,8 +2279,7 @@ ags_sfz_synth_util_copy_complex(AgsComplex *buffer,
     }
   }
 
-  ags_stream_free(sample_buffer);
-  ags_stream_free(im_buffer);
+  ags_sample_cache_entry_unref(sample_cache_entry);
 }
 
 /**
@@ -40,6 +40,7 @@
 #endif
 
 #include <math.h>
+#include <string.h>
 
 /**
  * SECTION:ags_soundcard_util
@@ -222,3 +223,132 @@ ags_soundcard_util_adjust_delay_and_attack(GObject *soundcard)
 
   g_rec_mutex_unlock(obj_mutex);  
 }
+
+/**
+ * ags_soundcard_util_convert_float_to_device:
+ * @destination: the device buffer
+ * @device_format: the device format as #AgsSoundcardFormat-enum
+ * @source: the float mix bus buffer
+ * @count: the count of samples, pcm channels times frames
+ * 
+ * Convert @source to @device_format and write it to @destination. The samples
+ * are clipped to the range of -1.0 to 1.0 and rounded to the nearest integer,
+ * so full scale maps symmetrically to the largest positive value and its
+ * negation. @destination is overwritten.
+ * 
+ * Since: 3.7.0
+ */
+void
+ags_soundcard_util_convert_float_to_device(void *destination, guint device_format,
+					   gfloat *source,
+					   guint count)
+{
+  gfloat value;
+  guint i;
+  
+  if(destination == NULL ||
+     source == NULL){
+    return;
+  }
+
+  switch(device_format){
+  case AGS_SOUNDCARD_SIGNED_8_BIT:
+    {
+      gint8 *buffer;
+
+      buffer = (gint8 *) destination;
+      
+      for(i = 0; i < count; i++){
+	value = source[i];
+
+	value = (value > 1.0f) ? 1.0f: ((value < -1.0f) ? -1.0f: value);
+	
+	buffer[i] = (gint8) lrintf(value * 127.0f);
+      }
+    }
+    break;
+  case AGS_SOUNDCARD_SIGNED_16_BIT:
+    {
+      gint16 *buffer;
+
+      buffer = (gint16 *) destination;
+      
+      for(i = 0; i < count; i++){
+	value = source[i];
+
+	value = (value > 1.0f) ? 1.0f: ((value < -1.0f) ? -1.0f: value);
+	
+	buffer[i] = (gint16) lrintf(value * 32767.0f);
+      }
+    }
+    break;
+  case AGS_SOUNDCARD_SIGNED_24_BIT:
+    {
+      gint32 *buffer;
+
+      buffer = (gint32 *) destination;
+      
+      for(i = 0; i < count; i++){
+	value = source[i];
+
+	value = (value > 1.0f) ? 1.0f: ((value < -1.0f) ? -1.0f: value);
+	
+	buffer[i] = (gint32) lrintf(value * 8388607.0f);
+      }
+    }
+    break;
+  case AGS_SOUNDCARD_SIGNED_32_BIT:
+    {
+      gint32 *buffer;
+
+      buffer = (gint32 *) destination;
+      
+      for(i = 0; i < count; i++){
+	gdouble double_value;
+	
+	double_value = (gdouble) source[i];
+
+	double_value = (double_value > 1.0) ? 1.0: ((double_value < -1.0) ? -1.0: double_value);
+	
+	buffer[i] = (gint32) lrint(double_value * 2147483647.0);
+      }
+    }
+    break;
+  case AGS_SOUNDCARD_SIGNED_64_BIT:
+    {
+      gint64 *buffer;
+
+      buffer = (gint64 *) destination;
+      
+      for(i = 0; i < count; i++){
+	gdouble double_value;
+	
+	double_value = (gdouble) source[i];
+
+	double_value = (double_value > 1.0) ? 1.0: ((double_value < -1.0) ? -1.0: double_value);
+
+	/* 2^63 - 1 isn't representable as double, stay below */
+	buffer[i] = (gint64) llrint(double_value * 9223372036854774784.0);
+      }
+    }
+    break;
+  case AGS_SOUNDCARD_FLOAT:
+    {
+      memcpy(destination, source, count * sizeof(gfloat));
+    }
+    break;
+  case AGS_SOUNDCARD_DOUBLE:
+    {
+      gdouble *buffer;
+
+      buffer = (gdouble *) destination;
+      
+      for(i = 0; i < count; i++){
+	buffer[i] = (gdouble) source[i];
+      }
+    }
+    break;
+  default:
+    g_warning("ags_soundcard_util_convert_float_to_device() - unsupported device format");
+  }
+}
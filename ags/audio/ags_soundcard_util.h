@@ -31,6 +31,10 @@ GRecMutex* ags_soundcard_util_get_obj_mutex(GObject *soundcard);
 
 void ags_soundcard_util_adjust_delay_and_attack(GObject *soundcard);
 
+void ags_soundcard_util_convert_float_to_device(void *destination, guint device_format,
+						gfloat *source,
+						guint count);
+
 G_END_DECLS
 
 #endif /*__AGS_SOUNDCARD_UTIL_H__*/
@@ -555,6 +555,8 @@ ags_synth_generator_init(AgsSynthGenerator *synth_generator)
   synth_generator->fm_lfo_depth = AGS_SYNTH_GENERATOR_DEFAULT_FM_LFO_DEPTH;
   
   synth_generator->fm_tuning = AGS_SYNTH_GENERATOR_DEFAULT_FM_TUNING;
+
+  synth_generator->fm_modulation_source = NULL;
   
   /* timestamp */
   synth_generator->timestamp = NULL;
@@ -1014,6 +1016,10 @@ ags_synth_generator_finalize(GObject *gobject)
     g_object_unref(synth_generator->timestamp);
   }
 
+  if(synth_generator->fm_modulation_source != NULL){
+    g_object_unref(synth_generator->fm_modulation_source);
+  }
+
   /* finalize */
   G_OBJECT_CLASS(ags_synth_generator_parent_class)->finalize(gobject);
 }
@@ -2073,6 +2079,8 @@ ags_synth_generator_compute(AgsSynthGenerator *synth_generator,
   gdouble fm_tuning;
   gboolean synced;
 
+  AgsModulationSource *fm_modulation_source;
+  
   GRecMutex *synth_generator_mutex;
   GRecMutex *stream_mutex;
 
@@ -2244,6 +2252,45 @@ ags_synth_generator_compute(AgsSynthGenerator *synth_generator,
   break;
   }
   
+  /* the FM LFO restarts every buffer, all notes share its control points */
+  fm_modulation_source = NULL;
+
+  if(do_fm_synth){
+    guint fm_samplerate, fm_buffer_size;
+    
+    g_rec_mutex_lock(synth_generator_mutex);
+
+    if(synth_generator->fm_modulation_source == NULL){
+      synth_generator->fm_modulation_source = ags_modulation_source_new((guint) samplerate,
+									buffer_size);
+    }
+
+    fm_modulation_source = synth_generator->fm_modulation_source;
+    g_object_ref(fm_modulation_source);
+    
+    g_rec_mutex_unlock(synth_generator_mutex);
+
+    g_object_get(fm_modulation_source,
+		 "samplerate", &fm_samplerate,
+		 "buffer-size", &fm_buffer_size,
+		 NULL);
+
+    if(fm_samplerate != (guint) samplerate ||
+       fm_buffer_size != buffer_size){
+      g_object_set(fm_modulation_source,
+		   "samplerate", (guint) samplerate,
+		   "buffer-size", buffer_size,
+		   NULL);
+    }
+    
+    ags_modulation_source_set_lfo(fm_modulation_source,
+				  fm_lfo_osc_mode,
+				  fm_lfo_freq, fm_lfo_depth,
+				  fm_tuning);
+    ags_modulation_source_compute(fm_modulation_source,
+				  0);
+  }
+  
   synced = FALSE;
   
   for(i = attack, j = 0; i < frame_count + attack && stream != NULL;){
@@ -2359,57 +2406,52 @@ ags_synth_generator_compute(AgsSynthGenerator *synth_generator,
       switch(synth_generator->oscillator){
       case AGS_SYNTH_GENERATOR_OSCILLATOR_SIN:
       {
-	ags_fm_synth_util_sin(stream->data,
-			      current_frequency, current_phase, volume,
-			      samplerate, audio_buffer_util_format,
-			      current_attack, current_count,
-			      fm_lfo_osc_mode,
-			      fm_lfo_freq, fm_lfo_depth,
-			      fm_tuning);
+	ags_fm_synth_util_modulate(stream->data,
+				   AGS_SYNTH_OSCILLATOR_SIN,
+				   current_frequency, current_phase, volume,
+				   samplerate, audio_buffer_util_format,
+				   current_attack, current_count,
+				   fm_modulation_source);
       }
       break;
       case AGS_SYNTH_GENERATOR_OSCILLATOR_SAWTOOTH:
       {
-	ags_fm_synth_util_sawtooth(stream->data,
+	ags_fm_synth_util_modulate(stream->data,
+				   AGS_SYNTH_OSCILLATOR_SAWTOOTH,
 				   current_frequency, current_phase, volume,
 				   samplerate, audio_buffer_util_format,
 				   current_attack, current_count,
-				   fm_lfo_osc_mode,
-				   fm_lfo_freq, fm_lfo_depth,
-				   fm_tuning);
+				   fm_modulation_source);
       }
       break;
       case AGS_SYNTH_GENERATOR_OSCILLATOR_TRIANGLE:
       {
-	ags_fm_synth_util_triangle(stream->data,
+	ags_fm_synth_util_modulate(stream->data,
+				   AGS_SYNTH_OSCILLATOR_TRIANGLE,
 				   current_frequency, current_phase, volume,
 				   samplerate, audio_buffer_util_format,
 				   current_attack, current_count,
-				   fm_lfo_osc_mode,
-				   fm_lfo_freq, fm_lfo_depth,
-				   fm_tuning);
+				   fm_modulation_source);
       }
       break;
       case AGS_SYNTH_GENERATOR_OSCILLATOR_SQUARE:
       {
-	ags_fm_synth_util_square(stream->data,
-				 current_frequency, current_phase, volume,
-				 samplerate, audio_buffer_util_format,
-				 current_attack, current_count,
-				 fm_lfo_osc_mode,
-				 fm_lfo_freq, fm_lfo_depth,
-				 fm_tuning);
+	ags_fm_synth_util_modulate(stream->data,
+				   AGS_SYNTH_OSCILLATOR_SQUARE,
+				   current_frequency, current_phase, volume,
+				   samplerate, audio_buffer_util_format,
+				   current_attack, current_count,
+				   fm_modulation_source);
       }
       break;
       case AGS_SYNTH_GENERATOR_OSCILLATOR_IMPULSE:
       {
-	ags_fm_synth_util_impulse(stream->data,
-				  current_frequency, current_phase, volume,
-				  samplerate, audio_buffer_util_format,
-				  current_attack, current_count,
-				  fm_lfo_osc_mode,
-				  fm_lfo_freq, fm_lfo_depth,
-				  fm_tuning);
+	ags_fm_synth_util_modulate(stream->data,
+				   AGS_SYNTH_OSCILLATOR_IMPULSE,
+				   current_frequency, current_phase, volume,
+				   samplerate, audio_buffer_util_format,
+				   current_attack, current_count,
+				   fm_modulation_source);
       }
       break;
       default:
@@ -2488,7 +2530,11 @@ ags_synth_generator_compute(AgsSynthGenerator *synth_generator,
        i % buffer_size == 0){
       stream = stream->next;
     }
-  }  
+  }
+
+  if(fm_modulation_source != NULL){
+    g_object_unref(fm_modulation_source);
+  }
 }
 
 /**
@@ -25,6 +25,8 @@
 
 #include <ags/libags.h>
 
+#include <ags/audio/ags_modulation_source.h>
+
 G_BEGIN_DECLS
 
 #define AGS_TYPE_SYNTH_GENERATOR                (ags_synth_generator_get_type())
@@ -117,6 +119,8 @@ struct _AgsSynthGenerator
   gdouble fm_lfo_depth;
 
   gdouble fm_tuning;
+
+  AgsModulationSource *fm_modulation_source;
   
   AgsComplex *damping;
   AgsComplex *vibration;
@@ -19,11 +19,15 @@
 
 #include <ags/audio/ags_synth_util.h>
 
+#include <ags/audio/ags_synth_enums.h>
 #include <ags/audio/ags_audio_buffer_util.h>
 #include <ags/audio/ags_fourier_transform_util.h>
 
 #include <math.h>
 #include <complex.h>
+#include <string.h>
+
+gdouble ags_synth_util_sin_table[AGS_SYNTH_UTIL_SIN_TABLE_SIZE + 1];
 
 /**
  * ags_synth_util_get_xcross_count_s8:
@@ -474,6 +478,696 @@ ags_synth_util_get_xcross_count(void *buffer,
   return(count);
 }
 
+/**
+ * ags_synth_util_sin_table_init:
+ *
+ * Fill the shared sine table used by the oscillators, once per process.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_synth_util_sin_table_init()
+{
+  static gsize sin_table_initialized = 0;
+
+  if(g_once_init_enter(&sin_table_initialized)){
+    guint i;
+
+    for(i = 0; i <= AGS_SYNTH_UTIL_SIN_TABLE_SIZE; i++){
+      ags_synth_util_sin_table[i] = sin(2.0 * M_PI * (gdouble) i / (gdouble) AGS_SYNTH_UTIL_SIN_TABLE_SIZE);
+    }
+
+    g_once_init_leave(&sin_table_initialized, 1);
+  }
+}
+
+/**
+ * ags_synth_util_sin_lookup:
+ * @t: the phase in cycles, from 0.0 to 1.0
+ *
+ * Read sinus of @t from the shared table with linear interpolation. Call
+ * ags_synth_util_sin_table_init() before.
+ *
+ * Returns: the sinus of 2 pi @t
+ *
+ * Since: 3.7.0
+ */
+gdouble
+ags_synth_util_sin_lookup(gdouble t)
+{
+  gdouble x;
+  guint j;
+
+  /* t is in [0.0, 1.0], the guard point holds sin(2 pi) */
+  x = t * (gdouble) AGS_SYNTH_UTIL_SIN_TABLE_SIZE;
+  j = (guint) x;
+
+  if(j >= AGS_SYNTH_UTIL_SIN_TABLE_SIZE){
+    return(0.0);
+  }
+  
+  return(ags_synth_util_sin_table[j] + (x - (gdouble) j) * (ags_synth_util_sin_table[j + 1] - ags_synth_util_sin_table[j]));
+}
+
+/**
+ * ags_synth_util_poly_blep:
+ * @t: the phase in cycles, from 0.0 to 1.0
+ * @dt: the phase increment per frame
+ *
+ * Poly BLEP residual of a step of height 2.0 at phase 0.0.
+ *
+ * Returns: the correction to add
+ *
+ * Since: 3.7.0
+ */
+gdouble
+ags_synth_util_poly_blep(gdouble t, gdouble dt)
+{
+  /* 2nd order polynomial residual of a unit step at t = 0 */
+  if(t < dt){
+    t /= dt;
+
+    return(t + t - t * t - 1.0);
+  }else if(t > 1.0 - dt){
+    t = (t - 1.0) / dt;
+
+    return(t * t + t + t + 1.0);
+  }
+
+  return(0.0);
+}
+
+/**
+ * ags_synth_util_poly_blamp:
+ * @t: the phase in cycles, from 0.0 to 1.0
+ * @dt: the phase increment per frame
+ *
+ * Poly BLAMP residual of a slope change at phase 0.0.
+ *
+ * Returns: the correction to add, scaled by the slope change and @dt
+ *
+ * Since: 3.7.0
+ */
+gdouble
+ags_synth_util_poly_blamp(gdouble t, gdouble dt)
+{
+  /* integrated poly BLEP, residual of a unit slope change at t = 0 */
+  if(t < dt){
+    t = t / dt - 1.0;
+
+    return(-1.0 / 3.0 * t * t * t);
+  }else if(t > 1.0 - dt){
+    t = (t - 1.0) / dt + 1.0;
+
+    return(1.0 / 3.0 * t * t * t);
+  }
+
+  return(0.0);
+}
+
+/**
+ * ags_synth_util_oscillate_double:
+ * @buffer: the audio buffer
+ * @oscillator_mode: the #AgsSynthOscillatorMode
+ * @freq: the frequency of the wave
+ * @phase: the phase of the wave in frames
+ * @volume: the volume of the wave
+ * @samplerate: the samplerate
+ * @offset: start frame
+ * @n_frames: generate n frames
+ *
+ * Add @n_frames of a band-limited wave to @buffer. The phase is kept
+ * by an accumulator, sinus is read from a shared interpolated table and
+ * the discontinuities of sawtooth, square and impulse are smoothed with
+ * poly BLEP, the corners of triangle with poly BLAMP.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_synth_util_oscillate_double(gdouble *buffer,
+				guint oscillator_mode,
+				gdouble freq, gdouble phase, gdouble volume,
+				guint samplerate,
+				guint offset, guint n_frames)
+{
+  gdouble t[AGS_SYNTH_UTIL_CHUNK_SIZE];
+
+  gdouble t0, dt, blep_dt;
+  guint count;
+  guint i, j;
+  
+  if(buffer == NULL ||
+     samplerate == 0){
+    return;
+  }
+
+  if(oscillator_mode >= AGS_SYNTH_OSCILLATOR_LAST){
+    g_warning("ags_synth_util_oscillate_double() - unknown oscillator mode");
+
+    return;
+  }
+
+  ags_synth_util_sin_table_init();
+  
+  /* cycles per frame */
+  dt = freq / (gdouble) samplerate;
+
+  blep_dt = fabs(dt);
+
+  if(blep_dt > 0.5){
+    blep_dt = 0.5;
+  }
+  
+  for(i = 0; i < n_frames; i += count){
+    count = n_frames - i;
+
+    if(count > AGS_SYNTH_UTIL_CHUNK_SIZE){
+      count = AGS_SYNTH_UTIL_CHUNK_SIZE;
+    }
+
+    /* phase accumulator - computed from the frame index so it doesn't drift */
+    t0 = ((gdouble) (offset + i) + phase) * dt;
+    t0 -= floor(t0);
+
+    for(j = 0; j < count; j++){
+      t[j] = t0 + (gdouble) j * dt;
+      t[j] -= floor(t[j]);
+    }
+
+    switch(oscillator_mode){
+    case AGS_SYNTH_OSCILLATOR_SIN:
+    {
+      for(j = 0; j < count; j++){
+	buffer[offset + i + j] += ags_synth_util_sin_lookup(t[j]) * volume;
+      }
+    }
+    break;
+    case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
+    {
+      for(j = 0; j < count; j++){
+	buffer[offset + i + j] += (2.0 * t[j] - 1.0 - ags_synth_util_poly_blep(t[j], blep_dt)) * volume;
+      }
+    }
+    break;
+    case AGS_SYNTH_OSCILLATOR_TRIANGLE:
+    {
+      gdouble u;
+      
+      for(j = 0; j < count; j++){
+	u = t[j] + 0.5;
+	u -= floor(u);
+	
+	buffer[offset + i + j] += (1.0 - 4.0 * fabs(t[j] - 0.5) + 4.0 * blep_dt * (ags_synth_util_poly_blamp(t[j], blep_dt) - ags_synth_util_poly_blamp(u, blep_dt))) * volume;
+      }
+    }
+    break;
+    case AGS_SYNTH_OSCILLATOR_SQUARE:
+    {
+      gdouble u;
+      
+      for(j = 0; j < count; j++){
+	u = t[j] + 0.5;
+	u -= floor(u);
+
+	buffer[offset + i + j] += (((t[j] < 0.5) ? 1.0: -1.0) + ags_synth_util_poly_blep(t[j], blep_dt) - ags_synth_util_poly_blep(u, blep_dt)) * volume;
+      }
+    }
+    break;
+    case AGS_SYNTH_OSCILLATOR_IMPULSE:
+    {
+      gdouble u, v;
+
+      /* high except in [0.6, 0.9) - where sin(2 pi t) drops below sin(2 pi 3/5) */
+      for(j = 0; j < count; j++){
+	u = t[j] + 0.4;
+	u -= floor(u);
+
+	v = t[j] + 0.1;
+	v -= floor(v);
+
+	buffer[offset + i + j] += (((t[j] < 0.6 || t[j] >= 0.9) ? 1.0: -1.0) - ags_synth_util_poly_blep(u, blep_dt) + ags_synth_util_poly_blep(v, blep_dt)) * volume;
+      }
+    }
+    break;
+    }
+  }
+}
+
+/**
+ * ags_synth_util_oscillate_s8:
+ * @buffer: the audio buffer
+ * @oscillator_mode: the #AgsSynthOscillatorMode
+ * @freq: the frequency of the wave
+ * @phase: the phase of the wave
+ * @volume: the volume of the wave
+ * @samplerate: the samplerate
+ * @offset: start frame
+ * @n_frames: generate n frames
+ *
+ * Add band-limited wave to @buffer.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_synth_util_oscillate_s8(gint8 *buffer,
+			    guint oscillator_mode,
+			    gdouble freq, gdouble phase, gdouble volume,
+			    guint samplerate,
+			    guint offset, guint n_frames)
+{
+  static const gdouble scale = 127.0;
+
+  gdouble y[AGS_SYNTH_UTIL_CHUNK_SIZE];
+
+  guint count;
+  guint i, j;
+
+  for(i = offset; i < offset + n_frames; i += count){
+    count = offset + n_frames - i;
+
+    if(count > AGS_SYNTH_UTIL_CHUNK_SIZE){
+      count = AGS_SYNTH_UTIL_CHUNK_SIZE;
+    }
+
+    memset(y, 0, count * sizeof(gdouble));
+    
+    ags_synth_util_oscillate_double(y,
+				    oscillator_mode,
+				    freq, phase + (gdouble) i, volume * scale,
+				    samplerate,
+				    0, count);
+
+    for(j = 0; j < count; j++){
+      buffer[i + j] = (gint8) (0xff & ((gint16) buffer[i + j] + (gint16) y[j]));
+    }
+  }
+}
+
+/**
+ * ags_synth_util_oscillate_s16:
+ * @buffer: the audio buffer
+ * @oscillator_mode: the #AgsSynthOscillatorMode
+ * @freq: the frequency of the wave
+ * @phase: the phase of the wave
+ * @volume: the volume of the wave
+ * @samplerate: the samplerate
+ * @offset: start frame
+ * @n_frames: generate n frames
+ *
+ * Add band-limited wave to @buffer.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_synth_util_oscillate_s16(gint16 *buffer,
+			     guint oscillator_mode,
+			     gdouble freq, gdouble phase, gdouble volume,
+			     guint samplerate,
+			     guint offset, guint n_frames)
+{
+  static const gdouble scale = 32767.0;
+
+  gdouble y[AGS_SYNTH_UTIL_CHUNK_SIZE];
+
+  guint count;
+  guint i, j;
+
+  for(i = offset; i < offset + n_frames; i += count){
+    count = offset + n_frames - i;
+
+    if(count > AGS_SYNTH_UTIL_CHUNK_SIZE){
+      count = AGS_SYNTH_UTIL_CHUNK_SIZE;
+    }
+
+    memset(y, 0, count * sizeof(gdouble));
+    
+    ags_synth_util_oscillate_double(y,
+				    oscillator_mode,
+				    freq, phase + (gdouble) i, volume * scale,
+				    samplerate,
+				    0, count);
+
+    for(j = 0; j < count; j++){
+      buffer[i + j] = (gint16) (0xffff & ((gint32) buffer[i + j] + (gint32) y[j]));
+    }
+  }
+}
+
+/**
+ * ags_synth_util_oscillate_s24:
+ * @buffer: the audio buffer
+ * @oscillator_mode: the #AgsSynthOscillatorMode
+ * @freq: the frequency of the wave
+ * @phase: the phase of the wave
+ * @volume: the volume of the wave
+ * @samplerate: the samplerate
+ * @offset: start frame
+ * @n_frames: generate n frames
+ *
+ * Add band-limited wave to @buffer.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_synth_util_oscillate_s24(gint32 *buffer,
+			     guint oscillator_mode,
+			     gdouble freq, gdouble phase, gdouble volume,
+			     guint samplerate,
+			     guint offset, guint n_frames)
+{
+  static const gdouble scale = 8388607.0;
+
+  gdouble y[AGS_SYNTH_UTIL_CHUNK_SIZE];
+
+  guint count;
+  guint i, j;
+
+  for(i = offset; i < offset + n_frames; i += count){
+    count = offset + n_frames - i;
+
+    if(count > AGS_SYNTH_UTIL_CHUNK_SIZE){
+      count = AGS_SYNTH_UTIL_CHUNK_SIZE;
+    }
+
+    memset(y, 0, count * sizeof(gdouble));
+    
+    ags_synth_util_oscillate_double(y,
+				    oscillator_mode,
+				    freq, phase + (gdouble) i, volume * scale,
+				    samplerate,
+				    0, count);
+
+    for(j = 0; j < count; j++){
+      buffer[i + j] = (gint32) (0xffffffff & ((gint32) buffer[i + j] + (gint32) y[j]));
+    }
+  }
+}
+
+/**
+ * ags_synth_util_oscillate_s32:
+ * @buffer: the audio buffer
+ * @oscillator_mode: the #AgsSynthOscillatorMode
+ * @freq: the frequency of the wave
+ * @phase: the phase of the wave
+ * @volume: the volume of the wave
+ * @samplerate: the samplerate
+ * @offset: start frame
+ * @n_frames: generate n frames
+ *
+ * Add band-limited wave to @buffer.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_synth_util_oscillate_s32(gint32 *buffer,
+			     guint oscillator_mode,
+			     gdouble freq, gdouble phase, gdouble volume,
+			     guint samplerate,
+			     guint offset, guint n_frames)
+{
+  static const gdouble scale = 214748363.0;
+
+  gdouble y[AGS_SYNTH_UTIL_CHUNK_SIZE];
+
+  guint count;
+  guint i, j;
+
+  for(i = offset; i < offset + n_frames; i += count){
+    count = offset + n_frames - i;
+
+    if(count > AGS_SYNTH_UTIL_CHUNK_SIZE){
+      count = AGS_SYNTH_UTIL_CHUNK_SIZE;
+    }
+
+    memset(y, 0, count * sizeof(gdouble));
+    
+    ags_synth_util_oscillate_double(y,
+				    oscillator_mode,
+				    freq, phase + (gdouble) i, volume * scale,
+				    samplerate,
+				    0, count);
+
+    for(j = 0; j < count; j++){
+      buffer[i + j] = (gint32) (0xffffffff & ((gint64) buffer[i + j] + (gint64) y[j]));
+    }
+  }
+}
+
+/**
+ * ags_synth_util_oscillate_s64:
+ * @buffer: the audio buffer
+ * @oscillator_mode: the #AgsSynthOscillatorMode
+ * @freq: the frequency of the wave
+ * @phase: the phase of the wave
+ * @volume: the volume of the wave
+ * @samplerate: the samplerate
+ * @offset: start frame
+ * @n_frames: generate n frames
+ *
+ * Add band-limited wave to @buffer.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_synth_util_oscillate_s64(gint64 *buffer,
+			     guint oscillator_mode,
+			     gdouble freq, gdouble phase, gdouble volume,
+			     guint samplerate,
+			     guint offset, guint n_frames)
+{
+  static const gdouble scale = 9223372036854775807.0;
+
+  gdouble y[AGS_SYNTH_UTIL_CHUNK_SIZE];
+
+  guint count;
+  guint i, j;
+
+  for(i = offset; i < offset + n_frames; i += count){
+    count = offset + n_frames - i;
+
+    if(count > AGS_SYNTH_UTIL_CHUNK_SIZE){
+      count = AGS_SYNTH_UTIL_CHUNK_SIZE;
+    }
+
+    memset(y, 0, count * sizeof(gdouble));
+    
+    ags_synth_util_oscillate_double(y,
+				    oscillator_mode,
+				    freq, phase + (gdouble) i, volume * scale,
+				    samplerate,
+				    0, count);
+
+    for(j = 0; j < count; j++){
+      buffer[i + j] = (gint64) (0xffffffffffff & ((gint64) buffer[i + j] + (gint64) y[j]));
+    }
+  }
+}
+
+/**
+ * ags_synth_util_oscillate_float:
+ * @buffer: the audio buffer
+ * @oscillator_mode: the #AgsSynthOscillatorMode
+ * @freq: the frequency of the wave
+ * @phase: the phase of the wave
+ * @volume: the volume of the wave
+ * @samplerate: the samplerate
+ * @offset: start frame
+ * @n_frames: generate n frames
+ *
+ * Add band-limited wave to @buffer.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_synth_util_oscillate_float(float *buffer,
+			       guint oscillator_mode,
+			       gdouble freq, gdouble phase, gdouble volume,
+			       guint samplerate,
+			       guint offset, guint n_frames)
+{
+  gdouble y[AGS_SYNTH_UTIL_CHUNK_SIZE];
+
+  guint count;
+  guint i, j;
+
+  for(i = offset; i < offset + n_frames; i += count){
+    count = offset + n_frames - i;
+
+    if(count > AGS_SYNTH_UTIL_CHUNK_SIZE){
+      count = AGS_SYNTH_UTIL_CHUNK_SIZE;
+    }
+
+    memset(y, 0, count * sizeof(gdouble));
+    
+    ags_synth_util_oscillate_double(y,
+				    oscillator_mode,
+				    freq, phase + (gdouble) i, volume,
+				    samplerate,
+				    0, count);
+
+    for(j = 0; j < count; j++){
+      buffer[i + j] = (float) ((gdouble) buffer[i + j] + y[j]);
+    }
+  }
+}
+
+/**
+ * ags_synth_util_oscillate_complex:
+ * @buffer: the audio buffer
+ * @oscillator_mode: the #AgsSynthOscillatorMode
+ * @freq: the frequency of the wave
+ * @phase: the phase of the wave
+ * @volume: the volume of the wave
+ * @samplerate: the samplerate
+ * @offset: start frame
+ * @n_frames: generate n frames
+ *
+ * Set @buffer to band-limited wave.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_synth_util_oscillate_complex(AgsComplex *buffer,
+				 guint oscillator_mode,
+				 gdouble freq, gdouble phase, gdouble volume,
+				 guint samplerate,
+				 guint offset, guint n_frames)
+{
+  AgsComplex *c_ptr;
+  AgsComplex **c_ptr_ptr;
+
+  gdouble y[AGS_SYNTH_UTIL_CHUNK_SIZE];
+
+  guint count;
+  guint i, j;
+
+  c_ptr = buffer;
+  c_ptr_ptr = &c_ptr;
+
+  for(i = offset; i < offset + n_frames; i += count){
+    count = offset + n_frames - i;
+
+    if(count > AGS_SYNTH_UTIL_CHUNK_SIZE){
+      count = AGS_SYNTH_UTIL_CHUNK_SIZE;
+    }
+
+    memset(y, 0, count * sizeof(gdouble));
+    
+    ags_synth_util_oscillate_double(y,
+				    oscillator_mode,
+				    freq, phase + (gdouble) i, volume,
+				    samplerate,
+				    0, count);
+
+    for(j = 0; j < count; j++, c_ptr++){
+      AGS_AUDIO_BUFFER_UTIL_DOUBLE_TO_COMPLEX(y[j], c_ptr_ptr);
+    }
+  }
+}
+
+/**
+ * ags_synth_util_oscillate:
+ * @buffer: the audio buffer
+ * @oscillator_mode: the #AgsSynthOscillatorMode
+ * @freq: the frequency of the wave
+ * @phase: the phase of the wave
+ * @volume: the volume of the wave
+ * @samplerate: the samplerate
+ * @audio_buffer_util_format: the audio data format
+ * @offset: start frame
+ * @n_frames: generate n frames
+ *
+ * Generate band-limited wave of @oscillator_mode.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_synth_util_oscillate(void *buffer,
+			 guint oscillator_mode,
+			 gdouble freq, gdouble phase, gdouble volume,
+			 guint samplerate, guint audio_buffer_util_format,
+			 guint offset, guint n_frames)
+{
+  switch(audio_buffer_util_format){
+  case AGS_AUDIO_BUFFER_UTIL_S8:
+  {
+    ags_synth_util_oscillate_s8((gint8 *) buffer,
+				oscillator_mode,
+				freq, phase, volume,
+				samplerate,
+				offset, n_frames);
+  }
+  break;
+  case AGS_AUDIO_BUFFER_UTIL_S16:
+  {
+    ags_synth_util_oscillate_s16((gint16 *) buffer,
+				 oscillator_mode,
+				 freq, phase, volume,
+				 samplerate,
+				 offset, n_frames);
+  }
+  break;
+  case AGS_AUDIO_BUFFER_UTIL_S24:
+  {
+    ags_synth_util_oscillate_s24((gint32 *) buffer,
+				 oscillator_mode,
+				 freq, phase, volume,
+				 samplerate,
+				 offset, n_frames);
+  }
+  break;
+  case AGS_AUDIO_BUFFER_UTIL_S32:
+  {
+    ags_synth_util_oscillate_s32((gint32 *) buffer,
+				 oscillator_mode,
+				 freq, phase, volume,
+				 samplerate,
+				 offset, n_frames);
+  }
+  break;
+  case AGS_AUDIO_BUFFER_UTIL_S64:
+  {
+    ags_synth_util_oscillate_s64((gint64 *) buffer,
+				 oscillator_mode,
+				 freq, phase, volume,
+				 samplerate,
+				 offset, n_frames);
+  }
+  break;
+  case AGS_AUDIO_BUFFER_UTIL_FLOAT:
+  {
+    ags_synth_util_oscillate_float((float *) buffer,
+				   oscillator_mode,
+				   freq, phase, volume,
+				   samplerate,
+				   offset, n_frames);
+  }
+  break;
+  case AGS_AUDIO_BUFFER_UTIL_DOUBLE:
+  {
+    ags_synth_util_oscillate_double((double *) buffer,
+				    oscillator_mode,
+				    freq, phase, volume,
+				    samplerate,
+				    offset, n_frames);
+  }
+  break;
+  case AGS_AUDIO_BUFFER_UTIL_COMPLEX:
+  {
+    ags_synth_util_oscillate_complex((AgsComplex *) buffer,
+				     oscillator_mode,
+				     freq, phase, volume,
+				     samplerate,
+				     offset, n_frames);
+  }
+  break;
+  default:
+  {
+    g_warning("ags_synth_util_oscillate() - unsupported format");
+  }
+  }
+}
+
 /**
  * ags_synth_util_sin_s8:
  * @buffer: the audio buffer
@@ -494,12 +1188,11 @@ ags_synth_util_sin_s8(gint8 *buffer,
 		      guint samplerate,
 		      guint offset, guint n_frames)
 {
-  static const gdouble scale = 127.0;
-  guint i;
-
-  for(i = offset; i < offset + n_frames; i++){
-    buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) (sin((gdouble) (i + phase) * 2.0 * M_PI * freq / (gdouble) samplerate) * scale * volume)));
-  }
+  ags_synth_util_oscillate_s8(buffer,
+			      AGS_SYNTH_OSCILLATOR_SIN,
+			      freq, phase, volume,
+			      samplerate,
+			      offset, n_frames);
 }
 
 /**
@@ -522,12 +1215,11 @@ ags_synth_util_sin_s16(gint16 *buffer,
 		       guint samplerate,
 		       guint offset, guint n_frames)
 {
-  static const gdouble scale = 32767.0;
-  guint i;
-
-  for(i = offset; i < offset + n_frames; i++){
-    buffer[i] = (gint16) (0xffff & ((gint32) buffer[i] + (gint32) (sin((gdouble) (i + phase) * 2.0 * M_PI * freq / (gdouble) samplerate) * scale * volume)));
-  }
+  ags_synth_util_oscillate_s16(buffer,
+			       AGS_SYNTH_OSCILLATOR_SIN,
+			       freq, phase, volume,
+			       samplerate,
+			       offset, n_frames);
 }
 
 /**
@@ -550,12 +1242,11 @@ ags_synth_util_sin_s24(gint32 *buffer,
 		       guint samplerate,
 		       guint offset, guint n_frames)
 {
-  static const gdouble scale = 8388607.0;
-  guint i;
-
-  for(i = offset; i < offset + n_frames; i++){
-    buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) (sin((gdouble) (i + phase) * 2.0 * M_PI * freq / (gdouble) samplerate) * scale * volume)));
-  }
+  ags_synth_util_oscillate_s24(buffer,
+			       AGS_SYNTH_OSCILLATOR_SIN,
+			       freq, phase, volume,
+			       samplerate,
+			       offset, n_frames);
 }
 
 /**
@@ -578,12 +1269,11 @@ ags_synth_util_sin_s32(gint32 *buffer,
 		       guint samplerate,
 		       guint offset, guint n_frames)
 {
-  static const gdouble scale = 214748363.0;
-  guint i;
-
-  for(i = offset; i < offset + n_frames; i++){
-    buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) (sin((gdouble) (i + phase) * 2.0 * M_PI * freq / (gdouble) samplerate) * scale * volume)));
-  }
+  ags_synth_util_oscillate_s32(buffer,
+			       AGS_SYNTH_OSCILLATOR_SIN,
+			       freq, phase, volume,
+			       samplerate,
+			       offset, n_frames);
 }
 
 /**
@@ -606,12 +1296,11 @@ ags_synth_util_sin_s64(gint64 *buffer,
 		       guint samplerate,
 		       guint offset, guint n_frames)
 {
-  static const gdouble scale = 9223372036854775807.0;
-  guint i;
-
-  for(i = offset; i < offset + n_frames; i++){
-    buffer[i] = (gint64) (0xffffffffffff & ((gint64) buffer[i] + (gint64) (sin((gdouble) (i + phase) * 2.0 * M_PI * freq / (gdouble) samplerate) * scale * volume)));
-  }
+  ags_synth_util_oscillate_s64(buffer,
+			       AGS_SYNTH_OSCILLATOR_SIN,
+			       freq, phase, volume,
+			       samplerate,
+			       offset, n_frames);
 }
 
 /**
@@ -634,11 +1323,11 @@ ags_synth_util_sin_float(float *buffer,
 			 guint samplerate,
 			 guint offset, guint n_frames)
 {
-  guint i;
-
-  for(i = offset; i < offset + n_frames; i++){
-    buffer[i] = (float) ((gdouble) buffer[i] + (gdouble) (sin((gdouble) (i + phase) * 2.0 * M_PI * freq / (gdouble) samplerate) * volume));
-  }
+  ags_synth_util_oscillate_float(buffer,
+				 AGS_SYNTH_OSCILLATOR_SIN,
+				 freq, phase, volume,
+				 samplerate,
+				 offset, n_frames);
 }
 
 /**
@@ -661,11 +1350,11 @@ ags_synth_util_sin_double(double *buffer,
 			  guint samplerate,
 			  guint offset, guint n_frames)
 {
-  guint i;
-
-  for(i = offset; i < offset + n_frames; i++){
-    buffer[i] = (double) ((gdouble) buffer[i] + (gdouble) (sin((gdouble) (i + phase) * 2.0 * M_PI * freq / (gdouble) samplerate) * volume));
-  }
+  ags_synth_util_oscillate_double(buffer,
+				  AGS_SYNTH_OSCILLATOR_SIN,
+				  freq, phase, volume,
+				  samplerate,
+				  offset, n_frames);
 }
 
 /**
@@ -688,24 +1377,11 @@ ags_synth_util_sin_complex(AgsComplex *buffer,
 			   guint samplerate,
 			   guint offset, guint n_frames)
 {
-  AgsComplex *c_ptr;
-  AgsComplex **c_ptr_ptr;
-
-  double y;
-
-  guint i_stop;
-  guint i;
-
-  c_ptr = buffer;
-  c_ptr_ptr = &c_ptr;
-  
-  i_stop = offset + n_frames;
-  
-  for(i = offset; i < i_stop; i++, c_ptr++){
-    y = (gdouble) (sin((gdouble) (i + phase) * 2.0 * M_PI * freq / (gdouble) samplerate) * volume);
-
-    AGS_AUDIO_BUFFER_UTIL_DOUBLE_TO_COMPLEX(y, c_ptr_ptr);
-  }
+  ags_synth_util_oscillate_complex(buffer,
+				   AGS_SYNTH_OSCILLATOR_SIN,
+				   freq, phase, volume,
+				   samplerate,
+				   offset, n_frames);
 }
 
 /**
@@ -718,7 +1394,7 @@ ags_synth_util_sin_complex(AgsComplex *buffer,
  * @offset: start frame
  * @n_frames: generate n frames
  *
- * Generate sawtooth wave.
+ * Generate band-limited sawtooth wave.
  *
  * Since: 3.0.0
  */
@@ -728,15 +1404,11 @@ ags_synth_util_sawtooth_s8(gint8 *buffer,
 			   guint samplerate,
 			   guint offset, guint n_frames)
 {
-  static const gdouble scale = 127.0;
-  guint i;
-
-  phase = (int) ceil(phase) % (int) ceil(freq);
-  phase = ceil(phase / freq) * ceil(samplerate / freq);
-
-  for(i = offset; i < offset + n_frames; i++){
-    buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * freq / samplerate) - 1.0) * scale * volume)));
-  }
+  ags_synth_util_oscillate_s8(buffer,
+			      AGS_SYNTH_OSCILLATOR_SAWTOOTH,
+			      freq, phase, volume,
+			      samplerate,
+			      offset, n_frames);
 }
 
 /**
@@ -749,7 +1421,7 @@ ags_synth_util_sawtooth_s8(gint8 *buffer,
  * @offset: start frame
  * @n_frames: generate n frames
  *
- * Generate sawtooth wave.
+ * Generate band-limited sawtooth wave.
  *
  * Since: 3.0.0
  */
@@ -759,15 +1431,11 @@ ags_synth_util_sawtooth_s16(gint16 *buffer,
 			    guint samplerate,
 			    guint offset, guint n_frames)
 {
-  static const gdouble scale = 32767.0;
-  guint i;
-
-  phase = (int) ceil(phase) % (int) ceil(freq);
-  phase = ceil(phase / freq) * ceil(samplerate / freq);
-
-  for(i = offset; i < offset + n_frames; i++){
-    buffer[i] = (gint16) (0xffff & ((gint32) buffer[i] + (gint32) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * freq / samplerate) - 1.0) * scale * volume)));
-  }
+  ags_synth_util_oscillate_s16(buffer,
+			       AGS_SYNTH_OSCILLATOR_SAWTOOTH,
+			       freq, phase, volume,
+			       samplerate,
+			       offset, n_frames);
 }
 
 /**
@@ -780,7 +1448,7 @@ ags_synth_util_sawtooth_s16(gint16 *buffer,
  * @offset: start frame
  * @n_frames: generate n frames
  *
- * Generate sawtooth wave.
+ * Generate band-limited sawtooth wave.
  *
  * Since: 3.0.0
  */
@@ -790,15 +1458,11 @@ ags_synth_util_sawtooth_s24(gint32 *buffer,
 			    guint samplerate,
 			    guint offset, guint n_frames)
 {
-  static const gdouble scale = 8388607.0;
-  guint i;
-
-  phase = (int) ceil(phase) % (int) ceil(freq);
-  phase = ceil(phase / freq) * ceil(samplerate / freq);
-
-  for(i = offset; i < offset + n_frames; i++){
-    buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * freq / samplerate) - 1.0) * scale * volume)));
-  }
+  ags_synth_util_oscillate_s24(buffer,
+			       AGS_SYNTH_OSCILLATOR_SAWTOOTH,
+			       freq, phase, volume,
+			       samplerate,
+			       offset, n_frames);
 }
 
 /**
@@ -811,7 +1475,7 @@ ags_synth_util_sawtooth_s24(gint32 *buffer,
  * @offset: start frame
  * @n_frames: generate n frames
  *
- * Generate sawtooth wave.
+ * Generate band-limited sawtooth wave.
  *
  * Since: 3.0.0
  */
@@ -821,15 +1485,11 @@ ags_synth_util_sawtooth_s32(gint32 *buffer,
 			    guint samplerate,
 			    guint offset, guint n_frames)
 {
-  static const gdouble scale = 214748363.0;
-  guint i;
-
-  phase = (int) ceil(phase) % (int) ceil(freq);
-  phase = ceil(phase / freq) * ceil(samplerate / freq);
-
-  for(i = offset; i < offset + n_frames; i++){
-    buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * freq / samplerate) - 1.0) * scale * volume)));
-  }
+  ags_synth_util_oscillate_s32(buffer,
+			       AGS_SYNTH_OSCILLATOR_SAWTOOTH,
+			       freq, phase, volume,
+			       samplerate,
+			       offset, n_frames);
 }
 
 /**
@@ -842,7 +1502,7 @@ ags_synth_util_sawtooth_s32(gint32 *buffer,
  * @offset: start frame
  * @n_frames: generate n frames
  *
- * Generate sawtooth wave.
+ * Generate band-limited sawtooth wave.
  *
  * Since: 3.0.0
  */
@@ -852,15 +1512,11 @@ ags_synth_util_sawtooth_s64(gint64 *buffer,
 			    guint samplerate,
 			    guint offset, guint n_frames)
 {
-  static const gdouble scale = 9223372036854775807.0;
-  guint i;
-
-  phase = (int) ceil(phase) % (int) ceil(freq);
-  phase = ceil(phase / freq) * ceil(samplerate / freq);
-
-  for(i = offset; i < offset + n_frames; i++){
-    buffer[i] = (gint64) (0xffffffffffffffff & ((gint64) buffer[i] + (gint64) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * freq / samplerate) - 1.0) * scale * volume)));
-  }
+  ags_synth_util_oscillate_s64(buffer,
+			       AGS_SYNTH_OSCILLATOR_SAWTOOTH,
+			       freq, phase, volume,
+			       samplerate,
+			       offset, n_frames);
 }
 
 /**
@@ -873,7 +1529,7 @@ ags_synth_util_sawtooth_s64(gint64 *buffer,
  * @offset: start frame
  * @n_frames: generate n frames
  *
- * Generate sawtooth wave.
+ * Generate band-limited sawtooth wave.
  *
  * Since: 3.0.0
  */
@@ -883,14 +1539,11 @@ ags_synth_util_sawtooth_float(float *buffer,
 			      guint samplerate,
 			      guint offset, guint n_frames)
 {
-  guint i;
-
-  phase = (int) ceil(phase) % (int) ceil(freq);
-  phase = ceil(phase / freq) * ceil(samplerate / freq);
-
-  for(i = offset; i < offset + n_frames; i++){
-    buffer[i] = ((double) buffer[i] + (double) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * freq / samplerate) - 1.0) * volume));
-  }
+  ags_synth_util_oscillate_float(buffer,
+				 AGS_SYNTH_OSCILLATOR_SAWTOOTH,
+				 freq, phase, volume,
+				 samplerate,
+				 offset, n_frames);
 }
 
 /**
@@ -903,7 +1556,7 @@ ags_synth_util_sawtooth_float(float *buffer,
  * @offset: start frame
  * @n_frames: generate n frames
  *
- * Generate sawtooth wave.
+ * Generate band-limited sawtooth wave.
  *
  * Since: 3.0.0
  */
@@ -913,14 +1566,11 @@ ags_synth_util_sawtooth_double(double *buffer,
 			       guint samplerate,
 			       guint offset, guint n_frames)
 {
-  guint i;
-
-  phase = (int) ceil(phase) % (int) ceil(freq);
-  phase = ceil(phase / freq) * ceil(samplerate / freq);
-
-  for(i = offset; i < offset + n_frames; i++){
-    buffer[i] = ((double) buffer[i] + (double) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * freq / samplerate) - 1.0) * volume));
-  }
+  ags_synth_util_oscillate_double(buffer,
+				  AGS_SYNTH_OSCILLATOR_SAWTOOTH,
+				  freq, phase, volume,
+				  samplerate,
+				  offset, n_frames);
 }
 
 /**
@@ -933,7 +1583,7 @@ ags_synth_util_sawtooth_double(double *buffer,
  * @offset: start frame
  * @n_frames: generate n frames
  *
- * Generate sawtooth wave.
+ * Generate band-limited sawtooth wave.
  *
  * Since: 3.0.0
  */
@@ -943,27 +1593,11 @@ ags_synth_util_sawtooth_complex(AgsComplex *buffer,
 				guint samplerate,
 				guint offset, guint n_frames)
 {
-  AgsComplex *c_ptr;
-  AgsComplex **c_ptr_ptr;
-
-  double y;
-
-  guint i_stop;
-  guint i;
-
-  phase = (int) ceil(phase) % (int) ceil(freq);
-  phase = ceil(phase / freq) * ceil(samplerate / freq);
-
-  c_ptr = buffer;
-  c_ptr_ptr = &c_ptr;
-
-  i_stop = offset + n_frames;
-
-  for(i = offset; i < i_stop; i++, c_ptr++){
-    y = (double) (((((int) ceil(i + phase) % (int) ceil(samplerate / freq)) * 2.0 * freq / samplerate) - 1.0) * volume);
-
-    AGS_AUDIO_BUFFER_UTIL_DOUBLE_TO_COMPLEX(y, c_ptr_ptr);
-  }
+  ags_synth_util_oscillate_complex(buffer,
+				   AGS_SYNTH_OSCILLATOR_SAWTOOTH,
+				   freq, phase, volume,
+				   samplerate,
+				   offset, n_frames);
 }
 
 /**
@@ -976,7 +1610,7 @@ ags_synth_util_sawtooth_complex(AgsComplex *buffer,
  * @offset: start frame
  * @n_frames: generate n frames
  *
- * Generate triangle wave.
+ * Generate band-limited triangle wave.
  *
  * Since: 3.0.0
  */
@@ -986,15 +1620,11 @@ ags_synth_util_triangle_s8(gint8 *buffer,
 			   guint samplerate,
 			   guint offset, guint n_frames)
 {
-  static const gdouble scale = 127.0;
-  guint i;
-
-  phase = (int) ceil(phase) % (int) ceil(freq);
-  phase = ceil(phase / freq) * ceil(samplerate / freq);
-
-  for(i = offset; i < offset + n_frames; i++){
-    buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) ((((phase + i) * freq / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * freq / samplerate)) / 2.0) * 2) - 1.0) * scale * volume)));
-  }
+  ags_synth_util_oscillate_s8(buffer,
+			      AGS_SYNTH_OSCILLATOR_TRIANGLE,
+			      freq, phase, volume,
+			      samplerate,
+			      offset, n_frames);
 }
 
 /**
@@ -1007,7 +1637,7 @@ ags_synth_util_triangle_s8(gint8 *buffer,
  * @offset: start frame
  * @n_frames: generate n frames
  *
- * Generate triangle wave.
+ * Generate band-limited triangle wave.
  *
  * Since: 3.0.0
  */
@@ -1017,15 +1647,11 @@ ags_synth_util_triangle_s16(gint16 *buffer,
 			    guint samplerate,
 			    guint offset, guint n_frames)
 {
-  static const gdouble scale = 32767.0;
-  guint i;
-
-  phase = (int) ceil(phase) % (int) ceil(freq);
-  phase = ceil(phase / freq) * ceil(samplerate / freq);
-
-  for(i = offset; i < offset + n_frames; i++){
-    buffer[i] = (gint16) (0xffff & ((gint32) buffer[i] + (gint32) ((((phase + i) * freq / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * freq / samplerate)) / 2.0) * 2) - 1.0) * scale * volume)));
-  }
+  ags_synth_util_oscillate_s16(buffer,
+			       AGS_SYNTH_OSCILLATOR_TRIANGLE,
+			       freq, phase, volume,
+			       samplerate,
+			       offset, n_frames);
 }
 
 /**
@@ -1038,7 +1664,7 @@ ags_synth_util_triangle_s16(gint16 *buffer,
  * @offset: start frame
  * @n_frames: generate n frames
  *
- * Generate triangle wave.
+ * Generate band-limited triangle wave.
  *
  * Since: 3.0.0
  */
@@ -1048,15 +1674,11 @@ ags_synth_util_triangle_s24(gint32 *buffer,
 			    guint samplerate,
 			    guint offset, guint n_frames)
 {
-  static const gdouble scale = 8388607.0;
-  guint i;
-
-  phase = (int) ceil(phase) % (int) ceil(freq);
-  phase = ceil(phase / freq) * ceil(samplerate / freq);
-
-  for(i = offset; i < offset + n_frames; i++){
-    buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) ((((phase + i) * freq / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * freq / samplerate)) / 2.0) * 2) - 1.0) * scale * volume)));
-  }
+  ags_synth_util_oscillate_s24(buffer,
+			       AGS_SYNTH_OSCILLATOR_TRIANGLE,
+			       freq, phase, volume,
+			       samplerate,
+			       offset, n_frames);
 }
 
 /**
@@ -1069,7 +1691,7 @@ ags_synth_util_triangle_s24(gint32 *buffer,
  * @offset: start frame
  * @n_frames: generate n frames
  *
- * Generate triangle wave.
+ * Generate band-limited triangle wave.
  *
  * Since: 3.0.0
  */
@@ -1079,15 +1701,11 @@ ags_synth_util_triangle_s32(gint32 *buffer,
 			    guint samplerate,
 			    guint offset, guint n_frames)
 {
-  static const gdouble scale = 214748363.0;
-  guint i;
-
-  phase = (int) ceil(phase) % (int) ceil(freq);
-  phase = ceil(phase / freq) * ceil(samplerate / freq);
-
-  for(i = offset; i < offset + n_frames; i++){
-    buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) ((((phase + i) * freq / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * freq / samplerate)) / 2.0) * 2) - 1.0) * scale * volume)));
-  }
+  ags_synth_util_oscillate_s32(buffer,
+			       AGS_SYNTH_OSCILLATOR_TRIANGLE,
+			       freq, phase, volume,
+			       samplerate,
+			       offset, n_frames);
 }
 
 /**
@@ -1100,7 +1718,7 @@ ags_synth_util_triangle_s32(gint32 *buffer,
  * @offset: start frame
  * @n_frames: generate n frames
  *
- * Generate triangle wave.
+ * Generate band-limited triangle wave.
  *
  * Since: 3.0.0
  */
@@ -1110,15 +1728,11 @@ ags_synth_util_triangle_s64(gint64 *buffer,
 			    guint samplerate,
 			    guint offset, guint n_frames)
 {
-  static const gdouble scale = 9223372036854775807.0;
-  guint i;
-
-  phase = (int) ceil(phase) % (int) ceil(freq);
-  phase = ceil(phase / freq) * ceil(samplerate / freq);
-
-  for(i = offset; i < offset + n_frames; i++){
-    buffer[i] = (gint64) (0xffffffffffffffff & ((gint64) buffer[i] + (gint64) ((((phase + i) * freq / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * freq / samplerate)) / 2.0) * 2) - 1.0) * scale * volume)));
-  }
+  ags_synth_util_oscillate_s64(buffer,
+			       AGS_SYNTH_OSCILLATOR_TRIANGLE,
+			       freq, phase, volume,
+			       samplerate,
+			       offset, n_frames);
 }
 
 /**
@@ -1131,7 +1745,7 @@ ags_synth_util_triangle_s64(gint64 *buffer,
  * @offset: start frame
  * @n_frames: generate n frames
  *
- * Generate triangle wave.
+ * Generate band-limited triangle wave.
  *
  * Since: 3.0.0
  */
@@ -1141,14 +1755,11 @@ ags_synth_util_triangle_float(float *buffer,
 			      guint samplerate,
 			      guint offset, guint n_frames)
 {
-  guint i;
-
-  phase = (int) ceil(phase) % (int) ceil(freq);
-  phase = ceil(phase / freq) * ceil(samplerate / freq);
-
-  for(i = offset; i < offset + n_frames; i++){
-    buffer[i] = ((double) buffer[i] + (double) ((((phase + i) * freq / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * freq / samplerate)) / 2.0) * 2) - 1.0) * volume));
-  }
+  ags_synth_util_oscillate_float(buffer,
+				 AGS_SYNTH_OSCILLATOR_TRIANGLE,
+				 freq, phase, volume,
+				 samplerate,
+				 offset, n_frames);
 }
 
 /**
@@ -1161,7 +1772,7 @@ ags_synth_util_triangle_float(float *buffer,
  * @offset: start frame
  * @n_frames: generate n frames
  *
- * Generate triangle wave.
+ * Generate band-limited triangle wave.
  *
  * Since: 3.0.0
  */
@@ -1171,14 +1782,11 @@ ags_synth_util_triangle_double(double *buffer,
 			       guint samplerate,
 			       guint offset, guint n_frames)
 {
-  guint i;
-
-  phase = (int) ceil(phase) % (int) ceil(freq);
-  phase = ceil(phase / freq) * ceil(samplerate / freq);
-
-  for(i = offset; i < offset + n_frames; i++){
-    buffer[i] = ((double) buffer[i] + (double) ((((phase + i) * freq / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * freq / samplerate)) / 2.0) * 2) - 1.0) * volume));
-  }
+  ags_synth_util_oscillate_double(buffer,
+				  AGS_SYNTH_OSCILLATOR_TRIANGLE,
+				  freq, phase, volume,
+				  samplerate,
+				  offset, n_frames);
 }
 
 /**
@@ -1191,7 +1799,7 @@ ags_synth_util_triangle_double(double *buffer,
  * @offset: start frame
  * @n_frames: generate n frames
  *
- * Generate triangle wave.
+ * Generate band-limited triangle wave.
  *
  * Since: 3.0.0
  */
@@ -1201,27 +1809,11 @@ ags_synth_util_triangle_complex(AgsComplex *buffer,
 				guint samplerate,
 				guint offset, guint n_frames)
 {
-  AgsComplex *c_ptr;
-  AgsComplex **c_ptr_ptr;
-
-  double y;
-
-  guint i_stop;
-  guint i;
-
-  phase = (int) ceil(phase) % (int) ceil(freq);
-  phase = ceil(phase / freq) * ceil(samplerate / freq);
-
-  c_ptr = buffer;
-  c_ptr_ptr = &c_ptr;
-  
-  i_stop = offset + n_frames;
-
-  for(i = offset; i < i_stop; i++, c_ptr++){
-    y = (double) ((((phase + i) * freq / samplerate * 2.0) - ((int) ((double) ((int) ((phase + i) * freq / samplerate)) / 2.0) * 2) - 1.0) * volume);
-
-    AGS_AUDIO_BUFFER_UTIL_DOUBLE_TO_COMPLEX(y, c_ptr_ptr);
-  }
+  ags_synth_util_oscillate_complex(buffer,
+				   AGS_SYNTH_OSCILLATOR_TRIANGLE,
+				   freq, phase, volume,
+				   samplerate,
+				   offset, n_frames);
 }
 
 /**
@@ -1234,7 +1826,7 @@ ags_synth_util_triangle_complex(AgsComplex *buffer,
  * @offset: start frame
  * @n_frames: generate n frames
  *
- * Generate square wave.
+ * Generate band-limited square wave.
  *
  * Since: 3.0.0
  */
@@ -1244,16 +1836,11 @@ ags_synth_util_square_s8(gint8 *buffer,
 			 guint samplerate,
 			 guint offset, guint n_frames)
 {
-  static const gdouble scale = 127.0;
-  guint i;
-
-  for(i = offset; i < offset + n_frames; i++){
-    if(sin((gdouble) (i + phase) * 2.0 * M_PI * freq / (gdouble) samplerate) >= 0.0){
-      buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) (1.0 * scale * volume)));
-    }else{
-      buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) (-1.0 * scale * volume)));
-    }
-  }
+  ags_synth_util_oscillate_s8(buffer,
+			      AGS_SYNTH_OSCILLATOR_SQUARE,
+			      freq, phase, volume,
+			      samplerate,
+			      offset, n_frames);
 }
 
 /**
@@ -1266,7 +1853,7 @@ ags_synth_util_square_s8(gint8 *buffer,
  * @offset: start frame
  * @n_frames: generate n frames
  *
- * Generate square wave.
+ * Generate band-limited square wave.
  *
  * Since: 3.0.0
  */
@@ -1276,16 +1863,11 @@ ags_synth_util_square_s16(gint16 *buffer,
 			  guint samplerate,
 			  guint offset, guint n_frames)
 {
-  static const gdouble scale = 32767.0;
-  guint i;
-
-  for(i = offset; i < offset + n_frames; i++){
-    if(sin((gdouble) (i + phase) * 2.0 * M_PI * freq / (gdouble) samplerate) >= 0.0){
-      buffer[i] = (gint16) (0xffff & ((gint32) buffer[i] + (gint32) (1.0 * scale * volume)));
-    }else{
-      buffer[i] = (gint16) (0xffff & ((gint32) buffer[i] + (gint32) (-1.0 * scale * volume)));
-    }
-  }
+  ags_synth_util_oscillate_s16(buffer,
+			       AGS_SYNTH_OSCILLATOR_SQUARE,
+			       freq, phase, volume,
+			       samplerate,
+			       offset, n_frames);
 }
 
 /**
@@ -1298,7 +1880,7 @@ ags_synth_util_square_s16(gint16 *buffer,
  * @offset: start frame
  * @n_frames: generate n frames
  *
- * Generate square wave.
+ * Generate band-limited square wave.
  *
  * Since: 3.0.0
  */
@@ -1308,16 +1890,11 @@ ags_synth_util_square_s24(gint32 *buffer,
 			  guint samplerate,
 			  guint offset, guint n_frames)
 {
-  static const gdouble scale = 8388607.0;
-  guint i;
-
-  for(i = offset; i < offset + n_frames; i++){
-    if(sin((gdouble) (i + phase) * 2.0 * M_PI * freq / (gdouble) samplerate) >= 0.0){
-      buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) (1.0 * scale * volume)));
-    }else{
-      buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) (-1.0 * scale * volume)));
-    }
-  }
+  ags_synth_util_oscillate_s24(buffer,
+			       AGS_SYNTH_OSCILLATOR_SQUARE,
+			       freq, phase, volume,
+			       samplerate,
+			       offset, n_frames);
 }
 
 /**
@@ -1330,7 +1907,7 @@ ags_synth_util_square_s24(gint32 *buffer,
  * @offset: start frame
  * @n_frames: generate n frames
  *
- * Generate square wave.
+ * Generate band-limited square wave.
  *
  * Since: 3.0.0
  */
@@ -1340,16 +1917,11 @@ ags_synth_util_square_s32(gint32 *buffer,
 			  guint samplerate,
 			  guint offset, guint n_frames)
 {
-  static const gdouble scale = 214748363.0;
-  guint i;
-
-  for(i = offset; i < offset + n_frames; i++){
-    if(sin((gdouble) (i + phase) * 2.0 * M_PI * freq / (gdouble) samplerate) >= 0.0){
-      buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) (1.0 * scale * volume)));
-    }else{
-      buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) (-1.0 * scale * volume)));
-    }
-  }
+  ags_synth_util_oscillate_s32(buffer,
+			       AGS_SYNTH_OSCILLATOR_SQUARE,
+			       freq, phase, volume,
+			       samplerate,
+			       offset, n_frames);
 }
 
 /**
@@ -1362,7 +1934,7 @@ ags_synth_util_square_s32(gint32 *buffer,
  * @offset: start frame
  * @n_frames: generate n frames
  *
- * Generate square wave.
+ * Generate band-limited square wave.
  *
  * Since: 3.0.0
  */
@@ -1372,16 +1944,11 @@ ags_synth_util_square_s64(gint64 *buffer,
 			  guint samplerate,
 			  guint offset, guint n_frames)
 {
-  static const gdouble scale = 9223372036854775807.0;
-  guint i;
-
-  for(i = offset; i < offset + n_frames; i++){
-    if(sin((gdouble) (i + phase) * 2.0 * M_PI * freq / (gdouble) samplerate) >= 0.0){
-      buffer[i] = (gint64) (0xffffffffffffffff & ((gint64) buffer[i] + (gint64) (1.0 * scale * volume)));
-    }else{
-      buffer[i] = (gint64) (0xffffffffffffffff & ((gint64) buffer[i] + (gint64) (-1.0 * scale * volume)));
-    }
-  }
+  ags_synth_util_oscillate_s64(buffer,
+			       AGS_SYNTH_OSCILLATOR_SQUARE,
+			       freq, phase, volume,
+			       samplerate,
+			       offset, n_frames);
 }
 
 /**
@@ -1394,7 +1961,7 @@ ags_synth_util_square_s64(gint64 *buffer,
  * @offset: start frame
  * @n_frames: generate n frames
  *
- * Generate square wave.
+ * Generate band-limited square wave.
  *
  * Since: 3.0.0
  */
@@ -1404,15 +1971,11 @@ ags_synth_util_square_float(float *buffer,
 			    guint samplerate,
 			    guint offset, guint n_frames)
 {
-  guint i;
-
-  for(i = offset; i < offset + n_frames; i++){
-    if(sin((gdouble) (i + phase) * 2.0 * M_PI * freq / (gdouble) samplerate) >= 0.0){
-      buffer[i] = (buffer[i] + (1.0 * volume));
-    }else{
-      buffer[i] = (buffer[i] + (-1.0 * volume));
-    }
-  }
+  ags_synth_util_oscillate_float(buffer,
+				 AGS_SYNTH_OSCILLATOR_SQUARE,
+				 freq, phase, volume,
+				 samplerate,
+				 offset, n_frames);
 }
 
 /**
@@ -1425,7 +1988,7 @@ ags_synth_util_square_float(float *buffer,
  * @offset: start frame
  * @n_frames: generate n frames
  *
- * Generate square wave.
+ * Generate band-limited square wave.
  *
  * Since: 3.0.0
  */
@@ -1435,15 +1998,11 @@ ags_synth_util_square_double(double *buffer,
 			     guint samplerate,
 			     guint offset, guint n_frames)
 {
-  guint i;
-
-  for(i = offset; i < offset + n_frames; i++){
-    if(sin((gdouble) (i + phase) * 2.0 * M_PI * freq / (gdouble) samplerate) >= 0.0){
-      buffer[i] = (buffer[i] + (1.0 * volume));
-    }else{
-      buffer[i] = (buffer[i] + (-1.0 * volume));
-    }
-  }
+  ags_synth_util_oscillate_double(buffer,
+				  AGS_SYNTH_OSCILLATOR_SQUARE,
+				  freq, phase, volume,
+				  samplerate,
+				  offset, n_frames);
 }
 
 /**
@@ -1456,7 +2015,7 @@ ags_synth_util_square_double(double *buffer,
  * @offset: start frame
  * @n_frames: generate n frames
  *
- * Generate square wave.
+ * Generate band-limited square wave.
  *
  * Since: 3.0.0
  */
@@ -1466,28 +2025,11 @@ ags_synth_util_square_complex(AgsComplex *buffer,
 			      guint samplerate,
 			      guint offset, guint n_frames)
 {
-  AgsComplex *c_ptr;
-  AgsComplex **c_ptr_ptr;
-
-  double y;
-
-  guint i_stop;
-  guint i;
-
-  c_ptr = buffer;
-  c_ptr_ptr = &c_ptr;
-
-  i_stop = offset + n_frames;
-
-  for(i = offset; i < i_stop; i++, c_ptr++){
-    if(sin((gdouble) (i + phase) * 2.0 * M_PI * freq / (gdouble) samplerate) >= 0.0){
-      y = (1.0 * volume);
-    }else{
-      y = (-1.0 * volume);
-    }    
-
-    AGS_AUDIO_BUFFER_UTIL_DOUBLE_TO_COMPLEX(y, c_ptr_ptr);
-  }
+  ags_synth_util_oscillate_complex(buffer,
+				   AGS_SYNTH_OSCILLATOR_SQUARE,
+				   freq, phase, volume,
+				   samplerate,
+				   offset, n_frames);
 }
 
 /**
@@ -1500,7 +2042,7 @@ ags_synth_util_square_complex(AgsComplex *buffer,
  * @offset: start frame
  * @n_frames: generate n frames
  *
- * Generate impulse wave.
+ * Generate band-limited impulse wave.
  *
  * Since: 3.0.0
  */
@@ -1510,16 +2052,11 @@ ags_synth_util_impulse_s8(gint8 *buffer,
 			  guint samplerate,
 			  guint offset, guint n_frames)
 {
-  static const gdouble scale = 127.0;
-  guint i;
-
-  for(i = offset; i < offset + n_frames; i++){
-    if(sin((gdouble) (i + phase) * 2.0 * M_PI * freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-      buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) (1.0 * scale * volume)));
-    }else{
-      buffer[i] = (gint8) (0xff & ((gint16) buffer[i] + (gint16) (-1.0 * scale * volume)));
-    }
-  }
+  ags_synth_util_oscillate_s8(buffer,
+			      AGS_SYNTH_OSCILLATOR_IMPULSE,
+			      freq, phase, volume,
+			      samplerate,
+			      offset, n_frames);
 }
 
 /**
@@ -1532,7 +2069,7 @@ ags_synth_util_impulse_s8(gint8 *buffer,
  * @offset: start frame
  * @n_frames: generate n frames
  *
- * Generate impulse wave.
+ * Generate band-limited impulse wave.
  *
  * Since: 3.0.0
  */
@@ -1542,16 +2079,11 @@ ags_synth_util_impulse_s16(gint16 *buffer,
 			   guint samplerate,
 			   guint offset, guint n_frames)
 {
-  static const gdouble scale = 32767.0;
-  guint i;
-
-  for(i = offset; i < offset + n_frames; i++){
-    if(sin((gdouble) (i + phase) * 2.0 * M_PI * freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-      buffer[i] = (gint16) (0xffff & ((gint32) buffer[i] + (gint32) (1.0 * scale * volume)));
-    }else{
-      buffer[i] = (gint16) (0xffff & ((gint32) buffer[i] + (gint32) (-1.0 * scale * volume)));
-    }
-  }
+  ags_synth_util_oscillate_s16(buffer,
+			       AGS_SYNTH_OSCILLATOR_IMPULSE,
+			       freq, phase, volume,
+			       samplerate,
+			       offset, n_frames);
 }
 
 /**
@@ -1564,7 +2096,7 @@ ags_synth_util_impulse_s16(gint16 *buffer,
  * @offset: start frame
  * @n_frames: generate n frames
  *
- * Generate impulse wave.
+ * Generate band-limited impulse wave.
  *
  * Since: 3.0.0
  */
@@ -1574,16 +2106,11 @@ ags_synth_util_impulse_s24(gint32 *buffer,
 			   guint samplerate,
 			   guint offset, guint n_frames)
 {
-  static const gdouble scale = 8388607.0;
-  guint i;
-
-  for(i = offset; i < offset + n_frames; i++){
-    if(sin((gdouble) (i + phase) * 2.0 * M_PI * freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-      buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) (1.0 * scale * volume)));
-    }else{
-      buffer[i] = (gint32) (0xffffffff & ((gint32) buffer[i] + (gint32) (-1.0 * scale * volume)));
-    }
-  }
+  ags_synth_util_oscillate_s24(buffer,
+			       AGS_SYNTH_OSCILLATOR_IMPULSE,
+			       freq, phase, volume,
+			       samplerate,
+			       offset, n_frames);
 }
 
 /**
@@ -1596,7 +2123,7 @@ ags_synth_util_impulse_s24(gint32 *buffer,
  * @offset: start frame
  * @n_frames: generate n frames
  *
- * Generate impulse wave.
+ * Generate band-limited impulse wave.
  *
  * Since: 3.0.0
  */
@@ -1606,16 +2133,11 @@ ags_synth_util_impulse_s32(gint32 *buffer,
 			   guint samplerate,
 			   guint offset, guint n_frames)
 {
-  static const gdouble scale = 214748363.0;
-  guint i;
-
-  for(i = offset; i < offset + n_frames; i++){
-    if(sin((gdouble) (i + phase) * 2.0 * M_PI * freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-      buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) (1.0 * scale * volume)));
-    }else{
-      buffer[i] = (gint32) (0xffffffff & ((gint64) buffer[i] + (gint64) (-1.0 * scale * volume)));
-    }
-  }
+  ags_synth_util_oscillate_s32(buffer,
+			       AGS_SYNTH_OSCILLATOR_IMPULSE,
+			       freq, phase, volume,
+			       samplerate,
+			       offset, n_frames);
 }
 
 /**
@@ -1628,7 +2150,7 @@ ags_synth_util_impulse_s32(gint32 *buffer,
  * @offset: start frame
  * @n_frames: generate n frames
  *
- * Generate impulse wave.
+ * Generate band-limited impulse wave.
  *
  * Since: 3.0.0
  */
@@ -1638,16 +2160,11 @@ ags_synth_util_impulse_s64(gint64 *buffer,
 			   guint samplerate,
 			   guint offset, guint n_frames)
 {
-  static const gdouble scale = 9223372036854775807.0;
-  guint i;
-
-  for(i = offset; i < offset + n_frames; i++){
-    if(sin((gdouble) (i + phase) * 2.0 * M_PI * freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-      buffer[i] = (gint64) (0xffffffffffffffff & ((gint64) buffer[i] + (gint64) (1.0 * scale * volume)));
-    }else{
-      buffer[i] = (gint64) (0xffffffffffffffff & ((gint64) buffer[i] + (gint64) (-1.0 * scale * volume)));
-    }
-  }
+  ags_synth_util_oscillate_s64(buffer,
+			       AGS_SYNTH_OSCILLATOR_IMPULSE,
+			       freq, phase, volume,
+			       samplerate,
+			       offset, n_frames);
 }
 
 /**
@@ -1660,7 +2177,7 @@ ags_synth_util_impulse_s64(gint64 *buffer,
  * @offset: start frame
  * @n_frames: generate n frames
  *
- * Generate impulse wave.
+ * Generate band-limited impulse wave.
  *
  * Since: 3.0.0
  */
@@ -1670,15 +2187,11 @@ ags_synth_util_impulse_float(float *buffer,
 			     guint samplerate,
 			     guint offset, guint n_frames)
 {
-  guint i;
-
-  for(i = offset; i < offset + n_frames; i++){
-    if(sin((gdouble) (i + phase) * 2.0 * M_PI * freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-      buffer[i] = (buffer[i] + (1.0 * volume));
-    }else{
-      buffer[i] = (buffer[i] + (-1.0 * volume));
-    }
-  }
+  ags_synth_util_oscillate_float(buffer,
+				 AGS_SYNTH_OSCILLATOR_IMPULSE,
+				 freq, phase, volume,
+				 samplerate,
+				 offset, n_frames);
 }
 
 /**
@@ -1691,7 +2204,7 @@ ags_synth_util_impulse_float(float *buffer,
  * @offset: start frame
  * @n_frames: generate n frames
  *
- * Generate impulse wave.
+ * Generate band-limited impulse wave.
  *
  * Since: 3.0.0
  */
@@ -1701,15 +2214,11 @@ ags_synth_util_impulse_double(double *buffer,
 			      guint samplerate,
 			      guint offset, guint n_frames)
 {
-  guint i;
-
-  for(i = offset; i < offset + n_frames; i++){
-    if(sin((gdouble) (i + phase) * 2.0 * M_PI * freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-      buffer[i] = (buffer[i] + (1.0 * volume));
-    }else{
-      buffer[i] = (buffer[i] + (-1.0 * volume));
-    }
-  }
+  ags_synth_util_oscillate_double(buffer,
+				  AGS_SYNTH_OSCILLATOR_IMPULSE,
+				  freq, phase, volume,
+				  samplerate,
+				  offset, n_frames);
 }
 
 /**
@@ -1722,7 +2231,7 @@ ags_synth_util_impulse_double(double *buffer,
  * @offset: start frame
  * @n_frames: generate n frames
  *
- * Generate impulse wave.
+ * Generate band-limited impulse wave.
  *
  * Since: 3.0.0
  */
@@ -1732,28 +2241,11 @@ ags_synth_util_impulse_complex(AgsComplex *buffer,
 			       guint samplerate,
 			       guint offset, guint n_frames)
 {
-  AgsComplex *c_ptr;
-  AgsComplex **c_ptr_ptr;
-
-  double y;
-
-  guint i_stop;
-  guint i;
-
-  c_ptr = buffer;
-  c_ptr_ptr = &c_ptr;
-
-  i_stop = offset + n_frames;
-
-  for(i = offset; i < i_stop; i++, c_ptr++){
-    if(sin((gdouble) (i + phase) * 2.0 * M_PI * freq / (gdouble) samplerate) >= sin(2.0 * M_PI * 3.0 / 5.0)){
-      y = (1.0 * volume);
-    }else{
-      y = (-1.0 * volume);
-    }
-
-    AGS_AUDIO_BUFFER_UTIL_DOUBLE_TO_COMPLEX(y, c_ptr_ptr);
-  }
+  ags_synth_util_oscillate_complex(buffer,
+				   AGS_SYNTH_OSCILLATOR_IMPULSE,
+				   freq, phase, volume,
+				   samplerate,
+				   offset, n_frames);
 }
 
 /**
@@ -1860,7 +2352,7 @@ ags_synth_util_sin(void *buffer,
  * @offset: start frame
  * @n_frames: generate n frames
  *
- * Generate sawtooth wave.
+ * Generate band-limited sawtooth wave.
  *
  * Since: 3.0.0
  */
@@ -1953,7 +2445,7 @@ ags_synth_util_sawtooth(void *buffer,
  * @offset: start frame
  * @n_frames: generate n frames
  *
- * Generate triangle wave.
+ * Generate band-limited triangle wave.
  *
  * Since: 3.0.0
  */
@@ -2046,7 +2538,7 @@ ags_synth_util_triangle(void *buffer,
  * @offset: start frame
  * @n_frames: generate n frames
  *
- * Generate square wave.
+ * Generate band-limited square wave.
  *
  * Since: 3.0.0
  */
@@ -2139,7 +2631,7 @@ ags_synth_util_square(void *buffer,
  * @offset: start frame
  * @n_frames: generate n frames
  *
- * Generate impulse wave.
+ * Generate band-limited impulse wave.
  *
  * Since: 3.0.0
  */
@@ -27,6 +27,9 @@
 
 G_BEGIN_DECLS
 
+#define AGS_SYNTH_UTIL_SIN_TABLE_SIZE (2048)
+#define AGS_SYNTH_UTIL_CHUNK_SIZE (256)
+
 /* zero-crossing */
 guint ags_synth_util_get_xcross_count_s8(gint8 *buffer,
 					 guint buffer_size);
@@ -49,6 +52,61 @@ guint ags_synth_util_get_xcross_count(void *buffer,
 				      guint audio_buffer_util_format,
 				      guint buffer_size);
 
+/* band-limited oscillator */
+void ags_synth_util_sin_table_init();
+
+gdouble ags_synth_util_sin_lookup(gdouble t);
+
+gdouble ags_synth_util_poly_blep(gdouble t, gdouble dt);
+gdouble ags_synth_util_poly_blamp(gdouble t, gdouble dt);
+
+void ags_synth_util_oscillate_s8(gint8 *buffer,
+				 guint oscillator_mode,
+				 gdouble freq, gdouble phase, gdouble volume,
+				 guint samplerate,
+				 guint offset, guint n_frames);
+void ags_synth_util_oscillate_s16(gint16 *buffer,
+				  guint oscillator_mode,
+				  gdouble freq, gdouble phase, gdouble volume,
+				  guint samplerate,
+				  guint offset, guint n_frames);
+void ags_synth_util_oscillate_s24(gint32 *buffer,
+				  guint oscillator_mode,
+				  gdouble freq, gdouble phase, gdouble volume,
+				  guint samplerate,
+				  guint offset, guint n_frames);
+void ags_synth_util_oscillate_s32(gint32 *buffer,
+				  guint oscillator_mode,
+				  gdouble freq, gdouble phase, gdouble volume,
+				  guint samplerate,
+				  guint offset, guint n_frames);
+void ags_synth_util_oscillate_s64(gint64 *buffer,
+				  guint oscillator_mode,
+				  gdouble freq, gdouble phase, gdouble volume,
+				  guint samplerate,
+				  guint offset, guint n_frames);
+void ags_synth_util_oscillate_float(float *buffer,
+				    guint oscillator_mode,
+				    gdouble freq, gdouble phase, gdouble volume,
+				    guint samplerate,
+				    guint offset, guint n_frames);
+void ags_synth_util_oscillate_double(gdouble *buffer,
+				     guint oscillator_mode,
+				     gdouble freq, gdouble phase, gdouble volume,
+				     guint samplerate,
+				     guint offset, guint n_frames);
+void ags_synth_util_oscillate_complex(AgsComplex *buffer,
+				      guint oscillator_mode,
+				      gdouble freq, gdouble phase, gdouble volume,
+				      guint samplerate,
+				      guint offset, guint n_frames);
+
+void ags_synth_util_oscillate(void *buffer,
+			      guint oscillator_mode,
+			      gdouble freq, gdouble phase, gdouble volume,
+			      guint samplerate, guint audio_buffer_util_format,
+			      guint offset, guint n_frames);
+
 /* sin oscillator */
 void ags_synth_util_sin_s8(gint8 *buffer,
 			   gdouble freq, gdouble phase, gdouble volume,
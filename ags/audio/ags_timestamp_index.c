@@ -0,0 +1,661 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ags/audio/ags_timestamp_index.h>
+
+#include <ags/i18n.h>
+
+void ags_timestamp_index_class_init(AgsTimestampIndexClass *timestamp_index);
+void ags_timestamp_index_init(AgsTimestampIndex *timestamp_index);
+void ags_timestamp_index_set_property(GObject *gobject,
+				      guint prop_id,
+				      const GValue *value,
+				      GParamSpec *param_spec);
+void ags_timestamp_index_get_property(GObject *gobject,
+				      guint prop_id,
+				      GValue *value,
+				      GParamSpec *param_spec);
+void ags_timestamp_index_finalize(GObject *gobject);
+
+guint64* ags_timestamp_index_bucket_key(AgsTimestampIndex *timestamp_index,
+					guint line,
+					guint64 nth_bucket);
+void ags_timestamp_index_entry_free(AgsTimestampIndexEntry *entry);
+void ags_timestamp_index_unlink_entry(AgsTimestampIndex *timestamp_index,
+				      AgsTimestampIndexEntry *entry);
+void ags_timestamp_index_link_entry(AgsTimestampIndex *timestamp_index,
+				    AgsTimestampIndexEntry *entry);
+
+/**
+ * SECTION:ags_timestamp_index
+ * @short_description: index of timestamped segments
+ * @title: AgsTimestampIndex
+ * @section_id:
+ * @include: ags/audio/ags_timestamp_index.h
+ *
+ * #AgsTimestampIndex maps line and timestamp offset of segments like #AgsNotation,
+ * #AgsAutomation or #AgsWave to the segment. The offsets are hashed to buckets of
+ * offset length, so a lookup doesn't depend on the count of segments.
+ */
+
+enum{
+  PROP_0,
+  PROP_OFFSET_LENGTH,
+};
+
+static gpointer ags_timestamp_index_parent_class = NULL;
+
+GType
+ags_timestamp_index_get_type()
+{
+  static volatile gsize g_define_type_id__volatile = 0;
+
+  if(g_once_init_enter (&g_define_type_id__volatile)){
+    GType ags_type_timestamp_index = 0;
+
+    static const GTypeInfo ags_timestamp_index_info = {
+      sizeof(AgsTimestampIndexClass),
+      NULL,
+      NULL,
+      (GClassInitFunc) ags_timestamp_index_class_init,
+      NULL,
+      NULL,
+      sizeof(AgsTimestampIndex),
+      0,
+      (GInstanceInitFunc) ags_timestamp_index_init,
+    };
+
+    ags_type_timestamp_index = g_type_register_static(G_TYPE_OBJECT,
+						      "AgsTimestampIndex",
+						      &ags_timestamp_index_info,
+						      0);
+
+    g_once_init_leave(&g_define_type_id__volatile, ags_type_timestamp_index);
+  }
+
+  return g_define_type_id__volatile;
+}
+
+void
+ags_timestamp_index_class_init(AgsTimestampIndexClass *timestamp_index)
+{
+  GObjectClass *gobject;
+
+  GParamSpec *param_spec;
+
+  ags_timestamp_index_parent_class = g_type_class_peek_parent(timestamp_index);
+
+  gobject = (GObjectClass *) timestamp_index;
+
+  gobject->set_property = ags_timestamp_index_set_property;
+  gobject->get_property = ags_timestamp_index_get_property;
+
+  gobject->finalize = ags_timestamp_index_finalize;
+
+  /* properties */
+  /**
+   * AgsTimestampIndex:offset-length:
+   *
+   * The offset length covered by one bucket.
+   *
+   * Since: 3.7.0
+   */
+  param_spec = g_param_spec_uint64("offset-length",
+				   i18n_pspec("offset length"),
+				   i18n_pspec("The offset length of a bucket"),
+				   1,
+				   G_MAXUINT64,
+				   1,
+				   G_PARAM_READABLE | G_PARAM_WRITABLE);
+  g_object_class_install_property(gobject,
+				  PROP_OFFSET_LENGTH,
+				  param_spec);
+}
+
+void
+ags_timestamp_index_init(AgsTimestampIndex *timestamp_index)
+{
+  timestamp_index->flags = 0;
+
+  /* add timestamp index mutex */
+  g_rec_mutex_init(&(timestamp_index->obj_mutex));
+
+  /* fields */
+  timestamp_index->offset_length = 1;
+
+  timestamp_index->bucket = g_hash_table_new_full(g_int64_hash, g_int64_equal,
+						  g_free,
+						  (GDestroyNotify) g_list_free);
+  timestamp_index->entry = g_hash_table_new_full(g_direct_hash, g_direct_equal,
+						 NULL,
+						 (GDestroyNotify) ags_timestamp_index_entry_free);
+}
+
+void
+ags_timestamp_index_set_property(GObject *gobject,
+				 guint prop_id,
+				 const GValue *value,
+				 GParamSpec *param_spec)
+{
+  AgsTimestampIndex *timestamp_index;
+
+  GRecMutex *timestamp_index_mutex;
+
+  timestamp_index = AGS_TIMESTAMP_INDEX(gobject);
+
+  /* get timestamp index mutex */
+  timestamp_index_mutex = AGS_TIMESTAMP_INDEX_GET_OBJ_MUTEX(timestamp_index);
+
+  switch(prop_id){
+  case PROP_OFFSET_LENGTH:
+    {
+      GHashTableIter iter;
+      
+      guint64 offset_length;
+
+      gpointer entry;
+      
+      offset_length = g_value_get_uint64(value);
+
+      g_rec_mutex_lock(timestamp_index_mutex);
+
+      if(offset_length == 0 ||
+	 offset_length == timestamp_index->offset_length){
+	g_rec_mutex_unlock(timestamp_index_mutex);
+
+	return;
+      }
+
+      /* rehash */
+      g_hash_table_remove_all(timestamp_index->bucket);
+
+      timestamp_index->offset_length = offset_length;
+
+      g_hash_table_iter_init(&iter,
+			     timestamp_index->entry);
+
+      while(g_hash_table_iter_next(&iter, NULL, &entry)){
+	ags_timestamp_index_link_entry(timestamp_index,
+				       entry);
+      }
+      
+      g_rec_mutex_unlock(timestamp_index_mutex);
+    }
+    break;
+  default:
+    G_OBJECT_WARN_INVALID_PROPERTY_ID(gobject, prop_id, param_spec);
+    break;
+  }
+}
+
+void
+ags_timestamp_index_get_property(GObject *gobject,
+				 guint prop_id,
+				 GValue *value,
+				 GParamSpec *param_spec)
+{
+  AgsTimestampIndex *timestamp_index;
+
+  GRecMutex *timestamp_index_mutex;
+
+  timestamp_index = AGS_TIMESTAMP_INDEX(gobject);
+
+  /* get timestamp index mutex */
+  timestamp_index_mutex = AGS_TIMESTAMP_INDEX_GET_OBJ_MUTEX(timestamp_index);
+
+  switch(prop_id){
+  case PROP_OFFSET_LENGTH:
+    {
+      g_rec_mutex_lock(timestamp_index_mutex);
+
+      g_value_set_uint64(value,
+			 timestamp_index->offset_length);
+
+      g_rec_mutex_unlock(timestamp_index_mutex);
+    }
+    break;
+  default:
+    G_OBJECT_WARN_INVALID_PROPERTY_ID(gobject, prop_id, param_spec);
+    break;
+  }
+}
+
+void
+ags_timestamp_index_finalize(GObject *gobject)
+{
+  AgsTimestampIndex *timestamp_index;
+
+  timestamp_index = AGS_TIMESTAMP_INDEX(gobject);
+
+  g_hash_table_destroy(timestamp_index->bucket);
+  g_hash_table_destroy(timestamp_index->entry);
+
+  /* call parent */
+  G_OBJECT_CLASS(ags_timestamp_index_parent_class)->finalize(gobject);
+}
+
+guint64*
+ags_timestamp_index_bucket_key(AgsTimestampIndex *timestamp_index,
+			       guint line,
+			       guint64 nth_bucket)
+{
+  guint64 *key;
+
+  key = (guint64 *) g_malloc(sizeof(guint64));
+  key[0] = (((guint64) line) << AGS_TIMESTAMP_INDEX_LINE_SHIFT) | (nth_bucket & ((G_GUINT64_CONSTANT(1) << AGS_TIMESTAMP_INDEX_LINE_SHIFT) - 1));
+
+  return(key);
+}
+
+void
+ags_timestamp_index_entry_free(AgsTimestampIndexEntry *entry)
+{
+  if(entry == NULL){
+    return;
+  }
+
+  g_object_unref(entry->data);
+  
+  g_free(entry);
+}
+
+void
+ags_timestamp_index_unlink_entry(AgsTimestampIndex *timestamp_index,
+				 AgsTimestampIndexEntry *entry)
+{
+  GList *start_list;
+  
+  guint64 *key;
+  gpointer orig_key;
+
+  key = ags_timestamp_index_bucket_key(timestamp_index,
+				       entry->line,
+				       entry->offset / timestamp_index->offset_length);
+
+  if(g_hash_table_lookup_extended(timestamp_index->bucket,
+				  key,
+				  &orig_key, (gpointer *) &start_list)){
+    /* the list's head might change */
+    g_hash_table_steal(timestamp_index->bucket,
+		       key);
+
+    start_list = g_list_remove(start_list,
+			       entry);
+    
+    if(start_list != NULL){
+      g_hash_table_insert(timestamp_index->bucket,
+			  orig_key,
+			  start_list);
+    }else{
+      g_free(orig_key);
+    }
+  }
+  
+  g_free(key);
+}
+
+void
+ags_timestamp_index_link_entry(AgsTimestampIndex *timestamp_index,
+			       AgsTimestampIndexEntry *entry)
+{
+  GList *start_list;
+  
+  guint64 *key;
+
+  key = ags_timestamp_index_bucket_key(timestamp_index,
+				       entry->line,
+				       entry->offset / timestamp_index->offset_length);
+
+  start_list = g_hash_table_lookup(timestamp_index->bucket,
+				   key);
+
+  if(start_list != NULL){
+    /* appending keeps the list's head */
+    g_list_append(start_list,
+		  entry);
+
+    g_free(key);
+  }else{
+    g_hash_table_insert(timestamp_index->bucket,
+			key,
+			g_list_prepend(NULL,
+				       entry));
+  }
+}
+
+/**
+ * ags_timestamp_index_get_offset_length:
+ * @timestamp_index: the #AgsTimestampIndex
+ * 
+ * Get offset length of a bucket.
+ * 
+ * Returns: the offset length
+ * 
+ * Since: 3.7.0
+ */
+guint64
+ags_timestamp_index_get_offset_length(AgsTimestampIndex *timestamp_index)
+{
+  guint64 offset_length;
+  
+  if(!AGS_IS_TIMESTAMP_INDEX(timestamp_index)){
+    return(0);
+  }
+
+  g_object_get(timestamp_index,
+	       "offset-length", &offset_length,
+	       NULL);
+
+  return(offset_length);
+}
+
+/**
+ * ags_timestamp_index_insert:
+ * @timestamp_index: the #AgsTimestampIndex
+ * @data: the #GObject to index
+ * @line: the line or audio channel
+ * @offset: the timestamp's offset
+ * 
+ * Insert @data at @line and @offset, if @data was already indexed it is moved.
+ * 
+ * Since: 3.7.0
+ */
+void
+ags_timestamp_index_insert(AgsTimestampIndex *timestamp_index,
+			   GObject *data,
+			   guint line,
+			   guint64 offset)
+{
+  AgsTimestampIndexEntry *entry;
+  
+  GRecMutex *timestamp_index_mutex;
+
+  if(!AGS_IS_TIMESTAMP_INDEX(timestamp_index) ||
+     !G_IS_OBJECT(data)){
+    return;
+  }
+
+  /* get timestamp index mutex */
+  timestamp_index_mutex = AGS_TIMESTAMP_INDEX_GET_OBJ_MUTEX(timestamp_index);
+
+  g_rec_mutex_lock(timestamp_index_mutex);
+
+  entry = g_hash_table_lookup(timestamp_index->entry,
+			      data);
+
+  if(entry != NULL){
+    ags_timestamp_index_unlink_entry(timestamp_index,
+				     entry);
+  }else{
+    entry = (AgsTimestampIndexEntry *) g_new0(AgsTimestampIndexEntry,
+					      1);
+
+    entry->data = data;
+    g_object_ref(data);
+    
+    g_hash_table_insert(timestamp_index->entry,
+			data,
+			entry);
+  }
+
+  entry->line = line;
+  entry->offset = offset;
+
+  ags_timestamp_index_link_entry(timestamp_index,
+				 entry);
+  
+  g_rec_mutex_unlock(timestamp_index_mutex);
+}
+
+/**
+ * ags_timestamp_index_remove:
+ * @timestamp_index: the #AgsTimestampIndex
+ * @data: the #GObject to remove
+ * 
+ * Remove @data from @timestamp_index.
+ * 
+ * Since: 3.7.0
+ */
+void
+ags_timestamp_index_remove(AgsTimestampIndex *timestamp_index,
+			   GObject *data)
+{
+  AgsTimestampIndexEntry *entry;
+  
+  GRecMutex *timestamp_index_mutex;
+
+  if(!AGS_IS_TIMESTAMP_INDEX(timestamp_index)){
+    return;
+  }
+
+  /* get timestamp index mutex */
+  timestamp_index_mutex = AGS_TIMESTAMP_INDEX_GET_OBJ_MUTEX(timestamp_index);
+
+  g_rec_mutex_lock(timestamp_index_mutex);
+
+  entry = g_hash_table_lookup(timestamp_index->entry,
+			      data);
+
+  if(entry != NULL){
+    ags_timestamp_index_unlink_entry(timestamp_index,
+				     entry);
+
+    g_hash_table_remove(timestamp_index->entry,
+			data);
+  }
+  
+  g_rec_mutex_unlock(timestamp_index_mutex);
+}
+
+/**
+ * ags_timestamp_index_clear:
+ * @timestamp_index: the #AgsTimestampIndex
+ * 
+ * Remove all entries of @timestamp_index.
+ * 
+ * Since: 3.7.0
+ */
+void
+ags_timestamp_index_clear(AgsTimestampIndex *timestamp_index)
+{
+  GRecMutex *timestamp_index_mutex;
+
+  if(!AGS_IS_TIMESTAMP_INDEX(timestamp_index)){
+    return;
+  }
+
+  /* get timestamp index mutex */
+  timestamp_index_mutex = AGS_TIMESTAMP_INDEX_GET_OBJ_MUTEX(timestamp_index);
+
+  g_rec_mutex_lock(timestamp_index_mutex);
+
+  g_hash_table_remove_all(timestamp_index->bucket);
+  g_hash_table_remove_all(timestamp_index->entry);
+  
+  g_rec_mutex_unlock(timestamp_index_mutex);
+}
+
+/**
+ * ags_timestamp_index_find:
+ * @timestamp_index: the #AgsTimestampIndex
+ * @line: the line or audio channel
+ * @x: the offset
+ * @length: the offset length to search
+ * 
+ * Find the entry of @line with the lowest offset within @x and @x + @length.
+ * 
+ * Returns: (transfer full): the matching #GObject or %NULL
+ * 
+ * Since: 3.7.0
+ */
+GObject*
+ags_timestamp_index_find(AgsTimestampIndex *timestamp_index,
+			 guint line,
+			 guint64 x, guint64 length)
+{
+  AgsTimestampIndexEntry *retval;
+  
+  GList *list;
+
+  guint64 key;
+  guint64 first_bucket, last_bucket;
+  guint64 i;
+  
+  GRecMutex *timestamp_index_mutex;
+
+  if(!AGS_IS_TIMESTAMP_INDEX(timestamp_index) ||
+     length == 0){
+    return(NULL);
+  }
+
+  /* get timestamp index mutex */
+  timestamp_index_mutex = AGS_TIMESTAMP_INDEX_GET_OBJ_MUTEX(timestamp_index);
+
+  g_rec_mutex_lock(timestamp_index_mutex);
+
+  first_bucket = x / timestamp_index->offset_length;
+  last_bucket = (x + length - 1) / timestamp_index->offset_length;
+
+  retval = NULL;
+  
+  for(i = first_bucket; i <= last_bucket && retval == NULL; i++){
+    key = (((guint64) line) << AGS_TIMESTAMP_INDEX_LINE_SHIFT) | (i & ((G_GUINT64_CONSTANT(1) << AGS_TIMESTAMP_INDEX_LINE_SHIFT) - 1));
+    
+    list = g_hash_table_lookup(timestamp_index->bucket,
+			       &key);
+
+    while(list != NULL){
+      AgsTimestampIndexEntry *entry;
+
+      entry = AGS_TIMESTAMP_INDEX_ENTRY(list->data);
+      
+      if(entry->line == line &&
+	 entry->offset >= x &&
+	 entry->offset < x + length){
+	if(retval == NULL ||
+	   entry->offset < retval->offset){
+	  retval = entry;
+	}
+      }
+      
+      list = list->next;
+    }
+  }
+
+  if(retval != NULL){
+    g_object_ref(retval->data);
+  }
+  
+  g_rec_mutex_unlock(timestamp_index_mutex);
+
+  return((retval != NULL) ? retval->data: NULL);
+}
+
+/**
+ * ags_timestamp_index_find_all:
+ * @timestamp_index: the #AgsTimestampIndex
+ * @line: the line or audio channel
+ * @x: the offset
+ * @length: the offset length to search
+ * 
+ * Find all entries of @line with offset within @x and @x + @length.
+ * 
+ * Returns: (element-type GObject) (transfer full): the matching #GObject as #GList-struct
+ * 
+ * Since: 3.7.0
+ */
+GList*
+ags_timestamp_index_find_all(AgsTimestampIndex *timestamp_index,
+			     guint line,
+			     guint64 x, guint64 length)
+{
+  GList *retval;
+  GList *list;
+
+  guint64 key;
+  guint64 first_bucket, last_bucket;
+  guint64 i;
+  
+  GRecMutex *timestamp_index_mutex;
+
+  if(!AGS_IS_TIMESTAMP_INDEX(timestamp_index) ||
+     length == 0){
+    return(NULL);
+  }
+
+  /* get timestamp index mutex */
+  timestamp_index_mutex = AGS_TIMESTAMP_INDEX_GET_OBJ_MUTEX(timestamp_index);
+
+  g_rec_mutex_lock(timestamp_index_mutex);
+
+  first_bucket = x / timestamp_index->offset_length;
+  last_bucket = (x + length - 1) / timestamp_index->offset_length;
+
+  retval = NULL;
+  
+  for(i = first_bucket; i <= last_bucket; i++){
+    key = (((guint64) line) << AGS_TIMESTAMP_INDEX_LINE_SHIFT) | (i & ((G_GUINT64_CONSTANT(1) << AGS_TIMESTAMP_INDEX_LINE_SHIFT) - 1));
+    
+    list = g_hash_table_lookup(timestamp_index->bucket,
+			       &key);
+
+    while(list != NULL){
+      AgsTimestampIndexEntry *entry;
+
+      entry = AGS_TIMESTAMP_INDEX_ENTRY(list->data);
+      
+      if(entry->line == line &&
+	 entry->offset >= x &&
+	 entry->offset < x + length){
+	g_object_ref(entry->data);
+	
+	retval = g_list_prepend(retval,
+				entry->data);
+      }
+      
+      list = list->next;
+    }
+  }
+  
+  g_rec_mutex_unlock(timestamp_index_mutex);
+
+  return(g_list_reverse(retval));
+}
+
+/**
+ * ags_timestamp_index_new:
+ * @offset_length: the offset length of a bucket
+ *
+ * Create a new instance of #AgsTimestampIndex.
+ *
+ * Returns: the new #AgsTimestampIndex
+ *
+ * Since: 3.7.0
+ */
+AgsTimestampIndex*
+ags_timestamp_index_new(guint64 offset_length)
+{
+  AgsTimestampIndex *timestamp_index;
+
+  timestamp_index = (AgsTimestampIndex *) g_object_new(AGS_TYPE_TIMESTAMP_INDEX,
+						       "offset-length", offset_length,
+						       NULL);
+
+  return(timestamp_index);
+}
@@ -0,0 +1,106 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __AGS_TIMESTAMP_INDEX_H__
+#define __AGS_TIMESTAMP_INDEX_H__
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <ags/libags.h>
+
+G_BEGIN_DECLS
+
+#define AGS_TYPE_TIMESTAMP_INDEX                (ags_timestamp_index_get_type())
+#define AGS_TIMESTAMP_INDEX(obj)                (G_TYPE_CHECK_INSTANCE_CAST((obj), AGS_TYPE_TIMESTAMP_INDEX, AgsTimestampIndex))
+#define AGS_TIMESTAMP_INDEX_CLASS(class)        (G_TYPE_CHECK_CLASS_CAST((class), AGS_TYPE_TIMESTAMP_INDEX, AgsTimestampIndexClass))
+#define AGS_IS_TIMESTAMP_INDEX(obj)             (G_TYPE_CHECK_INSTANCE_TYPE((obj), AGS_TYPE_TIMESTAMP_INDEX))
+#define AGS_IS_TIMESTAMP_INDEX_CLASS(class)     (G_TYPE_CHECK_CLASS_TYPE((class), AGS_TYPE_TIMESTAMP_INDEX))
+#define AGS_TIMESTAMP_INDEX_GET_CLASS(obj)      (G_TYPE_INSTANCE_GET_CLASS((obj), AGS_TYPE_TIMESTAMP_INDEX, AgsTimestampIndexClass))
+
+#define AGS_TIMESTAMP_INDEX_GET_OBJ_MUTEX(obj) (&(((AgsTimestampIndex *) obj)->obj_mutex))
+
+#define AGS_TIMESTAMP_INDEX_ENTRY(ptr) ((AgsTimestampIndexEntry *)(ptr))
+
+#define AGS_TIMESTAMP_INDEX_LINE_SHIFT (40)
+
+typedef struct _AgsTimestampIndex AgsTimestampIndex;
+typedef struct _AgsTimestampIndexClass AgsTimestampIndexClass;
+typedef struct _AgsTimestampIndexEntry AgsTimestampIndexEntry;
+
+struct _AgsTimestampIndex
+{
+  GObject gobject;
+
+  guint flags;
+
+  GRecMutex obj_mutex;
+
+  guint64 offset_length;
+  
+  GHashTable *bucket;
+  GHashTable *entry;
+};
+
+struct _AgsTimestampIndexClass
+{
+  GObjectClass gobject;
+};
+
+/**
+ * AgsTimestampIndexEntry:
+ * @data: the indexed #GObject
+ * @line: the line or audio channel
+ * @offset: the timestamp's offset
+ *
+ * An entry of #AgsTimestampIndex.
+ */
+struct _AgsTimestampIndexEntry
+{
+  GObject *data;
+
+  guint line;
+  guint64 offset;
+};
+
+GType ags_timestamp_index_get_type();
+
+guint64 ags_timestamp_index_get_offset_length(AgsTimestampIndex *timestamp_index);
+
+void ags_timestamp_index_insert(AgsTimestampIndex *timestamp_index,
+				GObject *data,
+				guint line,
+				guint64 offset);
+void ags_timestamp_index_remove(AgsTimestampIndex *timestamp_index,
+				GObject *data);
+
+void ags_timestamp_index_clear(AgsTimestampIndex *timestamp_index);
+
+GObject* ags_timestamp_index_find(AgsTimestampIndex *timestamp_index,
+				  guint line,
+				  guint64 x, guint64 length);
+GList* ags_timestamp_index_find_all(AgsTimestampIndex *timestamp_index,
+				    guint line,
+				    guint64 x, guint64 length);
+
+AgsTimestampIndex* ags_timestamp_index_new(guint64 offset_length);
+
+G_END_DECLS
+
+#endif /*__AGS_TIMESTAMP_INDEX_H__*/
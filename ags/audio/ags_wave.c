@@ -38,6 +38,14 @@ void ags_wave_get_property(GObject *gobject,
 			   GParamSpec *param_spec);
 void ags_wave_dispose(GObject *gobject);
 void ags_wave_finalize(GObject *gobject);
+
+guint ags_wave_chunk_word_size(guint format);
+gboolean ags_wave_chunk_add_buffer(AgsWave *wave,
+				   AgsBuffer *buffer);
+void ags_wave_chunk_remove_buffer(AgsWave *wave,
+				  AgsBuffer *buffer);
+void ags_wave_free_chunk(AgsWave *wave);
+void ags_wave_rechunk(AgsWave *wave);
   
 void ags_wave_insert_native_level_from_clipboard_version_1_4_0(AgsWave *wave,
 							       xmlNode *root_node, char *version,
@@ -66,7 +74,14 @@ void ags_wave_insert_native_level_from_clipboard(AgsWave *wave,
  * @section_id:
  * @include: ags/audio/ags_wave.h
  *
- * #AgsWave acts as a container of #AgsBuffer.
+ * #AgsWave acts as a container of #AgsBuffer. Alternatively it references a file
+ * region by #AgsWaveStream and provides the prefetched buffers of it.
+ *
+ * The audio data is kept in contiguous chunks of about #AGS_WAVE_DEFAULT_CHUNK_LENGTH
+ * frames and the added #AgsBuffer are views into them, so a buffer is found in
+ * constant time and a range of frames is available by ags_wave_find_data().
+ * Buffers not aligned to the wave's buffer size or of different format keep
+ * their own storage.
  */
 
 enum{
@@ -78,6 +93,7 @@ enum{
   PROP_FORMAT,
   PROP_TIMESTAMP,
   PROP_BUFFER,
+  PROP_WAVE_STREAM,
 };
 
 static gpointer ags_wave_parent_class = NULL;
@@ -248,6 +264,22 @@ ags_wave_class_init(AgsWaveClass *wave)
   g_object_class_install_property(gobject,
 				  PROP_BUFFER,
 				  param_spec);
+
+  /**
+   * AgsWave:wave-stream:
+   *
+   * The assigned #AgsWaveStream streaming the wave from file.
+   * 
+   * Since: 3.7.0
+   */
+  param_spec = g_param_spec_object("wave-stream",
+				   i18n_pspec("wave stream"),
+				   i18n_pspec("The wave stream of wave"),
+				   AGS_TYPE_WAVE_STREAM,
+				   G_PARAM_READABLE | G_PARAM_WRITABLE);
+  g_object_class_install_property(gobject,
+				  PROP_WAVE_STREAM,
+				  param_spec);
 }
 
 void
@@ -282,6 +314,14 @@ ags_wave_init(AgsWave *wave)
 
   wave->buffer = NULL;
   wave->selection = NULL;
+
+  wave->chunk_offset = 0;
+  wave->chunk_length = 0;
+
+  wave->chunk_count = 0;
+  wave->chunk = NULL;
+  
+  wave->wave_stream = NULL;
 }
 
 void
@@ -394,6 +434,8 @@ ags_wave_set_property(GObject *gobject,
 
       wave->timestamp = timestamp;
 
+      ags_wave_rechunk(wave);
+      
       g_rec_mutex_unlock(wave_mutex);
     }
     break;
@@ -419,6 +461,33 @@ ags_wave_set_property(GObject *gobject,
 			  FALSE);
     }
     break;
+  case PROP_WAVE_STREAM:
+    {
+      AgsWaveStream *wave_stream;
+
+      wave_stream = (AgsWaveStream *) g_value_get_object(value);
+
+      g_rec_mutex_lock(wave_mutex);
+
+      if(wave_stream == wave->wave_stream){
+	g_rec_mutex_unlock(wave_mutex);
+	
+	return;
+      }
+
+      if(wave->wave_stream != NULL){
+	g_object_unref(G_OBJECT(wave->wave_stream));
+      }
+
+      if(wave_stream != NULL){
+	g_object_ref(G_OBJECT(wave_stream));
+      }
+
+      wave->wave_stream = wave_stream;
+
+      g_rec_mutex_unlock(wave_mutex);
+    }
+    break;
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID(gobject, prop_id, param_spec);
     break;
@@ -506,6 +575,15 @@ ags_wave_get_property(GObject *gobject,
       g_rec_mutex_unlock(wave_mutex);
     }
     break;
+  case PROP_WAVE_STREAM:
+    {
+      g_rec_mutex_lock(wave_mutex);
+
+      g_value_set_object(value, wave->wave_stream);
+
+      g_rec_mutex_unlock(wave_mutex);
+    }
+    break;
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID(gobject, prop_id, param_spec);
     break;
@@ -535,6 +613,9 @@ ags_wave_dispose(GObject *gobject)
     wave->timestamp = NULL;
   }
 
+  /* chunk */
+  ags_wave_free_chunk(wave);
+  
   /* buffer and selection */
   list = wave->buffer;
 
@@ -551,6 +632,13 @@ ags_wave_dispose(GObject *gobject)
 
   wave->buffer = NULL;
   wave->selection = NULL;
+
+  /* wave stream */
+  if(wave->wave_stream != NULL){
+    g_object_unref(wave->wave_stream);
+
+    wave->wave_stream = NULL;
+  }
     
   /* call parent */
   G_OBJECT_CLASS(ags_wave_parent_class)->dispose(gobject);
@@ -573,17 +661,285 @@ ags_wave_finalize(GObject *gobject)
     g_object_unref(wave->timestamp);
   }
     
+  /* chunk */
+  ags_wave_free_chunk(wave);
+  
   /* buffer and selection */
   g_list_free_full(wave->buffer,
 		   g_object_unref);
 
   g_list_free_full(wave->selection,
 		   g_object_unref);
+
+  /* wave stream */
+  if(wave->wave_stream != NULL){
+    g_object_unref(wave->wave_stream);
+  }
   
   /* call parent */
   G_OBJECT_CLASS(ags_wave_parent_class)->finalize(gobject);
 }
 
+guint
+ags_wave_chunk_word_size(guint format)
+{
+  switch(format){
+  case AGS_SOUNDCARD_SIGNED_8_BIT:
+    return(sizeof(gint8));
+  case AGS_SOUNDCARD_SIGNED_16_BIT:
+    return(sizeof(gint16));
+  case AGS_SOUNDCARD_SIGNED_24_BIT:
+  case AGS_SOUNDCARD_SIGNED_32_BIT:
+    return(sizeof(gint32));
+  case AGS_SOUNDCARD_SIGNED_64_BIT:
+    return(sizeof(gint64));
+  case AGS_SOUNDCARD_FLOAT:
+    return(sizeof(gfloat));
+  case AGS_SOUNDCARD_DOUBLE:
+    return(sizeof(gdouble));
+  }
+
+  return(0);
+}
+
+gboolean
+ags_wave_chunk_add_buffer(AgsWave *wave,
+			  AgsBuffer *buffer)
+{
+  AgsWaveChunk *chunk;
+  
+  guint64 x;
+  guint64 offset;
+  guint samplerate;
+  guint buffer_size;
+  guint format;
+  guint word_size;
+  guint nth_chunk, nth_buffer;
+  guint i;
+  
+  GRecMutex *wave_mutex;
+  GRecMutex *buffer_mutex;
+
+  /* get wave and buffer mutex */
+  wave_mutex = AGS_WAVE_GET_OBJ_MUTEX(wave);
+  buffer_mutex = AGS_BUFFER_GET_OBJ_MUTEX(buffer);
+
+  /* get some fields */
+  g_rec_mutex_lock(buffer_mutex);
+
+  x = buffer->x;
+
+  samplerate = buffer->samplerate;
+  buffer_size = buffer->buffer_size;
+  format = buffer->format;
+  
+  g_rec_mutex_unlock(buffer_mutex);
+
+  word_size = ags_wave_chunk_word_size(format);
+  
+  /* check presets */
+  g_rec_mutex_lock(wave_mutex);
+
+  if(word_size == 0 ||
+     buffer_size == 0 ||
+     samplerate != wave->samplerate ||
+     buffer_size != wave->buffer_size ||
+     format != wave->format){
+    g_rec_mutex_unlock(wave_mutex);
+
+    return(FALSE);
+  }
+
+  if(wave->chunk_length == 0){
+    wave->chunk_offset = ags_timestamp_get_ags_offset(wave->timestamp);
+    wave->chunk_length = buffer_size * MAX(1, AGS_WAVE_DEFAULT_CHUNK_LENGTH / buffer_size);
+  }
+
+  /* unaligned buffers keep their own storage */
+  if(x < wave->chunk_offset ||
+     (x - wave->chunk_offset) % buffer_size != 0){
+    g_rec_mutex_unlock(wave_mutex);
+
+    return(FALSE);
+  }
+
+  offset = x - wave->chunk_offset;
+  
+  nth_chunk = offset / wave->chunk_length;
+  nth_buffer = (offset % wave->chunk_length) / buffer_size;
+
+  if(nth_chunk >= wave->chunk_count){
+    wave->chunk = (AgsWaveChunk **) g_renew(AgsWaveChunk *,
+					    wave->chunk,
+					    nth_chunk + 1);
+
+    for(i = wave->chunk_count; i < nth_chunk + 1; i++){
+      wave->chunk[i] = NULL;
+    }
+    
+    wave->chunk_count = nth_chunk + 1;
+  }
+
+  chunk = wave->chunk[nth_chunk];
+  
+  if(chunk == NULL){
+    chunk =
+      wave->chunk[nth_chunk] = (AgsWaveChunk *) g_new0(AgsWaveChunk,
+						       1);
+
+    chunk->data = ags_stream_alloc(wave->chunk_length,
+				   format);
+    chunk->buffer = (AgsBuffer **) g_new0(AgsBuffer *,
+					  wave->chunk_length / buffer_size);
+  }
+
+  /* already occupied */
+  if(chunk->buffer[nth_buffer] != NULL){
+    g_rec_mutex_unlock(wave_mutex);
+
+    return(FALSE);
+  }
+
+  ags_buffer_attach_data(buffer,
+			 ((guchar *) chunk->data) + (nth_buffer * buffer_size * word_size));
+
+  chunk->buffer[nth_buffer] = buffer;
+
+  g_rec_mutex_unlock(wave_mutex);
+
+  return(TRUE);
+}
+
+void
+ags_wave_chunk_remove_buffer(AgsWave *wave,
+			     AgsBuffer *buffer)
+{
+  AgsWaveChunk *chunk;
+
+  guint buffer_count;
+  guint i, j;
+  
+  GRecMutex *wave_mutex;
+
+  /* get wave mutex */
+  wave_mutex = AGS_WAVE_GET_OBJ_MUTEX(wave);
+
+  g_rec_mutex_lock(wave_mutex);
+
+  if(wave->chunk_length == 0){
+    g_rec_mutex_unlock(wave_mutex);
+
+    return;
+  }
+
+  buffer_count = wave->chunk_length / wave->buffer_size;
+  
+  for(i = 0; i < wave->chunk_count; i++){
+    chunk = wave->chunk[i];
+    
+    if(chunk == NULL){
+      continue;
+    }
+
+    for(j = 0; j < buffer_count; j++){
+      if(chunk->buffer[j] == buffer){
+	ags_buffer_detach_data(buffer);
+
+	ags_audio_buffer_util_clear_buffer(((guchar *) chunk->data) + (j * wave->buffer_size * ags_wave_chunk_word_size(wave->format)), 1,
+					   wave->buffer_size, ags_audio_buffer_util_format_from_soundcard(wave->format));
+	
+	chunk->buffer[j] = NULL;
+
+	g_rec_mutex_unlock(wave_mutex);
+
+	return;
+      }
+    }
+  }
+
+  g_rec_mutex_unlock(wave_mutex);
+}
+
+void
+ags_wave_free_chunk(AgsWave *wave)
+{
+  AgsWaveChunk *chunk;
+
+  guint buffer_count;
+  guint i, j;
+  
+  GRecMutex *wave_mutex;
+
+  /* get wave mutex */
+  wave_mutex = AGS_WAVE_GET_OBJ_MUTEX(wave);
+
+  g_rec_mutex_lock(wave_mutex);
+
+  if(wave->chunk_length == 0){
+    g_rec_mutex_unlock(wave_mutex);
+
+    return;
+  }
+
+  buffer_count = wave->chunk_length / wave->buffer_size;
+
+  for(i = 0; i < wave->chunk_count; i++){
+    chunk = wave->chunk[i];
+    
+    if(chunk == NULL){
+      continue;
+    }
+
+    for(j = 0; j < buffer_count; j++){
+      if(chunk->buffer[j] != NULL){
+	/* copy to own storage under the buffer mutex, the buffer might outlive the chunk */
+	ags_buffer_detach_data(chunk->buffer[j]);
+      }
+    }
+
+    ags_stream_free(chunk->data);
+
+    g_free(chunk->buffer);
+    g_free(chunk);
+  }
+
+  g_free(wave->chunk);
+  
+  wave->chunk_offset = 0;
+  wave->chunk_length = 0;
+
+  wave->chunk_count = 0;
+  wave->chunk = NULL;
+  
+  g_rec_mutex_unlock(wave_mutex);
+}
+
+void
+ags_wave_rechunk(AgsWave *wave)
+{
+  GList *buffer;
+  
+  GRecMutex *wave_mutex;
+
+  /* get wave mutex */
+  wave_mutex = AGS_WAVE_GET_OBJ_MUTEX(wave);
+
+  g_rec_mutex_lock(wave_mutex);
+
+  ags_wave_free_chunk(wave);
+
+  buffer = wave->buffer;
+
+  while(buffer != NULL){
+    ags_wave_chunk_add_buffer(wave,
+			      buffer->data);
+    
+    buffer = buffer->next;
+  }
+  
+  g_rec_mutex_unlock(wave_mutex);
+}
+
 /**
  * ags_wave_get_obj_mutex:
  * @wave: the #AgsWave
@@ -1175,6 +1531,8 @@ ags_wave_set_samplerate(AgsWave *wave,
   
   wave->samplerate = samplerate;
 
+  ags_wave_free_chunk(wave);
+
   start_list = g_list_copy(wave->buffer);
   
   g_rec_mutex_unlock(wave_mutex);
@@ -1369,6 +1727,8 @@ ags_wave_set_samplerate(AgsWave *wave,
   if(resampled_data != NULL){
     free(resampled_data);
   }
+
+  ags_wave_rechunk(wave);
 }
 
 /**
@@ -1451,6 +1811,8 @@ ags_wave_set_buffer_size(AgsWave *wave,
 
   format = wave->format;
   
+  ags_wave_free_chunk(wave);
+
   wave->buffer_size = buffer_size;
 
   start_list = g_list_copy(wave->buffer);
@@ -1636,6 +1998,8 @@ ags_wave_set_buffer_size(AgsWave *wave,
   if(data != NULL){
     free(data);
   }
+
+  ags_wave_rechunk(wave);
 }
 
 /**
@@ -1691,6 +2055,8 @@ ags_wave_set_format(AgsWave *wave,
   /* apply format */
   g_rec_mutex_lock(wave_mutex);
   
+  ags_wave_free_chunk(wave);
+
   wave->format = format;
 
   list =
@@ -1706,6 +2072,8 @@ ags_wave_set_format(AgsWave *wave,
   }
 
   g_list_free(list_start);
+
+  ags_wave_rechunk(wave);
 }
 
 /**
@@ -1806,8 +2174,12 @@ ags_wave_set_buffer(AgsWave *wave, GList *buffer)
     
   g_rec_mutex_lock(wave_mutex);
 
+  ags_wave_free_chunk(wave);
+  
   start_buffer = wave->buffer;
   wave->buffer = buffer;
+
+  ags_wave_rechunk(wave);
   
   g_rec_mutex_unlock(wave_mutex);
 
@@ -1815,6 +2187,54 @@ ags_wave_set_buffer(AgsWave *wave, GList *buffer)
 		   (GDestroyNotify) g_object_unref);
 }
 
+/**
+ * ags_wave_get_wave_stream:
+ * @wave: the #AgsWave
+ * 
+ * Get wave stream.
+ * 
+ * Returns: (transfer full): the #AgsWaveStream or %NULL if not streamed
+ * 
+ * Since: 3.7.0
+ */
+AgsWaveStream*
+ags_wave_get_wave_stream(AgsWave *wave)
+{
+  AgsWaveStream *wave_stream;
+
+  if(!AGS_IS_WAVE(wave)){
+    return(NULL);
+  }
+
+  g_object_get(wave,
+	       "wave-stream", &wave_stream,
+	       NULL);
+
+  return(wave_stream);
+}
+
+/**
+ * ags_wave_set_wave_stream:
+ * @wave: the #AgsWave
+ * @wave_stream: the #AgsWaveStream
+ * 
+ * Set wave stream, @wave provides the prefetched buffers of @wave_stream
+ * by ags_wave_find_point().
+ * 
+ * Since: 3.7.0
+ */
+void
+ags_wave_set_wave_stream(AgsWave *wave, AgsWaveStream *wave_stream)
+{
+  if(!AGS_IS_WAVE(wave)){
+    return;
+  }
+
+  g_object_set(wave,
+	       "wave-stream", wave_stream,
+	       NULL);
+}
+
 /**
  * ags_wave_add:
  * @wave: (element-type AgsAudio.Wave) (transfer none): the #GList-struct containing #AgsWave
@@ -1882,6 +2302,9 @@ ags_wave_add_buffer(AgsWave *wave,
     wave->buffer = g_list_insert_sorted(wave->buffer,
 					buffer,
 					(GCompareFunc) ags_buffer_sort_func);
+
+    ags_wave_chunk_add_buffer(wave,
+			      buffer);
   }
 
   g_rec_mutex_unlock(wave_mutex);
@@ -1918,6 +2341,9 @@ ags_wave_remove_buffer(AgsWave *wave,
   if(!use_selection_list){
     if(g_list_find(wave->buffer,
 		   buffer) != NULL){
+      ags_wave_chunk_remove_buffer(wave,
+				   buffer);
+      
       wave->buffer = g_list_remove(wave->buffer,
 				   buffer);
       g_object_unref(buffer);
@@ -2072,7 +2498,40 @@ ags_wave_find_point(AgsWave *wave,
   /* find buffer */
   g_rec_mutex_lock(wave_mutex);
 
+  /* streamed wave */
+  if(!use_selection_list &&
+     wave->wave_stream != NULL){
+    retval = ags_wave_stream_find_point(wave->wave_stream,
+					x);
+    
+    g_rec_mutex_unlock(wave_mutex);
+
+    return(retval);
+  }
+  
   buffer_size = wave->buffer_size;
+
+  /* chunked buffer */
+  if(!use_selection_list &&
+     wave->chunk_length != 0 &&
+     x >= wave->chunk_offset &&
+     (x - wave->chunk_offset) / wave->chunk_length < wave->chunk_count){
+    AgsWaveChunk *chunk;
+
+    chunk = wave->chunk[(x - wave->chunk_offset) / wave->chunk_length];
+
+    if(chunk != NULL){
+      retval = chunk->buffer[((x - wave->chunk_offset) % wave->chunk_length) / buffer_size];
+
+      if(retval != NULL &&
+	 retval->x <= x &&
+	 retval->x + buffer_size > x){
+	g_rec_mutex_unlock(wave_mutex);
+
+	return(retval);
+      }
+    }
+  }
   
   if(use_selection_list){
     buffer = wave->selection;
@@ -2163,6 +2622,115 @@ ags_wave_find_point(AgsWave *wave,
   return(retval);
 }
 
+/**
+ * ags_wave_find_data:
+ * @wave: the #AgsWave
+ * @x: offset
+ * @frame_count: (out): return location of the frame count available
+ *
+ * Find the contiguous audio data of @wave starting at @x. The returned data
+ * is in @wave's format and spans all buffers following @x within the same chunk,
+ * so a whole range is copied at once.
+ *
+ * The data is only valid as long as the caller holds the obj mutex of @wave,
+ * so lock it before calling and keep it locked until the data is copied.
+ *
+ * Returns: (transfer none): the data or %NULL if @x is not in chunk storage
+ *
+ * Since: 3.7.0
+ */
+gpointer
+ags_wave_find_data(AgsWave *wave,
+		   guint64 x,
+		   guint *frame_count)
+{
+  AgsWaveChunk *chunk;
+  
+  gpointer retval;
+
+  guint64 offset;
+  guint64 buffer_x;
+  guint buffer_size;
+  guint buffer_count;
+  guint word_size;
+  guint nth_chunk, nth_buffer;
+  guint i;
+  
+  GRecMutex *wave_mutex;
+
+  if(frame_count != NULL){
+    frame_count[0] = 0;
+  }
+  
+  if(!AGS_IS_WAVE(wave)){
+    return(NULL);
+  }
+
+  /* get wave mutex */
+  wave_mutex = AGS_WAVE_GET_OBJ_MUTEX(wave);
+
+  /* find chunk */
+  g_rec_mutex_lock(wave_mutex);
+
+  if(wave->wave_stream != NULL ||
+     wave->chunk_length == 0 ||
+     x < wave->chunk_offset ||
+     (x - wave->chunk_offset) / wave->chunk_length >= wave->chunk_count){
+    g_rec_mutex_unlock(wave_mutex);
+
+    return(NULL);
+  }
+
+  buffer_size = wave->buffer_size;
+  buffer_count = wave->chunk_length / buffer_size;
+
+  word_size = ags_wave_chunk_word_size(wave->format);
+
+  offset = x - wave->chunk_offset;
+
+  nth_chunk = offset / wave->chunk_length;
+  nth_buffer = (offset % wave->chunk_length) / buffer_size;
+
+  chunk = wave->chunk[nth_chunk];
+
+  if(chunk == NULL){
+    g_rec_mutex_unlock(wave_mutex);
+
+    return(NULL);
+  }
+
+  /* count the buffers still viewing the chunk */
+  for(i = nth_buffer; i < buffer_count; i++){
+    AgsBuffer *buffer;
+
+    buffer = chunk->buffer[i];
+    buffer_x = wave->chunk_offset + (guint64) nth_chunk * wave->chunk_length + (guint64) i * buffer_size;
+    
+    if(buffer == NULL ||
+       (AGS_BUFFER_VIEW & (buffer->flags)) == 0 ||
+       buffer->x != buffer_x ||
+       buffer->data != (gpointer) (((guchar *) chunk->data) + (i * buffer_size * word_size))){
+      break;
+    }
+  }
+
+  if(i == nth_buffer){
+    g_rec_mutex_unlock(wave_mutex);
+
+    return(NULL);
+  }
+
+  retval = ((guchar *) chunk->data) + ((offset % wave->chunk_length) * word_size);
+
+  if(frame_count != NULL){
+    frame_count[0] = (i * buffer_size) - (offset % wave->chunk_length);
+  }
+  
+  g_rec_mutex_unlock(wave_mutex);
+
+  return(retval);
+}
+
 /**
  * ags_wave_find_region:
  * @wave: the #AgsWave
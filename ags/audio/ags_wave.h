@@ -28,6 +28,7 @@
 #include <ags/libags.h>
 
 #include <ags/audio/ags_buffer.h>
+#include <ags/audio/ags_wave_stream.h>
 
 G_BEGIN_DECLS
 
@@ -52,12 +53,15 @@ G_BEGIN_DECLS
 #define AGS_WAVE_DEFAULT_DURATION (AGS_WAVE_DEFAULT_LENGTH * AGS_WAVE_DEFAULT_JIFFIE * AGS_USEC_PER_SEC)
 #define AGS_WAVE_DEFAULT_OFFSET (AGS_WAVE_DEFAULT_BUFFER_LENGTH * AGS_SOUNDCARD_DEFAULT_SAMPLERATE)
 
+#define AGS_WAVE_DEFAULT_CHUNK_LENGTH (65536)
+
 #define AGS_WAVE_CLIPBOARD_VERSION "1.4.0"
 #define AGS_WAVE_CLIPBOARD_TYPE "AgsWaveClipboardXml"
 #define AGS_WAVE_CLIPBOARD_FORMAT "AgsWaveNativeLevel"
 
 typedef struct _AgsWave AgsWave;
 typedef struct _AgsWaveClass AgsWaveClass;
+typedef struct _AgsWaveChunk AgsWaveChunk;
 
 /**
  * AgsWaveFlags:
@@ -70,6 +74,20 @@ typedef enum{
   AGS_WAVE_BYPASS            = 1,
 }AgsWaveFlags;
 
+/**
+ * AgsWaveChunk:
+ * @data: the contiguous audio data of chunk length frames
+ * @buffer: the #AgsBuffer viewing @data, one per buffer size frames
+ * 
+ * Contiguous storage of #AgsWave, the #AgsBuffer added to the wave are
+ * views into it.
+ */
+struct _AgsWaveChunk
+{
+  gpointer data;
+  AgsBuffer **buffer;
+};
+
 struct _AgsWave
 {
   GObject gobject;
@@ -91,6 +109,14 @@ struct _AgsWave
   
   GList *buffer;
   GList *selection;
+
+  guint64 chunk_offset;
+  guint chunk_length;
+  
+  guint chunk_count;
+  AgsWaveChunk **chunk;
+  
+  AgsWaveStream *wave_stream;
 };
 
 struct _AgsWaveClass
@@ -140,6 +166,10 @@ GList* ags_wave_get_buffer(AgsWave *wave);
 void ags_wave_set_buffer(AgsWave *wave,
 			 GList *buffer);
 
+AgsWaveStream* ags_wave_get_wave_stream(AgsWave *wave);
+void ags_wave_set_wave_stream(AgsWave *wave,
+			      AgsWaveStream *wave_stream);
+
 GList* ags_wave_add(GList *wave,
 		    AgsWave *new_wave);
 
@@ -157,6 +187,9 @@ gboolean ags_wave_is_buffer_selected(AgsWave *wave, AgsBuffer *buffer);
 AgsBuffer* ags_wave_find_point(AgsWave *wave,
 			       guint64 x,
 			       gboolean use_selection_list);
+gpointer ags_wave_find_data(AgsWave *wave,
+			    guint64 x,
+			    guint *frame_count);
 GList* ags_wave_find_region(AgsWave *wave,
 			    guint64 x0,
 			    guint64 x1,
@@ -0,0 +1,1078 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ags/audio/ags_wave_stream.h>
+
+#include <ags/audio/ags_audio_signal.h>
+#include <ags/audio/ags_audio_buffer_util.h>
+
+#include <ags/audio/file/ags_audio_file.h>
+#include <ags/audio/file/ags_sound_resource.h>
+
+#include <math.h>
+
+#include <ags/i18n.h>
+
+void ags_wave_stream_class_init(AgsWaveStreamClass *wave_stream);
+void ags_wave_stream_init(AgsWaveStream *wave_stream);
+void ags_wave_stream_set_property(GObject *gobject,
+				  guint prop_id,
+				  const GValue *value,
+				  GParamSpec *param_spec);
+void ags_wave_stream_get_property(GObject *gobject,
+				  guint prop_id,
+				  GValue *value,
+				  GParamSpec *param_spec);
+void ags_wave_stream_finalize(GObject *gobject);
+
+void ags_wave_stream_open(AgsWaveStream *wave_stream);
+void ags_wave_stream_request_seek(AgsWaveStream *wave_stream,
+				  guint index);
+void ags_wave_stream_read_buffer(AgsWaveStream *wave_stream,
+				 AgsBuffer *buffer);
+
+/**
+ * SECTION:ags_wave_stream
+ * @short_description: stream a file region as wave
+ * @title: AgsWaveStream
+ * @section_id:
+ * @include: ags/audio/ags_wave_stream.h
+ *
+ * #AgsWaveStream references one audio channel of a file region and keeps only
+ * the buffers just ahead of the playback cursor in memory.
+ *
+ * The ring of #AgsBuffer is filled by a single prefetch thread calling
+ * ags_wave_stream_prefetch() and consumed by the audio thread calling
+ * ags_wave_stream_find_point(). Both sides move the ring positions with atomic
+ * operations, so the consumer never waits for file I/O. A seek increments the
+ * generation and the prefetch thread refills the ring at the requested position.
+ */
+
+enum{
+  PROP_0,
+  PROP_FILENAME,
+  PROP_AUDIO_CHANNEL,
+  PROP_X_OFFSET,
+  PROP_FRAME_COUNT,
+  PROP_SAMPLERATE,
+  PROP_BUFFER_SIZE,
+  PROP_FORMAT,
+};
+
+static gpointer ags_wave_stream_parent_class = NULL;
+
+GType
+ags_wave_stream_get_type()
+{
+  static volatile gsize g_define_type_id__volatile = 0;
+
+  if(g_once_init_enter (&g_define_type_id__volatile)){
+    GType ags_type_wave_stream = 0;
+
+    static const GTypeInfo ags_wave_stream_info = {
+      sizeof(AgsWaveStreamClass),
+      NULL,
+      NULL,
+      (GClassInitFunc) ags_wave_stream_class_init,
+      NULL,
+      NULL,
+      sizeof(AgsWaveStream),
+      0,
+      (GInstanceInitFunc) ags_wave_stream_init,
+    };
+
+    ags_type_wave_stream = g_type_register_static(G_TYPE_OBJECT,
+						  "AgsWaveStream",
+						  &ags_wave_stream_info,
+						  0);
+
+    g_once_init_leave(&g_define_type_id__volatile, ags_type_wave_stream);
+  }
+
+  return g_define_type_id__volatile;
+}
+
+void
+ags_wave_stream_class_init(AgsWaveStreamClass *wave_stream)
+{
+  GObjectClass *gobject;
+
+  GParamSpec *param_spec;
+
+  ags_wave_stream_parent_class = g_type_class_peek_parent(wave_stream);
+
+  /* GObjectClass */
+  gobject = (GObjectClass *) wave_stream;
+
+  gobject->set_property = ags_wave_stream_set_property;
+  gobject->get_property = ags_wave_stream_get_property;
+
+  gobject->finalize = ags_wave_stream_finalize;
+
+  /* properties */
+  /**
+   * AgsWaveStream:filename:
+   *
+   * The file to stream from.
+   *
+   * Since: 3.7.0
+   */
+  param_spec = g_param_spec_string("filename",
+				   i18n_pspec("filename"),
+				   i18n_pspec("The filename to stream from"),
+				   NULL,
+				   G_PARAM_READABLE | G_PARAM_WRITABLE);
+  g_object_class_install_property(gobject,
+				  PROP_FILENAME,
+				  param_spec);
+
+  /**
+   * AgsWaveStream:audio-channel:
+   *
+   * The audio channel of the file to stream.
+   *
+   * Since: 3.7.0
+   */
+  param_spec = g_param_spec_uint("audio-channel",
+				 i18n_pspec("audio channel"),
+				 i18n_pspec("The audio channel of the file"),
+				 0,
+				 G_MAXUINT32,
+				 0,
+				 G_PARAM_READABLE | G_PARAM_WRITABLE);
+  g_object_class_install_property(gobject,
+				  PROP_AUDIO_CHANNEL,
+				  param_spec);
+
+  /**
+   * AgsWaveStream:x-offset:
+   *
+   * The x offset the region starts at.
+   *
+   * Since: 3.7.0
+   */
+  param_spec = g_param_spec_uint64("x-offset",
+				   i18n_pspec("x offset"),
+				   i18n_pspec("The x offset the region starts at"),
+				   0,
+				   G_MAXUINT64,
+				   0,
+				   G_PARAM_READABLE | G_PARAM_WRITABLE);
+  g_object_class_install_property(gobject,
+				  PROP_X_OFFSET,
+				  param_spec);
+
+  /**
+   * AgsWaveStream:frame-count:
+   *
+   * The frame count of the region at the stream's samplerate.
+   *
+   * Since: 3.7.0
+   */
+  param_spec = g_param_spec_uint64("frame-count",
+				   i18n_pspec("frame count"),
+				   i18n_pspec("The frame count of the region"),
+				   0,
+				   G_MAXUINT64,
+				   0,
+				   G_PARAM_READABLE | G_PARAM_WRITABLE);
+  g_object_class_install_property(gobject,
+				  PROP_FRAME_COUNT,
+				  param_spec);
+
+  /**
+   * AgsWaveStream:samplerate:
+   *
+   * The samplerate of the buffers.
+   *
+   * Since: 3.7.0
+   */
+  param_spec = g_param_spec_uint("samplerate",
+				 i18n_pspec("samplerate"),
+				 i18n_pspec("The samplerate of the buffers"),
+				 0,
+				 G_MAXUINT32,
+				 0,
+				 G_PARAM_READABLE | G_PARAM_WRITABLE);
+  g_object_class_install_property(gobject,
+				  PROP_SAMPLERATE,
+				  param_spec);
+
+  /**
+   * AgsWaveStream:buffer-size:
+   *
+   * The buffer size of the buffers.
+   *
+   * Since: 3.7.0
+   */
+  param_spec = g_param_spec_uint("buffer-size",
+				 i18n_pspec("buffer size"),
+				 i18n_pspec("The buffer size of the buffers"),
+				 0,
+				 G_MAXUINT32,
+				 0,
+				 G_PARAM_READABLE | G_PARAM_WRITABLE);
+  g_object_class_install_property(gobject,
+				  PROP_BUFFER_SIZE,
+				  param_spec);
+
+  /**
+   * AgsWaveStream:format:
+   *
+   * The format of the buffers.
+   *
+   * Since: 3.7.0
+   */
+  param_spec = g_param_spec_uint("format",
+				 i18n_pspec("format"),
+				 i18n_pspec("The format of the buffers"),
+				 0,
+				 G_MAXUINT32,
+				 0,
+				 G_PARAM_READABLE | G_PARAM_WRITABLE);
+  g_object_class_install_property(gobject,
+				  PROP_FORMAT,
+				  param_spec);
+}
+
+void
+ags_wave_stream_init(AgsWaveStream *wave_stream)
+{
+  AgsConfig *config;
+
+  wave_stream->flags = 0;
+
+  /* wave stream mutex */
+  g_rec_mutex_init(&(wave_stream->obj_mutex));
+
+  /* config */
+  config = ags_config_get_instance();
+
+  /* fields */
+  wave_stream->filename = NULL;
+  wave_stream->audio_channel = 0;
+
+  wave_stream->x_offset = 0;
+  wave_stream->frame_count = 0;
+
+  wave_stream->samplerate = (guint) ags_soundcard_helper_config_get_samplerate(config);
+  wave_stream->buffer_size = (guint) ags_soundcard_helper_config_get_buffer_size(config);
+  wave_stream->format = (guint) ags_soundcard_helper_config_get_format(config);
+
+  wave_stream->audio_file = NULL;
+
+  wave_stream->file_samplerate = 0;
+  wave_stream->file_offset = 0;
+
+  wave_stream->resampler = NULL;
+
+  wave_stream->file_data = NULL;
+  wave_stream->file_data_length = 0;
+  wave_stream->resample_data = NULL;
+
+  wave_stream->fill_generation = 0;
+  wave_stream->fill_index = 0;
+
+  wave_stream->ring_length = 0;
+  wave_stream->ring = NULL;
+  wave_stream->ring_generation = NULL;
+  wave_stream->ring_index = NULL;
+
+  wave_stream->read_position = 0;
+  wave_stream->write_position = 0;
+
+  wave_stream->pin_slot = 0;
+
+  wave_stream->generation = 0;
+  wave_stream->seek_index = 0;
+  wave_stream->fill_position = 0;
+}
+
+void
+ags_wave_stream_set_property(GObject *gobject,
+			     guint prop_id,
+			     const GValue *value,
+			     GParamSpec *param_spec)
+{
+  AgsWaveStream *wave_stream;
+
+  GRecMutex *wave_stream_mutex;
+
+  wave_stream = AGS_WAVE_STREAM(gobject);
+
+  /* get wave stream mutex */
+  wave_stream_mutex = AGS_WAVE_STREAM_GET_OBJ_MUTEX(wave_stream);
+
+  switch(prop_id){
+  case PROP_FILENAME:
+    {
+      gchar *filename;
+
+      filename = g_value_get_string(value);
+
+      g_rec_mutex_lock(wave_stream_mutex);
+
+      if(wave_stream->filename == filename){
+	g_rec_mutex_unlock(wave_stream_mutex);
+
+	return;
+      }
+
+      g_free(wave_stream->filename);
+
+      wave_stream->filename = g_strdup(filename);
+
+      g_rec_mutex_unlock(wave_stream_mutex);
+    }
+    break;
+  case PROP_AUDIO_CHANNEL:
+    {
+      g_rec_mutex_lock(wave_stream_mutex);
+
+      wave_stream->audio_channel = g_value_get_uint(value);
+
+      g_rec_mutex_unlock(wave_stream_mutex);
+    }
+    break;
+  case PROP_X_OFFSET:
+    {
+      g_rec_mutex_lock(wave_stream_mutex);
+
+      wave_stream->x_offset = g_value_get_uint64(value);
+
+      g_rec_mutex_unlock(wave_stream_mutex);
+    }
+    break;
+  case PROP_FRAME_COUNT:
+    {
+      g_rec_mutex_lock(wave_stream_mutex);
+
+      wave_stream->frame_count = g_value_get_uint64(value);
+
+      g_rec_mutex_unlock(wave_stream_mutex);
+    }
+    break;
+  case PROP_SAMPLERATE:
+    {
+      g_rec_mutex_lock(wave_stream_mutex);
+
+      if((AGS_WAVE_STREAM_OPENED & (wave_stream->flags)) == 0){
+	wave_stream->samplerate = g_value_get_uint(value);
+      }
+
+      g_rec_mutex_unlock(wave_stream_mutex);
+    }
+    break;
+  case PROP_BUFFER_SIZE:
+    {
+      g_rec_mutex_lock(wave_stream_mutex);
+
+      if((AGS_WAVE_STREAM_OPENED & (wave_stream->flags)) == 0){
+	wave_stream->buffer_size = g_value_get_uint(value);
+      }
+
+      g_rec_mutex_unlock(wave_stream_mutex);
+    }
+    break;
+  case PROP_FORMAT:
+    {
+      g_rec_mutex_lock(wave_stream_mutex);
+
+      if((AGS_WAVE_STREAM_OPENED & (wave_stream->flags)) == 0){
+	wave_stream->format = g_value_get_uint(value);
+      }
+
+      g_rec_mutex_unlock(wave_stream_mutex);
+    }
+    break;
+  default:
+    G_OBJECT_WARN_INVALID_PROPERTY_ID(gobject, prop_id, param_spec);
+    break;
+  }
+}
+
+void
+ags_wave_stream_get_property(GObject *gobject,
+			     guint prop_id,
+			     GValue *value,
+			     GParamSpec *param_spec)
+{
+  AgsWaveStream *wave_stream;
+
+  GRecMutex *wave_stream_mutex;
+
+  wave_stream = AGS_WAVE_STREAM(gobject);
+
+  /* get wave stream mutex */
+  wave_stream_mutex = AGS_WAVE_STREAM_GET_OBJ_MUTEX(wave_stream);
+
+  switch(prop_id){
+  case PROP_FILENAME:
+    {
+      g_rec_mutex_lock(wave_stream_mutex);
+
+      g_value_set_string(value, wave_stream->filename);
+
+      g_rec_mutex_unlock(wave_stream_mutex);
+    }
+    break;
+  case PROP_AUDIO_CHANNEL:
+    {
+      g_rec_mutex_lock(wave_stream_mutex);
+
+      g_value_set_uint(value, wave_stream->audio_channel);
+
+      g_rec_mutex_unlock(wave_stream_mutex);
+    }
+    break;
+  case PROP_X_OFFSET:
+    {
+      g_rec_mutex_lock(wave_stream_mutex);
+
+      g_value_set_uint64(value, wave_stream->x_offset);
+
+      g_rec_mutex_unlock(wave_stream_mutex);
+    }
+    break;
+  case PROP_FRAME_COUNT:
+    {
+      g_rec_mutex_lock(wave_stream_mutex);
+
+      g_value_set_uint64(value, wave_stream->frame_count);
+
+      g_rec_mutex_unlock(wave_stream_mutex);
+    }
+    break;
+  case PROP_SAMPLERATE:
+    {
+      g_rec_mutex_lock(wave_stream_mutex);
+
+      g_value_set_uint(value, wave_stream->samplerate);
+
+      g_rec_mutex_unlock(wave_stream_mutex);
+    }
+    break;
+  case PROP_BUFFER_SIZE:
+    {
+      g_rec_mutex_lock(wave_stream_mutex);
+
+      g_value_set_uint(value, wave_stream->buffer_size);
+
+      g_rec_mutex_unlock(wave_stream_mutex);
+    }
+    break;
+  case PROP_FORMAT:
+    {
+      g_rec_mutex_lock(wave_stream_mutex);
+
+      g_value_set_uint(value, wave_stream->format);
+
+      g_rec_mutex_unlock(wave_stream_mutex);
+    }
+    break;
+  default:
+    G_OBJECT_WARN_INVALID_PROPERTY_ID(gobject, prop_id, param_spec);
+    break;
+  }
+}
+
+void
+ags_wave_stream_finalize(GObject *gobject)
+{
+  AgsWaveStream *wave_stream;
+
+  guint i;
+
+  wave_stream = AGS_WAVE_STREAM(gobject);
+
+  g_free(wave_stream->filename);
+
+  if(wave_stream->audio_file != NULL){
+    ags_audio_file_close(AGS_AUDIO_FILE(wave_stream->audio_file));
+
+    g_object_unref(wave_stream->audio_file);
+  }
+
+  if(wave_stream->resampler != NULL){
+    g_object_unref(wave_stream->resampler);
+  }
+
+  g_free(wave_stream->file_data);
+  g_free(wave_stream->resample_data);
+
+  /* ring */
+  for(i = 0; i < wave_stream->ring_length; i++){
+    g_object_unref(wave_stream->ring[i]);
+  }
+
+  g_free(wave_stream->ring);
+  g_free(wave_stream->ring_generation);
+  g_free(wave_stream->ring_index);
+
+  /* call parent */
+  G_OBJECT_CLASS(ags_wave_stream_parent_class)->finalize(gobject);
+}
+
+/**
+ * ags_wave_stream_test_flags:
+ * @wave_stream: the #AgsWaveStream
+ * @flags: the flags
+ *
+ * Test @flags to be set on @wave_stream.
+ *
+ * Returns: %TRUE if flags are set, else %FALSE
+ *
+ * Since: 3.7.0
+ */
+gboolean
+ags_wave_stream_test_flags(AgsWaveStream *wave_stream, guint flags)
+{
+  gboolean retval;
+
+  GRecMutex *wave_stream_mutex;
+
+  if(!AGS_IS_WAVE_STREAM(wave_stream)){
+    return(FALSE);
+  }
+
+  /* get wave stream mutex */
+  wave_stream_mutex = AGS_WAVE_STREAM_GET_OBJ_MUTEX(wave_stream);
+
+  /* test */
+  g_rec_mutex_lock(wave_stream_mutex);
+
+  retval = (flags & (wave_stream->flags)) ? TRUE: FALSE;
+
+  g_rec_mutex_unlock(wave_stream_mutex);
+
+  return(retval);
+}
+
+/**
+ * ags_wave_stream_set_flags:
+ * @wave_stream: the #AgsWaveStream
+ * @flags: see #AgsWaveStreamFlags-enum
+ *
+ * Enable a feature of @wave_stream.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_wave_stream_set_flags(AgsWaveStream *wave_stream, guint flags)
+{
+  GRecMutex *wave_stream_mutex;
+
+  if(!AGS_IS_WAVE_STREAM(wave_stream)){
+    return;
+  }
+
+  /* get wave stream mutex */
+  wave_stream_mutex = AGS_WAVE_STREAM_GET_OBJ_MUTEX(wave_stream);
+
+  /* set flags */
+  g_rec_mutex_lock(wave_stream_mutex);
+
+  wave_stream->flags |= flags;
+
+  g_rec_mutex_unlock(wave_stream_mutex);
+}
+
+/**
+ * ags_wave_stream_unset_flags:
+ * @wave_stream: the #AgsWaveStream
+ * @flags: see #AgsWaveStreamFlags-enum
+ *
+ * Disable a feature of @wave_stream.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_wave_stream_unset_flags(AgsWaveStream *wave_stream, guint flags)
+{
+  GRecMutex *wave_stream_mutex;
+
+  if(!AGS_IS_WAVE_STREAM(wave_stream)){
+    return;
+  }
+
+  /* get wave stream mutex */
+  wave_stream_mutex = AGS_WAVE_STREAM_GET_OBJ_MUTEX(wave_stream);
+
+  /* unset flags */
+  g_rec_mutex_lock(wave_stream_mutex);
+
+  wave_stream->flags &= (~flags);
+
+  g_rec_mutex_unlock(wave_stream_mutex);
+}
+
+void
+ags_wave_stream_open(AgsWaveStream *wave_stream)
+{
+  AgsAudioFile *audio_file;
+
+  guint file_samplerate;
+  guint i;
+
+  wave_stream->flags |= AGS_WAVE_STREAM_OPENED;
+
+  if(wave_stream->filename == NULL ||
+     wave_stream->buffer_size == 0){
+    return;
+  }
+
+  audio_file = ags_audio_file_new(wave_stream->filename,
+				  NULL,
+				  wave_stream->audio_channel);
+
+  if(!ags_audio_file_open(audio_file)){
+    g_warning("ags_wave_stream_open() - failed to open %s", wave_stream->filename);
+
+    g_object_unref(audio_file);
+
+    return;
+  }
+
+  file_samplerate = wave_stream->samplerate;
+
+  ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(audio_file->sound_resource),
+				 NULL,
+				 &file_samplerate,
+				 NULL,
+				 NULL);
+
+  wave_stream->audio_file = (GObject *) audio_file;
+  wave_stream->file_samplerate = file_samplerate;
+
+  if(file_samplerate != wave_stream->samplerate){
+    wave_stream->resampler = ags_resampler_new(1,
+					       file_samplerate,
+					       wave_stream->samplerate,
+					       AGS_RESAMPLER_DEFAULT_QUALITY);
+
+    wave_stream->file_data_length = (guint) ceil((gdouble) wave_stream->buffer_size * (gdouble) file_samplerate / (gdouble) wave_stream->samplerate);
+
+    wave_stream->file_data = (gfloat *) g_malloc(wave_stream->file_data_length * sizeof(gfloat));
+    wave_stream->resample_data = (gfloat *) g_malloc(wave_stream->buffer_size * sizeof(gfloat));
+  }
+
+  /* ring covering the prefetch time */
+  wave_stream->ring_length = (guint) ceil(AGS_WAVE_STREAM_DEFAULT_PREFETCH_TIME * (gdouble) wave_stream->samplerate / (gdouble) wave_stream->buffer_size);
+
+  if(wave_stream->ring_length < 2){
+    wave_stream->ring_length = 2;
+  }
+
+  wave_stream->ring = (AgsBuffer **) g_malloc(wave_stream->ring_length * sizeof(AgsBuffer *));
+  wave_stream->ring_generation = (guint *) g_malloc0(wave_stream->ring_length * sizeof(guint));
+  wave_stream->ring_index = (guint *) g_malloc0(wave_stream->ring_length * sizeof(guint));
+
+  for(i = 0; i < wave_stream->ring_length; i++){
+    wave_stream->ring[i] = ags_buffer_new();
+    g_object_set(wave_stream->ring[i],
+		 "samplerate", wave_stream->samplerate,
+		 "buffer-size", wave_stream->buffer_size,
+		 "format", wave_stream->format,
+		 NULL);
+  }
+}
+
+void
+ags_wave_stream_request_seek(AgsWaveStream *wave_stream,
+			     guint index)
+{
+  g_atomic_int_set(&(wave_stream->seek_index),
+		   index);
+  g_atomic_int_inc(&(wave_stream->generation));
+}
+
+void
+ags_wave_stream_read_buffer(AgsWaveStream *wave_stream,
+			    AgsBuffer *buffer)
+{
+  AgsSoundResource *sound_resource;
+
+  guint num_read;
+  guint written;
+
+  sound_resource = AGS_SOUND_RESOURCE(AGS_AUDIO_FILE(wave_stream->audio_file)->sound_resource);
+
+  ags_audio_buffer_util_clear_buffer(buffer->data, 1,
+				     wave_stream->buffer_size, ags_audio_buffer_util_format_from_soundcard(wave_stream->format));
+
+  if(wave_stream->resampler == NULL){
+    ags_sound_resource_seek(sound_resource,
+			    wave_stream->file_offset, G_SEEK_SET);
+
+    num_read = ags_sound_resource_read(sound_resource,
+				       buffer->data, 1,
+				       wave_stream->audio_channel,
+				       wave_stream->buffer_size, wave_stream->format);
+
+    wave_stream->file_offset += num_read;
+
+    return;
+  }
+
+  /* resample - the resampler keeps unconsumed input for the next buffer */
+  ags_audio_buffer_util_clear_float(wave_stream->resample_data, 1,
+				    wave_stream->buffer_size);
+
+  written = 0;
+
+  while(written < wave_stream->buffer_size){
+    ags_audio_buffer_util_clear_float(wave_stream->file_data, 1,
+				      wave_stream->file_data_length);
+
+    ags_sound_resource_seek(sound_resource,
+			    wave_stream->file_offset, G_SEEK_SET);
+
+    num_read = ags_sound_resource_read(sound_resource,
+				       wave_stream->file_data, 1,
+				       wave_stream->audio_channel,
+				       wave_stream->file_data_length, AGS_SOUNDCARD_FLOAT);
+
+    wave_stream->file_offset += num_read;
+
+    written += ags_resampler_process(wave_stream->resampler,
+				     wave_stream->file_data, AGS_AUDIO_BUFFER_UTIL_FLOAT,
+				     num_read,
+				     wave_stream->resample_data + written, AGS_AUDIO_BUFFER_UTIL_FLOAT,
+				     wave_stream->buffer_size - written,
+				     ((num_read == 0) ? TRUE: FALSE));
+
+    if(num_read == 0){
+      break;
+    }
+  }
+
+  ags_audio_buffer_util_copy_buffer_to_buffer(buffer->data, 1, 0,
+					      wave_stream->resample_data, 1, 0,
+					      wave_stream->buffer_size, ags_audio_buffer_util_get_copy_mode(ags_audio_buffer_util_format_from_soundcard(wave_stream->format),
+													    AGS_AUDIO_BUFFER_UTIL_FLOAT));
+}
+
+/**
+ * ags_wave_stream_find_point:
+ * @wave_stream: the #AgsWaveStream
+ * @x: the x offset
+ *
+ * Find the prefetched buffer containing @x. This function doesn't block and is
+ * meant to be called by the audio thread, buffers older than @x are released to
+ * the prefetch thread. If @x was not prefetched, prefetching is restarted at @x.
+ *
+ * The returned buffer is pinned and not refilled by the prefetch thread until
+ * the next call of this function, even if a seek releases it.
+ *
+ * Returns: (transfer none): the #AgsBuffer or %NULL if not available
+ *
+ * Since: 3.7.0
+ */
+AgsBuffer*
+ags_wave_stream_find_point(AgsWaveStream *wave_stream,
+			   guint64 x)
+{
+  AgsBuffer *retval;
+
+  guint generation;
+  guint index;
+  guint read_position, write_position;
+  guint fill_position;
+  guint slot;
+
+  if(!AGS_IS_WAVE_STREAM(wave_stream)){
+    return(NULL);
+  }
+
+  /* region and buffer size don't change after the stream was opened */
+  if(wave_stream->ring_length == 0 ||
+     x < wave_stream->x_offset ||
+     x >= wave_stream->x_offset + wave_stream->frame_count){
+    return(NULL);
+  }
+
+  retval = NULL;
+
+  /* the buffer returned by the previous call is done */
+  g_atomic_int_set(&(wave_stream->pin_slot),
+		   0);
+
+  index = (guint) ((x - wave_stream->x_offset) / wave_stream->buffer_size);
+
+  generation = g_atomic_int_get(&(wave_stream->generation));
+
+  read_position = g_atomic_int_get(&(wave_stream->read_position));
+  write_position = g_atomic_int_get(&(wave_stream->write_position));
+
+  /* release buffers behind the cursor or of a previous seek */
+  while(read_position != write_position){
+    slot = read_position % wave_stream->ring_length;
+
+    if(wave_stream->ring_generation[slot] == generation &&
+       wave_stream->ring_index[slot] >= index){
+      if(wave_stream->ring_index[slot] == index){
+	retval = wave_stream->ring[slot];
+      }
+
+      break;
+    }
+
+    if(g_atomic_int_compare_and_exchange(&(wave_stream->read_position), read_position, read_position + 1)){
+      read_position++;
+    }else{
+      read_position = g_atomic_int_get(&(wave_stream->read_position));
+    }
+  }
+
+  /* pin, then check the prefetch thread didn't reclaim the slot meanwhile */
+  if(retval != NULL){
+    g_atomic_int_set(&(wave_stream->pin_slot),
+		     slot + 1);
+
+    if(g_atomic_int_get(&(wave_stream->read_position)) != read_position){
+      g_atomic_int_set(&(wave_stream->pin_slot),
+		       0);
+
+      retval = NULL;
+    }
+  }
+
+  /* restart prefetch if the cursor jumped */
+  if(retval == NULL &&
+     g_atomic_int_get(&(wave_stream->seek_index)) != index){
+    fill_position = g_atomic_int_get(&(wave_stream->fill_position));
+
+    if(read_position != write_position ||
+       fill_position > index ||
+       index >= fill_position + wave_stream->ring_length){
+      ags_wave_stream_request_seek(wave_stream,
+				   index);
+    }
+  }
+
+  return(retval);
+}
+
+/**
+ * ags_wave_stream_seek:
+ * @wave_stream: the #AgsWaveStream
+ * @x: the x offset
+ *
+ * Drop the prefetched buffers and let the prefetch thread continue at @x.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_wave_stream_seek(AgsWaveStream *wave_stream,
+		     guint64 x)
+{
+  guint64 x_offset;
+  guint buffer_size;
+
+  GRecMutex *wave_stream_mutex;
+
+  if(!AGS_IS_WAVE_STREAM(wave_stream)){
+    return;
+  }
+
+  /* get wave stream mutex */
+  wave_stream_mutex = AGS_WAVE_STREAM_GET_OBJ_MUTEX(wave_stream);
+
+  g_rec_mutex_lock(wave_stream_mutex);
+
+  x_offset = wave_stream->x_offset;
+  buffer_size = wave_stream->buffer_size;
+
+  g_rec_mutex_unlock(wave_stream_mutex);
+
+  if(buffer_size == 0){
+    return;
+  }
+
+  ags_wave_stream_request_seek(wave_stream,
+			       ((x > x_offset) ? (guint) ((x - x_offset) / buffer_size): 0));
+}
+
+/**
+ * ags_wave_stream_prefetch:
+ * @wave_stream: the #AgsWaveStream
+ *
+ * Fill the free buffers of @wave_stream's ring from file. Only one thread
+ * should call this function. Filling stops at the buffer pinned by
+ * ags_wave_stream_find_point().
+ *
+ * Returns: the count of buffers filled
+ *
+ * Since: 3.7.0
+ */
+guint
+ags_wave_stream_prefetch(AgsWaveStream *wave_stream)
+{
+  AgsBuffer *buffer;
+
+  guint generation;
+  guint seek_index;
+  guint read_position, write_position;
+  guint slot;
+  guint count;
+
+  GRecMutex *wave_stream_mutex;
+  GRecMutex *buffer_mutex;
+
+  if(!AGS_IS_WAVE_STREAM(wave_stream)){
+    return(0);
+  }
+
+  /* get wave stream mutex */
+  wave_stream_mutex = AGS_WAVE_STREAM_GET_OBJ_MUTEX(wave_stream);
+
+  g_rec_mutex_lock(wave_stream_mutex);
+
+  if((AGS_WAVE_STREAM_OPENED & (wave_stream->flags)) == 0){
+    ags_wave_stream_open(wave_stream);
+  }
+
+  if(wave_stream->audio_file == NULL){
+    g_rec_mutex_unlock(wave_stream_mutex);
+
+    return(0);
+  }
+
+  /* apply seek */
+  generation = g_atomic_int_get(&(wave_stream->generation));
+
+  if(generation != wave_stream->fill_generation){
+    seek_index = g_atomic_int_get(&(wave_stream->seek_index));
+
+    if(generation != g_atomic_int_get(&(wave_stream->generation))){
+      g_rec_mutex_unlock(wave_stream_mutex);
+
+      return(0);
+    }
+
+    wave_stream->fill_generation = generation;
+    wave_stream->fill_index = seek_index;
+
+    g_atomic_int_set(&(wave_stream->fill_position),
+		     seek_index);
+
+    wave_stream->file_offset = (guint64) floor((gdouble) seek_index * (gdouble) wave_stream->buffer_size * (gdouble) wave_stream->file_samplerate / (gdouble) wave_stream->samplerate);
+
+    if(wave_stream->resampler != NULL){
+      ags_resampler_reset(wave_stream->resampler);
+    }
+  }
+
+  read_position = g_atomic_int_get(&(wave_stream->read_position));
+  write_position = g_atomic_int_get(&(wave_stream->write_position));
+
+  /* reclaim buffers of a previous seek */
+  while(read_position != write_position &&
+	wave_stream->ring_generation[read_position % wave_stream->ring_length] != generation){
+    if(g_atomic_int_compare_and_exchange(&(wave_stream->read_position), read_position, read_position + 1)){
+      read_position++;
+    }else{
+      read_position = g_atomic_int_get(&(wave_stream->read_position));
+    }
+  }
+
+  /* fill */
+  count = 0;
+
+  while(write_position - read_position < wave_stream->ring_length &&
+	(guint64) wave_stream->fill_index * wave_stream->buffer_size < wave_stream->frame_count){
+    if(generation != g_atomic_int_get(&(wave_stream->generation))){
+      break;
+    }
+
+    slot = write_position % wave_stream->ring_length;
+
+    /* the audio thread still reads the slot, continue after it was released */
+    if(g_atomic_int_get(&(wave_stream->pin_slot)) == slot + 1){
+      break;
+    }
+
+    buffer = wave_stream->ring[slot];
+
+    buffer_mutex = AGS_BUFFER_GET_OBJ_MUTEX(buffer);
+
+    g_rec_mutex_lock(buffer_mutex);
+
+    buffer->x = wave_stream->x_offset + (guint64) wave_stream->fill_index * wave_stream->buffer_size;
+
+    ags_wave_stream_read_buffer(wave_stream,
+				buffer);
+
+    g_rec_mutex_unlock(buffer_mutex);
+
+    wave_stream->ring_generation[slot] = generation;
+    wave_stream->ring_index[slot] = wave_stream->fill_index;
+
+    /* publish */
+    write_position++;
+
+    g_atomic_int_set(&(wave_stream->write_position),
+		     write_position);
+
+    wave_stream->fill_index += 1;
+
+    g_atomic_int_set(&(wave_stream->fill_position),
+		     wave_stream->fill_index);
+
+    count++;
+
+    read_position = g_atomic_int_get(&(wave_stream->read_position));
+  }
+
+  g_rec_mutex_unlock(wave_stream_mutex);
+
+  return(count);
+}
+
+/**
+ * ags_wave_stream_new:
+ * @filename: the filename
+ * @audio_channel: the audio channel of @filename
+ * @x_offset: the x offset the region starts at
+ * @frame_count: the frame count of the region
+ *
+ * Creates a new instance of #AgsWaveStream. Set samplerate, buffer size and
+ * format before adding it to #AgsWavePrefetcher.
+ *
+ * Returns: the new #AgsWaveStream
+ *
+ * Since: 3.7.0
+ */
+AgsWaveStream*
+ags_wave_stream_new(gchar *filename,
+		    guint audio_channel,
+		    guint64 x_offset,
+		    guint64 frame_count)
+{
+  AgsWaveStream *wave_stream;
+
+  wave_stream = (AgsWaveStream *) g_object_new(AGS_TYPE_WAVE_STREAM,
+					       "filename", filename,
+					       "audio-channel", audio_channel,
+					       "x-offset", x_offset,
+					       "frame-count", frame_count,
+					       NULL);
+
+  return(wave_stream);
+}
@@ -0,0 +1,131 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __AGS_WAVE_STREAM_H__
+#define __AGS_WAVE_STREAM_H__
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <ags/libags.h>
+
+#include <ags/audio/ags_buffer.h>
+#include <ags/audio/ags_resampler.h>
+
+G_BEGIN_DECLS
+
+#define AGS_TYPE_WAVE_STREAM                (ags_wave_stream_get_type())
+#define AGS_WAVE_STREAM(obj)                (G_TYPE_CHECK_INSTANCE_CAST((obj), AGS_TYPE_WAVE_STREAM, AgsWaveStream))
+#define AGS_WAVE_STREAM_CLASS(class)        (G_TYPE_CHECK_CLASS_CAST((class), AGS_TYPE_WAVE_STREAM, AgsWaveStreamClass))
+#define AGS_IS_WAVE_STREAM(obj)             (G_TYPE_CHECK_INSTANCE_TYPE ((obj), AGS_TYPE_WAVE_STREAM))
+#define AGS_IS_WAVE_STREAM_CLASS(class)     (G_TYPE_CHECK_CLASS_TYPE ((class), AGS_TYPE_WAVE_STREAM))
+#define AGS_WAVE_STREAM_GET_CLASS(obj)      (G_TYPE_INSTANCE_GET_CLASS (obj, AGS_TYPE_WAVE_STREAM, AgsWaveStreamClass))
+
+#define AGS_WAVE_STREAM_GET_OBJ_MUTEX(obj) (&(((AgsWaveStream *) obj)->obj_mutex))
+
+#define AGS_WAVE_STREAM_DEFAULT_PREFETCH_TIME (4.0)
+
+typedef struct _AgsWaveStream AgsWaveStream;
+typedef struct _AgsWaveStreamClass AgsWaveStreamClass;
+
+/**
+ * AgsWaveStreamFlags:
+ * @AGS_WAVE_STREAM_OPENED: the file region was opened by the prefetch thread
+ *
+ * Enum values to control the behavior or indicate internal state of #AgsWaveStream by
+ * enable/disable as flags.
+ */
+typedef enum{
+  AGS_WAVE_STREAM_OPENED     = 1,
+}AgsWaveStreamFlags;
+
+struct _AgsWaveStream
+{
+  GObject gobject;
+
+  guint flags;
+
+  GRecMutex obj_mutex;
+
+  gchar *filename;
+  guint audio_channel;
+
+  guint64 x_offset;
+  guint64 frame_count;
+
+  guint samplerate;
+  guint buffer_size;
+  guint format;
+
+  GObject *audio_file;
+
+  guint file_samplerate;
+  guint64 file_offset;
+
+  AgsResampler *resampler;
+
+  gfloat *file_data;
+  guint file_data_length;
+  gfloat *resample_data;
+
+  guint fill_generation;
+  guint fill_index;
+
+  guint ring_length;
+  AgsBuffer **ring;
+  guint *ring_generation;
+  guint *ring_index;
+
+  volatile guint read_position;
+  volatile guint write_position;
+
+  volatile guint pin_slot;
+
+  volatile guint generation;
+  volatile guint seek_index;
+  volatile guint fill_position;
+};
+
+struct _AgsWaveStreamClass
+{
+  GObjectClass gobject;
+};
+
+GType ags_wave_stream_get_type(void);
+
+gboolean ags_wave_stream_test_flags(AgsWaveStream *wave_stream, guint flags);
+void ags_wave_stream_set_flags(AgsWaveStream *wave_stream, guint flags);
+void ags_wave_stream_unset_flags(AgsWaveStream *wave_stream, guint flags);
+
+AgsBuffer* ags_wave_stream_find_point(AgsWaveStream *wave_stream,
+				      guint64 x);
+
+void ags_wave_stream_seek(AgsWaveStream *wave_stream,
+			  guint64 x);
+
+guint ags_wave_stream_prefetch(AgsWaveStream *wave_stream);
+
+AgsWaveStream* ags_wave_stream_new(gchar *filename,
+				   guint audio_channel,
+				   guint64 x_offset,
+				   guint64 frame_count);
+
+G_END_DECLS
+
+#endif /*__AGS_WAVE_STREAM_H__*/
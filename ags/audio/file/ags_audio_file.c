@@ -21,10 +21,14 @@
 
 #include <ags/audio/ags_audio_signal.h>
 #include <ags/audio/ags_wave.h>
+#include <ags/audio/ags_wave_stream.h>
 #include <ags/audio/ags_audio_buffer_util.h>
 
+#include <ags/audio/thread/ags_wave_prefetcher.h>
+
 #include <ags/audio/file/ags_sound_resource.h>
 #include <ags/audio/file/ags_sndfile.h>
+#include <ags/audio/file/ags_mmap_file.h>
 #include <ags/audio/file/ags_gstreamer_file.h>
 
 #include <stdlib.h>
@@ -1178,7 +1182,47 @@ ags_audio_file_open(AgsAudioFile *audio_file)
   retval = FALSE;
   
   if(g_file_test(filename, G_FILE_TEST_EXISTS)){
-    if(ags_sndfile_check_suffix(filename)){
+    /* uncompressed PCM is read from memory mapping, fall back to libsndfile */
+    if(ags_mmap_file_check_suffix(filename)){
+      AgsMmapFile *mmap_file;
+
+      mmap_file = ags_mmap_file_new();
+
+      if(ags_sound_resource_open(AGS_SOUND_RESOURCE(mmap_file),
+				 filename)){
+	g_rec_mutex_lock(audio_file_mutex);
+
+	sound_resource = 
+	  audio_file->sound_resource = (GObject *) mmap_file;
+
+	g_rec_mutex_unlock(audio_file_mutex);
+      }else{
+	g_object_unref(mmap_file);
+      }
+    }
+    
+    if(sound_resource != NULL){
+      ags_sound_resource_info(AGS_SOUND_RESOURCE(sound_resource),
+			      &file_frame_count,
+			      NULL, NULL);
+
+      g_object_set(audio_file,
+		   "file-frame-count", file_frame_count,
+		   NULL);
+
+      ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(sound_resource),
+				     &file_audio_channels,
+				     &file_samplerate,
+				     NULL,
+				     NULL);
+
+      g_object_set(audio_file,
+		   "file-audio-channels", file_audio_channels,
+		   "file-samplerate", file_samplerate,
+		   NULL);
+
+      retval = TRUE;
+    }else if(ags_sndfile_check_suffix(filename)){
       g_rec_mutex_lock(audio_file_mutex);
       
       sound_resource = 
@@ -1670,6 +1714,166 @@ ags_audio_file_read_wave(AgsAudioFile *audio_file,
   g_rec_mutex_unlock(audio_file_mutex);
 }
 
+/**
+ * ags_audio_file_read_wave_stream:
+ * @audio_file: the #AgsAudioFile
+ * @x_offset: the x offset
+ *
+ * Create #AgsWave streaming from @audio_file's file instead of reading all
+ * buffers into memory. The waves of one audio channel share an #AgsWaveStream,
+ * which is prefetched ahead of playback by #AgsWavePrefetcher.
+ *
+ * Returns: (element-type AgsAudio.Wave) (transfer full): a #GList-struct containing #AgsWave
+ *
+ * Since: 3.7.0
+ */
+GList*
+ags_audio_file_read_wave_stream(AgsAudioFile *audio_file,
+				guint64 x_offset)
+{
+  GObject *sound_resource;
+  GObject *soundcard;
+
+  GList *start_list;
+  
+  gchar *filename;
+
+  guint64 relative_offset;
+  guint64 target_frame_count;
+  guint64 current_offset;
+  gint audio_channel;
+  guint frame_count;
+  guint audio_channels;
+  guint samplerate;
+  guint target_samplerate;
+  guint target_buffer_size;
+  guint target_format;
+  guint i, i_start, i_stop;
+  
+  GRecMutex *audio_file_mutex;
+
+  if(!AGS_IS_AUDIO_FILE(audio_file)){
+    return(NULL);
+  }
+
+  /* get audio_file mutex */
+  audio_file_mutex = AGS_AUDIO_FILE_GET_OBJ_MUTEX(audio_file);
+
+  /* get sound resource */
+  g_rec_mutex_lock(audio_file_mutex);
+      
+  sound_resource = audio_file->sound_resource;
+  soundcard = audio_file->soundcard;
+
+  filename = g_strdup(audio_file->filename);
+  
+  audio_channel = audio_file->audio_channel;
+  
+  g_rec_mutex_unlock(audio_file_mutex);
+
+  if(sound_resource == NULL){
+    g_free(filename);
+    
+    return(NULL);
+  }
+
+  ags_sound_resource_info(AGS_SOUND_RESOURCE(sound_resource),
+			  &frame_count,
+			  NULL, NULL);
+
+  ags_sound_resource_get_presets(AGS_SOUND_RESOURCE(sound_resource),
+				 &audio_channels,
+				 &samplerate,
+				 NULL,
+				 NULL);
+
+  if(soundcard != NULL){
+    ags_soundcard_get_presets(AGS_SOUNDCARD(soundcard),
+			      NULL,
+			      &target_samplerate,
+			      &target_buffer_size,
+			      &target_format);
+  }else{
+    AgsConfig *config;
+
+    config = ags_config_get_instance();
+
+    target_samplerate = ags_soundcard_helper_config_get_samplerate(config);
+    target_buffer_size = ags_soundcard_helper_config_get_buffer_size(config);
+    target_format = ags_soundcard_helper_config_get_format(config);
+  }
+
+  if(audio_channel == -1){
+    i_start = 0;
+    i_stop = audio_channels;
+  }else{
+    i_start = audio_channel;
+    i_stop = i_start + 1;
+  }
+
+  if(i_stop > audio_channels ||
+     samplerate == 0){
+    g_free(filename);
+    
+    return(NULL);
+  }
+
+  target_frame_count = (guint64) ceil((gdouble) frame_count * (gdouble) target_samplerate / (gdouble) samplerate);
+  
+  relative_offset = AGS_WAVE_DEFAULT_BUFFER_LENGTH * target_samplerate;
+
+  start_list = NULL;
+  
+  for(i = i_start; i < i_stop; i++){
+    AgsWaveStream *wave_stream;
+
+    wave_stream = ags_wave_stream_new(filename,
+				      i,
+				      x_offset,
+				      target_frame_count);
+    g_object_set(wave_stream,
+		 "samplerate", target_samplerate,
+		 "buffer-size", target_buffer_size,
+		 "format", target_format,
+		 NULL);
+
+    /* one wave per timestamp, all referencing the stream */
+    for(current_offset = relative_offset * (x_offset / relative_offset); current_offset < x_offset + target_frame_count; current_offset += relative_offset){
+      AgsWave *wave;
+      AgsTimestamp *timestamp;
+      
+      wave = ags_wave_new(NULL,
+			  i);
+      g_object_set(wave,
+		   "samplerate", target_samplerate,
+		   "buffer-size", target_buffer_size,
+		   "format", target_format,
+		   "wave-stream", wave_stream,
+		   NULL);
+
+      g_object_get(wave,
+		   "timestamp", &timestamp,
+		   NULL);
+      ags_timestamp_set_ags_offset(timestamp,
+				   current_offset);
+	
+      g_object_unref(timestamp);
+
+      start_list = ags_wave_add(start_list,
+				wave);
+    }
+
+    ags_wave_prefetcher_add_wave_stream(ags_wave_prefetcher_get_instance(),
+					wave_stream);
+    
+    g_object_unref(wave_stream);
+  }
+
+  g_free(filename);
+  
+  return(start_list);
+}
+
 /**
  * ags_audio_file_seek:
  * @audio_file: the #AgsAudioFile
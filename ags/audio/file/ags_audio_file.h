@@ -117,6 +117,8 @@ void ags_audio_file_read_audio_signal(AgsAudioFile *audio_file);
 void ags_audio_file_read_wave(AgsAudioFile *audio_file,
 			      guint64 x_offset,
 			      gdouble delay, guint attack);
+GList* ags_audio_file_read_wave_stream(AgsAudioFile *audio_file,
+				       guint64 x_offset);
 void ags_audio_file_seek(AgsAudioFile *audio_file, guint frames, gint whence);
 void ags_audio_file_write(AgsAudioFile *audio_file,
 			  void *buffer, guint buffer_size,
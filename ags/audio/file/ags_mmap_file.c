@@ -0,0 +1,1468 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ags/audio/file/ags_mmap_file.h>
+
+#include <ags/audio/ags_audio_signal.h>
+#include <ags/audio/ags_audio_buffer_util.h>
+
+#include <ags/audio/file/ags_sound_resource.h>
+
+#include <string.h>
+#include <math.h>
+
+#include <ags/i18n.h>
+
+void ags_mmap_file_class_init(AgsMmapFileClass *mmap_file);
+void ags_mmap_file_sound_resource_interface_init(AgsSoundResourceInterface *sound_resource);
+void ags_mmap_file_init(AgsMmapFile *mmap_file);
+void ags_mmap_file_set_property(GObject *gobject,
+				guint prop_id,
+				const GValue *value,
+				GParamSpec *param_spec);
+void ags_mmap_file_get_property(GObject *gobject,
+				guint prop_id,
+				GValue *value,
+				GParamSpec *param_spec);
+void ags_mmap_file_finalize(GObject *gobject);
+
+gboolean ags_mmap_file_open(AgsSoundResource *sound_resource,
+			    gchar *filename);
+gboolean ags_mmap_file_rw_open(AgsSoundResource *sound_resource,
+			       gchar *filename,
+			       guint audio_channels, guint samplerate,
+			       gboolean create);
+void ags_mmap_file_info(AgsSoundResource *sound_resource,
+			guint *frame_count,
+			guint *loop_start, guint *loop_end);
+void ags_mmap_file_set_presets(AgsSoundResource *sound_resource,
+			       guint channels,
+			       guint samplerate,
+			       guint buffer_size,
+			       guint format);
+void ags_mmap_file_get_presets(AgsSoundResource *sound_resource,
+			       guint *channels,
+			       guint *samplerate,
+			       guint *buffer_size,
+			       guint *format);
+guint ags_mmap_file_read(AgsSoundResource *sound_resource,
+			 void *dbuffer, guint daudio_channels,
+			 guint audio_channel,
+			 guint frame_count, guint format);
+guint ags_mmap_file_read_channels(AgsSoundResource *sound_resource,
+				  void **dbuffer,
+				  guint frame_count, guint format);
+void ags_mmap_file_seek(AgsSoundResource *sound_resource,
+			gint64 frame_count, gint whence);
+void ags_mmap_file_close(AgsSoundResource *sound_resource);
+
+guint16 ags_mmap_file_get_uint16(guchar *data,
+				 gboolean big_endian);
+guint32 ags_mmap_file_get_uint32(guchar *data,
+				 gboolean big_endian);
+guint64 ags_mmap_file_get_uint64(guchar *data,
+				 gboolean big_endian);
+
+gboolean ags_mmap_file_parse_wav(AgsMmapFile *mmap_file,
+				 guchar *contents, gsize length);
+gboolean ags_mmap_file_parse_aiff(AgsMmapFile *mmap_file,
+				  guchar *contents, gsize length);
+gboolean ags_mmap_file_set_sample_format(AgsMmapFile *mmap_file,
+					 guint bits_per_sample,
+					 gboolean is_float);
+
+void ags_mmap_file_unpack(AgsMmapFile *mmap_file,
+			  guchar *source,
+			  guint frame_count);
+void ags_mmap_file_copy_channel(AgsMmapFile *mmap_file,
+				void *dbuffer, guint daudio_channels,
+				guint audio_channel,
+				guint64 offset,
+				guint frame_count, guint format);
+
+/**
+ * SECTION:ags_mmap_file
+ * @short_description: memory mapped PCM files
+ * @title: AgsMmapFile
+ * @section_id:
+ * @include: ags/audio/file/ags_mmap_file.h
+ *
+ * #AgsMmapFile reads uncompressed PCM from WAV, RF64 and AIFF files. The file is
+ * mapped into memory and the samples are read from the mapping, so the data
+ * stays in page cache and is shared between processes opening the same file.
+ * Samples stored in a host compatible layout are copied to the destination
+ * without intermediate buffer, others are unpacked block by block.
+ */
+
+enum{
+  PROP_0,
+  PROP_FILENAME,
+  PROP_AUDIO_CHANNELS,
+  PROP_BUFFER_SIZE,
+  PROP_FORMAT,
+};
+
+static gpointer ags_mmap_file_parent_class = NULL;
+
+GType
+ags_mmap_file_get_type()
+{
+  static volatile gsize g_define_type_id__volatile = 0;
+
+  if(g_once_init_enter (&g_define_type_id__volatile)){
+    GType ags_type_mmap_file = 0;
+
+    static const GTypeInfo ags_mmap_file_info = {
+      sizeof (AgsMmapFileClass),
+      NULL, /* base_init */
+      NULL, /* base_finalize */
+      (GClassInitFunc) ags_mmap_file_class_init,
+      NULL, /* class_finalize */
+      NULL, /* class_data */
+      sizeof (AgsMmapFile),
+      0,    /* n_preallocs */
+      (GInstanceInitFunc) ags_mmap_file_init,
+    };
+
+    static const GInterfaceInfo ags_sound_resource_interface_info = {
+      (GInterfaceInitFunc) ags_mmap_file_sound_resource_interface_init,
+      NULL, /* interface_finalize */
+      NULL, /* interface_data */
+    };
+
+    ags_type_mmap_file = g_type_register_static(G_TYPE_OBJECT,
+						"AgsMmapFile",
+						&ags_mmap_file_info,
+						0);
+
+    g_type_add_interface_static(ags_type_mmap_file,
+				AGS_TYPE_SOUND_RESOURCE,
+				&ags_sound_resource_interface_info);
+
+    g_once_init_leave(&g_define_type_id__volatile, ags_type_mmap_file);
+  }
+
+  return g_define_type_id__volatile;
+}
+
+void
+ags_mmap_file_class_init(AgsMmapFileClass *mmap_file)
+{
+  GObjectClass *gobject;
+
+  GParamSpec *param_spec;
+
+  ags_mmap_file_parent_class = g_type_class_peek_parent(mmap_file);
+
+  gobject = (GObjectClass *) mmap_file;
+
+  gobject->set_property = ags_mmap_file_set_property;
+  gobject->get_property = ags_mmap_file_get_property;
+
+  gobject->finalize = ags_mmap_file_finalize;
+
+  /* properties */
+  /**
+   * AgsMmapFile:filename:
+   *
+   * The assigned filename.
+   *
+   * Since: 3.7.0
+   */
+  param_spec = g_param_spec_string("filename",
+				   i18n_pspec("the filename"),
+				   i18n_pspec("The filename"),
+				   NULL,
+				   G_PARAM_READABLE);
+  g_object_class_install_property(gobject,
+				  PROP_FILENAME,
+				  param_spec);
+
+  /**
+   * AgsMmapFile:audio-channels:
+   *
+   * The audio channels of the file.
+   *
+   * Since: 3.7.0
+   */
+  param_spec = g_param_spec_uint("audio-channels",
+				 i18n_pspec("audio channels"),
+				 i18n_pspec("The audio channels of the file"),
+				 0,
+				 G_MAXUINT32,
+				 0,
+				 G_PARAM_READABLE);
+  g_object_class_install_property(gobject,
+				  PROP_AUDIO_CHANNELS,
+				  param_spec);
+
+  /**
+   * AgsMmapFile:buffer-size:
+   *
+   * The buffer size to be used.
+   *
+   * Since: 3.7.0
+   */
+  param_spec = g_param_spec_uint("buffer-size",
+				 i18n_pspec("using buffer size"),
+				 i18n_pspec("The buffer size to be used"),
+				 0,
+				 G_MAXUINT32,
+				 0,
+				 G_PARAM_READABLE | G_PARAM_WRITABLE);
+  g_object_class_install_property(gobject,
+				  PROP_BUFFER_SIZE,
+				  param_spec);
+
+  /**
+   * AgsMmapFile:format:
+   *
+   * The format of the samples as stored in the file.
+   *
+   * Since: 3.7.0
+   */
+  param_spec = g_param_spec_uint("format",
+				 i18n_pspec("format"),
+				 i18n_pspec("The format of the file"),
+				 0,
+				 G_MAXUINT32,
+				 0,
+				 G_PARAM_READABLE);
+  g_object_class_install_property(gobject,
+				  PROP_FORMAT,
+				  param_spec);
+}
+
+void
+ags_mmap_file_sound_resource_interface_init(AgsSoundResourceInterface *sound_resource)
+{
+  sound_resource->open = ags_mmap_file_open;
+  sound_resource->rw_open = ags_mmap_file_rw_open;
+
+  sound_resource->load = NULL;
+
+  sound_resource->info = ags_mmap_file_info;
+
+  sound_resource->set_presets = ags_mmap_file_set_presets;
+  sound_resource->get_presets = ags_mmap_file_get_presets;
+
+  sound_resource->read = ags_mmap_file_read;
+  sound_resource->read_channels = ags_mmap_file_read_channels;
+
+  sound_resource->write = NULL;
+  sound_resource->flush = NULL;
+
+  sound_resource->seek = ags_mmap_file_seek;
+
+  sound_resource->close = ags_mmap_file_close;
+}
+
+void
+ags_mmap_file_init(AgsMmapFile *mmap_file)
+{
+  AgsConfig *config;
+
+  mmap_file->flags = 0;
+
+  /* add mmap file mutex */
+  g_rec_mutex_init(&(mmap_file->obj_mutex));
+
+  config = ags_config_get_instance();
+
+  mmap_file->filename = NULL;
+
+  mmap_file->mapped_file = NULL;
+
+  mmap_file->audio_channels = 0;
+  mmap_file->samplerate = 0;
+
+  mmap_file->buffer_size = ags_soundcard_helper_config_get_buffer_size(config);
+  mmap_file->format = AGS_SOUNDCARD_DOUBLE;
+
+  mmap_file->word_size = 0;
+  mmap_file->frame_size = 0;
+
+  mmap_file->data = NULL;
+  mmap_file->frame_count = 0;
+
+  mmap_file->offset = 0;
+
+  mmap_file->buffer = NULL;
+}
+
+void
+ags_mmap_file_set_property(GObject *gobject,
+			   guint prop_id,
+			   const GValue *value,
+			   GParamSpec *param_spec)
+{
+  AgsMmapFile *mmap_file;
+
+  GRecMutex *mmap_file_mutex;
+
+  mmap_file = AGS_MMAP_FILE(gobject);
+
+  /* get mmap file mutex */
+  mmap_file_mutex = AGS_MMAP_FILE_GET_OBJ_MUTEX(mmap_file);
+
+  switch(prop_id){
+  case PROP_BUFFER_SIZE:
+    {
+      guint buffer_size;
+
+      buffer_size = g_value_get_uint(value);
+
+      g_rec_mutex_lock(mmap_file_mutex);
+
+      if(buffer_size == mmap_file->buffer_size){
+	g_rec_mutex_unlock(mmap_file_mutex);
+
+	return;
+      }
+
+      mmap_file->buffer_size = buffer_size;
+
+      if(mmap_file->buffer != NULL){
+	ags_stream_free(mmap_file->buffer);
+
+	mmap_file->buffer = ags_stream_alloc(mmap_file->buffer_size,
+					     mmap_file->format);
+      }
+
+      g_rec_mutex_unlock(mmap_file_mutex);
+    }
+    break;
+  default:
+    G_OBJECT_WARN_INVALID_PROPERTY_ID(gobject, prop_id, param_spec);
+    break;
+  }
+}
+
+void
+ags_mmap_file_get_property(GObject *gobject,
+			   guint prop_id,
+			   GValue *value,
+			   GParamSpec *param_spec)
+{
+  AgsMmapFile *mmap_file;
+
+  GRecMutex *mmap_file_mutex;
+
+  mmap_file = AGS_MMAP_FILE(gobject);
+
+  /* get mmap file mutex */
+  mmap_file_mutex = AGS_MMAP_FILE_GET_OBJ_MUTEX(mmap_file);
+
+  switch(prop_id){
+  case PROP_FILENAME:
+    {
+      g_rec_mutex_lock(mmap_file_mutex);
+
+      g_value_set_string(value, mmap_file->filename);
+
+      g_rec_mutex_unlock(mmap_file_mutex);
+    }
+    break;
+  case PROP_AUDIO_CHANNELS:
+    {
+      g_rec_mutex_lock(mmap_file_mutex);
+
+      g_value_set_uint(value, mmap_file->audio_channels);
+
+      g_rec_mutex_unlock(mmap_file_mutex);
+    }
+    break;
+  case PROP_BUFFER_SIZE:
+    {
+      g_rec_mutex_lock(mmap_file_mutex);
+
+      g_value_set_uint(value, mmap_file->buffer_size);
+
+      g_rec_mutex_unlock(mmap_file_mutex);
+    }
+    break;
+  case PROP_FORMAT:
+    {
+      g_rec_mutex_lock(mmap_file_mutex);
+
+      g_value_set_uint(value, mmap_file->format);
+
+      g_rec_mutex_unlock(mmap_file_mutex);
+    }
+    break;
+  default:
+    G_OBJECT_WARN_INVALID_PROPERTY_ID(gobject, prop_id, param_spec);
+    break;
+  }
+}
+
+void
+ags_mmap_file_finalize(GObject *gobject)
+{
+  AgsMmapFile *mmap_file;
+
+  mmap_file = AGS_MMAP_FILE(gobject);
+
+  g_free(mmap_file->filename);
+
+  if(mmap_file->mapped_file != NULL){
+    g_mapped_file_unref(mmap_file->mapped_file);
+  }
+
+  if(mmap_file->buffer != NULL){
+    ags_stream_free(mmap_file->buffer);
+  }
+
+  /* call parent */
+  G_OBJECT_CLASS(ags_mmap_file_parent_class)->finalize(gobject);
+}
+
+/**
+ * ags_mmap_file_test_flags:
+ * @mmap_file: the #AgsMmapFile
+ * @flags: the flags
+ *
+ * Test @flags to be set on @mmap_file.
+ *
+ * Returns: %TRUE if flags are set, else %FALSE
+ *
+ * Since: 3.7.0
+ */
+gboolean
+ags_mmap_file_test_flags(AgsMmapFile *mmap_file, guint flags)
+{
+  gboolean retval;
+
+  GRecMutex *mmap_file_mutex;
+
+  if(!AGS_IS_MMAP_FILE(mmap_file)){
+    return(FALSE);
+  }
+
+  /* get mmap file mutex */
+  mmap_file_mutex = AGS_MMAP_FILE_GET_OBJ_MUTEX(mmap_file);
+
+  /* test */
+  g_rec_mutex_lock(mmap_file_mutex);
+
+  retval = (flags & (mmap_file->flags)) ? TRUE: FALSE;
+
+  g_rec_mutex_unlock(mmap_file_mutex);
+
+  return(retval);
+}
+
+/**
+ * ags_mmap_file_set_flags:
+ * @mmap_file: the #AgsMmapFile
+ * @flags: see #AgsMmapFileFlags-enum
+ *
+ * Enable a feature of @mmap_file.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_mmap_file_set_flags(AgsMmapFile *mmap_file, guint flags)
+{
+  GRecMutex *mmap_file_mutex;
+
+  if(!AGS_IS_MMAP_FILE(mmap_file)){
+    return;
+  }
+
+  /* get mmap file mutex */
+  mmap_file_mutex = AGS_MMAP_FILE_GET_OBJ_MUTEX(mmap_file);
+
+  /* set flags */
+  g_rec_mutex_lock(mmap_file_mutex);
+
+  mmap_file->flags |= flags;
+
+  g_rec_mutex_unlock(mmap_file_mutex);
+}
+
+/**
+ * ags_mmap_file_unset_flags:
+ * @mmap_file: the #AgsMmapFile
+ * @flags: see #AgsMmapFileFlags-enum
+ *
+ * Disable a feature of @mmap_file.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_mmap_file_unset_flags(AgsMmapFile *mmap_file, guint flags)
+{
+  GRecMutex *mmap_file_mutex;
+
+  if(!AGS_IS_MMAP_FILE(mmap_file)){
+    return;
+  }
+
+  /* get mmap file mutex */
+  mmap_file_mutex = AGS_MMAP_FILE_GET_OBJ_MUTEX(mmap_file);
+
+  /* unset flags */
+  g_rec_mutex_lock(mmap_file_mutex);
+
+  mmap_file->flags &= (~flags);
+
+  g_rec_mutex_unlock(mmap_file_mutex);
+}
+
+gboolean
+ags_mmap_file_set_sample_format(AgsMmapFile *mmap_file,
+				guint bits_per_sample,
+				gboolean is_float)
+{
+  if(is_float){
+    switch(bits_per_sample){
+    case 32:
+      {
+	mmap_file->format = AGS_SOUNDCARD_FLOAT;
+	mmap_file->word_size = 4;
+      }
+      break;
+    case 64:
+      {
+	mmap_file->format = AGS_SOUNDCARD_DOUBLE;
+	mmap_file->word_size = 8;
+      }
+      break;
+    default:
+      return(FALSE);
+    }
+  }else{
+    switch(bits_per_sample){
+    case 8:
+      {
+	mmap_file->format = AGS_SOUNDCARD_SIGNED_8_BIT;
+	mmap_file->word_size = 1;
+      }
+      break;
+    case 16:
+      {
+	mmap_file->format = AGS_SOUNDCARD_SIGNED_16_BIT;
+	mmap_file->word_size = 2;
+      }
+      break;
+    case 24:
+      {
+	mmap_file->format = AGS_SOUNDCARD_SIGNED_24_BIT;
+	mmap_file->word_size = 3;
+      }
+      break;
+    case 32:
+      {
+	mmap_file->format = AGS_SOUNDCARD_SIGNED_32_BIT;
+	mmap_file->word_size = 4;
+      }
+      break;
+    default:
+      return(FALSE);
+    }
+  }
+
+  return(TRUE);
+}
+
+guint16
+ags_mmap_file_get_uint16(guchar *data,
+			 gboolean big_endian)
+{
+  guint16 value;
+
+  /* the header fields aren't aligned */
+  memcpy(&value, data, sizeof(guint16));
+
+  return(big_endian ? GUINT16_FROM_BE(value): GUINT16_FROM_LE(value));
+}
+
+guint32
+ags_mmap_file_get_uint32(guchar *data,
+			 gboolean big_endian)
+{
+  guint32 value;
+
+  memcpy(&value, data, sizeof(guint32));
+
+  return(big_endian ? GUINT32_FROM_BE(value): GUINT32_FROM_LE(value));
+}
+
+guint64
+ags_mmap_file_get_uint64(guchar *data,
+			 gboolean big_endian)
+{
+  guint64 value;
+
+  memcpy(&value, data, sizeof(guint64));
+
+  return(big_endian ? GUINT64_FROM_BE(value): GUINT64_FROM_LE(value));
+}
+
+gboolean
+ags_mmap_file_parse_wav(AgsMmapFile *mmap_file,
+			guchar *contents, gsize length)
+{
+  guchar *chunk;
+
+  guint64 position;
+  guint64 data_length;
+  guint64 ds64_data_length;
+  guint audio_format;
+  guint bits_per_sample;
+  guint block_align;
+  gboolean is_rf64;
+  gboolean has_fmt;
+
+  if(length < 12 ||
+     memcmp(contents + 8, "WAVE", 4) != 0){
+    return(FALSE);
+  }
+
+  if(!memcmp(contents, "RIFF", 4)){
+    is_rf64 = FALSE;
+  }else if(!memcmp(contents, "RF64", 4)){
+    is_rf64 = TRUE;
+  }else{
+    return(FALSE);
+  }
+
+  ds64_data_length = 0;
+
+  audio_format = 0;
+  bits_per_sample = 0;
+  block_align = 0;
+
+  has_fmt = FALSE;
+
+  position = 12;
+
+  while(position + 8 <= length){
+    guint64 chunk_length;
+
+    chunk = contents + position;
+    
+    chunk_length = ags_mmap_file_get_uint32(chunk + 4,
+					    FALSE);
+
+    /* RF64 data chunk size is stored in ds64 */
+    if(is_rf64 &&
+       !memcmp(chunk, "data", 4) &&
+       chunk_length == 0xffffffff){
+      chunk_length = ds64_data_length;
+    }
+    
+    /* truncated or corrupt */
+    if(chunk_length > length - position - 8){
+      return(FALSE);
+    }
+    
+    if(!memcmp(chunk, "ds64", 4) &&
+       chunk_length >= 16){
+      /* 64 bit sizes of RF64 */
+      ds64_data_length = ags_mmap_file_get_uint64(chunk + 16,
+						  FALSE);
+    }else if(!memcmp(chunk, "fmt ", 4) &&
+	     chunk_length >= 16){
+      audio_format = ags_mmap_file_get_uint16(chunk + 8,
+					      FALSE);
+      mmap_file->audio_channels = ags_mmap_file_get_uint16(chunk + 10,
+							   FALSE);
+      mmap_file->samplerate = ags_mmap_file_get_uint32(chunk + 12,
+						       FALSE);
+      block_align = ags_mmap_file_get_uint16(chunk + 20,
+					     FALSE);
+      bits_per_sample = ags_mmap_file_get_uint16(chunk + 22,
+						 FALSE);
+
+      /* WAVE_FORMAT_EXTENSIBLE - the sub format GUID starts with the format tag */
+      if(audio_format == 0xfffe &&
+	 chunk_length >= 40){
+	audio_format = ags_mmap_file_get_uint16(chunk + 32,
+						FALSE);
+      }
+
+      has_fmt = TRUE;
+    }else if(!memcmp(chunk, "data", 4)){
+      if(!has_fmt){
+	return(FALSE);
+      }
+
+      data_length = chunk_length;
+
+      mmap_file->data = chunk + 8;
+
+      /* WAVE_FORMAT_PCM or WAVE_FORMAT_IEEE_FLOAT */
+      if(audio_format != 0x0001 &&
+	 audio_format != 0x0003){
+	return(FALSE);
+      }
+
+      if(!ags_mmap_file_set_sample_format(mmap_file,
+					  bits_per_sample,
+					  ((audio_format == 0x0003) ? TRUE: FALSE))){
+	return(FALSE);
+      }
+
+      /* 8 bit WAV is unsigned */
+      if(bits_per_sample == 8){
+	mmap_file->flags |= AGS_MMAP_FILE_UNSIGNED;
+      }
+
+      if(mmap_file->audio_channels == 0 ||
+	 block_align != mmap_file->audio_channels * mmap_file->word_size){
+	return(FALSE);
+      }
+
+      mmap_file->frame_size = block_align;
+      mmap_file->frame_count = data_length / block_align;
+
+      return(TRUE);
+    }
+
+    /* chunks are word aligned */
+    position += 8 + chunk_length + (chunk_length & 1);
+  }
+
+  return(FALSE);
+}
+
+gboolean
+ags_mmap_file_parse_aiff(AgsMmapFile *mmap_file,
+			 guchar *contents, gsize length)
+{
+  guchar *chunk;
+
+  guint64 position;
+  guint64 frame_count;
+  guint bits_per_sample;
+  gboolean is_aifc;
+  gboolean is_float;
+  gboolean has_comm;
+
+  if(length < 12 ||
+     memcmp(contents, "FORM", 4) != 0){
+    return(FALSE);
+  }
+
+  if(!memcmp(contents + 8, "AIFF", 4)){
+    is_aifc = FALSE;
+  }else if(!memcmp(contents + 8, "AIFC", 4)){
+    is_aifc = TRUE;
+  }else{
+    return(FALSE);
+  }
+
+  mmap_file->flags |= AGS_MMAP_FILE_BIG_ENDIAN;
+
+  frame_count = 0;
+  bits_per_sample = 0;
+
+  is_float = FALSE;
+  has_comm = FALSE;
+
+  position = 12;
+
+  while(position + 8 <= length){
+    guint64 chunk_length;
+
+    chunk = contents + position;
+    
+    chunk_length = ags_mmap_file_get_uint32(chunk + 4,
+					    TRUE);
+
+    /* truncated or corrupt */
+    if(chunk_length > length - position - 8){
+      return(FALSE);
+    }
+
+    if(!memcmp(chunk, "COMM", 4) &&
+       chunk_length >= 18){
+      guint64 mantissa;
+      gint exponent;
+
+      mmap_file->audio_channels = ags_mmap_file_get_uint16(chunk + 8,
+							   TRUE);
+      frame_count = ags_mmap_file_get_uint32(chunk + 10,
+					     TRUE);
+      bits_per_sample = ags_mmap_file_get_uint16(chunk + 14,
+						 TRUE);
+
+      /* 80 bit IEEE 754 extended samplerate */
+      exponent = ((chunk[16] & 0x7f) << 8) | chunk[17];
+      mantissa = ags_mmap_file_get_uint64(chunk + 18,
+					  TRUE);
+
+      mmap_file->samplerate = (guint) ldexp((gdouble) mantissa, exponent - 16383 - 63);
+
+      if(is_aifc){
+	if(chunk_length < 22){
+	  return(FALSE);
+	}
+
+	if(!memcmp(chunk + 26, "NONE", 4) ||
+	   !memcmp(chunk + 26, "twos", 4)){
+	  /* big endian integer */
+	}else if(!memcmp(chunk + 26, "sowt", 4)){
+	  mmap_file->flags &= (~AGS_MMAP_FILE_BIG_ENDIAN);
+	}else if(!g_ascii_strncasecmp((gchar *) chunk + 26, "fl32", 4)){
+	  is_float = TRUE;
+	  bits_per_sample = 32;
+	}else if(!g_ascii_strncasecmp((gchar *) chunk + 26, "fl64", 4)){
+	  is_float = TRUE;
+	  bits_per_sample = 64;
+	}else{
+	  /* compressed */
+	  return(FALSE);
+	}
+      }
+
+      has_comm = TRUE;
+    }else if(!memcmp(chunk, "SSND", 4) &&
+	     chunk_length >= 8){
+      guint64 data_offset;
+      guint64 data_length;
+
+      if(!has_comm){
+	return(FALSE);
+      }
+
+      if(!ags_mmap_file_set_sample_format(mmap_file,
+					  bits_per_sample,
+					  is_float)){
+	return(FALSE);
+      }
+
+      if(mmap_file->audio_channels == 0){
+	return(FALSE);
+      }
+
+      data_offset = ags_mmap_file_get_uint32(chunk + 8,
+					     TRUE);
+
+      if(data_offset + 8 > chunk_length){
+	return(FALSE);
+      }
+
+      mmap_file->data = chunk + 16 + data_offset;
+      mmap_file->frame_size = mmap_file->audio_channels * mmap_file->word_size;
+
+      data_length = chunk_length - 8 - data_offset;
+
+      mmap_file->frame_count = data_length / mmap_file->frame_size;
+
+      if(frame_count < mmap_file->frame_count){
+	mmap_file->frame_count = frame_count;
+      }
+
+      return(TRUE);
+    }
+
+    /* chunks are word aligned */
+    position += 8 + chunk_length + (chunk_length & 1);
+  }
+
+  return(FALSE);
+}
+
+gboolean
+ags_mmap_file_open(AgsSoundResource *sound_resource,
+		   gchar *filename)
+{
+  AgsMmapFile *mmap_file;
+
+  GMappedFile *mapped_file;
+
+  guchar *contents;
+
+  gsize length;
+  gboolean is_native;
+  gboolean success;
+
+  GError *error;
+
+  GRecMutex *mmap_file_mutex;
+
+  mmap_file = AGS_MMAP_FILE(sound_resource);
+
+  /* get mmap file mutex */
+  mmap_file_mutex = AGS_MMAP_FILE_GET_OBJ_MUTEX(mmap_file);
+
+  if(filename == NULL){
+    return(FALSE);
+  }
+
+  error = NULL;
+  mapped_file = g_mapped_file_new(filename,
+				  FALSE,
+				  &error);
+
+  if(mapped_file == NULL){
+    if(error != NULL){
+      g_warning("%s", error->message);
+
+      g_error_free(error);
+    }
+
+    return(FALSE);
+  }
+
+  contents = (guchar *) g_mapped_file_get_contents(mapped_file);
+  length = g_mapped_file_get_length(mapped_file);
+
+  g_rec_mutex_lock(mmap_file_mutex);
+
+  if(mmap_file->mapped_file != NULL){
+    g_rec_mutex_unlock(mmap_file_mutex);
+
+    g_mapped_file_unref(mapped_file);
+
+    g_warning("ags_mmap_file_open() - file already open");
+
+    return(FALSE);
+  }
+
+  mmap_file->flags &= (~(AGS_MMAP_FILE_BIG_ENDIAN |
+			 AGS_MMAP_FILE_UNSIGNED |
+			 AGS_MMAP_FILE_ZERO_COPY));
+
+  success = FALSE;
+
+  if(contents != NULL){
+    success = ags_mmap_file_parse_wav(mmap_file,
+				      contents, length);
+
+    if(!success){
+      mmap_file->flags &= (~(AGS_MMAP_FILE_BIG_ENDIAN |
+			     AGS_MMAP_FILE_UNSIGNED));
+
+      success = ags_mmap_file_parse_aiff(mmap_file,
+					 contents, length);
+    }
+  }
+
+  if(!success){
+    mmap_file->data = NULL;
+    mmap_file->frame_count = 0;
+
+    g_rec_mutex_unlock(mmap_file_mutex);
+
+    g_mapped_file_unref(mapped_file);
+
+    return(FALSE);
+  }
+
+  mmap_file->filename = g_strdup(filename);
+  mmap_file->mapped_file = mapped_file;
+
+  mmap_file->offset = 0;
+
+  /* read straight from the mapping if the samples are laid out like in memory */
+#if G_BYTE_ORDER == G_LITTLE_ENDIAN
+  is_native = ((AGS_MMAP_FILE_BIG_ENDIAN & (mmap_file->flags)) == 0) ? TRUE: FALSE;
+#else
+  is_native = ((AGS_MMAP_FILE_BIG_ENDIAN & (mmap_file->flags)) != 0) ? TRUE: FALSE;
+#endif
+
+  if((is_native || mmap_file->word_size == 1) &&
+     (AGS_MMAP_FILE_UNSIGNED & (mmap_file->flags)) == 0 &&
+     mmap_file->word_size != 3 &&
+     ((guintptr) mmap_file->data) % mmap_file->word_size == 0){
+    mmap_file->flags |= AGS_MMAP_FILE_ZERO_COPY;
+  }else{
+    mmap_file->buffer = ags_stream_alloc(mmap_file->buffer_size,
+					 mmap_file->format);
+  }
+
+  g_rec_mutex_unlock(mmap_file_mutex);
+
+  return(TRUE);
+}
+
+gboolean
+ags_mmap_file_rw_open(AgsSoundResource *sound_resource,
+		      gchar *filename,
+		      guint audio_channels, guint samplerate,
+		      gboolean create)
+{
+  g_warning("ags_mmap_file_rw_open() - read-only sound resource");
+
+  return(FALSE);
+}
+
+void
+ags_mmap_file_info(AgsSoundResource *sound_resource,
+		   guint *frame_count,
+		   guint *loop_start, guint *loop_end)
+{
+  AgsMmapFile *mmap_file;
+
+  GRecMutex *mmap_file_mutex;
+
+  mmap_file = AGS_MMAP_FILE(sound_resource);
+
+  /* get mmap file mutex */
+  mmap_file_mutex = AGS_MMAP_FILE_GET_OBJ_MUTEX(mmap_file);
+
+  if(loop_start != NULL){
+    loop_start[0] = 0;
+  }
+
+  if(loop_end != NULL){
+    loop_end[0] = 0;
+  }
+
+  g_rec_mutex_lock(mmap_file_mutex);
+
+  if(frame_count != NULL){
+    frame_count[0] = mmap_file->frame_count;
+  }
+
+  g_rec_mutex_unlock(mmap_file_mutex);
+}
+
+void
+ags_mmap_file_set_presets(AgsSoundResource *sound_resource,
+			  guint channels,
+			  guint samplerate,
+			  guint buffer_size,
+			  guint format)
+{
+  AgsMmapFile *mmap_file;
+
+  mmap_file = AGS_MMAP_FILE(sound_resource);
+
+  /* channels, samplerate and format are given by the file */
+  g_object_set(mmap_file,
+	       "buffer-size", buffer_size,
+	       NULL);
+}
+
+void
+ags_mmap_file_get_presets(AgsSoundResource *sound_resource,
+			  guint *channels,
+			  guint *samplerate,
+			  guint *buffer_size,
+			  guint *format)
+{
+  AgsMmapFile *mmap_file;
+
+  GRecMutex *mmap_file_mutex;
+
+  mmap_file = AGS_MMAP_FILE(sound_resource);
+
+  /* get mmap file mutex */
+  mmap_file_mutex = AGS_MMAP_FILE_GET_OBJ_MUTEX(mmap_file);
+
+  g_rec_mutex_lock(mmap_file_mutex);
+
+  if(channels != NULL){
+    *channels = mmap_file->audio_channels;
+  }
+
+  if(samplerate != NULL){
+    *samplerate = mmap_file->samplerate;
+  }
+
+  if(buffer_size != NULL){
+    *buffer_size = mmap_file->buffer_size;
+  }
+
+  if(format != NULL){
+    *format = mmap_file->format;
+  }
+
+  g_rec_mutex_unlock(mmap_file_mutex);
+}
+
+void
+ags_mmap_file_unpack(AgsMmapFile *mmap_file,
+		     guchar *source,
+		     guint frame_count)
+{
+  guint frame_size;
+  guint i;
+  gboolean is_big_endian;
+
+  frame_size = mmap_file->frame_size;
+
+  is_big_endian = ((AGS_MMAP_FILE_BIG_ENDIAN & (mmap_file->flags)) != 0) ? TRUE: FALSE;
+
+  switch(mmap_file->format){
+  case AGS_SOUNDCARD_SIGNED_8_BIT:
+    {
+      gint8 *buffer;
+
+      buffer = (gint8 *) mmap_file->buffer;
+
+      if((AGS_MMAP_FILE_UNSIGNED & (mmap_file->flags)) != 0){
+	for(i = 0; i < frame_count; i++){
+	  buffer[i] = (gint8) ((gint) source[i * frame_size] - 128);
+	}
+      }else{
+	for(i = 0; i < frame_count; i++){
+	  buffer[i] = (gint8) source[i * frame_size];
+	}
+      }
+    }
+    break;
+  case AGS_SOUNDCARD_SIGNED_16_BIT:
+    {
+      gint16 *buffer;
+
+      guint16 value;
+
+      buffer = (gint16 *) mmap_file->buffer;
+
+      for(i = 0; i < frame_count; i++){
+	memcpy(&value, source + i * frame_size, sizeof(guint16));
+
+	buffer[i] = (gint16) (is_big_endian ? GUINT16_FROM_BE(value): GUINT16_FROM_LE(value));
+      }
+    }
+    break;
+  case AGS_SOUNDCARD_SIGNED_24_BIT:
+    {
+      gint32 *buffer;
+      guchar *sample;
+
+      guint32 value;
+
+      buffer = (gint32 *) mmap_file->buffer;
+
+      for(i = 0; i < frame_count; i++){
+	sample = source + i * frame_size;
+
+	if(is_big_endian){
+	  value = (sample[0] << 16) | (sample[1] << 8) | sample[2];
+	}else{
+	  value = (sample[2] << 16) | (sample[1] << 8) | sample[0];
+	}
+
+	/* sign extend */
+	if((0x800000 & value) != 0){
+	  value |= 0xff000000;
+	}
+
+	buffer[i] = (gint32) value;
+      }
+    }
+    break;
+  case AGS_SOUNDCARD_SIGNED_32_BIT:
+    {
+      gint32 *buffer;
+
+      guint32 value;
+
+      buffer = (gint32 *) mmap_file->buffer;
+
+      for(i = 0; i < frame_count; i++){
+	memcpy(&value, source + i * frame_size, sizeof(guint32));
+
+	buffer[i] = (gint32) (is_big_endian ? GUINT32_FROM_BE(value): GUINT32_FROM_LE(value));
+      }
+    }
+    break;
+  case AGS_SOUNDCARD_FLOAT:
+    {
+      gfloat *buffer;
+
+      guint32 value;
+
+      buffer = (gfloat *) mmap_file->buffer;
+
+      for(i = 0; i < frame_count; i++){
+	memcpy(&value, source + i * frame_size, sizeof(guint32));
+
+	value = (is_big_endian ? GUINT32_FROM_BE(value): GUINT32_FROM_LE(value));
+
+	memcpy(buffer + i, &value, sizeof(gfloat));
+      }
+    }
+    break;
+  case AGS_SOUNDCARD_DOUBLE:
+    {
+      gdouble *buffer;
+
+      guint64 value;
+
+      buffer = (gdouble *) mmap_file->buffer;
+
+      for(i = 0; i < frame_count; i++){
+	memcpy(&value, source + i * frame_size, sizeof(guint64));
+
+	value = (is_big_endian ? GUINT64_FROM_BE(value): GUINT64_FROM_LE(value));
+
+	memcpy(buffer + i, &value, sizeof(gdouble));
+      }
+    }
+    break;
+  }
+}
+
+void
+ags_mmap_file_copy_channel(AgsMmapFile *mmap_file,
+			   void *dbuffer, guint daudio_channels,
+			   guint audio_channel,
+			   guint64 offset,
+			   guint frame_count, guint format)
+{
+  guchar *source;
+
+  guint copy_mode;
+  guint i;
+
+  copy_mode = ags_audio_buffer_util_get_copy_mode(ags_audio_buffer_util_format_from_soundcard(format),
+						  ags_audio_buffer_util_format_from_soundcard(mmap_file->format));
+
+  source = mmap_file->data + offset * mmap_file->frame_size + audio_channel * mmap_file->word_size;
+
+  if((AGS_MMAP_FILE_ZERO_COPY & (mmap_file->flags)) != 0){
+    ags_audio_buffer_util_copy_buffer_to_buffer(dbuffer, daudio_channels, 0,
+						source, mmap_file->audio_channels, 0,
+						frame_count, copy_mode);
+
+    return;
+  }
+
+  for(i = 0; i < frame_count; ){
+    guint read_count;
+
+    read_count = mmap_file->buffer_size;
+
+    if(i + read_count > frame_count){
+      read_count = frame_count - i;
+    }
+
+    ags_mmap_file_unpack(mmap_file,
+			 source + i * mmap_file->frame_size,
+			 read_count);
+
+    ags_audio_buffer_util_copy_buffer_to_buffer(dbuffer, daudio_channels, i * daudio_channels,
+						mmap_file->buffer, 1, 0,
+						read_count, copy_mode);
+
+    i += read_count;
+  }
+}
+
+guint
+ags_mmap_file_read(AgsSoundResource *sound_resource,
+		   void *dbuffer, guint daudio_channels,
+		   guint audio_channel,
+		   guint frame_count, guint format)
+{
+  AgsMmapFile *mmap_file;
+
+  GRecMutex *mmap_file_mutex;
+
+  mmap_file = AGS_MMAP_FILE(sound_resource);
+
+  /* get mmap file mutex */
+  mmap_file_mutex = AGS_MMAP_FILE_GET_OBJ_MUTEX(mmap_file);
+
+  g_rec_mutex_lock(mmap_file_mutex);
+
+  if(mmap_file->data == NULL ||
+     audio_channel >= mmap_file->audio_channels ||
+     mmap_file->offset >= mmap_file->frame_count){
+    g_rec_mutex_unlock(mmap_file_mutex);
+
+    return(0);
+  }
+
+  if(mmap_file->offset + frame_count > mmap_file->frame_count){
+    frame_count = mmap_file->frame_count - mmap_file->offset;
+  }
+
+  ags_mmap_file_copy_channel(mmap_file,
+			     dbuffer, daudio_channels,
+			     audio_channel,
+			     mmap_file->offset,
+			     frame_count, format);
+
+  mmap_file->offset += frame_count;
+
+  g_rec_mutex_unlock(mmap_file_mutex);
+
+  return(frame_count);
+}
+
+guint
+ags_mmap_file_read_channels(AgsSoundResource *sound_resource,
+			    void **dbuffer,
+			    guint frame_count, guint format)
+{
+  AgsMmapFile *mmap_file;
+
+  guint i;
+
+  GRecMutex *mmap_file_mutex;
+
+  mmap_file = AGS_MMAP_FILE(sound_resource);
+
+  /* get mmap file mutex */
+  mmap_file_mutex = AGS_MMAP_FILE_GET_OBJ_MUTEX(mmap_file);
+
+  g_rec_mutex_lock(mmap_file_mutex);
+
+  if(mmap_file->data == NULL ||
+     mmap_file->offset >= mmap_file->frame_count){
+    g_rec_mutex_unlock(mmap_file_mutex);
+
+    return(0);
+  }
+
+  if(mmap_file->offset + frame_count > mmap_file->frame_count){
+    frame_count = mmap_file->frame_count - mmap_file->offset;
+  }
+
+  for(i = 0; i < mmap_file->audio_channels; i++){
+    if(dbuffer[i] == NULL){
+      continue;
+    }
+
+    ags_mmap_file_copy_channel(mmap_file,
+			       dbuffer[i], 1,
+			       i,
+			       mmap_file->offset,
+			       frame_count, format);
+  }
+
+  mmap_file->offset += frame_count;
+
+  g_rec_mutex_unlock(mmap_file_mutex);
+
+  return(frame_count);
+}
+
+void
+ags_mmap_file_seek(AgsSoundResource *sound_resource,
+		   gint64 frame_count, gint whence)
+{
+  AgsMmapFile *mmap_file;
+
+  gint64 offset;
+
+  GRecMutex *mmap_file_mutex;
+
+  mmap_file = AGS_MMAP_FILE(sound_resource);
+
+  /* get mmap file mutex */
+  mmap_file_mutex = AGS_MMAP_FILE_GET_OBJ_MUTEX(mmap_file);
+
+  g_rec_mutex_lock(mmap_file_mutex);
+
+  offset = 0;
+
+  if(whence == G_SEEK_CUR){
+    offset = (gint64) mmap_file->offset + frame_count;
+  }else if(whence == G_SEEK_SET){
+    offset = frame_count;
+  }else if(whence == G_SEEK_END){
+    offset = (gint64) mmap_file->frame_count + frame_count;
+  }
+
+  if(offset < 0){
+    offset = 0;
+  }else if(offset > (gint64) mmap_file->frame_count){
+    offset = mmap_file->frame_count;
+  }
+
+  mmap_file->offset = offset;
+
+  g_rec_mutex_unlock(mmap_file_mutex);
+}
+
+void
+ags_mmap_file_close(AgsSoundResource *sound_resource)
+{
+  AgsMmapFile *mmap_file;
+
+  GRecMutex *mmap_file_mutex;
+
+  mmap_file = AGS_MMAP_FILE(sound_resource);
+
+  /* get mmap file mutex */
+  mmap_file_mutex = AGS_MMAP_FILE_GET_OBJ_MUTEX(mmap_file);
+
+  g_rec_mutex_lock(mmap_file_mutex);
+
+  if(mmap_file->mapped_file != NULL){
+    g_mapped_file_unref(mmap_file->mapped_file);
+
+    mmap_file->mapped_file = NULL;
+  }
+
+  g_free(mmap_file->filename);
+
+  mmap_file->filename = NULL;
+
+  mmap_file->data = NULL;
+  mmap_file->frame_count = 0;
+
+  mmap_file->offset = 0;
+
+  g_rec_mutex_unlock(mmap_file_mutex);
+}
+
+/**
+ * ags_mmap_file_check_suffix:
+ * @filename: the filename
+ *
+ * Check @filename's suffix to be supported, note only uncompressed PCM is
+ * accepted by ags_sound_resource_open().
+ *
+ * Returns: %TRUE if supported, else %FALSE
+ *
+ * Since: 3.7.0
+ */
+gboolean
+ags_mmap_file_check_suffix(gchar *filename)
+{
+  if(g_str_has_suffix(filename, ".wav") ||
+     g_str_has_suffix(filename, ".aif") ||
+     g_str_has_suffix(filename, ".aiff") ||
+     g_str_has_suffix(filename, ".aifc")){
+    return(TRUE);
+  }
+
+  return(FALSE);
+}
+
+/**
+ * ags_mmap_file_new:
+ *
+ * Creates a new instance of #AgsMmapFile.
+ *
+ * Returns: the new #AgsMmapFile.
+ *
+ * Since: 3.7.0
+ */
+AgsMmapFile*
+ags_mmap_file_new()
+{
+  AgsMmapFile *mmap_file;
+
+  mmap_file = (AgsMmapFile *) g_object_new(AGS_TYPE_MMAP_FILE,
+					   NULL);
+
+  return(mmap_file);
+}
@@ -0,0 +1,103 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __AGS_MMAP_FILE_H__
+#define __AGS_MMAP_FILE_H__
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <ags/libags.h>
+
+G_BEGIN_DECLS
+
+#define AGS_TYPE_MMAP_FILE                (ags_mmap_file_get_type())
+#define AGS_MMAP_FILE(obj)                (G_TYPE_CHECK_INSTANCE_CAST((obj), AGS_TYPE_MMAP_FILE, AgsMmapFile))
+#define AGS_MMAP_FILE_CLASS(class)        (G_TYPE_CHECK_CLASS_CAST((class), AGS_TYPE_MMAP_FILE, AgsMmapFileClass))
+#define AGS_IS_MMAP_FILE(obj)             (G_TYPE_CHECK_INSTANCE_TYPE((obj), AGS_TYPE_MMAP_FILE))
+#define AGS_IS_MMAP_FILE_CLASS(class)     (G_TYPE_CHECK_CLASS_TYPE((class), AGS_TYPE_MMAP_FILE))
+#define AGS_MMAP_FILE_GET_CLASS(obj)      (G_TYPE_INSTANCE_GET_CLASS((obj), AGS_TYPE_MMAP_FILE, AgsMmapFileClass))
+
+#define AGS_MMAP_FILE_GET_OBJ_MUTEX(obj) (&(((AgsMmapFile *) obj)->obj_mutex))
+
+typedef struct _AgsMmapFile AgsMmapFile;
+typedef struct _AgsMmapFileClass AgsMmapFileClass;
+
+/**
+ * AgsMmapFileFlags:
+ * @AGS_MMAP_FILE_BIG_ENDIAN: the samples are stored big endian
+ * @AGS_MMAP_FILE_UNSIGNED: the 8 bit samples are stored unsigned
+ * @AGS_MMAP_FILE_ZERO_COPY: the samples are read directly from the mapping
+ *
+ * Enum values to control the behavior or indicate internal state of #AgsMmapFile by
+ * enable/disable as flags.
+ */
+typedef enum{
+  AGS_MMAP_FILE_BIG_ENDIAN         = 1,
+  AGS_MMAP_FILE_UNSIGNED           = 1 <<  1,
+  AGS_MMAP_FILE_ZERO_COPY          = 1 <<  2,
+}AgsMmapFileFlags;
+
+struct _AgsMmapFile
+{
+  GObject gobject;
+
+  guint flags;
+
+  GRecMutex obj_mutex;
+
+  gchar *filename;
+
+  GMappedFile *mapped_file;
+
+  guint audio_channels;
+  guint samplerate;
+
+  guint buffer_size;
+  guint format;
+
+  guint word_size;
+  guint frame_size;
+
+  guchar *data;
+  guint64 frame_count;
+
+  guint64 offset;
+
+  void *buffer;
+};
+
+struct _AgsMmapFileClass
+{
+  GObjectClass gobject;
+};
+
+GType ags_mmap_file_get_type();
+
+gboolean ags_mmap_file_test_flags(AgsMmapFile *mmap_file, guint flags);
+void ags_mmap_file_set_flags(AgsMmapFile *mmap_file, guint flags);
+void ags_mmap_file_unset_flags(AgsMmapFile *mmap_file, guint flags);
+
+gboolean ags_mmap_file_check_suffix(gchar *filename);
+
+AgsMmapFile* ags_mmap_file_new();
+
+G_END_DECLS
+
+#endif /*__AGS_MMAP_FILE_H__*/
@@ -81,6 +81,9 @@ guint ags_sndfile_read(AgsSoundResource *sound_resource,
 		       void *dbuffer, guint daudio_channels,
 		       guint audio_channel,
 		       guint frame_count, guint format);
+guint ags_sndfile_read_channels(AgsSoundResource *sound_resource,
+				void **dbuffer,
+				guint frame_count, guint format);
 void ags_sndfile_write(AgsSoundResource *sound_resource,
 		       void *sbuffer, guint saudio_channels,
 		       guint audio_channel,
@@ -90,6 +93,13 @@ void ags_sndfile_seek(AgsSoundResource *sound_resource,
 		      gint64 frame_count, gint whence);
 void ags_sndfile_close(AgsSoundResource *sound_resource);
 
+guint ags_sndfile_read_deinterleave(AgsSndfile *sndfile,
+				    void **dbuffer, guint daudio_channels,
+				    gint audio_channel,
+				    guint frame_count, guint format);
+sf_count_t ags_sndfile_read_multi_frames(AgsSndfile *sndfile,
+					 sf_count_t multi_frames);
+
 sf_count_t ags_sndfile_vio_get_filelen(void *user_data);
 sf_count_t ags_sndfile_vio_seek(sf_count_t offset, int whence, void *user_data);
 sf_count_t ags_sndfile_vio_read(void *ptr, sf_count_t count, void *user_data);
@@ -308,6 +318,7 @@ ags_sndfile_sound_resource_interface_init(AgsSoundResourceInterface *sound_resou
   sound_resource->get_presets = ags_sndfile_get_presets;
   
   sound_resource->read = ags_sndfile_read;
+  sound_resource->read_channels = ags_sndfile_read_channels;
 
   sound_resource->write = ags_sndfile_write;
   sound_resource->flush = ags_sndfile_flush;
@@ -860,9 +871,12 @@ ags_sndfile_open(AgsSoundResource *sound_resource,
 	   SF_FORMAT_DOUBLE) & sndfile->info->format)){
   case SF_FORMAT_PCM_S8:
   {
-    //TODO:JK: implement me
-    //format = AGS_SOUNDCARD_SIGNED_8_BIT;
-    format = AGS_SOUNDCARD_DOUBLE;
+    /* raw access isn't available for compressed containers */
+    if((SF_FORMAT_TYPEMASK & sndfile->info->format) != SF_FORMAT_FLAC){
+      format = AGS_SOUNDCARD_SIGNED_8_BIT;
+    }else{
+      format = AGS_SOUNDCARD_SIGNED_16_BIT;
+    }
   }
   break;
   case SF_FORMAT_PCM_16:
@@ -872,16 +886,12 @@ ags_sndfile_open(AgsSoundResource *sound_resource,
   break;
   case SF_FORMAT_PCM_24:
   {
-    //TODO:JK: implement me
-    //format = AGS_SOUNDCARD_SIGNED_24_BIT;
-    format = AGS_SOUNDCARD_DOUBLE;
+    format = AGS_SOUNDCARD_SIGNED_24_BIT;
   }
   break;
   case SF_FORMAT_PCM_32:
   {
-    //TODO:JK: implement me
-    //format = AGS_SOUNDCARD_SIGNED_32_BIT;
-    format = AGS_SOUNDCARD_DOUBLE;
+    format = AGS_SOUNDCARD_SIGNED_32_BIT;
   }
   break;
   case SF_FORMAT_FLOAT:
@@ -1270,25 +1280,44 @@ ags_sndfile_read(AgsSoundResource *sound_resource,
 		 guint audio_channel,
 		 guint frame_count, guint format)
 {
-  AgsSndfile *sndfile;
+  return(ags_sndfile_read_deinterleave(AGS_SNDFILE(sound_resource),
+				       &dbuffer, daudio_channels,
+				       audio_channel,
+				       frame_count, format));
+}
+
+guint
+ags_sndfile_read_channels(AgsSoundResource *sound_resource,
+			  void **dbuffer,
+			  guint frame_count, guint format)
+{
+  /* decode each block once and deinterleave all channels */
+  return(ags_sndfile_read_deinterleave(AGS_SNDFILE(sound_resource),
+				       dbuffer, 1,
+				       -1,
+				       frame_count, format));
+}
 
+guint
+ags_sndfile_read_deinterleave(AgsSndfile *sndfile,
+			      void **dbuffer, guint daudio_channels,
+			      gint audio_channel,
+			      guint frame_count, guint format)
+{
   sf_count_t multi_frames;
   guint total_frame_count;
   guint read_count;
   guint copy_mode;
-  gboolean use_cache;
-  guint i;
+  guint i, j;
 
   GRecMutex *sndfile_mutex;
 
-  sndfile = AGS_SNDFILE(sound_resource);
-
   /* get sndfile mutex */
   sndfile_mutex = AGS_SNDFILE_GET_OBJ_MUTEX(sndfile);
 
   total_frame_count = 0;
 
-  ags_sound_resource_info(sound_resource,
+  ags_sound_resource_info(AGS_SOUND_RESOURCE(sndfile),
 			  &total_frame_count,
 			  NULL, NULL);
   
@@ -1301,32 +1330,17 @@ ags_sndfile_read(AgsSoundResource *sound_resource,
   }
 
   if(sndfile->offset + frame_count >= total_frame_count){
-    if(total_frame_count > sndfile->offset){
-      frame_count = total_frame_count - sndfile->offset;
-    }else{
-      g_rec_mutex_unlock(sndfile_mutex);
-    
-      return(0);
-    }
+    frame_count = total_frame_count - sndfile->offset;
   }
 
-#if 0
-  use_cache = FALSE;
-
-  if(sndfile->buffer_offset == sndfile->offset &&
-     frame_count <= sndfile->buffer_size){
-    use_cache = TRUE;
-  }
-#endif
-  
   sndfile->buffer_offset = sndfile->offset;
   
   read_count = sndfile->buffer_size;
 
   copy_mode = ags_audio_buffer_util_get_copy_mode(ags_audio_buffer_util_format_from_soundcard(format),
 						  ags_audio_buffer_util_format_from_soundcard(sndfile->format));
-      
-  for(i = 0; i < frame_count && sndfile->offset + i < total_frame_count; ){
+
+  for(i = 0; i < frame_count && sndfile->offset < total_frame_count; ){
     sf_count_t retval;
     
     if(sndfile->offset + read_count > total_frame_count){
@@ -1339,62 +1353,35 @@ ags_sndfile_read(AgsSoundResource *sound_resource,
     
     multi_frames = read_count * sndfile->info->channels;
 
-    retval = -1;
-    
-    //    if(!use_cache){
-    //      g_message("read %d %d", sndfile->offset, sndfile->buffer_size);
-      
-      switch(sndfile->format){
-      case AGS_SOUNDCARD_SIGNED_8_BIT:
-	{
-	  //TODO:JK: implement me
-	  retval = 0;
-	}
-	break;
-      case AGS_SOUNDCARD_SIGNED_16_BIT:
-	{
-	  retval = sf_read_short(sndfile->file, sndfile->buffer, multi_frames);
-	}
-	break;
-      case AGS_SOUNDCARD_SIGNED_24_BIT:
-	{
-	  //TODO:JK: implement me
-	  retval = 0;
-	}
-	break;
-      case AGS_SOUNDCARD_SIGNED_32_BIT:
-	{
-	  //TODO:JK: implement me
-	  retval = 0;
-	}
-	break;
-      case AGS_SOUNDCARD_FLOAT:
-	{
-	  retval = sf_read_float(sndfile->file, sndfile->buffer, multi_frames);
-	}
-	break;
-      case AGS_SOUNDCARD_DOUBLE:
-	{
-	  retval = sf_read_double(sndfile->file, sndfile->buffer, multi_frames);
-	}
-	break;
-      }
+    retval = ags_sndfile_read_multi_frames(sndfile,
+					   multi_frames);
 
-      sndfile->offset += read_count;
+    sndfile->offset += read_count;
       
-      if(retval == -1){
-	g_warning("read failed");
-      }
+    if(retval == -1){
+      g_warning("read failed");
+    }
 
-      if(retval != multi_frames){
-	break;
-      }    
-      //    }
+    if(retval != multi_frames){
+      break;
+    }    
 
-    ags_audio_buffer_util_copy_buffer_to_buffer(dbuffer, daudio_channels, (i * daudio_channels),
-						sndfile->buffer, sndfile->info->channels, audio_channel,
-						read_count, copy_mode);
-    //    g_message("[%d] %d", audio_channel, ags_synth_util_get_xcross_count_s16(dbuffer, read_count));
+    if(audio_channel >= 0){
+      /* single channel interleaved into the destination */
+      ags_audio_buffer_util_copy_buffer_to_buffer(dbuffer[0], daudio_channels, (i * daudio_channels),
+						  sndfile->buffer, sndfile->info->channels, audio_channel,
+						  read_count, copy_mode);
+    }else{
+      for(j = 0; j < sndfile->info->channels; j++){
+	if(dbuffer[j] == NULL){
+	  continue;
+	}
+      
+	ags_audio_buffer_util_copy_buffer_to_buffer(dbuffer[j], daudio_channels, (i * daudio_channels),
+						    sndfile->buffer, sndfile->info->channels, j,
+						    read_count, copy_mode);
+      }
+    }
     
     i += read_count;
   }
@@ -1404,6 +1391,62 @@ ags_sndfile_read(AgsSoundResource *sound_resource,
   return(frame_count);
 }
 
+sf_count_t
+ags_sndfile_read_multi_frames(AgsSndfile *sndfile,
+			      sf_count_t multi_frames)
+{
+  sf_count_t retval;
+
+  retval = -1;
+  
+  switch(sndfile->format){
+  case AGS_SOUNDCARD_SIGNED_8_BIT:
+    {
+      /* PCM_S8 raw data is the sample itself */
+      retval = sf_read_raw(sndfile->file, sndfile->buffer, multi_frames);
+    }
+    break;
+  case AGS_SOUNDCARD_SIGNED_16_BIT:
+    {
+      retval = sf_read_short(sndfile->file, sndfile->buffer, multi_frames);
+    }
+    break;
+  case AGS_SOUNDCARD_SIGNED_24_BIT:
+    {
+      gint32 *buffer;
+
+      sf_count_t i;
+
+      retval = sf_read_int(sndfile->file, sndfile->buffer, multi_frames);
+
+      /* libsndfile returns the 24 bit sample left aligned */
+      buffer = (gint32 *) sndfile->buffer;
+
+      for(i = 0; i < retval; i++){
+	buffer[i] = buffer[i] >> 8;
+      }
+    }
+    break;
+  case AGS_SOUNDCARD_SIGNED_32_BIT:
+    {
+      retval = sf_read_int(sndfile->file, sndfile->buffer, multi_frames);
+    }
+    break;
+  case AGS_SOUNDCARD_FLOAT:
+    {
+      retval = sf_read_float(sndfile->file, sndfile->buffer, multi_frames);
+    }
+    break;
+  case AGS_SOUNDCARD_DOUBLE:
+    {
+      retval = sf_read_double(sndfile->file, sndfile->buffer, multi_frames);
+    }
+    break;
+  }
+
+  return(retval);
+}
+
 void
 ags_sndfile_write(AgsSoundResource *sound_resource,
 		  void *sbuffer, guint saudio_channels,
@@ -1450,7 +1493,8 @@ ags_sndfile_write(AgsSoundResource *sound_resource,
     switch(sndfile->format){
     case AGS_SOUNDCARD_SIGNED_8_BIT:
       {
-	//TODO:JK: implement me
+	/* PCM_S8 raw data is the sample itself */
+	sf_write_raw(sndfile->file, sndfile->buffer, multi_frames);
       }
       break;
     case AGS_SOUNDCARD_SIGNED_16_BIT:
@@ -1460,12 +1504,23 @@ ags_sndfile_write(AgsSoundResource *sound_resource,
       break;
     case AGS_SOUNDCARD_SIGNED_24_BIT:
       {
-	//TODO:JK: implement me
+	gint32 *buffer;
+
+	sf_count_t j;
+
+	/* libsndfile expects the 24 bit sample left aligned, the buffer is cleared afterwards */
+	buffer = (gint32 *) sndfile->buffer;
+
+	for(j = 0; j < multi_frames; j++){
+	  buffer[j] = (gint32) ((guint32) buffer[j] << 8);
+	}
+
+	sf_write_int(sndfile->file, buffer, multi_frames);
       }
       break;
     case AGS_SOUNDCARD_SIGNED_32_BIT:
       {
-	//TODO:JK: implement me
+	sf_write_int(sndfile->file, sndfile->buffer, multi_frames);
       }
       break;
     case AGS_SOUNDCARD_FLOAT:
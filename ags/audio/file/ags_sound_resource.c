@@ -25,11 +25,25 @@
 #include <ags/audio/ags_buffer.h>
 #include <ags/audio/ags_audio_signal.h>
 #include <ags/audio/ags_audio_buffer_util.h>
+#include <ags/audio/ags_resampler.h>
 
 #include <math.h>
 
 void ags_sound_resource_base_init(AgsSoundResourceInterface *ginterface);
 
+guint ags_sound_resource_read_block(AgsSoundResource *sound_resource,
+				     void **dbuffer, guint audio_channels,
+				     guint64 offset,
+				     guint frame_count, guint format);
+guint ags_sound_resource_read_resample(AgsSoundResource *sound_resource,
+				       AgsResampler **resampler,
+				       void **data, guint buffer_size,
+				       void *tmp_data,
+				       void **target_data, guint target_buffer_size,
+				       guint audio_channels,
+				       guint64 *offset,
+				       guint format);
+
 /**
  * SECTION:ags_sound_resource
  * @short_description: read/write audio
@@ -283,6 +297,40 @@ ags_sound_resource_read(AgsSoundResource *sound_resource,
   return(retval);
 }
 
+/**
+ * ags_sound_resource_read_channels:
+ * @sound_resource: the #AgsSoundResource
+ * @dbuffer: (array): the destination buffers, one per audio channel or %NULL to skip it
+ * @frame_count: the frame count to read
+ * @format: the format to read
+ * 
+ * Read @frame_count number of frames of all audio channels from @sound_resource.
+ * Each block is decoded once and deinterleaved to @dbuffer.
+ * 
+ * Returns: the count of frames actually read
+ * 
+ * Since: 3.7.0
+ */
+guint
+ags_sound_resource_read_channels(AgsSoundResource *sound_resource,
+				 void **dbuffer,
+				 guint frame_count, guint format)
+{
+  AgsSoundResourceInterface *sound_resource_interface;
+
+  guint retval;
+  
+  g_return_val_if_fail(AGS_IS_SOUND_RESOURCE(sound_resource), 0);
+  sound_resource_interface = AGS_SOUND_RESOURCE_GET_INTERFACE(sound_resource);
+  g_return_val_if_fail(sound_resource_interface->read_channels, 0);
+
+  retval = sound_resource_interface->read_channels(sound_resource,
+						   dbuffer,
+						   frame_count, format);
+  
+  return(retval);
+}
+
 /**
  * ags_sound_resource_write:
  * @sound_resource: the #AgsSoundResource
@@ -375,13 +423,132 @@ ags_sound_resource_close(AgsSoundResource *sound_resource)
   sound_resource_interface->close(sound_resource);
 }
 
+guint
+ags_sound_resource_read_block(AgsSoundResource *sound_resource,
+			      void **dbuffer, guint audio_channels,
+			      guint64 offset,
+			      guint frame_count, guint format)
+{
+  AgsSoundResourceInterface *sound_resource_interface;
+
+  guint num_read;
+  guint i;
+
+  sound_resource_interface = AGS_SOUND_RESOURCE_GET_INTERFACE(sound_resource);
+
+  if(sound_resource_interface->read_channels != NULL){
+    num_read = ags_sound_resource_read_channels(sound_resource,
+						dbuffer,
+						frame_count, format);
+
+    return(num_read);
+  }
+
+  /* fallback - read channel by channel */
+  num_read = 0;
+  
+  for(i = 0; i < audio_channels; i++){
+    if(dbuffer[i] == NULL){
+      continue;
+    }
+
+    ags_sound_resource_seek(sound_resource,
+			    offset, G_SEEK_SET);
+
+    num_read = ags_sound_resource_read(sound_resource,
+				       dbuffer[i], 1,
+				       i,
+				       frame_count, format);
+  }
+
+  return(num_read);
+}
+
+guint
+ags_sound_resource_read_resample(AgsSoundResource *sound_resource,
+				 AgsResampler **resampler,
+				 void **data, guint buffer_size,
+				 void *tmp_data,
+				 void **target_data, guint target_buffer_size,
+				 guint audio_channels,
+				 guint64 *offset,
+				 guint format)
+{
+  guint buffer_format;
+  guint copy_mode;
+  guint current_read;
+  guint written, current_written;
+  guint i;
+
+  buffer_format = ags_audio_buffer_util_format_from_soundcard(format);
+
+  copy_mode = ags_audio_buffer_util_get_copy_mode(buffer_format,
+						  buffer_format);
+
+  for(i = 0; i < audio_channels; i++){
+    if(target_data[i] != NULL){
+      ags_audio_buffer_util_clear_buffer(target_data[i], 1,
+					 target_buffer_size, buffer_format);
+    }
+  }
+  
+  written = 0;
+
+  /* the filter needs look-ahead, so the first block might not fill target */
+  do{
+    for(i = 0; i < audio_channels; i++){
+      if(data[i] != NULL){
+	ags_audio_buffer_util_clear_buffer(data[i], 1,
+					   buffer_size, buffer_format);
+      }
+    }
+
+    current_read = ags_sound_resource_read_block(sound_resource,
+						 data, audio_channels,
+						 offset[0],
+						 buffer_size, format);
+    offset[0] += current_read;
+
+    /* all channels share the ratio, so they produce the same count of frames,
+     * at end of file the look-ahead kept by the filter is flushed
+     */
+    current_written = 0;
+    
+    for(i = 0; i < audio_channels; i++){
+      if(data[i] == NULL){
+	continue;
+      }
+
+      ags_audio_buffer_util_clear_buffer(tmp_data, 1,
+					 target_buffer_size, buffer_format);
+
+      current_written = ags_resampler_process(resampler[i],
+					      data[i], buffer_format,
+					      current_read,
+					      tmp_data, buffer_format,
+					      target_buffer_size - written,
+					      ((current_read == 0) ? TRUE: FALSE));
+
+      ags_audio_buffer_util_copy_buffer_to_buffer(target_data[i], 1, written,
+						  tmp_data, 1, 0,
+						  current_written, copy_mode);
+    }
+
+    written += current_written;
+  }while(written < target_buffer_size &&
+	 current_read > 0);
+
+  return(written);
+}
+
 /**
  * ags_sound_resource_read_audio_signal:
  * @sound_resource: the #AgsSoundResource
  * @soundcard: the #AgsSoundcard
  * @audio_channel: the audio channel or -1 for all
  * 
- * Read audio signal from @sound_resource.
+ * Read audio signal from @sound_resource. All audio channels are
+ * read in one pass.
  * 
  * Returns: (element-type AgsAudio.AudioSignal) (transfer full): a #GList-struct containing #AgsAudioSignal
  * 
@@ -393,9 +560,14 @@ ags_sound_resource_read_audio_signal(AgsSoundResource *sound_resource,
 				     gint audio_channel)
 {
   GList *start_list;
+  GList **stream;
+
+  AgsResampler **resampler;
 
-  void *target_data, *data;
+  void **target_data, **data;
+  void *tmp_data;
 
+  guint64 offset;
   guint frame_count;
   guint loop_start, loop_end;
   guint audio_channels;
@@ -403,7 +575,9 @@ ags_sound_resource_read_audio_signal(AgsSoundResource *sound_resource,
   guint target_buffer_size, buffer_size;
   guint target_format, format;
   guint copy_mode;
+  guint stream_length;
   guint i, i_start, i_stop;
+  guint j;
 
   if(!AGS_SOUND_RESOURCE(sound_resource)){
     return(NULL);
@@ -448,12 +622,31 @@ ags_sound_resource_read_audio_signal(AgsSoundResource *sound_resource,
     i_start = audio_channel;
     i_stop = i_start + 1;
   }
+
+  if(i_stop > audio_channels){
+    return(NULL);
+  }
   
   copy_mode = ags_audio_buffer_util_get_copy_mode(ags_audio_buffer_util_format_from_soundcard(target_format),
 						  ags_audio_buffer_util_format_from_soundcard(format));
 
-  data = NULL;
-  target_data = NULL;
+  stream = (GList **) malloc(audio_channels * sizeof(GList *));
+
+  resampler = (AgsResampler **) malloc(audio_channels * sizeof(AgsResampler *));
+
+  data = (void **) malloc(audio_channels * sizeof(void *));
+  target_data = (void **) malloc(audio_channels * sizeof(void *));
+
+  for(i = 0; i < audio_channels; i++){
+    stream[i] = NULL;
+
+    resampler[i] = NULL;
+    
+    data[i] = NULL;
+    target_data[i] = NULL;
+  }
+  
+  tmp_data = NULL;
   
   if(samplerate != target_samplerate){
     buffer_size = (guint) ceil((double) target_buffer_size / (double) target_samplerate * (double) samplerate);
@@ -463,20 +656,27 @@ ags_sound_resource_read_audio_signal(AgsSoundResource *sound_resource,
 				   samplerate,
 				   buffer_size,
 				   format);
-    
-    data = ags_stream_alloc(buffer_size,
-			    format);
-    target_data = ags_stream_alloc(target_buffer_size,
-				   format);
+
+    tmp_data = ags_stream_alloc(target_buffer_size,
+				format);
+
+    for(i = i_start; i < i_stop; i++){
+      data[i] = ags_stream_alloc(buffer_size,
+				 format);
+      target_data[i] = ags_stream_alloc(target_buffer_size,
+					format);
+
+      resampler[i] = ags_resampler_new(1,
+				       samplerate,
+				       target_samplerate,
+				       AGS_RESAMPLER_BEST_QUALITY);
+    }
   }
-    
+
+  stream_length = (guint) ceil(frame_count / target_buffer_size) + 1;
+  
   for(i = i_start; i < i_stop; i++){
     AgsAudioSignal *audio_signal;
-
-    GList *stream;
-
-    ags_sound_resource_seek(AGS_SOUND_RESOURCE(sound_resource),
-    			    0, G_SEEK_SET);
     
     audio_signal = ags_audio_signal_new(soundcard,
 					NULL,
@@ -490,68 +690,78 @@ ags_sound_resource_read_audio_signal(AgsSoundResource *sound_resource,
 		 "loop-end", target_samplerate * (loop_end / samplerate),
 		 NULL);
     ags_audio_signal_stream_resize(audio_signal,
-				   (guint) ceil(frame_count / target_buffer_size) + 1);
-    audio_signal->length = (guint) ceil(frame_count / target_buffer_size) + 1;
+				   stream_length);
+    audio_signal->length = stream_length;
     audio_signal->stream_current = audio_signal->stream;
     
     start_list = g_list_prepend(start_list,
 				audio_signal);
 
-    stream = audio_signal->stream;
+    stream[i] = audio_signal->stream;
 
     g_object_set(audio_signal,
 		 "last-frame", frame_count,
 		 NULL);
-    
-    while(stream != NULL){
-      if(samplerate != target_samplerate){
-	if(format == AGS_SOUNDCARD_DOUBLE){
-	  ags_audio_buffer_util_clear_double(data, 1,
-					     buffer_size);
-	}else if(format == AGS_SOUNDCARD_FLOAT){
-	  ags_audio_buffer_util_clear_float(data, 1,
-					    buffer_size);
-	}else{
-	  ags_audio_buffer_util_clear_buffer(data, 1,
-					     buffer_size, ags_audio_buffer_util_format_from_soundcard(format));
-	}
-	
-	ags_sound_resource_read(AGS_SOUND_RESOURCE(sound_resource),
-				data, 1,
-				i,
-				buffer_size, format);
-
-	ags_audio_buffer_util_clear_buffer(target_data, 1,
-					   target_buffer_size, ags_audio_buffer_util_format_from_soundcard(format));
-	ags_audio_buffer_util_resample_with_buffer(data, 1,
-						   ags_audio_buffer_util_format_from_soundcard(format), samplerate,
-						   buffer_size,
-						   target_samplerate,
-						   target_buffer_size,
-						   target_data);
-
-	ags_audio_buffer_util_copy_buffer_to_buffer(stream->data, 1, 0,
-						    target_data, 1, 0,
+  }
+
+  /* read all audio channels in one pass */
+  ags_sound_resource_seek(AGS_SOUND_RESOURCE(sound_resource),
+			  0, G_SEEK_SET);
+
+  offset = 0;
+  
+  for(j = 0; j < stream_length; j++){
+    if(samplerate != target_samplerate){
+      ags_sound_resource_read_resample(AGS_SOUND_RESOURCE(sound_resource),
+				       resampler,
+				       data, buffer_size,
+				       tmp_data,
+				       target_data, target_buffer_size,
+				       audio_channels,
+				       &offset,
+				       format);
+
+      for(i = i_start; i < i_stop; i++){
+	ags_audio_buffer_util_copy_buffer_to_buffer(stream[i]->data, 1, 0,
+						    target_data[i], 1, 0,
 						    target_buffer_size, copy_mode);
-      }else{
-	ags_sound_resource_read(AGS_SOUND_RESOURCE(sound_resource),
-				stream->data, 1,
-				i,
-				target_buffer_size, target_format);
+      }
+    }else{
+      for(i = i_start; i < i_stop; i++){
+	data[i] = stream[i]->data;
       }
       
-      /* iterate */
-      stream = stream->next;
+      offset += ags_sound_resource_read_block(AGS_SOUND_RESOURCE(sound_resource),
+					      data, audio_channels,
+					      offset,
+					      target_buffer_size, target_format);
+    }
+      
+    /* iterate */
+    for(i = i_start; i < i_stop; i++){
+      stream[i] = stream[i]->next;
     }
   }
 
-  if(data != NULL){
-    free(data);
+  for(i = i_start; i < i_stop; i++){
+    if(resampler[i] != NULL){
+      free(data[i]);
+      free(target_data[i]);
+
+      g_object_unref(resampler[i]);
+    }
   }
 
-  if(target_data != NULL){
-    free(target_data);
+  if(tmp_data != NULL){
+    free(tmp_data);
   }
+
+  free(stream);
+
+  free(resampler);
+  
+  free(data);
+  free(target_data);
   
   start_list = g_list_reverse(start_list);
 
@@ -571,7 +781,8 @@ ags_sound_resource_read_audio_signal(AgsSoundResource *sound_resource,
  * @delay: the delay
  * @attack: the attack
  * 
- * Read wave from @sound_resource.
+ * Read wave from @sound_resource. All audio channels are read
+ * in one pass.
  * 
  * Returns: (element-type AgsAudio.Wave) (transfer full): a #GList-struct containing #AgsWave
  * 
@@ -584,14 +795,20 @@ ags_sound_resource_read_wave(AgsSoundResource *sound_resource,
 			     guint64 x_offset,
 			     gdouble delay, guint attack)
 {
+  AgsWave **wave;
+  AgsBuffer **buffer;
+  AgsResampler **resampler;
+  
   GList *start_list;
 
-  void *target_data, *data;
+  void **target_data, **data;
+  void *tmp_data;
 
   guint copy_mode;
   guint64 relative_offset;
   guint64 x_point_offset;
   guint64 current_offset;
+  guint64 offset;
   guint frame_count;
   guint audio_channels;
   guint target_samplerate, samplerate;
@@ -645,11 +862,32 @@ ags_sound_resource_read_wave(AgsSoundResource *sound_resource,
     i_stop = i_start + 1;
   }
 
+  if(i_stop > audio_channels){
+    return(NULL);
+  }
+
   copy_mode = ags_audio_buffer_util_get_copy_mode(ags_audio_buffer_util_format_from_soundcard(target_format),
 						  ags_audio_buffer_util_format_from_soundcard(format));
-  
-  data = NULL;
-  target_data = NULL;
+
+  wave = (AgsWave **) malloc(audio_channels * sizeof(AgsWave *));
+  buffer = (AgsBuffer **) malloc(audio_channels * sizeof(AgsBuffer *));
+
+  resampler = (AgsResampler **) malloc(audio_channels * sizeof(AgsResampler *));
+
+  data = (void **) malloc(audio_channels * sizeof(void *));
+  target_data = (void **) malloc(audio_channels * sizeof(void *));
+
+  for(i = 0; i < audio_channels; i++){
+    wave[i] = NULL;
+    buffer[i] = NULL;
+
+    resampler[i] = NULL;
+    
+    data[i] = NULL;
+    target_data[i] = NULL;
+  }
+
+  tmp_data = NULL;
   
   if(samplerate != target_samplerate){
     buffer_size = (guint) ceil((double) target_buffer_size / (double) target_samplerate * (double) samplerate);
@@ -659,122 +897,133 @@ ags_sound_resource_read_wave(AgsSoundResource *sound_resource,
 				   samplerate,
 				   buffer_size,
 				   format);
-    
-    data = ags_stream_alloc(buffer_size,
-			    format);
-    target_data = ags_stream_alloc(target_buffer_size,
-				   format);
+
+    tmp_data = ags_stream_alloc(target_buffer_size,
+				format);
+
+    for(i = i_start; i < i_stop; i++){
+      data[i] = ags_stream_alloc(buffer_size,
+				 format);
+      target_data[i] = ags_stream_alloc(target_buffer_size,
+					format);
+
+      resampler[i] = ags_resampler_new(1,
+				       samplerate,
+				       target_samplerate,
+				       AGS_RESAMPLER_BEST_QUALITY);
+    }
+
+    /* ags_sound_resource_read_resample() counts frames of target samplerate */
+    frame_count = (guint) ceil((double) frame_count / (double) samplerate * (double) target_samplerate);
   }
   
   for(i = i_start; i < i_stop; i++){
-    AgsWave *wave;
-
-    gboolean success;
-
-    ags_sound_resource_seek(AGS_SOUND_RESOURCE(sound_resource),
-			    0, G_SEEK_SET);
-    
-    wave = ags_wave_new(NULL,
-			i);
-    g_object_set(wave,
+    wave[i] = ags_wave_new(NULL,
+			   i);
+    g_object_set(wave[i],
 		 "samplerate", target_samplerate,
 		 "buffer-size", target_buffer_size,
 		 "format", target_format,
 		 NULL);
 
     start_list = ags_wave_add(start_list,
-			      wave);
+			      wave[i]);
+  }
+
+  /* read all audio channels in one pass */
+  ags_sound_resource_seek(AGS_SOUND_RESOURCE(sound_resource),
+			  0, G_SEEK_SET);
     
-    relative_offset = AGS_WAVE_DEFAULT_BUFFER_LENGTH * target_samplerate;
+  relative_offset = AGS_WAVE_DEFAULT_BUFFER_LENGTH * target_samplerate;
     
-    x_point_offset = x_offset;
+  x_point_offset = x_offset;
       
-    current_offset = 0;
+  current_offset = 0;
+  offset = 0;
     
-    while(current_offset < frame_count){
-      AgsBuffer *buffer;
-
-      guint read_count;
-      guint num_read;
-      gboolean create_wave;
+  while(current_offset < frame_count){
+    guint read_count;
+    guint num_read;
+    gboolean create_wave;
       
-      create_wave = FALSE;
+    create_wave = FALSE;
 
-      read_count = target_buffer_size;
+    read_count = target_buffer_size;
   
-      if(x_point_offset + read_count > relative_offset * floor(x_point_offset / relative_offset) + relative_offset){
-	read_count = relative_offset * floor((x_point_offset + read_count) / relative_offset) - x_point_offset;
+    if(x_point_offset + read_count > relative_offset * floor(x_point_offset / relative_offset) + relative_offset){
+      read_count = relative_offset * floor((x_point_offset + read_count) / relative_offset) - x_point_offset;
 
-	create_wave = TRUE;
-      }else if(x_point_offset + read_count == relative_offset * floor(x_point_offset / relative_offset) + relative_offset){
-	create_wave = TRUE;
-      }
-      
-      buffer = ags_buffer_new();
-      g_object_set(buffer,
+      create_wave = TRUE;
+    }else if(x_point_offset + read_count == relative_offset * floor(x_point_offset / relative_offset) + relative_offset){
+      create_wave = TRUE;
+    }
+
+    for(i = i_start; i < i_stop; i++){
+      buffer[i] = ags_buffer_new();
+      g_object_set(buffer[i],
 		   "x", x_point_offset,
 		   "samplerate", target_samplerate,
 		   "buffer-size", target_buffer_size,
 		   "format", target_format,
 		   NULL);
-
-      if(samplerate != target_samplerate){
-	if(format == AGS_SOUNDCARD_DOUBLE){
-	  ags_audio_buffer_util_clear_double(data, 1,
-					     buffer_size);
-	}else if(format == AGS_SOUNDCARD_FLOAT){
-	  ags_audio_buffer_util_clear_float(data, 1,
-					    buffer_size);
-	}else{
-	  ags_audio_buffer_util_clear_buffer(data, 1,
-					     buffer_size, ags_audio_buffer_util_format_from_soundcard(format));
-	}
-	
-	num_read = ags_sound_resource_read(AGS_SOUND_RESOURCE(sound_resource),
-					   data, 1,
-					   i,
-					   buffer_size, format);
-
-	ags_audio_buffer_util_clear_buffer(target_data, 1,
-					   target_buffer_size, ags_audio_buffer_util_format_from_soundcard(format));
-	ags_audio_buffer_util_resample_with_buffer(data, 1,
-						   ags_audio_buffer_util_format_from_soundcard(format), samplerate,
-						   buffer_size,
-						   target_samplerate,
-						   target_buffer_size,
-						   target_data);
-
-	ags_audio_buffer_util_copy_buffer_to_buffer(buffer->data, 1, 0,
-						    target_data, 1, 0,
+    }
+    
+    if(samplerate != target_samplerate){
+      num_read = ags_sound_resource_read_resample(AGS_SOUND_RESOURCE(sound_resource),
+						  resampler,
+						  data, buffer_size,
+						  tmp_data,
+						  target_data, target_buffer_size,
+						  audio_channels,
+						  &offset,
+						  format);
+
+      for(i = i_start; i < i_stop; i++){
+	ags_audio_buffer_util_copy_buffer_to_buffer(buffer[i]->data, 1, 0,
+						    target_data[i], 1, 0,
 						    target_buffer_size, copy_mode);
-      }else{
-	num_read = ags_sound_resource_read(AGS_SOUND_RESOURCE(sound_resource),
-					   buffer->data, 1,
-					   i,
-					   read_count, target_format);
       }
-      //      g_message("read %d[%d-%d]: %d", read_count, i, i_stop, num_read);
+    }else{
+      for(i = i_start; i < i_stop; i++){
+	data[i] = buffer[i]->data;
+      }
+
+      num_read = ags_sound_resource_read_block(AGS_SOUND_RESOURCE(sound_resource),
+					       data, audio_channels,
+					       offset,
+					       read_count, target_format);
+
+      offset += num_read;
+    }
+    //      g_message("read %d[%d-%d]: %d", read_count, i_start, i_stop, num_read);
 
-      if(num_read == 0){
-	break;
+    if(num_read == 0){
+      for(i = i_start; i < i_stop; i++){
+	g_object_unref(buffer[i]);
       }
       
-      ags_wave_add_buffer(wave,
-			  buffer,
+      break;
+    }
+
+    for(i = i_start; i < i_stop; i++){
+      ags_wave_add_buffer(wave[i],
+			  buffer[i],
 			  FALSE);
-      
-      if(create_wave){
+    }
+    
+    if(create_wave){
+      for(i = i_start; i < i_stop; i++){
 	AgsTimestamp *timestamp;
 
-	wave = ags_wave_new(NULL,
-			    i);
-	g_object_set(wave,
+	wave[i] = ags_wave_new(NULL,
+			       i);
+	g_object_set(wave[i],
 		     "samplerate", target_samplerate,
 		     "buffer-size", target_buffer_size,
 		     "format", target_format,
 		     NULL);
 
-	g_object_get(wave,
+	g_object_get(wave[i],
 		     "timestamp", &timestamp,
 		     NULL);
 	ags_timestamp_set_ags_offset(timestamp,
@@ -783,24 +1032,36 @@ ags_sound_resource_read_wave(AgsSoundResource *sound_resource,
 	g_object_unref(timestamp);
 
 	start_list = ags_wave_add(start_list,
-				  wave);
-
+				  wave[i]);
       }
+    }
             
-      /* iterate */
-      x_point_offset += read_count;
+    /* iterate */
+    x_point_offset += read_count;
+
+    current_offset += num_read;
+  }
 
-      current_offset += num_read;
+  for(i = i_start; i < i_stop; i++){
+    if(resampler[i] != NULL){
+      free(data[i]);
+      free(target_data[i]);
+
+      g_object_unref(resampler[i]);
     }
   }
   
-  if(data != NULL){
-    free(data);
+  if(tmp_data != NULL){
+    free(tmp_data);
   }
+
+  free(wave);
+  free(buffer);
+
+  free(resampler);
   
-  if(target_data != NULL){
-    free(target_data);
-  }  
+  free(data);
+  free(target_data);
 
   g_list_foreach(start_list,
 		 (GFunc) g_object_ref,
@@ -72,6 +72,9 @@ struct _AgsSoundResourceInterface
 		void *dbuffer, guint daudio_channels,
 		guint audio_channel,
 		guint frame_count, guint format);
+  guint (*read_channels)(AgsSoundResource *sound_resource,
+			 void **dbuffer,
+			 guint frame_count, guint format);
 
   /* write sample data */
   void (*write)(AgsSoundResource *sound_resource,
@@ -119,6 +122,9 @@ guint ags_sound_resource_read(AgsSoundResource *sound_resource,
 			      void *dbuffer, guint daudio_channels,
 			      guint audio_channel,
 			      guint frame_count, guint format);
+guint ags_sound_resource_read_channels(AgsSoundResource *sound_resource,
+				       void **dbuffer,
+				       guint frame_count, guint format);
 
 /* write sample data */
 void ags_sound_resource_write(AgsSoundResource *sound_resource,
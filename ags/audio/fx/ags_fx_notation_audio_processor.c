@@ -1203,7 +1203,7 @@ ags_fx_notation_audio_processor_real_play(AgsFxNotationAudioProcessor *fx_notati
 
   AgsTimestamp *timestamp;
   
-  GList *start_notation, *notation;
+  GObject *notation;
 
   guint64 offset_counter;
   guint audio_channel;
@@ -1221,10 +1221,6 @@ ags_fx_notation_audio_processor_real_play(AgsFxNotationAudioProcessor *fx_notati
     return;
   }
   
-  g_object_get(audio,
-	       "notation", &start_notation,
-	       NULL);
-  
   /* timestamp and offset counter */
   g_rec_mutex_lock(fx_notation_audio_processor_mutex);
     
@@ -1237,37 +1233,33 @@ ags_fx_notation_audio_processor_real_play(AgsFxNotationAudioProcessor *fx_notati
   ags_timestamp_set_ags_offset(timestamp,
 			       AGS_NOTATION_DEFAULT_OFFSET * floor(offset_counter / AGS_NOTATION_DEFAULT_OFFSET));
 
-  /* find near timestamp */
-  notation = ags_notation_find_near_timestamp(start_notation, audio_channel,
-					      timestamp);
+  /* find notation */
+  notation = ags_audio_find_notation(audio, audio_channel,
+				     ags_timestamp_get_ags_offset(timestamp));
 
   if(notation != NULL){
-    GList *start_note, *note;
-    
-    start_note = ags_notation_find_offset(notation->data,
-					  offset_counter,
-					  FALSE);
+    AgsNotationNoteStore *note_store;
 
-    note = start_note;
+    guint i;
+    
+    note_store = ags_notation_get_note_store((AgsNotation *) notation);
 
-    while(note != NULL){
+    for(i = ags_notation_note_store_lower_bound(note_store,
+						offset_counter);
+	i < note_store->length && note_store->x0[i] == offset_counter;
+	i++){
       ags_fx_notation_audio_processor_key_on(fx_notation_audio_processor,
-					     note->data,
+					     note_store->note[i],
 					     AGS_FX_NOTATION_AUDIO_PROCESSOR_DEFAULT_KEY_ON_VELOCITY,
 					     AGS_FX_NOTATION_AUDIO_PROCESSOR_KEY_MODE_PLAY);
-
-      /* iterate */
-      note = note->next;
     }
 
-    g_list_free_full(start_note,
-		     (GDestroyNotify) g_object_unref);
+    ags_notation_note_store_unref(note_store);
+
+    g_object_unref(notation);
   }
 
   g_object_unref(audio);
-  
-  g_list_free_full(start_notation,
-		   (GDestroyNotify) g_object_unref);  
 }
 
 void
@@ -1296,7 +1288,6 @@ ags_fx_notation_audio_processor_real_record(AgsFxNotationAudioProcessor *fx_nota
   
   GObject *input_sequencer;
 
-  GList *start_notation, *notation;
   GList *start_note, *note;
   GList *start_recording_note, *recording_note;	
 
@@ -1373,13 +1364,8 @@ ags_fx_notation_audio_processor_real_record(AgsFxNotationAudioProcessor *fx_nota
 
   current_notation = NULL;
   
-  start_notation = NULL;
   start_note = NULL;
 
-  g_object_get(audio,
-	       "notation", &start_notation,
-	       NULL);
-
   /* get delay */
   delay = AGS_SOUNDCARD_DEFAULT_DELAY;
 
@@ -1421,13 +1407,9 @@ ags_fx_notation_audio_processor_real_record(AgsFxNotationAudioProcessor *fx_nota
   pattern_mode = ags_audio_test_behaviour_flags(audio,
 						AGS_SOUND_BEHAVIOUR_PATTERN_MODE);
   
-  /* find near timestamp */
-  notation = ags_notation_find_near_timestamp(start_notation, audio_channel,
-					      timestamp);
-
-  if(notation != NULL){
-    current_notation = notation->data;
-  }
+  /* find notation */
+  current_notation = (AgsNotation *) ags_audio_find_notation(audio, audio_channel,
+							     ags_timestamp_get_ags_offset(timestamp));
  
   /* retrieve buffer */
   midi_buffer = ags_sequencer_get_buffer(AGS_SEQUENCER(input_sequencer),
@@ -1741,8 +1723,9 @@ ags_fx_notation_audio_processor_real_record(AgsFxNotationAudioProcessor *fx_nota
     g_object_unref(input_sequencer);
   }
   
-  g_list_free_full(start_notation,
-		   (GDestroyNotify) g_object_unref);
+  if(current_notation != NULL){
+    g_object_unref(current_notation);
+  }
 
   g_list_free_full(start_note,
 		   (GDestroyNotify) g_object_unref);
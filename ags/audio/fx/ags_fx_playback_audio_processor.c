@@ -24,6 +24,8 @@
 
 #include <ags/audio/fx/ags_fx_playback_audio.h>
 
+#include <ags/audio/thread/ags_wave_prefetcher.h>
+
 #include <ags/i18n.h>
 
 void ags_fx_playback_audio_processor_class_init(AgsFxPlaybackAudioProcessorClass *fx_playback_audio_processor);
@@ -37,6 +39,7 @@ void ags_fx_playback_audio_processor_finalize(GObject *gobject);
 void ags_fx_playback_audio_processor_seek(AgsSeekable *seekable,
 					  gint64 offset,
 					  guint whence);
+void ags_fx_playback_audio_processor_seek_wave_stream(AgsFxPlaybackAudioProcessor *fx_playback_audio_processor);
 
 guint64 ags_fx_playback_audio_processor_get_wave_counter(AgsCountable *countable);
 
@@ -48,6 +51,9 @@ void ags_fx_playback_audio_processor_change_tact(AgsTactable *tactable, gdouble
 void ags_fx_playback_audio_processor_run_init_pre(AgsRecall *recall);
 void ags_fx_playback_audio_processor_run_inter(AgsRecall *recall);
 
+AgsAudioSignal* ags_fx_playback_audio_processor_get_audio_signal(AgsFxPlaybackAudioProcessor *fx_playback_audio_processor,
+								 guint data_mode);
+
 void ags_fx_playback_audio_processor_real_data_put(AgsFxPlaybackAudioProcessor *fx_playback_audio_processor,
 						   AgsBuffer *buffer,
 						   guint data_mode);
@@ -459,11 +465,95 @@ ags_fx_playback_audio_processor_seek(AgsSeekable *seekable,
   break;
   }
 
+  /* seed prefetch of streamed wave */
+  ags_fx_playback_audio_processor_seek_wave_stream(fx_playback_audio_processor);
+  
   if(fx_playback_audio != NULL){
     g_object_unref(fx_playback_audio);
   }
 }
 
+void
+ags_fx_playback_audio_processor_seek_wave_stream(AgsFxPlaybackAudioProcessor *fx_playback_audio_processor)
+{
+  AgsAudio *audio;
+
+  GList *start_wave, *wave;
+
+  guint64 x_offset;
+  guint audio_channel;
+  gboolean do_wakeup;
+  
+  GRecMutex *recall_mutex;
+
+  recall_mutex = AGS_RECALL_GET_OBJ_MUTEX(fx_playback_audio_processor);
+
+  audio = NULL;
+
+  audio_channel = 0;
+  
+  g_object_get(fx_playback_audio_processor,
+	       "audio", &audio,
+	       "audio-channel", &audio_channel,
+	       NULL);
+
+  if(audio == NULL){
+    return;
+  }
+  
+  g_rec_mutex_lock(recall_mutex);
+
+  x_offset = fx_playback_audio_processor->x_offset;
+  
+  g_rec_mutex_unlock(recall_mutex);
+
+  start_wave = NULL;
+  
+  g_object_get(audio,
+	       "wave", &start_wave,
+	       NULL);
+
+  wave = start_wave;
+
+  do_wakeup = FALSE;
+  
+  while(wave != NULL){
+    AgsWaveStream *wave_stream;
+
+    guint line;
+
+    wave_stream = NULL;
+    
+    g_object_get(wave->data,
+		 "line", &line,
+		 "wave-stream", &wave_stream,
+		 NULL);
+
+    if(line == audio_channel &&
+       wave_stream != NULL){
+      ags_wave_stream_seek(wave_stream,
+			   x_offset);
+
+      do_wakeup = TRUE;
+    }
+
+    if(wave_stream != NULL){
+      g_object_unref(wave_stream);
+    }
+    
+    wave = wave->next;
+  }
+
+  if(do_wakeup){
+    ags_wave_prefetcher_wakeup(ags_wave_prefetcher_get_instance());
+  }
+  
+  g_object_unref(audio);
+  
+  g_list_free_full(start_wave,
+		   (GDestroyNotify) g_object_unref);
+}
+
 guint64
 ags_fx_playback_audio_processor_get_wave_counter(AgsCountable *countable)
 {
@@ -943,10 +1033,9 @@ ags_fx_playback_audio_processor_run_inter(AgsRecall *recall)
   AGS_RECALL_CLASS(ags_fx_playback_audio_processor_parent_class)->run_inter(recall);
 }
 
-void
-ags_fx_playback_audio_processor_real_data_put(AgsFxPlaybackAudioProcessor *fx_playback_audio_processor,
-					      AgsBuffer *buffer,
-					      guint data_mode)
+AgsAudioSignal*
+ags_fx_playback_audio_processor_get_audio_signal(AgsFxPlaybackAudioProcessor *fx_playback_audio_processor,
+						 guint data_mode)
 {
   AgsAudioSignal *current_audio_signal;
   AgsRecallID *recall_id;
@@ -954,22 +1043,16 @@ ags_fx_playback_audio_processor_real_data_put(AgsFxPlaybackAudioProcessor *fx_pl
   
   GList *start_audio_signal, *audio_signal;
 
-  gpointer buffer_data;
-
-  guint buffer_x_offset, x_offset;
-  guint buffer_samplerate, samplerate;
-  guint buffer_buffer_size, buffer_size;
-  guint buffer_format, format;
-  guint copy_mode;
-  guint attack;
-  gboolean do_resample;
+  guint samplerate;
+  guint buffer_size;
+  guint format;
   
   GRecMutex *fx_playback_audio_processor_mutex;
-  GRecMutex *buffer_mutex;
-  GRecMutex *stream_mutex;
 
   fx_playback_audio_processor_mutex = AGS_RECALL_GET_OBJ_MUTEX(fx_playback_audio_processor);
 
+  recall_id = NULL;
+  
   samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
   buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
   format = AGS_SOUNDCARD_DEFAULT_FORMAT;
@@ -981,17 +1064,6 @@ ags_fx_playback_audio_processor_real_data_put(AgsFxPlaybackAudioProcessor *fx_pl
 	       "format", &format,
 	       NULL);
 
-  buffer_samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
-  buffer_buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
-  buffer_format = AGS_SOUNDCARD_DEFAULT_FORMAT;
-
-  g_object_get(buffer,
-	       "x", &buffer_x_offset,
-	       "samplerate", &buffer_samplerate,
-	       "buffer-size", &buffer_buffer_size,
-	       "format", &buffer_format,
-	       NULL);
-
   /* get audio signal */
   current_audio_signal = NULL;
   
@@ -999,8 +1071,6 @@ ags_fx_playback_audio_processor_real_data_put(AgsFxPlaybackAudioProcessor *fx_pl
   
   g_rec_mutex_lock(fx_playback_audio_processor_mutex);
 
-  x_offset = fx_playback_audio_processor->x_offset;
-  
   if(data_mode == AGS_FX_PLAYBACK_AUDIO_PROCESSOR_DATA_MODE_PLAY){
     start_audio_signal = fx_playback_audio_processor->playing_audio_signal;
   }else if(data_mode == AGS_FX_PLAYBACK_AUDIO_PROCESSOR_DATA_MODE_RECORD){
@@ -1034,8 +1104,6 @@ ags_fx_playback_audio_processor_real_data_put(AgsFxPlaybackAudioProcessor *fx_pl
 
     audio = NULL;
   
-    recall_id = NULL;
-
     fx_playback_audio = NULL;
 
     audio_channel = 0;
@@ -1043,7 +1111,6 @@ ags_fx_playback_audio_processor_real_data_put(AgsFxPlaybackAudioProcessor *fx_pl
     g_object_get(fx_playback_audio_processor,
 		 "output-soundcard", &output_soundcard,
 		 "audio", &audio,
-		 "recall-id", &recall_id,
 		 "recall-audio", &fx_playback_audio,
 		 "audio-channel", &audio_channel,
 		 NULL);
@@ -1140,6 +1207,67 @@ ags_fx_playback_audio_processor_real_data_put(AgsFxPlaybackAudioProcessor *fx_pl
     }
   }
 
+  if(recall_id != NULL){
+    g_object_unref(recall_id);
+  }
+
+  return(current_audio_signal);
+}
+
+void
+ags_fx_playback_audio_processor_real_data_put(AgsFxPlaybackAudioProcessor *fx_playback_audio_processor,
+					      AgsBuffer *buffer,
+					      guint data_mode)
+{
+  AgsAudioSignal *current_audio_signal;
+  
+  gpointer buffer_data;
+
+  guint buffer_x_offset, x_offset;
+  guint buffer_samplerate, samplerate;
+  guint buffer_buffer_size, buffer_size;
+  guint buffer_format, format;
+  guint copy_mode;
+  guint attack;
+  gboolean do_resample;
+  
+  GRecMutex *fx_playback_audio_processor_mutex;
+  GRecMutex *buffer_mutex;
+  GRecMutex *stream_mutex;
+
+  fx_playback_audio_processor_mutex = AGS_RECALL_GET_OBJ_MUTEX(fx_playback_audio_processor);
+
+  samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
+  buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
+  format = AGS_SOUNDCARD_DEFAULT_FORMAT;
+  
+  g_object_get(fx_playback_audio_processor,
+	       "samplerate", &samplerate,
+	       "buffer-size", &buffer_size,
+	       "format", &format,
+	       NULL);
+
+  buffer_samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
+  buffer_buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
+  buffer_format = AGS_SOUNDCARD_DEFAULT_FORMAT;
+
+  g_object_get(buffer,
+	       "x", &buffer_x_offset,
+	       "samplerate", &buffer_samplerate,
+	       "buffer-size", &buffer_buffer_size,
+	       "format", &buffer_format,
+	       NULL);
+
+  g_rec_mutex_lock(fx_playback_audio_processor_mutex);
+
+  x_offset = fx_playback_audio_processor->x_offset;
+
+  g_rec_mutex_unlock(fx_playback_audio_processor_mutex);
+
+  /* get audio signal */
+  current_audio_signal = ags_fx_playback_audio_processor_get_audio_signal(fx_playback_audio_processor,
+									  data_mode);
+
   buffer_mutex = AGS_BUFFER_GET_OBJ_MUTEX(buffer);
   stream_mutex = AGS_AUDIO_SIGNAL_GET_STREAM_MUTEX(current_audio_signal);
   
@@ -1210,10 +1338,6 @@ ags_fx_playback_audio_processor_real_data_put(AgsFxPlaybackAudioProcessor *fx_pl
   if(current_audio_signal != NULL){
     g_object_unref(current_audio_signal);
   }
-  
-  if(recall_id != NULL){
-    g_object_unref(recall_id);
-  }  
 }
 
 void
@@ -1267,7 +1391,7 @@ ags_fx_playback_audio_processor_real_play(AgsFxPlaybackAudioProcessor *fx_playba
 
   AgsTimestamp *timestamp;
   
-  GList *start_wave, *wave;
+  GObject *wave;
 
   guint audio_channel;
   guint64 relative_offset;
@@ -1275,6 +1399,7 @@ ags_fx_playback_audio_processor_real_play(AgsFxPlaybackAudioProcessor *fx_playba
   guint attack;
   guint samplerate;
   guint buffer_size;
+  guint format;
   guint frame_count;
   
   GRecMutex *fx_playback_audio_processor_mutex;
@@ -1288,6 +1413,7 @@ ags_fx_playback_audio_processor_real_play(AgsFxPlaybackAudioProcessor *fx_playba
 	       "audio-channel", &audio_channel,
 	       "samplerate", &samplerate,
 	       "buffer-size", &buffer_size,
+	       "format", &format,
 	       NULL);
 
   g_rec_mutex_lock(fx_playback_audio_processor_mutex);
@@ -1313,19 +1439,76 @@ ags_fx_playback_audio_processor_real_play(AgsFxPlaybackAudioProcessor *fx_playba
   }
   
   /* find wave - attempt #0 */
-  start_wave = NULL;
-  
-  g_object_get(audio,
-	       "wave", &start_wave,
-	       NULL);
-  
-  wave = ags_wave_find_near_timestamp(start_wave, audio_channel,
-				      timestamp);
+  wave = ags_audio_find_wave(audio, audio_channel,
+			     ags_timestamp_get_ags_offset(timestamp));
+
+  /* contiguous chunk - copy the whole period at once */
+  if(wave != NULL){
+    gpointer data;
+
+    guint available_frame_count;
+    guint wave_samplerate;
+    guint wave_format;
+
+    GRecMutex *wave_mutex;
+
+    /* get wave mutex */
+    wave_mutex = AGS_WAVE_GET_OBJ_MUTEX(wave);
+
+    /* the chunk data is only valid while holding the wave mutex */
+    g_rec_mutex_lock(wave_mutex);
+    
+    data = ags_wave_find_data((AgsWave *) wave,
+			      x_offset,
+			      &available_frame_count);
+
+    g_object_get(wave,
+		 "samplerate", &wave_samplerate,
+		 "format", &wave_format,
+		 NULL);
+    
+    if(data != NULL &&
+       available_frame_count >= buffer_size &&
+       wave_samplerate == samplerate){
+      AgsAudioSignal *current_audio_signal;
+
+      GRecMutex *stream_mutex;
+
+      current_audio_signal = ags_fx_playback_audio_processor_get_audio_signal(fx_playback_audio_processor,
+									      AGS_FX_PLAYBACK_AUDIO_PROCESSOR_DATA_MODE_PLAY);
 
+      stream_mutex = AGS_AUDIO_SIGNAL_GET_STREAM_MUTEX(current_audio_signal);
+      
+      g_rec_mutex_lock(stream_mutex);
+
+      ags_audio_buffer_util_copy_buffer_to_buffer(current_audio_signal->stream_current->data, 1, 0,
+						  data, 1, 0,
+						  buffer_size, ags_audio_buffer_util_get_copy_mode(ags_audio_buffer_util_format_from_soundcard(format),
+												   ags_audio_buffer_util_format_from_soundcard(wave_format)));
+      
+      g_rec_mutex_unlock(stream_mutex);
+
+      g_rec_mutex_unlock(wave_mutex);
+
+      g_object_unref(current_audio_signal);
+
+      /* unref */
+      if(audio != NULL){
+	g_object_unref(audio);
+      }
+
+      g_object_unref(wave);
+      
+      return;
+    }
+
+    g_rec_mutex_unlock(wave_mutex);
+  }
+  
   if(wave != NULL){
     AgsBuffer *buffer;
 
-    buffer = ags_wave_find_point(wave->data,
+    buffer = ags_wave_find_point((AgsWave *) wave,
 				 x_offset,
 				 FALSE);
 
@@ -1334,6 +1517,8 @@ ags_fx_playback_audio_processor_real_play(AgsFxPlaybackAudioProcessor *fx_playba
 					       buffer,
 					       AGS_FX_PLAYBACK_AUDIO_PROCESSOR_DATA_MODE_PLAY);
     }
+
+    g_object_unref(wave);
   }
 
   /* find wave - attempt #1 */
@@ -1342,13 +1527,13 @@ ags_fx_playback_audio_processor_real_play(AgsFxPlaybackAudioProcessor *fx_playba
     ags_timestamp_set_ags_offset(timestamp,
 				 (guint64) (relative_offset * floor((double) (x_offset + frame_count) / (double) relative_offset)));
 
-    wave = ags_wave_find_near_timestamp(start_wave, audio_channel,
-					timestamp);
+    wave = ags_audio_find_wave(audio, audio_channel,
+			       ags_timestamp_get_ags_offset(timestamp));
 
     if(wave != NULL){
       AgsBuffer *buffer;
 
-      buffer = ags_wave_find_point(wave->data,
+      buffer = ags_wave_find_point((AgsWave *) wave,
 				   x_offset + frame_count,
 				   FALSE);
 
@@ -1357,6 +1542,8 @@ ags_fx_playback_audio_processor_real_play(AgsFxPlaybackAudioProcessor *fx_playba
 						 buffer,
 						 AGS_FX_PLAYBACK_AUDIO_PROCESSOR_DATA_MODE_PLAY);
       }
+
+      g_object_unref(wave);
     }
   }
 
@@ -1364,9 +1551,6 @@ ags_fx_playback_audio_processor_real_play(AgsFxPlaybackAudioProcessor *fx_playba
   if(audio != NULL){
     g_object_unref(audio);
   }
-
-  g_list_free_full(start_wave,
-		   (GDestroyNotify) g_object_unref);
 }
 
 void
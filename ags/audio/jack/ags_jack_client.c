@@ -1684,6 +1684,16 @@ ags_jack_client_process_callback(jack_nframes_t nframes, void *ptr)
 	  word_size = sizeof(gint64);
 	}
 	break;
+      case AGS_SOUNDCARD_FLOAT:
+	{
+	  word_size = sizeof(gfloat);
+	}
+	break;
+      case AGS_SOUNDCARD_DOUBLE:
+	{
+	  word_size = sizeof(gdouble);
+	}
+	break;
       default:
 	g_rec_mutex_unlock(device_mutex);
 	
@@ -1877,6 +1887,16 @@ ags_jack_client_process_callback(jack_nframes_t nframes, void *ptr)
 	  word_size = sizeof(gint64);
 	}
 	break;
+      case AGS_SOUNDCARD_FLOAT:
+	{
+	  word_size = sizeof(gfloat);
+	}
+	break;
+      case AGS_SOUNDCARD_DOUBLE:
+	{
+	  word_size = sizeof(gdouble);
+	}
+	break;
       default:
 	g_rec_mutex_unlock(device_mutex);
 	
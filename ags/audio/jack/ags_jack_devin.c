@@ -581,7 +581,7 @@ ags_jack_devin_init(AgsJackDevin *jack_devin)
 
   jack_devin->samplerate = ags_soundcard_helper_config_get_samplerate(config);
   jack_devin->buffer_size = ags_soundcard_helper_config_get_buffer_size(config);
-  jack_devin->format = ags_soundcard_helper_config_get_format(config);
+  jack_devin->format = ags_soundcard_helper_config_get_device_format(config);
 
   /*  */
   jack_devin->card_uri = NULL;
@@ -595,6 +595,10 @@ ags_jack_devout_init(AgsJackDevout *jack_devout)
   jack_devout->buffer_size = ags_soundcard_helper_config_get_buffer_size(config);
   jack_devout->format = ags_soundcard_helper_config_get_format(config);
 
+  if(ags_soundcard_helper_config_get_float_mix_bus(config)){
+    jack_devout->flags |= AGS_JACK_DEVOUT_FLOAT_MIX_BUS;
+  }
+
   /*  */
   jack_devout->card_uri = NULL;
   jack_devout->jack_client = NULL;
@@ -783,6 +787,13 @@ ags_jack_devout_set_property(GObject *gobject,
 
       g_rec_mutex_lock(jack_devout_mutex);
 
+      /* float mix bus keeps its buffers */
+      if((AGS_JACK_DEVOUT_FLOAT_MIX_BUS & (jack_devout->flags)) != 0){
+	g_rec_mutex_unlock(jack_devout_mutex);
+
+	return;
+      }
+      
       if(format == jack_devout->format){
 	g_rec_mutex_unlock(jack_devout_mutex);
 
@@ -1790,6 +1801,16 @@ ags_jack_devout_port_init(AgsSoundcard *soundcard,
       word_size = sizeof(gint64);
     }
     break;
+  case AGS_SOUNDCARD_FLOAT:
+    {
+      word_size = sizeof(gfloat);
+    }
+    break;
+  case AGS_SOUNDCARD_DOUBLE:
+    {
+      word_size = sizeof(gdouble);
+    }
+    break;
   default:
     g_rec_mutex_unlock(jack_devout_mutex);
     
@@ -1906,6 +1927,16 @@ ags_jack_devout_port_play(AgsSoundcard *soundcard,
       word_size = sizeof(gint64);
     }
     break;
+  case AGS_SOUNDCARD_FLOAT:
+    {
+      word_size = sizeof(gfloat);
+    }
+    break;
+  case AGS_SOUNDCARD_DOUBLE:
+    {
+      word_size = sizeof(gdouble);
+    }
+    break;
   default:
     g_rec_mutex_unlock(jack_devout_mutex);
     
@@ -2091,6 +2122,16 @@ ags_jack_devout_port_free(AgsSoundcard *soundcard)
       word_size = sizeof(gint64);
     }
     break;
+  case AGS_SOUNDCARD_FLOAT:
+    {
+      word_size = sizeof(gfloat);
+    }
+    break;
+  case AGS_SOUNDCARD_DOUBLE:
+    {
+      word_size = sizeof(gdouble);
+    }
+    break;
   default:
     word_size = 0;
     
@@ -2995,6 +3036,16 @@ ags_jack_devout_realloc_buffer(AgsJackDevout *jack_devout)
       word_size = sizeof(gint64);
     }
     break;
+  case AGS_SOUNDCARD_FLOAT:
+    {
+      word_size = sizeof(gfloat);
+    }
+    break;
+  case AGS_SOUNDCARD_DOUBLE:
+    {
+      word_size = sizeof(gdouble);
+    }
+    break;
   default:
     g_warning("ags_jack_devout_realloc_buffer(): unsupported word size");
     return;
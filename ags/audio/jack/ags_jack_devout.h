@@ -53,6 +53,7 @@ typedef struct _AgsJackDevoutClass AgsJackDevoutClass;
  * @AGS_JACK_DEVOUT_START_PLAY: playback starting
  * @AGS_JACK_DEVOUT_NONBLOCKING: do non-blocking calls
  * @AGS_JACK_DEVOUT_INITIALIZED: the soundcard was initialized
+ * @AGS_JACK_DEVOUT_FLOAT_MIX_BUS: buffers are float regardless of format
  *
  * Enum values to control the behavior or indicate internal state of #AgsJackDevout by
  * enable/disable as flags.
@@ -75,6 +76,8 @@ typedef enum{
 
   AGS_JACK_DEVOUT_NONBLOCKING                    = 1 << 10,
   AGS_JACK_DEVOUT_INITIALIZED                    = 1 << 11,
+
+  AGS_JACK_DEVOUT_FLOAT_MIX_BUS                  = 1 << 12,
 }AgsJackDevoutFlags;
 
 /**
@@ -19,10 +19,15 @@
 
 #include <ags/audio/osc/controller/ags_osc_info_controller.h>
 
+#include <ags/audio/ags_sound_provider.h>
+#include <ags/audio/ags_recall_load_util.h>
+
 #include <ags/audio/osc/ags_osc_response.h>
 #include <ags/audio/osc/ags_osc_buffer_util.h>
 
 #include <stdlib.h>
+#include <string.h>
+#include <math.h>
 
 #include <ags/i18n.h>
 
@@ -39,6 +44,13 @@ void ags_osc_info_controller_get_property(GObject *gobject,
 void ags_osc_info_controller_dispose(GObject *gobject);
 void ags_osc_info_controller_finalize(GObject *gobject);
 
+GList* ags_osc_info_controller_get_rt_sanitizer_report(AgsOscInfoController *osc_info_controller,
+							AgsOscConnection *osc_connection,
+							guchar *message, guint message_size);
+GList* ags_osc_info_controller_get_dsp_load_report(AgsOscInfoController *osc_info_controller,
+						   AgsOscConnection *osc_connection,
+						   guchar *message, guint message_size);
+
 gpointer ags_osc_info_controller_real_get_info(AgsOscInfoController *osc_info_controller,
 					       AgsOscConnection *osc_connection,
 					       guchar *message, guint message_size);
@@ -51,6 +63,12 @@ gpointer ags_osc_info_controller_real_get_info(AgsOscInfoController *osc_info_co
  * @include: ags/audio/osc/controller/ags_osc_info_controller.h
  *
  * The #AgsOscInfoController implements the OSC info controller.
+ *
+ * Requesting /info with the string argument "rt-sanitizer" returns the
+ * hit count and report of #AgsRtSanitizer, see ags_rt_sanitizer_get_report().
+ * The argument "dsp-load" returns the time spent by every recall, see
+ * ags_recall_load_util_get_report(). The times stay zero unless the
+ * "dsp-load-accounting" key of the generic config group is set to true.
  */
 
 enum{
@@ -219,6 +237,136 @@ ags_osc_info_controller_finalize(GObject *gobject)
   G_OBJECT_CLASS(ags_osc_info_controller_parent_class)->finalize(gobject);
 }
 
+GList*
+ags_osc_info_controller_get_rt_sanitizer_report(AgsOscInfoController *osc_info_controller,
+						AgsOscConnection *osc_connection,
+						guchar *message, guint message_size)
+{
+  AgsOscResponse *osc_response;
+
+  GList *start_response;
+
+  gchar *report;
+  guchar *packet;
+
+  guint report_length;
+  guint count;
+  guint packet_size;
+  guint i;
+  
+  start_response = NULL;
+
+  osc_response = ags_osc_response_new();
+  start_response = g_list_prepend(start_response,
+				  osc_response);
+
+  report = ags_rt_sanitizer_get_report();
+
+  if(report == NULL){
+    report = g_strdup("realtime sanitizer disabled, configure with --enable-rt-sanitizer");
+  }
+
+  report_length = strlen(report);
+  
+  count = 0;
+
+  for(i = 0; i < AGS_RT_SANITIZER_HOOK_LAST; i++){
+    count += ags_rt_sanitizer_get_count(i);
+  }
+
+  /* path, type tag, argument, count and report */
+  packet_size = 4 + 8 + 8 + 16 + 4 + (4 * (guint) ceil((double) (report_length + 1) / 4.0));
+
+  packet = (guchar *) malloc(packet_size * sizeof(guchar));
+  memset(packet, 0, packet_size * sizeof(guchar));
+  
+  ags_osc_buffer_util_put_int32(packet,
+				packet_size - 4);
+
+  ags_osc_buffer_util_put_string(packet + 4,
+				 "/info", -1);
+  ags_osc_buffer_util_put_string(packet + 12,
+				 ",sis", -1);
+  ags_osc_buffer_util_put_string(packet + 20,
+				 AGS_OSC_INFO_CONTROLLER_RT_SANITIZER, -1);
+  ags_osc_buffer_util_put_int32(packet + 36,
+				count);
+  ags_osc_buffer_util_put_string(packet + 40,
+				 report, -1);
+
+  g_object_set(osc_response,
+	       "packet", packet,
+	       "packet-size", packet_size,
+	       NULL);
+
+  g_free(report);
+  
+  return(start_response);
+}
+
+GList*
+ags_osc_info_controller_get_dsp_load_report(AgsOscInfoController *osc_info_controller,
+					    AgsOscConnection *osc_connection,
+					    guchar *message, guint message_size)
+{
+  AgsOscResponse *osc_response;
+
+  AgsApplicationContext *application_context;
+  
+  GList *start_response;
+  GList *start_audio;
+  
+  gchar *report;
+  guchar *packet;
+
+  guint report_length;
+  guint packet_size;
+  
+  start_response = NULL;
+
+  osc_response = ags_osc_response_new();
+  start_response = g_list_prepend(start_response,
+				  osc_response);
+
+  application_context = ags_application_context_get_instance();
+
+  start_audio = ags_sound_provider_get_audio(AGS_SOUND_PROVIDER(application_context));
+  
+  report = ags_recall_load_util_get_report(start_audio);
+
+  g_list_free_full(start_audio,
+		   g_object_unref);
+
+  report_length = strlen(report);
+
+  /* path, type tag, argument and report */
+  packet_size = 4 + 8 + 4 + 12 + (4 * (guint) ceil((double) (report_length + 1) / 4.0));
+
+  packet = (guchar *) malloc(packet_size * sizeof(guchar));
+  memset(packet, 0, packet_size * sizeof(guchar));
+  
+  ags_osc_buffer_util_put_int32(packet,
+				packet_size - 4);
+
+  ags_osc_buffer_util_put_string(packet + 4,
+				 "/info", -1);
+  ags_osc_buffer_util_put_string(packet + 12,
+				 ",ss", -1);
+  ags_osc_buffer_util_put_string(packet + 16,
+				 AGS_OSC_INFO_CONTROLLER_DSP_LOAD, -1);
+  ags_osc_buffer_util_put_string(packet + 28,
+				 report, -1);
+
+  g_object_set(osc_response,
+	       "packet", packet,
+	       "packet-size", packet_size,
+	       NULL);
+
+  g_free(report);
+  
+  return(start_response);
+}
+
 gpointer
 ags_osc_info_controller_real_get_info(AgsOscInfoController *osc_info_controller,
 				      AgsOscConnection *osc_connection,
@@ -228,12 +376,50 @@ ags_osc_info_controller_real_get_info(AgsOscInfoController *osc_info_controller,
 
   GList *start_response;
 
+  gchar *type_tag;
+  gchar *argument;
   guchar *packet;
 
   guint packet_size;
+  gboolean is_rt_sanitizer;
+  gboolean is_dsp_load;
   
   static const guchar server_info_message[] = "/info\0\0\0,ssss\0\0\0V2.1.0\0\0osc-server\0\0Advanced Gtk+ Sequencer\02.1.0\0\0\0";
 
+  /* optional argument */
+  type_tag = NULL;
+  argument = NULL;
+  
+  if(message_size > 12){
+    ags_osc_buffer_util_get_string(message + 8,
+				   &type_tag, NULL);
+  }
+
+  if(type_tag != NULL &&
+     !strncmp(type_tag, ",s", 3) &&
+     message_size > 16){
+    ags_osc_buffer_util_get_string(message + 12,
+				   &argument, NULL);
+  }
+
+  is_rt_sanitizer = (argument != NULL &&
+		     !g_strcmp0(argument, AGS_OSC_INFO_CONTROLLER_RT_SANITIZER)) ? TRUE: FALSE;
+  is_dsp_load = (argument != NULL &&
+		 !g_strcmp0(argument, AGS_OSC_INFO_CONTROLLER_DSP_LOAD)) ? TRUE: FALSE;
+
+  free(type_tag);
+  free(argument);
+
+  if(is_rt_sanitizer){
+    return(ags_osc_info_controller_get_rt_sanitizer_report(osc_info_controller,
+							   osc_connection,
+							   message, message_size));
+  }else if(is_dsp_load){
+    return(ags_osc_info_controller_get_dsp_load_report(osc_info_controller,
+						       osc_connection,
+						       message, message_size));
+  }
+  
   start_response = NULL;
 
   osc_response = ags_osc_response_new();
@@ -36,6 +36,9 @@ G_BEGIN_DECLS
 #define AGS_IS_OSC_INFO_CONTROLLER_CLASS(class)     (G_TYPE_CHECK_CLASS_TYPE ((class), AGS_TYPE_OSC_INFO_CONTROLLER))
 #define AGS_OSC_INFO_CONTROLLER_GET_CLASS(obj)      (G_TYPE_INSTANCE_GET_CLASS(obj, AGS_TYPE_OSC_INFO_CONTROLLER, AgsOscInfoControllerClass))
 
+#define AGS_OSC_INFO_CONTROLLER_RT_SANITIZER "rt-sanitizer"
+#define AGS_OSC_INFO_CONTROLLER_DSP_LOAD "dsp-load"
+
 typedef struct _AgsOscInfoController AgsOscInfoController;
 typedef struct _AgsOscInfoControllerClass AgsOscInfoControllerClass;
 
@@ -572,7 +572,7 @@ ags_pulse_devin_init(AgsPulseDevin *pulse_devin)
 
   pulse_devin->samplerate = ags_soundcard_helper_config_get_samplerate(config);
   pulse_devin->buffer_size = ags_soundcard_helper_config_get_buffer_size(config);
-  pulse_devin->format = ags_soundcard_helper_config_get_format(config);
+  pulse_devin->format = ags_soundcard_helper_config_get_device_format(config);
 
   /*  */
   pulse_devin->card_uri = NULL;
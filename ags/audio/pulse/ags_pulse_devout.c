@@ -595,6 +595,10 @@ ags_pulse_devout_init(AgsPulseDevout *pulse_devout)
   pulse_devout->buffer_size = ags_soundcard_helper_config_get_buffer_size(config);
   pulse_devout->format = ags_soundcard_helper_config_get_format(config);
 
+  if(ags_soundcard_helper_config_get_float_mix_bus(config)){
+    pulse_devout->flags |= AGS_PULSE_DEVOUT_FLOAT_MIX_BUS;
+  }
+
   /*  */
   pulse_devout->card_uri = NULL;
   pulse_devout->pulse_client = NULL;
@@ -787,6 +791,13 @@ ags_pulse_devout_set_property(GObject *gobject,
 
       g_rec_mutex_lock(pulse_devout_mutex);
 
+      /* float mix bus keeps its buffers */
+      if((AGS_PULSE_DEVOUT_FLOAT_MIX_BUS & (pulse_devout->flags)) != 0){
+	g_rec_mutex_unlock(pulse_devout_mutex);
+
+	return;
+      }
+      
       if(format == pulse_devout->format){
 	g_rec_mutex_unlock(pulse_devout_mutex);
 
@@ -1829,6 +1840,11 @@ ags_pulse_devout_port_init(AgsSoundcard *soundcard,
       word_size = sizeof(gint64);
     }
     break;
+  case AGS_SOUNDCARD_FLOAT:
+    {
+      word_size = sizeof(gfloat);
+    }
+    break;
   default:
     g_rec_mutex_unlock(pulse_devout_mutex);
     
@@ -1939,6 +1955,11 @@ ags_pulse_devout_port_play(AgsSoundcard *soundcard,
       word_size = sizeof(gint32);
     }
     break;
+  case AGS_SOUNDCARD_FLOAT:
+    {
+      word_size = sizeof(gfloat);
+    }
+    break;
   default:
     g_rec_mutex_unlock(pulse_devout_mutex);
     
@@ -2332,6 +2353,11 @@ ags_pulse_devout_port_free(AgsSoundcard *soundcard)
       word_size = sizeof(gint64);
     }
     break;
+  case AGS_SOUNDCARD_FLOAT:
+    {
+      word_size = sizeof(gfloat);
+    }
+    break;
   default:
     word_size = 0;
     
@@ -3295,6 +3321,11 @@ ags_pulse_devout_realloc_buffer(AgsPulseDevout *pulse_devout)
       word_size = sizeof(gint32);
     }
     break;
+  case AGS_SOUNDCARD_FLOAT:
+    {
+      word_size = sizeof(gfloat);
+    }
+    break;
   default:
     g_warning("ags_pulse_devout_realloc_buffer(): unsupported word size");
     return;
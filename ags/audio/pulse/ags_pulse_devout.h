@@ -57,6 +57,7 @@ typedef struct _AgsPulseDevoutClass AgsPulseDevoutClass;
  * @AGS_PULSE_DEVOUT_START_PLAY: playback starting
  * @AGS_PULSE_DEVOUT_NONBLOCKING: do non-blocking calls
  * @AGS_PULSE_DEVOUT_INITIALIZED: the soundcard was initialized
+ * @AGS_PULSE_DEVOUT_FLOAT_MIX_BUS: buffers are float regardless of format
  *
  * Enum values to control the behavior or indicate internal state of #AgsPulseDevout by
  * enable/disable as flags.
@@ -82,6 +83,8 @@ typedef enum{
 
   AGS_PULSE_DEVOUT_NONBLOCKING                    = 1 << 14,
   AGS_PULSE_DEVOUT_INITIALIZED                    = 1 << 15,
+
+  AGS_PULSE_DEVOUT_FLOAT_MIX_BUS                  = 1 << 16,
 }AgsPulseDevoutFlags;
 
 /**
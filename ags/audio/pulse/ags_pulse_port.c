@@ -275,7 +275,7 @@ ags_pulse_port_init(AgsPulsePort *pulse_port)
 
   pulse_port->samplerate = ags_soundcard_helper_config_get_samplerate(config);
   pulse_port->buffer_size = ags_soundcard_helper_config_get_buffer_size(config);
-  pulse_port->format = ags_soundcard_helper_config_get_format(config);
+  pulse_port->format = ags_soundcard_helper_config_get_device_format(config);
 
   pulse_port->use_cache = TRUE;
   pulse_port->cache_buffer_size = AGS_PULSE_PORT_DEFAULT_CACHE_BUFFER_SIZE;
@@ -351,6 +351,24 @@ ags_pulse_port_init(AgsPulsePort *pulse_port)
       word_size = sizeof(gint32);
     }
     break;
+  case AGS_SOUNDCARD_FLOAT:
+    {
+#ifdef AGS_WITH_PULSE
+      if(ags_endian_host_is_be()){
+	pulse_port->sample_spec->format = PA_SAMPLE_FLOAT32BE;
+      }else{
+	pulse_port->sample_spec->format = PA_SAMPLE_FLOAT32LE;
+      }
+#endif
+
+      pulse_port->cache[0] = (void *) malloc(pulse_port->pcm_channels * pulse_port->cache_buffer_size * sizeof(gfloat));
+      pulse_port->cache[1] = (void *) malloc(pulse_port->pcm_channels * pulse_port->cache_buffer_size * sizeof(gfloat));
+      pulse_port->cache[2] = (void *) malloc(pulse_port->pcm_channels * pulse_port->cache_buffer_size * sizeof(gfloat));
+      pulse_port->cache[3] = (void *) malloc(pulse_port->pcm_channels * pulse_port->cache_buffer_size * sizeof(gfloat));
+
+      word_size = sizeof(gfloat);
+    }
+    break;
   default:
     g_warning("pulse devout/devin - unsupported format");
   }
@@ -1211,6 +1229,11 @@ ags_pulse_port_cached_stream_request_callback(pa_stream *stream, size_t length,
       word_size = sizeof(gint32);
     }
     break;
+  case AGS_SOUNDCARD_FLOAT:
+    {
+      word_size = sizeof(gfloat);
+    }
+    break;
   }
 
   frame_size = pulse_port->sample_spec->channels * pulse_port->cache_buffer_size * word_size;
@@ -1434,6 +1457,11 @@ ags_pulse_port_stream_request_callback(pa_stream *stream, size_t length, AgsPuls
       word_size = sizeof(gint32);
     }
     break;
+  case AGS_SOUNDCARD_FLOAT:
+    {
+      word_size = sizeof(gfloat);
+    }
+    break;
   }
         
   count = pulse_port->sample_spec->channels * pulse_port->buffer_size * word_size;
@@ -1686,6 +1714,11 @@ ags_pulse_port_stream_request_callback(pa_stream *stream, size_t length, AgsPuls
       word_size = sizeof(gint32);
     }
     break;
+  case AGS_SOUNDCARD_FLOAT:
+    {
+      word_size = sizeof(gfloat);
+    }
+    break;
   default:
     empty_run = TRUE;
   }
@@ -1926,6 +1959,11 @@ ags_pulse_port_get_fixed_size(AgsPulsePort *pulse_port)
       word_size = sizeof(gint32);
     }
     break;
+  case AGS_SOUNDCARD_FLOAT:
+    {
+      word_size = sizeof(gfloat);
+    }
+    break;
   default:
     g_warning("pulse devout - unsupported format");
 
@@ -2109,6 +2147,24 @@ ags_pulse_port_set_format(AgsPulsePort *pulse_port,
 					      pulse_port->pcm_channels * pulse_port->cache_buffer_size * sizeof(gint32));
     }
     break;
+  case AGS_SOUNDCARD_FLOAT:
+    {
+      if(ags_endian_host_is_be()){
+	pulse_port->sample_spec->format = PA_SAMPLE_FLOAT32BE;
+      }else{
+	pulse_port->sample_spec->format = PA_SAMPLE_FLOAT32LE;
+      }
+
+      pulse_port->cache[0] = (void *) realloc(pulse_port->cache[0],
+					      pulse_port->pcm_channels * pulse_port->cache_buffer_size * sizeof(gfloat));
+      pulse_port->cache[1] = (void *) realloc(pulse_port->cache[1],
+					      pulse_port->pcm_channels * pulse_port->cache_buffer_size * sizeof(gfloat));
+      pulse_port->cache[2] = (void *) realloc(pulse_port->cache[2],
+					      pulse_port->pcm_channels * pulse_port->cache_buffer_size * sizeof(gfloat));
+      pulse_port->cache[3] = (void *) realloc(pulse_port->cache[3],
+					      pulse_port->pcm_channels * pulse_port->cache_buffer_size * sizeof(gfloat));
+    }
+    break;
   default:
     g_warning("pulse devout - unsupported format");
   }
@@ -2180,6 +2236,18 @@ ags_pulse_port_set_cache_buffer_size(AgsPulsePort *pulse_port,
 					      pulse_port->pcm_channels * pulse_port->cache_buffer_size * sizeof(gint32));
     }
     break;
+  case AGS_SOUNDCARD_FLOAT:
+    {
+      pulse_port->cache[0] = (void *) realloc(pulse_port->cache[0],
+					      pulse_port->pcm_channels * pulse_port->cache_buffer_size * sizeof(gfloat));
+      pulse_port->cache[1] = (void *) realloc(pulse_port->cache[1],
+					      pulse_port->pcm_channels * pulse_port->cache_buffer_size * sizeof(gfloat));
+      pulse_port->cache[2] = (void *) realloc(pulse_port->cache[2],
+					      pulse_port->pcm_channels * pulse_port->cache_buffer_size * sizeof(gfloat));
+      pulse_port->cache[3] = (void *) realloc(pulse_port->cache[3],
+					      pulse_port->pcm_channels * pulse_port->cache_buffer_size * sizeof(gfloat));
+    }
+    break;
   default:
     g_warning("pulse devout - unsupported format");
   }
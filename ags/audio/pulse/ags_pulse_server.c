@@ -1223,6 +1223,10 @@ ags_pulse_server_register_soundcard(AgsSoundServer *sound_server,
     pulse_devout->port_name = (gchar **) malloc(2 * sizeof(gchar *));
     pulse_devout->port_name[0] = g_strdup(str);
     pulse_devout->port_name[1] = NULL;
+
+    /* float mix bus is written as float stream */
+    ags_pulse_port_set_format(pulse_port,
+			      pulse_devout->format);
     
     ags_pulse_port_register(pulse_port,
 			    str,
@@ -1506,6 +1510,9 @@ ags_pulse_server_register_default_soundcard(AgsPulseServer *pulse_server)
   pulse_devout->port_name = (gchar **) malloc(2 * sizeof(gchar *));
   pulse_devout->port_name[0] = g_strdup(str);
   pulse_devout->port_name[1] = NULL;
+
+  ags_pulse_port_set_format(pulse_port,
+			    pulse_devout->format);
   
   ags_pulse_port_register(pulse_port,
 			  str,
@@ -19,12 +19,14 @@
 
 #include <ags/audio/recall/ags_lfo_audio_signal.h>
 
+#include <ags/audio/ags_audio.h>
 #include <ags/audio/ags_input.h>
 #include <ags/audio/ags_port.h>
 #include <ags/audio/ags_recall_channel_run.h>
 #include <ags/audio/ags_audio_buffer_util.h>
 #include <ags/audio/ags_synth_enums.h>
 #include <ags/audio/ags_lfo_synth_util.h>
+#include <ags/audio/ags_modulation_source.h>
 
 #include <ags/audio/recall/ags_lfo_channel.h>
 #include <ags/audio/recall/ags_lfo_channel_run.h>
@@ -221,11 +223,16 @@ ags_lfo_audio_signal_run_inter(AgsRecall *recall)
   }
   
   if(source->stream_current != NULL){
+    AgsAudio *audio;
+    AgsChannel *channel;
     AgsLfoChannel *lfo_channel;
     AgsLfoChannelRun *lfo_channel_run;
     AgsLfoRecycling *lfo_recycling;
+    AgsModulationSource *modulation_source;
     AgsPort *port;
 
+    GObject *output_soundcard;
+
     void *buffer;
 
     gboolean enabled;
@@ -237,8 +244,10 @@ ags_lfo_audio_signal_run_inter(AgsRecall *recall)
     guint samplerate;
     guint buffer_size;
     guint format;
+    guint64 tic;
     guint limit;
     guint i;
+    gboolean shared;
  
     GValue value = {0,};
 
@@ -359,59 +368,107 @@ ags_lfo_audio_signal_run_inter(AgsRecall *recall)
 
     g_object_unref(port);
 
-    /* LFO */
-    switch(lfo_wave){
-    case AGS_SYNTH_OSCILLATOR_SIN:
-    {
-      ags_lfo_synth_util_sin(buffer,
-			     lfo_freq, lfo_phase,
-			     lfo_depth,
-			     lfo_tuning,
-			     samplerate, ags_audio_buffer_util_format_from_soundcard(format),
-			     0, buffer_size);
+    /* shared LFO of audio */
+    audio = NULL;
+    
+    modulation_source = NULL;
+
+    g_object_get(lfo_channel,
+		 "source", &channel,
+		 NULL);
+
+    if(channel != NULL){
+      g_object_get(channel,
+		   "audio", &audio,
+		   NULL);
     }
-    break;
-    case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
-    {
-      ags_lfo_synth_util_sawtooth(buffer,
-				  lfo_freq, lfo_phase,
-				  lfo_depth,
-				  lfo_tuning,
-				  samplerate, ags_audio_buffer_util_format_from_soundcard(format),
-				  0, buffer_size);
+
+    g_object_get(lfo_audio_signal,
+		 "output-soundcard", &output_soundcard,
+		 NULL);
+
+    if(audio != NULL &&
+       output_soundcard != NULL &&
+       lfo_freq > 0.0){
+      modulation_source = ags_audio_get_modulation_source(audio);
+    }
+
+    shared = FALSE;
+    
+    if(modulation_source != NULL){
+      tic = (((guint64) ags_soundcard_get_note_offset_absolute(AGS_SOUNDCARD(output_soundcard))) << 32) | (guint64) ags_soundcard_get_delay_counter(AGS_SOUNDCARD(output_soundcard));
+
+      /* the first voice of this tic computes the free-running LFO of audio, others reuse it if parameters match */
+      if(ags_modulation_source_compute_lfo(modulation_source,
+					   tic,
+					   lfo_wave,
+					   lfo_freq, lfo_depth,
+					   lfo_tuning)){
+	ags_modulation_source_multiply(modulation_source,
+				       buffer,
+				       ags_audio_buffer_util_format_from_soundcard(format),
+				       0, buffer_size);
+
+	shared = TRUE;
+      }
+      
+      g_object_unref(modulation_source);
     }
-    break;
-    case AGS_SYNTH_OSCILLATOR_TRIANGLE:
-    {
-      ags_lfo_synth_util_triangle(buffer,
+
+    if(!shared){
+      switch(lfo_wave){
+      case AGS_SYNTH_OSCILLATOR_SIN:
+      {
+        ags_lfo_synth_util_sin(buffer,
+			       lfo_freq, lfo_phase,
+			       lfo_depth,
+			       lfo_tuning,
+			       samplerate, ags_audio_buffer_util_format_from_soundcard(format),
+			       0, buffer_size);
+      }
+      break;
+      case AGS_SYNTH_OSCILLATOR_SAWTOOTH:
+      {
+        ags_lfo_synth_util_sawtooth(buffer,
+				    lfo_freq, lfo_phase,
+				    lfo_depth,
+				    lfo_tuning,
+				    samplerate, ags_audio_buffer_util_format_from_soundcard(format),
+				    0, buffer_size);
+      }
+      break;
+      case AGS_SYNTH_OSCILLATOR_TRIANGLE:
+      {
+        ags_lfo_synth_util_triangle(buffer,
+				    lfo_freq, lfo_phase,
+				    lfo_depth,
+				    lfo_tuning,
+				    samplerate, ags_audio_buffer_util_format_from_soundcard(format),
+				    0, buffer_size);
+      }
+      break;
+      case AGS_SYNTH_OSCILLATOR_SQUARE:
+      {
+        ags_lfo_synth_util_square(buffer,
 				  lfo_freq, lfo_phase,
 				  lfo_depth,
 				  lfo_tuning,
 				  samplerate, ags_audio_buffer_util_format_from_soundcard(format),
 				  0, buffer_size);
+      }
+      break;
+      case AGS_SYNTH_OSCILLATOR_IMPULSE:
+      {
+        ags_lfo_synth_util_impulse(buffer,
+				   lfo_freq, lfo_phase,
+				   lfo_depth,
+				   lfo_tuning,
+				   samplerate, ags_audio_buffer_util_format_from_soundcard(format),
+				   0, buffer_size);
+      }
+      break;
+      };
     }
-    break;
-    case AGS_SYNTH_OSCILLATOR_SQUARE:
-    {
-      ags_lfo_synth_util_square(buffer,
-				lfo_freq, lfo_phase,
-				lfo_depth,
-				lfo_tuning,
-				samplerate, ags_audio_buffer_util_format_from_soundcard(format),
-				0, buffer_size);
-    }
-    break;
-    case AGS_SYNTH_OSCILLATOR_IMPULSE:
-    {
-      ags_lfo_synth_util_impulse(buffer,
-				 lfo_freq, lfo_phase,
-				 lfo_depth,
-				 lfo_tuning,
-				 samplerate, ags_audio_buffer_util_format_from_soundcard(format),
-				 0, buffer_size);
-    }
-    break;
-    };
 
     lfo_audio_signal->current_lfo_phase += buffer_size;
 
@@ -419,6 +476,18 @@ ags_lfo_audio_signal_run_inter(AgsRecall *recall)
       lfo_audio_signal->current_lfo_phase = (guint) lfo_audio_signal->current_lfo_phase % (guint) (samplerate / lfo_freq);
     }
     
+    if(channel != NULL){
+      g_object_unref(channel);
+    }
+
+    if(audio != NULL){
+      g_object_unref(audio);
+    }
+
+    if(output_soundcard != NULL){
+      g_object_unref(output_soundcard);
+    }
+    
     g_object_unref(lfo_recycling);
 
     g_object_unref(lfo_channel_run);
@@ -196,6 +196,9 @@ ags_apply_bpm_set_property(GObject *gobject,
       }
 
       apply_bpm->scope = (GObject *) scope;
+
+      ags_task_set_coalesce_key((AgsTask *) apply_bpm,
+				scope);
     }
     break;
   case PROP_BPM:
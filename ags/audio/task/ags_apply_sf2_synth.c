@@ -21,6 +21,7 @@
 
 #include <ags/audio/ags_audio.h>
 #include <ags/audio/ags_input.h>
+#include <ags/audio/ags_recycling.h>
 #include <ags/audio/ags_audio_signal.h>
 #include <ags/audio/ags_sf2_synth_generator.h>
 #include <ags/audio/ags_audio_buffer_util.h>
@@ -30,6 +31,19 @@
 
 #include <ags/i18n.h>
 
+typedef struct _AgsApplySF2SynthJob AgsApplySF2SynthJob;
+
+struct _AgsApplySF2SynthJob
+{
+  AgsSF2SynthGenerator *sf2_synth_generator;
+
+  GList *audio_signal;
+  GList *previous_future;
+
+  gdouble note;
+  guint requested_frame_count;
+};
+
 void ags_apply_sf2_synth_class_init(AgsApplySF2SynthClass *apply_sf2_synth);
 void ags_apply_sf2_synth_init(AgsApplySF2Synth *apply_sf2_synth);
 void ags_apply_sf2_synth_set_property(GObject *gobject,
@@ -45,6 +59,14 @@ void ags_apply_sf2_synth_finalize(GObject *gobject);
 
 void ags_apply_sf2_synth_launch(AgsTask *task);
 
+AgsApplySF2SynthJob* ags_apply_sf2_synth_job_alloc(AgsSF2SynthGenerator *sf2_synth_generator,
+						   GList *audio_signal,
+						   gdouble note,
+						   guint requested_frame_count);
+void ags_apply_sf2_synth_job_free(AgsApplySF2SynthJob *apply_sf2_synth_job);
+gpointer ags_apply_sf2_synth_job_run(AgsFuture *future,
+				     gpointer data);
+
 /**
  * SECTION:ags_apply_sf2_synth
  * @short_description: apply Soundfont2 synth to channel
@@ -53,6 +75,10 @@ void ags_apply_sf2_synth_launch(AgsTask *task);
  * @include: ags/audio/task/ags_apply_sf2_synth.h
  *
  * The #AgsApplySF2Synth task apply the specified Soundfont2 synth to channel.
+ *
+ * The audio signal of every key is rendered by its own job on the shared
+ * #AgsJobPool and swapped into place once ready, so the task launcher
+ * doesn't wait for the computation.
  */
 
 static gpointer ags_apply_sf2_synth_parent_class = NULL;
@@ -383,24 +409,22 @@ ags_apply_sf2_synth_launch(AgsTask *task)
 {
   AgsApplySF2Synth *apply_sf2_synth;
 
-  AgsAudio *audio;
-  AgsChannel *channel, *next_pad, *input;
+  AgsChannel *channel, *next_pad;
   AgsRecycling *first_recycling;
   AgsAudioSignal *audio_signal;
   AgsSF2SynthGenerator *sf2_synth_generator;
 
+  AgsJobPool *job_pool;
+  AgsFuture *future, *render_future;
+  
+  AgsApplySF2SynthJob *apply_sf2_synth_job;
+
   GObject *output_soundcard;
   
   GList *list_start;
-  GList *rt_template_start, *rt_template;
+  GList *start_target, *target;
 
-  gchar *str;
-  
-  gdouble base_note;
-  gdouble note;
-  guint count;
   guint requested_frame_count;
-  guint buffer_size;
   guint i;
   
   apply_sf2_synth = AGS_APPLY_SF2_SYNTH(task);
@@ -408,23 +432,13 @@ ags_apply_sf2_synth_launch(AgsTask *task)
   g_return_if_fail(AGS_IS_CHANNEL(apply_sf2_synth->start_channel));
   g_return_if_fail(AGS_IS_SF2_SYNTH_GENERATOR(apply_sf2_synth->sf2_synth_generator));
   
-  channel = apply_sf2_synth->start_channel;
-  
   sf2_synth_generator = apply_sf2_synth->sf2_synth_generator;
 
-  base_note = apply_sf2_synth->base_note;
-  count = apply_sf2_synth->count;
-
   requested_frame_count = apply_sf2_synth->requested_frame_count;
 
-  buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
-  
-  /* get some fields */
-  g_object_get(channel,
-	       "audio", &audio,
-	       NULL);
+  job_pool = ags_job_pool_get_instance();
 
-  /* compute */
+  /* submit one render job per key */
   channel = apply_sf2_synth->start_channel;
 
   if(channel != NULL){
@@ -454,44 +468,47 @@ ags_apply_sf2_synth_launch(AgsTask *task)
 
 	g_object_ref(audio_signal);
       }
-	
-      /* compute audio signal */
-      note = apply_sf2_synth->base_note + (gdouble) i;
-	
-      ags_sf2_synth_generator_compute(sf2_synth_generator,
-				      (GObject *) audio_signal,
-				      note);
-      
-      g_object_get(audio_signal,
-		   "buffer-size", &buffer_size,
-		   NULL);
-      
-      g_object_set(audio_signal,
-		   "length", (guint) ceil(requested_frame_count / buffer_size),
-		   "frame-count", requested_frame_count,
-		   NULL);
 
-      rt_template = 
-	rt_template_start = ags_audio_signal_get_rt_template(list_start);
+      /* template and rt-templates */
+      start_target = g_list_prepend(ags_audio_signal_get_rt_template(list_start),
+				    audio_signal);
 
-      while(rt_template != NULL){
-	ags_sf2_synth_generator_compute(sf2_synth_generator,
-					rt_template->data,
-					note);
-	
-	g_object_get(rt_template->data,
-		     "buffer-size", &buffer_size,
-		     NULL);
+      apply_sf2_synth_job = ags_apply_sf2_synth_job_alloc(sf2_synth_generator,
+							  start_target,
+							  apply_sf2_synth->base_note + (gdouble) i,
+							  requested_frame_count);
+
+      /* render after the pending jobs of the same signals */
+      target = start_target;
+
+      while(target != NULL){
+	render_future = ags_audio_signal_get_render_future(target->data);
+
+	if(render_future != NULL){
+	  apply_sf2_synth_job->previous_future = g_list_prepend(apply_sf2_synth_job->previous_future,
+								render_future);
+	}
 	
-	g_object_set(rt_template->data,
-		     "length", (guint) ceil(requested_frame_count / buffer_size),
-		     "frame-count", requested_frame_count,
-		     NULL);
+	target = target->next;
+      }
+
+      future = ags_job_pool_submit(job_pool,
+				   (AgsJobFunc) ags_apply_sf2_synth_job_run,
+				   apply_sf2_synth_job,
+				   (GDestroyNotify) ags_apply_sf2_synth_job_free);
+
+      target = start_target;
 
-	rt_template = rt_template->next;
+      while(target != NULL){
+	ags_audio_signal_set_render_future(target->data,
+					   future);
+	
+	target = target->next;
       }
 
-      g_list_free_full(rt_template_start,
+      ags_future_unref(future);
+
+      g_list_free_full(start_target,
 		       g_object_unref);
     
       g_list_free_full(list_start,
@@ -499,7 +516,6 @@ ags_apply_sf2_synth_launch(AgsTask *task)
 	
       g_object_unref(output_soundcard);
       g_object_unref(first_recycling);
-      g_object_unref(audio_signal);
       
       /* iterate */
       next_pad = ags_channel_next_pad(channel);
@@ -509,10 +525,131 @@ ags_apply_sf2_synth_launch(AgsTask *task)
       channel = next_pad;
     }
   }
+}
+
+AgsApplySF2SynthJob*
+ags_apply_sf2_synth_job_alloc(AgsSF2SynthGenerator *sf2_synth_generator,
+			      GList *audio_signal,
+			      gdouble note,
+			      guint requested_frame_count)
+{
+  AgsApplySF2SynthJob *apply_sf2_synth_job;
+
+  apply_sf2_synth_job = (AgsApplySF2SynthJob *) g_malloc(sizeof(AgsApplySF2SynthJob));
+
+  apply_sf2_synth_job->sf2_synth_generator = sf2_synth_generator;
+  g_object_ref(sf2_synth_generator);
 
-  if(audio != NULL){
-    g_object_unref(audio);
+  apply_sf2_synth_job->audio_signal = g_list_copy_deep(audio_signal,
+						       (GCopyFunc) g_object_ref,
+						       NULL);
+  apply_sf2_synth_job->previous_future = NULL;
+
+  apply_sf2_synth_job->note = note;
+  apply_sf2_synth_job->requested_frame_count = requested_frame_count;
+
+  return(apply_sf2_synth_job);
+}
+
+void
+ags_apply_sf2_synth_job_free(AgsApplySF2SynthJob *apply_sf2_synth_job)
+{
+  if(apply_sf2_synth_job == NULL){
+    return;
   }
+
+  g_object_unref(apply_sf2_synth_job->sf2_synth_generator);
+
+  g_list_free_full(apply_sf2_synth_job->audio_signal,
+		   g_object_unref);
+  g_list_free_full(apply_sf2_synth_job->previous_future,
+		   (GDestroyNotify) ags_future_unref);
+
+  g_free(apply_sf2_synth_job);
+}
+
+gpointer
+ags_apply_sf2_synth_job_run(AgsFuture *future,
+			    gpointer data)
+{
+  AgsAudioSignal *audio_signal, *scratch;
+
+  AgsApplySF2SynthJob *apply_sf2_synth_job;
+
+  GObject *output_soundcard;
+
+  GList *previous_future;
+  GList *target;
+
+  guint samplerate;
+  guint buffer_size;
+  guint format;
+
+  apply_sf2_synth_job = (AgsApplySF2SynthJob *) data;
+
+  /* wait for the renders submitted before */
+  previous_future = apply_sf2_synth_job->previous_future;
+
+  while(previous_future != NULL){
+    ags_future_wait(previous_future->data);
+
+    previous_future = previous_future->next;
+  }
+
+  target = apply_sf2_synth_job->audio_signal;
+
+  while(target != NULL){
+    audio_signal = AGS_AUDIO_SIGNAL(target->data);
+
+    output_soundcard = NULL;
+
+    samplerate = AGS_SOUNDCARD_DEFAULT_SAMPLERATE;
+    buffer_size = AGS_SOUNDCARD_DEFAULT_BUFFER_SIZE;
+    format = AGS_SOUNDCARD_DEFAULT_FORMAT;
+    
+    g_object_get(audio_signal,
+		 "output-soundcard", &output_soundcard,
+		 "samplerate", &samplerate,
+		 "buffer-size", &buffer_size,
+		 "format", &format,
+		 NULL);
+
+    /* compute on a copy, the audio thread keeps reading the old data */
+    scratch = ags_audio_signal_new(output_soundcard,
+				   NULL,
+				   NULL);
+    g_object_set(scratch,
+		 "samplerate", samplerate,
+		 "buffer-size", buffer_size,
+		 "format", format,
+		 NULL);
+    
+    ags_audio_signal_duplicate_stream(scratch,
+				      audio_signal);
+
+    ags_sf2_synth_generator_compute(apply_sf2_synth_job->sf2_synth_generator,
+				    (GObject *) scratch,
+				    apply_sf2_synth_job->note);
+
+    g_object_set(scratch,
+		 "length", (guint) ceil(apply_sf2_synth_job->requested_frame_count / buffer_size),
+		 "frame-count", apply_sf2_synth_job->requested_frame_count,
+		 NULL);
+
+    /* publish */
+    ags_audio_signal_swap_stream(audio_signal,
+				 scratch);
+
+    g_object_unref(scratch);
+
+    if(output_soundcard != NULL){
+      g_object_unref(output_soundcard);
+    }
+    
+    target = target->next;
+  }
+
+  return(NULL);
 }
 
 /**
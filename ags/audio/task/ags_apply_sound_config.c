@@ -1022,8 +1022,11 @@ ags_apply_sound_config_launch(AgsTask *task)
     if(AGS_IS_PULSE_DEVOUT(soundcard)){
       GList *start_port, *port;
 
+      guint port_format;
+      
       g_object_get(soundcard,
 		   "pulse-port", &start_port,
+		   "format", &port_format,
 		   NULL);
 
       port = start_port;
@@ -1036,7 +1039,7 @@ ags_apply_sound_config_launch(AgsTask *task)
 	ags_pulse_port_set_buffer_size(port->data,
 				       buffer_size);
 	ags_pulse_port_set_format(port->data,
-				  format);
+				  port_format);
 	ags_pulse_port_set_cache_buffer_size(port->data,
 					     buffer_size * ceil(cache_buffer_size / buffer_size));
 	
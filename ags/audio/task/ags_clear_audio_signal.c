@@ -28,6 +28,14 @@
 
 #include <ags/i18n.h>
 
+typedef struct _AgsClearAudioSignalJob AgsClearAudioSignalJob;
+
+struct _AgsClearAudioSignalJob
+{
+  GList *audio_signal;
+  GList *previous_future;
+};
+
 void ags_clear_audio_signal_class_init(AgsClearAudioSignalClass *clear_audio_signal);
 void ags_clear_audio_signal_init(AgsClearAudioSignal *clear_audio_signal);
 void ags_clear_audio_signal_set_property(GObject *gobject,
@@ -43,6 +51,11 @@ void ags_clear_audio_signal_finalize(GObject *gobject);
 
 void ags_clear_audio_signal_launch(AgsTask *task);
 
+void ags_clear_audio_signal_clear(GList *audio_signal);
+void ags_clear_audio_signal_job_free(AgsClearAudioSignalJob *clear_audio_signal_job);
+gpointer ags_clear_audio_signal_job_run(AgsFuture *future,
+					gpointer data);
+
 /**
  * SECTION:ags_clear_audio_signal
  * @short_description: clear audio signal object
@@ -50,7 +63,8 @@ void ags_clear_audio_signal_launch(AgsTask *task);
  * @section_id:
  * @include: ags/audio/task/ags_clear_audio_signal.h
  *
- * The #AgsClearAudioSignal task clears #AgsAudioSignal.
+ * The #AgsClearAudioSignal task clears #AgsAudioSignal. If a render job of
+ * #AgsApplySynth or similar is still pending, the clear is queued behind it.
  */
 
 static gpointer ags_clear_audio_signal_parent_class = NULL;
@@ -236,10 +250,14 @@ ags_clear_audio_signal_launch(AgsTask *task)
   AgsAudioSignal *audio_signal;
 
   AgsClearAudioSignal *clear_audio_signal;
-  
-  GList *stream;
 
-  guint format;
+  AgsJobPool *job_pool;
+  AgsFuture *future, *render_future;
+
+  AgsClearAudioSignalJob *clear_audio_signal_job;
+  
+  GList *start_target, *target;
+  GList *start_previous_future;
   
   clear_audio_signal = AGS_CLEAR_AUDIO_SIGNAL(task);
 
@@ -247,24 +265,14 @@ ags_clear_audio_signal_launch(AgsTask *task)
   
   /* clear */
   audio_signal = clear_audio_signal->audio_signal;
-  
-  /* clear the stream */
-  stream = audio_signal->stream;
 
-  g_object_get(audio_signal,
-	       "format", &format,
-	       NULL);
+  g_object_ref(audio_signal);
+  
+  start_target = g_list_prepend(NULL,
+				audio_signal);
   
-  while(stream != NULL){
-    ags_audio_buffer_util_clear_buffer(stream->data, 1,
-				       audio_signal->buffer_size, ags_audio_buffer_util_format_from_soundcard(format));
-    
-    stream = stream->next;
-  }
-
   if(ags_audio_signal_test_flags(audio_signal, AGS_AUDIO_SIGNAL_TEMPLATE)){
     GList *list_start;
-    GList *rt_template_start, *rt_template;
 
     g_object_get(audio_signal,
 		 "recycling", &recycling,
@@ -273,36 +281,122 @@ ags_clear_audio_signal_launch(AgsTask *task)
     g_object_get(recycling,
 		 "audio-signal", &list_start,
 		 NULL);
-    
-    rt_template =
-      rt_template_start = ags_audio_signal_get_rt_template(list_start);
-
-    while(rt_template != NULL){
-      /* clear the stream */
-      stream = AGS_AUDIO_SIGNAL(rt_template->data)->stream;
-
-      g_object_get(rt_template->data,
-		   "format", &format,
-		   NULL);
-      
-      while(stream != NULL){
-	ags_audio_buffer_util_clear_buffer(stream->data, 1,
-					   audio_signal->buffer_size, ags_audio_buffer_util_format_from_soundcard(format));
-	
-	stream = stream->next;
-      }
 
-      rt_template = rt_template->next;
-    }
-
-    g_list_free_full(rt_template_start,
-		     g_object_unref);
+    start_target = g_list_concat(start_target,
+				 ags_audio_signal_get_rt_template(list_start));
     
     g_list_free_full(list_start,
 		     g_object_unref);
 
     g_object_unref(recycling);
   }
+
+  /* renders still pending on the job pool */
+  start_previous_future = NULL;
+  
+  target = start_target;
+
+  while(target != NULL){
+    render_future = ags_audio_signal_get_render_future(target->data);
+
+    if(render_future != NULL){
+      if(!ags_future_is_done(render_future)){
+	start_previous_future = g_list_prepend(start_previous_future,
+					       render_future);
+      }else{
+	ags_future_unref(render_future);
+      }
+    }
+    
+    target = target->next;
+  }
+
+  if(start_previous_future == NULL){
+    ags_clear_audio_signal_clear(start_target);
+
+    g_list_free_full(start_target,
+		     g_object_unref);
+
+    return;
+  }
+
+  /* clear after them */
+  job_pool = ags_job_pool_get_instance();
+
+  clear_audio_signal_job = (AgsClearAudioSignalJob *) g_malloc(sizeof(AgsClearAudioSignalJob));
+
+  clear_audio_signal_job->audio_signal = g_list_copy_deep(start_target,
+							  (GCopyFunc) g_object_ref,
+							  NULL);
+  clear_audio_signal_job->previous_future = start_previous_future;
+  
+  future = ags_job_pool_submit(job_pool,
+			       (AgsJobFunc) ags_clear_audio_signal_job_run,
+			       clear_audio_signal_job,
+			       (GDestroyNotify) ags_clear_audio_signal_job_free);
+
+  target = start_target;
+
+  while(target != NULL){
+    ags_audio_signal_set_render_future(target->data,
+				       future);
+	
+    target = target->next;
+  }
+
+  ags_future_unref(future);
+
+  g_list_free_full(start_target,
+		   g_object_unref);
+}
+
+void
+ags_clear_audio_signal_clear(GList *audio_signal)
+{
+  while(audio_signal != NULL){
+    ags_audio_signal_clear(audio_signal->data);
+
+    audio_signal = audio_signal->next;
+  }
+}
+
+void
+ags_clear_audio_signal_job_free(AgsClearAudioSignalJob *clear_audio_signal_job)
+{
+  if(clear_audio_signal_job == NULL){
+    return;
+  }
+
+  g_list_free_full(clear_audio_signal_job->audio_signal,
+		   g_object_unref);
+  g_list_free_full(clear_audio_signal_job->previous_future,
+		   (GDestroyNotify) ags_future_unref);
+
+  g_free(clear_audio_signal_job);
+}
+
+gpointer
+ags_clear_audio_signal_job_run(AgsFuture *future,
+			       gpointer data)
+{
+  AgsClearAudioSignalJob *clear_audio_signal_job;
+
+  GList *previous_future;
+
+  clear_audio_signal_job = (AgsClearAudioSignalJob *) data;
+
+  /* wait for the renders submitted before */
+  previous_future = clear_audio_signal_job->previous_future;
+
+  while(previous_future != NULL){
+    ags_future_wait(previous_future->data);
+
+    previous_future = previous_future->next;
+  }
+
+  ags_clear_audio_signal_clear(clear_audio_signal_job->audio_signal);
+
+  return(NULL);
 }
 
 /**
@@ -194,6 +194,9 @@ ags_set_buffer_size_set_property(GObject *gobject,
       }
 
       set_buffer_size->scope = (GObject *) scope;
+
+      ags_task_set_coalesce_key((AgsTask *) set_buffer_size,
+				scope);
     }
     break;
   case PROP_BUFFER_SIZE:
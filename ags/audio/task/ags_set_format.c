@@ -193,6 +193,9 @@ ags_set_format_set_property(GObject *gobject,
       }
 
       set_format->scope = (GObject *) scope;
+
+      ags_task_set_coalesce_key((AgsTask *) set_format,
+				scope);
     }
     break;
   case PROP_FORMAT:
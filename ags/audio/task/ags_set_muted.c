@@ -191,6 +191,9 @@ ags_set_muted_set_property(GObject *gobject,
       }
 
       set_muted->scope = (GObject *) scope;
+
+      ags_task_set_coalesce_key((AgsTask *) set_muted,
+				scope);
     }
     break;
   case PROP_MUTED:
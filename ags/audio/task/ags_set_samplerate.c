@@ -194,6 +194,9 @@ ags_set_samplerate_set_property(GObject *gobject,
       }
 
       set_samplerate->scope = (GObject *) scope;
+
+      ags_task_set_coalesce_key((AgsTask *) set_samplerate,
+				scope);
     }
     break;
   case PROP_SAMPLERATE:
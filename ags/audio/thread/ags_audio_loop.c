@@ -29,6 +29,7 @@
 #include <ags/audio/thread/ags_export_thread.h>
 #include <ags/audio/thread/ags_audio_thread.h>
 #include <ags/audio/thread/ags_channel_thread.h>
+#include <ags/audio/thread/ags_audio_scheduler.h>
 
 #include <ags/i18n.h>
 
@@ -232,6 +233,9 @@ ags_audio_loop_init(AgsAudioLoop *audio_loop)
 
   AgsConfig *config;
 
+  gchar *thread_model;
+  gchar *clock_source;
+
   gdouble frequency;
   guint samplerate;
   guint buffer_size;
@@ -254,6 +258,50 @@ ags_audio_loop_init(AgsAudioLoop *audio_loop)
 
   audio_loop->flags = 0;
 
+  /* thread model */
+  thread_model = ags_config_get_value(config,
+				      AGS_CONFIG_THREAD,
+				      "model");
+
+  if(thread_model != NULL &&
+     !g_ascii_strncasecmp(thread_model,
+			  "work-stealing",
+			  14)){
+    audio_loop->flags |= AGS_AUDIO_LOOP_WORK_STEALING;
+  }
+
+  g_free(thread_model);
+
+  /* clock source - either relative sleeps, absolute deadlines or slaved to the device's periods */
+  clock_source = ags_config_get_value(config,
+				      AGS_CONFIG_THREAD,
+				      "clock-source");
+
+  if(clock_source != NULL &&
+     (!g_ascii_strncasecmp(clock_source,
+			   "deadline",
+			   9) ||
+      !g_ascii_strncasecmp(clock_source,
+			   "device",
+			   7))){
+    thread->deadline_clock = ags_deadline_clock_alloc(0);
+
+    ags_deadline_clock_set_soundcard_period(thread->deadline_clock,
+					    samplerate,
+					    buffer_size);
+
+    if(!g_ascii_strncasecmp(clock_source,
+			    "device",
+			    7)){
+      ags_deadline_clock_set_flags(thread->deadline_clock, AGS_DEADLINE_CLOCK_SLAVE);
+    }
+  }
+
+  g_free(clock_source);
+
+  /* tic barrier - all synced threads arrive at the main loop's */
+  thread->tic_barrier = ags_tic_barrier_alloc(AGS_TIC_BARRIER_DEFAULT_SPIN_COUNT);
+
   /* tree lock mutex */
   g_rec_mutex_init(&(audio_loop->tree_lock));
 
@@ -269,6 +317,12 @@ ags_audio_loop_init(AgsAudioLoop *audio_loop)
   audio_loop->play_audio_ref = 0;
   audio_loop->play_audio = NULL;
 
+  /* published to the hot loop */
+  audio_loop->epoch_reclaimer = ags_epoch_reclaimer_alloc();
+
+  audio_loop->play_channel_array = NULL;
+  audio_loop->play_audio_array = NULL;
+
   audio_loop->sync_thread = NULL;
 
   /* staging program */
@@ -315,6 +369,10 @@ ags_audio_loop_set_property(GObject *gobject,
 	audio_loop->play_channel = g_list_prepend(audio_loop->play_channel,
 						  playback);
 	audio_loop->play_channel_ref = audio_loop->play_channel_ref + 1;
+
+	ags_epoch_array_publish(&(audio_loop->play_channel_array),
+				audio_loop->play_channel,
+				audio_loop->epoch_reclaimer);
       }
 
       g_rec_mutex_unlock(thread_mutex);
@@ -334,6 +392,10 @@ ags_audio_loop_set_property(GObject *gobject,
 						playback_domain);
 	g_object_ref(playback_domain);
 	audio_loop->play_audio_ref = audio_loop->play_audio_ref + 1;
+
+	ags_epoch_array_publish(&(audio_loop->play_audio_array),
+				audio_loop->play_audio,
+				audio_loop->epoch_reclaimer);
       }
 
       g_rec_mutex_unlock(thread_mutex);
@@ -410,6 +472,18 @@ ags_audio_loop_dispose(GObject *gobject)
     
     audio_loop->play_audio = NULL;
   }
+
+  if(audio_loop->play_channel_array != NULL){
+    ags_epoch_array_publish(&(audio_loop->play_channel_array),
+			    NULL,
+			    audio_loop->epoch_reclaimer);
+  }
+
+  if(audio_loop->play_audio_array != NULL){
+    ags_epoch_array_publish(&(audio_loop->play_audio_array),
+			    NULL,
+			    audio_loop->epoch_reclaimer);
+  }
   
   /* call parent */
   G_OBJECT_CLASS(ags_audio_loop_parent_class)->dispose(gobject);
@@ -429,6 +503,12 @@ ags_audio_loop_finalize(GObject *gobject)
   g_list_free_full(audio_loop->play_audio,
 		   g_object_unref);
 
+  /* published arrays */
+  ags_epoch_array_free(audio_loop->play_channel_array);
+  ags_epoch_array_free(audio_loop->play_audio_array);
+
+  ags_epoch_reclaimer_free(audio_loop->epoch_reclaimer);
+
   /* call parent */
   G_OBJECT_CLASS(ags_audio_loop_parent_class)->finalize(gobject);
 }
@@ -546,6 +626,13 @@ ags_audio_loop_change_frequency(AgsMainLoop *main_loop,
 	       "frequency", frequency,
 	       NULL);
 
+  /* deadline clock */
+  if(audio_loop->deadline_clock != NULL &&
+     frequency > 0.0){
+    ags_deadline_clock_set_period(audio_loop->deadline_clock,
+				  (guint64) ((gdouble) AGS_NSEC_PER_SEC / frequency));
+  }
+
   /* reset soundcard thread */
   thread = ags_thread_find_type(audio_loop, AGS_TYPE_SOUNDCARD_THREAD);
 
@@ -670,6 +757,12 @@ ags_audio_loop_run(AgsThread *thread)
 
   thread_mutex = AGS_THREAD_GET_OBJ_MUTEX(thread);
   
+  /* CPU affinity */
+  ags_cpu_affinity_setup(AGS_CPU_AFFINITY_KEY_AUDIO_MAIN_LOOP);
+
+  /* realtime sanitizer */
+  ags_rt_sanitizer_mark_rt_thread(TRUE);
+
   /* real-time setup */
 #ifdef AGS_WITH_RT
   if(!ags_thread_test_status_flags(thread, AGS_THREAD_STATUS_RT_SETUP)){
@@ -739,6 +832,9 @@ ags_audio_loop_run(AgsThread *thread)
     }
   }
 
+  /* free retired play lists, doesn't block */
+  ags_epoch_reclaimer_try_collect(audio_loop->epoch_reclaimer);
+
   /* decide if we stop */
   if(play_channel_ref == 0 &&
      play_audio_ref == 0){
@@ -810,7 +906,11 @@ ags_audio_loop_run(AgsThread *thread)
 		 NULL);
 
     if(!ags_thread_test_flags(audio_loop, AGS_THREAD_TIME_ACCOUNTING)){
-      g_usleep((guint) (G_USEC_PER_SEC / frequency) - 4);
+      if(thread->deadline_clock != NULL){
+	ags_deadline_clock_wait(thread->deadline_clock);
+      }else{
+	g_usleep((guint) (G_USEC_PER_SEC / frequency) - 4);
+      }
     }
   }
 }
@@ -829,25 +929,25 @@ ags_audio_loop_play_channel(AgsAudioLoop *audio_loop)
   AgsPlayback *playback;
   AgsChannel *channel;
 
-  GList *start_play_channel, *play_channel;
+  AgsEpochArray *play_channel_array;
+
   GList *recall_id;
 
-  gint sound_scope;
+  guint *staging_program;
 
-  GRecMutex *thread_mutex;
-  
-  thread_mutex = AGS_THREAD_GET_OBJ_MUTEX(audio_loop);
+  gint sound_scope;
+  guint staging_program_count;
+  guint epoch;
+  guint i;
+  guint nth;
 
-  /* get play channel */
-  g_rec_mutex_lock(thread_mutex);
+  /* get play channel - immutable as long as we didn't leave the epoch */
+  epoch = ags_epoch_reclaimer_enter(audio_loop->epoch_reclaimer);
 
-  start_play_channel = g_list_copy_deep(audio_loop->play_channel,
-					(GCopyFunc) g_object_ref,
-					NULL);
-  
-  g_rec_mutex_unlock(thread_mutex);
+  play_channel_array = g_atomic_pointer_get(&(audio_loop->play_channel_array));
 
-  if(start_play_channel == NULL){
+  if(play_channel_array == NULL ||
+     play_channel_array->length == 0){
     if(ags_audio_loop_test_flags(audio_loop, AGS_AUDIO_LOOP_PLAY_CHANNEL_TERMINATING)){
       ags_audio_loop_unset_flags(audio_loop, (AGS_AUDIO_LOOP_PLAY_CHANNEL |
 					      AGS_AUDIO_LOOP_PLAY_CHANNEL_TERMINATING));
@@ -859,18 +959,22 @@ ags_audio_loop_play_channel(AgsAudioLoop *audio_loop)
   //FIXME:JK: missing else
   ags_audio_loop_unset_flags(audio_loop, AGS_AUDIO_LOOP_PLAY_CHANNEL_TERMINATING);
   ags_audio_loop_set_flags(audio_loop, AGS_AUDIO_LOOP_PLAYING_CHANNEL);
+
+  /* staging program - fetched once per tic */
+  staging_program = ags_audio_loop_get_staging_program(audio_loop,
+						       &staging_program_count);
   
   /* run the 3 stages */
-  play_channel = start_play_channel;
+  for(i = 0; play_channel_array != NULL && i < play_channel_array->length; i++){
+    playback = (AgsPlayback *) play_channel_array->data[i];
 
-  while(play_channel != NULL){
-    playback = (AgsPlayback *) play_channel->data;
+    /* the playback holds a reference to its channel */
+    channel = (AgsChannel *) g_atomic_pointer_get(&(playback->channel));
 
-    channel = NULL;
-    g_object_get(playback,
-		 "channel", &channel,
-		 NULL);
-        
+    if(channel == NULL){
+      continue;
+    }
+    
     /* play */
 #if 0
     if(ags_playback_test_flags(playback, AGS_PLAYBACK_SUPER_THREADED_CHANNEL)){
@@ -883,50 +987,29 @@ ags_audio_loop_play_channel(AgsAudioLoop *audio_loop)
       sound_scope = AGS_SOUND_SCOPE_PLAYBACK;
       
       if(ags_playback_get_recall_id(playback, sound_scope) == NULL){
-	g_object_unref(channel);
-	
-	play_channel = play_channel->next;
-	
 	continue;
       }
     
       if((recall_id = ags_channel_check_scope(channel, sound_scope)) != NULL){
-	guint *staging_program;
-	
-	guint staging_program_count;
-	guint nth;
-
-	staging_program = ags_audio_loop_get_staging_program(audio_loop,
-							     &staging_program_count);
-	
 	for(nth = 0; nth < staging_program_count; nth++){
 	  ags_channel_recursive_run_stage(channel,
 					  sound_scope, staging_program[nth]);
 	}
 
-	g_free(staging_program);
-
 	g_list_free_full(recall_id,
 			 g_object_unref);
       }
 #if 0
     }
 #endif
-
-    if(channel != NULL){
-      g_object_unref(channel);
-    }
-    
-    /* iterate */
-    play_channel = play_channel->next;
   }
 
+  g_free(staging_program);
+
   /* sync channel */
 #if 0
-  play_channel = start_play_channel;
-  
-  while(play_channel != NULL){    
-    playback = (AgsPlayback *) play_channel->data;
+  for(i = 0; play_channel_array != NULL && i < play_channel_array->length; i++){
+    playback = (AgsPlayback *) play_channel_array->data[i];
 
     /* sync */
     if(ags_playback_test_flags(playback, AGS_PLAYBACK_SUPER_THREADED_CHANNEL)){
@@ -934,14 +1017,11 @@ ags_audio_loop_play_channel(AgsAudioLoop *audio_loop)
       ags_audio_loop_sync_channel_super_threaded(audio_loop,
 						 playback);
     }
-
-    /* iterate */
-    play_channel = play_channel->next;
   }
 #endif
   
-  g_list_free_full(start_play_channel,
-		   g_object_unref);
+  ags_epoch_reclaimer_leave(audio_loop->epoch_reclaimer,
+			    epoch);
 }
 
 void
@@ -1061,7 +1141,8 @@ ags_audio_loop_sync_channel_super_threaded(AgsAudioLoop *audio_loop,
  * ags_audio_loop_play_audio:
  * @audio_loop: an #AgsAudioLoop
  *
- * Invokes ags_audio_recursive_run_stage() for all scopes containing #AgsRecallID.
+ * Runs the #AgsExecutionPlan of all scopes containing #AgsRecallID.
+ * As %AGS_AUDIO_LOOP_WORK_STEALING is set, all audio is run by #AgsAudioScheduler.
  *
  * Since: 3.0.0
  */
@@ -1071,25 +1152,30 @@ ags_audio_loop_play_audio(AgsAudioLoop *audio_loop)
   AgsPlaybackDomain *playback_domain;
   AgsAudio *audio;
 
-  GList *start_play_audio, *play_audio;
-  GList *recall_id;
-  
-  gint sound_scope;
+  AgsEpochArray *play_audio_array;
 
-  GRecMutex *thread_mutex;
+  GList *start_scheduled_audio;
 
-  thread_mutex = AGS_THREAD_GET_OBJ_MUTEX(audio_loop);
+  guint *staging_program;
+  
+  gint sound_scope;
+  guint staging_program_count;
+  guint epoch;
+  guint i;
+  guint nth;
+  gboolean work_stealing;
 
-  /* get play audio */
-  g_rec_mutex_lock(thread_mutex);
+  work_stealing = ags_audio_loop_test_flags(audio_loop, AGS_AUDIO_LOOP_WORK_STEALING);
 
-  start_play_audio = g_list_copy_deep(audio_loop->play_audio,
-				      (GCopyFunc) g_object_ref,
-				      NULL);
+  start_scheduled_audio = NULL;
   
-  g_rec_mutex_unlock(thread_mutex);
+  /* get play audio - immutable as long as we didn't leave the epoch */
+  epoch = ags_epoch_reclaimer_enter(audio_loop->epoch_reclaimer);
+
+  play_audio_array = g_atomic_pointer_get(&(audio_loop->play_audio_array));
   
-  if(start_play_audio == NULL){
+  if(play_audio_array == NULL ||
+     play_audio_array->length == 0){
     if(ags_audio_loop_test_flags(audio_loop, AGS_AUDIO_LOOP_PLAY_AUDIO_TERMINATING)){
       ags_audio_loop_unset_flags(audio_loop, (AGS_AUDIO_LOOP_PLAY_AUDIO |
 					      AGS_AUDIO_LOOP_PLAY_AUDIO_TERMINATING));
@@ -1102,20 +1188,23 @@ ags_audio_loop_play_audio(AgsAudioLoop *audio_loop)
   ags_audio_loop_unset_flags(audio_loop, AGS_AUDIO_LOOP_PLAY_AUDIO_TERMINATING);
   ags_audio_loop_set_flags(audio_loop, AGS_AUDIO_LOOP_PLAYING_AUDIO);
 
-  /* playing */
-  play_audio = start_play_audio;
+  /* staging program - fetched once per tic */
+  staging_program = ags_audio_loop_get_staging_program(audio_loop,
+						       &staging_program_count);
 
-  while(play_audio != NULL){
+  /* playing */
+  for(i = 0; play_audio_array != NULL && i < play_audio_array->length; i++){
     AgsChannel *start_output;
     AgsChannel *output, *next;
     
-    playback_domain = (AgsPlaybackDomain *) play_audio->data;
+    playback_domain = (AgsPlaybackDomain *) play_audio_array->data[i];
 
-    audio = NULL;
-    
-    g_object_get(playback_domain,
-		 "audio", &audio,
-		 NULL);
+    /* the playback domain holds a reference to its audio */
+    audio = (AgsAudio *) g_atomic_pointer_get(&(playback_domain->audio));
+
+    if(audio == NULL){
+      continue;
+    }
     
     /* play */
     start_output = NULL;
@@ -1141,7 +1230,11 @@ ags_audio_loop_play_audio(AgsAudioLoop *audio_loop)
       }
     }
 
-    if(ags_playback_domain_test_flags(playback_domain, AGS_PLAYBACK_DOMAIN_SUPER_THREADED_AUDIO)){
+    if(work_stealing){
+      /* scheduled as soon as all play audio is collected */
+      start_scheduled_audio = g_list_prepend(start_scheduled_audio,
+					     audio);
+    }else if(ags_playback_domain_test_flags(playback_domain, AGS_PLAYBACK_DOMAIN_SUPER_THREADED_AUDIO)){
       /* super threaded */
       ags_audio_loop_play_audio_super_threaded(audio_loop,
 					       playback_domain);
@@ -1152,58 +1245,63 @@ ags_audio_loop_play_audio(AgsAudioLoop *audio_loop)
 	  continue;
 	}
 	
-	if((recall_id = ags_audio_check_scope(audio, sound_scope)) != NULL){
-	  guint *staging_program;
-	
-	  guint staging_program_count;
-	  guint nth;
+	AgsExecutionPlan *execution_plan;
 
-	  staging_program = ags_audio_loop_get_staging_program(audio_loop,
-							       &staging_program_count);
+	/* an empty plan means nothing of sound scope is playing */
+	execution_plan = ags_audio_get_execution_plan(audio,
+						      sound_scope);
+
+	if(execution_plan == NULL){
+	  continue;
+	}
 	
+	if(execution_plan->length > 0){
 	  for(nth = 0; nth < staging_program_count; nth++){
-	    ags_audio_recursive_run_stage(audio,
-					  sound_scope, staging_program[nth]);
+	    if(ags_execution_plan_test_staging_flags(staging_program[nth])){
+	      ags_execution_plan_run(execution_plan,
+				     staging_program[nth]);
+	    }else{
+	      ags_audio_recursive_run_stage(audio,
+					    sound_scope, staging_program[nth]);
+	    }
 	  }
-
-	  g_free(staging_program);
-	  
-	  g_list_free_full(recall_id,
-			   g_object_unref);
 	}
+
+	ags_execution_plan_unref(execution_plan);
       }
     }
 
-    if(audio != NULL){
-      g_object_unref(audio);
-    }
-    
     if(start_output != NULL){
       g_object_unref(start_output);
     }
+  }
+
+  /* work stealing */
+  if(start_scheduled_audio != NULL){
+    start_scheduled_audio = g_list_reverse(start_scheduled_audio);
     
-    /* iterate */
-    play_audio = play_audio->next;
+    ags_audio_scheduler_run(ags_audio_scheduler_get_instance(),
+			    start_scheduled_audio,
+			    staging_program, staging_program_count);
+
+    g_list_free(start_scheduled_audio);
   }
+
+  g_free(staging_program);
   
   /* sync audio */
-  play_audio = start_play_audio;
-
-  while(play_audio != NULL){
-    playback_domain = (AgsPlaybackDomain *) play_audio->data;
+  for(i = 0; play_audio_array != NULL && i < play_audio_array->length; i++){
+    playback_domain = (AgsPlaybackDomain *) play_audio_array->data[i];
 
     /* sync */
     if(ags_playback_domain_test_flags(playback_domain, AGS_PLAYBACK_DOMAIN_SUPER_THREADED_AUDIO)){
       ags_audio_loop_sync_audio_super_threaded(audio_loop,
 					       playback_domain);
     }
-    
-    /* iterate */
-    play_audio = play_audio->next;
   }
 
-  g_list_free_full(start_play_audio,
-		   g_object_unref);
+  ags_epoch_reclaimer_leave(audio_loop->epoch_reclaimer,
+			    epoch);
 
   g_list_free(audio_loop->sync_thread);
   audio_loop->sync_thread = NULL;
@@ -1471,6 +1569,10 @@ ags_audio_loop_add_audio(AgsAudioLoop *audio_loop, GObject *audio)
 					    playback_domain);
 
     audio_loop->play_audio_ref = audio_loop->play_audio_ref + 1;
+
+    ags_epoch_array_publish(&(audio_loop->play_audio_array),
+			    audio_loop->play_audio,
+			    audio_loop->epoch_reclaimer);
   }else{
     if(playback_domain != NULL){
       g_object_unref(playback_domain);
@@ -1514,6 +1616,10 @@ ags_audio_loop_remove_audio(AgsAudioLoop *audio_loop, GObject *audio)
     audio_loop->play_audio = g_list_remove(audio_loop->play_audio,
 					   playback_domain);
     audio_loop->play_audio_ref = audio_loop->play_audio_ref - 1;
+
+    ags_epoch_array_publish(&(audio_loop->play_audio_array),
+			    audio_loop->play_audio,
+			    audio_loop->epoch_reclaimer);
     
     g_object_unref(playback_domain);
   }
@@ -1560,6 +1666,10 @@ ags_audio_loop_add_channel(AgsAudioLoop *audio_loop, GObject *channel)
 					      playback);
 
     audio_loop->play_channel_ref = audio_loop->play_channel_ref + 1;
+
+    ags_epoch_array_publish(&(audio_loop->play_channel_array),
+			    audio_loop->play_channel,
+			    audio_loop->epoch_reclaimer);
   }else{
     if(playback != NULL){
       g_object_unref(playback);
@@ -1604,6 +1714,10 @@ ags_audio_loop_remove_channel(AgsAudioLoop *audio_loop, GObject *channel)
 					     playback);
     audio_loop->play_channel_ref = audio_loop->play_channel_ref - 1;
 
+    ags_epoch_array_publish(&(audio_loop->play_channel_array),
+			    audio_loop->play_channel,
+			    audio_loop->epoch_reclaimer);
+
     g_object_unref(playback);
   }
 
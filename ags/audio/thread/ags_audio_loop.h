@@ -51,6 +51,7 @@ typedef struct _AgsAudioLoopClass AgsAudioLoopClass;
  * @AGS_AUDIO_LOOP_PLAY_AUDIO: play audio
  * @AGS_AUDIO_LOOP_PLAYING_AUDIO: playing audio
  * @AGS_AUDIO_LOOP_PLAY_AUDIO_TERMINATING: play audio terminating
+ * @AGS_AUDIO_LOOP_WORK_STEALING: run audio by #AgsAudioScheduler
  * 
  * Enum values to control the behavior or indicate internal state of #AgsAudioLoop by
  * enable/disable as flags.
@@ -62,6 +63,7 @@ typedef enum{
   AGS_AUDIO_LOOP_PLAY_AUDIO                     = 1 << 3,
   AGS_AUDIO_LOOP_PLAYING_AUDIO                  = 1 << 4,
   AGS_AUDIO_LOOP_PLAY_AUDIO_TERMINATING         = 1 << 5,
+  AGS_AUDIO_LOOP_WORK_STEALING                  = 1 << 6,
 }AgsAudioLoopFlags;
 
 struct _AgsAudioLoop
@@ -83,6 +85,11 @@ struct _AgsAudioLoop
   guint play_audio_ref;
   GList *play_audio; // play AgsAudio
 
+  AgsEpochReclaimer *epoch_reclaimer;
+
+  AgsEpochArray *play_channel_array;
+  AgsEpochArray *play_audio_array;
+
   GList *sync_thread;
 
   gboolean do_fx_staging;
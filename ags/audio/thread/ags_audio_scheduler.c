@@ -0,0 +1,1172 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <ags/audio/thread/ags_audio_scheduler.h>
+
+#include <ags/audio/ags_audio.h>
+#include <ags/audio/ags_channel.h>
+
+#include <ags/i18n.h>
+
+void ags_audio_scheduler_class_init(AgsAudioSchedulerClass *audio_scheduler);
+void ags_audio_scheduler_init(AgsAudioScheduler *audio_scheduler);
+void ags_audio_scheduler_set_property(GObject *gobject,
+				      guint prop_id,
+				      const GValue *value,
+				      GParamSpec *param_spec);
+void ags_audio_scheduler_get_property(GObject *gobject,
+				      guint prop_id,
+				      GValue *value,
+				      GParamSpec *param_spec);
+void ags_audio_scheduler_finalize(GObject *gobject);
+
+void ags_audio_scheduler_free_graph(AgsAudioScheduler *audio_scheduler);
+void ags_audio_scheduler_find_upstream(GHashTable *upstream,
+				       GObject *audio);
+void ags_audio_scheduler_build_graph(AgsAudioScheduler *audio_scheduler,
+				     GList *audio);
+gboolean ags_audio_scheduler_graph_matches(AgsAudioScheduler *audio_scheduler,
+					   GList *audio);
+
+void ags_audio_scheduler_deque_push(AgsAudioSchedulerDeque *deque,
+				    AgsAudioSchedulerNode *node);
+AgsAudioSchedulerNode* ags_audio_scheduler_deque_pop(AgsAudioSchedulerDeque *deque);
+AgsAudioSchedulerNode* ags_audio_scheduler_deque_steal(AgsAudioSchedulerDeque *deque);
+
+void ags_audio_scheduler_run_node(AgsAudioScheduler *audio_scheduler,
+				  AgsAudioSchedulerNode *node);
+void ags_audio_scheduler_work(AgsAudioScheduler *audio_scheduler,
+			      guint nth_worker);
+
+void* ags_audio_scheduler_worker_run(void *ptr);
+
+/**
+ * SECTION:ags_audio_scheduler
+ * @short_description: work-stealing audio graph scheduler
+ * @title: AgsAudioScheduler
+ * @section_id:
+ * @include: ags/audio/thread/ags_audio_scheduler.h
+ *
+ * The #AgsAudioScheduler derives a dependency graph of the playing #AgsAudio
+ * from their channel links, every time the topology changes. Each tic the nodes
+ * are run on a fixed pool of workers, one per processor. Every worker owns a
+ * deque and steals from the others as it runs out of work, so independent
+ * machines are balanced across all cores.
+ */
+
+enum{
+  PROP_0,
+  PROP_WORKER_COUNT,
+};
+
+static gpointer ags_audio_scheduler_parent_class = NULL;
+
+static AgsAudioScheduler *ags_audio_scheduler = NULL;
+
+GType
+ags_audio_scheduler_get_type()
+{
+  static volatile gsize g_define_type_id__volatile = 0;
+
+  if(g_once_init_enter (&g_define_type_id__volatile)){
+    GType ags_type_audio_scheduler = 0;
+
+    static const GTypeInfo ags_audio_scheduler_info = {
+      sizeof(AgsAudioSchedulerClass),
+      NULL, /* base_init */
+      NULL, /* base_finalize */
+      (GClassInitFunc) ags_audio_scheduler_class_init,
+      NULL, /* class_finalize */
+      NULL, /* class_data */
+      sizeof(AgsAudioScheduler),
+      0,    /* n_preallocs */
+      (GInstanceInitFunc) ags_audio_scheduler_init,
+    };
+
+    ags_type_audio_scheduler = g_type_register_static(G_TYPE_OBJECT,
+						      "AgsAudioScheduler",
+						      &ags_audio_scheduler_info,
+						      0);
+
+    g_once_init_leave(&g_define_type_id__volatile, ags_type_audio_scheduler);
+  }
+
+  return g_define_type_id__volatile;
+}
+
+void
+ags_audio_scheduler_class_init(AgsAudioSchedulerClass *audio_scheduler)
+{
+  GObjectClass *gobject;
+
+  GParamSpec *param_spec;
+
+  ags_audio_scheduler_parent_class = g_type_class_peek_parent(audio_scheduler);
+
+  /* GObjectClass */
+  gobject = (GObjectClass *) audio_scheduler;
+
+  gobject->set_property = ags_audio_scheduler_set_property;
+  gobject->get_property = ags_audio_scheduler_get_property;
+
+  gobject->finalize = ags_audio_scheduler_finalize;
+
+  /* properties */
+  /**
+   * AgsAudioScheduler:worker-count:
+   *
+   * The count of workers including the thread calling ags_audio_scheduler_run(),
+   * it is applied as the workers are started.
+   * 
+   * Since: 3.7.0
+   */
+  param_spec = g_param_spec_uint("worker-count",
+				 i18n_pspec("worker count"),
+				 i18n_pspec("The count of workers"),
+				 1,
+				 G_MAXUINT32,
+				 1,
+				 G_PARAM_READABLE | G_PARAM_WRITABLE);
+  g_object_class_install_property(gobject,
+				  PROP_WORKER_COUNT,
+				  param_spec);
+}
+
+void
+ags_audio_scheduler_init(AgsAudioScheduler *audio_scheduler)
+{
+  audio_scheduler->flags = 0;
+
+  g_rec_mutex_init(&(audio_scheduler->obj_mutex));
+
+  /* workers */
+  audio_scheduler->worker_count = g_get_num_processors();
+
+  if(audio_scheduler->worker_count == 0){
+    audio_scheduler->worker_count = 1;
+  }
+  
+  audio_scheduler->worker = NULL;
+
+  audio_scheduler->deque = NULL;
+
+  g_mutex_init(&(audio_scheduler->wakeup_mutex));
+  g_cond_init(&(audio_scheduler->wakeup_cond));
+
+  audio_scheduler->epoch = 0;
+
+  g_mutex_init(&(audio_scheduler->done_mutex));
+  g_cond_init(&(audio_scheduler->done_cond));
+
+  audio_scheduler->active = 0;
+
+  /* graph */
+  audio_scheduler->topology_generation = 1;
+  audio_scheduler->graph_generation = 0;
+
+  audio_scheduler->audio = NULL;
+
+  audio_scheduler->node_count = 0;
+  audio_scheduler->node = NULL;
+
+  audio_scheduler->remaining = 0;
+
+  audio_scheduler->staging_program = NULL;
+  audio_scheduler->staging_program_count = 0;
+}
+
+void
+ags_audio_scheduler_set_property(GObject *gobject,
+				 guint prop_id,
+				 const GValue *value,
+				 GParamSpec *param_spec)
+{
+  AgsAudioScheduler *audio_scheduler;
+
+  GRecMutex *audio_scheduler_mutex;
+
+  audio_scheduler = AGS_AUDIO_SCHEDULER(gobject);
+
+  /* get audio scheduler mutex */
+  audio_scheduler_mutex = AGS_AUDIO_SCHEDULER_GET_OBJ_MUTEX(audio_scheduler);
+
+  switch(prop_id){
+  case PROP_WORKER_COUNT:
+    {
+      guint worker_count;
+
+      worker_count = g_value_get_uint(value);
+
+      g_rec_mutex_lock(audio_scheduler_mutex);
+
+      if((AGS_AUDIO_SCHEDULER_RUNNING & (audio_scheduler->flags)) == 0 &&
+	 worker_count > 0){
+	audio_scheduler->worker_count = worker_count;
+      }
+
+      g_rec_mutex_unlock(audio_scheduler_mutex);
+    }
+    break;
+  default:
+    G_OBJECT_WARN_INVALID_PROPERTY_ID(gobject, prop_id, param_spec);
+    break;
+  }
+}
+
+void
+ags_audio_scheduler_get_property(GObject *gobject,
+				 guint prop_id,
+				 GValue *value,
+				 GParamSpec *param_spec)
+{
+  AgsAudioScheduler *audio_scheduler;
+
+  GRecMutex *audio_scheduler_mutex;
+
+  audio_scheduler = AGS_AUDIO_SCHEDULER(gobject);
+
+  /* get audio scheduler mutex */
+  audio_scheduler_mutex = AGS_AUDIO_SCHEDULER_GET_OBJ_MUTEX(audio_scheduler);
+
+  switch(prop_id){
+  case PROP_WORKER_COUNT:
+    {
+      g_rec_mutex_lock(audio_scheduler_mutex);
+
+      g_value_set_uint(value, audio_scheduler->worker_count);
+
+      g_rec_mutex_unlock(audio_scheduler_mutex);
+    }
+    break;
+  default:
+    G_OBJECT_WARN_INVALID_PROPERTY_ID(gobject, prop_id, param_spec);
+    break;
+  }
+}
+
+void
+ags_audio_scheduler_finalize(GObject *gobject)
+{
+  AgsAudioScheduler *audio_scheduler;
+
+  audio_scheduler = AGS_AUDIO_SCHEDULER(gobject);
+
+  ags_audio_scheduler_stop(audio_scheduler);
+
+  ags_audio_scheduler_free_graph(audio_scheduler);
+
+  g_mutex_clear(&(audio_scheduler->wakeup_mutex));
+  g_cond_clear(&(audio_scheduler->wakeup_cond));
+
+  g_mutex_clear(&(audio_scheduler->done_mutex));
+  g_cond_clear(&(audio_scheduler->done_cond));
+
+  if(audio_scheduler == ags_audio_scheduler){
+    ags_audio_scheduler = NULL;
+  }
+
+  /* call parent */
+  G_OBJECT_CLASS(ags_audio_scheduler_parent_class)->finalize(gobject);
+}
+
+/**
+ * ags_audio_scheduler_test_flags:
+ * @audio_scheduler: the #AgsAudioScheduler
+ * @flags: the flags
+ *
+ * Test @flags to be set on @audio_scheduler.
+ *
+ * Returns: %TRUE if flags are set, else %FALSE
+ *
+ * Since: 3.7.0
+ */
+gboolean
+ags_audio_scheduler_test_flags(AgsAudioScheduler *audio_scheduler, guint flags)
+{
+  gboolean retval;
+
+  GRecMutex *audio_scheduler_mutex;
+
+  if(!AGS_IS_AUDIO_SCHEDULER(audio_scheduler)){
+    return(FALSE);
+  }
+
+  /* get audio scheduler mutex */
+  audio_scheduler_mutex = AGS_AUDIO_SCHEDULER_GET_OBJ_MUTEX(audio_scheduler);
+
+  /* test */
+  g_rec_mutex_lock(audio_scheduler_mutex);
+
+  retval = (flags & (audio_scheduler->flags)) ? TRUE: FALSE;
+
+  g_rec_mutex_unlock(audio_scheduler_mutex);
+
+  return(retval);
+}
+
+/**
+ * ags_audio_scheduler_set_flags:
+ * @audio_scheduler: the #AgsAudioScheduler
+ * @flags: see #AgsAudioSchedulerFlags-enum
+ *
+ * Enable a feature of @audio_scheduler.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_audio_scheduler_set_flags(AgsAudioScheduler *audio_scheduler, guint flags)
+{
+  GRecMutex *audio_scheduler_mutex;
+
+  if(!AGS_IS_AUDIO_SCHEDULER(audio_scheduler)){
+    return;
+  }
+
+  /* get audio scheduler mutex */
+  audio_scheduler_mutex = AGS_AUDIO_SCHEDULER_GET_OBJ_MUTEX(audio_scheduler);
+
+  /* set flags */
+  g_rec_mutex_lock(audio_scheduler_mutex);
+
+  audio_scheduler->flags |= flags;
+
+  g_rec_mutex_unlock(audio_scheduler_mutex);
+}
+
+/**
+ * ags_audio_scheduler_unset_flags:
+ * @audio_scheduler: the #AgsAudioScheduler
+ * @flags: see #AgsAudioSchedulerFlags-enum
+ *
+ * Disable a feature of @audio_scheduler.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_audio_scheduler_unset_flags(AgsAudioScheduler *audio_scheduler, guint flags)
+{
+  GRecMutex *audio_scheduler_mutex;
+
+  if(!AGS_IS_AUDIO_SCHEDULER(audio_scheduler)){
+    return;
+  }
+
+  /* get audio scheduler mutex */
+  audio_scheduler_mutex = AGS_AUDIO_SCHEDULER_GET_OBJ_MUTEX(audio_scheduler);
+
+  /* unset flags */
+  g_rec_mutex_lock(audio_scheduler_mutex);
+
+  audio_scheduler->flags &= (~flags);
+
+  g_rec_mutex_unlock(audio_scheduler_mutex);
+}
+
+/**
+ * ags_audio_scheduler_get_worker_count:
+ * @audio_scheduler: the #AgsAudioScheduler
+ *
+ * Get worker count of @audio_scheduler.
+ *
+ * Returns: the count of workers
+ *
+ * Since: 3.7.0
+ */
+guint
+ags_audio_scheduler_get_worker_count(AgsAudioScheduler *audio_scheduler)
+{
+  guint worker_count;
+
+  if(!AGS_IS_AUDIO_SCHEDULER(audio_scheduler)){
+    return(0);
+  }
+
+  g_object_get(audio_scheduler,
+	       "worker-count", &worker_count,
+	       NULL);
+
+  return(worker_count);
+}
+
+/**
+ * ags_audio_scheduler_topology_changed:
+ * @audio_scheduler: the #AgsAudioScheduler
+ *
+ * Notify @audio_scheduler about changed links, the dependency graph is
+ * derived again before the next tic.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_audio_scheduler_topology_changed(AgsAudioScheduler *audio_scheduler)
+{
+  if(!AGS_IS_AUDIO_SCHEDULER(audio_scheduler)){
+    return;
+  }
+
+  g_atomic_int_inc(&(audio_scheduler->topology_generation));
+}
+
+void
+ags_audio_scheduler_free_graph(AgsAudioScheduler *audio_scheduler)
+{
+  guint i;
+
+  for(i = 0; i < audio_scheduler->node_count; i++){
+    g_free(audio_scheduler->node[i]->successor);
+    
+    g_free(audio_scheduler->node[i]);
+  }
+
+  g_free(audio_scheduler->node);
+
+  audio_scheduler->node_count = 0;
+  audio_scheduler->node = NULL;
+
+  g_list_free_full(audio_scheduler->audio,
+		   (GDestroyNotify) g_object_unref);
+
+  audio_scheduler->audio = NULL;
+}
+
+void
+ags_audio_scheduler_find_upstream(GHashTable *upstream,
+				  GObject *audio)
+{
+  AgsChannel *input, *next_input;
+  AgsChannel *link;
+
+  GObject *link_audio;
+
+  input = NULL;
+  
+  g_object_get(audio,
+	       "input", &input,
+	       NULL);
+
+  while(input != NULL){
+    link = ags_channel_get_link(input);
+
+    if(link != NULL){
+      link_audio = NULL;
+      
+      g_object_get(link,
+		   "audio", &link_audio,
+		   NULL);
+
+      if(link_audio != NULL){
+	if(link_audio != audio &&
+	   !g_hash_table_contains(upstream, link_audio)){
+	  g_hash_table_add(upstream, link_audio);
+
+	  ags_audio_scheduler_find_upstream(upstream,
+					    link_audio);
+	}
+
+	g_object_unref(link_audio);
+      }
+      
+      g_object_unref(link);
+    }
+
+    /* iterate */
+    next_input = ags_channel_next(input);
+
+    g_object_unref(input);
+
+    input = next_input;
+  }
+}
+
+void
+ags_audio_scheduler_build_graph(AgsAudioScheduler *audio_scheduler,
+				GList *audio)
+{
+  AgsAudioSchedulerNode *node;
+  
+  GHashTable **upstream;
+
+  guint node_count;
+  guint i, j;
+
+  ags_audio_scheduler_free_graph(audio_scheduler);
+
+  node_count = g_list_length(audio);
+
+  audio_scheduler->audio = g_list_copy_deep(audio,
+					    (GCopyFunc) g_object_ref,
+					    NULL);
+
+  audio_scheduler->node_count = node_count;
+  audio_scheduler->node = (AgsAudioSchedulerNode **) g_malloc(node_count * sizeof(AgsAudioSchedulerNode *));
+
+  upstream = (GHashTable **) g_malloc(node_count * sizeof(GHashTable *));
+
+  for(i = 0; i < node_count; i++){
+    node = 
+      audio_scheduler->node[i] = (AgsAudioSchedulerNode *) g_malloc(sizeof(AgsAudioSchedulerNode));
+
+    node->audio = audio->data;
+
+    node->dependency_count = 0;
+    node->pending = 0;
+    
+    node->successor_count = 0;
+    node->successor = NULL;
+
+    upstream[i] = g_hash_table_new(g_direct_hash,
+				   g_direct_equal);
+
+    ags_audio_scheduler_find_upstream(upstream[i],
+				      node->audio);
+    
+    audio = audio->next;
+  }
+
+  /* an audio feeding an other one by link runs first */
+  for(i = 0; i < node_count; i++){
+    for(j = 0; j < node_count; j++){
+      if(i == j ||
+	 !g_hash_table_contains(upstream[j], audio_scheduler->node[i]->audio) ||
+	 g_hash_table_contains(upstream[i], audio_scheduler->node[j]->audio)){
+	continue;
+      }
+
+      node = audio_scheduler->node[i];
+      
+      node->successor = (AgsAudioSchedulerNode **) g_realloc(node->successor,
+							     (node->successor_count + 1) * sizeof(AgsAudioSchedulerNode *));
+      node->successor[node->successor_count] = audio_scheduler->node[j];
+      node->successor_count += 1;
+
+      audio_scheduler->node[j]->dependency_count += 1;
+    }
+  }
+
+  for(i = 0; i < node_count; i++){
+    g_hash_table_destroy(upstream[i]);
+  }
+  
+  g_free(upstream);
+
+  /* every deque might hold all nodes */
+  if(audio_scheduler->deque != NULL){
+    for(i = 0; i < audio_scheduler->worker_count; i++){
+      audio_scheduler->deque[i].length = node_count;
+      audio_scheduler->deque[i].buffer = (gpointer *) g_realloc(audio_scheduler->deque[i].buffer,
+								node_count * sizeof(gpointer));
+    }
+  }
+}
+
+gboolean
+ags_audio_scheduler_graph_matches(AgsAudioScheduler *audio_scheduler,
+				  GList *audio)
+{
+  GList *current;
+
+  if(audio_scheduler->graph_generation != g_atomic_int_get(&(audio_scheduler->topology_generation))){
+    return(FALSE);
+  }
+
+  current = audio_scheduler->audio;
+
+  while(current != NULL && audio != NULL){
+    if(current->data != audio->data){
+      return(FALSE);
+    }
+
+    current = current->next;
+    audio = audio->next;
+  }
+
+  return((current == NULL && audio == NULL) ? TRUE: FALSE);
+}
+
+/**
+ * ags_audio_scheduler_rebuild:
+ * @audio_scheduler: the #AgsAudioScheduler
+ * @audio: (element-type AgsAudio.Audio) (transfer none): the playing #AgsAudio
+ *
+ * Derive the dependency graph of @audio from the channel links. You don't need
+ * to call it yourself, ags_audio_scheduler_run() does as the topology changes.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_audio_scheduler_rebuild(AgsAudioScheduler *audio_scheduler,
+			    GList *audio)
+{
+  GRecMutex *audio_scheduler_mutex;
+
+  if(!AGS_IS_AUDIO_SCHEDULER(audio_scheduler)){
+    return;
+  }
+
+  /* get audio scheduler mutex */
+  audio_scheduler_mutex = AGS_AUDIO_SCHEDULER_GET_OBJ_MUTEX(audio_scheduler);
+
+  g_rec_mutex_lock(audio_scheduler_mutex);
+
+  audio_scheduler->graph_generation = g_atomic_int_get(&(audio_scheduler->topology_generation));
+  
+  ags_audio_scheduler_build_graph(audio_scheduler,
+				  audio);
+
+  g_rec_mutex_unlock(audio_scheduler_mutex);
+}
+
+void
+ags_audio_scheduler_deque_push(AgsAudioSchedulerDeque *deque,
+			       AgsAudioSchedulerNode *node)
+{
+  gint bottom;
+
+  bottom = g_atomic_int_get(&(deque->bottom));
+
+  g_atomic_pointer_set(&(deque->buffer[bottom % deque->length]),
+		       node);
+
+  g_atomic_int_set(&(deque->bottom),
+		   bottom + 1);
+}
+
+AgsAudioSchedulerNode*
+ags_audio_scheduler_deque_pop(AgsAudioSchedulerDeque *deque)
+{
+  AgsAudioSchedulerNode *node;
+
+  gint top, bottom;
+
+  bottom = g_atomic_int_get(&(deque->bottom)) - 1;
+
+  g_atomic_int_set(&(deque->bottom),
+		   bottom);
+
+  top = g_atomic_int_get(&(deque->top));
+
+  if(top > bottom){
+    /* empty */
+    g_atomic_int_set(&(deque->bottom),
+		     bottom + 1);
+
+    return(NULL);
+  }
+
+  node = g_atomic_pointer_get(&(deque->buffer[bottom % deque->length]));
+
+  if(top == bottom){
+    /* last one - race against thieves */
+    if(!g_atomic_int_compare_and_exchange(&(deque->top),
+					  top,
+					  top + 1)){
+      node = NULL;
+    }
+
+    g_atomic_int_set(&(deque->bottom),
+		     bottom + 1);
+  }
+
+  return(node);
+}
+
+AgsAudioSchedulerNode*
+ags_audio_scheduler_deque_steal(AgsAudioSchedulerDeque *deque)
+{
+  AgsAudioSchedulerNode *node;
+
+  gint top, bottom;
+
+  top = g_atomic_int_get(&(deque->top));
+  bottom = g_atomic_int_get(&(deque->bottom));
+
+  if(top >= bottom){
+    return(NULL);
+  }
+
+  node = g_atomic_pointer_get(&(deque->buffer[top % deque->length]));
+
+  if(!g_atomic_int_compare_and_exchange(&(deque->top),
+					top,
+					top + 1)){
+    return(NULL);
+  }
+
+  return(node);
+}
+
+void
+ags_audio_scheduler_run_node(AgsAudioScheduler *audio_scheduler,
+			     AgsAudioSchedulerNode *node)
+{
+  AgsExecutionPlan *execution_plan;
+  
+  gint sound_scope;
+  guint nth;
+
+  for(sound_scope = 0; sound_scope < AGS_SOUND_SCOPE_LAST; sound_scope++){
+    if(sound_scope == AGS_SOUND_SCOPE_PLAYBACK){
+      continue;
+    }
+
+    execution_plan = ags_audio_get_execution_plan((AgsAudio *) node->audio,
+						  sound_scope);
+
+    if(execution_plan == NULL){
+      continue;
+    }
+    
+    if(execution_plan->length > 0){
+      for(nth = 0; nth < audio_scheduler->staging_program_count; nth++){
+	if(ags_execution_plan_test_staging_flags(audio_scheduler->staging_program[nth])){
+	  ags_execution_plan_run(execution_plan,
+				 audio_scheduler->staging_program[nth]);
+	}else{
+	  ags_audio_recursive_run_stage((AgsAudio *) node->audio,
+					sound_scope, audio_scheduler->staging_program[nth]);
+	}
+      }
+    }
+    
+    ags_execution_plan_unref(execution_plan);
+  }
+}
+
+void
+ags_audio_scheduler_work(AgsAudioScheduler *audio_scheduler,
+			 guint nth_worker)
+{
+  AgsAudioSchedulerDeque *deque;
+  AgsAudioSchedulerNode *node;
+
+  guint worker_count;
+  guint i;
+  
+  deque = &(audio_scheduler->deque[nth_worker]);
+
+  worker_count = audio_scheduler->worker_count;
+  
+  while(g_atomic_int_get(&(audio_scheduler->remaining)) > 0){
+    node = ags_audio_scheduler_deque_pop(deque);
+
+    /* steal */
+    for(i = 1; node == NULL && i < worker_count; i++){
+      node = ags_audio_scheduler_deque_steal(&(audio_scheduler->deque[(nth_worker + i) % worker_count]));
+    }
+
+    if(node == NULL){
+      g_thread_yield();
+      
+      continue;
+    }
+
+    ags_audio_scheduler_run_node(audio_scheduler,
+				 node);
+
+    /* release successors before accounting, so remaining doesn't drop to 0 early */
+    for(i = 0; i < node->successor_count; i++){
+      if(g_atomic_int_dec_and_test(&(node->successor[i]->pending))){
+	ags_audio_scheduler_deque_push(deque,
+				       node->successor[i]);
+      }
+    }
+
+    g_atomic_int_add(&(audio_scheduler->remaining),
+		     -1);
+  }
+}
+
+void*
+ags_audio_scheduler_worker_run(void *ptr)
+{
+  AgsAudioScheduler *audio_scheduler;
+
+  guint nth_worker;
+  guint epoch;
+  
+  audio_scheduler = AGS_AUDIO_SCHEDULER(((gpointer *) ptr)[0]);
+  nth_worker = GPOINTER_TO_UINT(((gpointer *) ptr)[1]);
+  epoch = GPOINTER_TO_UINT(((gpointer *) ptr)[2]);
+
+  g_free(ptr);
+
+  /* CPU affinity */
+  ags_cpu_affinity_setup(AGS_CPU_AFFINITY_KEY_WORKER);
+
+  /* realtime sanitizer */
+  ags_rt_sanitizer_mark_rt_thread(TRUE);
+  
+#ifdef AGS_WITH_RT
+  {
+    AgsPriority *priority;
+    
+    struct sched_param param;
+
+    gchar *str;
+
+    priority = ags_priority_get_instance();
+    
+    /* Declare ourself as a real time task */
+    param.sched_priority = 45;
+
+    str = ags_priority_get_value(priority,
+				 AGS_PRIORITY_RT_THREAD,
+				 AGS_PRIORITY_KEY_AUDIO);
+
+    if(str != NULL){
+      param.sched_priority = (int) g_ascii_strtoull(str,
+						    NULL,
+						    10);
+    }
+      
+    if(str == NULL ||
+       ((!g_ascii_strncasecmp(str,
+			      "0",
+			      2)) != TRUE)){
+      if(sched_setscheduler(0, SCHED_FIFO, &param) == -1) {
+	perror("sched_setscheduler failed");
+      }
+    }
+    
+    g_free(str);
+  }
+#endif
+
+  for(;;){
+    /* wait for the next tic */
+    g_mutex_lock(&(audio_scheduler->wakeup_mutex));
+
+    while(epoch == audio_scheduler->epoch &&
+	  (AGS_AUDIO_SCHEDULER_RUNNING & (g_atomic_int_get(&(audio_scheduler->flags)))) != 0){
+      g_cond_wait(&(audio_scheduler->wakeup_cond),
+		  &(audio_scheduler->wakeup_mutex));
+    }
+
+    if(epoch == audio_scheduler->epoch){
+      g_mutex_unlock(&(audio_scheduler->wakeup_mutex));
+
+      break;
+    }
+
+    epoch = audio_scheduler->epoch;
+    
+    g_mutex_unlock(&(audio_scheduler->wakeup_mutex));
+
+    /* work */
+    ags_audio_scheduler_work(audio_scheduler,
+			     nth_worker);
+
+    /* done */
+    g_mutex_lock(&(audio_scheduler->done_mutex));
+
+    if(g_atomic_int_dec_and_test(&(audio_scheduler->active))){
+      g_cond_signal(&(audio_scheduler->done_cond));
+    }
+    
+    g_mutex_unlock(&(audio_scheduler->done_mutex));
+  }
+
+  g_thread_exit(NULL);
+
+  return(NULL);
+}
+
+/**
+ * ags_audio_scheduler_run:
+ * @audio_scheduler: the #AgsAudioScheduler
+ * @audio: (element-type AgsAudio.Audio) (transfer none): the playing #AgsAudio
+ * @staging_program: (array length=staging_program_count): the staging program
+ * @staging_program_count: the staging program count
+ *
+ * Run one tic of @audio. The calling thread participates as first worker and
+ * returns as all nodes are done and every worker is idle again.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_audio_scheduler_run(AgsAudioScheduler *audio_scheduler,
+			GList *audio,
+			guint *staging_program, guint staging_program_count)
+{
+  guint worker_count;
+  guint i, j;
+
+  GRecMutex *audio_scheduler_mutex;
+
+  if(!AGS_IS_AUDIO_SCHEDULER(audio_scheduler) ||
+     audio == NULL){
+    return;
+  }
+
+  ags_audio_scheduler_start(audio_scheduler);
+  
+  /* get audio scheduler mutex */
+  audio_scheduler_mutex = AGS_AUDIO_SCHEDULER_GET_OBJ_MUTEX(audio_scheduler);
+
+  /* prepare - all workers are idle */
+  g_rec_mutex_lock(audio_scheduler_mutex);
+
+  if(!ags_audio_scheduler_graph_matches(audio_scheduler,
+					audio)){
+    audio_scheduler->graph_generation = g_atomic_int_get(&(audio_scheduler->topology_generation));
+    
+    ags_audio_scheduler_build_graph(audio_scheduler,
+				    audio);
+  }
+
+  worker_count = audio_scheduler->worker_count;
+  
+  audio_scheduler->staging_program = staging_program;
+  audio_scheduler->staging_program_count = staging_program_count;
+
+  for(i = 0; i < worker_count; i++){
+    g_atomic_int_set(&(audio_scheduler->deque[i].top), 0);
+    g_atomic_int_set(&(audio_scheduler->deque[i].bottom), 0);
+  }
+
+  /* distribute the roots */
+  for(i = 0, j = 0; i < audio_scheduler->node_count; i++){
+    g_atomic_int_set(&(audio_scheduler->node[i]->pending),
+		     audio_scheduler->node[i]->dependency_count);
+
+    if(audio_scheduler->node[i]->dependency_count == 0){
+      ags_audio_scheduler_deque_push(&(audio_scheduler->deque[j % worker_count]),
+				     audio_scheduler->node[i]);
+      j++;
+    }
+  }
+
+  g_atomic_int_set(&(audio_scheduler->remaining),
+		   audio_scheduler->node_count);
+  g_atomic_int_set(&(audio_scheduler->active),
+		   worker_count - 1);
+
+  g_rec_mutex_unlock(audio_scheduler_mutex);
+
+  /* wakeup workers */
+  if(worker_count > 1){
+    g_mutex_lock(&(audio_scheduler->wakeup_mutex));
+
+    audio_scheduler->epoch += 1;
+    
+    g_cond_broadcast(&(audio_scheduler->wakeup_cond));
+
+    g_mutex_unlock(&(audio_scheduler->wakeup_mutex));
+  }
+
+  /* work as first worker */
+  ags_audio_scheduler_work(audio_scheduler,
+			   0);
+
+  /* wait until workers are idle */
+  g_mutex_lock(&(audio_scheduler->done_mutex));
+
+  while(g_atomic_int_get(&(audio_scheduler->active)) > 0){
+    g_cond_wait(&(audio_scheduler->done_cond),
+		&(audio_scheduler->done_mutex));
+  }
+  
+  g_mutex_unlock(&(audio_scheduler->done_mutex));
+
+  audio_scheduler->staging_program = NULL;
+  audio_scheduler->staging_program_count = 0;
+}
+
+/**
+ * ags_audio_scheduler_start:
+ * @audio_scheduler: the #AgsAudioScheduler
+ *
+ * Start the worker threads of @audio_scheduler, if not yet running.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_audio_scheduler_start(AgsAudioScheduler *audio_scheduler)
+{
+  guint epoch;
+  guint i;
+  
+  GRecMutex *audio_scheduler_mutex;
+
+  if(!AGS_IS_AUDIO_SCHEDULER(audio_scheduler)){
+    return;
+  }
+
+  /* get audio scheduler mutex */
+  audio_scheduler_mutex = AGS_AUDIO_SCHEDULER_GET_OBJ_MUTEX(audio_scheduler);
+
+  g_rec_mutex_lock(audio_scheduler_mutex);
+
+  if((AGS_AUDIO_SCHEDULER_RUNNING & (audio_scheduler->flags)) != 0){
+    g_rec_mutex_unlock(audio_scheduler_mutex);
+
+    return;
+  }
+
+  audio_scheduler->flags |= AGS_AUDIO_SCHEDULER_RUNNING;
+
+  /* deques - resized as the graph is built */
+  audio_scheduler->deque = (AgsAudioSchedulerDeque *) g_malloc(audio_scheduler->worker_count * sizeof(AgsAudioSchedulerDeque));
+
+  for(i = 0; i < audio_scheduler->worker_count; i++){
+    audio_scheduler->deque[i].top = 0;
+    audio_scheduler->deque[i].bottom = 0;
+      
+    audio_scheduler->deque[i].length = audio_scheduler->node_count;
+    audio_scheduler->deque[i].buffer = (gpointer *) g_malloc(audio_scheduler->node_count * sizeof(gpointer));
+  }
+  
+  /* the caller of ags_audio_scheduler_run() is the first worker */
+  audio_scheduler->worker = (GThread **) g_malloc(audio_scheduler->worker_count * sizeof(GThread *));
+
+  audio_scheduler->worker[0] = NULL;
+  
+  g_mutex_lock(&(audio_scheduler->wakeup_mutex));
+
+  epoch = audio_scheduler->epoch;
+
+  g_mutex_unlock(&(audio_scheduler->wakeup_mutex));
+
+  for(i = 1; i < audio_scheduler->worker_count; i++){
+    gpointer *data;
+
+    data = (gpointer *) g_malloc(3 * sizeof(gpointer));
+
+    data[0] = audio_scheduler;
+    data[1] = GUINT_TO_POINTER(i);
+    data[2] = GUINT_TO_POINTER(epoch);
+    
+    audio_scheduler->worker[i] = g_thread_new("Advanced Gtk+ Sequencer - audio scheduler",
+					      ags_audio_scheduler_worker_run,
+					      data);
+  }
+
+  g_rec_mutex_unlock(audio_scheduler_mutex);
+}
+
+/**
+ * ags_audio_scheduler_stop:
+ * @audio_scheduler: the #AgsAudioScheduler
+ *
+ * Stop the worker threads of @audio_scheduler and wait for them to exit.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_audio_scheduler_stop(AgsAudioScheduler *audio_scheduler)
+{
+  GThread **worker;
+
+  guint worker_count;
+  guint i;
+  
+  GRecMutex *audio_scheduler_mutex;
+
+  if(!AGS_IS_AUDIO_SCHEDULER(audio_scheduler)){
+    return;
+  }
+
+  /* get audio scheduler mutex */
+  audio_scheduler_mutex = AGS_AUDIO_SCHEDULER_GET_OBJ_MUTEX(audio_scheduler);
+
+  g_rec_mutex_lock(audio_scheduler_mutex);
+
+  worker = audio_scheduler->worker;
+  worker_count = audio_scheduler->worker_count;
+
+  audio_scheduler->flags &= (~AGS_AUDIO_SCHEDULER_RUNNING);
+  audio_scheduler->worker = NULL;
+
+  g_rec_mutex_unlock(audio_scheduler_mutex);
+
+  if(worker != NULL){
+    g_mutex_lock(&(audio_scheduler->wakeup_mutex));
+
+    g_cond_broadcast(&(audio_scheduler->wakeup_cond));
+
+    g_mutex_unlock(&(audio_scheduler->wakeup_mutex));
+
+    for(i = 1; i < worker_count; i++){
+      g_thread_join(worker[i]);
+    }
+
+    g_free(worker);
+  }
+
+  /* free deques */
+  g_rec_mutex_lock(audio_scheduler_mutex);
+
+  if(audio_scheduler->deque != NULL){
+    for(i = 0; i < worker_count; i++){
+      g_free(audio_scheduler->deque[i].buffer);
+    }
+
+    g_free(audio_scheduler->deque);
+
+    audio_scheduler->deque = NULL;
+  }
+
+  g_rec_mutex_unlock(audio_scheduler_mutex);
+}
+
+/**
+ * ags_audio_scheduler_get_instance:
+ *
+ * Get instance.
+ *
+ * Returns: (transfer none): the #AgsAudioScheduler
+ *
+ * Since: 3.7.0
+ */
+AgsAudioScheduler*
+ags_audio_scheduler_get_instance()
+{
+  static GMutex mutex;
+
+  g_mutex_lock(&mutex);
+
+  if(ags_audio_scheduler == NULL){
+    ags_audio_scheduler = ags_audio_scheduler_new();
+  }
+
+  g_mutex_unlock(&mutex);
+
+  return(ags_audio_scheduler);
+}
+
+/**
+ * ags_audio_scheduler_new:
+ *
+ * Create a new instance of #AgsAudioScheduler.
+ *
+ * Returns: the new #AgsAudioScheduler
+ *
+ * Since: 3.7.0
+ */
+AgsAudioScheduler*
+ags_audio_scheduler_new()
+{
+  AgsAudioScheduler *audio_scheduler;
+
+  audio_scheduler = (AgsAudioScheduler *) g_object_new(AGS_TYPE_AUDIO_SCHEDULER,
+						       NULL);
+
+  return(audio_scheduler);
+}
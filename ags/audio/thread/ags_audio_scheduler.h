@@ -0,0 +1,146 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __AGS_AUDIO_SCHEDULER_H__
+#define __AGS_AUDIO_SCHEDULER_H__
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <ags/libags.h>
+
+G_BEGIN_DECLS
+
+#define AGS_TYPE_AUDIO_SCHEDULER                (ags_audio_scheduler_get_type())
+#define AGS_AUDIO_SCHEDULER(obj)                (G_TYPE_CHECK_INSTANCE_CAST((obj), AGS_TYPE_AUDIO_SCHEDULER, AgsAudioScheduler))
+#define AGS_AUDIO_SCHEDULER_CLASS(class)        (G_TYPE_CHECK_CLASS_CAST((class), AGS_TYPE_AUDIO_SCHEDULER, AgsAudioSchedulerClass))
+#define AGS_IS_AUDIO_SCHEDULER(obj)             (G_TYPE_CHECK_INSTANCE_TYPE ((obj), AGS_TYPE_AUDIO_SCHEDULER))
+#define AGS_IS_AUDIO_SCHEDULER_CLASS(class)     (G_TYPE_CHECK_CLASS_TYPE ((class), AGS_TYPE_AUDIO_SCHEDULER))
+#define AGS_AUDIO_SCHEDULER_GET_CLASS(obj)      (G_TYPE_INSTANCE_GET_CLASS ((obj), AGS_TYPE_AUDIO_SCHEDULER, AgsAudioSchedulerClass))
+
+#define AGS_AUDIO_SCHEDULER_GET_OBJ_MUTEX(obj) (&(((AgsAudioScheduler *) obj)->obj_mutex))
+
+#define AGS_AUDIO_SCHEDULER_NODE(ptr) ((AgsAudioSchedulerNode *)(ptr))
+#define AGS_AUDIO_SCHEDULER_DEQUE(ptr) ((AgsAudioSchedulerDeque *)(ptr))
+
+typedef struct _AgsAudioScheduler AgsAudioScheduler;
+typedef struct _AgsAudioSchedulerClass AgsAudioSchedulerClass;
+typedef struct _AgsAudioSchedulerNode AgsAudioSchedulerNode;
+typedef struct _AgsAudioSchedulerDeque AgsAudioSchedulerDeque;
+
+/**
+ * AgsAudioSchedulerFlags:
+ * @AGS_AUDIO_SCHEDULER_RUNNING: the worker threads are running
+ *
+ * Enum values to control the behavior or indicate internal state of #AgsAudioScheduler by
+ * enable/disable as flags.
+ */
+typedef enum{
+  AGS_AUDIO_SCHEDULER_RUNNING      = 1,
+}AgsAudioSchedulerFlags;
+
+struct _AgsAudioSchedulerNode
+{
+  GObject *audio;
+
+  guint dependency_count;
+  volatile gint pending;
+
+  guint successor_count;
+  AgsAudioSchedulerNode **successor;
+};
+
+struct _AgsAudioSchedulerDeque
+{
+  volatile gint top;
+  volatile gint bottom;
+
+  guint length;
+  gpointer *buffer;
+};
+
+struct _AgsAudioScheduler
+{
+  GObject gobject;
+
+  guint flags;
+
+  GRecMutex obj_mutex;
+
+  guint worker_count;
+  GThread **worker;
+
+  AgsAudioSchedulerDeque *deque;
+
+  GMutex wakeup_mutex;
+  GCond wakeup_cond;
+
+  volatile guint epoch;
+
+  GMutex done_mutex;
+  GCond done_cond;
+
+  volatile gint active;
+
+  volatile guint topology_generation;
+  guint graph_generation;
+
+  GList *audio;
+
+  guint node_count;
+  AgsAudioSchedulerNode **node;
+
+  volatile gint remaining;
+
+  guint *staging_program;
+  guint staging_program_count;
+};
+
+struct _AgsAudioSchedulerClass
+{
+  GObjectClass gobject;
+};
+
+GType ags_audio_scheduler_get_type();
+
+gboolean ags_audio_scheduler_test_flags(AgsAudioScheduler *audio_scheduler, guint flags);
+void ags_audio_scheduler_set_flags(AgsAudioScheduler *audio_scheduler, guint flags);
+void ags_audio_scheduler_unset_flags(AgsAudioScheduler *audio_scheduler, guint flags);
+
+guint ags_audio_scheduler_get_worker_count(AgsAudioScheduler *audio_scheduler);
+
+void ags_audio_scheduler_topology_changed(AgsAudioScheduler *audio_scheduler);
+
+void ags_audio_scheduler_rebuild(AgsAudioScheduler *audio_scheduler,
+				 GList *audio);
+
+void ags_audio_scheduler_run(AgsAudioScheduler *audio_scheduler,
+			     GList *audio,
+			     guint *staging_program, guint staging_program_count);
+
+void ags_audio_scheduler_start(AgsAudioScheduler *audio_scheduler);
+void ags_audio_scheduler_stop(AgsAudioScheduler *audio_scheduler);
+
+AgsAudioScheduler* ags_audio_scheduler_get_instance();
+
+AgsAudioScheduler* ags_audio_scheduler_new();
+
+G_END_DECLS
+
+#endif /*__AGS_AUDIO_SCHEDULER_H__*/
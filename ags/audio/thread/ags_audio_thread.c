@@ -49,6 +49,13 @@ void ags_audio_thread_start(AgsThread *thread);
 void ags_audio_thread_run(AgsThread *thread);
 void ags_audio_thread_stop(AgsThread *thread);
 
+void ags_audio_thread_run_playback(AgsAudioThread *audio_thread,
+				   AgsEpochArray *playback_array,
+				   gint sound_scope,
+				   guint *staging_program, guint staging_program_count);
+void ags_audio_thread_sync_playback(AgsAudioThread *audio_thread,
+				    AgsEpochArray *playback_array);
+
 void ags_audio_thread_play_channel_super_threaded(AgsAudioThread *audio_thread, AgsPlayback *playback);
 void ags_audio_thread_sync_channel_super_threaded(AgsAudioThread *audio_thread, AgsPlayback *playback);
 
@@ -433,21 +440,29 @@ void
 ags_audio_thread_run(AgsThread *thread)
 {
   AgsAudio *audio;
-  AgsChannel *channel;
   AgsPlaybackDomain *playback_domain;
 
   AgsAudioLoop *audio_loop;
   AgsAudioThread *audio_thread;
 
-  GList *output_playback_start, *input_playback_start, *playback;
-  GList *recall_id;
+  AgsEpochArray *output_playback_array, *input_playback_array;
+
+  guint *staging_program;
   
   gint sound_scope;
+  guint staging_program_count;
+  guint epoch;
 
   GRecMutex *thread_mutex;
 
 //  g_message("do: audio %f", thread->tic_delay);
   
+  /* CPU affinity */
+  ags_cpu_affinity_setup(AGS_CPU_AFFINITY_KEY_AUDIO);
+
+  /* realtime sanitizer */
+  ags_rt_sanitizer_mark_rt_thread(TRUE);
+
   /* real-time setup */
 #ifdef AGS_WITH_RT
   if(!ags_thread_test_status_flags(thread, AGS_THREAD_STATUS_RT_SETUP)){
@@ -497,13 +512,18 @@ ags_audio_thread_run(AgsThread *thread)
 
   thread_mutex = AGS_THREAD_GET_OBJ_MUTEX(thread);
   
-  g_object_get(audio_thread,
-	       "audio", &audio,
-	       NULL);
+  /* the audio thread holds a reference to its audio and the audio to its playback domain */
+  audio = (AgsAudio *) g_atomic_pointer_get(&(audio_thread->audio));
 
-  g_object_get(audio,
-	       "playback-domain", &playback_domain,
-	        NULL);
+  if(audio == NULL){
+    return;
+  }
+  
+  playback_domain = (AgsPlaybackDomain *) g_atomic_pointer_get(&(audio->playback_domain));
+
+  if(playback_domain == NULL){
+    return;
+  }
   
   /* start - wait until signaled */
   g_rec_mutex_lock(thread_mutex);
@@ -539,211 +559,48 @@ ags_audio_thread_run(AgsThread *thread)
    */
 //  g_message("audio thread");
   
-  /* input */
   g_rec_mutex_lock(thread_mutex);
 
   sound_scope = audio_thread->sound_scope;
   
   g_rec_mutex_unlock(thread_mutex);
 
-  g_object_get(playback_domain,
-	       "input-playback", &input_playback_start,
-	       NULL);
-
-  playback = input_playback_start;
-  
-  while(playback != NULL){
-    if(ags_playback_test_flags(playback->data, AGS_PLAYBACK_SUPER_THREADED_CHANNEL)){
-      ags_audio_thread_play_channel_super_threaded(audio_thread, playback->data);
-    }else{
-      g_object_get(playback->data,
-		   "channel", &channel,
-		   NULL);
-
-      g_object_unref(channel);
-      
-      if(sound_scope >= 0){
-	if(sound_scope == AGS_SOUND_SCOPE_PLAYBACK ||
-	   ags_playback_get_recall_id((AgsPlayback *) playback, sound_scope) == NULL){
-	  playback = playback->next;
-	  
-	  continue;
-	}
-	
-	if((recall_id = ags_channel_check_scope(channel, sound_scope)) != NULL){
-	  guint *staging_program;
-	
-	  guint staging_program_count;
-	  guint nth;
+  /* staging program - fetched once per tic */
+  staging_program = ags_audio_thread_get_staging_program(audio_thread,
+							 &staging_program_count);
 
-	  staging_program = ags_audio_thread_get_staging_program(audio_thread,
-								 &staging_program_count);
-	
-	  for(nth = 0; nth < staging_program_count; nth++){
-	    ags_channel_recursive_run_stage(channel,
-					    sound_scope, staging_program[nth]);
-	  }
+  /* get playback - immutable as long as we didn't leave the epoch */
+  epoch = ags_epoch_reclaimer_enter(playback_domain->epoch_reclaimer);
 
-	  g_free(staging_program);
-	  
-	  g_list_free_full(recall_id,
-			   g_object_unref);
-	}
-      }else{
-	for(sound_scope = 0; sound_scope < AGS_SOUND_SCOPE_LAST; sound_scope++){
-	  if(sound_scope == AGS_SOUND_SCOPE_PLAYBACK ||
-	     ags_playback_get_recall_id((AgsPlayback *) playback, sound_scope) == NULL){
-	    continue;
-	  }
-	  
-	  if((recall_id = ags_channel_check_scope(channel, sound_scope)) != NULL){
-	    guint *staging_program;
-	
-	    guint staging_program_count;
-	    guint nth;
-
-	    staging_program = ags_audio_thread_get_staging_program(audio_thread,
-								   &staging_program_count);
-	
-	    for(nth = 0; nth < staging_program_count; nth++){
-	      ags_channel_recursive_run_stage(channel,
-					      sound_scope, staging_program[nth]);
-	    }
+  input_playback_array = g_atomic_pointer_get(&(playback_domain->input_playback_array));
+  output_playback_array = g_atomic_pointer_get(&(playback_domain->output_playback_array));
 
-	    g_free(staging_program);
-	  
-	    g_list_free_full(recall_id,
-			     g_object_unref);
-	  }
-	}
-      }
-    }
-    
-    playback = playback->next;
-  }
+  /* input */
+  ags_audio_thread_run_playback(audio_thread,
+				input_playback_array,
+				sound_scope,
+				staging_program, staging_program_count);
   
   /* output */
-  g_rec_mutex_lock(thread_mutex);
+  ags_audio_thread_run_playback(audio_thread,
+				output_playback_array,
+				sound_scope,
+				staging_program, staging_program_count);
 
-  sound_scope = audio_thread->sound_scope;
-  
-  g_rec_mutex_unlock(thread_mutex);
-
-  g_object_get(playback_domain,
-	       "output-playback", &output_playback_start,
-	       NULL);
-
-  playback = output_playback_start;
-  
-  while(playback != NULL){    
-    if(ags_playback_test_flags(playback->data, AGS_PLAYBACK_SUPER_THREADED_CHANNEL)){
-      ags_audio_thread_play_channel_super_threaded(audio_thread, playback->data);
-    }else{
-      channel = NULL;
-      
-      g_object_get(playback->data,
-		   "channel", &channel,
-		   NULL);
-      
-      if(sound_scope >= 0){
-	if(sound_scope == AGS_SOUND_SCOPE_PLAYBACK ||
-	   ags_playback_get_recall_id((AgsPlayback *) playback->data, sound_scope) == NULL){
-	  playback = playback->next;
-	}else{
-	  if((recall_id = ags_channel_check_scope(channel, sound_scope)) != NULL){
-	    guint *staging_program;
-	    
-	    guint staging_program_count;
-	    guint nth;
-	    
-	    staging_program = ags_audio_thread_get_staging_program(audio_thread,
-								   &staging_program_count);
-	    
-	    for(nth = 0; nth < staging_program_count; nth++){
-	      ags_channel_recursive_run_stage(channel,
-					      sound_scope, staging_program[nth]);
-	    }
-	    
-	    g_free(staging_program);
-	    
-	    g_list_free_full(recall_id,
-			     g_object_unref);
-	  }
-	}
-      }else{	
-	for(sound_scope = 0; sound_scope < AGS_SOUND_SCOPE_LAST; sound_scope++){
-	  if(sound_scope == AGS_SOUND_SCOPE_PLAYBACK ||
-	     ags_playback_get_recall_id((AgsPlayback *) playback->data, sound_scope) == NULL){
-	  }else{
-	    if((recall_id = ags_channel_check_scope(channel, sound_scope)) != NULL){
-	      guint *staging_program;
-	
-	      guint staging_program_count;
-	      guint nth;
-
-	      staging_program = ags_audio_thread_get_staging_program(audio_thread,
-								     &staging_program_count);
-	
-	      for(nth = 0; nth < staging_program_count; nth++){
-		ags_channel_recursive_run_stage(channel,
-						sound_scope, staging_program[nth]);
-	      }
-
-	      g_free(staging_program);
-	  
-	      g_list_free_full(recall_id,
-			       g_object_unref);
-	    }
-	  }
-	}
-      }
-
-      if(channel != NULL){
-	g_object_unref(channel);
-      }
-    }
-    
-    playback = playback->next;
-  }
+  g_free(staging_program);
   
   /* 
    * wait to be completed
    */
-  g_rec_mutex_lock(thread_mutex);
-
-  sound_scope = audio_thread->sound_scope;
-  
-  g_rec_mutex_unlock(thread_mutex);
-
   if(sound_scope != AGS_SOUND_SCOPE_PLAYBACK){
-    /* input */
-    playback = input_playback_start;
-
-    while(playback != NULL){
-      if(ags_playback_test_flags(playback->data, AGS_PLAYBACK_SUPER_THREADED_CHANNEL)){
-	ags_audio_thread_sync_channel_super_threaded(audio_thread, playback->data);
-      }
-    
-      playback = playback->next;
-    }
-  
-    /* output */
-    playback = output_playback_start;
-
-    while(playback != NULL){
-      if(ags_playback_test_flags(playback->data, AGS_PLAYBACK_SUPER_THREADED_CHANNEL)){
-	ags_audio_thread_sync_channel_super_threaded(audio_thread, playback->data);
-      }
-    
-      playback = playback->next;
-    }
+    ags_audio_thread_sync_playback(audio_thread,
+				   input_playback_array);
+    ags_audio_thread_sync_playback(audio_thread,
+				   output_playback_array);
   }
 
-  g_list_free_full(input_playback_start,
-		   g_object_unref);
-  
-  g_list_free_full(output_playback_start,
-		   g_object_unref);
+  ags_epoch_reclaimer_leave(playback_domain->epoch_reclaimer,
+			    epoch);
 
   g_list_free(audio_thread->sync_thread);
   audio_thread->sync_thread = NULL;
@@ -761,10 +618,85 @@ ags_audio_thread_run(AgsThread *thread)
     g_mutex_unlock(&(audio_thread->done_mutex));
   }
 
-  /* unref */
-  g_object_unref(audio);
+  /* free retired playback lists after being done, doesn't block */
+  ags_epoch_reclaimer_try_collect(playback_domain->epoch_reclaimer);
+}
+
+void
+ags_audio_thread_run_playback(AgsAudioThread *audio_thread,
+			      AgsEpochArray *playback_array,
+			      gint sound_scope,
+			      guint *staging_program, guint staging_program_count)
+{
+  AgsPlayback *playback;
+  AgsChannel *channel;
+
+  GList *recall_id;
+
+  gint current_sound_scope;
+  guint i;
+  guint nth;
 
-  g_object_unref(playback_domain);
+  if(playback_array == NULL){
+    return;
+  }
+  
+  for(i = 0; i < playback_array->length; i++){
+    playback = (AgsPlayback *) playback_array->data[i];
+
+    if(ags_playback_test_flags(playback, AGS_PLAYBACK_SUPER_THREADED_CHANNEL)){
+      ags_audio_thread_play_channel_super_threaded(audio_thread, playback);
+
+      continue;
+    }
+
+    /* the playback holds a reference to its channel */
+    channel = (AgsChannel *) g_atomic_pointer_get(&(playback->channel));
+
+    if(channel == NULL){
+      continue;
+    }
+    
+    for(current_sound_scope = ((sound_scope >= 0) ? sound_scope: 0); current_sound_scope < AGS_SOUND_SCOPE_LAST; current_sound_scope++){
+      if(current_sound_scope != AGS_SOUND_SCOPE_PLAYBACK &&
+	 ags_playback_get_recall_id(playback, current_sound_scope) != NULL &&
+	 (recall_id = ags_channel_check_scope(channel, current_sound_scope)) != NULL){
+	for(nth = 0; nth < staging_program_count; nth++){
+	  ags_channel_recursive_run_stage(channel,
+					  current_sound_scope, staging_program[nth]);
+	}
+	  
+	g_list_free_full(recall_id,
+			 g_object_unref);
+      }
+
+      /* a specific sound scope only */
+      if(sound_scope >= 0){
+	break;
+      }
+    }
+  }
+}
+
+void
+ags_audio_thread_sync_playback(AgsAudioThread *audio_thread,
+			       AgsEpochArray *playback_array)
+{
+  AgsPlayback *playback;
+
+  guint i;
+
+  if(playback_array == NULL){
+    return;
+  }
+  
+  for(i = 0; i < playback_array->length; i++){
+    playback = (AgsPlayback *) playback_array->data[i];
+
+    if(ags_playback_test_flags(playback, AGS_PLAYBACK_SUPER_THREADED_CHANNEL)){
+      ags_audio_thread_sync_channel_super_threaded(audio_thread, playback);
+    }
+  }
 }
 
 void
@@ -426,6 +426,12 @@ ags_channel_thread_run(AgsThread *thread)
 
   GRecMutex *thread_mutex;
 
+  /* CPU affinity */
+  ags_cpu_affinity_setup(AGS_CPU_AFFINITY_KEY_AUDIO);
+
+  /* realtime sanitizer */
+  ags_rt_sanitizer_mark_rt_thread(TRUE);
+
   /* real-time setup */
 #ifdef AGS_WITH_RT
   if(!ags_thread_test_status_flags(thread, AGS_THREAD_STATUS_RT_SETUP)){
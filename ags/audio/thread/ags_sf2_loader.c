@@ -43,7 +43,8 @@ void ags_sf2_loader_get_property(GObject *gobject,
 void ags_sf2_loader_dispose(GObject *gobject);
 void ags_sf2_loader_finalize(GObject *gobject);
 
-void* ags_sf2_loader_run(void *ptr);
+gpointer ags_sf2_loader_run(AgsFuture *future,
+			     gpointer data);
 
 /**
  * SECTION:ags_sf2_loader
@@ -206,7 +207,7 @@ ags_sf2_loader_init(AgsSF2Loader *sf2_loader)
   g_rec_mutex_init(&(sf2_loader->obj_mutex));
 
   /* fields */
-  sf2_loader->thread = NULL;
+  sf2_loader->future = NULL;
   
   sf2_loader->audio = NULL;
 
@@ -475,6 +476,10 @@ ags_sf2_loader_finalize(GObject *gobject)
     g_object_unref(sf2_loader->audio_container);
   }
   
+  if(sf2_loader->future != NULL){
+    ags_future_unref(sf2_loader->future);
+  }
+  
   /* call parent */
   G_OBJECT_CLASS(ags_sf2_loader_parent_class)->finalize(gobject);
 }
@@ -572,8 +577,9 @@ ags_sf2_loader_unset_flags(AgsSF2Loader *sf2_loader, guint flags)
   g_rec_mutex_unlock(sf2_loader_mutex);
 }
 
-void*
-ags_sf2_loader_run(void *ptr)
+gpointer
+ags_sf2_loader_run(AgsFuture *future,
+		   gpointer data)
 {
   AgsAudioContainerManager *audio_container_manager;
 
@@ -583,7 +589,7 @@ ags_sf2_loader_run(void *ptr)
   
   GRecMutex *audio_container_manager_mutex;
 
-  sf2_loader = AGS_SF2_LOADER(ptr);
+  sf2_loader = AGS_SF2_LOADER(data);
 
   output_soundcard = NULL;
   
@@ -673,8 +679,6 @@ ags_sf2_loader_run(void *ptr)
   ags_sf2_loader_set_flags(sf2_loader,
 			   AGS_SF2_LOADER_HAS_COMPLETED);
 
-  g_thread_exit(NULL);
-
   return(NULL);
 }
 
@@ -929,13 +933,20 @@ ags_sf2_loader_set_audio_container(AgsSF2Loader *sf2_loader,
 void
 ags_sf2_loader_start(AgsSF2Loader *sf2_loader)
 {
+  AgsJobPool *job_pool;
+
   if(!AGS_IS_SF2_LOADER(sf2_loader)){
     return;
   }
   
-  sf2_loader->thread = g_thread_new("Advanced Gtk+ Sequencer - SFZ loader",
-				    ags_sf2_loader_run,
-				    sf2_loader);
+  job_pool = ags_job_pool_get_instance();
+
+  g_object_ref(sf2_loader);
+  
+  sf2_loader->future = ags_job_pool_submit(job_pool,
+					   (AgsJobFunc) ags_sf2_loader_run,
+					   sf2_loader,
+					   (GDestroyNotify) g_object_unref);
 }
 
 
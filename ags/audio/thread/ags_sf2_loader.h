@@ -63,7 +63,7 @@ struct _AgsSF2Loader
 
   GRecMutex obj_mutex;
 
-  GThread *thread;
+  AgsFuture *future;
 
   AgsAudio *audio;
 
@@ -41,7 +41,8 @@ void ags_sfz_loader_get_property(GObject *gobject,
 void ags_sfz_loader_dispose(GObject *gobject);
 void ags_sfz_loader_finalize(GObject *gobject);
 
-void* ags_sfz_loader_run(void *ptr);
+gpointer ags_sfz_loader_run(AgsFuture *future,
+			     gpointer data);
 
 /**
  * SECTION:ags_sfz_loader
@@ -170,7 +171,7 @@ ags_sfz_loader_init(AgsSFZLoader *sfz_loader)
   g_rec_mutex_init(&(sfz_loader->obj_mutex)); 
 
   /* fields */
-  sfz_loader->thread = NULL;
+  sfz_loader->future = NULL;
   
   sfz_loader->audio = NULL;
 
@@ -371,6 +372,10 @@ ags_sfz_loader_finalize(GObject *gobject)
     g_object_unref(sfz_loader->audio_container);
   }
   
+  if(sfz_loader->future != NULL){
+    ags_future_unref(sfz_loader->future);
+  }
+  
   /* call parent */
   G_OBJECT_CLASS(ags_sfz_loader_parent_class)->finalize(gobject);
 }
@@ -468,8 +473,9 @@ ags_sfz_loader_unset_flags(AgsSFZLoader *sfz_loader, guint flags)
   g_rec_mutex_unlock(sfz_loader_mutex);
 }
 
-void*
-ags_sfz_loader_run(void *ptr)
+gpointer
+ags_sfz_loader_run(AgsFuture *future,
+		   gpointer data)
 {
   AgsAudioContainerManager *audio_container_manager;
 
@@ -479,7 +485,7 @@ ags_sfz_loader_run(void *ptr)
   
   GRecMutex *audio_container_manager_mutex;
 
-  sfz_loader = AGS_SFZ_LOADER(ptr);
+  sfz_loader = AGS_SFZ_LOADER(data);
   
   output_soundcard = NULL;  
 
@@ -570,8 +576,6 @@ ags_sfz_loader_run(void *ptr)
   ags_sfz_loader_set_flags(sfz_loader,
 			   AGS_SFZ_LOADER_HAS_COMPLETED);
   
-  g_thread_exit(NULL);
-
   return(NULL);
 }
 
@@ -730,13 +734,20 @@ ags_sfz_loader_set_audio_container(AgsSFZLoader *sfz_loader,
 void
 ags_sfz_loader_start(AgsSFZLoader *sfz_loader)
 {
+  AgsJobPool *job_pool;
+
   if(!AGS_IS_SFZ_LOADER(sfz_loader)){
     return;
   }
   
-  sfz_loader->thread = g_thread_new("Advanced Gtk+ Sequencer - SFZ loader",
-				    ags_sfz_loader_run,
-				    sfz_loader);
+  job_pool = ags_job_pool_get_instance();
+
+  g_object_ref(sfz_loader);
+  
+  sfz_loader->future = ags_job_pool_submit(job_pool,
+					   (AgsJobFunc) ags_sfz_loader_run,
+					   sfz_loader,
+					   (GDestroyNotify) g_object_unref);
 }
 
 /**
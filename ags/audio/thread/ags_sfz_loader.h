@@ -65,7 +65,7 @@ struct _AgsSFZLoader
 
   GRecMutex obj_mutex;
 
-  GThread *thread;
+  AgsFuture *future;
 
   AgsAudio *audio;
 
@@ -425,6 +425,12 @@ ags_soundcard_thread_run(AgsThread *thread)
 
   soundcard = soundcard_thread->soundcard;
 
+  /* CPU affinity */
+  ags_cpu_affinity_setup(AGS_CPU_AFFINITY_KEY_SOUNDCARD);
+
+  /* realtime sanitizer */
+  ags_rt_sanitizer_mark_rt_thread(TRUE);
+
   /* real-time setup */
 #ifdef AGS_WITH_RT
   if(!ags_thread_test_status_flags(thread, AGS_THREAD_STATUS_RT_SETUP)){
@@ -481,6 +487,12 @@ ags_soundcard_thread_run(AgsThread *thread)
 
 	g_error_free(error);
       }
+
+      /* period written - wakeup a main loop slaved to the device */
+      if(thread->parent != NULL &&
+	 ags_deadline_clock_test_flags(thread->parent->deadline_clock, AGS_DEADLINE_CLOCK_SLAVE)){
+	ags_deadline_clock_period_wakeup(thread->parent->deadline_clock);
+      }
     }
   }
 
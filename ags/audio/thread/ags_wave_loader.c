@@ -39,7 +39,8 @@ void ags_wave_loader_get_property(GObject *gobject,
 void ags_wave_loader_dispose(GObject *gobject);
 void ags_wave_loader_finalize(GObject *gobject);
 
-void* ags_wave_loader_run(void *ptr);
+gpointer ags_wave_loader_run(AgsFuture *future,
+			      gpointer data);
 
 /**
  * SECTION:ags_wave_loader
@@ -168,7 +169,7 @@ ags_wave_loader_init(AgsWaveLoader *wave_loader)
   g_rec_mutex_init(&(wave_loader->obj_mutex));
 
   /* fields */
-  wave_loader->thread = NULL;
+  wave_loader->future = NULL;
   
   wave_loader->audio = NULL;
 
@@ -366,6 +367,10 @@ ags_wave_loader_finalize(GObject *gobject)
     g_object_unref(wave_loader->audio_file);
   }
   
+  if(wave_loader->future != NULL){
+    ags_future_unref(wave_loader->future);
+  }
+  
   /* call parent */
   G_OBJECT_CLASS(ags_wave_loader_parent_class)->finalize(gobject);
 }
@@ -463,8 +468,9 @@ ags_wave_loader_unset_flags(AgsWaveLoader *wave_loader, guint flags)
   g_rec_mutex_unlock(wave_loader_mutex);
 }
 
-void*
-ags_wave_loader_run(void *ptr)
+gpointer
+ags_wave_loader_run(AgsFuture *future,
+		    gpointer data)
 {
   AgsWaveLoader *wave_loader;
 
@@ -475,7 +481,7 @@ ags_wave_loader_run(void *ptr)
   guint n_pads, current_pads;
   guint n_audio_channels, current_audio_channels;
 
-  wave_loader = AGS_WAVE_LOADER(ptr);
+  wave_loader = AGS_WAVE_LOADER(data);
 
   g_object_get(wave_loader->audio,
 	       "output-soundcard", &output_soundcard,
@@ -537,12 +543,19 @@ ags_wave_loader_run(void *ptr)
 			 1, 0);
     }
     
-    wave =
-      start_wave = ags_sound_resource_read_wave(AGS_SOUND_RESOURCE(wave_loader->audio_file->sound_resource),
-						output_soundcard,
-						-1,
-						0,
-						0.0, 0);
+    if(ags_wave_loader_test_flags(wave_loader, AGS_WAVE_LOADER_STREAM)){
+      /* keep the file on disk and prefetch during playback */
+      wave =
+	start_wave = ags_audio_file_read_wave_stream(wave_loader->audio_file,
+						     0);
+    }else{
+      wave =
+	start_wave = ags_sound_resource_read_wave(AGS_SOUND_RESOURCE(wave_loader->audio_file->sound_resource),
+						  output_soundcard,
+						  -1,
+						  0,
+						  0.0, 0);
+    }
 
     if(ags_wave_loader_test_flags(wave_loader, AGS_WAVE_LOADER_DO_REPLACE)){
       while(wave != NULL){
@@ -575,8 +588,6 @@ ags_wave_loader_run(void *ptr)
   ags_wave_loader_set_flags(wave_loader,
 			    AGS_WAVE_LOADER_HAS_COMPLETED);
   
-  g_thread_exit(NULL);
-
   return(NULL);
 }
 
@@ -735,13 +746,20 @@ ags_wave_loader_set_audio_file(AgsWaveLoader *wave_loader,
 void
 ags_wave_loader_start(AgsWaveLoader *wave_loader)
 {
+  AgsJobPool *job_pool;
+
   if(!AGS_IS_WAVE_LOADER(wave_loader)){
     return;
   }
   
-  wave_loader->thread = g_thread_new("Advanced Gtk+ Sequencer - SFZ loader",
-				     ags_wave_loader_run,
-				     wave_loader);
+  job_pool = ags_job_pool_get_instance();
+
+  g_object_ref(wave_loader);
+  
+  wave_loader->future = ags_job_pool_submit(job_pool,
+					    (AgsJobFunc) ags_wave_loader_run,
+					    wave_loader,
+					    (GDestroyNotify) g_object_unref);
 }
 
 /**
@@ -46,6 +46,7 @@ typedef struct _AgsWaveLoaderClass AgsWaveLoaderClass;
 typedef enum{
   AGS_WAVE_LOADER_DO_REPLACE      = 1,
   AGS_WAVE_LOADER_HAS_COMPLETED   = 1 <<  1,
+  AGS_WAVE_LOADER_STREAM          = 1 <<  2,
 }AgsWaveLoaderFlags;
 
 struct _AgsWaveLoader
@@ -56,7 +57,7 @@ struct _AgsWaveLoader
 
   GRecMutex obj_mutex;
 
-  GThread *thread;
+  AgsFuture *future;
 
   AgsAudio *audio;
 
@@ -0,0 +1,534 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ags/audio/thread/ags_wave_prefetcher.h>
+
+#include <ags/i18n.h>
+
+void ags_wave_prefetcher_class_init(AgsWavePrefetcherClass *wave_prefetcher);
+void ags_wave_prefetcher_init(AgsWavePrefetcher *wave_prefetcher);
+void ags_wave_prefetcher_finalize(GObject *gobject);
+
+void ags_wave_prefetcher_wave_stream_weak_notify(AgsWavePrefetcher *wave_prefetcher,
+						 GObject *wave_stream);
+
+void* ags_wave_prefetcher_run(void *ptr);
+
+/**
+ * SECTION:ags_wave_prefetcher
+ * @short_description: prefetch streamed wave
+ * @title: AgsWavePrefetcher
+ * @section_id:
+ * @include: ags/audio/thread/ags_wave_prefetcher.h
+ *
+ * The #AgsWavePrefetcher runs one thread reading ahead all added #AgsWaveStream,
+ * so the audio thread finds the upcoming buffers in memory. Streams are held by
+ * weak reference and drop out as soon as the owning #AgsWave is gone.
+ */
+
+static gpointer ags_wave_prefetcher_parent_class = NULL;
+
+static AgsWavePrefetcher *ags_wave_prefetcher = NULL;
+
+GType
+ags_wave_prefetcher_get_type()
+{
+  static volatile gsize g_define_type_id__volatile = 0;
+
+  if(g_once_init_enter (&g_define_type_id__volatile)){
+    GType ags_type_wave_prefetcher = 0;
+
+    static const GTypeInfo ags_wave_prefetcher_info = {
+      sizeof(AgsWavePrefetcherClass),
+      NULL, /* base_init */
+      NULL, /* base_finalize */
+      (GClassInitFunc) ags_wave_prefetcher_class_init,
+      NULL, /* class_finalize */
+      NULL, /* class_data */
+      sizeof(AgsWavePrefetcher),
+      0,    /* n_preallocs */
+      (GInstanceInitFunc) ags_wave_prefetcher_init,
+    };
+
+    ags_type_wave_prefetcher = g_type_register_static(G_TYPE_OBJECT,
+						      "AgsWavePrefetcher",
+						      &ags_wave_prefetcher_info,
+						      0);
+
+    g_once_init_leave(&g_define_type_id__volatile, ags_type_wave_prefetcher);
+  }
+
+  return g_define_type_id__volatile;
+}
+
+void
+ags_wave_prefetcher_class_init(AgsWavePrefetcherClass *wave_prefetcher)
+{
+  GObjectClass *gobject;
+
+  ags_wave_prefetcher_parent_class = g_type_class_peek_parent(wave_prefetcher);
+
+  /* GObjectClass */
+  gobject = (GObjectClass *) wave_prefetcher;
+
+  gobject->finalize = ags_wave_prefetcher_finalize;
+}
+
+void
+ags_wave_prefetcher_init(AgsWavePrefetcher *wave_prefetcher)
+{
+  wave_prefetcher->flags = 0;
+
+  g_rec_mutex_init(&(wave_prefetcher->obj_mutex));
+
+  wave_prefetcher->thread = NULL;
+
+  g_mutex_init(&(wave_prefetcher->wakeup_mutex));
+  g_cond_init(&(wave_prefetcher->wakeup_cond));
+
+  wave_prefetcher->wakeup = FALSE;
+
+  wave_prefetcher->wave_stream = NULL;
+}
+
+void
+ags_wave_prefetcher_finalize(GObject *gobject)
+{
+  AgsWavePrefetcher *wave_prefetcher;
+
+  GList *wave_stream;
+
+  wave_prefetcher = AGS_WAVE_PREFETCHER(gobject);
+
+  ags_wave_prefetcher_stop(wave_prefetcher);
+
+  wave_stream = wave_prefetcher->wave_stream;
+
+  while(wave_stream != NULL){
+    g_object_weak_unref(wave_stream->data,
+			(GWeakNotify) ags_wave_prefetcher_wave_stream_weak_notify,
+			wave_prefetcher);
+
+    wave_stream = wave_stream->next;
+  }
+
+  g_list_free(wave_prefetcher->wave_stream);
+
+  g_mutex_clear(&(wave_prefetcher->wakeup_mutex));
+  g_cond_clear(&(wave_prefetcher->wakeup_cond));
+
+  if(wave_prefetcher == ags_wave_prefetcher){
+    ags_wave_prefetcher = NULL;
+  }
+
+  /* call parent */
+  G_OBJECT_CLASS(ags_wave_prefetcher_parent_class)->finalize(gobject);
+}
+
+/**
+ * ags_wave_prefetcher_test_flags:
+ * @wave_prefetcher: the #AgsWavePrefetcher
+ * @flags: the flags
+ *
+ * Test @flags to be set on @wave_prefetcher.
+ *
+ * Returns: %TRUE if flags are set, else %FALSE
+ *
+ * Since: 3.7.0
+ */
+gboolean
+ags_wave_prefetcher_test_flags(AgsWavePrefetcher *wave_prefetcher, guint flags)
+{
+  gboolean retval;
+
+  GRecMutex *wave_prefetcher_mutex;
+
+  if(!AGS_IS_WAVE_PREFETCHER(wave_prefetcher)){
+    return(FALSE);
+  }
+
+  /* get wave prefetcher mutex */
+  wave_prefetcher_mutex = AGS_WAVE_PREFETCHER_GET_OBJ_MUTEX(wave_prefetcher);
+
+  /* test */
+  g_rec_mutex_lock(wave_prefetcher_mutex);
+
+  retval = (flags & (wave_prefetcher->flags)) ? TRUE: FALSE;
+
+  g_rec_mutex_unlock(wave_prefetcher_mutex);
+
+  return(retval);
+}
+
+/**
+ * ags_wave_prefetcher_set_flags:
+ * @wave_prefetcher: the #AgsWavePrefetcher
+ * @flags: see #AgsWavePrefetcherFlags-enum
+ *
+ * Enable a feature of @wave_prefetcher.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_wave_prefetcher_set_flags(AgsWavePrefetcher *wave_prefetcher, guint flags)
+{
+  GRecMutex *wave_prefetcher_mutex;
+
+  if(!AGS_IS_WAVE_PREFETCHER(wave_prefetcher)){
+    return;
+  }
+
+  /* get wave prefetcher mutex */
+  wave_prefetcher_mutex = AGS_WAVE_PREFETCHER_GET_OBJ_MUTEX(wave_prefetcher);
+
+  /* set flags */
+  g_rec_mutex_lock(wave_prefetcher_mutex);
+
+  wave_prefetcher->flags |= flags;
+
+  g_rec_mutex_unlock(wave_prefetcher_mutex);
+}
+
+/**
+ * ags_wave_prefetcher_unset_flags:
+ * @wave_prefetcher: the #AgsWavePrefetcher
+ * @flags: see #AgsWavePrefetcherFlags-enum
+ *
+ * Disable a feature of @wave_prefetcher.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_wave_prefetcher_unset_flags(AgsWavePrefetcher *wave_prefetcher, guint flags)
+{
+  GRecMutex *wave_prefetcher_mutex;
+
+  if(!AGS_IS_WAVE_PREFETCHER(wave_prefetcher)){
+    return;
+  }
+
+  /* get wave prefetcher mutex */
+  wave_prefetcher_mutex = AGS_WAVE_PREFETCHER_GET_OBJ_MUTEX(wave_prefetcher);
+
+  /* unset flags */
+  g_rec_mutex_lock(wave_prefetcher_mutex);
+
+  wave_prefetcher->flags &= (~flags);
+
+  g_rec_mutex_unlock(wave_prefetcher_mutex);
+}
+
+void
+ags_wave_prefetcher_wave_stream_weak_notify(AgsWavePrefetcher *wave_prefetcher,
+					    GObject *wave_stream)
+{
+  GRecMutex *wave_prefetcher_mutex;
+
+  /* get wave prefetcher mutex */
+  wave_prefetcher_mutex = AGS_WAVE_PREFETCHER_GET_OBJ_MUTEX(wave_prefetcher);
+
+  g_rec_mutex_lock(wave_prefetcher_mutex);
+
+  wave_prefetcher->wave_stream = g_list_remove(wave_prefetcher->wave_stream,
+					       wave_stream);
+
+  g_rec_mutex_unlock(wave_prefetcher_mutex);
+}
+
+/**
+ * ags_wave_prefetcher_add_wave_stream:
+ * @wave_prefetcher: the #AgsWavePrefetcher
+ * @wave_stream: the #AgsWaveStream
+ *
+ * Add @wave_stream to @wave_prefetcher and start prefetching it. The stream is
+ * not referenced and removed as it gets finalized.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_wave_prefetcher_add_wave_stream(AgsWavePrefetcher *wave_prefetcher,
+				    AgsWaveStream *wave_stream)
+{
+  GRecMutex *wave_prefetcher_mutex;
+
+  if(!AGS_IS_WAVE_PREFETCHER(wave_prefetcher) ||
+     !AGS_IS_WAVE_STREAM(wave_stream)){
+    return;
+  }
+
+  /* get wave prefetcher mutex */
+  wave_prefetcher_mutex = AGS_WAVE_PREFETCHER_GET_OBJ_MUTEX(wave_prefetcher);
+
+  g_rec_mutex_lock(wave_prefetcher_mutex);
+
+  if(g_list_find(wave_prefetcher->wave_stream, wave_stream) == NULL){
+    g_object_weak_ref((GObject *) wave_stream,
+		      (GWeakNotify) ags_wave_prefetcher_wave_stream_weak_notify,
+		      wave_prefetcher);
+
+    wave_prefetcher->wave_stream = g_list_prepend(wave_prefetcher->wave_stream,
+						  wave_stream);
+  }
+
+  g_rec_mutex_unlock(wave_prefetcher_mutex);
+
+  ags_wave_prefetcher_start(wave_prefetcher);
+  ags_wave_prefetcher_wakeup(wave_prefetcher);
+}
+
+/**
+ * ags_wave_prefetcher_remove_wave_stream:
+ * @wave_prefetcher: the #AgsWavePrefetcher
+ * @wave_stream: the #AgsWaveStream
+ *
+ * Remove @wave_stream from @wave_prefetcher.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_wave_prefetcher_remove_wave_stream(AgsWavePrefetcher *wave_prefetcher,
+				       AgsWaveStream *wave_stream)
+{
+  GRecMutex *wave_prefetcher_mutex;
+
+  if(!AGS_IS_WAVE_PREFETCHER(wave_prefetcher) ||
+     !AGS_IS_WAVE_STREAM(wave_stream)){
+    return;
+  }
+
+  /* get wave prefetcher mutex */
+  wave_prefetcher_mutex = AGS_WAVE_PREFETCHER_GET_OBJ_MUTEX(wave_prefetcher);
+
+  g_rec_mutex_lock(wave_prefetcher_mutex);
+
+  if(g_list_find(wave_prefetcher->wave_stream, wave_stream) != NULL){
+    g_object_weak_unref((GObject *) wave_stream,
+			(GWeakNotify) ags_wave_prefetcher_wave_stream_weak_notify,
+			wave_prefetcher);
+
+    wave_prefetcher->wave_stream = g_list_remove(wave_prefetcher->wave_stream,
+						 wave_stream);
+  }
+
+  g_rec_mutex_unlock(wave_prefetcher_mutex);
+}
+
+/**
+ * ags_wave_prefetcher_wakeup:
+ * @wave_prefetcher: the #AgsWavePrefetcher
+ *
+ * Wake up the prefetch thread, i.e. after a seek.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_wave_prefetcher_wakeup(AgsWavePrefetcher *wave_prefetcher)
+{
+  if(!AGS_IS_WAVE_PREFETCHER(wave_prefetcher)){
+    return;
+  }
+
+  g_mutex_lock(&(wave_prefetcher->wakeup_mutex));
+
+  wave_prefetcher->wakeup = TRUE;
+
+  g_cond_signal(&(wave_prefetcher->wakeup_cond));
+
+  g_mutex_unlock(&(wave_prefetcher->wakeup_mutex));
+}
+
+void*
+ags_wave_prefetcher_run(void *ptr)
+{
+  AgsWavePrefetcher *wave_prefetcher;
+
+  GList *start_wave_stream, *wave_stream;
+
+  guint count;
+
+  GRecMutex *wave_prefetcher_mutex;
+
+  wave_prefetcher = AGS_WAVE_PREFETCHER(ptr);
+
+  /* get wave prefetcher mutex */
+  wave_prefetcher_mutex = AGS_WAVE_PREFETCHER_GET_OBJ_MUTEX(wave_prefetcher);
+
+  while(ags_wave_prefetcher_test_flags(wave_prefetcher, AGS_WAVE_PREFETCHER_RUNNING)){
+    g_rec_mutex_lock(wave_prefetcher_mutex);
+
+    start_wave_stream = g_list_copy_deep(wave_prefetcher->wave_stream,
+					 (GCopyFunc) g_object_ref,
+					 NULL);
+
+    g_rec_mutex_unlock(wave_prefetcher_mutex);
+
+    /* fill rings */
+    count = 0;
+
+    wave_stream = start_wave_stream;
+
+    while(wave_stream != NULL){
+      count += ags_wave_stream_prefetch(wave_stream->data);
+
+      wave_stream = wave_stream->next;
+    }
+
+    g_list_free_full(start_wave_stream,
+		     (GDestroyNotify) g_object_unref);
+
+    /* wait for the cursor to move on */
+    if(count == 0){
+      g_mutex_lock(&(wave_prefetcher->wakeup_mutex));
+
+      if(!wave_prefetcher->wakeup){
+	g_cond_wait_until(&(wave_prefetcher->wakeup_cond),
+			  &(wave_prefetcher->wakeup_mutex),
+			  g_get_monotonic_time() + AGS_WAVE_PREFETCHER_DEFAULT_INTERVAL);
+      }
+
+      wave_prefetcher->wakeup = FALSE;
+
+      g_mutex_unlock(&(wave_prefetcher->wakeup_mutex));
+    }
+  }
+
+  g_thread_exit(NULL);
+
+  return(NULL);
+}
+
+/**
+ * ags_wave_prefetcher_start:
+ * @wave_prefetcher: the #AgsWavePrefetcher
+ *
+ * Start the prefetch thread of @wave_prefetcher, if not yet running.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_wave_prefetcher_start(AgsWavePrefetcher *wave_prefetcher)
+{
+  GRecMutex *wave_prefetcher_mutex;
+
+  if(!AGS_IS_WAVE_PREFETCHER(wave_prefetcher)){
+    return;
+  }
+
+  /* get wave prefetcher mutex */
+  wave_prefetcher_mutex = AGS_WAVE_PREFETCHER_GET_OBJ_MUTEX(wave_prefetcher);
+
+  g_rec_mutex_lock(wave_prefetcher_mutex);
+
+  if((AGS_WAVE_PREFETCHER_RUNNING & (wave_prefetcher->flags)) != 0){
+    g_rec_mutex_unlock(wave_prefetcher_mutex);
+
+    return;
+  }
+
+  wave_prefetcher->flags |= AGS_WAVE_PREFETCHER_RUNNING;
+
+  wave_prefetcher->thread = g_thread_new("Advanced Gtk+ Sequencer - wave prefetcher",
+					 ags_wave_prefetcher_run,
+					 wave_prefetcher);
+
+  g_rec_mutex_unlock(wave_prefetcher_mutex);
+}
+
+/**
+ * ags_wave_prefetcher_stop:
+ * @wave_prefetcher: the #AgsWavePrefetcher
+ *
+ * Stop the prefetch thread of @wave_prefetcher and wait for it to exit.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_wave_prefetcher_stop(AgsWavePrefetcher *wave_prefetcher)
+{
+  GThread *thread;
+
+  GRecMutex *wave_prefetcher_mutex;
+
+  if(!AGS_IS_WAVE_PREFETCHER(wave_prefetcher)){
+    return;
+  }
+
+  /* get wave prefetcher mutex */
+  wave_prefetcher_mutex = AGS_WAVE_PREFETCHER_GET_OBJ_MUTEX(wave_prefetcher);
+
+  g_rec_mutex_lock(wave_prefetcher_mutex);
+
+  thread = wave_prefetcher->thread;
+
+  wave_prefetcher->flags &= (~AGS_WAVE_PREFETCHER_RUNNING);
+  wave_prefetcher->thread = NULL;
+
+  g_rec_mutex_unlock(wave_prefetcher_mutex);
+
+  if(thread != NULL){
+    ags_wave_prefetcher_wakeup(wave_prefetcher);
+
+    g_thread_join(thread);
+  }
+}
+
+/**
+ * ags_wave_prefetcher_get_instance:
+ *
+ * Get instance.
+ *
+ * Returns: (transfer none): the #AgsWavePrefetcher
+ *
+ * Since: 3.7.0
+ */
+AgsWavePrefetcher*
+ags_wave_prefetcher_get_instance()
+{
+  static GMutex mutex;
+
+  g_mutex_lock(&mutex);
+
+  if(ags_wave_prefetcher == NULL){
+    ags_wave_prefetcher = ags_wave_prefetcher_new();
+  }
+
+  g_mutex_unlock(&mutex);
+
+  return(ags_wave_prefetcher);
+}
+
+/**
+ * ags_wave_prefetcher_new:
+ *
+ * Create a new instance of #AgsWavePrefetcher.
+ *
+ * Returns: the new #AgsWavePrefetcher
+ *
+ * Since: 3.7.0
+ */
+AgsWavePrefetcher*
+ags_wave_prefetcher_new()
+{
+  AgsWavePrefetcher *wave_prefetcher;
+
+  wave_prefetcher = (AgsWavePrefetcher *) g_object_new(AGS_TYPE_WAVE_PREFETCHER,
+						       NULL);
+
+  return(wave_prefetcher);
+}
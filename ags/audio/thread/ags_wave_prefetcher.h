@@ -0,0 +1,102 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __AGS_WAVE_PREFETCHER_H__
+#define __AGS_WAVE_PREFETCHER_H__
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <ags/libags.h>
+
+#include <ags/audio/ags_wave_stream.h>
+
+G_BEGIN_DECLS
+
+#define AGS_TYPE_WAVE_PREFETCHER                (ags_wave_prefetcher_get_type())
+#define AGS_WAVE_PREFETCHER(obj)                (G_TYPE_CHECK_INSTANCE_CAST((obj), AGS_TYPE_WAVE_PREFETCHER, AgsWavePrefetcher))
+#define AGS_WAVE_PREFETCHER_CLASS(class)        (G_TYPE_CHECK_CLASS_CAST((class), AGS_TYPE_WAVE_PREFETCHER, AgsWavePrefetcherClass))
+#define AGS_IS_WAVE_PREFETCHER(obj)             (G_TYPE_CHECK_INSTANCE_TYPE ((obj), AGS_TYPE_WAVE_PREFETCHER))
+#define AGS_IS_WAVE_PREFETCHER_CLASS(class)     (G_TYPE_CHECK_CLASS_TYPE ((class), AGS_TYPE_WAVE_PREFETCHER))
+#define AGS_WAVE_PREFETCHER_GET_CLASS(obj)      (G_TYPE_INSTANCE_GET_CLASS ((obj), AGS_TYPE_WAVE_PREFETCHER, AgsWavePrefetcherClass))
+
+#define AGS_WAVE_PREFETCHER_GET_OBJ_MUTEX(obj) (&(((AgsWavePrefetcher *) obj)->obj_mutex))
+
+#define AGS_WAVE_PREFETCHER_DEFAULT_INTERVAL (10 * G_TIME_SPAN_MILLISECOND)
+
+typedef struct _AgsWavePrefetcher AgsWavePrefetcher;
+typedef struct _AgsWavePrefetcherClass AgsWavePrefetcherClass;
+
+/**
+ * AgsWavePrefetcherFlags:
+ * @AGS_WAVE_PREFETCHER_RUNNING: the prefetch thread is running
+ *
+ * Enum values to control the behavior or indicate internal state of #AgsWavePrefetcher by
+ * enable/disable as flags.
+ */
+typedef enum{
+  AGS_WAVE_PREFETCHER_RUNNING      = 1,
+}AgsWavePrefetcherFlags;
+
+struct _AgsWavePrefetcher
+{
+  GObject gobject;
+
+  guint flags;
+
+  GRecMutex obj_mutex;
+
+  GThread *thread;
+
+  GMutex wakeup_mutex;
+  GCond wakeup_cond;
+
+  volatile gboolean wakeup;
+
+  GList *wave_stream;
+};
+
+struct _AgsWavePrefetcherClass
+{
+  GObjectClass gobject;
+};
+
+GType ags_wave_prefetcher_get_type();
+
+gboolean ags_wave_prefetcher_test_flags(AgsWavePrefetcher *wave_prefetcher, guint flags);
+void ags_wave_prefetcher_set_flags(AgsWavePrefetcher *wave_prefetcher, guint flags);
+void ags_wave_prefetcher_unset_flags(AgsWavePrefetcher *wave_prefetcher, guint flags);
+
+void ags_wave_prefetcher_add_wave_stream(AgsWavePrefetcher *wave_prefetcher,
+					 AgsWaveStream *wave_stream);
+void ags_wave_prefetcher_remove_wave_stream(AgsWavePrefetcher *wave_prefetcher,
+					    AgsWaveStream *wave_stream);
+
+void ags_wave_prefetcher_wakeup(AgsWavePrefetcher *wave_prefetcher);
+
+void ags_wave_prefetcher_start(AgsWavePrefetcher *wave_prefetcher);
+void ags_wave_prefetcher_stop(AgsWavePrefetcher *wave_prefetcher);
+
+AgsWavePrefetcher* ags_wave_prefetcher_get_instance();
+
+AgsWavePrefetcher* ags_wave_prefetcher_new();
+
+G_END_DECLS
+
+#endif /*__AGS_WAVE_PREFETCHER_H__*/
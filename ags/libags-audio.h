@@ -48,6 +48,7 @@
 #include <ags/audio/ags_acceleration.h>
 #include <ags/audio/ags_audio.h>
 #include <ags/audio/ags_audio_application_context.h>
+#include <ags/audio/ags_audio_buffer_kernel.h>
 #include <ags/audio/ags_audio_buffer_util.h>
 #include <ags/audio/ags_audio_signal.h>
 #include <ags/audio/ags_automation.h>
@@ -56,6 +57,7 @@
 #include <ags/audio/ags_devout.h>
 #include <ags/audio/ags_devin.h>
 #include <ags/audio/ags_diatonic_scale.h>
+#include <ags/audio/ags_execution_plan.h>
 #include <ags/audio/ags_fast_pitch_util.h>
 #include <ags/audio/ags_fifoout.h>
 #include <ags/audio/ags_filter_util.h>
@@ -67,6 +69,7 @@
 #include <ags/audio/ags_lfo_synth_util.h>
 #include <ags/audio/ags_midi.h>
 #include <ags/audio/ags_midiin.h>
+#include <ags/audio/ags_modulation_source.h>
 #include <ags/audio/ags_notation.h>
 #include <ags/audio/ags_note.h>
 #include <ags/audio/ags_output.h>
@@ -93,10 +96,13 @@
 #include <ags/audio/ags_recall_ladspa_run.h>
 #include <ags/audio/ags_recall_lv2.h>
 #include <ags/audio/ags_recall_lv2_run.h>
+#include <ags/audio/ags_recall_load_util.h>
 #include <ags/audio/ags_generic_recall_recycling.h>
 #include <ags/audio/ags_recall_recycling.h>
 #include <ags/audio/ags_recycling_context.h>
 #include <ags/audio/ags_recycling.h>
+#include <ags/audio/ags_resampler.h>
+#include <ags/audio/ags_sample_cache.h>
 #include <ags/audio/ags_sound_provider.h>
 #include <ags/audio/ags_sequencer_util.h>
 #include <ags/audio/ags_soundcard_util.h>
@@ -107,11 +113,14 @@
 #include <ags/audio/ags_sf2_synth_util.h>
 #include <ags/audio/ags_sfz_synth_generator.h>
 #include <ags/audio/ags_sfz_synth_util.h>
+#include <ags/audio/ags_timestamp_index.h>
 #include <ags/audio/ags_track.h>
 #include <ags/audio/ags_wave.h>
+#include <ags/audio/ags_wave_stream.h>
 
 /* audio thread */
 #include <ags/audio/thread/ags_audio_loop.h>
+#include <ags/audio/thread/ags_audio_scheduler.h>
 #include <ags/audio/thread/ags_audio_thread.h>
 #include <ags/audio/thread/ags_channel_thread.h>
 #include <ags/audio/thread/ags_sequencer_thread.h>
@@ -120,6 +129,7 @@
 #include <ags/audio/thread/ags_sf2_loader.h>
 #include <ags/audio/thread/ags_sfz_loader.h>
 #include <ags/audio/thread/ags_wave_loader.h>
+#include <ags/audio/thread/ags_wave_prefetcher.h>
 
 /* audio file */
 #include <ags/audio/file/ags_audio_container.h>
@@ -140,6 +150,7 @@
 #include <ags/audio/file/ags_sfz_region.h>
 #include <ags/audio/file/ags_sfz_sample.h>
 #include <ags/audio/file/ags_sndfile.h>
+#include <ags/audio/file/ags_mmap_file.h>
 #include <ags/audio/file/ags_sound_container.h>
 #include <ags/audio/file/ags_sound_resource.h>
 
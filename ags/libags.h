@@ -72,18 +72,25 @@
 
 /* thread */
 #include <ags/thread/ags_concurrency_provider.h>
+#include <ags/thread/ags_cpu_affinity.h>
+#include <ags/thread/ags_deadline_clock.h>
 #include <ags/thread/ags_destroy_worker.h>
+#include <ags/thread/ags_epoch_reclaimer.h>
+#include <ags/thread/ags_future.h>
 #include <ags/thread/ags_generic_main_loop.h>
+#include <ags/thread/ags_job_pool.h>
 #include <ags/thread/ags_message_delivery.h>
 #include <ags/thread/ags_message_envelope.h>
 #include <ags/thread/ags_message_queue.h>
 #include <ags/thread/ags_returnable_thread.h>
+#include <ags/thread/ags_rt_sanitizer.h>
 #include <ags/thread/ags_task_completion.h>
 #include <ags/thread/ags_task.h>
 #include <ags/thread/ags_task_launcher.h>
 #include <ags/thread/ags_thread_application_context.h>
 #include <ags/thread/ags_thread_pool.h>
 #include <ags/thread/ags_thread.h>
+#include <ags/thread/ags_tic_barrier.h>
 #include <ags/thread/ags_timestamp.h>
 #include <ags/thread/ags_worker_thread.h>
 
@@ -394,12 +394,14 @@ ags_config_real_load_defaults(AgsConfig *config)
   ags_config_set_value(config, AGS_CONFIG_GENERIC, "disable-feature", "experimental");
   ags_config_set_value(config, AGS_CONFIG_GENERIC, "engine-mode", "performance");
   ags_config_set_value(config, AGS_CONFIG_GENERIC, "gui-scale", "1.0");
+  ags_config_set_value(config, AGS_CONFIG_GENERIC, "stream-wave", "false");
 
   ags_config_set_value(config, AGS_CONFIG_THREAD, "model", "super-threaded");
   ags_config_set_value(config, AGS_CONFIG_THREAD, "super-threaded-scope", "audio");
   ags_config_set_value(config, AGS_CONFIG_THREAD, "lock-global", "ags-thread");
   ags_config_set_value(config, AGS_CONFIG_THREAD, "lock-parent", "ags-recycling-thread");
   ags_config_set_value(config, AGS_CONFIG_THREAD, "max-precision", "250");
+  ags_config_set_value(config, AGS_CONFIG_THREAD, "clock-source", "relative");
 
 #if defined(AGS_WITH_WASAPI)
   ags_config_set_value(config, AGS_CONFIG_SOUNDCARD_0, "backend", "wasapi");
@@ -0,0 +1,261 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <CUnit/CUnit.h>
+#include <CUnit/Automated.h>
+#include <CUnit/Basic.h>
+
+#include <ags/libags.h>
+#include <ags/libags-audio.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+int ags_audio_buffer_kernel_test_init_suite();
+int ags_audio_buffer_kernel_test_clean_suite();
+
+void ags_audio_buffer_kernel_test_test_stride();
+void ags_audio_buffer_kernel_test_set_isa();
+void ags_audio_buffer_kernel_test_copy_s8_to_s8();
+void ags_audio_buffer_kernel_test_copy_s16_to_s16();
+void ags_audio_buffer_kernel_test_copy_s32_to_s32();
+void ags_audio_buffer_kernel_test_copy_s64_to_s64();
+void ags_audio_buffer_kernel_test_copy_float_to_float();
+void ags_audio_buffer_kernel_test_copy_double_to_double();
+
+#define AGS_AUDIO_BUFFER_KERNEL_TEST_FRAME_COUNT (1027)
+#define AGS_AUDIO_BUFFER_KERNEL_TEST_MAX_CHANNELS (8)
+
+guint ags_audio_buffer_kernel_test_layout[][2] = {
+  {1, 1},
+  {1, 2},
+  {1, 4},
+  {1, 8},
+  {2, 1},
+  {2, 2},
+  {4, 1},
+  {4, 4},
+  {8, 1},
+  {8, 2},
+  {8, 8},
+};
+
+#define AGS_AUDIO_BUFFER_KERNEL_TEST_LAYOUT_COUNT (sizeof(ags_audio_buffer_kernel_test_layout) / (2 * sizeof(guint)))
+
+/* The suite initialization function.
+ * Opens the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_audio_buffer_kernel_test_init_suite()
+{
+  return(0);
+}
+
+/* The suite cleanup function.
+ * Closes the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_audio_buffer_kernel_test_clean_suite()
+{
+  ags_audio_buffer_kernel_set_isa(ags_audio_buffer_kernel_get_supported_isa());
+
+  return(0);
+}
+
+void
+ags_audio_buffer_kernel_test_test_stride()
+{
+  CU_ASSERT(ags_audio_buffer_kernel_test_stride(1, 1) == TRUE);
+  CU_ASSERT(ags_audio_buffer_kernel_test_stride(1, 2) == TRUE);
+  CU_ASSERT(ags_audio_buffer_kernel_test_stride(1, 8) == TRUE);
+
+  /* interleaved destination */
+  CU_ASSERT(ags_audio_buffer_kernel_test_stride(2, 2) == TRUE);
+  CU_ASSERT(ags_audio_buffer_kernel_test_stride(2, 1) == TRUE);
+  CU_ASSERT(ags_audio_buffer_kernel_test_stride(8, 1) == TRUE);
+
+  CU_ASSERT(ags_audio_buffer_kernel_test_stride(1, 3) == FALSE);
+  CU_ASSERT(ags_audio_buffer_kernel_test_stride(3, 1) == FALSE);
+  CU_ASSERT(ags_audio_buffer_kernel_test_stride(16, 16) == FALSE);
+}
+
+void
+ags_audio_buffer_kernel_test_set_isa()
+{
+  guint supported_isa;
+
+  supported_isa = ags_audio_buffer_kernel_get_supported_isa();
+
+  ags_audio_buffer_kernel_set_isa(AGS_AUDIO_BUFFER_KERNEL_ISA_AVX512);
+  CU_ASSERT(ags_audio_buffer_kernel_get_isa() == supported_isa);
+
+  ags_audio_buffer_kernel_set_isa(AGS_AUDIO_BUFFER_KERNEL_ISA_NONE);
+  CU_ASSERT(ags_audio_buffer_kernel_get_isa() == AGS_AUDIO_BUFFER_KERNEL_ISA_NONE);
+
+  /* no kernel, caller falls back */
+  CU_ASSERT(ags_audio_buffer_kernel_copy_float_to_float(NULL, 1,
+							NULL, 1,
+							0) == FALSE);
+
+  ags_audio_buffer_kernel_set_isa(supported_isa);
+}
+
+#define AGS_AUDIO_BUFFER_KERNEL_TEST_COPY(data_type, suffix) {		\
+    data_type *destination, *expected, *source;				\
+									\
+    guint isa, supported_isa;						\
+    guint dchannels, schannels;						\
+    guint buffer_length;						\
+    guint i, j;								\
+    gboolean success;							\
+									\
+    buffer_length = AGS_AUDIO_BUFFER_KERNEL_TEST_MAX_CHANNELS * AGS_AUDIO_BUFFER_KERNEL_TEST_FRAME_COUNT; \
+									\
+    destination = (data_type *) malloc(buffer_length * sizeof(data_type)); \
+    expected = (data_type *) malloc(buffer_length * sizeof(data_type)); \
+    source = (data_type *) malloc(buffer_length * sizeof(data_type));	\
+									\
+    supported_isa = ags_audio_buffer_kernel_get_supported_isa();	\
+									\
+    success = TRUE;							\
+									\
+    for(isa = AGS_AUDIO_BUFFER_KERNEL_ISA_SSE2; isa <= supported_isa; isa++){ \
+      ags_audio_buffer_kernel_set_isa(isa);				\
+									\
+      for(i = 0; i < AGS_AUDIO_BUFFER_KERNEL_TEST_LAYOUT_COUNT; i++){	\
+	dchannels = ags_audio_buffer_kernel_test_layout[i][0];		\
+	schannels = ags_audio_buffer_kernel_test_layout[i][1];		\
+									\
+	for(j = 0; j < buffer_length; j++){				\
+	  destination[j] = (data_type) ((gint) (j % 1000) - 500);	\
+	  expected[j] = destination[j];					\
+	  source[j] = (data_type) ((gint) ((j * 7) % 1000) - 500);	\
+	}								\
+									\
+	/* last channel of interleaved buffer */			\
+	if(!ags_audio_buffer_kernel_copy_##suffix(destination + (dchannels - 1), dchannels, \
+						  source + (schannels - 1), schannels, \
+						  AGS_AUDIO_BUFFER_KERNEL_TEST_FRAME_COUNT)){ \
+	  continue;							\
+	}								\
+									\
+	for(j = 0; j < AGS_AUDIO_BUFFER_KERNEL_TEST_FRAME_COUNT; j++){	\
+	  expected[(dchannels - 1) + j * dchannels] = (data_type) (expected[(dchannels - 1) + j * dchannels] + source[(schannels - 1) + j * schannels]); \
+	}								\
+									\
+	if(memcmp(destination, expected, buffer_length * sizeof(data_type)) != 0){ \
+	  success = FALSE;						\
+	}								\
+      }									\
+    }									\
+									\
+    ags_audio_buffer_kernel_set_isa(supported_isa);			\
+									\
+    free(destination);							\
+    free(expected);							\
+    free(source);							\
+									\
+    CU_ASSERT(success == TRUE);						\
+  }
+
+void
+ags_audio_buffer_kernel_test_copy_s8_to_s8()
+{
+  AGS_AUDIO_BUFFER_KERNEL_TEST_COPY(gint8, s8_to_s8);
+}
+
+void
+ags_audio_buffer_kernel_test_copy_s16_to_s16()
+{
+  AGS_AUDIO_BUFFER_KERNEL_TEST_COPY(gint16, s16_to_s16);
+}
+
+void
+ags_audio_buffer_kernel_test_copy_s32_to_s32()
+{
+  AGS_AUDIO_BUFFER_KERNEL_TEST_COPY(gint32, s32_to_s32);
+}
+
+void
+ags_audio_buffer_kernel_test_copy_s64_to_s64()
+{
+  AGS_AUDIO_BUFFER_KERNEL_TEST_COPY(gint64, s64_to_s64);
+}
+
+void
+ags_audio_buffer_kernel_test_copy_float_to_float()
+{
+  AGS_AUDIO_BUFFER_KERNEL_TEST_COPY(gfloat, float_to_float);
+}
+
+void
+ags_audio_buffer_kernel_test_copy_double_to_double()
+{
+  AGS_AUDIO_BUFFER_KERNEL_TEST_COPY(gdouble, double_to_double);
+}
+
+int
+main(int argc, char **argv)
+{
+  CU_pSuite pSuite = NULL;
+
+  putenv("LC_ALL=C");
+  putenv("LANG=C");
+
+  /* initialize the CUnit test registry */
+  if(CUE_SUCCESS != CU_initialize_registry()){
+    return CU_get_error();
+  }
+
+  /* add a suite to the registry */
+  pSuite = CU_add_suite("AgsAudioBufferKernelTest", ags_audio_buffer_kernel_test_init_suite, ags_audio_buffer_kernel_test_clean_suite);
+
+  if(pSuite == NULL){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* add the tests to the suite */
+  if((CU_add_test(pSuite, "test of ags_audio_buffer_kernel.c test stride", ags_audio_buffer_kernel_test_test_stride) == NULL) ||
+     (CU_add_test(pSuite, "test of ags_audio_buffer_kernel.c set isa", ags_audio_buffer_kernel_test_set_isa) == NULL) ||
+     (CU_add_test(pSuite, "test of ags_audio_buffer_kernel.c copy s8 to s8", ags_audio_buffer_kernel_test_copy_s8_to_s8) == NULL) ||
+     (CU_add_test(pSuite, "test of ags_audio_buffer_kernel.c copy s16 to s16", ags_audio_buffer_kernel_test_copy_s16_to_s16) == NULL) ||
+     (CU_add_test(pSuite, "test of ags_audio_buffer_kernel.c copy s32 to s32", ags_audio_buffer_kernel_test_copy_s32_to_s32) == NULL) ||
+     (CU_add_test(pSuite, "test of ags_audio_buffer_kernel.c copy s64 to s64", ags_audio_buffer_kernel_test_copy_s64_to_s64) == NULL) ||
+     (CU_add_test(pSuite, "test of ags_audio_buffer_kernel.c copy float to float", ags_audio_buffer_kernel_test_copy_float_to_float) == NULL) ||
+     (CU_add_test(pSuite, "test of ags_audio_buffer_kernel.c copy double to double", ags_audio_buffer_kernel_test_copy_double_to_double) == NULL)){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* Run all tests using the CUnit Basic interface */
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+  CU_basic_run_tests();
+
+  CU_cleanup_registry();
+
+  return(CU_get_error());
+}
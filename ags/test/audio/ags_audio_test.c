@@ -49,6 +49,7 @@ void ags_audio_test_add_notation();
 void ags_audio_test_remove_notation();
 void ags_audio_test_add_automation();
 void ags_audio_test_remove_automation();
+void ags_audio_test_find_notation();
 void ags_audio_test_add_recall_id();
 void ags_audio_test_remove_recall_id();
 void ags_audio_test_add_recycling_context();
@@ -681,6 +682,59 @@ ags_audio_test_remove_automation()
   //TODO:JK: implement me
 }
 
+void
+ags_audio_test_find_notation()
+{
+  AgsAudio *audio;
+  AgsNotation *notation;
+
+  GObject *current;
+  
+  /* instantiate audio */
+  audio = ags_audio_new(devout);
+
+  notation = ags_notation_new((GObject *) audio,
+			      0);
+  notation->timestamp->timer.ags_offset.offset = AGS_NOTATION_DEFAULT_OFFSET;
+
+  /* indexed by add */
+  ags_audio_add_notation(audio,
+			 (GObject *) notation);
+
+  current = ags_audio_find_notation(audio,
+				    0,
+				    AGS_NOTATION_DEFAULT_OFFSET);
+  CU_ASSERT(current == (GObject *) notation);
+
+  g_object_unref(current);
+
+  CU_ASSERT(ags_audio_find_notation(audio,
+				    0,
+				    0) == NULL);
+
+  /* counted but not indexed, rebuilt on the miss */
+  notation = ags_notation_new((GObject *) audio,
+			      0);
+  notation->timestamp->timer.ags_offset.offset = 0;
+
+  ags_audio_add_notation(audio,
+			 (GObject *) notation);
+
+  ags_timestamp_index_clear(audio->notation_index);
+
+  CU_ASSERT(audio->notation_count == 2);
+
+  current = ags_audio_find_notation(audio,
+				    0,
+				    0);
+  CU_ASSERT(current == (GObject *) notation);
+
+  g_object_unref(current);
+  
+  g_object_run_dispose((GObject *) audio);
+  g_object_unref(audio);
+}
+
 void
 ags_audio_test_add_recall_id()
 {
@@ -1644,6 +1698,7 @@ main(int argc, char **argv)
      (CU_add_test(pSuite, "test of AgsAudio link channel", ags_audio_test_link_channel) == NULL) ||
      (CU_add_test(pSuite, "test of AgsAudio finalize linked channel", ags_audio_test_finalize_linked_channel) == NULL) ||
      (CU_add_test(pSuite, "test of AgsAudio add recall", ags_audio_test_add_recall) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsAudio find notation", ags_audio_test_find_notation) == NULL) ||
      (CU_add_test(pSuite, "test of AgsAudio add recall container", ags_audio_test_add_recall_container) == NULL) ||
      (CU_add_test(pSuite, "test of AgsAudio recall id", ags_audio_test_add_recall_id) == NULL) ||
      (CU_add_test(pSuite, "test of AgsAudio recycling context", ags_audio_test_add_recycling_context) == NULL) ||
@@ -0,0 +1,226 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <CUnit/CUnit.h>
+#include <CUnit/Automated.h>
+#include <CUnit/Basic.h>
+
+#include <ags/libags.h>
+#include <ags/libags-audio.h>
+
+#include <stdlib.h>
+
+int ags_execution_plan_test_init_suite();
+int ags_execution_plan_test_clean_suite();
+
+void ags_execution_plan_test_alloc();
+void ags_execution_plan_test_invalidate();
+void ags_execution_plan_test_test_staging_flags();
+void ags_execution_plan_test_audio_get_execution_plan();
+
+#define AGS_EXECUTION_PLAN_TEST_AUDIO_CHANNELS (2)
+#define AGS_EXECUTION_PLAN_TEST_OUTPUT_PADS (1)
+#define AGS_EXECUTION_PLAN_TEST_INPUT_PADS (8)
+
+AgsDevout *devout;
+
+/* The suite initialization function.
+ * Opens the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_execution_plan_test_init_suite()
+{
+  devout = ags_devout_new(NULL);
+  g_object_ref(devout);
+
+  return(0);
+}
+
+/* The suite cleanup function.
+ * Closes the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_execution_plan_test_clean_suite()
+{
+  g_object_unref(devout);
+
+  return(0);
+}
+
+void
+ags_execution_plan_test_alloc()
+{
+  AgsExecutionPlan *execution_plan;
+
+  execution_plan = ags_execution_plan_alloc(AGS_SOUND_SCOPE_SEQUENCER);
+
+  CU_ASSERT(execution_plan != NULL);
+  CU_ASSERT(execution_plan->ref_count == 1);
+  CU_ASSERT(execution_plan->sound_scope == AGS_SOUND_SCOPE_SEQUENCER);
+  CU_ASSERT(execution_plan->length == 0);
+  CU_ASSERT(execution_plan->entry == NULL);
+
+  CU_ASSERT(ags_execution_plan_ref(execution_plan) == execution_plan);
+  CU_ASSERT(execution_plan->ref_count == 2);
+
+  ags_execution_plan_unref(execution_plan);
+  CU_ASSERT(execution_plan->ref_count == 1);
+
+  ags_execution_plan_unref(execution_plan);
+}
+
+void
+ags_execution_plan_test_invalidate()
+{
+  AgsExecutionPlan *execution_plan;
+
+  guint generation;
+  
+  execution_plan = ags_execution_plan_alloc(AGS_SOUND_SCOPE_NOTATION);
+
+  CU_ASSERT(ags_execution_plan_is_valid(execution_plan) == TRUE);
+
+  generation = ags_execution_plan_get_generation();
+  
+  ags_execution_plan_invalidate();
+
+  CU_ASSERT(ags_execution_plan_get_generation() == generation + 1);
+  CU_ASSERT(ags_execution_plan_is_valid(execution_plan) == FALSE);
+  CU_ASSERT(ags_execution_plan_is_valid(NULL) == FALSE);
+
+  ags_execution_plan_unref(execution_plan);
+}
+
+void
+ags_execution_plan_test_test_staging_flags()
+{
+  CU_ASSERT(ags_execution_plan_test_staging_flags(AGS_SOUND_STAGING_FEED_INPUT_QUEUE |
+						  AGS_SOUND_STAGING_AUTOMATE |
+						  AGS_SOUND_STAGING_RUN_PRE) == TRUE);
+  CU_ASSERT(ags_execution_plan_test_staging_flags(AGS_SOUND_STAGING_RUN_INTER) == TRUE);
+  CU_ASSERT(ags_execution_plan_test_staging_flags(AGS_SOUND_STAGING_RUN_POST) == TRUE);
+
+  CU_ASSERT(ags_execution_plan_test_staging_flags(AGS_SOUND_STAGING_RUN_INIT_PRE) == FALSE);
+  CU_ASSERT(ags_execution_plan_test_staging_flags(AGS_SOUND_STAGING_RUN_INTER |
+						  AGS_SOUND_STAGING_CANCEL) == FALSE);
+  CU_ASSERT(ags_execution_plan_test_staging_flags(AGS_SOUND_STAGING_FINI) == FALSE);
+}
+
+void
+ags_execution_plan_test_audio_get_execution_plan()
+{
+  AgsAudio *audio;
+
+  AgsExecutionPlan *execution_plan, *current_execution_plan;
+  
+  audio = ags_audio_new(devout);
+  g_object_ref(audio);
+
+  ags_audio_set_audio_channels(audio,
+			       AGS_EXECUTION_PLAN_TEST_AUDIO_CHANNELS, 0);
+
+  ags_audio_set_pads(audio,
+		     AGS_TYPE_INPUT,
+		     AGS_EXECUTION_PLAN_TEST_INPUT_PADS, 0);
+  ags_audio_set_pads(audio,
+		     AGS_TYPE_OUTPUT,
+		     AGS_EXECUTION_PLAN_TEST_OUTPUT_PADS, 0);
+
+  /* invalid sound scope */
+  CU_ASSERT(ags_audio_get_execution_plan(audio, -1) == NULL);
+  CU_ASSERT(ags_audio_get_execution_plan(audio, AGS_SOUND_SCOPE_LAST) == NULL);
+
+  /* nothing playing - empty plan */
+  execution_plan = ags_audio_get_execution_plan(audio,
+						AGS_SOUND_SCOPE_SEQUENCER);
+
+  CU_ASSERT(execution_plan != NULL);
+  CU_ASSERT(execution_plan->length == 0);
+  CU_ASSERT(ags_execution_plan_is_valid(execution_plan) == TRUE);
+
+  /* compiled once */
+  current_execution_plan = ags_audio_get_execution_plan(audio,
+							AGS_SOUND_SCOPE_SEQUENCER);
+
+  CU_ASSERT(current_execution_plan == execution_plan);
+
+  ags_execution_plan_unref(current_execution_plan);
+  
+  /* compiled again */
+  ags_execution_plan_invalidate();
+
+  current_execution_plan = ags_audio_get_execution_plan(audio,
+							AGS_SOUND_SCOPE_SEQUENCER);
+
+  CU_ASSERT(current_execution_plan != execution_plan);
+  CU_ASSERT(ags_execution_plan_is_valid(current_execution_plan) == TRUE);
+  CU_ASSERT(ags_execution_plan_is_valid(execution_plan) == FALSE);
+
+  ags_execution_plan_unref(current_execution_plan);
+  ags_execution_plan_unref(execution_plan);
+  
+  g_object_unref(audio);
+}
+
+int
+main(int argc, char **argv)
+{
+  CU_pSuite pSuite = NULL;
+
+  putenv("LC_ALL=C");
+  putenv("LANG=C");
+
+  /* initialize the CUnit test registry */
+  if(CUE_SUCCESS != CU_initialize_registry()){
+    return CU_get_error();
+  }
+
+  /* add a suite to the registry */
+  pSuite = CU_add_suite("AgsExecutionPlanTest", ags_execution_plan_test_init_suite, ags_execution_plan_test_clean_suite);
+
+  if(pSuite == NULL){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* add the tests to the suite */
+  if((CU_add_test(pSuite, "test of AgsExecutionPlan alloc", ags_execution_plan_test_alloc) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsExecutionPlan invalidate", ags_execution_plan_test_invalidate) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsExecutionPlan test staging flags", ags_execution_plan_test_test_staging_flags) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsAudio get execution plan", ags_execution_plan_test_audio_get_execution_plan) == NULL)){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* Run all tests using the CUnit Basic interface */
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+  CU_basic_run_tests();
+
+  CU_cleanup_registry();
+
+  return(CU_get_error());
+}
@@ -27,6 +27,8 @@
 #include <ags/libags.h>
 #include <ags/libags-audio.h>
 
+#include <math.h>
+
 int ags_fm_synth_util_test_init_suite();
 int ags_fm_synth_util_test_clean_suite();
 
@@ -75,6 +77,9 @@ void ags_fm_synth_util_test_impulse_float();
 void ags_fm_synth_util_test_impulse_double();
 void ags_fm_synth_util_test_impulse_complex();
 
+void ags_fm_synth_util_test_oscillate_double();
+void ags_fm_synth_util_test_modulate();
+
 #define AGS_FM_SYNTH_UTIL_TEST_FREQ (440.0)
 #define AGS_FM_SYNTH_UTIL_TEST_PHASE (0.0)
 #define AGS_FM_SYNTH_UTIL_TEST_VOLUME (1.0)
@@ -1106,6 +1111,137 @@ ags_fm_synth_util_test_impulse_complex()
   CU_ASSERT(xcross_count + 2 > ((gdouble) AGS_FM_SYNTH_UTIL_TEST_FRAME_COUNT / (gdouble) AGS_FM_SYNTH_UTIL_TEST_SAMPLERATE) * AGS_FM_SYNTH_UTIL_TEST_FREQ);
 }
 
+void
+ags_fm_synth_util_test_oscillate_double()
+{
+  gdouble *buffer, *reference;
+
+  gdouble peak;
+  guint oscillator_mode;
+  guint i;
+  gboolean success;
+  
+  buffer = ags_stream_alloc(AGS_FM_SYNTH_UTIL_TEST_FRAME_COUNT,
+			    AGS_SOUNDCARD_DOUBLE);
+  reference = ags_stream_alloc(AGS_FM_SYNTH_UTIL_TEST_FRAME_COUNT,
+			       AGS_SOUNDCARD_DOUBLE);
+
+  /* without modulation the carrier equals the plain oscillator */
+  success = TRUE;
+
+  for(oscillator_mode = 0; oscillator_mode < AGS_SYNTH_OSCILLATOR_LAST; oscillator_mode++){
+    ags_audio_buffer_util_clear_buffer(buffer, 1,
+				       AGS_FM_SYNTH_UTIL_TEST_FRAME_COUNT, AGS_AUDIO_BUFFER_UTIL_DOUBLE);
+    ags_audio_buffer_util_clear_buffer(reference, 1,
+				       AGS_FM_SYNTH_UTIL_TEST_FRAME_COUNT, AGS_AUDIO_BUFFER_UTIL_DOUBLE);
+
+    ags_fm_synth_util_oscillate_double(buffer,
+				       oscillator_mode,
+				       AGS_FM_SYNTH_UTIL_TEST_FREQ, AGS_FM_SYNTH_UTIL_TEST_PHASE, AGS_FM_SYNTH_UTIL_TEST_VOLUME,
+				       AGS_FM_SYNTH_UTIL_TEST_SAMPLERATE,
+				       AGS_FM_SYNTH_UTIL_TEST_OFFSET, AGS_FM_SYNTH_UTIL_TEST_FRAME_COUNT,
+				       AGS_FM_SYNTH_UTIL_TEST_LFO_OSC_MODE,
+				       AGS_FM_SYNTH_UTIL_TEST_LFO_FREQ, 0.0,
+				       AGS_FM_SYNTH_UTIL_TEST_TUNING);
+
+    ags_synth_util_oscillate_double(reference,
+				    oscillator_mode,
+				    AGS_FM_SYNTH_UTIL_TEST_FREQ, AGS_FM_SYNTH_UTIL_TEST_PHASE, AGS_FM_SYNTH_UTIL_TEST_VOLUME,
+				    AGS_FM_SYNTH_UTIL_TEST_SAMPLERATE,
+				    AGS_FM_SYNTH_UTIL_TEST_OFFSET, AGS_FM_SYNTH_UTIL_TEST_FRAME_COUNT);
+
+    for(i = 0; i < AGS_FM_SYNTH_UTIL_TEST_FRAME_COUNT; i++){
+      if(fabs(buffer[i] - reference[i]) > 0.0001){
+	success = FALSE;
+
+	break;
+      }
+    }
+  }
+
+  CU_ASSERT(success == TRUE);
+
+  /* modulated carrier keeps its level */
+  ags_audio_buffer_util_clear_buffer(buffer, 1,
+				     AGS_FM_SYNTH_UTIL_TEST_FRAME_COUNT, AGS_AUDIO_BUFFER_UTIL_DOUBLE);
+
+  ags_fm_synth_util_oscillate_double(buffer,
+				     AGS_SYNTH_OSCILLATOR_SIN,
+				     AGS_FM_SYNTH_UTIL_TEST_FREQ, AGS_FM_SYNTH_UTIL_TEST_PHASE, AGS_FM_SYNTH_UTIL_TEST_VOLUME,
+				     AGS_FM_SYNTH_UTIL_TEST_SAMPLERATE,
+				     AGS_FM_SYNTH_UTIL_TEST_OFFSET, AGS_FM_SYNTH_UTIL_TEST_FRAME_COUNT,
+				     AGS_FM_SYNTH_UTIL_TEST_LFO_OSC_MODE,
+				     AGS_FM_SYNTH_UTIL_TEST_LFO_FREQ, AGS_FM_SYNTH_UTIL_TEST_LFO_DEPTH,
+				     AGS_FM_SYNTH_UTIL_TEST_TUNING);
+
+  peak = 0.0;
+
+  for(i = 0; i < AGS_FM_SYNTH_UTIL_TEST_FRAME_COUNT; i++){
+    if(fabs(buffer[i]) > peak){
+      peak = fabs(buffer[i]);
+    }
+  }
+
+  CU_ASSERT(peak > 0.9 && peak <= 1.0);
+}
+
+void
+ags_fm_synth_util_test_modulate()
+{
+  AgsModulationSource *modulation_source;
+
+  gdouble *buffer, *reference;
+
+  guint i;
+  gboolean success;
+  
+  buffer = ags_stream_alloc(AGS_FM_SYNTH_UTIL_TEST_FRAME_COUNT,
+			    AGS_SOUNDCARD_DOUBLE);
+  reference = ags_stream_alloc(AGS_FM_SYNTH_UTIL_TEST_FRAME_COUNT,
+			       AGS_SOUNDCARD_DOUBLE);
+
+  modulation_source = ags_modulation_source_new(AGS_FM_SYNTH_UTIL_TEST_SAMPLERATE,
+						AGS_FM_SYNTH_UTIL_TEST_FRAME_COUNT);
+
+  ags_modulation_source_set_lfo(modulation_source,
+				AGS_FM_SYNTH_UTIL_TEST_LFO_OSC_MODE,
+				AGS_FM_SYNTH_UTIL_TEST_LFO_FREQ, AGS_FM_SYNTH_UTIL_TEST_LFO_DEPTH,
+				AGS_FM_SYNTH_UTIL_TEST_TUNING);
+  ags_modulation_source_compute(modulation_source,
+				0);
+  
+  /* the shared control points modulate like the LFO of the voice */
+  ags_fm_synth_util_modulate(buffer,
+			     AGS_SYNTH_OSCILLATOR_SAWTOOTH,
+			     AGS_FM_SYNTH_UTIL_TEST_FREQ, AGS_FM_SYNTH_UTIL_TEST_PHASE, AGS_FM_SYNTH_UTIL_TEST_VOLUME,
+			     AGS_FM_SYNTH_UTIL_TEST_SAMPLERATE, AGS_AUDIO_BUFFER_UTIL_DOUBLE,
+			     AGS_FM_SYNTH_UTIL_TEST_OFFSET, AGS_FM_SYNTH_UTIL_TEST_FRAME_COUNT,
+			     modulation_source);
+
+  ags_fm_synth_util_oscillate_double(reference,
+				     AGS_SYNTH_OSCILLATOR_SAWTOOTH,
+				     AGS_FM_SYNTH_UTIL_TEST_FREQ, AGS_FM_SYNTH_UTIL_TEST_PHASE, AGS_FM_SYNTH_UTIL_TEST_VOLUME,
+				     AGS_FM_SYNTH_UTIL_TEST_SAMPLERATE,
+				     AGS_FM_SYNTH_UTIL_TEST_OFFSET, AGS_FM_SYNTH_UTIL_TEST_FRAME_COUNT,
+				     AGS_FM_SYNTH_UTIL_TEST_LFO_OSC_MODE,
+				     AGS_FM_SYNTH_UTIL_TEST_LFO_FREQ, AGS_FM_SYNTH_UTIL_TEST_LFO_DEPTH,
+				     AGS_FM_SYNTH_UTIL_TEST_TUNING);
+
+  success = TRUE;
+  
+  for(i = 0; i < AGS_FM_SYNTH_UTIL_TEST_FRAME_COUNT; i++){
+    if(fabs(buffer[i] - reference[i]) > 0.0001){
+      success = FALSE;
+
+      break;
+    }
+  }
+
+  CU_ASSERT(success == TRUE);
+
+  g_object_unref(modulation_source);
+}
+
 int
 main(int argc, char **argv)
 {
@@ -1168,7 +1304,9 @@ main(int argc, char **argv)
      (CU_add_test(pSuite, "test of ags_fm_synth_util.c impulse signed 64 bit", ags_fm_synth_util_test_impulse_s64) == NULL) ||
      (CU_add_test(pSuite, "test of ags_fm_synth_util.c impulse float", ags_fm_synth_util_test_impulse_float) == NULL) ||
      (CU_add_test(pSuite, "test of ags_fm_synth_util.c impulse double", ags_fm_synth_util_test_impulse_double) == NULL) ||
-     (CU_add_test(pSuite, "test of ags_fm_synth_util.c impulse complex", ags_fm_synth_util_test_impulse_complex) == NULL)){
+     (CU_add_test(pSuite, "test of ags_fm_synth_util.c impulse complex", ags_fm_synth_util_test_impulse_complex) == NULL) ||
+     (CU_add_test(pSuite, "test of ags_fm_synth_util.c oscillate double", ags_fm_synth_util_test_oscillate_double) == NULL) ||
+     (CU_add_test(pSuite, "test of ags_fm_synth_util.c modulate", ags_fm_synth_util_test_modulate) == NULL)){
     CU_cleanup_registry();
       
     return CU_get_error();
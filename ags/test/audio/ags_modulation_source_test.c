@@ -0,0 +1,285 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <CUnit/CUnit.h>
+#include <CUnit/Automated.h>
+#include <CUnit/Basic.h>
+
+#include <ags/libags.h>
+#include <ags/libags-audio.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+int ags_modulation_source_test_init_suite();
+int ags_modulation_source_test_clean_suite();
+
+void ags_modulation_source_test_compute();
+void ags_modulation_source_test_compute_lfo();
+void ags_modulation_source_test_get_value();
+void ags_modulation_source_test_multiply();
+
+#define AGS_MODULATION_SOURCE_TEST_SAMPLERATE (44100)
+#define AGS_MODULATION_SOURCE_TEST_BUFFER_SIZE (512)
+#define AGS_MODULATION_SOURCE_TEST_LFO_FREQ (6.0)
+#define AGS_MODULATION_SOURCE_TEST_LFO_DEPTH (0.5)
+
+/* The suite initialization function.
+ * Opens the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_modulation_source_test_init_suite()
+{
+  return(0);
+}
+
+/* The suite cleanup function.
+ * Closes the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_modulation_source_test_clean_suite()
+{
+  return(0);
+}
+
+void
+ags_modulation_source_test_compute()
+{
+  AgsModulationSource *modulation_source;
+
+  gdouble first_value;
+  gdouble expected;
+  guint k;
+  
+  modulation_source = ags_modulation_source_new(AGS_MODULATION_SOURCE_TEST_SAMPLERATE,
+						AGS_MODULATION_SOURCE_TEST_BUFFER_SIZE);
+
+  ags_modulation_source_set_lfo(modulation_source,
+				AGS_SYNTH_OSCILLATOR_SAWTOOTH,
+				AGS_MODULATION_SOURCE_TEST_LFO_FREQ, AGS_MODULATION_SOURCE_TEST_LFO_DEPTH,
+				0.0);
+
+  ags_modulation_source_compute(modulation_source,
+				1);
+
+  CU_ASSERT(ags_modulation_source_test_flags(modulation_source, AGS_MODULATION_SOURCE_COMPUTED));
+  CU_ASSERT(modulation_source->control_count == AGS_MODULATION_SOURCE_TEST_BUFFER_SIZE / AGS_MODULATION_SOURCE_DEFAULT_CONTROL_PERIOD + 1);
+
+  /* sawtooth starts at -1.0 */
+  CU_ASSERT(fabs(modulation_source->control_value[0] + AGS_MODULATION_SOURCE_TEST_LFO_DEPTH) < 0.000001);
+
+  for(k = 0; k < modulation_source->control_count; k++){
+    expected = (2.0 * (gdouble) (k * AGS_MODULATION_SOURCE_DEFAULT_CONTROL_PERIOD) * AGS_MODULATION_SOURCE_TEST_LFO_FREQ / (gdouble) AGS_MODULATION_SOURCE_TEST_SAMPLERATE - 1.0) * AGS_MODULATION_SOURCE_TEST_LFO_DEPTH;
+
+    CU_ASSERT(fabs(modulation_source->control_value[k] - expected) < 0.000001);
+  }
+
+  /* same tic doesn't advance */
+  first_value = modulation_source->control_value[0];
+
+  ags_modulation_source_compute(modulation_source,
+				1);
+
+  CU_ASSERT(modulation_source->control_value[0] == first_value);
+
+  /* next tic continues where the previous buffer ended */
+  expected = modulation_source->control_value[modulation_source->control_count - 1];
+  
+  ags_modulation_source_compute(modulation_source,
+				2);
+
+  CU_ASSERT(fabs(modulation_source->control_value[0] - expected) < 0.000001);
+
+  g_object_unref(modulation_source);
+}
+
+void
+ags_modulation_source_test_compute_lfo()
+{
+  AgsModulationSource *modulation_source;
+
+  gdouble lfo_phase;
+  
+  modulation_source = ags_modulation_source_new(AGS_MODULATION_SOURCE_TEST_SAMPLERATE,
+						AGS_MODULATION_SOURCE_TEST_BUFFER_SIZE);
+
+  /* the first consumer of a tic sets the LFO */
+  CU_ASSERT(ags_modulation_source_compute_lfo(modulation_source,
+					      1,
+					      AGS_SYNTH_OSCILLATOR_SIN,
+					      AGS_MODULATION_SOURCE_TEST_LFO_FREQ, AGS_MODULATION_SOURCE_TEST_LFO_DEPTH,
+					      0.0) == TRUE);
+  CU_ASSERT(ags_modulation_source_test_flags(modulation_source, AGS_MODULATION_SOURCE_COMPUTED));
+
+  /* others of the same tic share it only with the same parameters */
+  CU_ASSERT(ags_modulation_source_compute_lfo(modulation_source,
+					      1,
+					      AGS_SYNTH_OSCILLATOR_SIN,
+					      AGS_MODULATION_SOURCE_TEST_LFO_FREQ, AGS_MODULATION_SOURCE_TEST_LFO_DEPTH,
+					      0.0) == TRUE);
+  CU_ASSERT(ags_modulation_source_compute_lfo(modulation_source,
+					      1,
+					      AGS_SYNTH_OSCILLATOR_SQUARE,
+					      AGS_MODULATION_SOURCE_TEST_LFO_FREQ, AGS_MODULATION_SOURCE_TEST_LFO_DEPTH,
+					      0.0) == FALSE);
+  CU_ASSERT(modulation_source->lfo_wave == AGS_SYNTH_OSCILLATOR_SIN);
+  
+  /* the next tic continues the free-running phase */
+  lfo_phase = modulation_source->lfo_phase;
+  
+  CU_ASSERT(ags_modulation_source_compute_lfo(modulation_source,
+					      2,
+					      AGS_SYNTH_OSCILLATOR_SQUARE,
+					      AGS_MODULATION_SOURCE_TEST_LFO_FREQ, AGS_MODULATION_SOURCE_TEST_LFO_DEPTH,
+					      0.0) == TRUE);
+  CU_ASSERT(fabs(modulation_source->lfo_phase - (lfo_phase + (gdouble) AGS_MODULATION_SOURCE_TEST_BUFFER_SIZE * AGS_MODULATION_SOURCE_TEST_LFO_FREQ / (gdouble) AGS_MODULATION_SOURCE_TEST_SAMPLERATE)) < 0.000001);
+  
+  g_object_unref(modulation_source);
+}
+
+void
+ags_modulation_source_test_get_value()
+{
+  AgsModulationSource *modulation_source;
+
+  gdouble *buffer;
+  
+  gdouble value;
+  gdouble expected;
+  guint i;
+  
+  modulation_source = ags_modulation_source_new(AGS_MODULATION_SOURCE_TEST_SAMPLERATE,
+						AGS_MODULATION_SOURCE_TEST_BUFFER_SIZE);
+
+  ags_modulation_source_set_lfo(modulation_source,
+				AGS_SYNTH_OSCILLATOR_SIN,
+				AGS_MODULATION_SOURCE_TEST_LFO_FREQ, AGS_MODULATION_SOURCE_TEST_LFO_DEPTH,
+				0.0);
+
+  ags_modulation_source_compute(modulation_source,
+				0);
+
+  buffer = (gdouble *) g_malloc(AGS_MODULATION_SOURCE_TEST_BUFFER_SIZE * sizeof(gdouble));
+
+  ags_modulation_source_fill(modulation_source,
+			     buffer,
+			     0, AGS_MODULATION_SOURCE_TEST_BUFFER_SIZE);
+  
+  /* interpolated values follow the per sample LFO closely */
+  for(i = 0; i < AGS_MODULATION_SOURCE_TEST_BUFFER_SIZE; i++){
+    value = ags_modulation_source_get_value(modulation_source,
+					    i);
+    expected = sin((gdouble) i * 2.0 * M_PI * AGS_MODULATION_SOURCE_TEST_LFO_FREQ / (gdouble) AGS_MODULATION_SOURCE_TEST_SAMPLERATE) * AGS_MODULATION_SOURCE_TEST_LFO_DEPTH;
+
+    CU_ASSERT(fabs(value - expected) < 0.001);
+    CU_ASSERT(buffer[i] == value);
+  }
+
+  g_free(buffer);
+  
+  g_object_unref(modulation_source);
+}
+
+void
+ags_modulation_source_test_multiply()
+{
+  AgsModulationSource *modulation_source;
+
+  gint16 *buffer;
+  
+  guint i;
+  
+  modulation_source = ags_modulation_source_new(AGS_MODULATION_SOURCE_TEST_SAMPLERATE,
+						AGS_MODULATION_SOURCE_TEST_BUFFER_SIZE);
+
+  /* square with depth 0.5 and tuning 600 cent multiplies by 1.0 in the first half */
+  ags_modulation_source_set_lfo(modulation_source,
+				AGS_SYNTH_OSCILLATOR_SQUARE,
+				AGS_MODULATION_SOURCE_TEST_LFO_FREQ, AGS_MODULATION_SOURCE_TEST_LFO_DEPTH,
+				600.0);
+
+  ags_modulation_source_compute(modulation_source,
+				0);
+
+  buffer = (gint16 *) g_malloc(AGS_MODULATION_SOURCE_TEST_BUFFER_SIZE * sizeof(gint16));
+
+  for(i = 0; i < AGS_MODULATION_SOURCE_TEST_BUFFER_SIZE; i++){
+    buffer[i] = 1000;
+  }
+
+  ags_modulation_source_multiply(modulation_source,
+				 buffer,
+				 AGS_AUDIO_BUFFER_UTIL_S16,
+				 0, AGS_MODULATION_SOURCE_TEST_BUFFER_SIZE);
+  
+  for(i = 0; i < AGS_MODULATION_SOURCE_TEST_BUFFER_SIZE; i++){
+    CU_ASSERT(buffer[i] == 1000);
+  }
+
+  g_free(buffer);
+  
+  g_object_unref(modulation_source);
+}
+
+int
+main(int argc, char **argv)
+{
+  CU_pSuite pSuite = NULL;
+
+  putenv("LC_ALL=C");
+  putenv("LANG=C");
+
+  /* initialize the CUnit test registry */
+  if(CUE_SUCCESS != CU_initialize_registry()){
+    return CU_get_error();
+  }
+
+  /* add a suite to the registry */
+  pSuite = CU_add_suite("AgsModulationSourceTest", ags_modulation_source_test_init_suite, ags_modulation_source_test_clean_suite);
+
+  if(pSuite == NULL){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* add the tests to the suite */
+  if((CU_add_test(pSuite, "test of AgsModulationSource compute", ags_modulation_source_test_compute) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsModulationSource compute LFO", ags_modulation_source_test_compute_lfo) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsModulationSource get value", ags_modulation_source_test_get_value) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsModulationSource multiply", ags_modulation_source_test_multiply) == NULL)){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* Run all tests using the CUnit Basic interface */
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+  CU_basic_run_tests();
+
+  CU_cleanup_registry();
+
+  return(CU_get_error());
+}
@@ -39,6 +39,8 @@ void ags_notation_test_remove_note_at_position();
 void ags_notation_test_is_note_selected();
 void ags_notation_test_find_point();
 void ags_notation_test_find_region();
+void ags_notation_test_find_offset();
+void ags_notation_test_get_note_store();
 void ags_notation_test_free_selection();
 void ags_notation_test_add_all_to_selection();
 void ags_notation_test_add_point_to_selection();
@@ -82,6 +84,15 @@ void ags_notation_test_insert_from_clipboard();
 #define AGS_NOTATION_TEST_FIND_REGION_SELECTION_WIDTH (128)
 #define AGS_NOTATION_TEST_FIND_REGION_SELECTION_HEIGHT (24)
 
+#define AGS_NOTATION_TEST_FIND_OFFSET_WIDTH (1024)
+#define AGS_NOTATION_TEST_FIND_OFFSET_HEIGHT (88)
+#define AGS_NOTATION_TEST_FIND_OFFSET_COUNT (4096)
+#define AGS_NOTATION_TEST_FIND_OFFSET_N_ATTEMPTS (128)
+
+#define AGS_NOTATION_TEST_GET_NOTE_STORE_WIDTH (1024)
+#define AGS_NOTATION_TEST_GET_NOTE_STORE_HEIGHT (88)
+#define AGS_NOTATION_TEST_GET_NOTE_STORE_COUNT (1024)
+
 #define AGS_NOTATION_TEST_FREE_SELECTION_WIDTH (1024)
 #define AGS_NOTATION_TEST_FREE_SELECTION_HEIGHT (88)
 #define AGS_NOTATION_TEST_FREE_SELECTION_COUNT (1024)
@@ -529,6 +540,171 @@ ags_notation_test_find_region()
   CU_ASSERT(success == TRUE);
 }
 
+void
+ags_notation_test_find_offset()
+{
+  AgsNotation *notation;
+  AgsNote *note;
+
+  GList *list, *current, *start_offset, *offset;
+  
+  guint x0, y;
+  guint nth;
+  guint count;
+  guint i;
+  gboolean success;
+
+  /* create notation */
+  notation = ags_notation_new(audio,
+			      0);
+
+  for(i = 0; i < AGS_NOTATION_TEST_FIND_OFFSET_COUNT; i++){
+    x0 = rand() % AGS_NOTATION_TEST_FIND_OFFSET_WIDTH;
+    y = rand() % AGS_NOTATION_TEST_FIND_OFFSET_HEIGHT;
+    
+    note = ags_note_new_with_offset(x0, x0 + 1,
+				    y,
+				    0.0, 0.0);
+
+    ags_notation_add_note(notation,
+			  note,
+			  FALSE);
+  }
+
+  /* assert find offset */
+  success = TRUE;
+
+  for(i = 0;
+      i < AGS_NOTATION_TEST_FIND_OFFSET_N_ATTEMPTS &&
+	success;
+      i++){
+    nth = rand() % g_list_length(notation->note);
+    current = g_list_nth(notation->note,
+			 nth);
+
+    x0 = AGS_NOTE(current->data)->x[0];
+    
+    start_offset = ags_notation_find_offset(notation,
+					    x0,
+					    FALSE);
+
+    /* count matching notes of the list view */
+    list = notation->note;
+    count = 0;
+    
+    while(list != NULL){
+      if(AGS_NOTE(list->data)->x[0] == x0){
+	count++;
+      }
+
+      list = list->next;
+    }
+
+    if(g_list_length(start_offset) != count ||
+       g_list_find(start_offset, current->data) == NULL){
+      success = FALSE;
+    }
+
+    offset = start_offset;
+    
+    while(offset != NULL){
+      if(AGS_NOTE(offset->data)->x[0] != x0){
+	success = FALSE;
+      }
+      
+      offset = offset->next;
+    }
+
+    g_list_free_full(start_offset,
+		     g_object_unref);
+  }
+
+  CU_ASSERT(success == TRUE);
+}
+
+void
+ags_notation_test_get_note_store()
+{
+  AgsNotation *notation;
+  AgsNote *note;
+  AgsNotationNoteStore *note_store, *current_note_store;
+
+  GList *list;
+  
+  guint x0, y;
+  guint i;
+  gboolean success;
+
+  /* create notation */
+  notation = ags_notation_new(audio,
+			      0);
+
+  for(i = 0; i < AGS_NOTATION_TEST_GET_NOTE_STORE_COUNT; i++){
+    x0 = rand() % AGS_NOTATION_TEST_GET_NOTE_STORE_WIDTH;
+    y = rand() % AGS_NOTATION_TEST_GET_NOTE_STORE_HEIGHT;
+    
+    note = ags_note_new_with_offset(x0, x0 + 1,
+				    y,
+				    0.0, 0.0);
+
+    ags_notation_add_note(notation,
+			  note,
+			  FALSE);
+  }
+
+  /* assert store matches list view */
+  note_store = ags_notation_get_note_store(notation);
+
+  CU_ASSERT(note_store != NULL);
+  CU_ASSERT(note_store->length == g_list_length(notation->note));
+
+  list = notation->note;
+  success = TRUE;
+  
+  for(i = 0; i < note_store->length && list != NULL; i++){
+    if(note_store->note[i] != list->data ||
+       note_store->x0[i] != AGS_NOTE(list->data)->x[0] ||
+       note_store->y[i] != AGS_NOTE(list->data)->y){
+      success = FALSE;
+
+      break;
+    }
+    
+    list = list->next;
+  }
+
+  CU_ASSERT(success == TRUE);
+
+  /* shared until modified */
+  current_note_store = ags_notation_get_note_store(notation);
+
+  CU_ASSERT(current_note_store == note_store);
+
+  ags_notation_note_store_unref(current_note_store);
+
+  /* lower bound */
+  i = ags_notation_note_store_lower_bound(note_store,
+					  AGS_NOTATION_TEST_GET_NOTE_STORE_WIDTH / 2);
+
+  CU_ASSERT(i == note_store->length ||
+	    note_store->x0[i] >= AGS_NOTATION_TEST_GET_NOTE_STORE_WIDTH / 2);
+  CU_ASSERT(i == 0 ||
+	    note_store->x0[i - 1] < AGS_NOTATION_TEST_GET_NOTE_STORE_WIDTH / 2);
+
+  /* modify invalidates */
+  ags_notation_remove_note(notation,
+			   note_store->note[0],
+			   FALSE);
+
+  current_note_store = ags_notation_get_note_store(notation);
+
+  CU_ASSERT(current_note_store != note_store);
+  CU_ASSERT(current_note_store->length == note_store->length - 1);
+
+  ags_notation_note_store_unref(current_note_store);
+  ags_notation_note_store_unref(note_store);
+}
+
 void
 ags_notation_test_free_selection()
 {
@@ -834,6 +1010,8 @@ main(int argc, char **argv)
      (CU_add_test(pSuite, "test of AgsNotation is note selected", ags_notation_test_is_note_selected) == NULL) ||
      (CU_add_test(pSuite, "test of AgsNotation find point", ags_notation_test_find_point) == NULL) ||
      (CU_add_test(pSuite, "test of AgsNotation find region", ags_notation_test_find_region) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsNotation find offset", ags_notation_test_find_offset) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsNotation get note store", ags_notation_test_get_note_store) == NULL) ||
      (CU_add_test(pSuite, "test of AgsNotation free selection", ags_notation_test_free_selection) == NULL) ||
      (CU_add_test(pSuite, "test of AgsNotation add all to selection", ags_notation_test_add_all_to_selection) == NULL) ||
      (CU_add_test(pSuite, "test of AgsNotation add point to selection", ags_notation_test_add_point_to_selection) == NULL) ||
@@ -63,6 +63,7 @@ void ags_recall_test_add_handler();
 void ags_recall_test_remove_handler();
 void ags_recall_test_lock_port();
 void ags_recall_test_unlock_port();
+void ags_recall_test_load();
 
 void ags_recall_test_callback(AgsRecall *recall,
 			      gpointer data);
@@ -96,6 +97,8 @@ AgsRecall* ags_recall_test_duplicate_callback(AgsRecall *recall, AgsRecallID *re
 #define AGS_RECALL_TEST_GET_BY_EFFECT_RECALL_COUNT (4)
 #define AGS_RECALL_TEST_GET_BY_EFFECT_LADSPA_RECALL_COUNT (16)
 
+#define AGS_RECALL_TEST_LOAD_CHILDREN_COUNT (4)
+
 AgsDevout *devout;
 
 /* The suite initialization function.
@@ -875,6 +878,82 @@ ags_recall_test_unlock_port()
   //TODO:JK: implement me
 }
 
+void
+ags_recall_test_load()
+{
+  AgsRecall *recall;
+  AgsRecall **child;
+
+  guint64 run_count, cumulative_time, peak_time;
+  guint i;
+  gboolean success;
+
+  recall = ags_recall_new();
+
+  child = (AgsRecall **) malloc(AGS_RECALL_TEST_LOAD_CHILDREN_COUNT * sizeof(AgsRecall *));
+  
+  for(i = 0; i < AGS_RECALL_TEST_LOAD_CHILDREN_COUNT; i++){
+    child[i] = ags_recall_new();
+    ags_recall_add_child(recall,
+			 child[i]);
+  }
+
+  /* assert children accounted */
+  ags_recall_global_set_load_accounting(TRUE);
+  
+  ags_recall_run_pre(recall);
+
+  success = TRUE;
+  
+  for(i = 0; i < AGS_RECALL_TEST_LOAD_CHILDREN_COUNT; i++){
+    ags_recall_get_load(child[i],
+			AGS_RECALL_LOAD_RUN_PRE,
+			&run_count, &cumulative_time, &peak_time);
+
+    if(run_count != 1 ||
+       peak_time > cumulative_time){
+      success = FALSE;
+
+      break;
+    }
+
+    ags_recall_get_load(child[i],
+			AGS_RECALL_LOAD_RUN_POST,
+			&run_count, NULL, NULL);
+
+    if(run_count != 0){
+      success = FALSE;
+
+      break;
+    }
+  }
+
+  CU_ASSERT(success == TRUE);
+
+  /* assert reset */
+  success = TRUE;
+
+  for(i = 0; i < AGS_RECALL_TEST_LOAD_CHILDREN_COUNT; i++){
+    ags_recall_reset_load(child[i]);
+    
+    ags_recall_get_load(child[i],
+			AGS_RECALL_LOAD_RUN_PRE,
+			&run_count, &cumulative_time, &peak_time);
+
+    if(run_count != 0 ||
+       cumulative_time != 0 ||
+       peak_time != 0){
+      success = FALSE;
+
+      break;
+    }
+  }
+
+  CU_ASSERT(success == TRUE);
+
+  free(child);
+}
+
 int
 main(int argc, char **argv)
 {
@@ -929,7 +1008,8 @@ main(int argc, char **argv)
      (CU_add_test(pSuite, "test of AgsRecall add handler", ags_recall_test_add_handler) == NULL) ||
      (CU_add_test(pSuite, "test of AgsRecall remove handler", ags_recall_test_remove_handler) == NULL) ||
      (CU_add_test(pSuite, "test of AgsRecall lock port", ags_recall_test_lock_port) == NULL) ||
-     (CU_add_test(pSuite, "test of AgsRecall unlock port", ags_recall_test_unlock_port) == NULL)){
+     (CU_add_test(pSuite, "test of AgsRecall unlock port", ags_recall_test_unlock_port) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsRecall load", ags_recall_test_load) == NULL)){
     CU_cleanup_registry();
     
     return CU_get_error();
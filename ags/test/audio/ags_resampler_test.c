@@ -0,0 +1,282 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <CUnit/CUnit.h>
+#include <CUnit/Automated.h>
+#include <CUnit/Basic.h>
+
+#include <ags/libags.h>
+#include <ags/libags-audio.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+int ags_resampler_test_init_suite();
+int ags_resampler_test_clean_suite();
+
+void ags_resampler_test_get_target_length();
+void ags_resampler_test_convert();
+void ags_resampler_test_process();
+void ags_resampler_test_get_thread_default();
+
+#define AGS_RESAMPLER_TEST_SAMPLERATE (44100)
+#define AGS_RESAMPLER_TEST_TARGET_SAMPLERATE (48000)
+#define AGS_RESAMPLER_TEST_FREQUENCY (440.0)
+#define AGS_RESAMPLER_TEST_FRAME_COUNT (44100)
+#define AGS_RESAMPLER_TEST_BLOCK_LENGTH (512)
+
+gfloat *ags_resampler_test_sine = NULL;
+
+/* The suite initialization function.
+ * Opens the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_resampler_test_init_suite()
+{
+  guint i;
+
+  ags_resampler_test_sine = (gfloat *) malloc(AGS_RESAMPLER_TEST_FRAME_COUNT * sizeof(gfloat));
+
+  for(i = 0; i < AGS_RESAMPLER_TEST_FRAME_COUNT; i++){
+    ags_resampler_test_sine[i] = 0.5 * sin(2.0 * M_PI * AGS_RESAMPLER_TEST_FREQUENCY * (gdouble) i / (gdouble) AGS_RESAMPLER_TEST_SAMPLERATE);
+  }
+
+  return(0);
+}
+
+/* The suite cleanup function.
+ * Closes the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_resampler_test_clean_suite()
+{
+  free(ags_resampler_test_sine);
+
+  return(0);
+}
+
+void
+ags_resampler_test_get_target_length()
+{
+  AgsResampler *resampler;
+
+  resampler = ags_resampler_new(1,
+				AGS_RESAMPLER_TEST_SAMPLERATE,
+				AGS_RESAMPLER_TEST_TARGET_SAMPLERATE,
+				AGS_RESAMPLER_DEFAULT_QUALITY);
+
+  CU_ASSERT(ags_resampler_get_target_length(resampler, AGS_RESAMPLER_TEST_SAMPLERATE) == AGS_RESAMPLER_TEST_TARGET_SAMPLERATE);
+
+  /* no integer truncation of the ratio */
+  CU_ASSERT(ags_resampler_get_target_length(resampler, 441) == 480);
+
+  ags_resampler_set_samplerate(resampler,
+			       AGS_RESAMPLER_TEST_TARGET_SAMPLERATE);
+  ags_resampler_set_target_samplerate(resampler,
+				      AGS_RESAMPLER_TEST_SAMPLERATE);
+
+  CU_ASSERT(ags_resampler_get_target_length(resampler, 480) == 441);
+
+  g_object_unref(resampler);
+}
+
+void
+ags_resampler_test_convert()
+{
+  AgsResampler *resampler;
+
+  gfloat *target_buffer;
+
+  gdouble expected;
+  guint target_length;
+  guint written;
+  guint i;
+  gboolean success;
+
+  resampler = ags_resampler_new(1,
+				AGS_RESAMPLER_TEST_SAMPLERATE,
+				AGS_RESAMPLER_TEST_TARGET_SAMPLERATE,
+				AGS_RESAMPLER_DEFAULT_QUALITY);
+
+  target_length = ags_resampler_get_target_length(resampler,
+						  AGS_RESAMPLER_TEST_FRAME_COUNT);
+
+  target_buffer = (gfloat *) malloc(target_length * sizeof(gfloat));
+  memset(target_buffer, 0, target_length * sizeof(gfloat));
+
+  written = ags_resampler_convert(resampler,
+				  ags_resampler_test_sine, AGS_AUDIO_BUFFER_UTIL_FLOAT,
+				  AGS_RESAMPLER_TEST_FRAME_COUNT,
+				  target_buffer, AGS_AUDIO_BUFFER_UTIL_FLOAT,
+				  target_length);
+
+  CU_ASSERT(written + 1 >= target_length);
+
+  /* compare to the sine at target samplerate, skip the edges */
+  success = TRUE;
+
+  for(i = 1024; i + 1024 < written; i++){
+    expected = 0.5 * sin(2.0 * M_PI * AGS_RESAMPLER_TEST_FREQUENCY * (gdouble) i / (gdouble) AGS_RESAMPLER_TEST_TARGET_SAMPLERATE);
+
+    if(fabs(expected - target_buffer[i]) > 0.01){
+      success = FALSE;
+
+      break;
+    }
+  }
+
+  CU_ASSERT(success == TRUE);
+
+  free(target_buffer);
+
+  g_object_unref(resampler);
+}
+
+void
+ags_resampler_test_process()
+{
+  AgsResampler *resampler;
+
+  gfloat *target_buffer, *stream_buffer;
+
+  guint target_length;
+  guint written, stream_written;
+  guint offset;
+  guint i;
+  gboolean success;
+
+  resampler = ags_resampler_new(1,
+				AGS_RESAMPLER_TEST_SAMPLERATE,
+				AGS_RESAMPLER_TEST_TARGET_SAMPLERATE,
+				AGS_RESAMPLER_DEFAULT_QUALITY);
+
+  target_length = ags_resampler_get_target_length(resampler,
+						  AGS_RESAMPLER_TEST_FRAME_COUNT);
+
+  target_buffer = (gfloat *) malloc(target_length * sizeof(gfloat));
+  memset(target_buffer, 0, target_length * sizeof(gfloat));
+
+  stream_buffer = (gfloat *) malloc(target_length * sizeof(gfloat));
+  memset(stream_buffer, 0, target_length * sizeof(gfloat));
+
+  written = ags_resampler_convert(resampler,
+				  ags_resampler_test_sine, AGS_AUDIO_BUFFER_UTIL_FLOAT,
+				  AGS_RESAMPLER_TEST_FRAME_COUNT,
+				  target_buffer, AGS_AUDIO_BUFFER_UTIL_FLOAT,
+				  target_length);
+
+  /* the same signal block by block must match the one-shot result */
+  ags_resampler_reset(resampler);
+
+  stream_written = 0;
+
+  for(offset = 0; offset < AGS_RESAMPLER_TEST_FRAME_COUNT; offset += AGS_RESAMPLER_TEST_BLOCK_LENGTH){
+    guint block_length;
+
+    block_length = AGS_RESAMPLER_TEST_BLOCK_LENGTH;
+
+    if(offset + block_length > AGS_RESAMPLER_TEST_FRAME_COUNT){
+      block_length = AGS_RESAMPLER_TEST_FRAME_COUNT - offset;
+    }
+
+    stream_written += ags_resampler_process(resampler,
+					    ags_resampler_test_sine + offset, AGS_AUDIO_BUFFER_UTIL_FLOAT,
+					    block_length,
+					    stream_buffer + stream_written, AGS_AUDIO_BUFFER_UTIL_FLOAT,
+					    target_length - stream_written,
+					    ((offset + block_length >= AGS_RESAMPLER_TEST_FRAME_COUNT) ? TRUE: FALSE));
+  }
+
+  CU_ASSERT(stream_written == written);
+
+  success = TRUE;
+
+  for(i = 0; i < written && i < stream_written; i++){
+    if(fabs(target_buffer[i] - stream_buffer[i]) > 0.0001){
+      success = FALSE;
+
+      break;
+    }
+  }
+
+  CU_ASSERT(success == TRUE);
+
+  free(target_buffer);
+  free(stream_buffer);
+
+  g_object_unref(resampler);
+}
+
+void
+ags_resampler_test_get_thread_default()
+{
+  AgsResampler *resampler;
+
+  resampler = ags_resampler_get_thread_default();
+
+  CU_ASSERT(AGS_IS_RESAMPLER(resampler));
+  CU_ASSERT(ags_resampler_get_thread_default() == resampler);
+}
+
+int
+main(int argc, char **argv)
+{
+  CU_pSuite pSuite = NULL;
+
+  putenv("LC_ALL=C");
+  putenv("LANG=C");
+
+  /* initialize the CUnit test registry */
+  if(CUE_SUCCESS != CU_initialize_registry()){
+    return CU_get_error();
+  }
+
+  /* add a suite to the registry */
+  pSuite = CU_add_suite("AgsResamplerTest", ags_resampler_test_init_suite, ags_resampler_test_clean_suite);
+
+  if(pSuite == NULL){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* add the tests to the suite */
+  if((CU_add_test(pSuite, "test of AgsResampler get target length", ags_resampler_test_get_target_length) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsResampler convert", ags_resampler_test_convert) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsResampler process", ags_resampler_test_process) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsResampler get thread default", ags_resampler_test_get_thread_default) == NULL)){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* Run all tests using the CUnit Basic interface */
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+  CU_basic_run_tests();
+
+  CU_cleanup_registry();
+
+  return(CU_get_error());
+}
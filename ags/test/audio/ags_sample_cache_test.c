@@ -0,0 +1,365 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <CUnit/CUnit.h>
+#include <CUnit/Automated.h>
+#include <CUnit/Basic.h>
+
+#include <ags/libags.h>
+#include <ags/libags-audio.h>
+
+#include <stdlib.h>
+
+int ags_sample_cache_test_init_suite();
+int ags_sample_cache_test_clean_suite();
+
+void ags_sample_cache_test_lookup();
+void ags_sample_cache_test_insert();
+void ags_sample_cache_test_insert_decoded();
+void ags_sample_cache_test_evict();
+void ags_sample_cache_test_remove_sample();
+
+#define AGS_SAMPLE_CACHE_TEST_SAMPLERATE (44100)
+#define AGS_SAMPLE_CACHE_TEST_FRAME_COUNT (1024)
+#define AGS_SAMPLE_CACHE_TEST_NOTE (-9.0)
+
+/* The suite initialization function.
+ * Opens the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_sample_cache_test_init_suite()
+{
+  return(0);
+}
+
+/* The suite cleanup function.
+ * Closes the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_sample_cache_test_clean_suite()
+{
+  return(0);
+}
+
+void
+ags_sample_cache_test_lookup()
+{
+  AgsSampleCache *sample_cache;
+  AgsSampleCacheEntry *sample_cache_entry, *current;
+
+  GObject *sample;
+
+  sample_cache = ags_sample_cache_new();
+
+  sample = g_object_new(G_TYPE_OBJECT,
+			NULL);
+
+  CU_ASSERT(ags_sample_cache_lookup(sample_cache,
+				    sample,
+				    AGS_SAMPLE_CACHE_TEST_SAMPLERATE, AGS_SOUNDCARD_SIGNED_16_BIT,
+				    AGS_SAMPLE_CACHE_TEST_NOTE) == NULL);
+
+  sample_cache_entry = ags_sample_cache_insert(sample_cache,
+					       sample,
+					       AGS_SAMPLE_CACHE_TEST_SAMPLERATE, AGS_SOUNDCARD_SIGNED_16_BIT,
+					       AGS_SAMPLE_CACHE_TEST_NOTE,
+					       ags_stream_alloc(AGS_SAMPLE_CACHE_TEST_FRAME_COUNT,
+								AGS_SOUNDCARD_SIGNED_16_BIT),
+					       AGS_SAMPLE_CACHE_TEST_FRAME_COUNT);
+
+  /* hit */
+  current = ags_sample_cache_lookup(sample_cache,
+				    sample,
+				    AGS_SAMPLE_CACHE_TEST_SAMPLERATE, AGS_SOUNDCARD_SIGNED_16_BIT,
+				    AGS_SAMPLE_CACHE_TEST_NOTE);
+
+  CU_ASSERT(current == sample_cache_entry);
+
+  ags_sample_cache_entry_unref(current);
+
+  /* any other part of the key misses */
+  CU_ASSERT(ags_sample_cache_lookup(sample_cache,
+				    sample,
+				    48000, AGS_SOUNDCARD_SIGNED_16_BIT,
+				    AGS_SAMPLE_CACHE_TEST_NOTE) == NULL);
+  CU_ASSERT(ags_sample_cache_lookup(sample_cache,
+				    sample,
+				    AGS_SAMPLE_CACHE_TEST_SAMPLERATE, AGS_SOUNDCARD_FLOAT,
+				    AGS_SAMPLE_CACHE_TEST_NOTE) == NULL);
+  CU_ASSERT(ags_sample_cache_lookup(sample_cache,
+				    sample,
+				    AGS_SAMPLE_CACHE_TEST_SAMPLERATE, AGS_SOUNDCARD_SIGNED_16_BIT,
+				    AGS_SAMPLE_CACHE_TEST_NOTE + 1.0) == NULL);
+
+  ags_sample_cache_entry_unref(sample_cache_entry);
+
+  g_object_unref(sample);
+  g_object_unref(sample_cache);
+}
+
+void
+ags_sample_cache_test_insert()
+{
+  AgsSampleCache *sample_cache;
+  AgsSampleCacheEntry *sample_cache_entry, *current;
+
+  GObject *sample;
+
+  sample_cache = ags_sample_cache_new();
+
+  sample = g_object_new(G_TYPE_OBJECT,
+			NULL);
+
+  sample_cache_entry = ags_sample_cache_insert(sample_cache,
+					       sample,
+					       AGS_SAMPLE_CACHE_TEST_SAMPLERATE, AGS_SOUNDCARD_SIGNED_16_BIT,
+					       AGS_SAMPLE_CACHE_TEST_NOTE,
+					       ags_stream_alloc(AGS_SAMPLE_CACHE_TEST_FRAME_COUNT,
+								AGS_SOUNDCARD_SIGNED_16_BIT),
+					       AGS_SAMPLE_CACHE_TEST_FRAME_COUNT);
+
+  CU_ASSERT(sample_cache_entry != NULL);
+  CU_ASSERT(sample_cache_entry->frame_count == AGS_SAMPLE_CACHE_TEST_FRAME_COUNT);
+  CU_ASSERT(sample_cache->memory_used == AGS_SAMPLE_CACHE_TEST_FRAME_COUNT * sizeof(gint16));
+
+  /* inserting the same key again keeps the first entry */
+  current = ags_sample_cache_insert(sample_cache,
+				    sample,
+				    AGS_SAMPLE_CACHE_TEST_SAMPLERATE, AGS_SOUNDCARD_SIGNED_16_BIT,
+				    AGS_SAMPLE_CACHE_TEST_NOTE,
+				    ags_stream_alloc(AGS_SAMPLE_CACHE_TEST_FRAME_COUNT,
+						     AGS_SOUNDCARD_SIGNED_16_BIT),
+				    AGS_SAMPLE_CACHE_TEST_FRAME_COUNT);
+
+  CU_ASSERT(current == sample_cache_entry);
+  CU_ASSERT(sample_cache->memory_used == AGS_SAMPLE_CACHE_TEST_FRAME_COUNT * sizeof(gint16));
+
+  ags_sample_cache_entry_unref(current);
+  ags_sample_cache_entry_unref(sample_cache_entry);
+
+  g_object_unref(sample);
+  g_object_unref(sample_cache);
+}
+
+void
+ags_sample_cache_test_insert_decoded()
+{
+  AgsSampleCache *sample_cache;
+  AgsSampleCacheEntry *sample_cache_entry, *current;
+
+  GObject *sample;
+
+  sample_cache = ags_sample_cache_new();
+
+  sample = g_object_new(G_TYPE_OBJECT,
+			NULL);
+
+  CU_ASSERT(ags_sample_cache_lookup_decoded(sample_cache,
+					    sample,
+					    AGS_SAMPLE_CACHE_TEST_SAMPLERATE) == NULL);
+
+  sample_cache_entry = ags_sample_cache_insert_decoded(sample_cache,
+						       sample,
+						       AGS_SAMPLE_CACHE_TEST_SAMPLERATE,
+						       ags_stream_alloc(AGS_SAMPLE_CACHE_TEST_FRAME_COUNT,
+									AGS_SOUNDCARD_DOUBLE),
+						       AGS_SAMPLE_CACHE_TEST_FRAME_COUNT);
+
+  CU_ASSERT(sample_cache_entry != NULL);
+  CU_ASSERT((AGS_SAMPLE_CACHE_ENTRY_DECODED & (sample_cache_entry->flags)) != 0);
+  CU_ASSERT(sample_cache->memory_used == AGS_SAMPLE_CACHE_TEST_FRAME_COUNT * sizeof(gdouble));
+
+  /* the decoded level doesn't collide with a pitched double entry */
+  CU_ASSERT(ags_sample_cache_lookup(sample_cache,
+				    sample,
+				    AGS_SAMPLE_CACHE_TEST_SAMPLERATE, AGS_SOUNDCARD_DOUBLE,
+				    0.0) == NULL);
+
+  current = ags_sample_cache_insert(sample_cache,
+				    sample,
+				    AGS_SAMPLE_CACHE_TEST_SAMPLERATE, AGS_SOUNDCARD_DOUBLE,
+				    0.0,
+				    ags_stream_alloc(AGS_SAMPLE_CACHE_TEST_FRAME_COUNT,
+						     AGS_SOUNDCARD_DOUBLE),
+				    AGS_SAMPLE_CACHE_TEST_FRAME_COUNT);
+
+  CU_ASSERT(current != sample_cache_entry);
+  CU_ASSERT(sample_cache->memory_used == 2 * AGS_SAMPLE_CACHE_TEST_FRAME_COUNT * sizeof(gdouble));
+
+  ags_sample_cache_entry_unref(current);
+
+  /* any note hits the same decoded entry */
+  current = ags_sample_cache_lookup_decoded(sample_cache,
+					    sample,
+					    AGS_SAMPLE_CACHE_TEST_SAMPLERATE);
+
+  CU_ASSERT(current == sample_cache_entry);
+
+  ags_sample_cache_entry_unref(current);
+  ags_sample_cache_entry_unref(sample_cache_entry);
+
+  g_object_unref(sample);
+  g_object_unref(sample_cache);
+}
+
+void
+ags_sample_cache_test_evict()
+{
+  AgsSampleCache *sample_cache;
+  AgsSampleCacheEntry *sample_cache_entry;
+
+  GObject *sample;
+
+  guint i;
+
+  sample_cache = ags_sample_cache_new();
+
+  /* room for two entries */
+  g_object_set(sample_cache,
+	       "memory-budget", (guint64) (2 * AGS_SAMPLE_CACHE_TEST_FRAME_COUNT * sizeof(gfloat)),
+	       NULL);
+
+  sample = g_object_new(G_TYPE_OBJECT,
+			NULL);
+
+  for(i = 0; i < 3; i++){
+    if(i == 2){
+      /* touch the first entry, so the second becomes least recently used */
+      sample_cache_entry = ags_sample_cache_lookup(sample_cache,
+						   sample,
+						   AGS_SAMPLE_CACHE_TEST_SAMPLERATE, AGS_SOUNDCARD_FLOAT,
+						   0.0);
+
+      CU_ASSERT(sample_cache_entry != NULL);
+
+      ags_sample_cache_entry_unref(sample_cache_entry);
+    }
+
+    sample_cache_entry = ags_sample_cache_insert(sample_cache,
+						 sample,
+						 AGS_SAMPLE_CACHE_TEST_SAMPLERATE, AGS_SOUNDCARD_FLOAT,
+						 (gdouble) i,
+						 ags_stream_alloc(AGS_SAMPLE_CACHE_TEST_FRAME_COUNT,
+								  AGS_SOUNDCARD_FLOAT),
+						 AGS_SAMPLE_CACHE_TEST_FRAME_COUNT);
+
+    ags_sample_cache_entry_unref(sample_cache_entry);
+  }
+
+  CU_ASSERT(sample_cache->memory_used == 2 * AGS_SAMPLE_CACHE_TEST_FRAME_COUNT * sizeof(gfloat));
+
+  sample_cache_entry = ags_sample_cache_lookup(sample_cache,
+					       sample,
+					       AGS_SAMPLE_CACHE_TEST_SAMPLERATE, AGS_SOUNDCARD_FLOAT,
+					       1.0);
+
+  CU_ASSERT(sample_cache_entry == NULL);
+
+  sample_cache_entry = ags_sample_cache_lookup(sample_cache,
+					       sample,
+					       AGS_SAMPLE_CACHE_TEST_SAMPLERATE, AGS_SOUNDCARD_FLOAT,
+					       0.0);
+
+  CU_ASSERT(sample_cache_entry != NULL);
+
+  ags_sample_cache_entry_unref(sample_cache_entry);
+
+  g_object_unref(sample);
+  g_object_unref(sample_cache);
+}
+
+void
+ags_sample_cache_test_remove_sample()
+{
+  AgsSampleCache *sample_cache;
+  AgsSampleCacheEntry *sample_cache_entry;
+
+  GObject *sample;
+
+  sample_cache = ags_sample_cache_new();
+
+  sample = g_object_new(G_TYPE_OBJECT,
+			NULL);
+
+  sample_cache_entry = ags_sample_cache_insert(sample_cache,
+					       sample,
+					       AGS_SAMPLE_CACHE_TEST_SAMPLERATE, AGS_SOUNDCARD_DOUBLE,
+					       AGS_SAMPLE_CACHE_TEST_NOTE,
+					       ags_stream_alloc(AGS_SAMPLE_CACHE_TEST_FRAME_COUNT,
+								AGS_SOUNDCARD_DOUBLE),
+					       AGS_SAMPLE_CACHE_TEST_FRAME_COUNT);
+
+  /* finalizing the sample drops its entries, the data stays valid for the holder */
+  g_object_unref(sample);
+
+  CU_ASSERT(sample_cache->memory_used == 0);
+  CU_ASSERT(g_hash_table_size(sample_cache->entry) == 0);
+  CU_ASSERT(sample_cache_entry->data != NULL);
+
+  ags_sample_cache_entry_unref(sample_cache_entry);
+
+  g_object_unref(sample_cache);
+}
+
+int
+main(int argc, char **argv)
+{
+  CU_pSuite pSuite = NULL;
+
+  putenv("LC_ALL=C");
+  putenv("LANG=C");
+
+  /* initialize the CUnit test registry */
+  if(CUE_SUCCESS != CU_initialize_registry()){
+    return CU_get_error();
+  }
+
+  /* add a suite to the registry */
+  pSuite = CU_add_suite("AgsSampleCacheTest", ags_sample_cache_test_init_suite, ags_sample_cache_test_clean_suite);
+
+  if(pSuite == NULL){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* add the tests to the suite */
+  if((CU_add_test(pSuite, "test of AgsSampleCache lookup", ags_sample_cache_test_lookup) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsSampleCache insert", ags_sample_cache_test_insert) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsSampleCache insert decoded", ags_sample_cache_test_insert_decoded) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsSampleCache evict", ags_sample_cache_test_evict) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsSampleCache remove sample", ags_sample_cache_test_remove_sample) == NULL)){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* Run all tests using the CUnit Basic interface */
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+  CU_basic_run_tests();
+
+  CU_cleanup_registry();
+
+  return(CU_get_error());
+}
@@ -0,0 +1,258 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <CUnit/CUnit.h>
+#include <CUnit/Automated.h>
+#include <CUnit/Basic.h>
+
+#include <ags/libags.h>
+#include <ags/libags-audio.h>
+
+#include <stdlib.h>
+
+#include <string.h>
+
+int ags_soundcard_util_test_init_suite();
+int ags_soundcard_util_test_clean_suite();
+
+void ags_soundcard_util_test_convert_float_to_device_s8();
+void ags_soundcard_util_test_convert_float_to_device_s16();
+void ags_soundcard_util_test_convert_float_to_device_s24();
+void ags_soundcard_util_test_convert_float_to_device_s32();
+void ags_soundcard_util_test_convert_float_to_device_s64();
+void ags_soundcard_util_test_convert_float_to_device_float();
+void ags_soundcard_util_test_convert_float_to_device_double();
+
+#define AGS_SOUNDCARD_UTIL_TEST_COUNT (7)
+
+gboolean ags_soundcard_util_test_convert_signed(guint device_format,
+						gdouble max_value);
+
+/* The suite initialization function.
+ * Opens the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_soundcard_util_test_init_suite()
+{
+  return(0);
+}
+
+/* The suite cleanup function.
+ * Closes the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_soundcard_util_test_clean_suite()
+{
+  return(0);
+}
+
+gboolean
+ags_soundcard_util_test_convert_signed(guint device_format,
+				       gdouble max_value)
+{
+  gfloat source[AGS_SOUNDCARD_UTIL_TEST_COUNT];
+  gint64 destination[AGS_SOUNDCARD_UTIL_TEST_COUNT];
+  gint64 expected[AGS_SOUNDCARD_UTIL_TEST_COUNT];
+  gint64 value;
+
+  guint i;
+  gboolean success;
+
+  /* full scale, clipped, silence and less than one step, the latter rounds instead of truncating */
+  source[0] = 1.0;
+  source[1] = -1.0;
+  source[2] = 2.0;
+  source[3] = -2.0;
+  source[4] = 0.0;
+  source[5] = (gfloat) (0.75 / max_value);
+  source[6] = (gfloat) (-0.75 / max_value);
+
+  expected[0] = (gint64) max_value;
+  expected[1] = -1 * (gint64) max_value;
+  expected[2] = (gint64) max_value;
+  expected[3] = -1 * (gint64) max_value;
+  expected[4] = 0;
+  expected[5] = 1;
+  expected[6] = -1;
+
+  memset(destination, 0, AGS_SOUNDCARD_UTIL_TEST_COUNT * sizeof(gint64));
+  
+  ags_soundcard_util_convert_float_to_device(destination, device_format,
+					     source,
+					     AGS_SOUNDCARD_UTIL_TEST_COUNT);
+
+  success = TRUE;
+  
+  for(i = 0; i < AGS_SOUNDCARD_UTIL_TEST_COUNT; i++){
+    switch(device_format){
+    case AGS_SOUNDCARD_SIGNED_8_BIT:
+      {
+	value = ((gint8 *) destination)[i];
+      }
+      break;
+    case AGS_SOUNDCARD_SIGNED_16_BIT:
+      {
+	value = ((gint16 *) destination)[i];
+      }
+      break;
+    case AGS_SOUNDCARD_SIGNED_24_BIT:
+    case AGS_SOUNDCARD_SIGNED_32_BIT:
+      {
+	value = ((gint32 *) destination)[i];
+      }
+      break;
+    default:
+      {
+	value = destination[i];
+      }
+    }
+
+    if(value != expected[i]){
+      success = FALSE;
+    }
+  }
+
+  return(success);
+}
+
+void
+ags_soundcard_util_test_convert_float_to_device_s8()
+{
+  CU_ASSERT(ags_soundcard_util_test_convert_signed(AGS_SOUNDCARD_SIGNED_8_BIT,
+						   127.0) == TRUE);
+}
+
+void
+ags_soundcard_util_test_convert_float_to_device_s16()
+{
+  CU_ASSERT(ags_soundcard_util_test_convert_signed(AGS_SOUNDCARD_SIGNED_16_BIT,
+						   32767.0) == TRUE);
+}
+
+void
+ags_soundcard_util_test_convert_float_to_device_s24()
+{
+  CU_ASSERT(ags_soundcard_util_test_convert_signed(AGS_SOUNDCARD_SIGNED_24_BIT,
+						   8388607.0) == TRUE);
+}
+
+void
+ags_soundcard_util_test_convert_float_to_device_s32()
+{
+  CU_ASSERT(ags_soundcard_util_test_convert_signed(AGS_SOUNDCARD_SIGNED_32_BIT,
+						   2147483647.0) == TRUE);
+}
+
+void
+ags_soundcard_util_test_convert_float_to_device_s64()
+{
+  CU_ASSERT(ags_soundcard_util_test_convert_signed(AGS_SOUNDCARD_SIGNED_64_BIT,
+						   9223372036854774784.0) == TRUE);
+}
+
+void
+ags_soundcard_util_test_convert_float_to_device_float()
+{
+  gfloat source[AGS_SOUNDCARD_UTIL_TEST_COUNT] = {
+    1.0, -1.0, 2.0, -2.0, 0.0, 0.5, -0.5,
+  };
+  gfloat destination[AGS_SOUNDCARD_UTIL_TEST_COUNT];
+  
+  /* floating point is passed through */
+  ags_soundcard_util_convert_float_to_device(destination, AGS_SOUNDCARD_FLOAT,
+					     source,
+					     AGS_SOUNDCARD_UTIL_TEST_COUNT);
+
+  CU_ASSERT(memcmp(destination, source, AGS_SOUNDCARD_UTIL_TEST_COUNT * sizeof(gfloat)) == 0);
+}
+
+void
+ags_soundcard_util_test_convert_float_to_device_double()
+{
+  gfloat source[AGS_SOUNDCARD_UTIL_TEST_COUNT] = {
+    1.0, -1.0, 2.0, -2.0, 0.0, 0.5, -0.5,
+  };
+  gdouble destination[AGS_SOUNDCARD_UTIL_TEST_COUNT];
+
+  guint i;
+  gboolean success;
+  
+  ags_soundcard_util_convert_float_to_device(destination, AGS_SOUNDCARD_DOUBLE,
+					     source,
+					     AGS_SOUNDCARD_UTIL_TEST_COUNT);
+
+  success = TRUE;
+  
+  for(i = 0; i < AGS_SOUNDCARD_UTIL_TEST_COUNT; i++){
+    if(destination[i] != (gdouble) source[i]){
+      success = FALSE;
+    }
+  }
+
+  CU_ASSERT(success == TRUE);
+}
+
+int
+main(int argc, char **argv)
+{
+  CU_pSuite pSuite = NULL;
+
+  putenv("LC_ALL=C");
+  putenv("LANG=C");
+
+  /* initialize the CUnit test registry */
+  if(CUE_SUCCESS != CU_initialize_registry()){
+    return CU_get_error();
+  }
+
+  /* add a suite to the registry */
+  pSuite = CU_add_suite("AgsSoundcardUtilTest", ags_soundcard_util_test_init_suite, ags_soundcard_util_test_clean_suite);
+
+  if(pSuite == NULL){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* add the tests to the suite */
+  if((CU_add_test(pSuite, "test of ags_soundcard_util.c convert float to signed 8 bit", ags_soundcard_util_test_convert_float_to_device_s8) == NULL) ||
+     (CU_add_test(pSuite, "test of ags_soundcard_util.c convert float to signed 16 bit", ags_soundcard_util_test_convert_float_to_device_s16) == NULL) ||
+     (CU_add_test(pSuite, "test of ags_soundcard_util.c convert float to signed 24 bit", ags_soundcard_util_test_convert_float_to_device_s24) == NULL) ||
+     (CU_add_test(pSuite, "test of ags_soundcard_util.c convert float to signed 32 bit", ags_soundcard_util_test_convert_float_to_device_s32) == NULL) ||
+     (CU_add_test(pSuite, "test of ags_soundcard_util.c convert float to signed 64 bit", ags_soundcard_util_test_convert_float_to_device_s64) == NULL) ||
+     (CU_add_test(pSuite, "test of ags_soundcard_util.c convert float to float", ags_soundcard_util_test_convert_float_to_device_float) == NULL) ||
+     (CU_add_test(pSuite, "test of ags_soundcard_util.c convert float to double", ags_soundcard_util_test_convert_float_to_device_double) == NULL)){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* Run all tests using the CUnit Basic interface */
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+  CU_basic_run_tests();
+
+  CU_cleanup_registry();
+
+  return(CU_get_error());
+}
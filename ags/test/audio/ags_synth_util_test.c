@@ -27,6 +27,8 @@
 #include <ags/libags.h>
 #include <ags/libags-audio.h>
 
+#include <math.h>
+
 int ags_synth_util_test_init_suite();
 int ags_synth_util_test_clean_suite();
 
@@ -75,6 +77,8 @@ void ags_synth_util_test_impulse_float();
 void ags_synth_util_test_impulse_double();
 void ags_synth_util_test_impulse_complex();
 
+void ags_synth_util_test_oscillate_double();
+
 #define AGS_SYNTH_UTIL_TEST_PHASE (0.0)
 #define AGS_SYNTH_UTIL_TEST_VOLUME (1.0)
 #define AGS_SYNTH_UTIL_TEST_SAMPLERATE (44100)
@@ -1433,6 +1437,55 @@ ags_synth_util_test_impulse_complex()
   CU_ASSERT(success == TRUE);
 }
 
+void
+ags_synth_util_test_oscillate_double()
+{
+  gdouble *buffer;
+
+  gdouble peak;
+  guint xcross_count;
+  guint oscillator_mode;
+  guint i;
+  gboolean success;
+  
+  buffer = ags_stream_alloc(AGS_SYNTH_UTIL_TEST_FRAME_COUNT,
+			    AGS_SOUNDCARD_DOUBLE);
+
+  success = TRUE;
+
+  for(oscillator_mode = 0; oscillator_mode < AGS_SYNTH_OSCILLATOR_LAST; oscillator_mode++){
+    ags_audio_buffer_util_clear_buffer(buffer, 1,
+				       AGS_SYNTH_UTIL_TEST_FRAME_COUNT, AGS_AUDIO_BUFFER_UTIL_DOUBLE);
+    
+    ags_synth_util_oscillate_double(buffer,
+				    oscillator_mode,
+				    440.0, AGS_SYNTH_UTIL_TEST_PHASE, AGS_SYNTH_UTIL_TEST_VOLUME,
+				    AGS_SYNTH_UTIL_TEST_SAMPLERATE,
+				    AGS_SYNTH_UTIL_TEST_OFFSET, AGS_SYNTH_UTIL_TEST_FRAME_COUNT);
+    
+    xcross_count = ags_synth_util_get_xcross_count(buffer,
+						   AGS_AUDIO_BUFFER_UTIL_DOUBLE,
+						   AGS_SYNTH_UTIL_TEST_FRAME_COUNT);
+
+    peak = 0.0;
+
+    for(i = 0; i < AGS_SYNTH_UTIL_TEST_FRAME_COUNT; i++){
+      if(fabs(buffer[i]) > peak){
+	peak = fabs(buffer[i]);
+      }
+    }
+
+    /* at least a zero-crossing per period, band-limiting must not blow up the level */
+    if(xcross_count + 1 < floor(((gdouble) AGS_SYNTH_UTIL_TEST_FRAME_COUNT / (gdouble) AGS_SYNTH_UTIL_TEST_SAMPLERATE) * 440.0) ||
+       peak < 0.9 ||
+       peak > 1.1){
+      success = FALSE;
+    }
+  }
+  
+  CU_ASSERT(success == TRUE);
+}
+
 int
 main(int argc, char **argv)
 {
@@ -1494,7 +1547,8 @@ main(int argc, char **argv)
      (CU_add_test(pSuite, "test of ags_synth_util.c impulse s64", ags_synth_util_test_impulse_s64) == NULL) ||
      (CU_add_test(pSuite, "test of ags_synth_util.c impulse float", ags_synth_util_test_impulse_float) == NULL) ||
      (CU_add_test(pSuite, "test of ags_synth_util.c impulse double", ags_synth_util_test_impulse_double) == NULL) ||
-     (CU_add_test(pSuite, "test of ags_synth_util.c impulse complex", ags_synth_util_test_impulse_complex) == NULL)){
+     (CU_add_test(pSuite, "test of ags_synth_util.c impulse complex", ags_synth_util_test_impulse_complex) == NULL) ||
+     (CU_add_test(pSuite, "test of ags_synth_util.c oscillate double", ags_synth_util_test_oscillate_double) == NULL)){
     CU_cleanup_registry();
       
     return CU_get_error();
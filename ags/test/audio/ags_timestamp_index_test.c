@@ -0,0 +1,297 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <CUnit/CUnit.h>
+#include <CUnit/Automated.h>
+#include <CUnit/Basic.h>
+
+#include <ags/libags.h>
+#include <ags/libags-audio.h>
+
+#include <stdlib.h>
+
+int ags_timestamp_index_test_init_suite();
+int ags_timestamp_index_test_clean_suite();
+
+void ags_timestamp_index_test_insert();
+void ags_timestamp_index_test_remove();
+void ags_timestamp_index_test_find();
+void ags_timestamp_index_test_find_all();
+
+#define AGS_TIMESTAMP_INDEX_TEST_OFFSET_LENGTH (1024)
+#define AGS_TIMESTAMP_INDEX_TEST_COUNT (64)
+
+/* The suite initialization function.
+ * Opens the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_timestamp_index_test_init_suite()
+{
+  return(0);
+}
+
+/* The suite cleanup function.
+ * Closes the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_timestamp_index_test_clean_suite()
+{
+  return(0);
+}
+
+void
+ags_timestamp_index_test_insert()
+{
+  AgsTimestampIndex *timestamp_index;
+
+  GObject *data;
+  
+  timestamp_index = ags_timestamp_index_new(AGS_TIMESTAMP_INDEX_TEST_OFFSET_LENGTH);
+
+  CU_ASSERT(ags_timestamp_index_get_offset_length(timestamp_index) == AGS_TIMESTAMP_INDEX_TEST_OFFSET_LENGTH);
+
+  data = g_object_new(G_TYPE_OBJECT,
+		      NULL);
+
+  ags_timestamp_index_insert(timestamp_index,
+			     data,
+			     0, 0);
+
+  CU_ASSERT(g_hash_table_size(timestamp_index->entry) == 1);
+  CU_ASSERT(data->ref_count == 2);
+  
+  /* insert again moves */
+  ags_timestamp_index_insert(timestamp_index,
+			     data,
+			     1, 4 * AGS_TIMESTAMP_INDEX_TEST_OFFSET_LENGTH);
+
+  CU_ASSERT(g_hash_table_size(timestamp_index->entry) == 1);
+  CU_ASSERT(g_hash_table_size(timestamp_index->bucket) == 1);
+  CU_ASSERT(data->ref_count == 2);
+
+  CU_ASSERT(ags_timestamp_index_find(timestamp_index,
+				     0,
+				     0, AGS_TIMESTAMP_INDEX_TEST_OFFSET_LENGTH) == NULL);
+
+  g_object_unref(timestamp_index);
+
+  CU_ASSERT(data->ref_count == 1);
+
+  g_object_unref(data);
+}
+
+void
+ags_timestamp_index_test_remove()
+{
+  AgsTimestampIndex *timestamp_index;
+
+  GObject *data[AGS_TIMESTAMP_INDEX_TEST_COUNT];
+
+  guint i;
+  
+  timestamp_index = ags_timestamp_index_new(AGS_TIMESTAMP_INDEX_TEST_OFFSET_LENGTH);
+
+  for(i = 0; i < AGS_TIMESTAMP_INDEX_TEST_COUNT; i++){
+    data[i] = g_object_new(G_TYPE_OBJECT,
+			   NULL);
+
+    ags_timestamp_index_insert(timestamp_index,
+			       data[i],
+			       i % 2, (i / 2) * AGS_TIMESTAMP_INDEX_TEST_OFFSET_LENGTH);
+  }
+
+  CU_ASSERT(g_hash_table_size(timestamp_index->bucket) == AGS_TIMESTAMP_INDEX_TEST_COUNT);
+
+  for(i = 0; i < AGS_TIMESTAMP_INDEX_TEST_COUNT; i += 2){
+    ags_timestamp_index_remove(timestamp_index,
+			       data[i]);
+  }
+
+  CU_ASSERT(g_hash_table_size(timestamp_index->entry) == AGS_TIMESTAMP_INDEX_TEST_COUNT / 2);
+  CU_ASSERT(g_hash_table_size(timestamp_index->bucket) == AGS_TIMESTAMP_INDEX_TEST_COUNT / 2);
+
+  CU_ASSERT(ags_timestamp_index_find(timestamp_index,
+				     0,
+				     0, AGS_TIMESTAMP_INDEX_TEST_COUNT * AGS_TIMESTAMP_INDEX_TEST_OFFSET_LENGTH) == NULL);
+
+  ags_timestamp_index_clear(timestamp_index);
+
+  CU_ASSERT(g_hash_table_size(timestamp_index->entry) == 0);
+  CU_ASSERT(g_hash_table_size(timestamp_index->bucket) == 0);
+
+  for(i = 0; i < AGS_TIMESTAMP_INDEX_TEST_COUNT; i++){
+    CU_ASSERT(data[i]->ref_count == 1);
+    
+    g_object_unref(data[i]);
+  }
+  
+  g_object_unref(timestamp_index);
+}
+
+void
+ags_timestamp_index_test_find()
+{
+  AgsTimestampIndex *timestamp_index;
+
+  GObject *data[AGS_TIMESTAMP_INDEX_TEST_COUNT];
+  GObject *current;
+  
+  guint i;
+  gboolean success;
+  
+  timestamp_index = ags_timestamp_index_new(AGS_TIMESTAMP_INDEX_TEST_OFFSET_LENGTH);
+
+  for(i = 0; i < AGS_TIMESTAMP_INDEX_TEST_COUNT; i++){
+    data[i] = g_object_new(G_TYPE_OBJECT,
+			   NULL);
+
+    ags_timestamp_index_insert(timestamp_index,
+			       data[i],
+			       i % 4, (i / 4) * AGS_TIMESTAMP_INDEX_TEST_OFFSET_LENGTH);
+  }
+
+  success = TRUE;
+  
+  for(i = 0; i < AGS_TIMESTAMP_INDEX_TEST_COUNT; i++){
+    current = ags_timestamp_index_find(timestamp_index,
+				       i % 4,
+				       (i / 4) * AGS_TIMESTAMP_INDEX_TEST_OFFSET_LENGTH, AGS_TIMESTAMP_INDEX_TEST_OFFSET_LENGTH);
+
+    if(current != data[i]){
+      success = FALSE;
+    }
+
+    if(current != NULL){
+      g_object_unref(current);
+    }
+  }
+
+  CU_ASSERT(success == TRUE);
+
+  /* lowest offset within a range over several buckets */
+  current = ags_timestamp_index_find(timestamp_index,
+				     1,
+				     AGS_TIMESTAMP_INDEX_TEST_OFFSET_LENGTH / 2, 4 * AGS_TIMESTAMP_INDEX_TEST_OFFSET_LENGTH);
+
+  CU_ASSERT(current == data[5]);
+
+  if(current != NULL){
+    g_object_unref(current);
+  }
+
+  /* unused line */
+  CU_ASSERT(ags_timestamp_index_find(timestamp_index,
+				     4,
+				     0, AGS_TIMESTAMP_INDEX_TEST_OFFSET_LENGTH) == NULL);
+  
+  g_object_unref(timestamp_index);
+
+  for(i = 0; i < AGS_TIMESTAMP_INDEX_TEST_COUNT; i++){
+    g_object_unref(data[i]);
+  }
+}
+
+void
+ags_timestamp_index_test_find_all()
+{
+  AgsTimestampIndex *timestamp_index;
+
+  GObject *data[AGS_TIMESTAMP_INDEX_TEST_COUNT];
+
+  GList *start_list;
+  
+  guint i;
+  
+  timestamp_index = ags_timestamp_index_new(AGS_TIMESTAMP_INDEX_TEST_OFFSET_LENGTH);
+
+  /* several entries per bucket */
+  for(i = 0; i < AGS_TIMESTAMP_INDEX_TEST_COUNT; i++){
+    data[i] = g_object_new(G_TYPE_OBJECT,
+			   NULL);
+
+    ags_timestamp_index_insert(timestamp_index,
+			       data[i],
+			       0, (i / 8) * AGS_TIMESTAMP_INDEX_TEST_OFFSET_LENGTH);
+  }
+
+  start_list = ags_timestamp_index_find_all(timestamp_index,
+					    0,
+					    AGS_TIMESTAMP_INDEX_TEST_OFFSET_LENGTH, AGS_TIMESTAMP_INDEX_TEST_OFFSET_LENGTH);
+
+  CU_ASSERT(g_list_length(start_list) == 8);
+  CU_ASSERT(g_list_find(start_list, data[8]) != NULL);
+  CU_ASSERT(g_list_find(start_list, data[15]) != NULL);
+  CU_ASSERT(g_list_find(start_list, data[16]) == NULL);
+
+  g_list_free_full(start_list,
+		   (GDestroyNotify) g_object_unref);
+
+  g_object_unref(timestamp_index);
+
+  for(i = 0; i < AGS_TIMESTAMP_INDEX_TEST_COUNT; i++){
+    g_object_unref(data[i]);
+  }
+}
+
+int
+main(int argc, char **argv)
+{
+  CU_pSuite pSuite = NULL;
+
+  putenv("LC_ALL=C");
+  putenv("LANG=C");
+
+  /* initialize the CUnit test registry */
+  if(CUE_SUCCESS != CU_initialize_registry()){
+    return CU_get_error();
+  }
+
+  /* add a suite to the registry */
+  pSuite = CU_add_suite("AgsTimestampIndexTest", ags_timestamp_index_test_init_suite, ags_timestamp_index_test_clean_suite);
+
+  if(pSuite == NULL){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* add the tests to the suite */
+  if((CU_add_test(pSuite, "test of AgsTimestampIndex insert", ags_timestamp_index_test_insert) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsTimestampIndex remove", ags_timestamp_index_test_remove) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsTimestampIndex find", ags_timestamp_index_test_find) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsTimestampIndex find all", ags_timestamp_index_test_find_all) == NULL)){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* Run all tests using the CUnit Basic interface */
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+  CU_basic_run_tests();
+
+  CU_cleanup_registry();
+
+  return(CU_get_error());
+}
@@ -0,0 +1,299 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib.h>
+#include <glib-object.h>
+#include <glib/gstdio.h>
+
+#include <CUnit/CUnit.h>
+#include <CUnit/Automated.h>
+#include <CUnit/Basic.h>
+
+#include <ags/libags.h>
+#include <ags/libags-audio.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+int ags_wave_stream_test_init_suite();
+int ags_wave_stream_test_clean_suite();
+
+void ags_wave_stream_test_prefetch();
+void ags_wave_stream_test_find_point();
+void ags_wave_stream_test_seek();
+void ags_wave_stream_test_pin();
+
+#define AGS_WAVE_STREAM_TEST_SAMPLERATE (44100)
+#define AGS_WAVE_STREAM_TEST_BUFFER_SIZE (512)
+#define AGS_WAVE_STREAM_TEST_FRAME_COUNT (8192)
+#define AGS_WAVE_STREAM_TEST_X_OFFSET (1000)
+
+gchar *ags_wave_stream_test_filename = NULL;
+
+AgsWaveStream* ags_wave_stream_test_create_stream();
+
+/* The suite initialization function.
+ * Opens the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_wave_stream_test_init_suite()
+{
+  guchar *contents;
+
+  gsize length;
+  guint i;
+
+  /* 16 bit mono WAV with sample i set to i */
+  length = 44 + 2 * AGS_WAVE_STREAM_TEST_FRAME_COUNT;
+  contents = (guchar *) g_malloc0(length);
+
+  memcpy(contents, "RIFF", 4);
+  *((guint32 *) (contents + 4)) = GUINT32_TO_LE(length - 8);
+  memcpy(contents + 8, "WAVE", 4);
+
+  memcpy(contents + 12, "fmt ", 4);
+  *((guint32 *) (contents + 16)) = GUINT32_TO_LE(16);
+  *((guint16 *) (contents + 20)) = GUINT16_TO_LE(1);
+  *((guint16 *) (contents + 22)) = GUINT16_TO_LE(1);
+  *((guint32 *) (contents + 24)) = GUINT32_TO_LE(AGS_WAVE_STREAM_TEST_SAMPLERATE);
+  *((guint32 *) (contents + 28)) = GUINT32_TO_LE(2 * AGS_WAVE_STREAM_TEST_SAMPLERATE);
+  *((guint16 *) (contents + 32)) = GUINT16_TO_LE(2);
+  *((guint16 *) (contents + 34)) = GUINT16_TO_LE(16);
+
+  memcpy(contents + 36, "data", 4);
+  *((guint32 *) (contents + 40)) = GUINT32_TO_LE(2 * AGS_WAVE_STREAM_TEST_FRAME_COUNT);
+
+  for(i = 0; i < AGS_WAVE_STREAM_TEST_FRAME_COUNT; i++){
+    *((guint16 *) (contents + 44 + 2 * i)) = GUINT16_TO_LE((guint16) i);
+  }
+
+  ags_wave_stream_test_filename = g_build_filename(g_get_tmp_dir(),
+						   "ags_wave_stream_test.wav",
+						   NULL);
+
+  if(!g_file_set_contents(ags_wave_stream_test_filename,
+			  (gchar *) contents, length,
+			  NULL)){
+    g_free(contents);
+
+    return(-1);
+  }
+
+  g_free(contents);
+
+  return(0);
+}
+
+/* The suite cleanup function.
+ * Closes the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_wave_stream_test_clean_suite()
+{
+  g_unlink(ags_wave_stream_test_filename);
+
+  g_free(ags_wave_stream_test_filename);
+
+  return(0);
+}
+
+AgsWaveStream*
+ags_wave_stream_test_create_stream()
+{
+  AgsWaveStream *wave_stream;
+
+  wave_stream = ags_wave_stream_new(ags_wave_stream_test_filename,
+				    0,
+				    AGS_WAVE_STREAM_TEST_X_OFFSET,
+				    AGS_WAVE_STREAM_TEST_FRAME_COUNT);
+  g_object_set(wave_stream,
+	       "samplerate", AGS_WAVE_STREAM_TEST_SAMPLERATE,
+	       "buffer-size", AGS_WAVE_STREAM_TEST_BUFFER_SIZE,
+	       "format", AGS_SOUNDCARD_SIGNED_16_BIT,
+	       NULL);
+
+  return(wave_stream);
+}
+
+void
+ags_wave_stream_test_prefetch()
+{
+  AgsWaveStream *wave_stream;
+
+  wave_stream = ags_wave_stream_test_create_stream();
+
+  /* the whole region fits the ring */
+  CU_ASSERT(ags_wave_stream_prefetch(wave_stream) == AGS_WAVE_STREAM_TEST_FRAME_COUNT / AGS_WAVE_STREAM_TEST_BUFFER_SIZE);
+  CU_ASSERT(ags_wave_stream_test_flags(wave_stream, AGS_WAVE_STREAM_OPENED));
+
+  /* nothing left to do */
+  CU_ASSERT(ags_wave_stream_prefetch(wave_stream) == 0);
+
+  g_object_unref(wave_stream);
+}
+
+void
+ags_wave_stream_test_find_point()
+{
+  AgsWaveStream *wave_stream;
+  AgsBuffer *buffer;
+
+  wave_stream = ags_wave_stream_test_create_stream();
+
+  ags_wave_stream_prefetch(wave_stream);
+
+  /* out of region */
+  CU_ASSERT(ags_wave_stream_find_point(wave_stream, 0) == NULL);
+  CU_ASSERT(ags_wave_stream_find_point(wave_stream, AGS_WAVE_STREAM_TEST_X_OFFSET + AGS_WAVE_STREAM_TEST_FRAME_COUNT) == NULL);
+
+  /* first buffer */
+  buffer = ags_wave_stream_find_point(wave_stream, AGS_WAVE_STREAM_TEST_X_OFFSET + 10);
+
+  CU_ASSERT(buffer != NULL);
+
+  if(buffer != NULL){
+    CU_ASSERT(buffer->x == AGS_WAVE_STREAM_TEST_X_OFFSET);
+    CU_ASSERT(((gint16 *) buffer->data)[10] == 10);
+  }
+
+  /* advancing releases the first buffer */
+  buffer = ags_wave_stream_find_point(wave_stream, AGS_WAVE_STREAM_TEST_X_OFFSET + 3 * AGS_WAVE_STREAM_TEST_BUFFER_SIZE);
+
+  CU_ASSERT(buffer != NULL);
+
+  if(buffer != NULL){
+    CU_ASSERT(buffer->x == AGS_WAVE_STREAM_TEST_X_OFFSET + 3 * AGS_WAVE_STREAM_TEST_BUFFER_SIZE);
+    CU_ASSERT(((gint16 *) buffer->data)[0] == 3 * AGS_WAVE_STREAM_TEST_BUFFER_SIZE);
+  }
+
+  CU_ASSERT(wave_stream->read_position == 3);
+
+  g_object_unref(wave_stream);
+}
+
+void
+ags_wave_stream_test_seek()
+{
+  AgsWaveStream *wave_stream;
+  AgsBuffer *buffer;
+
+  wave_stream = ags_wave_stream_test_create_stream();
+
+  ags_wave_stream_prefetch(wave_stream);
+
+  /* move the cursor to the end and seek back */
+  CU_ASSERT(ags_wave_stream_find_point(wave_stream, AGS_WAVE_STREAM_TEST_X_OFFSET + AGS_WAVE_STREAM_TEST_FRAME_COUNT - 1) != NULL);
+
+  ags_wave_stream_seek(wave_stream,
+		       AGS_WAVE_STREAM_TEST_X_OFFSET + 2 * AGS_WAVE_STREAM_TEST_BUFFER_SIZE);
+
+  CU_ASSERT(ags_wave_stream_find_point(wave_stream, AGS_WAVE_STREAM_TEST_X_OFFSET + 2 * AGS_WAVE_STREAM_TEST_BUFFER_SIZE) == NULL);
+
+  CU_ASSERT(ags_wave_stream_prefetch(wave_stream) == AGS_WAVE_STREAM_TEST_FRAME_COUNT / AGS_WAVE_STREAM_TEST_BUFFER_SIZE - 2);
+
+  buffer = ags_wave_stream_find_point(wave_stream, AGS_WAVE_STREAM_TEST_X_OFFSET + 2 * AGS_WAVE_STREAM_TEST_BUFFER_SIZE);
+
+  CU_ASSERT(buffer != NULL);
+
+  if(buffer != NULL){
+    CU_ASSERT(((gint16 *) buffer->data)[1] == 2 * AGS_WAVE_STREAM_TEST_BUFFER_SIZE + 1);
+  }
+
+  /* jumping backwards without seek restarts prefetch */
+  CU_ASSERT(ags_wave_stream_find_point(wave_stream, AGS_WAVE_STREAM_TEST_X_OFFSET) == NULL);
+  CU_ASSERT(ags_wave_stream_prefetch(wave_stream) > 0);
+  CU_ASSERT(ags_wave_stream_find_point(wave_stream, AGS_WAVE_STREAM_TEST_X_OFFSET) != NULL);
+
+  g_object_unref(wave_stream);
+}
+
+void
+ags_wave_stream_test_pin()
+{
+  AgsWaveStream *wave_stream;
+  AgsBuffer *buffer;
+
+  wave_stream = ags_wave_stream_test_create_stream();
+
+  ags_wave_stream_prefetch(wave_stream);
+
+  /* the last buffer is read while seeking to the start */
+  buffer = ags_wave_stream_find_point(wave_stream, AGS_WAVE_STREAM_TEST_X_OFFSET + AGS_WAVE_STREAM_TEST_FRAME_COUNT - 1);
+
+  CU_ASSERT(buffer != NULL);
+
+  ags_wave_stream_seek(wave_stream,
+		       AGS_WAVE_STREAM_TEST_X_OFFSET);
+
+  /* the pinned slot isn't refilled */
+  CU_ASSERT(ags_wave_stream_prefetch(wave_stream) == AGS_WAVE_STREAM_TEST_FRAME_COUNT / AGS_WAVE_STREAM_TEST_BUFFER_SIZE - 1);
+
+  if(buffer != NULL){
+    CU_ASSERT(buffer->x == AGS_WAVE_STREAM_TEST_X_OFFSET + AGS_WAVE_STREAM_TEST_FRAME_COUNT - AGS_WAVE_STREAM_TEST_BUFFER_SIZE);
+  }
+
+  /* the next read releases it */
+  CU_ASSERT(ags_wave_stream_find_point(wave_stream, AGS_WAVE_STREAM_TEST_X_OFFSET) != NULL);
+  CU_ASSERT(ags_wave_stream_prefetch(wave_stream) == 1);
+
+  g_object_unref(wave_stream);
+}
+
+int
+main(int argc, char **argv)
+{
+  CU_pSuite pSuite = NULL;
+
+  putenv("LC_ALL=C");
+  putenv("LANG=C");
+
+  /* initialize the CUnit test registry */
+  if(CUE_SUCCESS != CU_initialize_registry()){
+    return CU_get_error();
+  }
+
+  /* add a suite to the registry */
+  pSuite = CU_add_suite("AgsWaveStreamTest", ags_wave_stream_test_init_suite, ags_wave_stream_test_clean_suite);
+
+  if(pSuite == NULL){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* add the tests to the suite */
+  if((CU_add_test(pSuite, "test of AgsWaveStream prefetch", ags_wave_stream_test_prefetch) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsWaveStream find point", ags_wave_stream_test_find_point) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsWaveStream seek", ags_wave_stream_test_seek) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsWaveStream pin", ags_wave_stream_test_pin) == NULL)){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* Run all tests using the CUnit Basic interface */
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+  CU_basic_run_tests();
+
+  CU_cleanup_registry();
+
+  return(CU_get_error());
+}
@@ -38,6 +38,7 @@ void ags_wave_test_remove_buffer();
 void ags_wave_test_get_selection();
 void ags_wave_test_is_buffer_selected();
 void ags_wave_test_find_point();
+void ags_wave_test_find_data();
 void ags_wave_test_find_region();
 void ags_wave_test_free_selection();
 void ags_wave_test_add_region_to_selection();
@@ -66,6 +67,10 @@ void ags_wave_test_insert_from_clipboard_extended();
 #define AGS_WAVE_TEST_FIND_POINT_COUNT (1025)
 #define AGS_WAVE_TEST_FIND_POINT_N_ATTEMPTS (1024)
 
+#define AGS_WAVE_TEST_FIND_DATA_BUFFER_SIZE (1024)
+#define AGS_WAVE_TEST_FIND_DATA_COUNT (128)
+#define AGS_WAVE_TEST_FIND_DATA_REMOVE_NTH (2)
+
 #define AGS_WAVE_TEST_FIND_REGION_BUFFER_SIZE (1024)
 #define AGS_WAVE_TEST_FIND_REGION_COUNT (1024)
 #define AGS_WAVE_TEST_FIND_REGION_N_ATTEMPTS (128)
@@ -402,6 +407,96 @@ ags_wave_test_find_point()
   CU_ASSERT(success == TRUE);
 }
 
+void
+ags_wave_test_find_data()
+{
+  AgsWave *wave;
+  AgsBuffer *buffer, *removed_buffer;
+
+  gint16 *data;
+  
+  guint64 x;
+  guint frame_count;
+  guint i, j;
+  
+  /* create wave */
+  wave = ags_wave_new(audio,
+		      0);
+  g_object_set(wave,
+	       "buffer-size", AGS_WAVE_TEST_FIND_DATA_BUFFER_SIZE,
+	       "format", AGS_SOUNDCARD_SIGNED_16_BIT,
+	       NULL);
+
+  removed_buffer = NULL;
+  
+  for(i = 0; i < AGS_WAVE_TEST_FIND_DATA_COUNT; i++){
+    x = i * AGS_WAVE_TEST_FIND_DATA_BUFFER_SIZE;
+    
+    buffer = ags_buffer_new();
+    g_object_set(buffer,
+		 "buffer-size", AGS_WAVE_TEST_FIND_DATA_BUFFER_SIZE,
+		 "format", AGS_SOUNDCARD_SIGNED_16_BIT,
+		 "x", x, 
+		 NULL);
+
+    for(j = 0; j < AGS_WAVE_TEST_FIND_DATA_BUFFER_SIZE; j++){
+      ((gint16 *) buffer->data)[j] = i;
+    }
+    
+    ags_wave_add_buffer(wave,
+			buffer,
+			FALSE);
+
+    if(i == AGS_WAVE_TEST_FIND_DATA_REMOVE_NTH){
+      removed_buffer = buffer;
+    }
+  }
+
+  /* buffers are views into a contiguous chunk */
+  CU_ASSERT(ags_buffer_test_flags(removed_buffer, AGS_BUFFER_VIEW));
+  
+  data = ags_wave_find_data(wave,
+			    AGS_WAVE_TEST_FIND_DATA_BUFFER_SIZE / 2,
+			    &frame_count);
+
+  CU_ASSERT(data != NULL);
+  CU_ASSERT(frame_count == wave->chunk_length - AGS_WAVE_TEST_FIND_DATA_BUFFER_SIZE / 2);
+
+  if(data != NULL){
+    CU_ASSERT(data[0] == 0);
+    CU_ASSERT(data[AGS_WAVE_TEST_FIND_DATA_BUFFER_SIZE] == 1);
+  }
+
+  CU_ASSERT(ags_wave_find_point(wave,
+				AGS_WAVE_TEST_FIND_DATA_BUFFER_SIZE + 1,
+				FALSE)->data == (gpointer) (data + AGS_WAVE_TEST_FIND_DATA_BUFFER_SIZE / 2));
+  
+  /* removing a buffer interrupts the range and detaches its data */
+  g_object_ref(removed_buffer);
+  
+  ags_wave_remove_buffer(wave,
+			 removed_buffer,
+			 FALSE);
+
+  CU_ASSERT(!ags_buffer_test_flags(removed_buffer, AGS_BUFFER_VIEW));
+  CU_ASSERT(((gint16 *) removed_buffer->data)[0] == AGS_WAVE_TEST_FIND_DATA_REMOVE_NTH);
+
+  data = ags_wave_find_data(wave,
+			    0,
+			    &frame_count);
+
+  CU_ASSERT(data != NULL);
+  CU_ASSERT(frame_count == AGS_WAVE_TEST_FIND_DATA_REMOVE_NTH * AGS_WAVE_TEST_FIND_DATA_BUFFER_SIZE);
+
+  CU_ASSERT(ags_wave_find_data(wave,
+			       AGS_WAVE_TEST_FIND_DATA_REMOVE_NTH * AGS_WAVE_TEST_FIND_DATA_BUFFER_SIZE,
+			       &frame_count) == NULL);
+  CU_ASSERT(frame_count == 0);
+
+  g_object_unref(removed_buffer);
+  g_object_unref(wave);
+}
+
 void
 ags_wave_test_find_region()
 {
@@ -647,6 +742,7 @@ main(int argc, char **argv)
      (CU_add_test(pSuite, "test of AgsWave get selection", ags_wave_test_get_selection) == NULL) ||
      (CU_add_test(pSuite, "test of AgsWave is buffer selected", ags_wave_test_is_buffer_selected) == NULL) ||
      (CU_add_test(pSuite, "test of AgsWave find point", ags_wave_test_find_point) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsWave find data", ags_wave_test_find_data) == NULL) ||
      (CU_add_test(pSuite, "test of AgsWave find region", ags_wave_test_find_region) == NULL) ||
      (CU_add_test(pSuite, "test of AgsWave free selection", ags_wave_test_free_selection) == NULL) ||
      (CU_add_test(pSuite, "test of AgsWave add region to selection", ags_wave_test_add_region_to_selection) == NULL) ||
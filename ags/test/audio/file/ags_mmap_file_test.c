@@ -0,0 +1,481 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <glib-object.h>
+
+#include <CUnit/CUnit.h>
+#include <CUnit/Automated.h>
+#include <CUnit/Basic.h>
+
+#include <ags/libags.h>
+#include <ags/libags-audio.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+int ags_mmap_file_test_init_suite();
+int ags_mmap_file_test_clean_suite();
+
+void ags_mmap_file_test_parse_wav();
+void ags_mmap_file_test_parse_rf64();
+void ags_mmap_file_test_parse_aiff();
+void ags_mmap_file_test_read_wave_resample();
+
+#define AGS_MMAP_FILE_TEST_SAMPLERATE (44100)
+#define AGS_MMAP_FILE_TEST_AUDIO_CHANNELS (2)
+#define AGS_MMAP_FILE_TEST_FRAME_COUNT (1024)
+
+gchar *ags_mmap_file_test_filename = NULL;
+
+gsize ags_mmap_file_test_create_wav(guchar *contents,
+				    gboolean is_rf64);
+gsize ags_mmap_file_test_create_aiff(guchar *contents);
+
+gboolean ags_mmap_file_test_open(guchar *contents, gsize length,
+				 guint64 *frame_count);
+
+/* The suite initialization function.
+ * Opens the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_mmap_file_test_init_suite()
+{
+  ags_mmap_file_test_filename = g_build_filename(g_get_tmp_dir(),
+						 "ags_mmap_file_test",
+						 NULL);
+
+  return(0);
+}
+
+/* The suite cleanup function.
+ * Closes the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_mmap_file_test_clean_suite()
+{
+  g_unlink(ags_mmap_file_test_filename);
+
+  g_free(ags_mmap_file_test_filename);
+
+  return(0);
+}
+
+gsize
+ags_mmap_file_test_create_wav(guchar *contents,
+			      gboolean is_rf64)
+{
+  guint32 value32;
+  guint16 value16;
+  guint64 value64;
+  gsize offset;
+
+  /* 16 bit stereo, the header fields are copied since they aren't aligned */
+  memcpy(contents, ((is_rf64) ? "RF64": "RIFF"), 4);
+  memcpy(contents + 8, "WAVE", 4);
+
+  offset = 12;
+
+  if(is_rf64){
+    memcpy(contents + offset, "ds64", 4);
+
+    value32 = GUINT32_TO_LE(28);
+    memcpy(contents + offset + 4, &value32, 4);
+
+    memset(contents + offset + 8, 0, 28);
+
+    value64 = GUINT64_TO_LE(4 * AGS_MMAP_FILE_TEST_FRAME_COUNT);
+    memcpy(contents + offset + 16, &value64, 8);
+
+    offset += 36;
+  }
+
+  memcpy(contents + offset, "fmt ", 4);
+
+  value32 = GUINT32_TO_LE(16);
+  memcpy(contents + offset + 4, &value32, 4);
+
+  value16 = GUINT16_TO_LE(1);
+  memcpy(contents + offset + 8, &value16, 2);
+
+  value16 = GUINT16_TO_LE(AGS_MMAP_FILE_TEST_AUDIO_CHANNELS);
+  memcpy(contents + offset + 10, &value16, 2);
+
+  value32 = GUINT32_TO_LE(AGS_MMAP_FILE_TEST_SAMPLERATE);
+  memcpy(contents + offset + 12, &value32, 4);
+
+  value32 = GUINT32_TO_LE(4 * AGS_MMAP_FILE_TEST_SAMPLERATE);
+  memcpy(contents + offset + 16, &value32, 4);
+
+  value16 = GUINT16_TO_LE(4);
+  memcpy(contents + offset + 20, &value16, 2);
+
+  value16 = GUINT16_TO_LE(16);
+  memcpy(contents + offset + 22, &value16, 2);
+
+  offset += 24;
+
+  memcpy(contents + offset, "data", 4);
+
+  value32 = GUINT32_TO_LE(((is_rf64) ? 0xffffffff: 4 * AGS_MMAP_FILE_TEST_FRAME_COUNT));
+  memcpy(contents + offset + 4, &value32, 4);
+
+  offset += 8 + 4 * AGS_MMAP_FILE_TEST_FRAME_COUNT;
+
+  value32 = GUINT32_TO_LE(offset - 8);
+  memcpy(contents + 4, &value32, 4);
+
+  return(offset);
+}
+
+gsize
+ags_mmap_file_test_create_aiff(guchar *contents)
+{
+  guint32 value32;
+  guint16 value16;
+
+  /* 16 bit stereo, 80 bit extended samplerate of 44100 */
+  static const guchar samplerate[10] = {
+    0x40, 0x0e, 0xac, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  };
+
+  memcpy(contents, "FORM", 4);
+  memcpy(contents + 8, "AIFF", 4);
+
+  memcpy(contents + 12, "COMM", 4);
+
+  value32 = GUINT32_TO_BE(18);
+  memcpy(contents + 16, &value32, 4);
+
+  value16 = GUINT16_TO_BE(AGS_MMAP_FILE_TEST_AUDIO_CHANNELS);
+  memcpy(contents + 20, &value16, 2);
+
+  value32 = GUINT32_TO_BE(AGS_MMAP_FILE_TEST_FRAME_COUNT);
+  memcpy(contents + 22, &value32, 4);
+
+  value16 = GUINT16_TO_BE(16);
+  memcpy(contents + 26, &value16, 2);
+
+  memcpy(contents + 28, samplerate, 10);
+
+  memcpy(contents + 38, "SSND", 4);
+
+  value32 = GUINT32_TO_BE(8 + 4 * AGS_MMAP_FILE_TEST_FRAME_COUNT);
+  memcpy(contents + 42, &value32, 4);
+
+  memset(contents + 46, 0, 8);
+
+  value32 = GUINT32_TO_BE(54 + 4 * AGS_MMAP_FILE_TEST_FRAME_COUNT - 8);
+  memcpy(contents + 4, &value32, 4);
+
+  return(54 + 4 * AGS_MMAP_FILE_TEST_FRAME_COUNT);
+}
+
+gboolean
+ags_mmap_file_test_open(guchar *contents, gsize length,
+			guint64 *frame_count)
+{
+  AgsMmapFile *mmap_file;
+
+  gboolean success;
+
+  if(!g_file_set_contents(ags_mmap_file_test_filename,
+			  (gchar *) contents, length,
+			  NULL)){
+    return(FALSE);
+  }
+
+  mmap_file = ags_mmap_file_new();
+
+  success = ags_sound_resource_open(AGS_SOUND_RESOURCE(mmap_file),
+				    ags_mmap_file_test_filename);
+
+  if(success){
+    CU_ASSERT(mmap_file->audio_channels == AGS_MMAP_FILE_TEST_AUDIO_CHANNELS);
+    CU_ASSERT(mmap_file->samplerate == AGS_MMAP_FILE_TEST_SAMPLERATE);
+    CU_ASSERT(mmap_file->format == AGS_SOUNDCARD_SIGNED_16_BIT);
+
+    frame_count[0] = mmap_file->frame_count;
+
+    ags_sound_resource_close(AGS_SOUND_RESOURCE(mmap_file));
+  }
+
+  g_object_unref(mmap_file);
+
+  return(success);
+}
+
+void
+ags_mmap_file_test_parse_wav()
+{
+  guchar *contents;
+
+  guint64 frame_count;
+  gsize length;
+  gsize i;
+
+  contents = (guchar *) g_malloc0(1024 + 4 * AGS_MMAP_FILE_TEST_FRAME_COUNT);
+
+  length = ags_mmap_file_test_create_wav(contents,
+					 FALSE);
+
+  frame_count = 0;
+
+  CU_ASSERT(ags_mmap_file_test_open(contents, length,
+				    &frame_count) == TRUE);
+  CU_ASSERT(frame_count == AGS_MMAP_FILE_TEST_FRAME_COUNT);
+
+  /* truncated input is rejected */
+  CU_ASSERT(ags_mmap_file_test_open(contents, length - 1,
+				    &frame_count) == FALSE);
+
+  for(i = 0; i < 64; i++){
+    CU_ASSERT(ags_mmap_file_test_open(contents, i,
+				      &frame_count) == FALSE);
+  }
+
+  g_free(contents);
+}
+
+void
+ags_mmap_file_test_parse_rf64()
+{
+  guchar *contents;
+
+  guint64 frame_count;
+  gsize length;
+  gsize i;
+
+  contents = (guchar *) g_malloc0(1024 + 4 * AGS_MMAP_FILE_TEST_FRAME_COUNT);
+
+  length = ags_mmap_file_test_create_wav(contents,
+					 TRUE);
+
+  frame_count = 0;
+
+  /* the data size is taken from ds64 */
+  CU_ASSERT(ags_mmap_file_test_open(contents, length,
+				    &frame_count) == TRUE);
+  CU_ASSERT(frame_count == AGS_MMAP_FILE_TEST_FRAME_COUNT);
+
+  /* truncated input is rejected */
+  CU_ASSERT(ags_mmap_file_test_open(contents, length - 1,
+				    &frame_count) == FALSE);
+
+  for(i = 0; i < 100; i++){
+    CU_ASSERT(ags_mmap_file_test_open(contents, i,
+				      &frame_count) == FALSE);
+  }
+
+  g_free(contents);
+}
+
+void
+ags_mmap_file_test_parse_aiff()
+{
+  guchar *contents;
+
+  guint64 frame_count;
+  gsize length;
+  gsize i;
+
+  contents = (guchar *) g_malloc0(1024 + 4 * AGS_MMAP_FILE_TEST_FRAME_COUNT);
+
+  length = ags_mmap_file_test_create_aiff(contents);
+
+  frame_count = 0;
+
+  CU_ASSERT(ags_mmap_file_test_open(contents, length,
+				    &frame_count) == TRUE);
+  CU_ASSERT(frame_count == AGS_MMAP_FILE_TEST_FRAME_COUNT);
+
+  /* truncated input is rejected */
+  CU_ASSERT(ags_mmap_file_test_open(contents, length - 1,
+				    &frame_count) == FALSE);
+
+  for(i = 0; i < 64; i++){
+    CU_ASSERT(ags_mmap_file_test_open(contents, i,
+				      &frame_count) == FALSE);
+  }
+
+  g_free(contents);
+}
+
+void
+ags_mmap_file_test_read_wave_resample()
+{
+  AgsMmapFile *mmap_file;
+  
+  AgsConfig *config;
+
+  GList *start_wave, *wave;
+  GList *start_buffer, *buffer;
+  
+  guchar *contents;
+  gfloat *data;
+
+  gint16 value16;
+  guint32 value32;
+  guint target_samplerate, samplerate;
+  guint target_format;
+  guint expected_frame_count, frame_count;
+  gsize length;
+  gsize i;
+
+  config = ags_config_get_instance();
+
+  target_samplerate = ags_soundcard_helper_config_get_samplerate(config);
+  target_format = ags_soundcard_helper_config_get_format(config);
+
+  samplerate = target_samplerate / 2;
+
+  contents = (guchar *) g_malloc0(1024 + 4 * AGS_MMAP_FILE_TEST_FRAME_COUNT);
+
+  length = ags_mmap_file_test_create_wav(contents,
+					 FALSE);
+
+  /* half the samplerate of the soundcard */
+  value32 = GUINT32_TO_LE(samplerate);
+  memcpy(contents + 24, &value32, 4);
+
+  value32 = GUINT32_TO_LE(4 * samplerate);
+  memcpy(contents + 28, &value32, 4);
+
+  /* constant signal of half amplitude */
+  value16 = GINT16_TO_LE(16384);
+  
+  for(i = 0; i < 2 * AGS_MMAP_FILE_TEST_FRAME_COUNT; i++){
+    memcpy(contents + 44 + 2 * i, &value16, 2);
+  }
+
+  CU_ASSERT(g_file_set_contents(ags_mmap_file_test_filename,
+				(gchar *) contents, length,
+				NULL) == TRUE);
+
+  mmap_file = ags_mmap_file_new();
+
+  CU_ASSERT(ags_sound_resource_open(AGS_SOUND_RESOURCE(mmap_file),
+				    ags_mmap_file_test_filename) == TRUE);
+
+  start_wave = ags_sound_resource_read_wave(AGS_SOUND_RESOURCE(mmap_file),
+					    NULL,
+					    0,
+					    0,
+					    0.0, 0);
+
+  CU_ASSERT(start_wave != NULL);
+
+  /* count the frames carrying the signal, the filter tail is flushed at end of file */
+  expected_frame_count = (guint) ceil((double) AGS_MMAP_FILE_TEST_FRAME_COUNT / (double) samplerate * (double) target_samplerate);
+
+  frame_count = 0;
+  
+  wave = start_wave;
+
+  while(wave != NULL){
+    start_buffer = ags_wave_get_buffer(wave->data);
+
+    buffer = start_buffer;
+
+    while(buffer != NULL){
+      guint buffer_size;
+
+      buffer_size = ags_buffer_get_buffer_size(buffer->data);
+
+      data = (gfloat *) g_malloc0(buffer_size * sizeof(gfloat));
+
+      ags_audio_buffer_util_copy_buffer_to_buffer(data, 1, 0,
+						  ags_buffer_get_data(buffer->data), 1, 0,
+						  buffer_size, ags_audio_buffer_util_get_copy_mode(AGS_AUDIO_BUFFER_UTIL_FLOAT,
+												   ags_audio_buffer_util_format_from_soundcard(target_format)));
+
+      for(i = 0; i < buffer_size; i++){
+	if(data[i] > 0.25){
+	  frame_count++;
+	}
+      }
+
+      g_free(data);
+      
+      buffer = buffer->next;
+    }
+
+    g_list_free_full(start_buffer,
+		     g_object_unref);
+    
+    wave = wave->next;
+  }
+
+  CU_ASSERT(frame_count + 4 >= expected_frame_count &&
+	    frame_count <= expected_frame_count + 4);
+  
+  g_list_free_full(start_wave,
+		   g_object_unref);
+
+  ags_sound_resource_close(AGS_SOUND_RESOURCE(mmap_file));
+
+  g_object_unref(mmap_file);
+  
+  g_free(contents);
+}
+
+int
+main(int argc, char **argv)
+{
+  CU_pSuite pSuite = NULL;
+
+  putenv("LC_ALL=C");
+  putenv("LANG=C");
+
+  /* initialize the CUnit test registry */
+  if(CUE_SUCCESS != CU_initialize_registry()){
+    return CU_get_error();
+  }
+
+  /* add a suite to the registry */
+  pSuite = CU_add_suite("AgsMmapFileTest", ags_mmap_file_test_init_suite, ags_mmap_file_test_clean_suite);
+
+  if(pSuite == NULL){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* add the tests to the suite */
+  if((CU_add_test(pSuite, "test of AgsMmapFile parse WAV", ags_mmap_file_test_parse_wav) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsMmapFile parse RF64", ags_mmap_file_test_parse_rf64) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsMmapFile parse AIFF", ags_mmap_file_test_parse_aiff) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsMmapFile read wave resample", ags_mmap_file_test_read_wave_resample) == NULL)){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* Run all tests using the CUnit Basic interface */
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+  CU_basic_run_tests();
+
+  CU_cleanup_registry();
+
+  return(CU_get_error());
+}
@@ -0,0 +1,282 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <glib-object.h>
+
+#include <CUnit/CUnit.h>
+#include <CUnit/Automated.h>
+#include <CUnit/Basic.h>
+
+#include <ags/libags.h>
+#include <ags/libags-audio.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <sndfile.h>
+
+int ags_sndfile_test_init_suite();
+int ags_sndfile_test_clean_suite();
+
+void ags_sndfile_test_read_s8();
+void ags_sndfile_test_read_s24();
+void ags_sndfile_test_read_s32();
+
+#define AGS_SNDFILE_TEST_SAMPLERATE (44100)
+#define AGS_SNDFILE_TEST_AUDIO_CHANNELS (2)
+#define AGS_SNDFILE_TEST_FRAME_COUNT (1024)
+
+gchar *ags_sndfile_test_filename = NULL;
+
+gint32 ags_sndfile_test_sample(guint frame, guint audio_channel,
+			       guint bits);
+void ags_sndfile_test_round_trip(gint sf_format, guint format,
+				 guint bits);
+
+/* The suite initialization function.
+ * Opens the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_sndfile_test_init_suite()
+{
+  ags_sndfile_test_filename = g_build_filename(g_get_tmp_dir(),
+					       "ags_sndfile_test.aiff",
+					       NULL);
+
+  return(0);
+}
+
+/* The suite cleanup function.
+ * Closes the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_sndfile_test_clean_suite()
+{
+  g_unlink(ags_sndfile_test_filename);
+
+  g_free(ags_sndfile_test_filename);
+
+  return(0);
+}
+
+gint32
+ags_sndfile_test_sample(guint frame, guint audio_channel,
+			guint bits)
+{
+  gint32 max_value;
+  gint32 value;
+
+  /* full scale ramp, the second channel inverted */
+  max_value = (gint32) ((G_GUINT64_CONSTANT(1) << (bits - 1)) - 1);
+
+  value = (gint32) (((gint64) 2 * max_value * frame) / (AGS_SNDFILE_TEST_FRAME_COUNT - 1) - max_value);
+
+  if(audio_channel == 1){
+    value = -value;
+  }
+  
+  return(value);
+}
+
+void
+ags_sndfile_test_round_trip(gint sf_format, guint format,
+			    guint bits)
+{
+  AgsSndfile *sndfile;
+
+  SNDFILE *file;
+  SF_INFO info;
+
+  void *dbuffer[AGS_SNDFILE_TEST_AUDIO_CHANNELS];
+  int *data;
+
+  gint32 value;
+  guint word_size;
+  guint i, j;
+  gboolean success;
+
+  /* write left aligned samples with libsndfile */
+  memset(&info, 0, sizeof(SF_INFO));
+  
+  info.samplerate = AGS_SNDFILE_TEST_SAMPLERATE;
+  info.channels = AGS_SNDFILE_TEST_AUDIO_CHANNELS;
+  info.format = SF_FORMAT_AIFF | sf_format;
+
+  file = sf_open(ags_sndfile_test_filename, SFM_WRITE, &info);
+
+  CU_ASSERT(file != NULL);
+
+  if(file == NULL){
+    return;
+  }
+
+  data = (int *) g_malloc(AGS_SNDFILE_TEST_AUDIO_CHANNELS * AGS_SNDFILE_TEST_FRAME_COUNT * sizeof(int));
+  
+  for(i = 0; i < AGS_SNDFILE_TEST_FRAME_COUNT; i++){
+    for(j = 0; j < AGS_SNDFILE_TEST_AUDIO_CHANNELS; j++){
+      data[AGS_SNDFILE_TEST_AUDIO_CHANNELS * i + j] = (int) ((guint32) ags_sndfile_test_sample(i, j, bits) << (32 - bits));
+    }
+  }
+  
+  CU_ASSERT(sf_write_int(file, data, AGS_SNDFILE_TEST_AUDIO_CHANNELS * AGS_SNDFILE_TEST_FRAME_COUNT) == AGS_SNDFILE_TEST_AUDIO_CHANNELS * AGS_SNDFILE_TEST_FRAME_COUNT);
+
+  sf_close(file);
+
+  g_free(data);
+
+  /* read back */
+  sndfile = ags_sndfile_new();
+
+  success = ags_sound_resource_open(AGS_SOUND_RESOURCE(sndfile),
+				    ags_sndfile_test_filename);
+
+  CU_ASSERT(success == TRUE);
+
+  if(!success){
+    g_object_unref(sndfile);
+
+    return;
+  }
+  
+  CU_ASSERT(sndfile->format == format);
+
+  word_size = (bits == 8) ? 1: 4;
+
+  for(j = 0; j < AGS_SNDFILE_TEST_AUDIO_CHANNELS; j++){
+    dbuffer[j] = g_malloc0(AGS_SNDFILE_TEST_FRAME_COUNT * word_size);
+  }
+
+  /* single channel */
+  CU_ASSERT(ags_sound_resource_read(AGS_SOUND_RESOURCE(sndfile),
+				    dbuffer[1], 1,
+				    1,
+				    AGS_SNDFILE_TEST_FRAME_COUNT, format) == AGS_SNDFILE_TEST_FRAME_COUNT);
+
+  success = TRUE;
+  
+  for(i = 0; i < AGS_SNDFILE_TEST_FRAME_COUNT; i++){
+    value = (bits == 8) ? ((gint8 *) dbuffer[1])[i]: ((gint32 *) dbuffer[1])[i];
+    
+    if(value != ags_sndfile_test_sample(i, 1, bits)){
+      success = FALSE;
+
+      break;
+    }
+  }
+
+  CU_ASSERT(success == TRUE);
+
+  /* all channels */
+  ags_sound_resource_seek(AGS_SOUND_RESOURCE(sndfile),
+			  0, G_SEEK_SET);
+
+  CU_ASSERT(ags_sound_resource_read_channels(AGS_SOUND_RESOURCE(sndfile),
+					     dbuffer,
+					     AGS_SNDFILE_TEST_FRAME_COUNT, format) == AGS_SNDFILE_TEST_FRAME_COUNT);
+
+  success = TRUE;
+  
+  for(i = 0; i < AGS_SNDFILE_TEST_FRAME_COUNT; i++){
+    for(j = 0; j < AGS_SNDFILE_TEST_AUDIO_CHANNELS; j++){
+      value = (bits == 8) ? ((gint8 *) dbuffer[j])[i]: ((gint32 *) dbuffer[j])[i];
+    
+      if(value != ags_sndfile_test_sample(i, j, bits)){
+	success = FALSE;
+      }
+    }
+  }
+
+  CU_ASSERT(success == TRUE);
+
+  for(j = 0; j < AGS_SNDFILE_TEST_AUDIO_CHANNELS; j++){
+    g_free(dbuffer[j]);
+  }
+  
+  ags_sound_resource_close(AGS_SOUND_RESOURCE(sndfile));
+
+  g_object_unref(sndfile);
+}
+
+void
+ags_sndfile_test_read_s8()
+{
+  /* sf_read_raw() */
+  ags_sndfile_test_round_trip(SF_FORMAT_PCM_S8, AGS_SOUNDCARD_SIGNED_8_BIT,
+			      8);
+}
+
+void
+ags_sndfile_test_read_s24()
+{
+  /* sf_read_int() shifted right by 8 bits */
+  ags_sndfile_test_round_trip(SF_FORMAT_PCM_24, AGS_SOUNDCARD_SIGNED_24_BIT,
+			      24);
+}
+
+void
+ags_sndfile_test_read_s32()
+{
+  /* sf_read_int() */
+  ags_sndfile_test_round_trip(SF_FORMAT_PCM_32, AGS_SOUNDCARD_SIGNED_32_BIT,
+			      32);
+}
+
+int
+main(int argc, char **argv)
+{
+  CU_pSuite pSuite = NULL;
+
+  putenv("LC_ALL=C");
+  putenv("LANG=C");
+
+  /* initialize the CUnit test registry */
+  if(CUE_SUCCESS != CU_initialize_registry()){
+    return CU_get_error();
+  }
+
+  /* add a suite to the registry */
+  pSuite = CU_add_suite("AgsSndfileTest", ags_sndfile_test_init_suite, ags_sndfile_test_clean_suite);
+
+  if(pSuite == NULL){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* add the tests to the suite */
+  if((CU_add_test(pSuite, "test of AgsSndfile read signed 8 bit", ags_sndfile_test_read_s8) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsSndfile read signed 24 bit", ags_sndfile_test_read_s24) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsSndfile read signed 32 bit", ags_sndfile_test_read_s32) == NULL)){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* Run all tests using the CUnit Basic interface */
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+  CU_basic_run_tests();
+
+  CU_cleanup_registry();
+
+  return(CU_get_error());
+}
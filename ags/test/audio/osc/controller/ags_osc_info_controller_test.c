@@ -35,6 +35,8 @@ int ags_osc_info_controller_test_init_suite();
 int ags_osc_info_controller_test_clean_suite();
 
 void ags_osc_info_controller_test_get_info();
+void ags_osc_info_controller_test_get_rt_sanitizer_report();
+void ags_osc_info_controller_test_get_dsp_load_report();
 
 #define AGS_OSC_INFO_CONTROLLER_TEST_CONFIG "[generic]\n" \
   "autosave-thread=false\n"			       \
@@ -129,6 +131,87 @@ ags_osc_info_controller_test_get_info()
   CU_ASSERT(osc_response != NULL);
 }
 
+void
+ags_osc_info_controller_test_get_rt_sanitizer_report()
+{  
+  AgsOscConnection *osc_connection;
+
+  AgsOscInfoController *osc_info_controller;
+
+  GList *osc_response;
+
+  guchar *packet;
+
+  static const unsigned char *info_message = "/info\x00\x00\x00,s\x00\x00rt-sanitizer\x00\x00\x00\x00";
+
+  static const guint info_message_size = 28;
+
+  osc_connection = ags_osc_connection_new(NULL);
+  
+  osc_info_controller = ags_osc_info_controller_new();
+
+  osc_response = ags_osc_info_controller_get_info(osc_info_controller,
+						  osc_connection,
+						  info_message, info_message_size);
+
+  CU_ASSERT(osc_response != NULL);
+
+  packet = NULL;
+  
+  g_object_get(osc_response->data,
+	       "packet", &packet,
+	       NULL);
+
+  CU_ASSERT(packet != NULL);
+
+  if(packet != NULL){
+    CU_ASSERT(!strncmp(packet + 4, "/info", 6));
+    CU_ASSERT(!strncmp(packet + 12, ",sis", 5));
+    CU_ASSERT(!strncmp(packet + 20, AGS_OSC_INFO_CONTROLLER_RT_SANITIZER, 13));
+  }
+}
+
+void
+ags_osc_info_controller_test_get_dsp_load_report()
+{  
+  AgsOscConnection *osc_connection;
+
+  AgsOscInfoController *osc_info_controller;
+
+  GList *osc_response;
+
+  guchar *packet;
+
+  static const unsigned char *info_message = "/info\x00\x00\x00,s\x00\x00dsp-load\x00\x00\x00\x00";
+
+  static const guint info_message_size = 24;
+
+  osc_connection = ags_osc_connection_new(NULL);
+  
+  osc_info_controller = ags_osc_info_controller_new();
+
+  osc_response = ags_osc_info_controller_get_info(osc_info_controller,
+						  osc_connection,
+						  info_message, info_message_size);
+
+  CU_ASSERT(osc_response != NULL);
+
+  packet = NULL;
+  
+  g_object_get(osc_response->data,
+	       "packet", &packet,
+	       NULL);
+
+  CU_ASSERT(packet != NULL);
+
+  if(packet != NULL){
+    CU_ASSERT(!strncmp(packet + 4, "/info", 6));
+    CU_ASSERT(!strncmp(packet + 12, ",ss", 4));
+    CU_ASSERT(!strncmp(packet + 16, AGS_OSC_INFO_CONTROLLER_DSP_LOAD, 9));
+    CU_ASSERT(!strncmp(packet + 28, AGS_RECALL_LOAD_UTIL_REPORT_HEADER, strlen(AGS_RECALL_LOAD_UTIL_REPORT_HEADER)));
+  }
+}
+
 int
 main(int argc, char **argv)
 {
@@ -156,7 +239,9 @@ main(int argc, char **argv)
   }
 
   /* add the tests to the suite */
-  if((CU_add_test(pSuite, "test of AgsOscInfoController get info", ags_osc_info_controller_test_get_info) == NULL)){
+  if((CU_add_test(pSuite, "test of AgsOscInfoController get info", ags_osc_info_controller_test_get_info) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsOscInfoController get rt sanitizer report", ags_osc_info_controller_test_get_rt_sanitizer_report) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsOscInfoController get DSP load report", ags_osc_info_controller_test_get_dsp_load_report) == NULL)){
     CU_cleanup_registry();
     
     return CU_get_error();
@@ -36,6 +36,7 @@ void ags_apply_synth_test_launch();
 
 #define AGS_APPLY_SYNTH_TEST_BASE_NOTE (0.0)
 #define AGS_APPLY_SYNTH_TEST_INPUT_PADS (88)
+#define AGS_APPLY_SYNTH_TEST_FRAME_COUNT (4096)
 
 /* The suite initialization function.
  * Opens the temporary file used by the tests.
@@ -62,9 +63,19 @@ ags_apply_synth_test_launch()
 {
   AgsDevout *devout;
   AgsAudio *audio;
+  AgsChannel *channel;
+  AgsRecycling *first_recycling;
+  AgsAudioSignal *template;
   AgsSynthGenerator *synth_generator;
   
   AgsApplySynth *apply_synth;
+
+  AgsFuture *render_future;
+
+  GList *list_start;
+
+  guint i;
+  gboolean success;
   
   AgsApplicationContext *application_context;
   
@@ -96,6 +107,9 @@ ags_apply_synth_test_launch()
 		     AGS_APPLY_SYNTH_TEST_INPUT_PADS, 0);
 
   synth_generator = ags_synth_generator_new();
+  g_object_set(synth_generator,
+	       "frame-count", AGS_APPLY_SYNTH_TEST_FRAME_COUNT,
+	       NULL);
 
   apply_synth = ags_apply_synth_new(synth_generator,
 				    audio->input,
@@ -108,6 +122,47 @@ ags_apply_synth_test_launch()
 
   /* test */
   ags_task_launch(apply_synth);
+
+  /* every key got its render job */
+  channel = audio->input;
+
+  success = TRUE;
+  
+  for(i = 0; channel != NULL && i < AGS_APPLY_SYNTH_TEST_INPUT_PADS; i++){
+    g_object_get(channel,
+		 "first-recycling", &first_recycling,
+		 NULL);
+
+    g_object_get(first_recycling,
+		 "audio-signal", &list_start,
+		 NULL);
+
+    template = ags_audio_signal_get_template(list_start);
+
+    render_future = ags_audio_signal_get_render_future(template);
+
+    if(render_future == NULL){
+      success = FALSE;
+    }else{
+      ags_future_wait(render_future);
+
+      if(template->stream == NULL){
+	success = FALSE;
+      }
+      
+      ags_future_unref(render_future);
+    }
+
+    g_list_free_full(list_start,
+		     g_object_unref);
+
+    g_object_unref(template);
+    g_object_unref(first_recycling);
+
+    channel = channel->next;
+  }
+
+  CU_ASSERT(success == TRUE);
 }
 
 int
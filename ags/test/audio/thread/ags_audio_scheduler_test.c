@@ -0,0 +1,255 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <CUnit/CUnit.h>
+#include <CUnit/Automated.h>
+#include <CUnit/Basic.h>
+
+#include <ags/libags.h>
+#include <ags/libags-audio.h>
+
+#include <stdlib.h>
+
+int ags_audio_scheduler_test_init_suite();
+int ags_audio_scheduler_test_clean_suite();
+
+void ags_audio_scheduler_test_rebuild();
+void ags_audio_scheduler_test_topology_changed();
+void ags_audio_scheduler_test_run();
+
+AgsAudio* ags_audio_scheduler_test_create_audio();
+
+#define AGS_AUDIO_SCHEDULER_TEST_AUDIO_CHANNELS (2)
+#define AGS_AUDIO_SCHEDULER_TEST_INPUT_PADS (1)
+#define AGS_AUDIO_SCHEDULER_TEST_OUTPUT_PADS (1)
+
+AgsDevout *devout;
+
+AgsAudio *master;
+AgsAudio *slave;
+AgsAudio *solo;
+
+GList *start_audio;
+
+/* The suite initialization function.
+ * Opens the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_audio_scheduler_test_init_suite()
+{
+  AgsChannel *channel, *link;
+
+  GError *error;
+
+  guint i;
+  
+  devout = ags_devout_new(NULL);
+  g_object_ref(devout);
+
+  master = ags_audio_scheduler_test_create_audio();
+  slave = ags_audio_scheduler_test_create_audio();
+  solo = ags_audio_scheduler_test_create_audio();
+
+  /* slave feeds master */
+  channel = master->input;
+  link = slave->output;
+
+  for(i = 0; i < AGS_AUDIO_SCHEDULER_TEST_AUDIO_CHANNELS; i++){
+    error = NULL;
+    ags_channel_set_link(channel, link,
+			 &error);
+
+    channel = channel->next;
+    link = link->next;
+  }
+
+  start_audio = NULL;
+  start_audio = g_list_prepend(start_audio,
+			       solo);
+  start_audio = g_list_prepend(start_audio,
+			       slave);
+  start_audio = g_list_prepend(start_audio,
+			       master);
+  
+  return(0);
+}
+
+/* The suite cleanup function.
+ * Closes the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_audio_scheduler_test_clean_suite()
+{
+  g_list_free(start_audio);
+  
+  g_object_unref(devout);
+
+  return(0);
+}
+
+AgsAudio*
+ags_audio_scheduler_test_create_audio()
+{
+  AgsAudio *audio;
+
+  audio = ags_audio_new(devout);
+  audio->flags |= (AGS_AUDIO_OUTPUT_HAS_RECYCLING |
+		   AGS_AUDIO_ASYNC);
+  
+  ags_audio_set_audio_channels(audio,
+			       AGS_AUDIO_SCHEDULER_TEST_AUDIO_CHANNELS, 0);
+  
+  ags_audio_set_pads(audio,
+		     AGS_TYPE_INPUT,
+		     AGS_AUDIO_SCHEDULER_TEST_INPUT_PADS, 0);
+  ags_audio_set_pads(audio,
+		     AGS_TYPE_OUTPUT,
+		     AGS_AUDIO_SCHEDULER_TEST_OUTPUT_PADS, 0);
+
+  return(audio);
+}
+
+void
+ags_audio_scheduler_test_rebuild()
+{
+  AgsAudioScheduler *audio_scheduler;
+
+  audio_scheduler = ags_audio_scheduler_new();
+
+  ags_audio_scheduler_rebuild(audio_scheduler,
+			      start_audio);
+
+  CU_ASSERT(audio_scheduler->node_count == 3);
+
+  /* master depends on slave */
+  CU_ASSERT(audio_scheduler->node[0]->audio == (GObject *) master);
+  CU_ASSERT(audio_scheduler->node[0]->dependency_count == 1);
+  CU_ASSERT(audio_scheduler->node[0]->successor_count == 0);
+
+  CU_ASSERT(audio_scheduler->node[1]->audio == (GObject *) slave);
+  CU_ASSERT(audio_scheduler->node[1]->dependency_count == 0);
+  CU_ASSERT(audio_scheduler->node[1]->successor_count == 1);
+  CU_ASSERT(audio_scheduler->node[1]->successor[0] == audio_scheduler->node[0]);
+
+  /* solo is independent */
+  CU_ASSERT(audio_scheduler->node[2]->dependency_count == 0);
+  CU_ASSERT(audio_scheduler->node[2]->successor_count == 0);
+
+  g_object_unref(audio_scheduler);
+}
+
+void
+ags_audio_scheduler_test_topology_changed()
+{
+  AgsAudioScheduler *audio_scheduler;
+
+  guint generation;
+
+  audio_scheduler = ags_audio_scheduler_new();
+
+  generation = audio_scheduler->topology_generation;
+
+  ags_audio_scheduler_topology_changed(audio_scheduler);
+
+  CU_ASSERT(audio_scheduler->topology_generation == generation + 1);
+
+  g_object_unref(audio_scheduler);
+}
+
+void
+ags_audio_scheduler_test_run()
+{
+  AgsAudioScheduler *audio_scheduler;
+
+  guint staging_program[] = {
+    AGS_SOUND_STAGING_RUN_PRE,
+    AGS_SOUND_STAGING_RUN_INTER,
+    AGS_SOUND_STAGING_RUN_POST,
+  };
+  guint i;
+  
+  audio_scheduler = ags_audio_scheduler_new();
+  g_object_set(audio_scheduler,
+	       "worker-count", 4,
+	       NULL);
+
+  /* no scope is playing, every node completes anyway */
+  for(i = 0; i < 16; i++){
+    ags_audio_scheduler_run(audio_scheduler,
+			    start_audio,
+			    staging_program, 3);
+
+    CU_ASSERT(audio_scheduler->remaining == 0);
+    CU_ASSERT(audio_scheduler->active == 0);
+  }
+
+  CU_ASSERT(ags_audio_scheduler_test_flags(audio_scheduler, AGS_AUDIO_SCHEDULER_RUNNING));
+  
+  ags_audio_scheduler_stop(audio_scheduler);
+
+  CU_ASSERT(!ags_audio_scheduler_test_flags(audio_scheduler, AGS_AUDIO_SCHEDULER_RUNNING));
+  
+  g_object_unref(audio_scheduler);
+}
+
+int
+main(int argc, char **argv)
+{
+  CU_pSuite pSuite = NULL;
+
+  putenv("LC_ALL=C");
+  putenv("LANG=C");
+
+  /* initialize the CUnit test registry */
+  if(CUE_SUCCESS != CU_initialize_registry()){
+    return CU_get_error();
+  }
+
+  /* add a suite to the registry */
+  pSuite = CU_add_suite("AgsAudioSchedulerTest", ags_audio_scheduler_test_init_suite, ags_audio_scheduler_test_clean_suite);
+
+  if(pSuite == NULL){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* add the tests to the suite */
+  if((CU_add_test(pSuite, "test of AgsAudioScheduler rebuild", ags_audio_scheduler_test_rebuild) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsAudioScheduler topology changed", ags_audio_scheduler_test_topology_changed) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsAudioScheduler run", ags_audio_scheduler_test_run) == NULL)){
+    CU_cleanup_registry();
+
+    return CU_get_error();
+  }
+
+  /* Run all tests using the CUnit Basic interface */
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+  CU_basic_run_tests();
+
+  CU_cleanup_registry();
+
+  return(CU_get_error());
+}
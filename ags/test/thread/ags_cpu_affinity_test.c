@@ -0,0 +1,232 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <CUnit/CUnit.h>
+#include <CUnit/Basic.h>
+
+#include <ags/libags.h>
+
+int ags_cpu_affinity_test_init_suite();
+int ags_cpu_affinity_test_clean_suite();
+
+void ags_cpu_affinity_test_parse_cpu_list();
+void ags_cpu_affinity_test_auto_place();
+void ags_cpu_affinity_test_set_cpu();
+
+/* The suite initialization function.
+ * Opens the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_cpu_affinity_test_init_suite()
+{    
+  return(0);
+}
+
+/* The suite cleanup function.
+ * Closes the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_cpu_affinity_test_clean_suite()
+{
+  
+  return(0);
+}
+
+void
+ags_cpu_affinity_test_parse_cpu_list()
+{
+  guint *cpu;
+
+  guint cpu_count;
+
+  /* ranges and single CPUs */
+  cpu = ags_cpu_affinity_parse_cpu_list("0-2, 5,7-8\n",
+					&cpu_count);
+
+  CU_ASSERT(cpu != NULL);
+  CU_ASSERT(cpu_count == 6);
+
+  if(cpu != NULL &&
+     cpu_count == 6){
+    CU_ASSERT(cpu[0] == 0);
+    CU_ASSERT(cpu[2] == 2);
+    CU_ASSERT(cpu[3] == 5);
+    CU_ASSERT(cpu[5] == 8);
+  }
+
+  g_free(cpu);
+
+  /* duplicates */
+  cpu = ags_cpu_affinity_parse_cpu_list("3,1-3",
+					&cpu_count);
+
+  CU_ASSERT(cpu != NULL);
+  CU_ASSERT(cpu_count == 3);
+
+  g_free(cpu);
+
+  /* empty and malformed */
+  CU_ASSERT(ags_cpu_affinity_parse_cpu_list("\n", &cpu_count) == NULL);
+  CU_ASSERT(cpu_count == 0);
+  
+  CU_ASSERT(ags_cpu_affinity_parse_cpu_list("auto", &cpu_count) == NULL);
+  CU_ASSERT(ags_cpu_affinity_parse_cpu_list("4-2", &cpu_count) == NULL);
+  CU_ASSERT(ags_cpu_affinity_parse_cpu_list("1-", &cpu_count) == NULL);
+  CU_ASSERT(ags_cpu_affinity_parse_cpu_list(NULL, &cpu_count) == NULL);
+}
+
+void
+ags_cpu_affinity_test_auto_place()
+{
+  guint online[] = {0, 1, 2, 3, 4, 5};
+  guint isolated[] = {3, 4, 5};
+  
+  guint *cpu;
+
+  guint cpu_count;
+
+  /* no isolated CPUs */
+  CU_ASSERT(ags_cpu_affinity_auto_place(AGS_CPU_AFFINITY_KEY_AUDIO_MAIN_LOOP,
+					online, 6,
+					NULL, 0,
+					0,
+					&cpu_count) == NULL);
+  CU_ASSERT(cpu_count == 0);
+
+  /* audio main loop */
+  cpu = ags_cpu_affinity_auto_place(AGS_CPU_AFFINITY_KEY_AUDIO_MAIN_LOOP,
+				    online, 6,
+				    isolated, 3,
+				    7,
+				    &cpu_count);
+
+  CU_ASSERT(cpu != NULL && cpu_count == 1 && cpu[0] == 3);
+
+  g_free(cpu);
+
+  /* round robin */
+  cpu = ags_cpu_affinity_auto_place(AGS_CPU_AFFINITY_KEY_SOUNDCARD,
+				    online, 6,
+				    isolated, 3,
+				    0,
+				    &cpu_count);
+
+  CU_ASSERT(cpu != NULL && cpu_count == 1 && cpu[0] == 4);
+
+  g_free(cpu);
+
+  cpu = ags_cpu_affinity_auto_place(AGS_CPU_AFFINITY_KEY_WORKER,
+				    online, 6,
+				    isolated, 3,
+				    3,
+				    &cpu_count);
+
+  CU_ASSERT(cpu != NULL && cpu_count == 1 && cpu[0] == 5);
+
+  g_free(cpu);
+
+  /* housekeeping */
+  cpu = ags_cpu_affinity_auto_place(AGS_CPU_AFFINITY_KEY_TASK_LAUNCHER,
+				    online, 6,
+				    isolated, 3,
+				    0,
+				    &cpu_count);
+
+  CU_ASSERT(cpu != NULL && cpu_count == 3);
+
+  if(cpu != NULL &&
+     cpu_count == 3){
+    CU_ASSERT(cpu[0] == 0 && cpu[1] == 1 && cpu[2] == 2);
+  }
+  
+  g_free(cpu);
+
+  cpu = ags_cpu_affinity_auto_place(AGS_CPU_AFFINITY_KEY_JOB_POOL,
+				    online, 6,
+				    isolated, 3,
+				    0,
+				    &cpu_count);
+
+  CU_ASSERT(cpu != NULL && cpu_count == 3);
+
+  g_free(cpu);
+}
+
+void
+ags_cpu_affinity_test_set_cpu()
+{
+  guint *online;
+
+  guint online_count;
+
+  online = ags_cpu_affinity_get_online(&online_count);
+
+  CU_ASSERT(online != NULL);
+  CU_ASSERT(online_count > 0);
+
+  CU_ASSERT(ags_cpu_affinity_set_cpu(NULL, 0) == FALSE);
+
+#if defined(__linux__)
+  CU_ASSERT(ags_cpu_affinity_set_cpu(online, online_count) == TRUE);
+#endif
+  
+  g_free(online);
+}
+
+int
+main(int argc, char **argv)
+{
+  CU_pSuite pSuite = NULL;
+
+  /* initialize the CUnit test registry */
+  if(CUE_SUCCESS != CU_initialize_registry()){
+    return CU_get_error();
+  }
+
+  /* add a suite to the registry */
+  pSuite = CU_add_suite("AgsCpuAffinityTest", ags_cpu_affinity_test_init_suite, ags_cpu_affinity_test_clean_suite);
+  
+  if(pSuite == NULL){
+    CU_cleanup_registry();
+    
+    return CU_get_error();
+  }
+
+  /* add the tests to the suite */
+  if((CU_add_test(pSuite, "test of ags_cpu_affinity.c parse cpu list", ags_cpu_affinity_test_parse_cpu_list) == NULL) ||
+     (CU_add_test(pSuite, "test of ags_cpu_affinity.c auto place", ags_cpu_affinity_test_auto_place) == NULL) ||
+     (CU_add_test(pSuite, "test of ags_cpu_affinity.c set cpu", ags_cpu_affinity_test_set_cpu) == NULL)){
+    CU_cleanup_registry();
+      
+    return CU_get_error();
+  }
+  
+  /* Run all tests using the CUnit Basic interface */
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+  CU_basic_run_tests();
+  
+  CU_cleanup_registry();
+  
+  return(CU_get_error());
+}
@@ -0,0 +1,189 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <CUnit/CUnit.h>
+#include <CUnit/Basic.h>
+
+#include <ags/libags.h>
+
+int ags_deadline_clock_test_init_suite();
+int ags_deadline_clock_test_clean_suite();
+
+void ags_deadline_clock_test_set_soundcard_period();
+void ags_deadline_clock_test_wait();
+void ags_deadline_clock_test_wait_missed();
+void ags_deadline_clock_test_period_wakeup();
+
+#define AGS_DEADLINE_CLOCK_TEST_PERIOD (2000000)
+
+/* The suite initialization function.
+ * Opens the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_deadline_clock_test_init_suite()
+{    
+  return(0);
+}
+
+/* The suite cleanup function.
+ * Closes the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_deadline_clock_test_clean_suite()
+{
+  
+  return(0);
+}
+
+void
+ags_deadline_clock_test_set_soundcard_period()
+{
+  AgsDeadlineClock *deadline_clock;
+
+  deadline_clock = ags_deadline_clock_alloc(0);
+
+  CU_ASSERT(ags_deadline_clock_get_period(deadline_clock) == AGS_DEADLINE_CLOCK_DEFAULT_PERIOD);
+
+  ags_deadline_clock_set_soundcard_period(deadline_clock,
+					  48000,
+					  128);
+
+  CU_ASSERT(ags_deadline_clock_get_period(deadline_clock) == 2666666);
+
+  ags_deadline_clock_free(deadline_clock);
+}
+
+void
+ags_deadline_clock_test_wait()
+{
+  AgsDeadlineClock *deadline_clock;
+
+  gint64 start_time, end_time;
+  guint i;
+  
+  deadline_clock = ags_deadline_clock_alloc(AGS_DEADLINE_CLOCK_TEST_PERIOD);
+
+  start_time = ags_deadline_clock_get_monotonic_time();
+  
+  ags_deadline_clock_start(deadline_clock);
+
+  for(i = 0; i < 4; i++){
+    CU_ASSERT(ags_deadline_clock_wait(deadline_clock) == 1);
+  }
+
+  end_time = ags_deadline_clock_get_monotonic_time();
+
+  /* never earlier than the absolute deadline */
+  CU_ASSERT(end_time - start_time >= 4 * AGS_DEADLINE_CLOCK_TEST_PERIOD);
+  CU_ASSERT(deadline_clock->missed_count == 0);
+
+  ags_deadline_clock_free(deadline_clock);
+}
+
+void
+ags_deadline_clock_test_wait_missed()
+{
+  AgsDeadlineClock *deadline_clock;
+
+  gint64 deadline;
+  
+  deadline_clock = ags_deadline_clock_alloc(AGS_DEADLINE_CLOCK_TEST_PERIOD);
+
+  ags_deadline_clock_start(deadline_clock);
+
+  deadline = deadline_clock->deadline;
+
+  /* oversleep 3 periods */
+  g_usleep((3 * AGS_DEADLINE_CLOCK_TEST_PERIOD + AGS_DEADLINE_CLOCK_TEST_PERIOD / 2) / 1000);
+
+  CU_ASSERT(ags_deadline_clock_wait(deadline_clock) >= 3);
+  CU_ASSERT(deadline_clock->missed_count >= 2);
+
+  /* phase is kept */
+  CU_ASSERT((deadline_clock->deadline - deadline) % AGS_DEADLINE_CLOCK_TEST_PERIOD == 0);
+
+  ags_deadline_clock_free(deadline_clock);
+}
+
+void
+ags_deadline_clock_test_period_wakeup()
+{
+  AgsDeadlineClock *deadline_clock;
+
+  deadline_clock = ags_deadline_clock_alloc(AGS_DEADLINE_CLOCK_TEST_PERIOD);
+
+  ags_deadline_clock_set_flags(deadline_clock, AGS_DEADLINE_CLOCK_SLAVE);
+
+  ags_deadline_clock_start(deadline_clock);
+
+  /* pending periods of the device */
+  ags_deadline_clock_period_wakeup(deadline_clock);
+  ags_deadline_clock_period_wakeup(deadline_clock);
+
+  CU_ASSERT(ags_deadline_clock_wait(deadline_clock) == 2);
+  CU_ASSERT(deadline_clock->pending_wakeup == 0);
+
+  /* stalled device - times out at deadline */
+  CU_ASSERT(ags_deadline_clock_wait(deadline_clock) == 1);
+  
+  ags_deadline_clock_free(deadline_clock);
+}
+
+int
+main(int argc, char **argv)
+{
+  CU_pSuite pSuite = NULL;
+
+  /* initialize the CUnit test registry */
+  if(CUE_SUCCESS != CU_initialize_registry()){
+    return CU_get_error();
+  }
+
+  /* add a suite to the registry */
+  pSuite = CU_add_suite("AgsDeadlineClockTest", ags_deadline_clock_test_init_suite, ags_deadline_clock_test_clean_suite);
+  
+  if(pSuite == NULL){
+    CU_cleanup_registry();
+    
+    return CU_get_error();
+  }
+
+  /* add the tests to the suite */
+  if((CU_add_test(pSuite, "test of AgsDeadlineClock set soundcard period", ags_deadline_clock_test_set_soundcard_period) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsDeadlineClock wait", ags_deadline_clock_test_wait) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsDeadlineClock wait missed", ags_deadline_clock_test_wait_missed) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsDeadlineClock period wakeup", ags_deadline_clock_test_period_wakeup) == NULL)){
+    CU_cleanup_registry();
+      
+    return CU_get_error();
+  }
+  
+  /* Run all tests using the CUnit Basic interface */
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+  CU_basic_run_tests();
+  
+  CU_cleanup_registry();
+  
+  return(CU_get_error());
+}
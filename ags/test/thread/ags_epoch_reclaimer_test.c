@@ -0,0 +1,311 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <CUnit/CUnit.h>
+#include <CUnit/Basic.h>
+
+#include <ags/libags.h>
+
+int ags_epoch_reclaimer_test_init_suite();
+int ags_epoch_reclaimer_test_clean_suite();
+
+void ags_epoch_reclaimer_test_retire();
+void ags_epoch_reclaimer_test_enter();
+void ags_epoch_reclaimer_test_try_collect();
+void ags_epoch_reclaimer_test_array_alloc();
+void ags_epoch_reclaimer_test_array_publish();
+
+void ags_epoch_reclaimer_test_destroy(gpointer data);
+
+guint ags_epoch_reclaimer_test_destroy_count = 0;
+
+/* The suite initialization function.
+ * Opens the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_epoch_reclaimer_test_init_suite()
+{    
+  return(0);
+}
+
+/* The suite cleanup function.
+ * Closes the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_epoch_reclaimer_test_clean_suite()
+{
+  
+  return(0);
+}
+
+void
+ags_epoch_reclaimer_test_destroy(gpointer data)
+{
+  ags_epoch_reclaimer_test_destroy_count++;
+}
+
+void
+ags_epoch_reclaimer_test_retire()
+{
+  AgsEpochReclaimer *epoch_reclaimer;
+
+  epoch_reclaimer = ags_epoch_reclaimer_alloc();
+
+  ags_epoch_reclaimer_test_destroy_count = 0;
+
+  /* without readers the grace period passes immediately */
+  ags_epoch_reclaimer_retire(epoch_reclaimer,
+			     GUINT_TO_POINTER(1), ags_epoch_reclaimer_test_destroy);
+
+  CU_ASSERT(ags_epoch_reclaimer_test_destroy_count == 1);
+  CU_ASSERT(epoch_reclaimer->retired == NULL);
+
+  /* retired data is freed with the reclaimer */
+  ags_epoch_reclaimer_free(epoch_reclaimer);
+}
+
+void
+ags_epoch_reclaimer_test_enter()
+{
+  AgsEpochReclaimer *epoch_reclaimer;
+
+  guint epoch;
+  
+  epoch_reclaimer = ags_epoch_reclaimer_alloc();
+
+  ags_epoch_reclaimer_test_destroy_count = 0;
+
+  /* a reader blocks reclamation */
+  epoch = ags_epoch_reclaimer_enter(epoch_reclaimer);
+  
+  ags_epoch_reclaimer_retire(epoch_reclaimer,
+			     GUINT_TO_POINTER(1), ags_epoch_reclaimer_test_destroy);
+
+  CU_ASSERT(ags_epoch_reclaimer_test_destroy_count == 0);
+  CU_ASSERT(ags_epoch_reclaimer_collect(epoch_reclaimer) == 0);
+
+  /* left */
+  ags_epoch_reclaimer_leave(epoch_reclaimer,
+			    epoch);
+
+  CU_ASSERT(ags_epoch_reclaimer_collect(epoch_reclaimer) == 1);
+  CU_ASSERT(ags_epoch_reclaimer_test_destroy_count == 1);
+
+  /* free remaining */
+  epoch = ags_epoch_reclaimer_enter(epoch_reclaimer);
+  
+  ags_epoch_reclaimer_retire(epoch_reclaimer,
+			     GUINT_TO_POINTER(1), ags_epoch_reclaimer_test_destroy);
+
+  ags_epoch_reclaimer_leave(epoch_reclaimer,
+			    epoch);
+
+  ags_epoch_reclaimer_free(epoch_reclaimer);
+
+  CU_ASSERT(ags_epoch_reclaimer_test_destroy_count == 2);
+}
+
+void
+ags_epoch_reclaimer_test_try_collect()
+{
+  AgsEpochReclaimer *epoch_reclaimer;
+
+  guint epoch;
+  
+  epoch_reclaimer = ags_epoch_reclaimer_alloc();
+
+  ags_epoch_reclaimer_test_destroy_count = 0;
+
+  /* nothing retired */
+  CU_ASSERT(ags_epoch_reclaimer_try_collect(epoch_reclaimer) == 0);
+
+  /* retired while reading, collected by the reader after leaving */
+  epoch = ags_epoch_reclaimer_enter(epoch_reclaimer);
+  
+  ags_epoch_reclaimer_retire(epoch_reclaimer,
+			     GUINT_TO_POINTER(1), ags_epoch_reclaimer_test_destroy);
+
+  CU_ASSERT(epoch_reclaimer->retired_count == 1);
+  CU_ASSERT(ags_epoch_reclaimer_try_collect(epoch_reclaimer) == 0);
+
+  ags_epoch_reclaimer_leave(epoch_reclaimer,
+			    epoch);
+
+  CU_ASSERT(ags_epoch_reclaimer_try_collect(epoch_reclaimer) == 1);
+  CU_ASSERT(ags_epoch_reclaimer_test_destroy_count == 1);
+  CU_ASSERT(epoch_reclaimer->retired_count == 0);
+
+  /* contended, returns without blocking */
+  epoch = ags_epoch_reclaimer_enter(epoch_reclaimer);
+  
+  ags_epoch_reclaimer_retire(epoch_reclaimer,
+			     GUINT_TO_POINTER(1), ags_epoch_reclaimer_test_destroy);
+
+  ags_epoch_reclaimer_leave(epoch_reclaimer,
+			    epoch);
+
+  g_mutex_lock(&(epoch_reclaimer->retire_mutex));
+
+  CU_ASSERT(ags_epoch_reclaimer_try_collect(epoch_reclaimer) == 0);
+
+  g_mutex_unlock(&(epoch_reclaimer->retire_mutex));
+
+  CU_ASSERT(ags_epoch_reclaimer_try_collect(epoch_reclaimer) == 1);
+  CU_ASSERT(ags_epoch_reclaimer_test_destroy_count == 2);
+
+  ags_epoch_reclaimer_free(epoch_reclaimer);
+}
+
+void
+ags_epoch_reclaimer_test_array_alloc()
+{
+  AgsEpochArray *epoch_array;
+  GObject *gobject;
+
+  GList *list;
+
+  gobject = g_object_new(G_TYPE_OBJECT,
+			 NULL);
+
+  list = g_list_prepend(NULL,
+			gobject);
+  list = g_list_prepend(list,
+			gobject);
+
+  epoch_array = ags_epoch_array_alloc(7,
+				      list);
+
+  CU_ASSERT(epoch_array->version == 7);
+  CU_ASSERT(epoch_array->length == 2);
+  CU_ASSERT(epoch_array->data[0] == gobject);
+  CU_ASSERT(epoch_array->data[1] == gobject);
+  CU_ASSERT(gobject->ref_count == 3);
+
+  ags_epoch_array_free(epoch_array);
+
+  CU_ASSERT(gobject->ref_count == 1);
+
+  g_list_free(list);
+  
+  g_object_unref(gobject);
+}
+
+void
+ags_epoch_reclaimer_test_array_publish()
+{
+  AgsEpochReclaimer *epoch_reclaimer;
+  AgsEpochArray *epoch_array, *current_epoch_array;
+  GObject *gobject;
+
+  GList *list;
+
+  guint epoch;
+  
+  epoch_reclaimer = ags_epoch_reclaimer_alloc();
+
+  epoch_array = NULL;
+
+  gobject = g_object_new(G_TYPE_OBJECT,
+			 NULL);
+
+  list = g_list_prepend(NULL,
+			gobject);
+
+  ags_epoch_array_publish(&epoch_array,
+			  list,
+			  epoch_reclaimer);
+
+  CU_ASSERT(epoch_array != NULL);
+  CU_ASSERT(epoch_array->version == 0);
+  CU_ASSERT(epoch_array->length == 1);
+
+  /* reader keeps the previous version alive */
+  epoch = ags_epoch_reclaimer_enter(epoch_reclaimer);
+
+  current_epoch_array = epoch_array;
+  
+  ags_epoch_array_publish(&epoch_array,
+			  NULL,
+			  epoch_reclaimer);
+
+  CU_ASSERT(epoch_array != current_epoch_array);
+  CU_ASSERT(epoch_array->version == 1);
+  CU_ASSERT(epoch_array->length == 0);
+
+  CU_ASSERT(current_epoch_array->data[0] == gobject);
+  CU_ASSERT(gobject->ref_count == 2);
+
+  ags_epoch_reclaimer_leave(epoch_reclaimer,
+			    epoch);
+
+  ags_epoch_reclaimer_collect(epoch_reclaimer);
+
+  CU_ASSERT(gobject->ref_count == 1);
+
+  ags_epoch_array_free(epoch_array);
+  ags_epoch_reclaimer_free(epoch_reclaimer);
+
+  g_list_free(list);
+  
+  g_object_unref(gobject);
+}
+
+int
+main(int argc, char **argv)
+{
+  CU_pSuite pSuite = NULL;
+
+  /* initialize the CUnit test registry */
+  if(CUE_SUCCESS != CU_initialize_registry()){
+    return CU_get_error();
+  }
+
+  /* add a suite to the registry */
+  pSuite = CU_add_suite("AgsEpochReclaimerTest", ags_epoch_reclaimer_test_init_suite, ags_epoch_reclaimer_test_clean_suite);
+  
+  if(pSuite == NULL){
+    CU_cleanup_registry();
+    
+    return CU_get_error();
+  }
+
+  /* add the tests to the suite */
+  if((CU_add_test(pSuite, "test of AgsEpochReclaimer retire", ags_epoch_reclaimer_test_retire) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsEpochReclaimer enter", ags_epoch_reclaimer_test_enter) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsEpochReclaimer try collect", ags_epoch_reclaimer_test_try_collect) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsEpochArray alloc", ags_epoch_reclaimer_test_array_alloc) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsEpochArray publish", ags_epoch_reclaimer_test_array_publish) == NULL)){
+    CU_cleanup_registry();
+      
+    return CU_get_error();
+  }
+  
+  /* Run all tests using the CUnit Basic interface */
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+  CU_basic_run_tests();
+  
+  CU_cleanup_registry();
+  
+  return(CU_get_error());
+}
@@ -0,0 +1,274 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <CUnit/CUnit.h>
+#include <CUnit/Basic.h>
+
+#include <ags/libags.h>
+
+int ags_job_pool_test_init_suite();
+int ags_job_pool_test_clean_suite();
+
+void ags_job_pool_test_future();
+void ags_job_pool_test_submit();
+void ags_job_pool_test_submit_nested();
+void ags_job_pool_test_stop();
+
+gpointer ags_job_pool_test_increment(AgsFuture *future,
+				     gpointer data);
+gpointer ags_job_pool_test_spawn(AgsFuture *future,
+				 gpointer data);
+void ags_job_pool_test_callback(AgsFuture *future,
+				gpointer user_data);
+
+#define AGS_JOB_POOL_TEST_WORKER_COUNT (4)
+#define AGS_JOB_POOL_TEST_JOB_COUNT (64)
+
+AgsJobPool *job_pool;
+
+volatile gint ags_job_pool_test_counter;
+
+/* The suite initialization function.
+ * Opens the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_job_pool_test_init_suite()
+{
+  job_pool = ags_job_pool_new();
+  g_object_set(job_pool,
+	       "worker-count", AGS_JOB_POOL_TEST_WORKER_COUNT,
+	       NULL);
+  
+  return(0);
+}
+
+/* The suite cleanup function.
+ * Closes the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_job_pool_test_clean_suite()
+{
+  g_object_unref(job_pool);
+  
+  return(0);
+}
+
+gpointer
+ags_job_pool_test_increment(AgsFuture *future,
+			    gpointer data)
+{
+  g_atomic_int_inc(&ags_job_pool_test_counter);
+
+  return(data);
+}
+
+gpointer
+ags_job_pool_test_spawn(AgsFuture *future,
+			gpointer data)
+{
+  AgsFuture **child;
+
+  guint i;
+
+  child = (AgsFuture **) data;
+  
+  for(i = 0; i < AGS_JOB_POOL_TEST_WORKER_COUNT; i++){
+    child[i] = ags_job_pool_submit(job_pool,
+				   ags_job_pool_test_increment,
+				   GUINT_TO_POINTER(i + 1),
+				   NULL);
+  }
+
+  return(NULL);
+}
+
+void
+ags_job_pool_test_callback(AgsFuture *future,
+			   gpointer user_data)
+{
+  g_atomic_int_inc((volatile gint *) user_data);
+}
+
+void
+ags_job_pool_test_future()
+{
+  AgsFuture *future;
+
+  gpointer result;
+  
+  volatile gint callback_count;
+
+  future = ags_future_alloc();
+
+  callback_count = 0;
+  
+  ags_future_add_callback(future,
+			  ags_job_pool_test_callback,
+			  (gpointer) &callback_count);
+
+  CU_ASSERT(ags_future_is_done(future) == FALSE);
+  CU_ASSERT(ags_future_wait_until(future,
+				  g_get_monotonic_time() + G_TIME_SPAN_MILLISECOND,
+				  &result) == FALSE);
+  CU_ASSERT(result == NULL);
+  
+  ags_future_complete(future,
+		      GUINT_TO_POINTER(7));
+
+  CU_ASSERT(ags_future_is_done(future) == TRUE);
+  CU_ASSERT(g_atomic_int_get(&callback_count) == 1);
+  CU_ASSERT(ags_future_wait(future) == GUINT_TO_POINTER(7));
+
+  /* already done invokes immediately */
+  ags_future_add_callback(future,
+			  ags_job_pool_test_callback,
+			  (gpointer) &callback_count);
+
+  CU_ASSERT(g_atomic_int_get(&callback_count) == 2);
+
+  ags_future_unref(future);
+}
+
+void
+ags_job_pool_test_submit()
+{
+  AgsFuture *future[AGS_JOB_POOL_TEST_JOB_COUNT];
+
+  guint i;
+  gboolean success;
+  
+  g_atomic_int_set(&ags_job_pool_test_counter,
+		   0);
+  
+  for(i = 0; i < AGS_JOB_POOL_TEST_JOB_COUNT; i++){
+    future[i] = ags_job_pool_submit(job_pool,
+				    ags_job_pool_test_increment,
+				    GUINT_TO_POINTER(i + 1),
+				    NULL);
+  }
+
+  CU_ASSERT(ags_job_pool_test_flags(job_pool, AGS_JOB_POOL_RUNNING) == TRUE);
+
+  success = TRUE;
+  
+  for(i = 0; i < AGS_JOB_POOL_TEST_JOB_COUNT; i++){
+    if(ags_future_wait(future[i]) != GUINT_TO_POINTER(i + 1)){
+      success = FALSE;
+    }
+
+    ags_future_unref(future[i]);
+  }
+
+  CU_ASSERT(success == TRUE);
+  CU_ASSERT(g_atomic_int_get(&ags_job_pool_test_counter) == AGS_JOB_POOL_TEST_JOB_COUNT);
+}
+
+void
+ags_job_pool_test_submit_nested()
+{
+  AgsFuture *future;
+  AgsFuture *child[AGS_JOB_POOL_TEST_WORKER_COUNT];
+
+  guint i;
+
+  g_atomic_int_set(&ags_job_pool_test_counter,
+		   0);
+
+  future = ags_job_pool_submit(job_pool,
+			       ags_job_pool_test_spawn,
+			       child,
+			       NULL);
+
+  ags_future_wait(future);
+  ags_future_unref(future);
+
+  for(i = 0; i < AGS_JOB_POOL_TEST_WORKER_COUNT; i++){
+    CU_ASSERT(child[i] != NULL);
+    CU_ASSERT(ags_future_wait(child[i]) == GUINT_TO_POINTER(i + 1));
+
+    ags_future_unref(child[i]);
+  }
+
+  CU_ASSERT(g_atomic_int_get(&ags_job_pool_test_counter) == AGS_JOB_POOL_TEST_WORKER_COUNT);
+}
+
+void
+ags_job_pool_test_stop()
+{
+  AgsFuture *future;
+  
+  ags_job_pool_stop(job_pool);
+
+  CU_ASSERT(ags_job_pool_test_flags(job_pool, AGS_JOB_POOL_RUNNING) == FALSE);
+  CU_ASSERT(job_pool->worker == NULL);
+  CU_ASSERT(job_pool->deque == NULL);
+
+  /* submit restarts the workers */
+  future = ags_job_pool_submit(job_pool,
+			       ags_job_pool_test_increment,
+			       GUINT_TO_POINTER(1),
+			       NULL);
+
+  CU_ASSERT(ags_future_wait(future) == GUINT_TO_POINTER(1));
+
+  ags_future_unref(future);
+}
+
+int
+main(int argc, char **argv)
+{
+  CU_pSuite pSuite = NULL;
+
+  /* initialize the CUnit test registry */
+  if(CUE_SUCCESS != CU_initialize_registry()){
+    return CU_get_error();
+  }
+
+  /* add a suite to the registry */
+  pSuite = CU_add_suite("AgsJobPoolTest", ags_job_pool_test_init_suite, ags_job_pool_test_clean_suite);
+  
+  if(pSuite == NULL){
+    CU_cleanup_registry();
+    
+    return CU_get_error();
+  }
+
+  /* add the tests to the suite */
+  if((CU_add_test(pSuite, "test of AgsFuture complete and wait", ags_job_pool_test_future) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsJobPool submit", ags_job_pool_test_submit) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsJobPool submit nested", ags_job_pool_test_submit_nested) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsJobPool stop", ags_job_pool_test_stop) == NULL)){
+    CU_cleanup_registry();
+      
+    return CU_get_error();
+  }
+  
+  /* Run all tests using the CUnit Basic interface */
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+  CU_basic_run_tests();
+  
+  CU_cleanup_registry();
+  
+  return(CU_get_error());
+}
@@ -0,0 +1,154 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <CUnit/CUnit.h>
+#include <CUnit/Basic.h>
+
+#include <ags/libags.h>
+
+#include <string.h>
+
+int ags_rt_sanitizer_test_init_suite();
+int ags_rt_sanitizer_test_clean_suite();
+
+void ags_rt_sanitizer_test_record();
+void ags_rt_sanitizer_test_get_report();
+
+void ags_rt_sanitizer_test_hit();
+
+/* The suite initialization function.
+ * Opens the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_rt_sanitizer_test_init_suite()
+{
+  ags_rt_sanitizer_reset();
+  
+  return(0);
+}
+
+/* The suite cleanup function.
+ * Closes the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_rt_sanitizer_test_clean_suite()
+{
+  ags_rt_sanitizer_mark_rt_thread(FALSE);
+  
+  return(0);
+}
+
+void
+ags_rt_sanitizer_test_hit()
+{
+  ags_rt_sanitizer_record(AGS_RT_SANITIZER_HOOK_WRITE);
+}
+
+void
+ags_rt_sanitizer_test_record()
+{
+  guint i;
+  
+  /* not a realtime thread */
+  ags_rt_sanitizer_test_hit();
+
+  CU_ASSERT(ags_rt_sanitizer_get_count(AGS_RT_SANITIZER_HOOK_WRITE) == 0);
+
+  ags_rt_sanitizer_mark_rt_thread(TRUE);
+
+  if(!ags_rt_sanitizer_is_enabled()){
+    CU_ASSERT(ags_rt_sanitizer_is_rt_thread() == FALSE);
+
+    return;
+  }
+
+  CU_ASSERT(ags_rt_sanitizer_is_rt_thread() == TRUE);
+
+  for(i = 0; i < 3; i++){
+    ags_rt_sanitizer_test_hit();
+  }
+
+  CU_ASSERT(ags_rt_sanitizer_get_count(AGS_RT_SANITIZER_HOOK_WRITE) == 3);
+  CU_ASSERT(ags_rt_sanitizer_get_count(AGS_RT_SANITIZER_HOOK_LAST) == 0);
+  CU_ASSERT(ags_rt_sanitizer_get_dropped_count() == 0);
+}
+
+void
+ags_rt_sanitizer_test_get_report()
+{
+  gchar *report;
+
+  report = ags_rt_sanitizer_get_report();
+
+  if(!ags_rt_sanitizer_is_enabled()){
+    CU_ASSERT(report == NULL);
+
+    return;
+  }
+  
+  CU_ASSERT(report != NULL);
+  CU_ASSERT(strstr(report, "write hit") != NULL);
+
+  g_free(report);
+
+  ags_rt_sanitizer_reset();
+
+  CU_ASSERT(ags_rt_sanitizer_get_count(AGS_RT_SANITIZER_HOOK_WRITE) == 0);
+}
+
+int
+main(int argc, char **argv)
+{
+  CU_pSuite pSuite = NULL;
+
+  /* initialize the CUnit test registry */
+  if(CUE_SUCCESS != CU_initialize_registry()){
+    return CU_get_error();
+  }
+
+  /* add a suite to the registry */
+  pSuite = CU_add_suite("AgsRtSanitizerTest", ags_rt_sanitizer_test_init_suite, ags_rt_sanitizer_test_clean_suite);
+  
+  if(pSuite == NULL){
+    CU_cleanup_registry();
+    
+    return CU_get_error();
+  }
+
+  /* add the tests to the suite */
+  if((CU_add_test(pSuite, "test of ags_rt_sanitizer.c record", ags_rt_sanitizer_test_record) == NULL) ||
+     (CU_add_test(pSuite, "test of ags_rt_sanitizer.c get report", ags_rt_sanitizer_test_get_report) == NULL)){
+    CU_cleanup_registry();
+      
+    return CU_get_error();
+  }
+  
+  /* Run all tests using the CUnit Basic interface */
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+  CU_basic_run_tests();
+  
+  CU_cleanup_registry();
+  
+  return(CU_get_error());
+}
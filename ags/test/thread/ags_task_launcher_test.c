@@ -36,6 +36,7 @@ void ags_task_launcher_test_add_task();
 void ags_task_launcher_test_add_task_all();
 void ags_task_launcher_test_add_cyclic_task();
 void ags_task_launcher_test_remove_cyclic_task();
+void ags_task_launcher_test_run();
 
 /* The suite initialization function.
  * Opens the temporary file used by the tests.
@@ -200,6 +201,50 @@ ags_task_launcher_test_remove_cyclic_task()
   CU_ASSERT(g_list_find(task_launcher->cyclic_task, task_1) == NULL);
 }
 
+void
+ags_task_launcher_test_run()
+{
+  AgsTaskLauncher *task_launcher;
+  AgsTask *task_0, *task_1, *task_2;
+
+  GObject *target;
+  
+  task_launcher = ags_task_launcher_new();
+  g_object_set(task_launcher,
+	       "max-task-count", 1,
+	       NULL);
+
+  target = g_object_new(G_TYPE_OBJECT,
+			NULL);
+  
+  /* task 0 is replaced by task 1 of the same target */
+  task_0 = ags_task_new();
+  ags_task_set_coalesce_key(task_0,
+			    target);
+  ags_task_launcher_add_task(task_launcher, task_0);
+  
+  task_1 = ags_task_new();
+  ags_task_set_coalesce_key(task_1,
+			    target);
+  ags_task_launcher_add_task(task_launcher, task_1);
+
+  task_2 = ags_task_new();
+  ags_task_launcher_add_task(task_launcher, task_2);
+
+  /* task 1 is launched and task 2 stays pending */
+  ags_task_launcher_run(task_launcher);
+
+  CU_ASSERT(task_launcher->task == NULL);
+  CU_ASSERT(g_list_length(task_launcher->pending_task) == 1);
+  CU_ASSERT(g_list_find(task_launcher->pending_task, task_2) != NULL);
+
+  ags_task_launcher_run(task_launcher);
+
+  CU_ASSERT(task_launcher->pending_task == NULL);
+
+  g_object_unref(target);
+}
+
 int
 main(int argc, char **argv)
 {
@@ -226,7 +271,8 @@ main(int argc, char **argv)
      (CU_add_test(pSuite, "test of AgsTaskLauncher add task", ags_task_launcher_test_add_task) == NULL) ||
      (CU_add_test(pSuite, "test of AgsTaskLauncher add task all", ags_task_launcher_test_add_task_all) == NULL) ||
      (CU_add_test(pSuite, "test of AgsTaskLauncher add cyclic task", ags_task_launcher_test_add_cyclic_task) == NULL) ||
-     (CU_add_test(pSuite, "test of AgsTaskLauncher remove cyclic task", ags_task_launcher_test_remove_cyclic_task) == NULL)){
+     (CU_add_test(pSuite, "test of AgsTaskLauncher remove cyclic task", ags_task_launcher_test_remove_cyclic_task) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsTaskLauncher run", ags_task_launcher_test_run) == NULL)){
     CU_cleanup_registry();
       
     return CU_get_error();
@@ -0,0 +1,320 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <CUnit/CUnit.h>
+#include <CUnit/Basic.h>
+
+#include <ags/libags.h>
+
+int ags_tic_barrier_test_init_suite();
+int ags_tic_barrier_test_clean_suite();
+
+void ags_tic_barrier_test_ref();
+void ags_tic_barrier_test_add_party();
+void ags_tic_barrier_test_remove_party();
+void ags_tic_barrier_test_arrive();
+void ags_tic_barrier_test_release();
+void ags_tic_barrier_test_wait();
+void ags_tic_barrier_test_join();
+
+gpointer ags_tic_barrier_test_wait_thread(gpointer data);
+gpointer ags_tic_barrier_test_join_thread(gpointer data);
+
+/* The suite initialization function.
+ * Opens the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_tic_barrier_test_init_suite()
+{    
+  return(0);
+}
+
+/* The suite cleanup function.
+ * Closes the temporary file used by the tests.
+ * Returns zero on success, non-zero otherwise.
+ */
+int
+ags_tic_barrier_test_clean_suite()
+{
+  
+  return(0);
+}
+
+void
+ags_tic_barrier_test_ref()
+{
+  AgsTicBarrier *tic_barrier;
+
+  tic_barrier = ags_tic_barrier_alloc(AGS_TIC_BARRIER_DEFAULT_SPIN_COUNT);
+
+  CU_ASSERT(tic_barrier != NULL);
+  CU_ASSERT(tic_barrier->ref_count == 1);
+
+  CU_ASSERT(ags_tic_barrier_ref(tic_barrier) == tic_barrier);
+  CU_ASSERT(tic_barrier->ref_count == 2);
+
+  ags_tic_barrier_unref(tic_barrier);
+  CU_ASSERT(tic_barrier->ref_count == 1);
+
+  ags_tic_barrier_unref(tic_barrier);
+}
+
+void
+ags_tic_barrier_test_add_party()
+{
+  AgsTicBarrier *tic_barrier;
+
+  tic_barrier = ags_tic_barrier_alloc(AGS_TIC_BARRIER_DEFAULT_SPIN_COUNT);
+
+  CU_ASSERT(ags_tic_barrier_get_party_count(tic_barrier) == 0);
+
+  ags_tic_barrier_add_party(tic_barrier);
+  ags_tic_barrier_add_party(tic_barrier);
+  ags_tic_barrier_add_party(tic_barrier);
+
+  CU_ASSERT(ags_tic_barrier_get_party_count(tic_barrier) == 3);
+
+  ags_tic_barrier_unref(tic_barrier);
+}
+
+void
+ags_tic_barrier_test_remove_party()
+{
+  AgsTicBarrier *tic_barrier;
+
+  guint generation;
+  
+  tic_barrier = ags_tic_barrier_alloc(AGS_TIC_BARRIER_DEFAULT_SPIN_COUNT);
+
+  ags_tic_barrier_add_party(tic_barrier);
+  ags_tic_barrier_add_party(tic_barrier);
+
+  /* nobody arrived - removing doesn't complete the tic */
+  CU_ASSERT(ags_tic_barrier_remove_party(tic_barrier) == FALSE);
+  CU_ASSERT(ags_tic_barrier_get_party_count(tic_barrier) == 1);
+
+  /* one arrived of two - the leaving party completes the tic */
+  ags_tic_barrier_add_party(tic_barrier);
+
+  CU_ASSERT(ags_tic_barrier_arrive(tic_barrier, &generation) == FALSE);
+  CU_ASSERT(ags_tic_barrier_remove_party(tic_barrier) == TRUE);
+  CU_ASSERT(ags_tic_barrier_get_party_count(tic_barrier) == 1);
+
+  ags_tic_barrier_unref(tic_barrier);
+}
+
+void
+ags_tic_barrier_test_arrive()
+{
+  AgsTicBarrier *tic_barrier;
+
+  guint generation;
+  
+  tic_barrier = ags_tic_barrier_alloc(AGS_TIC_BARRIER_DEFAULT_SPIN_COUNT);
+
+  ags_tic_barrier_add_party(tic_barrier);
+  ags_tic_barrier_add_party(tic_barrier);
+  ags_tic_barrier_add_party(tic_barrier);
+
+  /* only the last arriving party leads */
+  CU_ASSERT(ags_tic_barrier_arrive(tic_barrier, &generation) == FALSE);
+  CU_ASSERT(generation == 0);
+  
+  CU_ASSERT(ags_tic_barrier_arrive(tic_barrier, &generation) == FALSE);
+  CU_ASSERT(ags_tic_barrier_arrive(tic_barrier, &generation) == TRUE);
+
+  ags_tic_barrier_unref(tic_barrier);
+}
+
+void
+ags_tic_barrier_test_release()
+{
+  AgsTicBarrier *tic_barrier;
+
+  guint generation;
+  
+  tic_barrier = ags_tic_barrier_alloc(AGS_TIC_BARRIER_DEFAULT_SPIN_COUNT);
+
+  ags_tic_barrier_add_party(tic_barrier);
+  ags_tic_barrier_add_party(tic_barrier);
+
+  CU_ASSERT(ags_tic_barrier_get_generation(tic_barrier) == 0);
+
+  ags_tic_barrier_arrive(tic_barrier, &generation);
+  CU_ASSERT(ags_tic_barrier_arrive(tic_barrier, &generation) == TRUE);
+
+  ags_tic_barrier_release(tic_barrier);
+
+  /* next tic starts with nobody arrived */
+  CU_ASSERT(ags_tic_barrier_get_generation(tic_barrier) == 1);
+  CU_ASSERT(ags_tic_barrier_get_party_count(tic_barrier) == 2);
+  CU_ASSERT((tic_barrier->state & AGS_TIC_BARRIER_ARRIVED_MASK) == 0);
+  CU_ASSERT((tic_barrier->state & AGS_TIC_BARRIER_RELEASE_MASK) == 0);
+
+  /* waiting for a passed generation returns immediately */
+  ags_tic_barrier_wait(tic_barrier, generation);
+  
+  ags_tic_barrier_unref(tic_barrier);
+}
+
+gpointer
+ags_tic_barrier_test_wait_thread(gpointer data)
+{
+  AgsTicBarrier *tic_barrier;
+
+  guint generation;
+  guint i;
+  
+  tic_barrier = (AgsTicBarrier *) data;
+
+  for(i = 0; i < 64; i++){
+    if(ags_tic_barrier_arrive(tic_barrier, &generation)){
+      ags_tic_barrier_release(tic_barrier);
+    }else{
+      ags_tic_barrier_wait(tic_barrier, generation);
+    }
+  }
+
+  return(NULL);
+}
+
+void
+ags_tic_barrier_test_wait()
+{
+  AgsTicBarrier *tic_barrier;
+
+  GThread *thread[4];
+  
+  guint i;
+  
+  /* no spinning - force the sleeping path */
+  tic_barrier = ags_tic_barrier_alloc(0);
+
+  for(i = 0; i < 4; i++){
+    ags_tic_barrier_add_party(tic_barrier);
+  }
+
+  for(i = 0; i < 4; i++){
+    thread[i] = g_thread_new("ags_tic_barrier_test",
+			     ags_tic_barrier_test_wait_thread,
+			     tic_barrier);
+  }
+
+  for(i = 0; i < 4; i++){
+    g_thread_join(thread[i]);
+  }
+
+  CU_ASSERT(ags_tic_barrier_get_generation(tic_barrier) == 64);
+
+  ags_tic_barrier_unref(tic_barrier);
+}
+
+gpointer
+ags_tic_barrier_test_join_thread(gpointer data)
+{
+  ags_tic_barrier_add_party((AgsTicBarrier *) data);
+
+  return(NULL);
+}
+
+void
+ags_tic_barrier_test_join()
+{
+  AgsTicBarrier *tic_barrier;
+
+  GThread *thread;
+  
+  guint generation;
+  
+  tic_barrier = ags_tic_barrier_alloc(AGS_TIC_BARRIER_DEFAULT_SPIN_COUNT);
+
+  ags_tic_barrier_add_party(tic_barrier);
+
+  CU_ASSERT(ags_tic_barrier_arrive(tic_barrier, &generation) == TRUE);
+
+  /* the generation is complete - joining waits for the release */
+  thread = g_thread_new("ags_tic_barrier_test",
+			ags_tic_barrier_test_join_thread,
+			tic_barrier);
+
+  g_usleep(G_USEC_PER_SEC / 100);
+
+  CU_ASSERT(ags_tic_barrier_get_party_count(tic_barrier) == 1);
+
+  ags_tic_barrier_release(tic_barrier);
+
+  g_thread_join(thread);
+
+  CU_ASSERT(ags_tic_barrier_get_party_count(tic_barrier) == 2);
+  CU_ASSERT(ags_tic_barrier_get_generation(tic_barrier) == 1);
+
+  /* the joined party is needed to complete the next generation */
+  CU_ASSERT(ags_tic_barrier_arrive(tic_barrier, &generation) == FALSE);
+  CU_ASSERT(generation == 1);
+  CU_ASSERT(ags_tic_barrier_arrive(tic_barrier, &generation) == TRUE);
+
+  ags_tic_barrier_release(tic_barrier);
+  
+  ags_tic_barrier_unref(tic_barrier);
+}
+
+int
+main(int argc, char **argv)
+{
+  CU_pSuite pSuite = NULL;
+
+  /* initialize the CUnit test registry */
+  if(CUE_SUCCESS != CU_initialize_registry()){
+    return CU_get_error();
+  }
+
+  /* add a suite to the registry */
+  pSuite = CU_add_suite("AgsTicBarrierTest", ags_tic_barrier_test_init_suite, ags_tic_barrier_test_clean_suite);
+  
+  if(pSuite == NULL){
+    CU_cleanup_registry();
+    
+    return CU_get_error();
+  }
+
+  /* add the tests to the suite */
+  if((CU_add_test(pSuite, "test of AgsTicBarrier ref", ags_tic_barrier_test_ref) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsTicBarrier add party", ags_tic_barrier_test_add_party) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsTicBarrier remove party", ags_tic_barrier_test_remove_party) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsTicBarrier arrive", ags_tic_barrier_test_arrive) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsTicBarrier release", ags_tic_barrier_test_release) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsTicBarrier wait", ags_tic_barrier_test_wait) == NULL) ||
+     (CU_add_test(pSuite, "test of AgsTicBarrier join", ags_tic_barrier_test_join) == NULL)){
+    CU_cleanup_registry();
+      
+    return CU_get_error();
+  }
+  
+  /* Run all tests using the CUnit Basic interface */
+  CU_basic_set_mode(CU_BRM_VERBOSE);
+  CU_basic_run_tests();
+  
+  CU_cleanup_registry();
+  
+  return(CU_get_error());
+}
@@ -0,0 +1,533 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <ags/thread/ags_cpu_affinity.h>
+
+#include <ags/object/ags_config.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+guint* ags_cpu_affinity_read_cpu_list(gchar *filename,
+				      guint *cpu_count);
+
+/**
+ * SECTION:ags_cpu_affinity
+ * @short_description: CPU affinity of threads
+ * @title: AgsCpuAffinity
+ * @section_id:
+ * @include: ags/thread/ags_cpu_affinity.h
+ *
+ * The CPU affinity functions pin the calling thread to the CPU set
+ * configured in the [thread] section of #AgsConfig. The keys are
+ * %AGS_CPU_AFFINITY_KEY_AUDIO_MAIN_LOOP, %AGS_CPU_AFFINITY_KEY_SOUNDCARD,
+ * %AGS_CPU_AFFINITY_KEY_AUDIO, %AGS_CPU_AFFINITY_KEY_WORKER,
+ * %AGS_CPU_AFFINITY_KEY_TASK_LAUNCHER and %AGS_CPU_AFFINITY_KEY_JOB_POOL.
+ *
+ * A value is either a CPU list like "2-3,6" or %AGS_CPU_AFFINITY_AUTO. Auto
+ * placement uses the CPUs isolated by the isolcpus kernel parameter. The
+ * scheduler doesn't balance load across isolated CPUs, so every realtime
+ * thread is pinned to exactly one of them: the audio main loop gets the
+ * first and all others are dealt round robin over the remaining ones. The
+ * task launcher and the job pool are kept on the housekeeping CPUs. Without isolated CPUs
+ * auto placement leaves the threads alone.
+ */
+
+static GPrivate ags_cpu_affinity_private;
+
+static volatile gint ags_cpu_affinity_nth = 0;
+
+/**
+ * ags_cpu_affinity_parse_cpu_list:
+ * @cpu_list: the CPU list string, like "0-3,6"
+ * @cpu_count: (out): return location of the CPU count
+ *
+ * Parse @cpu_list in the format of the kernel's cpulist files. Duplicate
+ * CPUs are skipped.
+ *
+ * Returns: (transfer full): the CPU array or %NULL if @cpu_list is empty or malformed
+ *
+ * Since: 3.7.0
+ */
+guint*
+ags_cpu_affinity_parse_cpu_list(gchar *cpu_list,
+				guint *cpu_count)
+{
+  GArray *array;
+  
+  gchar **token, **iter;
+
+  gboolean success;
+
+  if(cpu_count != NULL){
+    cpu_count[0] = 0;
+  }
+  
+  if(cpu_list == NULL){
+    return(NULL);
+  }
+
+  array = g_array_new(FALSE, FALSE, sizeof(guint));
+
+  token = g_strsplit(cpu_list,
+		     ",",
+		     -1);
+
+  success = TRUE;
+  
+  for(iter = token; *iter != NULL && success; iter++){
+    gchar *str, *end;
+
+    guint64 first, last;
+    guint64 i;
+    guint j;
+
+    str = g_strstrip(*iter);
+
+    if(str[0] == '\0'){
+      continue;
+    }
+
+    if(!g_ascii_isdigit(str[0])){
+      success = FALSE;
+
+      break;
+    }
+    
+    first = g_ascii_strtoull(str,
+			     &end,
+			     10);
+    last = first;
+
+    if(end[0] == '-'){
+      if(!g_ascii_isdigit(end[1])){
+	success = FALSE;
+
+	break;
+      }
+      
+      last = g_ascii_strtoull(end + 1,
+			      &end,
+			      10);
+    }
+
+    if(end[0] != '\0' ||
+       last < first ||
+       last >= G_MAXUINT){
+      success = FALSE;
+
+      break;
+    }
+
+    for(i = first; i <= last; i++){
+      for(j = 0; j < array->len; j++){
+	if(g_array_index(array, guint, j) == (guint) i){
+	  break;
+	}
+      }
+
+      if(j == array->len){
+	guint cpu;
+
+	cpu = (guint) i;
+	
+	g_array_append_val(array,
+			   cpu);
+      }
+    }
+  }
+
+  g_strfreev(token);
+
+  if(!success ||
+     array->len == 0){
+    g_array_free(array,
+		 TRUE);
+
+    return(NULL);
+  }
+
+  if(cpu_count != NULL){
+    cpu_count[0] = array->len;
+  }
+  
+  return((guint *) g_array_free(array,
+				FALSE));
+}
+
+guint*
+ags_cpu_affinity_read_cpu_list(gchar *filename,
+			       guint *cpu_count)
+{
+  gchar *str;
+
+  guint *cpu;
+  
+  str = NULL;
+
+  if(!g_file_get_contents(filename,
+			  &str,
+			  NULL,
+			  NULL)){
+    if(cpu_count != NULL){
+      cpu_count[0] = 0;
+    }
+
+    return(NULL);
+  }
+
+  cpu = ags_cpu_affinity_parse_cpu_list(str,
+					cpu_count);
+
+  g_free(str);
+  
+  return(cpu);
+}
+
+/**
+ * ags_cpu_affinity_get_online:
+ * @cpu_count: (out): return location of the CPU count
+ *
+ * Get the online CPUs. If the kernel doesn't tell, the CPUs are assumed
+ * to be numbered from 0 to g_get_num_processors() - 1.
+ *
+ * Returns: (transfer full): the CPU array
+ *
+ * Since: 3.7.0
+ */
+guint*
+ags_cpu_affinity_get_online(guint *cpu_count)
+{
+  guint *cpu;
+
+  guint n_processors;
+  guint i;
+  
+  cpu = ags_cpu_affinity_read_cpu_list(AGS_CPU_AFFINITY_ONLINE_FILENAME,
+				       cpu_count);
+
+  if(cpu != NULL){
+    return(cpu);
+  }
+
+  n_processors = g_get_num_processors();
+
+  cpu = (guint *) g_malloc(n_processors * sizeof(guint));
+
+  for(i = 0; i < n_processors; i++){
+    cpu[i] = i;
+  }
+
+  if(cpu_count != NULL){
+    cpu_count[0] = n_processors;
+  }
+  
+  return(cpu);
+}
+
+/**
+ * ags_cpu_affinity_get_isolated:
+ * @cpu_count: (out): return location of the CPU count
+ *
+ * Get the CPUs isolated from the scheduler by the isolcpus kernel parameter.
+ *
+ * Returns: (transfer full): the CPU array or %NULL if there are no isolated CPUs
+ *
+ * Since: 3.7.0
+ */
+guint*
+ags_cpu_affinity_get_isolated(guint *cpu_count)
+{
+  return(ags_cpu_affinity_read_cpu_list(AGS_CPU_AFFINITY_ISOLATED_FILENAME,
+					cpu_count));
+}
+
+/**
+ * ags_cpu_affinity_auto_place:
+ * @key: the config key of the thread
+ * @online: the online CPUs
+ * @online_count: the count of @online
+ * @isolated: the isolated CPUs
+ * @isolated_count: the count of @isolated
+ * @nth: the placement counter
+ * @cpu_count: (out): return location of the CPU count
+ *
+ * Compute the automatic placement of the thread configured by @key. The
+ * audio main loop gets the first isolated CPU, the @nth other realtime
+ * thread gets one of the remaining isolated CPUs round robin and the
+ * task launcher or job pool gets all housekeeping CPUs.
+ *
+ * Returns: (transfer full): the CPU array or %NULL to leave the thread alone
+ *
+ * Since: 3.7.0
+ */
+guint*
+ags_cpu_affinity_auto_place(gchar *key,
+			    guint *online, guint online_count,
+			    guint *isolated, guint isolated_count,
+			    guint nth,
+			    guint *cpu_count)
+{
+  guint *cpu;
+
+  guint i, j;
+  
+  if(cpu_count != NULL){
+    cpu_count[0] = 0;
+  }
+
+  if(key == NULL ||
+     isolated == NULL ||
+     isolated_count == 0){
+    return(NULL);
+  }
+
+  /* housekeeping */
+  if(!g_strcmp0(key,
+		AGS_CPU_AFFINITY_KEY_TASK_LAUNCHER) ||
+     !g_strcmp0(key,
+		AGS_CPU_AFFINITY_KEY_JOB_POOL)){
+    guint count;
+    
+    if(online == NULL ||
+       online_count == 0){
+      return(NULL);
+    }
+
+    cpu = (guint *) g_malloc(online_count * sizeof(guint));
+    count = 0;
+
+    for(i = 0; i < online_count; i++){
+      for(j = 0; j < isolated_count; j++){
+	if(online[i] == isolated[j]){
+	  break;
+	}
+      }
+
+      if(j == isolated_count){
+	cpu[count] = online[i];
+	count++;
+      }
+    }
+
+    if(count == 0){
+      g_free(cpu);
+
+      return(NULL);
+    }
+
+    if(cpu_count != NULL){
+      cpu_count[0] = count;
+    }
+    
+    return(cpu);
+  }
+
+  /* realtime */
+  cpu = (guint *) g_malloc(sizeof(guint));
+
+  if(!g_strcmp0(key,
+		AGS_CPU_AFFINITY_KEY_AUDIO_MAIN_LOOP) ||
+     isolated_count == 1){
+    cpu[0] = isolated[0];
+  }else{
+    cpu[0] = isolated[1 + (nth % (isolated_count - 1))];
+  }
+
+  if(cpu_count != NULL){
+    cpu_count[0] = 1;
+  }
+  
+  return(cpu);
+}
+
+/**
+ * ags_cpu_affinity_get_cpu:
+ * @key: the config key of the thread
+ * @cpu_count: (out): return location of the CPU count
+ *
+ * Get the CPUs configured by @key in the [thread] section of #AgsConfig.
+ *
+ * Returns: (transfer full): the CPU array or %NULL if the thread is not pinned
+ *
+ * Since: 3.7.0
+ */
+guint*
+ags_cpu_affinity_get_cpu(gchar *key,
+			 guint *cpu_count)
+{
+  AgsConfig *config;
+
+  gchar *str;
+
+  guint *cpu;
+
+  if(cpu_count != NULL){
+    cpu_count[0] = 0;
+  }
+  
+  if(key == NULL){
+    return(NULL);
+  }
+  
+  config = ags_config_get_instance();
+  
+  str = ags_config_get_value(config,
+			     AGS_CONFIG_THREAD,
+			     key);
+
+  if(str == NULL){
+    return(NULL);
+  }
+
+  if(!g_ascii_strncasecmp(str,
+			  AGS_CPU_AFFINITY_AUTO,
+			  5)){
+    guint *online, *isolated;
+
+    guint online_count, isolated_count;
+
+    online = ags_cpu_affinity_get_online(&online_count);
+    isolated = ags_cpu_affinity_get_isolated(&isolated_count);
+
+    cpu = ags_cpu_affinity_auto_place(key,
+				      online, online_count,
+				      isolated, isolated_count,
+				      (guint) g_atomic_int_add(&ags_cpu_affinity_nth,
+							       1),
+				      cpu_count);
+
+    g_free(online);
+    g_free(isolated);
+  }else{
+    cpu = ags_cpu_affinity_parse_cpu_list(str,
+					  cpu_count);
+  }
+
+  g_free(str);
+  
+  return(cpu);
+}
+
+/**
+ * ags_cpu_affinity_set_cpu:
+ * @cpu: the CPUs
+ * @cpu_count: the count of @cpu
+ *
+ * Set the CPU affinity of the calling thread to @cpu.
+ *
+ * Returns: %TRUE on success, otherwise %FALSE
+ *
+ * Since: 3.7.0
+ */
+gboolean
+ags_cpu_affinity_set_cpu(guint *cpu, guint cpu_count)
+{
+#if defined(__linux__)
+  cpu_set_t cpu_set;
+
+  guint i;
+  gboolean has_cpu;
+  int retval;
+  
+  if(cpu == NULL ||
+     cpu_count == 0){
+    return(FALSE);
+  }
+
+  CPU_ZERO(&cpu_set);
+
+  has_cpu = FALSE;
+  
+  for(i = 0; i < cpu_count; i++){
+    if(cpu[i] < CPU_SETSIZE){
+      CPU_SET(cpu[i], &cpu_set);
+
+      has_cpu = TRUE;
+    }
+  }
+
+  if(!has_cpu){
+    return(FALSE);
+  }
+  
+  retval = pthread_setaffinity_np(pthread_self(),
+				  sizeof(cpu_set_t),
+				  &cpu_set);
+
+  if(retval != 0){
+    g_warning("pthread_setaffinity_np failed - %s", strerror(retval));
+
+    return(FALSE);
+  }
+  
+  return(TRUE);
+#else
+  return(FALSE);
+#endif
+}
+
+/**
+ * ags_cpu_affinity_setup:
+ * @key: the config key of the thread
+ *
+ * Pin the calling thread to the CPUs configured by @key. This is done
+ * once per thread, later calls do nothing.
+ *
+ * Returns: %TRUE if the thread was pinned, otherwise %FALSE
+ *
+ * Since: 3.7.0
+ */
+gboolean
+ags_cpu_affinity_setup(gchar *key)
+{
+  guint *cpu;
+
+  guint cpu_count;
+  gboolean success;
+  
+  if(g_private_get(&ags_cpu_affinity_private) != NULL){
+    return(FALSE);
+  }
+
+  g_private_set(&ags_cpu_affinity_private,
+		GUINT_TO_POINTER(1));
+
+  cpu = ags_cpu_affinity_get_cpu(key,
+				 &cpu_count);
+
+  if(cpu == NULL){
+    return(FALSE);
+  }
+
+  success = ags_cpu_affinity_set_cpu(cpu, cpu_count);
+
+  g_free(cpu);
+  
+  return(success);
+}
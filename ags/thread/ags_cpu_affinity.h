@@ -0,0 +1,61 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __AGS_CPU_AFFINITY_H__
+#define __AGS_CPU_AFFINITY_H__
+
+#include <glib.h>
+#include <glib-object.h>
+
+G_BEGIN_DECLS
+
+#define AGS_CPU_AFFINITY_KEY_AUDIO_MAIN_LOOP "cpu-affinity-audio-main-loop"
+#define AGS_CPU_AFFINITY_KEY_SOUNDCARD "cpu-affinity-soundcard"
+#define AGS_CPU_AFFINITY_KEY_AUDIO "cpu-affinity-audio"
+#define AGS_CPU_AFFINITY_KEY_WORKER "cpu-affinity-worker"
+#define AGS_CPU_AFFINITY_KEY_TASK_LAUNCHER "cpu-affinity-task-launcher"
+#define AGS_CPU_AFFINITY_KEY_JOB_POOL "cpu-affinity-job-pool"
+
+#define AGS_CPU_AFFINITY_AUTO "auto"
+
+#define AGS_CPU_AFFINITY_ONLINE_FILENAME "/sys/devices/system/cpu/online"
+#define AGS_CPU_AFFINITY_ISOLATED_FILENAME "/sys/devices/system/cpu/isolated"
+
+guint* ags_cpu_affinity_parse_cpu_list(gchar *cpu_list,
+				       guint *cpu_count);
+
+guint* ags_cpu_affinity_get_online(guint *cpu_count);
+guint* ags_cpu_affinity_get_isolated(guint *cpu_count);
+
+guint* ags_cpu_affinity_auto_place(gchar *key,
+				   guint *online, guint online_count,
+				   guint *isolated, guint isolated_count,
+				   guint nth,
+				   guint *cpu_count);
+
+guint* ags_cpu_affinity_get_cpu(gchar *key,
+				guint *cpu_count);
+
+gboolean ags_cpu_affinity_set_cpu(guint *cpu, guint cpu_count);
+
+gboolean ags_cpu_affinity_setup(gchar *key);
+
+G_END_DECLS
+
+#endif /*__AGS_CPU_AFFINITY_H__*/
@@ -0,0 +1,405 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ags/thread/ags_deadline_clock.h>
+
+#include <ags/lib/ags_time.h>
+
+#include <time.h>
+#include <errno.h>
+
+void ags_deadline_clock_sleep_until(gint64 deadline);
+
+/**
+ * SECTION:ags_deadline_clock
+ * @short_description: absolute deadline clock
+ * @title: AgsDeadlineClock
+ * @section_id:
+ * @include: ags/thread/ags_deadline_clock.h
+ *
+ * The #AgsDeadlineClock paces a loop by absolute %CLOCK_MONOTONIC deadlines,
+ * each one exactly a period after the previous. Unlike relative sleeps the
+ * time spent computing a tic doesn't accumulate as drift. If a deadline is
+ * missed, the clock skips the lost periods and keeps its phase.
+ *
+ * With %AGS_DEADLINE_CLOCK_SLAVE set, ags_deadline_clock_wait() returns as the
+ * device reports a period by ags_deadline_clock_period_wakeup() and the
+ * deadline is used as timeout only.
+ */
+
+/**
+ * ags_deadline_clock_alloc:
+ * @period: the period in nsec
+ *
+ * Allocate #AgsDeadlineClock.
+ *
+ * Returns: (transfer full): the new #AgsDeadlineClock
+ *
+ * Since: 3.7.0
+ */
+AgsDeadlineClock*
+ags_deadline_clock_alloc(guint64 period)
+{
+  AgsDeadlineClock *deadline_clock;
+
+  deadline_clock = (AgsDeadlineClock *) g_malloc(sizeof(AgsDeadlineClock));
+
+  deadline_clock->flags = 0;
+
+  deadline_clock->period = ((period > 0) ? period: AGS_DEADLINE_CLOCK_DEFAULT_PERIOD);
+
+  deadline_clock->deadline = 0;
+
+  deadline_clock->missed_count = 0;
+
+  deadline_clock->pending_wakeup = 0;
+
+  g_mutex_init(&(deadline_clock->wakeup_mutex));
+  g_cond_init(&(deadline_clock->wakeup_cond));
+
+  return(deadline_clock);
+}
+
+/**
+ * ags_deadline_clock_free:
+ * @deadline_clock: the #AgsDeadlineClock
+ *
+ * Free @deadline_clock.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_deadline_clock_free(AgsDeadlineClock *deadline_clock)
+{
+  if(deadline_clock == NULL){
+    return;
+  }
+
+  g_mutex_clear(&(deadline_clock->wakeup_mutex));
+  g_cond_clear(&(deadline_clock->wakeup_cond));
+
+  g_free(deadline_clock);
+}
+
+/**
+ * ags_deadline_clock_test_flags:
+ * @deadline_clock: the #AgsDeadlineClock
+ * @flags: the flags
+ *
+ * Test @flags to be set on @deadline_clock.
+ * 
+ * Returns: %TRUE if flags are set, else %FALSE
+ *
+ * Since: 3.7.0
+ */
+gboolean
+ags_deadline_clock_test_flags(AgsDeadlineClock *deadline_clock, guint flags)
+{
+  if(deadline_clock == NULL){
+    return(FALSE);
+  }
+
+  return(((flags & (g_atomic_int_get(&(deadline_clock->flags)))) != 0) ? TRUE: FALSE);
+}
+
+/**
+ * ags_deadline_clock_set_flags:
+ * @deadline_clock: the #AgsDeadlineClock
+ * @flags: the flags
+ *
+ * Set @flags on @deadline_clock.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_deadline_clock_set_flags(AgsDeadlineClock *deadline_clock, guint flags)
+{
+  if(deadline_clock == NULL){
+    return;
+  }
+
+  g_atomic_int_or(&(deadline_clock->flags),
+		  flags);
+}
+
+/**
+ * ags_deadline_clock_unset_flags:
+ * @deadline_clock: the #AgsDeadlineClock
+ * @flags: the flags
+ *
+ * Unset @flags on @deadline_clock.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_deadline_clock_unset_flags(AgsDeadlineClock *deadline_clock, guint flags)
+{
+  if(deadline_clock == NULL){
+    return;
+  }
+
+  g_atomic_int_and(&(deadline_clock->flags),
+		   (~flags));
+}
+
+/**
+ * ags_deadline_clock_get_monotonic_time:
+ *
+ * Get the current time of %CLOCK_MONOTONIC.
+ *
+ * Returns: the time in nsec
+ *
+ * Since: 3.7.0
+ */
+gint64
+ags_deadline_clock_get_monotonic_time()
+{
+#if defined(__APPLE__) || defined(AGS_W32API)
+  return(g_get_monotonic_time() * 1000);
+#else
+  struct timespec current_time;
+
+  clock_gettime(CLOCK_MONOTONIC, &current_time);
+
+  return(((gint64) current_time.tv_sec * AGS_NSEC_PER_SEC) + (gint64) current_time.tv_nsec);
+#endif
+}
+
+void
+ags_deadline_clock_sleep_until(gint64 deadline)
+{
+#if defined(__APPLE__) || defined(AGS_W32API)
+  gint64 current_time;
+
+  current_time = ags_deadline_clock_get_monotonic_time();
+
+  if(deadline > current_time){
+    g_usleep((gulong) ((deadline - current_time) / 1000));
+  }
+#else
+  struct timespec deadline_time;
+
+  deadline_time.tv_sec = (time_t) (deadline / AGS_NSEC_PER_SEC);
+  deadline_time.tv_nsec = (long) (deadline % AGS_NSEC_PER_SEC);
+
+  /* absolute - an interrupted sleep is resumed with the same deadline */
+  while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME,
+			&deadline_time, NULL) == EINTR);
+#endif
+}
+
+/**
+ * ags_deadline_clock_get_period:
+ * @deadline_clock: the #AgsDeadlineClock
+ *
+ * Get period of @deadline_clock.
+ *
+ * Returns: the period in nsec
+ *
+ * Since: 3.7.0
+ */
+guint64
+ags_deadline_clock_get_period(AgsDeadlineClock *deadline_clock)
+{
+  guint64 period;
+
+  if(deadline_clock == NULL){
+    return(0);
+  }
+
+  g_mutex_lock(&(deadline_clock->wakeup_mutex));
+
+  period = deadline_clock->period;
+
+  g_mutex_unlock(&(deadline_clock->wakeup_mutex));
+
+  return(period);
+}
+
+/**
+ * ags_deadline_clock_set_period:
+ * @deadline_clock: the #AgsDeadlineClock
+ * @period: the period in nsec
+ *
+ * Set period of @deadline_clock, it applies starting with the next deadline.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_deadline_clock_set_period(AgsDeadlineClock *deadline_clock,
+			      guint64 period)
+{
+  if(deadline_clock == NULL ||
+     period == 0){
+    return;
+  }
+
+  g_mutex_lock(&(deadline_clock->wakeup_mutex));
+
+  deadline_clock->period = period;
+
+  g_mutex_unlock(&(deadline_clock->wakeup_mutex));
+}
+
+/**
+ * ags_deadline_clock_set_soundcard_period:
+ * @deadline_clock: the #AgsDeadlineClock
+ * @samplerate: the samplerate
+ * @buffer_size: the buffer size
+ *
+ * Set period of @deadline_clock to the time the soundcard needs to play
+ * @buffer_size frames at @samplerate.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_deadline_clock_set_soundcard_period(AgsDeadlineClock *deadline_clock,
+					guint samplerate,
+					guint buffer_size)
+{
+  if(deadline_clock == NULL ||
+     samplerate == 0){
+    return;
+  }
+
+  ags_deadline_clock_set_period(deadline_clock,
+				((guint64) buffer_size * AGS_NSEC_PER_SEC) / (guint64) samplerate);
+}
+
+/**
+ * ags_deadline_clock_start:
+ * @deadline_clock: the #AgsDeadlineClock
+ *
+ * Anchor the first deadline of @deadline_clock one period from now.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_deadline_clock_start(AgsDeadlineClock *deadline_clock)
+{
+  if(deadline_clock == NULL){
+    return;
+  }
+
+  deadline_clock->deadline = ags_deadline_clock_get_monotonic_time() + (gint64) ags_deadline_clock_get_period(deadline_clock);
+
+  g_mutex_lock(&(deadline_clock->wakeup_mutex));
+
+  deadline_clock->pending_wakeup = 0;
+  
+  g_mutex_unlock(&(deadline_clock->wakeup_mutex));
+
+  ags_deadline_clock_set_flags(deadline_clock, AGS_DEADLINE_CLOCK_STARTED);
+}
+
+/**
+ * ags_deadline_clock_wait:
+ * @deadline_clock: the #AgsDeadlineClock
+ *
+ * Wait for the next deadline of @deadline_clock. As slave, wait for the next
+ * period wakeup of the device with the deadline as timeout.
+ *
+ * Returns: the count of periods passed, greater than 1 if deadlines were missed
+ *
+ * Since: 3.7.0
+ */
+guint
+ags_deadline_clock_wait(AgsDeadlineClock *deadline_clock)
+{
+  gint64 current_time;
+  gint64 period;
+  guint passed;
+
+  if(deadline_clock == NULL){
+    return(0);
+  }
+
+  if(!ags_deadline_clock_test_flags(deadline_clock, AGS_DEADLINE_CLOCK_STARTED)){
+    ags_deadline_clock_start(deadline_clock);
+  }
+
+  period = (gint64) ags_deadline_clock_get_period(deadline_clock);
+  
+  passed = 1;
+  
+  if(ags_deadline_clock_test_flags(deadline_clock, AGS_DEADLINE_CLOCK_SLAVE)){
+    /* the device drives - deadline is timeout of a stalled device */
+    g_mutex_lock(&(deadline_clock->wakeup_mutex));
+
+    while(deadline_clock->pending_wakeup == 0){
+      if(!g_cond_wait_until(&(deadline_clock->wakeup_cond),
+			    &(deadline_clock->wakeup_mutex),
+			    deadline_clock->deadline / 1000)){
+	break;
+      }
+    }
+
+    if(deadline_clock->pending_wakeup > 0){
+      passed = deadline_clock->pending_wakeup;
+      
+      deadline_clock->pending_wakeup = 0;
+    }
+    
+    g_mutex_unlock(&(deadline_clock->wakeup_mutex));
+
+    deadline_clock->deadline = ags_deadline_clock_get_monotonic_time() + period;
+
+    return(passed);
+  }
+
+  current_time = ags_deadline_clock_get_monotonic_time();
+
+  if(current_time < deadline_clock->deadline){
+    ags_deadline_clock_sleep_until(deadline_clock->deadline);
+  }else{
+    /* missed - skip lost periods but keep the phase */
+    passed += (guint) ((current_time - deadline_clock->deadline) / period);
+
+    deadline_clock->missed_count += (passed - 1);
+  }
+  
+  deadline_clock->deadline += (passed * period);
+  
+  return(passed);
+}
+
+/**
+ * ags_deadline_clock_period_wakeup:
+ * @deadline_clock: the #AgsDeadlineClock
+ *
+ * Report a period of the device to @deadline_clock, it releases a slave
+ * waiting in ags_deadline_clock_wait().
+ *
+ * Since: 3.7.0
+ */
+void
+ags_deadline_clock_period_wakeup(AgsDeadlineClock *deadline_clock)
+{
+  if(deadline_clock == NULL){
+    return;
+  }
+
+  g_mutex_lock(&(deadline_clock->wakeup_mutex));
+
+  deadline_clock->pending_wakeup += 1;
+
+  g_cond_signal(&(deadline_clock->wakeup_cond));
+
+  g_mutex_unlock(&(deadline_clock->wakeup_mutex));
+}
@@ -0,0 +1,87 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __AGS_DEADLINE_CLOCK_H__
+#define __AGS_DEADLINE_CLOCK_H__
+
+#include <glib.h>
+#include <glib-object.h>
+
+G_BEGIN_DECLS
+
+#define AGS_DEADLINE_CLOCK(ptr) ((AgsDeadlineClock *)(ptr))
+
+#define AGS_DEADLINE_CLOCK_DEFAULT_PERIOD (11609977) // 512 frames at 44100 Hz in nsec
+
+typedef struct _AgsDeadlineClock AgsDeadlineClock;
+
+/**
+ * AgsDeadlineClockFlags:
+ * @AGS_DEADLINE_CLOCK_STARTED: the first deadline was anchored
+ * @AGS_DEADLINE_CLOCK_SLAVE: tics are driven by ags_deadline_clock_period_wakeup(), the
+ *   deadline serves as timeout only
+ *
+ * Enum values to control the behavior or indicate internal state of #AgsDeadlineClock by
+ * enable/disable as flags.
+ */
+typedef enum{
+  AGS_DEADLINE_CLOCK_STARTED      = 1,
+  AGS_DEADLINE_CLOCK_SLAVE        = 1 <<  1,
+}AgsDeadlineClockFlags;
+
+struct _AgsDeadlineClock
+{
+  volatile guint flags;
+
+  guint64 period;
+
+  gint64 deadline;
+
+  guint64 missed_count;
+
+  volatile guint pending_wakeup;
+
+  GMutex wakeup_mutex;
+  GCond wakeup_cond;
+};
+
+AgsDeadlineClock* ags_deadline_clock_alloc(guint64 period);
+void ags_deadline_clock_free(AgsDeadlineClock *deadline_clock);
+
+gboolean ags_deadline_clock_test_flags(AgsDeadlineClock *deadline_clock, guint flags);
+void ags_deadline_clock_set_flags(AgsDeadlineClock *deadline_clock, guint flags);
+void ags_deadline_clock_unset_flags(AgsDeadlineClock *deadline_clock, guint flags);
+
+gint64 ags_deadline_clock_get_monotonic_time();
+
+guint64 ags_deadline_clock_get_period(AgsDeadlineClock *deadline_clock);
+void ags_deadline_clock_set_period(AgsDeadlineClock *deadline_clock,
+				   guint64 period);
+void ags_deadline_clock_set_soundcard_period(AgsDeadlineClock *deadline_clock,
+					     guint samplerate,
+					     guint buffer_size);
+
+void ags_deadline_clock_start(AgsDeadlineClock *deadline_clock);
+guint ags_deadline_clock_wait(AgsDeadlineClock *deadline_clock);
+
+void ags_deadline_clock_period_wakeup(AgsDeadlineClock *deadline_clock);
+
+G_END_DECLS
+
+#endif /*__AGS_DEADLINE_CLOCK_H__*/
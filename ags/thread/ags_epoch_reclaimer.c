@@ -0,0 +1,438 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ags/thread/ags_epoch_reclaimer.h>
+
+void ags_epoch_reclaimer_retired_free(AgsEpochRetired *retired);
+
+GList* ags_epoch_reclaimer_advance(AgsEpochReclaimer *epoch_reclaimer,
+				   guint *count);
+
+/**
+ * SECTION:ags_epoch_reclaimer
+ * @short_description: epoch based reclamation
+ * @title: AgsEpochReclaimer
+ * @section_id:
+ * @include: ags/thread/ags_epoch_reclaimer.h
+ *
+ * The #AgsEpochReclaimer defers freeing of data, that was replaced by a
+ * writer, until no reader can access it anymore. Readers enclose their
+ * access by ags_epoch_reclaimer_enter() and ags_epoch_reclaimer_leave(),
+ * which doesn't take any lock.
+ *
+ * The global epoch is advanced by the writer as soon as nobody is
+ * reading in the previous epoch anymore. Data retired in epoch n is
+ * freed as the epoch reaches n + %AGS_EPOCH_RECLAIMER_GRACE_PERIOD.
+ * Since retiring happens only as the writer publishes, readers call
+ * ags_epoch_reclaimer_try_collect() after leaving, which never blocks.
+ *
+ * #AgsEpochArray is an immutable array of #GObject published that way.
+ * Readers iterate it without taking references.
+ */
+
+/**
+ * ags_epoch_reclaimer_alloc:
+ *
+ * Allocate #AgsEpochReclaimer.
+ *
+ * Returns: (transfer full): the new #AgsEpochReclaimer
+ *
+ * Since: 3.7.0
+ */
+AgsEpochReclaimer*
+ags_epoch_reclaimer_alloc()
+{
+  AgsEpochReclaimer *epoch_reclaimer;
+
+  epoch_reclaimer = (AgsEpochReclaimer *) g_malloc(sizeof(AgsEpochReclaimer));
+
+  epoch_reclaimer->epoch = 0;
+
+  epoch_reclaimer->active[0] = 0;
+  epoch_reclaimer->active[1] = 0;
+
+  g_mutex_init(&(epoch_reclaimer->retire_mutex));
+
+  epoch_reclaimer->retired_count = 0;
+  epoch_reclaimer->retired = NULL;
+
+  return(epoch_reclaimer);
+}
+
+/**
+ * ags_epoch_reclaimer_free:
+ * @epoch_reclaimer: the #AgsEpochReclaimer
+ *
+ * Free @epoch_reclaimer and all data retired to it. There must not be any
+ * reader left.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_epoch_reclaimer_free(AgsEpochReclaimer *epoch_reclaimer)
+{
+  if(epoch_reclaimer == NULL){
+    return;
+  }
+
+  g_list_free_full(epoch_reclaimer->retired,
+		   (GDestroyNotify) ags_epoch_reclaimer_retired_free);
+
+  g_mutex_clear(&(epoch_reclaimer->retire_mutex));
+
+  g_free(epoch_reclaimer);
+}
+
+void
+ags_epoch_reclaimer_retired_free(AgsEpochRetired *retired)
+{
+  if(retired->destroy_func != NULL){
+    retired->destroy_func(retired->data);
+  }
+
+  g_free(retired);
+}
+
+GList*
+ags_epoch_reclaimer_advance(AgsEpochReclaimer *epoch_reclaimer,
+			    guint *count)
+{
+  GList *list, *next;
+  GList *start_garbage;
+
+  guint epoch;
+  guint i;
+
+  start_garbage = NULL;
+  count[0] = 0;
+  
+  /* advance - nobody may read in the previous epoch */
+  for(i = 0; i < AGS_EPOCH_RECLAIMER_GRACE_PERIOD; i++){
+    epoch = g_atomic_int_get(&(epoch_reclaimer->epoch));
+
+    if(g_atomic_int_get(&(epoch_reclaimer->active[(epoch + 1) % 2])) != 0){
+      break;
+    }
+
+    g_atomic_int_set(&(epoch_reclaimer->epoch),
+		     epoch + 1);
+  }
+
+  epoch = g_atomic_int_get(&(epoch_reclaimer->epoch));
+
+  /* collect */
+  list = epoch_reclaimer->retired;
+
+  while(list != NULL){
+    next = list->next;
+
+    if(epoch - AGS_EPOCH_RETIRED(list->data)->epoch >= AGS_EPOCH_RECLAIMER_GRACE_PERIOD){
+      epoch_reclaimer->retired = g_list_remove_link(epoch_reclaimer->retired,
+						    list);
+      start_garbage = g_list_concat(list,
+				    start_garbage);
+
+      count[0] += 1;
+    }
+
+    list = next;
+  }
+
+  g_atomic_int_add(&(epoch_reclaimer->retired_count),
+		   -1 * (gint) count[0]);
+
+  return(start_garbage);
+}
+
+/**
+ * ags_epoch_reclaimer_enter:
+ * @epoch_reclaimer: the #AgsEpochReclaimer
+ *
+ * Enter read side critical section of @epoch_reclaimer.
+ *
+ * Returns: the epoch to pass to ags_epoch_reclaimer_leave()
+ *
+ * Since: 3.7.0
+ */
+guint
+ags_epoch_reclaimer_enter(AgsEpochReclaimer *epoch_reclaimer)
+{
+  guint epoch;
+
+  if(epoch_reclaimer == NULL){
+    return(0);
+  }
+
+  /* retry if the epoch advanced before we were counted */
+  for(;;){
+    epoch = g_atomic_int_get(&(epoch_reclaimer->epoch));
+
+    g_atomic_int_inc(&(epoch_reclaimer->active[epoch % 2]));
+
+    if(g_atomic_int_get(&(epoch_reclaimer->epoch)) == epoch){
+      break;
+    }
+
+    g_atomic_int_add(&(epoch_reclaimer->active[epoch % 2]),
+		     -1);
+  }
+
+  return(epoch);
+}
+
+/**
+ * ags_epoch_reclaimer_leave:
+ * @epoch_reclaimer: the #AgsEpochReclaimer
+ * @epoch: the epoch returned by ags_epoch_reclaimer_enter()
+ *
+ * Leave read side critical section of @epoch_reclaimer.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_epoch_reclaimer_leave(AgsEpochReclaimer *epoch_reclaimer,
+			  guint epoch)
+{
+  if(epoch_reclaimer == NULL){
+    return;
+  }
+
+  g_atomic_int_add(&(epoch_reclaimer->active[epoch % 2]),
+		   -1);
+}
+
+/**
+ * ags_epoch_reclaimer_retire:
+ * @epoch_reclaimer: the #AgsEpochReclaimer
+ * @data: the data not reachable by new readers anymore
+ * @destroy_func: the #GDestroyNotify to free @data
+ *
+ * Retire @data, it is freed as soon as all readers, that might still access
+ * it, left. Retiring collects garbage, too.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_epoch_reclaimer_retire(AgsEpochReclaimer *epoch_reclaimer,
+			   gpointer data, GDestroyNotify destroy_func)
+{
+  AgsEpochRetired *retired;
+
+  if(epoch_reclaimer == NULL ||
+     data == NULL){
+    return;
+  }
+
+  retired = (AgsEpochRetired *) g_malloc(sizeof(AgsEpochRetired));
+
+  retired->data = data;
+  retired->destroy_func = destroy_func;
+
+  g_mutex_lock(&(epoch_reclaimer->retire_mutex));
+
+  retired->epoch = g_atomic_int_get(&(epoch_reclaimer->epoch));
+
+  epoch_reclaimer->retired = g_list_prepend(epoch_reclaimer->retired,
+					    retired);
+  g_atomic_int_inc(&(epoch_reclaimer->retired_count));
+
+  g_mutex_unlock(&(epoch_reclaimer->retire_mutex));
+
+  ags_epoch_reclaimer_collect(epoch_reclaimer);
+}
+
+/**
+ * ags_epoch_reclaimer_collect:
+ * @epoch_reclaimer: the #AgsEpochReclaimer
+ *
+ * Advance the epoch of @epoch_reclaimer as far as readers permit and free
+ * all retired data out of reach. Never blocks on readers.
+ *
+ * Returns: the count of freed data
+ *
+ * Since: 3.7.0
+ */
+guint
+ags_epoch_reclaimer_collect(AgsEpochReclaimer *epoch_reclaimer)
+{
+  GList *start_garbage;
+
+  guint count;
+
+  if(epoch_reclaimer == NULL){
+    return(0);
+  }
+
+  g_mutex_lock(&(epoch_reclaimer->retire_mutex));
+
+  start_garbage = ags_epoch_reclaimer_advance(epoch_reclaimer,
+					      &count);
+
+  g_mutex_unlock(&(epoch_reclaimer->retire_mutex));
+
+  /* free outside of lock */
+  g_list_free_full(start_garbage,
+		   (GDestroyNotify) ags_epoch_reclaimer_retired_free);
+
+  return(count);
+}
+
+/**
+ * ags_epoch_reclaimer_try_collect:
+ * @epoch_reclaimer: the #AgsEpochReclaimer
+ *
+ * Like ags_epoch_reclaimer_collect(), but returns immediately if nothing
+ * was retired or an other thread retires or collects right now. Call it on
+ * the reader side after ags_epoch_reclaimer_leave(), so data retired while
+ * readers were active doesn't wait for the next retire.
+ *
+ * Returns: the count of freed data
+ *
+ * Since: 3.7.0
+ */
+guint
+ags_epoch_reclaimer_try_collect(AgsEpochReclaimer *epoch_reclaimer)
+{
+  GList *start_garbage;
+
+  guint count;
+
+  if(epoch_reclaimer == NULL ||
+     g_atomic_int_get(&(epoch_reclaimer->retired_count)) == 0){
+    return(0);
+  }
+
+  if(!g_mutex_trylock(&(epoch_reclaimer->retire_mutex))){
+    return(0);
+  }
+
+  start_garbage = ags_epoch_reclaimer_advance(epoch_reclaimer,
+					      &count);
+
+  g_mutex_unlock(&(epoch_reclaimer->retire_mutex));
+
+  /* free outside of lock */
+  g_list_free_full(start_garbage,
+		   (GDestroyNotify) ags_epoch_reclaimer_retired_free);
+
+  return(count);
+}
+
+/**
+ * ags_epoch_array_alloc:
+ * @version: the version
+ * @list: (element-type GObject) (transfer none): the #GList-struct of #GObject
+ *
+ * Allocate #AgsEpochArray containing the objects of @list, each of them
+ * is referenced once for the lifetime of the array.
+ *
+ * Returns: (transfer full): the new #AgsEpochArray
+ *
+ * Since: 3.7.0
+ */
+AgsEpochArray*
+ags_epoch_array_alloc(guint version,
+		      GList *list)
+{
+  AgsEpochArray *epoch_array;
+
+  guint i;
+
+  epoch_array = (AgsEpochArray *) g_malloc(sizeof(AgsEpochArray));
+
+  epoch_array->version = version;
+
+  epoch_array->length = g_list_length(list);
+  epoch_array->data = NULL;
+
+  if(epoch_array->length > 0){
+    epoch_array->data = (GObject **) g_malloc(epoch_array->length * sizeof(GObject *));
+  }
+
+  for(i = 0; list != NULL; i++){
+    epoch_array->data[i] = g_object_ref(list->data);
+
+    list = list->next;
+  }
+
+  return(epoch_array);
+}
+
+/**
+ * ags_epoch_array_free:
+ * @epoch_array: the #AgsEpochArray
+ *
+ * Free @epoch_array and unref its objects.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_epoch_array_free(AgsEpochArray *epoch_array)
+{
+  guint i;
+
+  if(epoch_array == NULL){
+    return;
+  }
+
+  for(i = 0; i < epoch_array->length; i++){
+    g_object_unref(epoch_array->data[i]);
+  }
+
+  g_free(epoch_array->data);
+
+  g_free(epoch_array);
+}
+
+/**
+ * ags_epoch_array_publish:
+ * @epoch_array: (inout): the location of the published #AgsEpochArray
+ * @list: (element-type GObject) (transfer none): the #GList-struct of #GObject
+ * @epoch_reclaimer: the #AgsEpochReclaimer the readers of @epoch_array use
+ *
+ * Publish a new version of @epoch_array containing @list and retire the
+ * previous one to @epoch_reclaimer. Writers have to be serialized by the
+ * caller.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_epoch_array_publish(AgsEpochArray **epoch_array,
+			GList *list,
+			AgsEpochReclaimer *epoch_reclaimer)
+{
+  AgsEpochArray *old_epoch_array, *new_epoch_array;
+
+  if(epoch_array == NULL){
+    return;
+  }
+
+  old_epoch_array = g_atomic_pointer_get(epoch_array);
+  
+  new_epoch_array = ags_epoch_array_alloc(((old_epoch_array != NULL) ? old_epoch_array->version + 1: 0),
+					  list);
+
+  g_atomic_pointer_set(epoch_array,
+		       new_epoch_array);
+
+  if(old_epoch_array != NULL){
+    ags_epoch_reclaimer_retire(epoch_reclaimer,
+			       old_epoch_array, (GDestroyNotify) ags_epoch_array_free);
+  }
+}
@@ -0,0 +1,89 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __AGS_EPOCH_RECLAIMER_H__
+#define __AGS_EPOCH_RECLAIMER_H__
+
+#include <glib.h>
+#include <glib-object.h>
+
+G_BEGIN_DECLS
+
+#define AGS_EPOCH_RECLAIMER(ptr) ((AgsEpochReclaimer *)(ptr))
+#define AGS_EPOCH_RETIRED(ptr) ((AgsEpochRetired *)(ptr))
+#define AGS_EPOCH_ARRAY(ptr) ((AgsEpochArray *)(ptr))
+
+#define AGS_EPOCH_RECLAIMER_GRACE_PERIOD (2)
+
+typedef struct _AgsEpochReclaimer AgsEpochReclaimer;
+typedef struct _AgsEpochRetired AgsEpochRetired;
+typedef struct _AgsEpochArray AgsEpochArray;
+
+struct _AgsEpochReclaimer
+{
+  volatile guint epoch;
+  volatile gint active[2];
+
+  GMutex retire_mutex;
+
+  volatile gint retired_count;
+  GList *retired;
+};
+
+struct _AgsEpochRetired
+{
+  guint epoch;
+
+  gpointer data;
+  GDestroyNotify destroy_func;
+};
+
+struct _AgsEpochArray
+{
+  guint version;
+
+  guint length;
+  GObject **data;
+};
+
+/* epoch reclaimer */
+AgsEpochReclaimer* ags_epoch_reclaimer_alloc();
+void ags_epoch_reclaimer_free(AgsEpochReclaimer *epoch_reclaimer);
+
+guint ags_epoch_reclaimer_enter(AgsEpochReclaimer *epoch_reclaimer);
+void ags_epoch_reclaimer_leave(AgsEpochReclaimer *epoch_reclaimer,
+			       guint epoch);
+
+void ags_epoch_reclaimer_retire(AgsEpochReclaimer *epoch_reclaimer,
+				gpointer data, GDestroyNotify destroy_func);
+guint ags_epoch_reclaimer_collect(AgsEpochReclaimer *epoch_reclaimer);
+guint ags_epoch_reclaimer_try_collect(AgsEpochReclaimer *epoch_reclaimer);
+
+/* epoch array */
+AgsEpochArray* ags_epoch_array_alloc(guint version,
+				     GList *list);
+void ags_epoch_array_free(AgsEpochArray *epoch_array);
+
+void ags_epoch_array_publish(AgsEpochArray **epoch_array,
+			     GList *list,
+			     AgsEpochReclaimer *epoch_reclaimer);
+
+G_END_DECLS
+
+#endif /*__AGS_EPOCH_RECLAIMER_H__*/
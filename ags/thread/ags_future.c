@@ -0,0 +1,366 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ags/thread/ags_future.h>
+
+/**
+ * SECTION:ags_future
+ * @short_description: result of an asynchronous job
+ * @title: AgsFuture
+ * @section_id:
+ * @include: ags/thread/ags_future.h
+ *
+ * The #AgsFuture is returned by ags_job_pool_submit(). You can wait for the
+ * result, poll it or add a callback that is invoked as the job completes.
+ * Callbacks run in the thread completing the job, or immediately if the
+ * future is already done.
+ *
+ * Cancelling a future prevents a job that didn't start yet from running.
+ * A running job might poll %AGS_FUTURE_CANCELLED and return early.
+ */
+
+GType
+ags_future_get_type()
+{
+  static volatile gsize g_define_type_id__volatile = 0;
+
+  if(g_once_init_enter (&g_define_type_id__volatile)){
+    GType ags_type_future = 0;
+
+    ags_type_future =
+      g_boxed_type_register_static("AgsFuture",
+				   (GBoxedCopyFunc) ags_future_ref,
+				   (GBoxedFreeFunc) ags_future_unref);
+
+    g_once_init_leave(&g_define_type_id__volatile, ags_type_future);
+  }
+
+  return g_define_type_id__volatile;
+}
+
+/**
+ * ags_future_alloc:
+ *
+ * Allocate #AgsFuture.
+ *
+ * Returns: (transfer full): the new #AgsFuture
+ *
+ * Since: 3.7.0
+ */
+AgsFuture*
+ags_future_alloc()
+{
+  AgsFuture *future;
+
+  future = (AgsFuture *) g_malloc(sizeof(AgsFuture));
+
+  future->ref_count = 1;
+
+  future->flags = 0;
+
+  g_mutex_init(&(future->mutex));
+  g_cond_init(&(future->cond));
+
+  future->result = NULL;
+
+  future->callback = NULL;
+  
+  return(future);
+}
+
+/**
+ * ags_future_ref:
+ * @future: the #AgsFuture
+ *
+ * Increase reference count of @future.
+ *
+ * Returns: (transfer none): the #AgsFuture
+ *
+ * Since: 3.7.0
+ */
+AgsFuture*
+ags_future_ref(AgsFuture *future)
+{
+  if(future == NULL){
+    return(NULL);
+  }
+
+  g_atomic_int_inc(&(future->ref_count));
+
+  return(future);
+}
+
+/**
+ * ags_future_unref:
+ * @future: the #AgsFuture
+ *
+ * Decrease reference count of @future and free it if the count drops to 0.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_future_unref(AgsFuture *future)
+{
+  if(future == NULL){
+    return;
+  }
+
+  if(g_atomic_int_dec_and_test(&(future->ref_count))){
+    g_mutex_clear(&(future->mutex));
+    g_cond_clear(&(future->cond));
+
+    g_list_free_full(future->callback,
+		     g_free);
+    
+    g_free(future);
+  }
+}
+
+/**
+ * ags_future_test_flags:
+ * @future: the #AgsFuture
+ * @flags: the flags
+ *
+ * Test @flags to be set on @future.
+ * 
+ * Returns: %TRUE if flags are set, else %FALSE
+ *
+ * Since: 3.7.0
+ */
+gboolean
+ags_future_test_flags(AgsFuture *future, guint flags)
+{
+  if(future == NULL){
+    return(FALSE);
+  }
+
+  return(((flags & (g_atomic_int_get(&(future->flags)))) != 0) ? TRUE: FALSE);
+}
+
+/**
+ * ags_future_add_callback:
+ * @future: the #AgsFuture
+ * @func: the #AgsFutureFunc
+ * @user_data: the user data
+ *
+ * Add @func to be invoked as @future is done. If @future is already done,
+ * @func is invoked immediately by the calling thread.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_future_add_callback(AgsFuture *future,
+			AgsFutureFunc func,
+			gpointer user_data)
+{
+  AgsFutureCallback *callback;
+
+  if(future == NULL ||
+     func == NULL){
+    return;
+  }
+
+  g_mutex_lock(&(future->mutex));
+
+  if(!ags_future_test_flags(future, AGS_FUTURE_DONE)){
+    callback = (AgsFutureCallback *) g_malloc(sizeof(AgsFutureCallback));
+
+    callback->func = func;
+    callback->user_data = user_data;
+
+    future->callback = g_list_append(future->callback,
+				     callback);
+    
+    g_mutex_unlock(&(future->mutex));
+
+    return;
+  }
+  
+  g_mutex_unlock(&(future->mutex));
+
+  func(future,
+       user_data);
+}
+
+/**
+ * ags_future_complete:
+ * @future: the #AgsFuture
+ * @result: the result
+ *
+ * Complete @future with @result, wake up all waiting threads and invoke
+ * the callbacks.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_future_complete(AgsFuture *future,
+		    gpointer result)
+{
+  GList *start_callback, *callback;
+
+  if(future == NULL){
+    return;
+  }
+
+  g_mutex_lock(&(future->mutex));
+
+  if(ags_future_test_flags(future, AGS_FUTURE_DONE)){
+    g_mutex_unlock(&(future->mutex));
+
+    return;
+  }
+  
+  future->result = result;
+
+  g_atomic_int_or(&(future->flags),
+		  AGS_FUTURE_DONE);
+
+  start_callback = future->callback;
+  future->callback = NULL;
+  
+  g_cond_broadcast(&(future->cond));
+  
+  g_mutex_unlock(&(future->mutex));
+
+  /* invoke callbacks */
+  callback = start_callback;
+
+  while(callback != NULL){
+    AGS_FUTURE_CALLBACK(callback->data)->func(future,
+					      AGS_FUTURE_CALLBACK(callback->data)->user_data);
+
+    callback = callback->next;
+  }
+
+  g_list_free_full(start_callback,
+		   g_free);
+}
+
+/**
+ * ags_future_cancel:
+ * @future: the #AgsFuture
+ *
+ * Cancel @future. A job that didn't start won't run and its future completes
+ * with %NULL result.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_future_cancel(AgsFuture *future)
+{
+  if(future == NULL){
+    return;
+  }
+
+  g_atomic_int_or(&(future->flags),
+		  AGS_FUTURE_CANCELLED);
+}
+
+/**
+ * ags_future_is_done:
+ * @future: the #AgsFuture
+ *
+ * Check if @future is done.
+ *
+ * Returns: %TRUE if done, otherwise %FALSE
+ *
+ * Since: 3.7.0
+ */
+gboolean
+ags_future_is_done(AgsFuture *future)
+{
+  return(ags_future_test_flags(future, AGS_FUTURE_DONE));
+}
+
+/**
+ * ags_future_wait:
+ * @future: the #AgsFuture
+ *
+ * Wait for @future to be done.
+ *
+ * Returns: (transfer none): the result
+ *
+ * Since: 3.7.0
+ */
+gpointer
+ags_future_wait(AgsFuture *future)
+{
+  gpointer result;
+  
+  if(future == NULL){
+    return(NULL);
+  }
+
+  g_mutex_lock(&(future->mutex));
+
+  while(!ags_future_test_flags(future, AGS_FUTURE_DONE)){
+    g_cond_wait(&(future->cond),
+		&(future->mutex));
+  }
+
+  result = future->result;
+  
+  g_mutex_unlock(&(future->mutex));
+
+  return(result);
+}
+
+/**
+ * ags_future_wait_until:
+ * @future: the #AgsFuture
+ * @end_time: the monotonic time to wait until
+ * @result: (out) (transfer none): return location of the result
+ *
+ * Wait for @future to be done, but at most until @end_time.
+ *
+ * Returns: %TRUE if done, %FALSE on timeout
+ *
+ * Since: 3.7.0
+ */
+gboolean
+ags_future_wait_until(AgsFuture *future,
+		      gint64 end_time,
+		      gpointer *result)
+{
+  gboolean is_done;
+  
+  if(future == NULL){
+    return(FALSE);
+  }
+
+  g_mutex_lock(&(future->mutex));
+
+  while(!ags_future_test_flags(future, AGS_FUTURE_DONE)){
+    if(!g_cond_wait_until(&(future->cond),
+			  &(future->mutex),
+			  end_time)){
+      break;
+    }
+  }
+
+  is_done = ags_future_test_flags(future, AGS_FUTURE_DONE);
+
+  if(result != NULL){
+    result[0] = (is_done) ? future->result: NULL;
+  }
+  
+  g_mutex_unlock(&(future->mutex));
+
+  return(is_done);
+}
@@ -0,0 +1,96 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __AGS_FUTURE_H__
+#define __AGS_FUTURE_H__
+
+#include <glib.h>
+#include <glib-object.h>
+
+G_BEGIN_DECLS
+
+#define AGS_TYPE_FUTURE         (ags_future_get_type())
+#define AGS_FUTURE(ptr) ((AgsFuture *)(ptr))
+#define AGS_FUTURE_CALLBACK(ptr) ((AgsFutureCallback *)(ptr))
+
+typedef struct _AgsFuture AgsFuture;
+typedef struct _AgsFutureCallback AgsFutureCallback;
+
+typedef void (*AgsFutureFunc)(AgsFuture *future,
+			      gpointer user_data);
+
+/**
+ * AgsFutureFlags:
+ * @AGS_FUTURE_DONE: the job completed and the result is available
+ * @AGS_FUTURE_CANCELLED: the job was cancelled
+ *
+ * Enum values to indicate the state of #AgsFuture.
+ */
+typedef enum{
+  AGS_FUTURE_DONE        = 1,
+  AGS_FUTURE_CANCELLED   = 1 <<  1,
+}AgsFutureFlags;
+
+struct _AgsFuture
+{
+  volatile gint ref_count;
+
+  volatile guint flags;
+
+  GMutex mutex;
+  GCond cond;
+
+  gpointer result;
+
+  GList *callback;
+};
+
+struct _AgsFutureCallback
+{
+  AgsFutureFunc func;
+  gpointer user_data;
+};
+
+GType ags_future_get_type();
+
+AgsFuture* ags_future_alloc();
+
+AgsFuture* ags_future_ref(AgsFuture *future);
+void ags_future_unref(AgsFuture *future);
+
+gboolean ags_future_test_flags(AgsFuture *future, guint flags);
+
+void ags_future_add_callback(AgsFuture *future,
+			     AgsFutureFunc func,
+			     gpointer user_data);
+
+void ags_future_complete(AgsFuture *future,
+			 gpointer result);
+void ags_future_cancel(AgsFuture *future);
+
+gboolean ags_future_is_done(AgsFuture *future);
+
+gpointer ags_future_wait(AgsFuture *future);
+gboolean ags_future_wait_until(AgsFuture *future,
+			       gint64 end_time,
+			       gpointer *result);
+
+G_END_DECLS
+
+#endif /*__AGS_FUTURE_H__*/
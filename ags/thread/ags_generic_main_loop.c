@@ -169,6 +169,9 @@ ags_generic_main_loop_init(AgsGenericMainLoop *generic_main_loop)
   g_object_set(thread,
 	       "frequency", AGS_GENERIC_MAIN_LOOP_DEFAULT_JIFFIE,
 	       NULL);
+
+  /* tic barrier - all synced threads arrive at the main loop's */
+  thread->tic_barrier = ags_tic_barrier_alloc(AGS_TIC_BARRIER_DEFAULT_SPIN_COUNT);
   
   /* tree lock mutex */
   g_rec_mutex_init(&(generic_main_loop->tree_lock));
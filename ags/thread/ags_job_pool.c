@@ -0,0 +1,772 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ags/thread/ags_job_pool.h>
+
+#include <ags/object/ags_config.h>
+
+#include <ags/thread/ags_cpu_affinity.h>
+
+#include <ags/i18n.h>
+
+void ags_job_pool_class_init(AgsJobPoolClass *job_pool);
+void ags_job_pool_init(AgsJobPool *job_pool);
+void ags_job_pool_set_property(GObject *gobject,
+			       guint prop_id,
+			       const GValue *value,
+			       GParamSpec *param_spec);
+void ags_job_pool_get_property(GObject *gobject,
+			       guint prop_id,
+			       GValue *value,
+			       GParamSpec *param_spec);
+void ags_job_pool_finalize(GObject *gobject);
+
+AgsJobPoolJob* ags_job_pool_take_job(AgsJobPool *job_pool,
+				     guint nth_worker);
+void ags_job_pool_run_job(AgsJobPoolJob *job);
+
+void* ags_job_pool_worker_run(void *ptr);
+
+/**
+ * SECTION:ags_job_pool
+ * @short_description: shared background worker pool
+ * @title: AgsJobPool
+ * @section_id:
+ * @include: ags/thread/ags_job_pool.h
+ *
+ * The #AgsJobPool runs background jobs like loading samples on a fixed
+ * number of workers, by default one per processor, instead of a thread
+ * per job. Jobs submitted from outside the pool go to a shared injection
+ * queue. Jobs submitted by a running job go to the worker's own deque, which
+ * it pops last in first out. Idle workers steal the oldest job of the others.
+ *
+ * Every job returns an #AgsFuture to wait for, poll or attach a callback to.
+ */
+
+enum{
+  PROP_0,
+  PROP_WORKER_COUNT,
+};
+
+static gpointer ags_job_pool_parent_class = NULL;
+
+static AgsJobPool *ags_job_pool = NULL;
+
+static GPrivate ags_job_pool_worker_deque;
+
+GType
+ags_job_pool_get_type()
+{
+  static volatile gsize g_define_type_id__volatile = 0;
+
+  if(g_once_init_enter (&g_define_type_id__volatile)){
+    GType ags_type_job_pool = 0;
+
+    static const GTypeInfo ags_job_pool_info = {
+      sizeof(AgsJobPoolClass),
+      NULL, /* base_init */
+      NULL, /* base_finalize */
+      (GClassInitFunc) ags_job_pool_class_init,
+      NULL, /* class_finalize */
+      NULL, /* class_data */
+      sizeof(AgsJobPool),
+      0,    /* n_preallocs */
+      (GInstanceInitFunc) ags_job_pool_init,
+    };
+
+    ags_type_job_pool = g_type_register_static(G_TYPE_OBJECT,
+					       "AgsJobPool",
+					       &ags_job_pool_info,
+					       0);
+
+    g_once_init_leave(&g_define_type_id__volatile, ags_type_job_pool);
+  }
+
+  return g_define_type_id__volatile;
+}
+
+void
+ags_job_pool_class_init(AgsJobPoolClass *job_pool)
+{
+  GObjectClass *gobject;
+
+  GParamSpec *param_spec;
+
+  ags_job_pool_parent_class = g_type_class_peek_parent(job_pool);
+
+  /* GObjectClass */
+  gobject = (GObjectClass *) job_pool;
+
+  gobject->set_property = ags_job_pool_set_property;
+  gobject->get_property = ags_job_pool_get_property;
+
+  gobject->finalize = ags_job_pool_finalize;
+
+  /* properties */
+  /**
+   * AgsJobPool:worker-count:
+   *
+   * The count of workers, it is applied as the workers are started.
+   * 
+   * Since: 3.7.0
+   */
+  param_spec = g_param_spec_uint("worker-count",
+				 i18n_pspec("worker count"),
+				 i18n_pspec("The count of workers"),
+				 1,
+				 G_MAXUINT32,
+				 1,
+				 G_PARAM_READABLE | G_PARAM_WRITABLE);
+  g_object_class_install_property(gobject,
+				  PROP_WORKER_COUNT,
+				  param_spec);
+}
+
+void
+ags_job_pool_init(AgsJobPool *job_pool)
+{
+  AgsConfig *config;
+
+  gchar *str;
+
+  job_pool->flags = 0;
+
+  g_rec_mutex_init(&(job_pool->obj_mutex));
+
+  /* workers */
+  config = ags_config_get_instance();
+  
+  job_pool->worker_count = g_get_num_processors();
+
+  str = ags_config_get_value(config,
+			     AGS_CONFIG_THREAD,
+			     "job-pool-worker-count");
+
+  if(str != NULL){
+    job_pool->worker_count = g_ascii_strtoull(str,
+					      NULL,
+					      10);
+
+    g_free(str);
+  }
+  
+  if(job_pool->worker_count == 0){
+    job_pool->worker_count = 1;
+  }
+  
+  job_pool->worker = NULL;
+
+  /* queues */
+  job_pool->deque = NULL;
+
+  g_mutex_init(&(job_pool->injection.mutex));
+  g_queue_init(&(job_pool->injection.queue));
+
+  job_pool->job_count = 0;
+
+  g_mutex_init(&(job_pool->wakeup_mutex));
+  g_cond_init(&(job_pool->wakeup_cond));
+}
+
+void
+ags_job_pool_set_property(GObject *gobject,
+			  guint prop_id,
+			  const GValue *value,
+			  GParamSpec *param_spec)
+{
+  AgsJobPool *job_pool;
+
+  GRecMutex *job_pool_mutex;
+
+  job_pool = AGS_JOB_POOL(gobject);
+
+  /* get job pool mutex */
+  job_pool_mutex = AGS_JOB_POOL_GET_OBJ_MUTEX(job_pool);
+
+  switch(prop_id){
+  case PROP_WORKER_COUNT:
+    {
+      guint worker_count;
+
+      worker_count = g_value_get_uint(value);
+
+      g_rec_mutex_lock(job_pool_mutex);
+
+      if((AGS_JOB_POOL_RUNNING & (job_pool->flags)) == 0 &&
+	 worker_count > 0){
+	job_pool->worker_count = worker_count;
+      }
+
+      g_rec_mutex_unlock(job_pool_mutex);
+    }
+    break;
+  default:
+    G_OBJECT_WARN_INVALID_PROPERTY_ID(gobject, prop_id, param_spec);
+    break;
+  }
+}
+
+void
+ags_job_pool_get_property(GObject *gobject,
+			  guint prop_id,
+			  GValue *value,
+			  GParamSpec *param_spec)
+{
+  AgsJobPool *job_pool;
+
+  GRecMutex *job_pool_mutex;
+
+  job_pool = AGS_JOB_POOL(gobject);
+
+  /* get job pool mutex */
+  job_pool_mutex = AGS_JOB_POOL_GET_OBJ_MUTEX(job_pool);
+
+  switch(prop_id){
+  case PROP_WORKER_COUNT:
+    {
+      g_rec_mutex_lock(job_pool_mutex);
+
+      g_value_set_uint(value, job_pool->worker_count);
+
+      g_rec_mutex_unlock(job_pool_mutex);
+    }
+    break;
+  default:
+    G_OBJECT_WARN_INVALID_PROPERTY_ID(gobject, prop_id, param_spec);
+    break;
+  }
+}
+
+void
+ags_job_pool_finalize(GObject *gobject)
+{
+  AgsJobPool *job_pool;
+
+  job_pool = AGS_JOB_POOL(gobject);
+
+  ags_job_pool_stop(job_pool);
+
+  g_mutex_clear(&(job_pool->injection.mutex));
+
+  g_mutex_clear(&(job_pool->wakeup_mutex));
+  g_cond_clear(&(job_pool->wakeup_cond));
+
+  if(job_pool == ags_job_pool){
+    ags_job_pool = NULL;
+  }
+
+  /* call parent */
+  G_OBJECT_CLASS(ags_job_pool_parent_class)->finalize(gobject);
+}
+
+/**
+ * ags_job_pool_test_flags:
+ * @job_pool: the #AgsJobPool
+ * @flags: the flags
+ *
+ * Test @flags to be set on @job_pool.
+ *
+ * Returns: %TRUE if flags are set, else %FALSE
+ *
+ * Since: 3.7.0
+ */
+gboolean
+ags_job_pool_test_flags(AgsJobPool *job_pool, guint flags)
+{
+  gboolean retval;
+
+  GRecMutex *job_pool_mutex;
+
+  if(!AGS_IS_JOB_POOL(job_pool)){
+    return(FALSE);
+  }
+
+  /* get job pool mutex */
+  job_pool_mutex = AGS_JOB_POOL_GET_OBJ_MUTEX(job_pool);
+
+  /* test */
+  g_rec_mutex_lock(job_pool_mutex);
+
+  retval = (flags & (job_pool->flags)) ? TRUE: FALSE;
+
+  g_rec_mutex_unlock(job_pool_mutex);
+
+  return(retval);
+}
+
+/**
+ * ags_job_pool_set_flags:
+ * @job_pool: the #AgsJobPool
+ * @flags: see #AgsJobPoolFlags-enum
+ *
+ * Enable a feature of @job_pool.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_job_pool_set_flags(AgsJobPool *job_pool, guint flags)
+{
+  GRecMutex *job_pool_mutex;
+
+  if(!AGS_IS_JOB_POOL(job_pool)){
+    return;
+  }
+
+  /* get job pool mutex */
+  job_pool_mutex = AGS_JOB_POOL_GET_OBJ_MUTEX(job_pool);
+
+  /* set flags */
+  g_rec_mutex_lock(job_pool_mutex);
+
+  job_pool->flags |= flags;
+
+  g_rec_mutex_unlock(job_pool_mutex);
+}
+
+/**
+ * ags_job_pool_unset_flags:
+ * @job_pool: the #AgsJobPool
+ * @flags: see #AgsJobPoolFlags-enum
+ *
+ * Disable a feature of @job_pool.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_job_pool_unset_flags(AgsJobPool *job_pool, guint flags)
+{
+  GRecMutex *job_pool_mutex;
+
+  if(!AGS_IS_JOB_POOL(job_pool)){
+    return;
+  }
+
+  /* get job pool mutex */
+  job_pool_mutex = AGS_JOB_POOL_GET_OBJ_MUTEX(job_pool);
+
+  /* unset flags */
+  g_rec_mutex_lock(job_pool_mutex);
+
+  job_pool->flags &= (~flags);
+
+  g_rec_mutex_unlock(job_pool_mutex);
+}
+
+/**
+ * ags_job_pool_get_worker_count:
+ * @job_pool: the #AgsJobPool
+ *
+ * Get worker count of @job_pool.
+ *
+ * Returns: the count of workers
+ *
+ * Since: 3.7.0
+ */
+guint
+ags_job_pool_get_worker_count(AgsJobPool *job_pool)
+{
+  guint worker_count;
+
+  if(!AGS_IS_JOB_POOL(job_pool)){
+    return(0);
+  }
+
+  g_object_get(job_pool,
+	       "worker-count", &worker_count,
+	       NULL);
+
+  return(worker_count);
+}
+
+AgsJobPoolJob*
+ags_job_pool_take_job(AgsJobPool *job_pool,
+		      guint nth_worker)
+{
+  AgsJobPoolJob *job;
+
+  guint worker_count;
+  guint i;
+
+  worker_count = job_pool->worker_count;
+  
+  /* own deque, newest first */
+  g_mutex_lock(&(job_pool->deque[nth_worker].mutex));
+
+  job = g_queue_pop_tail(&(job_pool->deque[nth_worker].queue));
+  
+  g_mutex_unlock(&(job_pool->deque[nth_worker].mutex));
+
+  /* injection queue */
+  if(job == NULL){
+    g_mutex_lock(&(job_pool->injection.mutex));
+
+    job = g_queue_pop_head(&(job_pool->injection.queue));
+  
+    g_mutex_unlock(&(job_pool->injection.mutex));
+  }
+
+  /* steal oldest */
+  for(i = 1; job == NULL && i < worker_count; i++){
+    AgsJobPoolDeque *deque;
+
+    deque = &(job_pool->deque[(nth_worker + i) % worker_count]);
+    
+    g_mutex_lock(&(deque->mutex));
+
+    job = g_queue_pop_head(&(deque->queue));
+  
+    g_mutex_unlock(&(deque->mutex));
+  }
+
+  if(job != NULL){
+    g_atomic_int_add(&(job_pool->job_count),
+		     -1);
+  }
+  
+  return(job);
+}
+
+void
+ags_job_pool_run_job(AgsJobPoolJob *job)
+{
+  gpointer result;
+
+  result = NULL;
+  
+  if(!ags_future_test_flags(job->future, AGS_FUTURE_CANCELLED)){
+    result = job->job_func(job->future,
+			   job->data);
+  }
+
+  ags_future_complete(job->future,
+		      result);
+
+  if(job->data_destroy != NULL){
+    job->data_destroy(job->data);
+  }
+
+  ags_future_unref(job->future);
+
+  g_free(job);
+}
+
+void*
+ags_job_pool_worker_run(void *ptr)
+{
+  AgsJobPool *job_pool;
+  AgsJobPoolJob *job;
+
+  guint nth_worker;
+  
+  job_pool = AGS_JOB_POOL(((gpointer *) ptr)[0]);
+  nth_worker = GPOINTER_TO_UINT(((gpointer *) ptr)[1]);
+
+  g_free(ptr);
+
+  /* keep background work off the realtime CPUs */
+  ags_cpu_affinity_setup(AGS_CPU_AFFINITY_KEY_JOB_POOL);
+  
+  g_private_set(&ags_job_pool_worker_deque,
+		&(job_pool->deque[nth_worker]));
+
+  while(ags_job_pool_test_flags(job_pool, AGS_JOB_POOL_RUNNING)){
+    job = ags_job_pool_take_job(job_pool,
+				nth_worker);
+
+    if(job != NULL){
+      ags_job_pool_run_job(job);
+      
+      continue;
+    }
+
+    /* wait for jobs */
+    g_mutex_lock(&(job_pool->wakeup_mutex));
+
+    while(g_atomic_int_get(&(job_pool->job_count)) <= 0 &&
+	  ags_job_pool_test_flags(job_pool, AGS_JOB_POOL_RUNNING)){
+      g_cond_wait(&(job_pool->wakeup_cond),
+		  &(job_pool->wakeup_mutex));
+    }
+
+    g_mutex_unlock(&(job_pool->wakeup_mutex));
+  }
+
+  g_private_set(&ags_job_pool_worker_deque,
+		NULL);
+  
+  g_thread_exit(NULL);
+
+  return(NULL);
+}
+
+/**
+ * ags_job_pool_submit:
+ * @job_pool: the #AgsJobPool
+ * @job_func: the #AgsJobFunc to run
+ * @data: the data passed to @job_func
+ * @data_destroy: the #GDestroyNotify called with @data as the job is done, or %NULL
+ *
+ * Submit @job_func to @job_pool. The workers are started if not running yet.
+ *
+ * Returns: (transfer full): the #AgsFuture completed with the return value of @job_func
+ *
+ * Since: 3.7.0
+ */
+AgsFuture*
+ags_job_pool_submit(AgsJobPool *job_pool,
+		    AgsJobFunc job_func,
+		    gpointer data,
+		    GDestroyNotify data_destroy)
+{
+  AgsJobPoolJob *job;
+  AgsJobPoolDeque *deque;
+
+  AgsFuture *future;
+  
+  if(!AGS_IS_JOB_POOL(job_pool) ||
+     job_func == NULL){
+    return(NULL);
+  }
+
+  ags_job_pool_start(job_pool);
+  
+  future = ags_future_alloc();
+
+  job = (AgsJobPoolJob *) g_malloc(sizeof(AgsJobPoolJob));
+
+  job->job_func = job_func;
+
+  job->data = data;
+  job->data_destroy = data_destroy;
+
+  job->future = ags_future_ref(future);
+
+  /* jobs submitted by a worker of this pool go to its own deque */
+  deque = g_private_get(&ags_job_pool_worker_deque);
+
+  if(deque == NULL ||
+     job_pool->deque == NULL ||
+     deque < job_pool->deque ||
+     deque >= job_pool->deque + job_pool->worker_count){
+    deque = &(job_pool->injection);
+  }
+  
+  g_mutex_lock(&(deque->mutex));
+
+  g_queue_push_tail(&(deque->queue),
+		    job);
+  
+  g_mutex_unlock(&(deque->mutex));
+
+  /* wake up a worker */
+  g_mutex_lock(&(job_pool->wakeup_mutex));
+
+  g_atomic_int_inc(&(job_pool->job_count));
+  
+  g_cond_signal(&(job_pool->wakeup_cond));
+
+  g_mutex_unlock(&(job_pool->wakeup_mutex));
+  
+  return(future);
+}
+
+/**
+ * ags_job_pool_start:
+ * @job_pool: the #AgsJobPool
+ *
+ * Start the worker threads of @job_pool.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_job_pool_start(AgsJobPool *job_pool)
+{
+  guint i;
+  
+  GRecMutex *job_pool_mutex;
+
+  if(!AGS_IS_JOB_POOL(job_pool)){
+    return;
+  }
+
+  /* get job pool mutex */
+  job_pool_mutex = AGS_JOB_POOL_GET_OBJ_MUTEX(job_pool);
+
+  g_rec_mutex_lock(job_pool_mutex);
+
+  if((AGS_JOB_POOL_RUNNING & (job_pool->flags)) != 0){
+    g_rec_mutex_unlock(job_pool_mutex);
+
+    return;
+  }
+
+  job_pool->flags |= AGS_JOB_POOL_RUNNING;
+
+  /* deques */
+  job_pool->deque = (AgsJobPoolDeque *) g_malloc(job_pool->worker_count * sizeof(AgsJobPoolDeque));
+
+  for(i = 0; i < job_pool->worker_count; i++){
+    g_mutex_init(&(job_pool->deque[i].mutex));
+    g_queue_init(&(job_pool->deque[i].queue));
+  }
+
+  /* workers */
+  job_pool->worker = (GThread **) g_malloc(job_pool->worker_count * sizeof(GThread *));
+
+  for(i = 0; i < job_pool->worker_count; i++){
+    gpointer *data;
+
+    data = (gpointer *) g_malloc(2 * sizeof(gpointer));
+
+    data[0] = job_pool;
+    data[1] = GUINT_TO_POINTER(i);
+    
+    job_pool->worker[i] = g_thread_new("Advanced Gtk+ Sequencer - job pool",
+				       ags_job_pool_worker_run,
+				       data);
+  }
+
+  g_rec_mutex_unlock(job_pool_mutex);
+}
+
+/**
+ * ags_job_pool_stop:
+ * @job_pool: the #AgsJobPool
+ *
+ * Stop the worker threads of @job_pool and wait for them to exit. The jobs
+ * not started yet are cancelled.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_job_pool_stop(AgsJobPool *job_pool)
+{
+  AgsJobPoolJob *job;
+  
+  GThread **worker;
+
+  guint worker_count;
+  guint i;
+  
+  GRecMutex *job_pool_mutex;
+
+  if(!AGS_IS_JOB_POOL(job_pool)){
+    return;
+  }
+
+  /* get job pool mutex */
+  job_pool_mutex = AGS_JOB_POOL_GET_OBJ_MUTEX(job_pool);
+
+  g_rec_mutex_lock(job_pool_mutex);
+
+  worker = job_pool->worker;
+  worker_count = job_pool->worker_count;
+
+  job_pool->flags &= (~AGS_JOB_POOL_RUNNING);
+  job_pool->worker = NULL;
+
+  g_rec_mutex_unlock(job_pool_mutex);
+
+  if(worker == NULL){
+    return;
+  }
+  
+  g_mutex_lock(&(job_pool->wakeup_mutex));
+
+  g_cond_broadcast(&(job_pool->wakeup_cond));
+
+  g_mutex_unlock(&(job_pool->wakeup_mutex));
+
+  for(i = 0; i < worker_count; i++){
+    g_thread_join(worker[i]);
+  }
+
+  g_free(worker);
+
+  /* cancel pending jobs */
+  for(i = 0; i < worker_count; i++){
+    while((job = g_queue_pop_head(&(job_pool->deque[i].queue))) != NULL){
+      ags_future_cancel(job->future);
+      ags_job_pool_run_job(job);
+    }
+
+    g_mutex_clear(&(job_pool->deque[i].mutex));
+  }
+
+  while((job = g_queue_pop_head(&(job_pool->injection.queue))) != NULL){
+    ags_future_cancel(job->future);
+    ags_job_pool_run_job(job);
+  }
+
+  g_atomic_int_set(&(job_pool->job_count),
+		   0);
+  
+  g_rec_mutex_lock(job_pool_mutex);
+
+  g_free(job_pool->deque);
+
+  job_pool->deque = NULL;
+
+  g_rec_mutex_unlock(job_pool_mutex);
+}
+
+/**
+ * ags_job_pool_get_instance:
+ *
+ * Get instance.
+ *
+ * Returns: (transfer none): the #AgsJobPool
+ *
+ * Since: 3.7.0
+ */
+AgsJobPool*
+ags_job_pool_get_instance()
+{
+  static GMutex mutex;
+
+  g_mutex_lock(&mutex);
+
+  if(ags_job_pool == NULL){
+    ags_job_pool = ags_job_pool_new();
+  }
+
+  g_mutex_unlock(&mutex);
+
+  return(ags_job_pool);
+}
+
+/**
+ * ags_job_pool_new:
+ *
+ * Create a new instance of #AgsJobPool.
+ *
+ * Returns: the new #AgsJobPool
+ *
+ * Since: 3.7.0
+ */
+AgsJobPool*
+ags_job_pool_new()
+{
+  AgsJobPool *job_pool;
+
+  job_pool = (AgsJobPool *) g_object_new(AGS_TYPE_JOB_POOL,
+					 NULL);
+
+  return(job_pool);
+}
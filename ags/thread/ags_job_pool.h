@@ -0,0 +1,125 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __AGS_JOB_POOL_H__
+#define __AGS_JOB_POOL_H__
+
+#include <glib.h>
+#include <glib-object.h>
+
+#include <ags/thread/ags_future.h>
+
+G_BEGIN_DECLS
+
+#define AGS_TYPE_JOB_POOL                (ags_job_pool_get_type())
+#define AGS_JOB_POOL(obj)                (G_TYPE_CHECK_INSTANCE_CAST((obj), AGS_TYPE_JOB_POOL, AgsJobPool))
+#define AGS_JOB_POOL_CLASS(class)        (G_TYPE_CHECK_CLASS_CAST((class), AGS_TYPE_JOB_POOL, AgsJobPoolClass))
+#define AGS_IS_JOB_POOL(obj)             (G_TYPE_CHECK_INSTANCE_TYPE ((obj), AGS_TYPE_JOB_POOL))
+#define AGS_IS_JOB_POOL_CLASS(class)     (G_TYPE_CHECK_CLASS_TYPE ((class), AGS_TYPE_JOB_POOL))
+#define AGS_JOB_POOL_GET_CLASS(obj)      (G_TYPE_INSTANCE_GET_CLASS ((obj), AGS_TYPE_JOB_POOL, AgsJobPoolClass))
+
+#define AGS_JOB_POOL_GET_OBJ_MUTEX(obj) (&(((AgsJobPool *) obj)->obj_mutex))
+
+#define AGS_JOB_POOL_JOB(ptr) ((AgsJobPoolJob *)(ptr))
+#define AGS_JOB_POOL_DEQUE(ptr) ((AgsJobPoolDeque *)(ptr))
+
+typedef struct _AgsJobPool AgsJobPool;
+typedef struct _AgsJobPoolClass AgsJobPoolClass;
+typedef struct _AgsJobPoolJob AgsJobPoolJob;
+typedef struct _AgsJobPoolDeque AgsJobPoolDeque;
+
+typedef gpointer (*AgsJobFunc)(AgsFuture *future,
+			       gpointer data);
+
+/**
+ * AgsJobPoolFlags:
+ * @AGS_JOB_POOL_RUNNING: the worker threads are running
+ *
+ * Enum values to control the behavior or indicate internal state of #AgsJobPool by
+ * enable/disable as flags.
+ */
+typedef enum{
+  AGS_JOB_POOL_RUNNING      = 1,
+}AgsJobPoolFlags;
+
+struct _AgsJobPoolJob
+{
+  AgsJobFunc job_func;
+
+  gpointer data;
+  GDestroyNotify data_destroy;
+
+  AgsFuture *future;
+};
+
+struct _AgsJobPoolDeque
+{
+  GMutex mutex;
+
+  GQueue queue;
+};
+
+struct _AgsJobPool
+{
+  GObject gobject;
+
+  guint flags;
+
+  GRecMutex obj_mutex;
+
+  guint worker_count;
+  GThread **worker;
+
+  AgsJobPoolDeque *deque;
+  AgsJobPoolDeque injection;
+
+  volatile gint job_count;
+
+  GMutex wakeup_mutex;
+  GCond wakeup_cond;
+};
+
+struct _AgsJobPoolClass
+{
+  GObjectClass gobject;
+};
+
+GType ags_job_pool_get_type();
+
+gboolean ags_job_pool_test_flags(AgsJobPool *job_pool, guint flags);
+void ags_job_pool_set_flags(AgsJobPool *job_pool, guint flags);
+void ags_job_pool_unset_flags(AgsJobPool *job_pool, guint flags);
+
+guint ags_job_pool_get_worker_count(AgsJobPool *job_pool);
+
+AgsFuture* ags_job_pool_submit(AgsJobPool *job_pool,
+			       AgsJobFunc job_func,
+			       gpointer data,
+			       GDestroyNotify data_destroy);
+
+void ags_job_pool_start(AgsJobPool *job_pool);
+void ags_job_pool_stop(AgsJobPool *job_pool);
+
+AgsJobPool* ags_job_pool_get_instance();
+
+AgsJobPool* ags_job_pool_new();
+
+G_END_DECLS
+
+#endif /*__AGS_JOB_POOL_H__*/
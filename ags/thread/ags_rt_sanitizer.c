@@ -0,0 +1,433 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <ags/config.h>
+
+#include <ags/thread/ags_rt_sanitizer.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(AGS_WITH_RT_SANITIZER)
+#include <execinfo.h>
+#endif
+
+void ags_rt_sanitizer_atexit();
+
+/**
+ * SECTION:ags_rt_sanitizer
+ * @short_description: realtime safety sanitizer
+ * @title: AgsRtSanitizer
+ * @section_id:
+ * @include: ags/thread/ags_rt_sanitizer.h
+ *
+ * The realtime sanitizer counts calls to functions that must not be used
+ * by realtime threads. The audio main loop, soundcard, audio, channel and
+ * worker threads mark themselves with ags_rt_sanitizer_mark_rt_thread().
+ *
+ * Configuring with --enable-rt-sanitizer links gsequencer against
+ * libags_rt_sanitizer. It interposes malloc(), calloc(), realloc(), free(),
+ * pthread_mutex_lock() and write(). Each interposed function calls
+ * ags_rt_sanitizer_record(). If the calling thread is a realtime thread,
+ * the hit is counted per call site, identified by its backtrace. #GRecMutex
+ * is implemented with pthread mutexes and so is covered. #GMutex uses
+ * futexes on Linux and is not.
+ *
+ * Recording never allocates. Call sites are kept in a fixed size table,
+ * and hits that don't fit it are counted as dropped. The report is printed
+ * to stderr at exit, and the OSC info controller returns it on request.
+ *
+ * Without --enable-rt-sanitizer all functions do nothing.
+ */
+
+#if defined(AGS_WITH_RT_SANITIZER)
+typedef struct _AgsRtSanitizerSite AgsRtSanitizerSite;
+
+struct _AgsRtSanitizerSite
+{
+  volatile gint state;
+  
+  guint hook;
+  guint hash;
+
+  guint frame_count;
+  gpointer frame[AGS_RT_SANITIZER_MAX_FRAME_COUNT];
+
+  volatile gint count;
+};
+
+enum{
+  AGS_RT_SANITIZER_SITE_EMPTY,
+  AGS_RT_SANITIZER_SITE_CLAIMED,
+  AGS_RT_SANITIZER_SITE_READY,
+};
+
+static const gchar *ags_rt_sanitizer_hook_name[] = {
+  "malloc",
+  "free",
+  "pthread_mutex_lock",
+  "write",
+};
+
+/* initial-exec keeps TLS access from calling back into malloc */
+static __thread gboolean ags_rt_sanitizer_rt_thread __attribute__((tls_model("initial-exec"))) = FALSE;
+static __thread gboolean ags_rt_sanitizer_recording __attribute__((tls_model("initial-exec"))) = FALSE;
+
+static AgsRtSanitizerSite ags_rt_sanitizer_site[AGS_RT_SANITIZER_MAX_SITE_COUNT];
+
+static volatile gint ags_rt_sanitizer_count[AGS_RT_SANITIZER_HOOK_LAST];
+static volatile gint ags_rt_sanitizer_dropped_count = 0;
+
+static volatile gint ags_rt_sanitizer_atexit_registered = FALSE;
+#endif
+
+/**
+ * ags_rt_sanitizer_is_enabled:
+ *
+ * Check if the realtime sanitizer was compiled in.
+ *
+ * Returns: %TRUE if configured with --enable-rt-sanitizer, otherwise %FALSE
+ *
+ * Since: 3.7.0
+ */
+gboolean
+ags_rt_sanitizer_is_enabled()
+{
+#if defined(AGS_WITH_RT_SANITIZER)
+  return(TRUE);
+#else
+  return(FALSE);
+#endif
+}
+
+/**
+ * ags_rt_sanitizer_mark_rt_thread:
+ * @is_rt_thread: %TRUE if the calling thread is a realtime thread
+ *
+ * Mark the calling thread as realtime thread. Only realtime threads are
+ * recorded.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_rt_sanitizer_mark_rt_thread(gboolean is_rt_thread)
+{
+#if defined(AGS_WITH_RT_SANITIZER)
+  gpointer frame[1];
+
+  if(ags_rt_sanitizer_rt_thread == is_rt_thread){
+    return;
+  }
+  
+  if(is_rt_thread){
+    /* the first backtrace() loads the unwinder, do it outside of the realtime section */
+    ags_rt_sanitizer_recording = TRUE;
+    
+    backtrace(frame, 1);
+
+    if(g_atomic_int_compare_and_exchange(&ags_rt_sanitizer_atexit_registered, FALSE, TRUE)){
+      atexit(ags_rt_sanitizer_atexit);
+    }
+    
+    ags_rt_sanitizer_recording = FALSE;
+  }
+
+  ags_rt_sanitizer_rt_thread = is_rt_thread;
+#endif
+}
+
+/**
+ * ags_rt_sanitizer_is_rt_thread:
+ *
+ * Check if the calling thread is marked as realtime thread.
+ *
+ * Returns: %TRUE if marked, otherwise %FALSE
+ *
+ * Since: 3.7.0
+ */
+gboolean
+ags_rt_sanitizer_is_rt_thread()
+{
+#if defined(AGS_WITH_RT_SANITIZER)
+  return(ags_rt_sanitizer_rt_thread);
+#else
+  return(FALSE);
+#endif
+}
+
+/**
+ * ags_rt_sanitizer_record:
+ * @hook: the #AgsRtSanitizerHook
+ *
+ * Record a hit of @hook by the calling thread. Does nothing unless the
+ * thread is marked as realtime thread. The call site is identified by the
+ * backtrace of the caller.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_rt_sanitizer_record(guint hook)
+{
+#if defined(AGS_WITH_RT_SANITIZER)
+  AgsRtSanitizerSite *site;
+  
+  gpointer frame[AGS_RT_SANITIZER_MAX_FRAME_COUNT + 1];
+
+  guint frame_count;
+  guint hash;
+  guint state;
+  guint i, j;
+  
+  if(!ags_rt_sanitizer_rt_thread ||
+     ags_rt_sanitizer_recording ||
+     hook >= AGS_RT_SANITIZER_HOOK_LAST){
+    return;
+  }
+
+  ags_rt_sanitizer_recording = TRUE;
+
+  g_atomic_int_inc(&(ags_rt_sanitizer_count[hook]));
+
+  /* skip this function's own frame */
+  frame_count = backtrace(frame, AGS_RT_SANITIZER_MAX_FRAME_COUNT + 1);
+
+  if(frame_count > 0){
+    frame_count--;
+  }
+
+  hash = hook;
+  
+  for(i = 0; i < frame_count; i++){
+    hash = 31 * hash + (guint) GPOINTER_TO_SIZE(frame[i + 1]);
+  }
+
+  /* find or claim the call site - open addressing, no allocation */
+  for(i = 0, j = hash % AGS_RT_SANITIZER_MAX_SITE_COUNT; i < AGS_RT_SANITIZER_MAX_SITE_COUNT; i++, j = (j + 1) % AGS_RT_SANITIZER_MAX_SITE_COUNT){
+    site = &(ags_rt_sanitizer_site[j]);
+
+    state = g_atomic_int_get(&(site->state));
+    
+    if(state == AGS_RT_SANITIZER_SITE_EMPTY){
+      if(g_atomic_int_compare_and_exchange(&(site->state), AGS_RT_SANITIZER_SITE_EMPTY, AGS_RT_SANITIZER_SITE_CLAIMED)){
+	site->hook = hook;
+	site->hash = hash;
+	site->frame_count = frame_count;
+	
+	memcpy(site->frame, frame + 1, frame_count * sizeof(gpointer));
+
+	g_atomic_int_set(&(site->count), 1);
+	g_atomic_int_set(&(site->state), AGS_RT_SANITIZER_SITE_READY);
+	
+	ags_rt_sanitizer_recording = FALSE;
+
+	return;
+      }
+
+      state = g_atomic_int_get(&(site->state));
+    }
+
+    /* a site being claimed by another thread is skipped, at worst it shows up twice */
+    if(state == AGS_RT_SANITIZER_SITE_READY &&
+       site->hash == hash &&
+       site->hook == hook &&
+       site->frame_count == frame_count &&
+       !memcmp(site->frame, frame + 1, frame_count * sizeof(gpointer))){
+      g_atomic_int_inc(&(site->count));
+
+      ags_rt_sanitizer_recording = FALSE;
+      
+      return;
+    }
+  }
+
+  g_atomic_int_inc(&ags_rt_sanitizer_dropped_count);
+
+  ags_rt_sanitizer_recording = FALSE;
+#endif
+}
+
+/**
+ * ags_rt_sanitizer_get_count:
+ * @hook: the #AgsRtSanitizerHook
+ *
+ * Get the number of times @hook was hit by realtime threads.
+ *
+ * Returns: the hit count
+ *
+ * Since: 3.7.0
+ */
+guint
+ags_rt_sanitizer_get_count(guint hook)
+{
+#if defined(AGS_WITH_RT_SANITIZER)
+  if(hook >= AGS_RT_SANITIZER_HOOK_LAST){
+    return(0);
+  }
+
+  return(g_atomic_int_get(&(ags_rt_sanitizer_count[hook])));
+#else
+  return(0);
+#endif
+}
+
+/**
+ * ags_rt_sanitizer_get_dropped_count:
+ *
+ * Get the number of hits whose call site didn't fit the site table.
+ *
+ * Returns: the dropped count
+ *
+ * Since: 3.7.0
+ */
+guint
+ags_rt_sanitizer_get_dropped_count()
+{
+#if defined(AGS_WITH_RT_SANITIZER)
+  return(g_atomic_int_get(&ags_rt_sanitizer_dropped_count));
+#else
+  return(0);
+#endif
+}
+
+/**
+ * ags_rt_sanitizer_reset:
+ *
+ * Reset all counters and call sites. Only call this while no realtime
+ * thread is running.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_rt_sanitizer_reset()
+{
+#if defined(AGS_WITH_RT_SANITIZER)
+  guint i;
+
+  for(i = 0; i < AGS_RT_SANITIZER_HOOK_LAST; i++){
+    g_atomic_int_set(&(ags_rt_sanitizer_count[i]), 0);
+  }
+
+  g_atomic_int_set(&ags_rt_sanitizer_dropped_count, 0);
+  
+  for(i = 0; i < AGS_RT_SANITIZER_MAX_SITE_COUNT; i++){
+    g_atomic_int_set(&(ags_rt_sanitizer_site[i].count), 0);
+    g_atomic_int_set(&(ags_rt_sanitizer_site[i].state), AGS_RT_SANITIZER_SITE_EMPTY);
+  }
+#endif
+}
+
+/**
+ * ags_rt_sanitizer_get_report:
+ *
+ * Get the report of all recorded call sites with symbolized backtraces.
+ *
+ * Returns: (transfer full): the report as string or %NULL if not enabled
+ *
+ * Since: 3.7.0
+ */
+gchar*
+ags_rt_sanitizer_get_report()
+{
+#if defined(AGS_WITH_RT_SANITIZER)
+  AgsRtSanitizerSite *site;
+  GString *report;
+
+  gchar **symbol;
+
+  gboolean recording;
+  guint i, j;
+
+  /* don't record the report's own allocations */
+  recording = ags_rt_sanitizer_recording;
+  ags_rt_sanitizer_recording = TRUE;
+  
+  report = g_string_new(NULL);
+
+  g_string_append_printf(report,
+			 "realtime sanitizer: malloc %u, free %u, pthread_mutex_lock %u, write %u, dropped %u\n",
+			 ags_rt_sanitizer_get_count(AGS_RT_SANITIZER_HOOK_MALLOC),
+			 ags_rt_sanitizer_get_count(AGS_RT_SANITIZER_HOOK_FREE),
+			 ags_rt_sanitizer_get_count(AGS_RT_SANITIZER_HOOK_MUTEX_LOCK),
+			 ags_rt_sanitizer_get_count(AGS_RT_SANITIZER_HOOK_WRITE),
+			 ags_rt_sanitizer_get_dropped_count());
+
+  for(i = 0; i < AGS_RT_SANITIZER_MAX_SITE_COUNT; i++){
+    site = &(ags_rt_sanitizer_site[i]);
+    
+    if(g_atomic_int_get(&(site->state)) != AGS_RT_SANITIZER_SITE_READY){
+      continue;
+    }
+
+    g_string_append_printf(report,
+			   "%s hit %u times at:\n",
+			   ags_rt_sanitizer_hook_name[site->hook],
+			   g_atomic_int_get(&(site->count)));
+
+    symbol = backtrace_symbols(site->frame,
+			       site->frame_count);
+
+    for(j = 0; j < site->frame_count; j++){
+      if(symbol != NULL){
+	g_string_append_printf(report,
+			       "  %s\n",
+			       symbol[j]);
+      }else{
+	g_string_append_printf(report,
+			       "  %p\n",
+			       site->frame[j]);
+      }
+    }
+
+    free(symbol);
+  }
+  
+  ags_rt_sanitizer_recording = recording;
+
+  return(g_string_free(report, FALSE));
+#else
+  return(NULL);
+#endif
+}
+
+/**
+ * ags_rt_sanitizer_dump_report:
+ *
+ * Print the report to stderr.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_rt_sanitizer_dump_report()
+{
+  gchar *report;
+
+  report = ags_rt_sanitizer_get_report();
+
+  if(report != NULL){
+    g_printerr("%s", report);
+  }
+
+  g_free(report);
+}
+
+void
+ags_rt_sanitizer_atexit()
+{
+  ags_rt_sanitizer_dump_report();
+}
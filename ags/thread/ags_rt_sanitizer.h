@@ -0,0 +1,66 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __AGS_RT_SANITIZER_H__
+#define __AGS_RT_SANITIZER_H__
+
+#include <glib.h>
+#include <glib-object.h>
+
+G_BEGIN_DECLS
+
+#define AGS_RT_SANITIZER_MAX_FRAME_COUNT (16)
+#define AGS_RT_SANITIZER_MAX_SITE_COUNT (1024)
+
+/**
+ * AgsRtSanitizerHook:
+ * @AGS_RT_SANITIZER_HOOK_MALLOC: malloc(), calloc() or realloc() was called
+ * @AGS_RT_SANITIZER_HOOK_FREE: free() was called
+ * @AGS_RT_SANITIZER_HOOK_MUTEX_LOCK: pthread_mutex_lock() was called
+ * @AGS_RT_SANITIZER_HOOK_WRITE: write() was called
+ * @AGS_RT_SANITIZER_HOOK_LAST: the hook count
+ *
+ * Enum values identifying the interposed function that was hit by a realtime thread.
+ */
+typedef enum{
+  AGS_RT_SANITIZER_HOOK_MALLOC,
+  AGS_RT_SANITIZER_HOOK_FREE,
+  AGS_RT_SANITIZER_HOOK_MUTEX_LOCK,
+  AGS_RT_SANITIZER_HOOK_WRITE,
+  AGS_RT_SANITIZER_HOOK_LAST,
+}AgsRtSanitizerHook;
+
+gboolean ags_rt_sanitizer_is_enabled();
+
+void ags_rt_sanitizer_mark_rt_thread(gboolean is_rt_thread);
+gboolean ags_rt_sanitizer_is_rt_thread();
+
+void ags_rt_sanitizer_record(guint hook);
+
+guint ags_rt_sanitizer_get_count(guint hook);
+guint ags_rt_sanitizer_get_dropped_count();
+
+void ags_rt_sanitizer_reset();
+
+gchar* ags_rt_sanitizer_get_report();
+void ags_rt_sanitizer_dump_report();
+
+G_END_DECLS
+
+#endif /*__AGS_RT_SANITIZER_H__*/
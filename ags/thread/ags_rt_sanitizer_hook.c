@@ -0,0 +1,100 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <ags/config.h>
+
+#include <ags/thread/ags_rt_sanitizer.h>
+
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <dlfcn.h>
+
+/* the hooks of libags_rt_sanitizer, linked into gsequencer with --enable-rt-sanitizer */
+
+extern void* __libc_malloc(size_t size);
+extern void* __libc_calloc(size_t nmemb, size_t size);
+extern void* __libc_realloc(void *ptr, size_t size);
+extern void __libc_free(void *ptr);
+
+void*
+malloc(size_t size)
+{
+  ags_rt_sanitizer_record(AGS_RT_SANITIZER_HOOK_MALLOC);
+
+  return(__libc_malloc(size));
+}
+
+void*
+calloc(size_t nmemb, size_t size)
+{
+  ags_rt_sanitizer_record(AGS_RT_SANITIZER_HOOK_MALLOC);
+
+  return(__libc_calloc(nmemb, size));
+}
+
+void*
+realloc(void *ptr, size_t size)
+{
+  ags_rt_sanitizer_record(AGS_RT_SANITIZER_HOOK_MALLOC);
+
+  return(__libc_realloc(ptr, size));
+}
+
+void
+free(void *ptr)
+{
+  if(ptr != NULL){
+    ags_rt_sanitizer_record(AGS_RT_SANITIZER_HOOK_FREE);
+  }
+  
+  __libc_free(ptr);
+}
+
+int
+pthread_mutex_lock(pthread_mutex_t *mutex)
+{
+  static int (*real_pthread_mutex_lock)(pthread_mutex_t *mutex) = NULL;
+
+  if(real_pthread_mutex_lock == NULL){
+    real_pthread_mutex_lock = dlsym(RTLD_NEXT, "pthread_mutex_lock");
+  }
+  
+  ags_rt_sanitizer_record(AGS_RT_SANITIZER_HOOK_MUTEX_LOCK);
+
+  return(real_pthread_mutex_lock(mutex));
+}
+
+ssize_t
+write(int fd, const void *buf, size_t count)
+{
+  static ssize_t (*real_write)(int fd, const void *buf, size_t count) = NULL;
+
+  if(real_write == NULL){
+    real_write = dlsym(RTLD_NEXT, "write");
+  }
+  
+  ags_rt_sanitizer_record(AGS_RT_SANITIZER_HOOK_WRITE);
+
+  return(real_write(fd, buf, count));
+}
@@ -200,6 +200,8 @@ ags_task_init(AgsTask *task)
   task->task_name = NULL;
 
   task->task_launcher = NULL;
+
+  task->coalesce_key = NULL;
 }
 
 void
@@ -413,6 +415,72 @@ ags_task_unset_flags(AgsTask *task, guint flags)
   g_rec_mutex_unlock(task_mutex);
 }
 
+/**
+ * ags_task_get_coalesce_key:
+ * @task: the #AgsTask
+ *
+ * Get coalesce key of @task.
+ *
+ * Returns: (transfer none): the coalesce key or %NULL
+ *
+ * Since: 3.7.0
+ */
+gpointer
+ags_task_get_coalesce_key(AgsTask *task)
+{
+  gpointer coalesce_key;
+  
+  GRecMutex *task_mutex;
+
+  if(!AGS_IS_TASK(task)){
+    return(NULL);
+  }
+
+  /* get task mutex */
+  task_mutex = AGS_TASK_GET_OBJ_MUTEX(task);
+
+  /* get coalesce key */
+  g_rec_mutex_lock(task_mutex);
+
+  coalesce_key = task->coalesce_key;
+  
+  g_rec_mutex_unlock(task_mutex);
+
+  return(coalesce_key);
+}
+
+/**
+ * ags_task_set_coalesce_key:
+ * @task: the #AgsTask
+ * @coalesce_key: the coalesce key, usually the target object
+ *
+ * Set coalesce key of @task. A pending task of the same type and with the
+ * same coalesce key is replaced by @task as #AgsTaskLauncher collects it.
+ * %NULL disables coalescing.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_task_set_coalesce_key(AgsTask *task,
+			  gpointer coalesce_key)
+{
+  GRecMutex *task_mutex;
+
+  if(!AGS_IS_TASK(task)){
+    return;
+  }
+
+  /* get task mutex */
+  task_mutex = AGS_TASK_GET_OBJ_MUTEX(task);
+
+  /* set coalesce key */
+  g_rec_mutex_lock(task_mutex);
+
+  task->coalesce_key = coalesce_key;
+  
+  g_rec_mutex_unlock(task_mutex);
+}
+
 /**
  * ags_task_launch:
  * @task: an #AgsTask
@@ -62,6 +62,8 @@ struct _AgsTask
   gchar *task_name;
 
   GObject *task_launcher;
+
+  gpointer coalesce_key;
 };
 
 struct _AgsTaskClass
@@ -79,6 +81,10 @@ gboolean ags_task_test_flags(AgsTask *task, guint flags);
 void ags_task_set_flags(AgsTask *task, guint flags);
 void ags_task_unset_flags(AgsTask *task, guint flags);
 
+gpointer ags_task_get_coalesce_key(AgsTask *task);
+void ags_task_set_coalesce_key(AgsTask *task,
+			       gpointer coalesce_key);
+
 void ags_task_launch(AgsTask *task);
 void ags_task_failure(AgsTask *task, GError *error);
 
@@ -20,6 +20,9 @@
 #include <ags/thread/ags_task_launcher.h>
 
 #include <ags/object/ags_connectable.h>
+#include <ags/object/ags_config.h>
+
+#include <ags/thread/ags_cpu_affinity.h>
 
 #include <ags/i18n.h>
 
@@ -50,6 +53,9 @@ gboolean ags_task_launcher_is_connected(AgsConnectable *connectable);
 void ags_task_launcher_connect(AgsConnectable *connectable);
 void ags_task_launcher_disconnect(AgsConnectable *connectable);
 
+GList* ags_task_launcher_take_task(AgsTaskLauncher *task_launcher);
+void ags_task_launcher_collect_task(AgsTaskLauncher *task_launcher);
+
 void ags_task_launcher_real_run(AgsTaskLauncher *task_launcher);
 
 gboolean ags_task_launcher_source_func(AgsTaskLauncher *task_launcher);
@@ -62,6 +68,12 @@ gboolean ags_task_launcher_source_func(AgsTaskLauncher *task_launcher);
  * @include: ags/thread/ags_task_launcher.h
  *
  * The #AgsTaskLauncher acts as task launcher.
+ *
+ * Adding a task doesn't lock, the tasks are pushed to a lock-free stack
+ * and collected as the launcher runs. Collecting coalesces tasks of the
+ * same type and coalesce key, so only the newest one is launched, see
+ * ags_task_set_coalesce_key(). At most #AgsTaskLauncher:max-task-count
+ * one shot tasks are launched per run, the remaining stay pending.
  */
 
 enum{
@@ -73,6 +85,7 @@ enum{
   PROP_0,
   PROP_TASK,
   PROP_CYCLIC_TASK,
+  PROP_MAX_TASK_COUNT,
 };
 
 static gpointer ags_task_launcher_parent_class = NULL;
@@ -188,6 +201,24 @@ ags_task_launcher_class_init(AgsTaskLauncherClass *task_launcher)
 				  PROP_CYCLIC_TASK,
 				  param_spec);
 
+  /**
+   * AgsTaskLauncher:max-task-count:
+   *
+   * The maximum count of one shot tasks launched per run, 0 means unbounded.
+   * 
+   * Since: 3.7.0
+   */
+  param_spec = g_param_spec_uint("max-task-count",
+				 i18n_pspec("max task count"),
+				 i18n_pspec("The maximum count of tasks launched per run"),
+				 0,
+				 G_MAXUINT32,
+				 AGS_TASK_LAUNCHER_DEFAULT_MAX_TASK_COUNT,
+				 G_PARAM_READABLE | G_PARAM_WRITABLE);
+  g_object_class_install_property(gobject,
+				  PROP_MAX_TASK_COUNT,
+				  param_spec);
+
   /* AgsTaskLauncher */
   task_launcher->run = ags_task_launcher_real_run;
 
@@ -235,6 +266,10 @@ ags_task_launcher_connectable_interface_init(AgsConnectableInterface *connectabl
 void
 ags_task_launcher_init(AgsTaskLauncher *task_launcher)
 {
+  AgsConfig *config;
+
+  gchar *str;
+  
   task_launcher->flags = 0;
 
   /* the obj mutex */
@@ -249,6 +284,25 @@ ags_task_launcher_init(AgsTaskLauncher *task_launcher)
   task_launcher->task = NULL;
   task_launcher->cyclic_task = NULL;
 
+  task_launcher->pending_task = NULL;
+
+  /* max task count */
+  config = ags_config_get_instance();
+
+  task_launcher->max_task_count = AGS_TASK_LAUNCHER_DEFAULT_MAX_TASK_COUNT;
+
+  str = ags_config_get_value(config,
+			     AGS_CONFIG_THREAD,
+			     "task-launcher-max-task-count");
+
+  if(str != NULL){
+    task_launcher->max_task_count = g_ascii_strtoull(str,
+						     NULL,
+						     10);
+
+    g_free(str);
+  }
+
   /* wait */
   g_atomic_int_set(&(task_launcher->is_running),
 		   FALSE);
@@ -295,6 +349,15 @@ ags_task_launcher_set_property(GObject *gobject,
 				      cyclic_task);
   }
   break;
+  case PROP_MAX_TASK_COUNT:
+  {
+    g_rec_mutex_lock(task_launcher_mutex);
+
+    task_launcher->max_task_count = g_value_get_uint(value);
+
+    g_rec_mutex_unlock(task_launcher_mutex);
+  }
+  break;
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID(gobject, prop_id, param_spec);
     break;
@@ -319,11 +382,29 @@ ags_task_launcher_get_property(GObject *gobject,
   switch(prop_id){
   case PROP_TASK:
   {
+    GList *start_list, *list;
+    GList *start_queue;
+    
     g_rec_mutex_lock(task_launcher_mutex);
 
-    g_value_set_pointer(value, g_list_copy_deep(task_launcher->task,
-						(GCopyFunc) g_object_ref,
-						NULL));
+    start_list = g_list_copy_deep(task_launcher->pending_task,
+				  (GCopyFunc) g_object_ref,
+				  NULL);
+
+    /* nodes of the queue are only freed with the mutex held */
+    start_queue = NULL;
+
+    list = g_atomic_pointer_get(&(task_launcher->task));
+    
+    while(list != NULL){
+      start_queue = g_list_prepend(start_queue,
+				   g_object_ref(list->data));
+
+      list = list->next;
+    }
+    
+    g_value_set_pointer(value, g_list_concat(start_list,
+					     start_queue));
 
     g_rec_mutex_unlock(task_launcher_mutex);
   }
@@ -339,6 +420,15 @@ ags_task_launcher_get_property(GObject *gobject,
     g_rec_mutex_unlock(task_launcher_mutex);
   }
   break;
+  case PROP_MAX_TASK_COUNT:
+  {
+    g_rec_mutex_lock(task_launcher_mutex);
+
+    g_value_set_uint(value, task_launcher->max_task_count);
+
+    g_rec_mutex_unlock(task_launcher_mutex);
+  }
+  break;
   default:
     G_OBJECT_WARN_INVALID_PROPERTY_ID(gobject, prop_id, param_spec);
     break;
@@ -358,11 +448,14 @@ ags_task_launcher_dispose(GObject *gobject)
     task_launcher->main_context = NULL;
   }
   
-  if(task_launcher->task != NULL){
-    g_list_free_full(task_launcher->task,
+  g_list_free_full(ags_task_launcher_take_task(task_launcher),
+		   g_object_unref);
+  
+  if(task_launcher->pending_task != NULL){
+    g_list_free_full(task_launcher->pending_task,
 		     g_object_unref);
     
-    task_launcher->task = NULL;
+    task_launcher->pending_task = NULL;
   }
   
   if(task_launcher->cyclic_task != NULL){
@@ -393,6 +486,9 @@ ags_task_launcher_finalize(GObject *gobject)
   g_list_free_full(task_launcher->task,
 		   g_object_unref);
 
+  g_list_free_full(task_launcher->pending_task,
+		   g_object_unref);
+
   g_list_free_full(task_launcher->cyclic_task,
 		   g_object_unref);
   
@@ -676,7 +772,8 @@ ags_task_launcher_attach(AgsTaskLauncher *task_launcher,
  * @task_launcher: the #AgsTaskLauncher
  * @task: the #AgsTask
  * 
- * Add @task to @task_launcher.
+ * Add @task to @task_launcher. This function doesn't lock and is safe to
+ * call from any thread.
  * 
  * Since: 3.0.0
  */
@@ -684,23 +781,25 @@ void
 ags_task_launcher_add_task(AgsTaskLauncher *task_launcher,
 			   AgsTask *task)
 {
-  GRecMutex *task_launcher_mutex;
+  GList *start_list, *list;
 
   if(!AGS_IS_TASK_LAUNCHER(task_launcher) ||
      !AGS_IS_TASK(task)){
     return;
   }
 
-  /* get task launcher mutex */
-  task_launcher_mutex = AGS_TASK_LAUNCHER_GET_OBJ_MUTEX(task_launcher);
+  list = g_list_alloc();
+  list->data = task;
+  g_object_ref(task);
 
-  g_rec_mutex_lock(task_launcher_mutex);
+  /* push */
+  do{
+    start_list = g_atomic_pointer_get(&(task_launcher->task));
 
-  task_launcher->task = g_list_prepend(task_launcher->task,
-				       task);
-  g_object_ref(task);
-  
-  g_rec_mutex_unlock(task_launcher_mutex);
+    list->next = start_list;
+  }while(!g_atomic_pointer_compare_and_exchange(&(task_launcher->task),
+						start_list,
+						list));
 }
 
 /**
@@ -708,7 +807,8 @@ ags_task_launcher_add_task(AgsTaskLauncher *task_launcher,
  * @task_launcher: the #AgsTaskLauncher
  * @list: (element-type Ags.Task) (transfer none): the #GList-struct containing #AgsTask
  * 
- * Add all @list to @task_launcher.
+ * Add all @list to @task_launcher in one step, keeping the order of @list.
+ * This function doesn't lock and is safe to call from any thread.
  * 
  * Since: 3.0.0
  */
@@ -716,30 +816,46 @@ void
 ags_task_launcher_add_task_all(AgsTaskLauncher *task_launcher,
 			       GList *list)
 {
-  GRecMutex *task_launcher_mutex;
+  GList *start_queue, *queue, *last_queue;
+  GList *start_list;
 
   if(!AGS_IS_TASK_LAUNCHER(task_launcher) ||
      list == NULL){
     return;
   }
 
-  /* get task launcher mutex */
-  task_launcher_mutex = AGS_TASK_LAUNCHER_GET_OBJ_MUTEX(task_launcher);
+  /* the queue is newest first */
+  start_queue = NULL;
+  last_queue = NULL;
 
-  g_rec_mutex_lock(task_launcher_mutex);
+  while(list != NULL){
+    if(AGS_IS_TASK(list->data)){
+      queue = g_list_alloc();
+      queue->data = g_object_ref(list->data);
+      queue->next = start_queue;
 
-  if(task_launcher->task != NULL){
-    task_launcher->task = g_list_concat(task_launcher->task,
-					g_list_copy_deep(list,
-							 (GCopyFunc) g_object_ref,
-							 NULL));
-  }else{
-    task_launcher->task = g_list_copy_deep(list,
-					   (GCopyFunc) g_object_ref,
-					   NULL);
+      if(start_queue == NULL){
+	last_queue = queue;
+      }
+      
+      start_queue = queue;
+    }
+    
+    list = list->next;
+  }
+
+  if(start_queue == NULL){
+    return;
   }
   
-  g_rec_mutex_unlock(task_launcher_mutex);
+  /* push */
+  do{
+    start_list = g_atomic_pointer_get(&(task_launcher->task));
+
+    last_queue->next = start_list;
+  }while(!g_atomic_pointer_compare_and_exchange(&(task_launcher->task),
+						start_list,
+						start_queue));
 }
 
 /**
@@ -807,6 +923,104 @@ ags_task_launcher_remove_cyclic_task(AgsTaskLauncher *task_launcher,
   g_rec_mutex_unlock(task_launcher_mutex);
 }
 
+GList*
+ags_task_launcher_take_task(AgsTaskLauncher *task_launcher)
+{
+  GList *start_list, *list, *next;
+  GList *start_task;
+
+  /* pop all */
+  do{
+    start_list = g_atomic_pointer_get(&(task_launcher->task));
+  }while(!g_atomic_pointer_compare_and_exchange(&(task_launcher->task),
+						start_list,
+						NULL));
+
+  /* reverse to launch order and fix the prev links */
+  start_task = NULL;
+
+  list = start_list;
+  
+  while(list != NULL){
+    next = list->next;
+
+    list->prev = NULL;
+    list->next = start_task;
+
+    if(start_task != NULL){
+      start_task->prev = list;
+    }
+
+    start_task = list;
+    
+    list = next;
+  }
+
+  return(start_task);
+}
+
+void
+ags_task_launcher_collect_task(AgsTaskLauncher *task_launcher)
+{
+  GHashTable *coalesce;
+
+  GList *task, *prev;
+
+  GRecMutex *task_launcher_mutex;
+
+  /* get task launcher mutex */
+  task_launcher_mutex = AGS_TASK_LAUNCHER_GET_OBJ_MUTEX(task_launcher);
+
+  g_rec_mutex_lock(task_launcher_mutex);
+
+  task_launcher->pending_task = g_list_concat(task_launcher->pending_task,
+					      ags_task_launcher_take_task(task_launcher));
+
+  /* coalesce, the newest task of a type and key wins */
+  coalesce = g_hash_table_new_full(g_direct_hash, g_direct_equal,
+				   NULL,
+				   (GDestroyNotify) g_slist_free);
+  
+  task = g_list_last(task_launcher->pending_task);
+
+  while(task != NULL){
+    GSList *type;
+
+    gpointer coalesce_key;
+
+    prev = task->prev;
+    
+    coalesce_key = ags_task_get_coalesce_key(task->data);
+
+    if(coalesce_key != NULL){
+      type = g_hash_table_lookup(coalesce,
+				 coalesce_key);
+
+      if(g_slist_find(type, GSIZE_TO_POINTER(G_OBJECT_TYPE(task->data))) != NULL){
+	g_object_unref(task->data);
+
+	task_launcher->pending_task = g_list_delete_link(task_launcher->pending_task,
+							 task);
+      }else{
+	g_hash_table_steal(coalesce,
+			   coalesce_key);
+	
+	g_hash_table_insert(coalesce,
+			    coalesce_key,
+			    g_slist_prepend(type,
+					    GSIZE_TO_POINTER(G_OBJECT_TYPE(task->data))));
+      }
+    }
+
+    /* iterate */
+    task = prev;
+  }
+
+  g_hash_table_destroy(coalesce);
+  
+  g_rec_mutex_unlock(task_launcher_mutex);
+}
+
 void
 ags_task_launcher_real_run(AgsTaskLauncher *task_launcher)
 {
@@ -820,15 +1034,27 @@ ags_task_launcher_real_run(AgsTaskLauncher *task_launcher)
 
   g_rec_mutex_lock(task_launcher_mutex);
 
-  g_object_get(task_launcher,
-	       "task", &start_task,
-	       "cyclic-task", &start_cyclic_task,
-	       NULL);
+  ags_task_launcher_collect_task(task_launcher);
 
-  g_list_free_full(task_launcher->task,
-		   g_object_unref);
+  /* bounded work per run */
+  start_task = task_launcher->pending_task;
+  task_launcher->pending_task = NULL;
   
-  task_launcher->task = NULL;
+  if(task_launcher->max_task_count > 0){
+    task = g_list_nth(start_task,
+		      task_launcher->max_task_count);
+
+    if(task != NULL){
+      task->prev->next = NULL;
+      task->prev = NULL;
+
+      task_launcher->pending_task = task;
+    }
+  }
+  
+  start_cyclic_task = g_list_copy_deep(task_launcher->cyclic_task,
+				       (GCopyFunc) g_object_ref,
+				       NULL);
   
   g_rec_mutex_unlock(task_launcher_mutex);
   
@@ -881,6 +1107,9 @@ ags_task_launcher_run(AgsTaskLauncher *task_launcher)
 gboolean
 ags_task_launcher_source_func(AgsTaskLauncher *task_launcher)
 {
+  /* CPU affinity of the attached main context's thread */
+  ags_cpu_affinity_setup(AGS_CPU_AFFINITY_KEY_TASK_LAUNCHER);
+  
   ags_task_launcher_run(task_launcher);
 
   return(FALSE);
@@ -39,6 +39,8 @@ G_BEGIN_DECLS
 
 #define AGS_TASK_LAUNCHER_GET_OBJ_MUTEX(obj) (&(((AgsTaskLauncher *) obj)->obj_mutex))
 
+#define AGS_TASK_LAUNCHER_DEFAULT_MAX_TASK_COUNT (256)
+
 typedef struct _AgsTaskLauncher AgsTaskLauncher;
 typedef struct _AgsTaskLauncherClass AgsTaskLauncherClass;
 
@@ -70,6 +72,9 @@ struct _AgsTaskLauncher
   GList *task;
   GList *cyclic_task;
 
+  GList *pending_task;
+  guint max_task_count;
+
   volatile gboolean is_running;
   volatile gint wait_count;
   
@@ -487,6 +487,12 @@ ags_thread_init(AgsThread *thread)
   thread->prev = NULL;
 
   thread->children = NULL;
+
+  /* tic barrier - allocated by the main loop */
+  thread->tic_barrier = NULL;
+
+  /* deadline clock - optionally paces the main loop */
+  thread->deadline_clock = NULL;
 }
 
 void
@@ -636,6 +642,12 @@ ags_thread_finalize(GObject *gobject)
 
   /* UUID */
   ags_uuid_free(thread->uuid);
+
+  /* tic barrier */
+  ags_tic_barrier_unref(thread->tic_barrier);
+
+  /* deadline clock */
+  ags_deadline_clock_free(thread->deadline_clock);
     
   /* call parent */
   G_OBJECT_CLASS(ags_thread_parent_class)->finalize(gobject);
@@ -2228,10 +2240,10 @@ ags_thread_real_clock(AgsThread *thread)
   
   AgsApplicationContext *application_context;
 
-  guint main_sync_tic, current_sync_tic, next_main_sync_tic;
-  gdouble next_tic_delay, prev_tic_delay;
-  guint sync_tic_wait, sync_tic_done;
-  guint next_sync_tic_wait, next_sync_tic_done;    
+  AgsTicBarrier *tic_barrier;
+  
+  guint main_sync_tic, current_sync_tic, next_sync_tic;
+  guint generation;
   guint clocked_steps;
   gboolean initial_sync;
   
@@ -2240,8 +2252,6 @@ ags_thread_real_clock(AgsThread *thread)
   GRecMutex *tree_mutex;
   GMutex *thread_start_mutex;
   GCond *thread_start_cond;
-  GMutex *wait_mutex;
-  GCond *wait_cond;
   
   application_context = ags_application_context_get_instance();
   
@@ -2254,10 +2264,8 @@ ags_thread_real_clock(AgsThread *thread)
   main_loop_mutex = AGS_THREAD_GET_OBJ_MUTEX(main_loop);
 
   tree_mutex = ags_main_loop_get_tree_lock(AGS_MAIN_LOOP(main_loop));
-  
-  /* wait */
-  wait_mutex = AGS_THREAD_GET_WAIT_MUTEX(thread);
-  wait_cond = AGS_THREAD_GET_WAIT_COND(thread);
+
+  tic_barrier = main_loop->tic_barrier;
 
   /* check initial sync */
   initial_sync = FALSE;
@@ -2291,6 +2299,13 @@ ags_thread_real_clock(AgsThread *thread)
       
   g_mutex_unlock(thread_start_mutex);
 
+  /* absolute deadline of main loop - sleep without holding the tree */
+  if(thread == main_loop &&
+     thread->deadline_clock != NULL &&
+     ags_thread_test_flags(thread, AGS_THREAD_TIME_ACCOUNTING)){
+    ags_deadline_clock_wait(thread->deadline_clock);
+  }
+
   g_rec_mutex_lock(tree_mutex);
 
   if(thread == main_loop){
@@ -2326,151 +2341,9 @@ ags_thread_real_clock(AgsThread *thread)
     current_sync_tic = main_sync_tic;
     ags_thread_set_current_sync_tic(thread, main_sync_tic);
   }
-  
-  sync_tic_wait = 0;
-  sync_tic_done = 0;
-  
-  switch(current_sync_tic){
-  case 0:
-  {
-    sync_tic_wait = AGS_THREAD_SYNC_TIC_WAIT_0;
-    sync_tic_done = AGS_THREAD_SYNC_TIC_DONE_0;
-  }
-  break;
-  case 1:
-  {
-    sync_tic_wait = AGS_THREAD_SYNC_TIC_WAIT_1;
-    sync_tic_done = AGS_THREAD_SYNC_TIC_DONE_1;
-  }
-  break;
-  case 2:
-  {
-    sync_tic_wait = AGS_THREAD_SYNC_TIC_WAIT_2;
-    sync_tic_done = AGS_THREAD_SYNC_TIC_DONE_2;
-  }
-  break;
-  case 3:
-  {
-    sync_tic_wait = AGS_THREAD_SYNC_TIC_WAIT_3;
-    sync_tic_done = AGS_THREAD_SYNC_TIC_DONE_3;
-  }
-  break;
-  case 4:
-  {
-    sync_tic_wait = AGS_THREAD_SYNC_TIC_WAIT_4;
-    sync_tic_done = AGS_THREAD_SYNC_TIC_DONE_4;
-  }
-  break;
-  case 5:
-  {
-    sync_tic_wait = AGS_THREAD_SYNC_TIC_WAIT_5;
-    sync_tic_done = AGS_THREAD_SYNC_TIC_DONE_5;
-  }
-  break;
-  case 6:
-  {
-    sync_tic_wait = AGS_THREAD_SYNC_TIC_WAIT_6;
-    sync_tic_done = AGS_THREAD_SYNC_TIC_DONE_6;
-  }
-  break;
-  case 7:
-  {
-    sync_tic_wait = AGS_THREAD_SYNC_TIC_WAIT_7;
-    sync_tic_done = AGS_THREAD_SYNC_TIC_DONE_7;
-  }
-  break;
-  case 8:
-  {
-    sync_tic_wait = AGS_THREAD_SYNC_TIC_WAIT_8;
-    sync_tic_done = AGS_THREAD_SYNC_TIC_DONE_8;
-  }
-  break;
-  default:
-    g_critical("invalid current sync-tic");
-  }
 
-  next_main_sync_tic = G_MAXUINT;
+  next_sync_tic = (current_sync_tic + 1) % AGS_THREAD_SYNC_TIC_COUNT;
   
-  next_sync_tic_wait = 0;
-  next_sync_tic_done = 0;
-  
-  switch(main_sync_tic){
-  case 0:
-  {
-    next_main_sync_tic = 1;
-    
-    next_sync_tic_wait = AGS_THREAD_SYNC_TIC_WAIT_1;
-    next_sync_tic_done = AGS_THREAD_SYNC_TIC_DONE_1;
-  }
-  break;
-  case 1:
-  {
-    next_main_sync_tic = 2;
-    
-    next_sync_tic_wait = AGS_THREAD_SYNC_TIC_WAIT_2;
-    next_sync_tic_done = AGS_THREAD_SYNC_TIC_DONE_2;
-  }
-  break;
-  case 2:
-  {
-    next_main_sync_tic = 3;
-    
-    next_sync_tic_wait = AGS_THREAD_SYNC_TIC_WAIT_3;
-    next_sync_tic_done = AGS_THREAD_SYNC_TIC_DONE_3;
-  }
-  break;
-  case 3:
-  {
-    next_main_sync_tic = 4;
-
-    next_sync_tic_wait = AGS_THREAD_SYNC_TIC_WAIT_4;
-    next_sync_tic_done = AGS_THREAD_SYNC_TIC_DONE_4;
-  }
-  break;
-  case 4:
-  {
-    next_main_sync_tic = 5;
-    
-    next_sync_tic_wait = AGS_THREAD_SYNC_TIC_WAIT_5;
-    next_sync_tic_done = AGS_THREAD_SYNC_TIC_DONE_5;
-  }
-  break;
-  case 5:
-  {
-    next_main_sync_tic = 6;
-    
-    next_sync_tic_wait = AGS_THREAD_SYNC_TIC_WAIT_6;
-    next_sync_tic_done = AGS_THREAD_SYNC_TIC_DONE_6;
-  }
-  break;
-  case 6:
-  {
-    next_main_sync_tic = 7;
-    
-    next_sync_tic_wait = AGS_THREAD_SYNC_TIC_WAIT_7;
-    next_sync_tic_done = AGS_THREAD_SYNC_TIC_DONE_7;
-  }
-  break;
-  case 7:
-  {
-    next_main_sync_tic = 8;
-    
-    next_sync_tic_wait = AGS_THREAD_SYNC_TIC_WAIT_8;
-    next_sync_tic_done = AGS_THREAD_SYNC_TIC_DONE_8;
-  }
-  break;
-  case 8:
-  {
-    next_main_sync_tic = 0;
-    
-    next_sync_tic_wait = AGS_THREAD_SYNC_TIC_WAIT_0;
-    next_sync_tic_done = AGS_THREAD_SYNC_TIC_DONE_0;
-  }
-  break;
-  default:
-    g_critical("invalid main sync-tic");
-  }
-
   /* do initial sync */
   if(initial_sync){
     gdouble main_delay;
@@ -2494,9 +2367,6 @@ ags_thread_real_clock(AgsThread *thread)
     }else{
       prev_main_tic_delay = main_delay - 1.0; // (floor(main_delay) + 1.0) - (floor(main_delay) + main_tic_delay); // (main_delay + 1.0) - (main_delay + main_tic_delay);
     }
-  
-    ags_thread_set_sync_tic_flags(thread, sync_tic_wait);
-    ags_thread_unset_sync_tic_flags(thread, sync_tic_done);	
       
     /* mark synced */
     if(ags_thread_test_flags(thread, AGS_THREAD_IMMEDIATE_SYNC)){
@@ -2508,7 +2378,10 @@ ags_thread_real_clock(AgsThread *thread)
     }else{
       thread->tic_delay = 0.0;
     }
-      
+
+    /* join the tic barrier */
+    ags_tic_barrier_add_party(tic_barrier);
+    
     ags_thread_set_flags(thread, AGS_THREAD_MARK_SYNCED);
     ags_thread_set_status_flags(thread, (AGS_THREAD_STATUS_SYNCED_FREQ));
     
@@ -2519,49 +2392,32 @@ ags_thread_real_clock(AgsThread *thread)
     ags_main_loop_dec_queued_critical_region(AGS_MAIN_LOOP(main_loop));
   }
 
-  /* synchronize */
+  /* synchronize - the last thread arriving runs the task launcher */
   ags_thread_set_status_flags(thread, AGS_THREAD_STATUS_WAITING);
-    
-  if(current_sync_tic != main_sync_tic ||
-     !ags_thread_is_tree_ready_recursive(main_loop, current_sync_tic)){
-    gboolean unlock_tree;
-
-    unlock_tree = TRUE;
-          
-    g_mutex_lock(wait_mutex);
-      
-    if(ags_thread_test_sync_tic_flags(thread, sync_tic_wait) &&
-       !ags_thread_test_sync_tic_flags(thread, sync_tic_done)){
-      ags_thread_set_sync_tic_flags(thread, sync_tic_wait);
-
-      while(ags_thread_test_sync_tic_flags(thread, sync_tic_wait) &&
-	    !ags_thread_test_sync_tic_flags(thread, sync_tic_done)){
-	if(unlock_tree){
-	  unlock_tree = FALSE;
-	  
-	  g_rec_mutex_unlock(tree_mutex);
-	}
-	
-	g_cond_wait(wait_cond,
-		    wait_mutex);
-      }
-    }
 
+  if(tic_barrier == NULL){
+    /* no tic barrier - don't sync, the main loop runs the task launcher */
     ags_thread_unset_status_flags(thread, AGS_THREAD_STATUS_WAITING);
 
-    if(unlock_tree){
-      unlock_tree = FALSE;
-	  
-      g_rec_mutex_unlock(tree_mutex);
+    if(thread == main_loop){
+      ags_main_loop_set_syncing(AGS_MAIN_LOOP(main_loop), TRUE);
+
+      /* get task launcher */
+      task_launcher = ags_concurrency_provider_get_task_launcher(AGS_CONCURRENCY_PROVIDER(application_context));
+      
+      /* run task launcher */
+      ags_task_launcher_sync_run(task_launcher);
+    
+      ags_main_loop_set_syncing(AGS_MAIN_LOOP(main_loop), FALSE);
     }
+    
+    g_rec_mutex_unlock(tree_mutex);
+  }else if(!ags_tic_barrier_arrive(tic_barrier, &generation)){
+    g_rec_mutex_unlock(tree_mutex);
 
-    ags_thread_unset_sync_tic_flags(thread, sync_tic_wait);
-    ags_thread_unset_sync_tic_flags(thread, sync_tic_done);
+    ags_tic_barrier_wait(tic_barrier, generation);
 
-    ags_thread_set_sync_tic_flags(thread, next_sync_tic_wait);
-    ags_thread_unset_sync_tic_flags(thread, next_sync_tic_done);
-      
-    g_mutex_unlock(wait_mutex);
+    ags_thread_unset_status_flags(thread, AGS_THREAD_STATUS_WAITING);
   }else{
     ags_main_loop_set_syncing(AGS_MAIN_LOOP(main_loop), TRUE);
 
@@ -2573,37 +2429,21 @@ ags_thread_real_clock(AgsThread *thread)
     /* run task launcher */
     ags_task_launcher_sync_run(task_launcher);
     
-    /* signal */
-#if 1
-    if(main_sync_tic == current_sync_tic){
-    }else{
-      g_critical("out-of-sync - main sync-tic != current sync-tic");
-    }
-
-    ags_thread_prepare_tree_sync_recursive(main_loop,
-					   main_sync_tic);
-
-    ags_thread_set_tree_sync_recursive(main_loop,
-				       main_sync_tic);
-#else
-    ags_thread_prepare_tree_sync_recursive(main_loop,
-					   main_sync_tic);
-
-    ags_thread_set_tree_sync_recursive(main_loop,
-				       main_sync_tic);
-#endif
-    
     ags_main_loop_set_syncing(AGS_MAIN_LOOP(main_loop), FALSE);
 
-    ags_thread_unset_sync_tic_flags(thread, sync_tic_wait);
-    ags_thread_unset_sync_tic_flags(thread, sync_tic_done);
-
-    ags_thread_set_sync_tic_flags(thread, next_sync_tic_wait);
-    ags_thread_unset_sync_tic_flags(thread, next_sync_tic_done);
+    /* signal */
+    ags_tic_barrier_release(tic_barrier);
 
     g_rec_mutex_unlock(tree_mutex);
   }
 
+  /* apply next sync tic */
+  ags_thread_set_current_sync_tic(thread, next_sync_tic);
+
+  if(!ags_thread_test_status_flags(thread, AGS_THREAD_STATUS_SYNCED)){
+    ags_thread_set_status_flags(thread, AGS_THREAD_STATUS_SYNCED);
+  }
+
   /* get task launcher */
   task_launcher = ags_concurrency_provider_get_task_launcher(AGS_CONCURRENCY_PROVIDER(application_context));
 
@@ -2693,7 +2533,6 @@ ags_thread_loop(void *ptr)
   
   GList *start_start_queue, *start_queue;
   
-  guint main_sync_tic, current_sync_tic;
   guint i, i_stop;
 
   GRecMutex *tree_mutex;
@@ -2844,28 +2683,16 @@ ags_thread_loop(void *ptr)
   
   g_rec_mutex_lock(tree_mutex);
 
-  /* sync tic */
-  main_sync_tic = ags_thread_get_current_sync_tic(main_loop);
-
-  current_sync_tic = ags_thread_get_current_sync_tic(thread);
-
 #ifdef AGS_DEBUG
-  g_message("thread finish %d %d", main_sync_tic, current_sync_tic);
+  g_message("thread finish %d %d", ags_thread_get_current_sync_tic(main_loop), ags_thread_get_current_sync_tic(thread));
 #endif
   
   ags_thread_clear_status_flags(thread);
   ags_thread_clear_sync_tic_flags(thread);
-  
-  if(!ags_thread_is_tree_ready_recursive(main_loop, current_sync_tic) ||
-     current_sync_tic != main_sync_tic){
-    if(main_sync_tic != current_sync_tic){
-      g_critical("out-of-sync - main sync-tic != current sync-tic");
-    }
-    
-    g_rec_mutex_unlock(tree_mutex);
-  }else{
-    AgsTaskLauncher *task_launcher;
 
+  /* leave the tic barrier, the others might wait only for us */
+  if(ags_thread_test_flags(thread, AGS_THREAD_MARK_SYNCED) &&
+     ags_tic_barrier_remove_party(main_loop->tic_barrier)){
     ags_main_loop_set_syncing(AGS_MAIN_LOOP(main_loop), TRUE);
 
     /* get task launcher */
@@ -2874,31 +2701,14 @@ ags_thread_loop(void *ptr)
     /* run task launcher */
     ags_task_launcher_sync_run(task_launcher);
 
-    /* signal */
-#if 1
-    if(main_sync_tic == current_sync_tic){
-    }else{
-      g_critical("out-of-sync - main sync-tic != current sync-tic");
-    }
-
-    ags_thread_prepare_tree_sync_recursive(main_loop,
-					   main_sync_tic);
-
-    ags_thread_set_tree_sync_recursive(main_loop,
-				       main_sync_tic);
-#else
-    ags_thread_prepare_tree_sync_recursive(main_loop,
-					   main_sync_tic);
-
-    ags_thread_set_tree_sync_recursive(main_loop,
-				       main_sync_tic);
-#endif
-
     ags_main_loop_set_syncing(AGS_MAIN_LOOP(main_loop), FALSE);
-      
-    g_rec_mutex_unlock(tree_mutex);
+
+    /* signal */
+    ags_tic_barrier_release(main_loop->tic_barrier);
   }
   
+  g_rec_mutex_unlock(tree_mutex);
+  
   /* exit thread */
   ags_thread_unset_flags(thread, AGS_THREAD_MARK_SYNCED);
 
@@ -26,6 +26,9 @@
 #include <ags/lib/ags_uuid.h>
 #include <ags/lib/ags_time.h>
 
+#include <ags/thread/ags_tic_barrier.h>
+#include <ags/thread/ags_deadline_clock.h>
+
 #include <time.h>
 
 G_BEGIN_DECLS
@@ -57,6 +60,8 @@ G_BEGIN_DECLS
 
 #define AGS_THREAD_MAX_PRECISION (1000.0)
 
+#define AGS_THREAD_SYNC_TIC_COUNT (9)
+
 #define AGS_THREAD_DEFAULT_ATTACK (1.0)
 
 #define AGS_THREAD_TOLERANCE (0.0)
@@ -213,6 +218,10 @@ struct _AgsThread
   AgsThread *prev;
 
   AgsThread *children;
+
+  AgsTicBarrier *tic_barrier;
+
+  AgsDeadlineClock *deadline_clock;
 };
 
 struct _AgsThreadClass
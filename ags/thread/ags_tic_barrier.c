@@ -0,0 +1,387 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <ags/thread/ags_tic_barrier.h>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <limits.h>
+
+/**
+ * SECTION:ags_tic_barrier
+ * @short_description: phase barrier
+ * @title: AgsTicBarrier
+ * @section_id:
+ * @include: ags/thread/ags_tic_barrier.h
+ *
+ * The #AgsTicBarrier is a phase barrier all synced #AgsThread arrive at once per
+ * tic. The last party to arrive is the leader, it does the serial work and calls
+ * ags_tic_barrier_release() to start the next generation. The others spin for a
+ * bounded count and then sleep on the generation counter, using a futex where
+ * available.
+ *
+ * Parties and arrivals share one atomic word, so neither of them needs a lock.
+ */
+
+GType
+ags_tic_barrier_get_type()
+{
+  static volatile gsize g_define_type_id__volatile = 0;
+
+  if(g_once_init_enter (&g_define_type_id__volatile)){
+    GType ags_type_tic_barrier = 0;
+
+    ags_type_tic_barrier =
+      g_boxed_type_register_static("AgsTicBarrier",
+				   (GBoxedCopyFunc) ags_tic_barrier_ref,
+				   (GBoxedFreeFunc) ags_tic_barrier_unref);
+
+    g_once_init_leave(&g_define_type_id__volatile, ags_type_tic_barrier);
+  }
+
+  return g_define_type_id__volatile;
+}
+
+/**
+ * ags_tic_barrier_alloc:
+ * @spin_count: the count of spins before going to sleep
+ *
+ * Allocate #AgsTicBarrier without any party.
+ *
+ * Returns: (transfer full): the new #AgsTicBarrier
+ *
+ * Since: 3.7.0
+ */
+AgsTicBarrier*
+ags_tic_barrier_alloc(guint spin_count)
+{
+  AgsTicBarrier *tic_barrier;
+
+  tic_barrier = (AgsTicBarrier *) g_malloc(sizeof(AgsTicBarrier));
+
+  tic_barrier->ref_count = 1;
+
+  tic_barrier->generation = 0;
+  tic_barrier->state = 0;
+  tic_barrier->sleeping = 0;
+
+  tic_barrier->spin_count = spin_count;
+
+  g_mutex_init(&(tic_barrier->wait_mutex));
+  g_cond_init(&(tic_barrier->wait_cond));
+
+  return(tic_barrier);
+}
+
+/**
+ * ags_tic_barrier_ref:
+ * @tic_barrier: the #AgsTicBarrier
+ *
+ * Increase reference count of @tic_barrier.
+ *
+ * Returns: (transfer full): @tic_barrier
+ *
+ * Since: 3.7.0
+ */
+AgsTicBarrier*
+ags_tic_barrier_ref(AgsTicBarrier *tic_barrier)
+{
+  if(tic_barrier == NULL){
+    return(NULL);
+  }
+
+  g_atomic_int_inc(&(tic_barrier->ref_count));
+
+  return(tic_barrier);
+}
+
+/**
+ * ags_tic_barrier_unref:
+ * @tic_barrier: the #AgsTicBarrier
+ *
+ * Decrease reference count of @tic_barrier and free it if the count drops to 0.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_tic_barrier_unref(AgsTicBarrier *tic_barrier)
+{
+  if(tic_barrier == NULL){
+    return;
+  }
+
+  if(g_atomic_int_dec_and_test(&(tic_barrier->ref_count))){
+    g_mutex_clear(&(tic_barrier->wait_mutex));
+    g_cond_clear(&(tic_barrier->wait_cond));
+    
+    g_free(tic_barrier);
+  }
+}
+
+/**
+ * ags_tic_barrier_get_generation:
+ * @tic_barrier: the #AgsTicBarrier
+ *
+ * Get current generation of @tic_barrier, it is incremented by every release.
+ *
+ * Returns: the generation
+ *
+ * Since: 3.7.0
+ */
+guint
+ags_tic_barrier_get_generation(AgsTicBarrier *tic_barrier)
+{
+  if(tic_barrier == NULL){
+    return(0);
+  }
+
+  return((guint) g_atomic_int_get(&(tic_barrier->generation)));
+}
+
+/**
+ * ags_tic_barrier_get_party_count:
+ * @tic_barrier: the #AgsTicBarrier
+ *
+ * Get the count of parties of @tic_barrier.
+ *
+ * Returns: the party count
+ *
+ * Since: 3.7.0
+ */
+guint
+ags_tic_barrier_get_party_count(AgsTicBarrier *tic_barrier)
+{
+  if(tic_barrier == NULL){
+    return(0);
+  }
+
+  return(((guint) g_atomic_int_get(&(tic_barrier->state))) >> AGS_TIC_BARRIER_PARTY_SHIFT);
+}
+
+/**
+ * ags_tic_barrier_add_party:
+ * @tic_barrier: the #AgsTicBarrier
+ *
+ * Add a party to @tic_barrier, it has to arrive starting with the current
+ * generation. If all parties arrived already, the party is kept out until the
+ * leader's ags_tic_barrier_release() did start the next generation.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_tic_barrier_add_party(AgsTicBarrier *tic_barrier)
+{
+  guint state;
+  guint arrived;
+
+  if(tic_barrier == NULL){
+    return;
+  }
+
+  for(;;){
+    state = (guint) g_atomic_int_get(&(tic_barrier->state));
+
+    arrived = (AGS_TIC_BARRIER_ARRIVED_MASK & state);
+
+    /* complete or releasing, the generation read by arrive would be stale */
+    if((AGS_TIC_BARRIER_RELEASE_MASK & state) != 0 ||
+       (arrived != 0 && arrived == (state >> AGS_TIC_BARRIER_PARTY_SHIFT))){
+      g_thread_yield();
+
+      continue;
+    }
+
+    if(g_atomic_int_compare_and_exchange(&(tic_barrier->state),
+					 (gint) state,
+					 (gint) (state + (1 << AGS_TIC_BARRIER_PARTY_SHIFT)))){
+      break;
+    }
+  }
+}
+
+/**
+ * ags_tic_barrier_remove_party:
+ * @tic_barrier: the #AgsTicBarrier
+ *
+ * Remove a party, that didn't arrive at the current generation, from @tic_barrier.
+ * If all remaining parties did arrive already, the caller is the leader and has to
+ * call ags_tic_barrier_release().
+ *
+ * Returns: %TRUE if the caller is the leader, else %FALSE
+ *
+ * Since: 3.7.0
+ */
+gboolean
+ags_tic_barrier_remove_party(AgsTicBarrier *tic_barrier)
+{
+  guint state;
+  guint arrived;
+
+  if(tic_barrier == NULL){
+    return(FALSE);
+  }
+
+  state = (guint) g_atomic_int_add(&(tic_barrier->state),
+				   -(1 << AGS_TIC_BARRIER_PARTY_SHIFT));
+  state -= (1 << AGS_TIC_BARRIER_PARTY_SHIFT);
+
+  arrived = (AGS_TIC_BARRIER_ARRIVED_MASK & state);
+
+  return((arrived != 0 && arrived == (state >> AGS_TIC_BARRIER_PARTY_SHIFT)) ? TRUE: FALSE);
+}
+
+/**
+ * ags_tic_barrier_arrive:
+ * @tic_barrier: the #AgsTicBarrier
+ * @generation: (out): return location of the generation arrived at
+ *
+ * Arrive at @tic_barrier. The last party to arrive is the leader, it doesn't wait
+ * but has to call ags_tic_barrier_release(). All others pass @generation to
+ * ags_tic_barrier_wait().
+ *
+ * Returns: %TRUE if the caller is the leader, else %FALSE
+ *
+ * Since: 3.7.0
+ */
+gboolean
+ags_tic_barrier_arrive(AgsTicBarrier *tic_barrier,
+		       guint *generation)
+{
+  guint state;
+
+  g_return_val_if_fail(tic_barrier != NULL, FALSE);
+
+  /* the generation can't change until we arrived, parties don't join while
+   * a generation is complete or released
+   */
+  if(generation != NULL){
+    generation[0] = (guint) g_atomic_int_get(&(tic_barrier->generation));
+  }
+  
+  state = (guint) g_atomic_int_add(&(tic_barrier->state),
+				   1);
+  state += 1;
+
+  return(((AGS_TIC_BARRIER_ARRIVED_MASK & state) == (state >> AGS_TIC_BARRIER_PARTY_SHIFT)) ? TRUE: FALSE);
+}
+
+/**
+ * ags_tic_barrier_wait:
+ * @tic_barrier: the #AgsTicBarrier
+ * @generation: the generation returned by ags_tic_barrier_arrive()
+ *
+ * Wait for the leader to release @generation. Spins the configured count and
+ * sleeps after that.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_tic_barrier_wait(AgsTicBarrier *tic_barrier,
+		     guint generation)
+{
+  guint i;
+
+  if(tic_barrier == NULL){
+    return;
+  }
+
+  /* bounded spin */
+  for(i = 0; i < tic_barrier->spin_count; i++){
+    if((guint) g_atomic_int_get(&(tic_barrier->generation)) != generation){
+      return;
+    }
+  }
+
+  /* sleep */
+  g_atomic_int_inc(&(tic_barrier->sleeping));
+  
+#if defined(__linux__)
+  while((guint) g_atomic_int_get(&(tic_barrier->generation)) == generation){
+    syscall(SYS_futex,
+	    &(tic_barrier->generation), FUTEX_WAIT_PRIVATE, (gint) generation,
+	    NULL, NULL, 0);
+  }
+#else
+  g_mutex_lock(&(tic_barrier->wait_mutex));
+
+  while((guint) g_atomic_int_get(&(tic_barrier->generation)) == generation){
+    g_cond_wait(&(tic_barrier->wait_cond),
+		&(tic_barrier->wait_mutex));
+  }
+
+  g_mutex_unlock(&(tic_barrier->wait_mutex));
+#endif
+
+  g_atomic_int_add(&(tic_barrier->sleeping),
+		   -1);
+}
+
+/**
+ * ags_tic_barrier_release:
+ * @tic_barrier: the #AgsTicBarrier
+ *
+ * Release all parties waiting at the current generation of @tic_barrier. Only
+ * the leader may call it.
+ *
+ * Since: 3.7.0
+ */
+void
+ags_tic_barrier_release(AgsTicBarrier *tic_barrier)
+{
+  guint state;
+
+  if(tic_barrier == NULL){
+    return;
+  }
+
+  /* reset arrived before the parties can arrive at the next generation and
+   * mark releasing until the generation was incremented
+   */
+  do{
+    state = (guint) g_atomic_int_get(&(tic_barrier->state));
+  }while(!g_atomic_int_compare_and_exchange(&(tic_barrier->state),
+					    (gint) state,
+					    (gint) ((state & ~((guint) AGS_TIC_BARRIER_ARRIVED_MASK)) + (1 << AGS_TIC_BARRIER_RELEASE_SHIFT))));
+
+#if defined(__linux__)
+  g_atomic_int_inc(&(tic_barrier->generation));
+
+  if(g_atomic_int_get(&(tic_barrier->sleeping)) > 0){
+    syscall(SYS_futex,
+	    &(tic_barrier->generation), FUTEX_WAKE_PRIVATE, INT_MAX,
+	    NULL, NULL, 0);
+  }
+#else
+  g_mutex_lock(&(tic_barrier->wait_mutex));
+
+  g_atomic_int_inc(&(tic_barrier->generation));
+
+  g_cond_broadcast(&(tic_barrier->wait_cond));
+
+  g_mutex_unlock(&(tic_barrier->wait_mutex));
+#endif
+
+  g_atomic_int_add(&(tic_barrier->state),
+		   -(1 << AGS_TIC_BARRIER_RELEASE_SHIFT));
+}
@@ -0,0 +1,76 @@
+/* GSequencer - Advanced GTK Sequencer
+ * Copyright (C) 2005-2020 Joël Krähemann
+ *
+ * This file is part of GSequencer.
+ *
+ * GSequencer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GSequencer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GSequencer.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __AGS_TIC_BARRIER_H__
+#define __AGS_TIC_BARRIER_H__
+
+#include <glib.h>
+#include <glib-object.h>
+
+G_BEGIN_DECLS
+
+#define AGS_TYPE_TIC_BARRIER         (ags_tic_barrier_get_type())
+#define AGS_TIC_BARRIER(ptr) ((AgsTicBarrier *)(ptr))
+
+#define AGS_TIC_BARRIER_DEFAULT_SPIN_COUNT (256)
+
+#define AGS_TIC_BARRIER_ARRIVED_MASK (0xfff)
+#define AGS_TIC_BARRIER_RELEASE_MASK (0xf000)
+#define AGS_TIC_BARRIER_RELEASE_SHIFT (12)
+#define AGS_TIC_BARRIER_PARTY_SHIFT (16)
+
+typedef struct _AgsTicBarrier AgsTicBarrier;
+
+struct _AgsTicBarrier
+{
+  volatile gint ref_count;
+
+  volatile gint generation;
+  volatile gint state;
+  volatile gint sleeping;
+
+  guint spin_count;
+
+  GMutex wait_mutex;
+  GCond wait_cond;
+};
+
+GType ags_tic_barrier_get_type();
+
+AgsTicBarrier* ags_tic_barrier_alloc(guint spin_count);
+
+AgsTicBarrier* ags_tic_barrier_ref(AgsTicBarrier *tic_barrier);
+void ags_tic_barrier_unref(AgsTicBarrier *tic_barrier);
+
+guint ags_tic_barrier_get_generation(AgsTicBarrier *tic_barrier);
+guint ags_tic_barrier_get_party_count(AgsTicBarrier *tic_barrier);
+
+void ags_tic_barrier_add_party(AgsTicBarrier *tic_barrier);
+gboolean ags_tic_barrier_remove_party(AgsTicBarrier *tic_barrier);
+
+gboolean ags_tic_barrier_arrive(AgsTicBarrier *tic_barrier,
+				guint *generation);
+void ags_tic_barrier_wait(AgsTicBarrier *tic_barrier,
+			  guint generation);
+void ags_tic_barrier_release(AgsTicBarrier *tic_barrier);
+
+G_END_DECLS
+
+#endif /*__AGS_TIC_BARRIER_H__*/
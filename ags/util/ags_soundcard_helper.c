@@ -210,7 +210,8 @@ ags_soundcard_helper_config_get_buffer_size(AgsConfig *config)
  * ags_soundcard_helper_config_get_format:
  * @config: the #AgsConfig
  * 
- * Get format as #AgsSoundcardFormat-enum.
+ * Get format as #AgsSoundcardFormat-enum. If float mix bus is enabled
+ * this is always %AGS_SOUNDCARD_FLOAT, otherwise the device format.
  * 
  * Returns: the format
  * 
@@ -218,6 +219,27 @@ ags_soundcard_helper_config_get_buffer_size(AgsConfig *config)
  */
 guint
 ags_soundcard_helper_config_get_format(AgsConfig *config)
+{
+  if(ags_soundcard_helper_config_get_float_mix_bus(config)){
+    return(AGS_SOUNDCARD_FLOAT);
+  }
+
+  return(ags_soundcard_helper_config_get_device_format(config));
+}
+
+/**
+ * ags_soundcard_helper_config_get_device_format:
+ * @config: the #AgsConfig
+ * 
+ * Get device format as #AgsSoundcardFormat-enum, the format written
+ * to the hardware.
+ * 
+ * Returns: the device format
+ * 
+ * Since: 3.7.0
+ */
+guint
+ags_soundcard_helper_config_get_device_format(AgsConfig *config)
 {
   gchar *str;
 
@@ -249,3 +271,85 @@ ags_soundcard_helper_config_get_format(AgsConfig *config)
 
   return(format);
 }
+
+/**
+ * ags_soundcard_helper_config_get_float_mix_bus:
+ * @config: the #AgsConfig
+ * 
+ * Get float mix bus. If enabled audio signals, recalls and soundcard buffers
+ * use %AGS_SOUNDCARD_FLOAT and the output backend converts to device format
+ * as filling its ring buffer. Only the alsa, oss, jack and pulse backends
+ * implement it, with any other backend it is always disabled.
+ * 
+ * Returns: %TRUE if float mix bus enabled, else %FALSE
+ * 
+ * Since: 3.7.0
+ */
+gboolean
+ags_soundcard_helper_config_get_float_mix_bus(AgsConfig *config)
+{
+  gchar *str;
+
+  gboolean float_mix_bus;
+
+  if(!AGS_IS_CONFIG(config)){
+    return(FALSE);
+  }
+  
+  /* float mix bus */
+  str = ags_config_get_value(config,
+			     AGS_CONFIG_SOUNDCARD,
+			     "float-mix-bus");
+
+  if(str == NULL){
+    str = ags_config_get_value(config,
+			       AGS_CONFIG_SOUNDCARD_0,
+			       "float-mix-bus");
+  }
+
+  float_mix_bus = FALSE;
+  
+  if(str != NULL){
+    float_mix_bus = (!g_ascii_strncasecmp(str,
+					  "true",
+					  5)) ? TRUE: FALSE;
+    
+    g_free(str);
+  }
+
+  if(!float_mix_bus){
+    return(FALSE);
+  }
+
+  /* backend */
+  str = ags_config_get_value(config,
+			     AGS_CONFIG_SOUNDCARD,
+			     "backend");
+
+  if(str == NULL){
+    str = ags_config_get_value(config,
+			       AGS_CONFIG_SOUNDCARD_0,
+			       "backend");
+  }
+
+  if(str != NULL){
+    if(g_ascii_strncasecmp(str,
+			   "alsa",
+			   5) != 0 &&
+       g_ascii_strncasecmp(str,
+			   "oss",
+			   4) != 0 &&
+       g_ascii_strncasecmp(str,
+			   "jack",
+			   5) != 0 &&
+       g_ascii_strncasecmp(str,
+			   "pulse",
+			   6) != 0){
+      float_mix_bus = FALSE;
+    }
+    
+    g_free(str);
+  }
+
+  return(float_mix_bus);
+}
@@ -33,6 +33,9 @@ guint ags_soundcard_helper_config_get_pcm_channels(AgsConfig *config);
 gdouble ags_soundcard_helper_config_get_samplerate(AgsConfig *config);
 guint ags_soundcard_helper_config_get_buffer_size(AgsConfig *config);
 guint ags_soundcard_helper_config_get_format(AgsConfig *config);
+guint ags_soundcard_helper_config_get_device_format(AgsConfig *config);
+
+gboolean ags_soundcard_helper_config_get_float_mix_bus(AgsConfig *config);
 
 G_END_DECLS
 